@@ -0,0 +1,163 @@
+/**
+ * \file core/epoch.hpp
+ **/
+#ifndef DOTOTHER_EPOCH_HPP
+#define DOTOTHER_EPOCH_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace dotother {
+
+  /**
+   * epoch based reclamation for memory that readers reach without a lock
+   *
+   * a reader holds a Guard while it uses a pointer it loaded from shared state , the guard announces the epoch the
+   *   reader entered in a slot owned by its thread , a writer that unlinks memory stamps it with Retire and frees it
+   *   once IsSafe says every reader still inside a guard entered after the stamp , those readers can only have loaded
+   *   whatever replaced it
+   *
+   * guards nest , only the outermost one touches the slot , threads past kMaxThreads share one counter which holds
+   *   back every reclamation while any of them is inside a guard
+   **/
+  class EpochDomain {
+   public:
+    constexpr static size_t kMaxThreads = 128;
+
+    class Guard {
+     public:
+      Guard() {
+        EpochDomain::Get().Enter();
+      }
+
+      ~Guard() {
+        EpochDomain::Get().Exit();
+      }
+
+      Guard(const Guard&) = delete;
+      Guard& operator=(const Guard&) = delete;
+    };
+
+    static EpochDomain& Get() {
+      return domain;
+    }
+
+    /// call after unlinking the memory from shared state , the returned stamp goes to IsSafe
+    uint64_t Retire() {
+      return epoch.fetch_add(1);
+    }
+
+    /// true once no thread can still hold memory retired with this stamp
+    bool IsSafe(uint64_t stamp) const {
+      if (overflow.load() != 0) {
+        return false;
+      }
+
+      for (const Slot& slot : slots) {
+        const uint64_t entered = slot.epoch.load();
+        if (entered != 0 && entered <= stamp) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+   private:
+    struct alignas(64) Slot {
+      /// epoch the owning thread entered its outermost guard in , 0 outside of a guard
+      std::atomic<uint64_t> epoch = 0;
+      std::atomic<bool> claimed = false;
+    };
+
+    /// trivially destructible so the thread local on the read path needs no init check
+    struct ThreadState {
+      Slot* slot = nullptr;
+      uint32_t depth = 0;
+    };
+
+    /// hands the slot back when its thread exits , only touched once per thread
+    struct SlotRelease {
+      Slot* slot = nullptr;
+
+      ~SlotRelease() {
+        if (slot != nullptr) {
+          slot->claimed.store(false, std::memory_order_release);
+        }
+      }
+    };
+
+    /// constant initialized , usable from static constructors and destructors in any order
+    static EpochDomain domain;
+
+    std::array<Slot, kMaxThreads> slots;
+
+    /// starts at 1 so a slot holding 0 is never mistaken for a reader
+    std::atomic<uint64_t> epoch = 1;
+
+    /// readers inside a guard that did not get a slot
+    std::atomic<uint32_t> overflow = 0;
+
+    constexpr EpochDomain() = default;
+
+    static ThreadState& Local() {
+      thread_local constinit ThreadState state;
+      return state;
+    }
+
+    /**
+     * the slot store and the loads a reader makes after it are sequentially consistent with Retire , a reader that
+     *   loaded memory before it was unlinked announced an epoch no later than its stamp
+     **/
+    void Enter() {
+      ThreadState& state = Local();
+      if (state.depth++ > 0) {
+        return;
+      }
+
+      if (state.slot == nullptr) {
+        state.slot = Claim();
+        if (state.slot != nullptr) {
+          thread_local SlotRelease release;
+          release.slot = state.slot;
+        }
+      }
+
+      if (state.slot != nullptr) {
+        state.slot->epoch.store(epoch.load());
+      } else {
+        overflow.fetch_add(1);
+      }
+    }
+
+    void Exit() {
+      ThreadState& state = Local();
+      if (--state.depth > 0) {
+        return;
+      }
+
+      if (state.slot != nullptr) {
+        state.slot->epoch.store(0, std::memory_order_release);
+      } else {
+        overflow.fetch_sub(1, std::memory_order_release);
+      }
+    }
+
+    Slot* Claim() {
+      for (Slot& slot : slots) {
+        bool expected = false;
+        if (!slot.claimed.load(std::memory_order_relaxed) &&
+            slot.claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+          return &slot;
+        }
+      }
+      return nullptr;
+    }
+  };
+
+  constinit inline EpochDomain EpochDomain::domain;
+
+}  // namespace dotother
+
+#endif  // !DOTOTHER_EPOCH_HPP
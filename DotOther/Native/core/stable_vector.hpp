@@ -4,26 +4,51 @@
 #ifndef DOTOTHER_STABLE_VECTOR_HPP
 #define DOTOTHER_STABLE_VECTOR_HPP
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
-#include <iostream>
-#include <list>
-#include <mutex>
-#include <shared_mutex>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "core/dotother_defines.hpp"
+#include "core/epoch.hpp"
 
 namespace dotother {
 
+  /**
+   * append only paged vector , elements never move once inserted so references stay valid while it grows
+   *
+   * any number of threads can append and read at the same time:
+   *  - an index is reserved with one atomic add , the slot is constructed in place and then published , Size only
+   *    counts the constructed prefix so a reader never sees a slot that is still being constructed , a writer never
+   *    waits for another one , publishing just lags until the slower writer is done
+   *  - reads go through one flat page table , a page is installed with a compare exchange by the first writer that
+   *    needs it , doubling the table freezes the empty entries of the old one so no install lands in a table that
+   *    is being copied , a writer that finds a frozen entry helps finish the growth instead of waiting
+   *  - readers and writers hold an EpochDomain::Guard while they use a table pointer , a replaced table is freed by
+   *    the next install or growth once no guard that could have loaded it is still open
+   *
+   * the NoLock variants skip the atomic reservation , they are only correct while a single thread appends , Clear ,
+   *   copying and destruction must not run alongside anything else
+   *
+   * EmplaceBack publishes a default constructed element and hands back a reference to fill in , readers on other
+   *   threads can see it before it is filled , use Insert/Emplace when other threads read while this one appends
+   **/
   template <typename T, size_t N = 256>
   class StableVector {
    public:
+    static_assert(N > 0, "StableVector pages need at least one element");
+
     StableVector() = default;
 
     StableVector(const StableVector& other) {
-      other.ForEach([this](const T& elem) mutable {
-        EmplaceBackNoLock().second = elem;
+      other.ForEach([this](const T& elem) {
+        EmplaceNoLock(elem);
       });
     }
 
@@ -32,188 +57,387 @@ namespace dotother {
     }
 
     StableVector& operator=(const StableVector& other) {
+      if (this == &other) {
+        return *this;
+      }
+
       Clear();
 
-      other.ForEach([this](const T& elem) mutable {
-        EmplaceBackNoLock().second = elem;
+      other.ForEach([this](const T& elem) {
+        EmplaceNoLock(elem);
       });
 
       return *this;
     }
 
+    /// destroys every element and frees every page and table , not safe alongside any other call
     void Clear() {
-      for (size_t i = 0; i < page_count; i++) {
-        delete page_table[i];
+      const size_t count = published.load(std::memory_order_acquire);
+
+      Table* current = table.load(std::memory_order_acquire);
+      for (size_t p = 0; current != nullptr && p < current->capacity; ++p) {
+        Page* page = current->pages[p].load(std::memory_order_relaxed);
+        if (page == nullptr || page == Frozen()) {
+          continue;
+        }
+
+        const size_t first = p * N;
+        std::destroy_n(page->At(0), count > first ? (std::min)(count - first, N) : 0);
+        delete page;
       }
 
-      elt_count = 0;
-      capacity = 0;
-      page_count = 0;
+      delete current;
+      table.store(nullptr, std::memory_order_release);
+
+      for (Retired* node = retired.exchange(nullptr); node != nullptr;) {
+        Retired* next = node->next;
+        delete node->table;
+        delete node;
+        node = next;
+      }
+      retired_count.store(0, std::memory_order_relaxed);
+
+      reserved.store(0, std::memory_order_relaxed);
+      published.store(0, std::memory_order_release);
     }
 
     T& operator[](size_t index) {
-      size_t page_idx = index / N;
-      size_t elt_index = index - (page_idx * N);
-      return page_table[page_idx]->elements[elt_index];
+      return *PageAt(index / N)->At(index % N);
     }
 
     const T& operator[](size_t index) const {
-      size_t page_idx = index / N;
-      size_t elt_index = index - (page_idx * N);
-      return page_table[page_idx]->elements[elt_index];
+      return *PageAt(index / N)->At(index % N);
     }
 
+    /// number of published elements , every index below it is constructed and visible to the calling thread
     size_t Size() const {
-      return elt_count;
+      return published.load(std::memory_order_acquire);
+    }
+
+    bool Empty() const {
+      return Size() == 0;
+    }
+
+    /// replaced tables that a reader may still hold , installs and growth free them as soon as that is not the case
+    size_t RetiredTables() const {
+      return retired_count.load(std::memory_order_acquire);
+    }
+
+    /// frees every retired table no open guard can reach , installs and growth already do this as they go
+    void Reclaim() {
+      Retired* node = retired.exchange(nullptr);
+      while (node != nullptr) {
+        Retired* next = node->next;
+        if (EpochDomain::Get().IsSafe(node->stamp)) {
+          delete node->table;
+          delete node;
+          retired_count.fetch_sub(1, std::memory_order_release);
+        } else {
+          PushRetired(node);
+        }
+        node = next;
+      }
+    }
+
+    template <typename... Args>
+    std::pair<uint32_t, T&> Emplace(Args&&... args) {
+      EpochDomain::Guard guard;
+
+      const uint32_t index = reserved.fetch_add(1, std::memory_order_relaxed);
+      T* slot = std::construct_at(EnsureSlot(index), std::forward<Args>(args)...);
+
+      Publish(index);
+      return { index, *slot };
+    }
+
+    template <typename... Args>
+    std::pair<uint32_t, T&> EmplaceNoLock(Args&&... args) {
+      EpochDomain::Guard guard;
+
+      const uint32_t index = reserved.load(std::memory_order_relaxed);
+      reserved.store(index + 1, std::memory_order_relaxed);
+
+      T* slot = std::construct_at(EnsureSlot(index), std::forward<Args>(args)...);
+      PageAt(index / N)->ready[index % N].store(true, std::memory_order_relaxed);
+      published.store(index + 1, std::memory_order_release);
+
+      return { index, *slot };
     }
 
     std::pair<uint32_t, T&> Insert(T&& new_elt) {
-      size_t page_idx = elt_count / N;
+      return Emplace(std::move(new_elt));
+    }
 
-      if (elt_count >= capacity) {
-        std::scoped_lock lock(mutex);
-        if (elt_count >= capacity) {
-          Page* new_page = new Page();
-          if (page_idx >= page_count) {
-            auto old_pages = page_count;
+    std::pair<uint32_t, T&> InsertNoLock(T&& new_elt) {
+      return EmplaceNoLock(std::move(new_elt));
+    }
 
-            page_count = (std::max)(uint64_t(16), page_count * 2);
-            owner<Page*[]> new_page_table = new_owner<Page*[]>(page_count);
-            std::memcpy(new_page_table.get(), page_table.load(), old_pages * sizeof(void*));
+    std::pair<uint32_t, T&> EmplaceBack() {
+      return Emplace();
+    }
 
-            page_table.exchange(new_page_table.get());
-            page_tables.push_back(std::move(new_page_table));
-          }
+    std::pair<uint32_t, T&> EmplaceBackNoLock() {
+      return EmplaceNoLock();
+    }
 
-          page_table[page_idx] = new_page;
+    /**
+     * visits the elements published when it starts , appends that land while it runs are not visited , the table is
+     *   loaded once and held under a guard for the whole walk
+     **/
+    template <typename Fn>
+    void ForEach(Fn&& fn) {
+      EpochDomain::Guard guard;
+
+      const size_t count = Size();
+      const Table* current = table.load(std::memory_order_acquire);
+      for (size_t first = 0; first < count; first += N) {
+        Page* page = current->pages[first / N].load(std::memory_order_acquire);
+        const size_t last = (std::min)(count - first, N);
+        for (size_t i = 0; i < last; ++i) {
+          fn(*page->At(i));
+        }
+      }
+    }
 
-          capacity += N;
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+      EpochDomain::Guard guard;
+
+      const size_t count = Size();
+      const Table* current = table.load(std::memory_order_acquire);
+      for (size_t first = 0; first < count; first += N) {
+        const Page* page = current->pages[first / N].load(std::memory_order_acquire);
+        const size_t last = (std::min)(count - first, N);
+        for (size_t i = 0; i < last; ++i) {
+          fn(*page->At(i));
         }
       }
+    }
 
-      uint32_t index = (++elt_count - 1);
-      uint32_t elt_index = index - (page_idx * N);
-      page_table[page_idx]->elements[elt_index] = std::move(new_elt);
-      return {
-        index,
-        page_table[page_idx]->elements[elt_index]};
+    /**
+     * ForEach split by pages over num_threads threads (0 = hardware concurrency) , the calling thread takes pages
+     *   as well , fn is called concurrently and in no particular order
+     **/
+    template <typename Fn>
+    void ParallelForEach(Fn&& fn, uint32_t num_threads = 0) {
+      ParallelPages(*this, fn, num_threads);
     }
 
-    std::pair<uint32_t, T&> InsertNoLock(T&& new_elt) {
-      size_t page_idx = elt_count / N;
+    template <typename Fn>
+    void ParallelForEach(Fn&& fn, uint32_t num_threads = 0) const {
+      ParallelPages(*this, fn, num_threads);
+    }
 
-      if (elt_count >= capacity) {
-        std::scoped_lock lock(mutex);
+   private:
+    struct Page {
+      alignas(T) std::byte storage[sizeof(T) * N];
 
-        if (elt_count >= capacity) {
-          Page* new_page = new Page();
-          if (page_idx >= page_count) {
-            uint64_t old_pages = page_count;
-            page_count = (std::max)(uint64_t(16), page_count * 2);
+      /// set once the slot is constructed , published only moves past ready slots
+      std::array<std::atomic<bool>, N> ready{};
 
-            owner<Page*[]> new_page_table = new_owner<Page*[]>(page_count);
-            std::memcpy(new_page_table.get(), page_table.load(), old_pages * sizeof(void*));
+      T* At(size_t index) {
+        return reinterpret_cast<T*>(storage) + index;
+      }
 
-            page_table.exchange(new_page_table.get());
-            page_tables.push_back(std::move(new_page_table));
-          }
+      const T* At(size_t index) const {
+        return reinterpret_cast<const T*>(storage) + index;
+      }
+    };
 
-          page_table[page_idx] = new_page;
+    struct Table {
+      explicit Table(size_t capacity)
+          : capacity(capacity), pages(new_owner<std::atomic<Page*>[]>(capacity)) {}
 
-          capacity += N;
-        }
-      }
+      size_t capacity;
+      owner<std::atomic<Page*>[]> pages;
+    };
 
-      uint32_t index = (++elt_count - 1);
-      uint32_t elt_index = index - (page_idx * N);
-      page_table[page_idx]->elements[elt_index] = std::move(new_elt);
-      return {
-        index,
-        page_table[page_idx]->elements[elt_index]};
-    }
+    /// a replaced table waiting for the readers that entered before it was replaced
+    struct Retired {
+      Table* table;
+      uint64_t stamp;
+      Retired* next = nullptr;
+    };
 
-    std::pair<uint32_t, T&> EmplaceBack() {
-      size_t page_idx = elt_count / N;
+    std::atomic<Table*> table = nullptr;
+
+    std::atomic<Retired*> retired = nullptr;
+    std::atomic<size_t> retired_count = 0;
+
+    /// slots handed out to writers
+    std::atomic<uint32_t> reserved = 0;
+
+    /// length of the constructed prefix of the reserved slots
+    std::atomic<uint32_t> published = 0;
 
-      if (elt_count >= capacity) {
-        Page* new_page = new Page();
-        if (page_idx >= page_count) {
-          uint64_t old_pages = page_count;
-          page_count = (std::max)(uint64_t(16), page_count * 2);
+    /// marks an empty entry of a table that is being copied into a larger one , never a real page
+    static Page* Frozen() {
+      return reinterpret_cast<Page*>(alignof(Page));
+    }
 
-          owner<Page*[]> new_page_table = new_owner<Page*[]>(page_count);
-          std::memcpy(new_page_table.get(), page_table.load(), old_pages * sizeof(void*));
+    /// only for pages holding published slots , those are installed before their first slot is published
+    Page* PageAt(size_t page) const {
+      EpochDomain::Guard guard;
+      return table.load(std::memory_order_acquire)->pages[page].load(std::memory_order_acquire);
+    }
 
-          page_table.exchange(new_page_table.get());
-          page_tables.push_back(std::move(new_page_table));
+    /**
+     * marks index constructed and moves published over every ready slot after it , whichever writer finishes the
+     *   slot published is stuck on carries it forward so nobody waits on a slower writer
+     *
+     * the flag store , the published updates and the flag loads are sequentially consistent , a writer marking its
+     *   slot and one advancing up to it can not both miss the other
+     **/
+    void Publish(size_t index) {
+      PageAt(index / N)->ready[index % N].store(true);
+
+      uint32_t current = published.load();
+      while (IsReady(current)) {
+        if (published.compare_exchange_weak(current, current + 1)) {
+          ++current;
         }
+      }
+    }
 
-        page_table[page_idx] = new_page;
+    /// false for slots whose page no writer has installed yet
+    bool IsReady(size_t index) const {
+      EpochDomain::Guard guard;
 
-        capacity += N;
+      const size_t page = index / N;
+      const Table* current = table.load();
+      if (current == nullptr || page >= current->capacity) {
+        return false;
       }
 
-      uint32_t index = (++elt_count - 1);
-      uint32_t elt_index = index - (page_idx * N);
-      return {
-        index,
-        page_table[page_idx]->elements[elt_index]};
+      /// a frozen entry was empty when the table was replaced , still not installed as far as this load goes
+      Page* installed = current->pages[page].load();
+      return installed != nullptr && installed != Frozen() && installed->ready[index % N].load();
     }
 
-    std::pair<uint32_t, T&> EmplaceBackNoLock() {
-      size_t page_idx = elt_count / N;
+    /// storage for a reserved index , the writer that first needs a page installs it
+    T* EnsureSlot(size_t index) {
+      EpochDomain::Guard guard;
+      return InstallPage(index / N)->At(index % N);
+    }
 
-      if (elt_count >= capacity) {
-        auto* new_page = new Page();
+    /**
+     * the page at this index of the live table , installed by the first writer to get there , guard held
+     *
+     * the installs and the freezing in Grow are sequentially consistent , an entry holds a page in every table
+     *   after the one it was installed in and can never be installed in two
+     **/
+    Page* InstallPage(size_t page) {
+      Page* fresh = nullptr;
+      while (true) {
+        Table* current = table.load();
+        if (current == nullptr || page >= current->capacity) {
+          Grow(current, page + 1);
+          continue;
+        }
 
-        if (page_idx >= page_count) {
-          auto old_pages = page_count;
-          page_count = (std::max)(uint64_t(16), page_count * 2);
+        Page* installed = current->pages[page].load();
+        if (installed == Frozen()) {
+          Grow(current, page + 1);
+          continue;
+        }
 
-          owner<Page*[]> new_page_table = new_owner<Page*[]>(page_count);
-          std::memcpy(new_page_table.get(), page_table.load(), old_pages * sizeof(void*));
+        if (installed != nullptr) {
+          delete fresh;
+          return installed;
+        }
 
-          page_table.exchange(new_page_table.get());
-          page_tables.push_back(std::move(new_page_table));
+        if (fresh == nullptr) {
+          fresh = new Page;
         }
 
-        page_table[page_idx] = new_page;
-        capacity += N;
+        if (current->pages[page].compare_exchange_strong(installed, fresh)) {
+          if (retired.load(std::memory_order_relaxed) != nullptr) {
+            Reclaim();
+          }
+          return fresh;
+        }
       }
-
-      uint32_t index = (++elt_count - 1);
-      uint32_t elt_index = index - (page_idx * N);
-      return {
-        index,
-        page_table[page_idx]->elements[elt_index]};
     }
 
-    template <typename Fn>
-    void ForEach(Fn&& fn) {
-      for (uint32_t i = 0; i < elt_count; ++i) {
-        fn((*this)[i]);
+    /**
+     * copies current into a table at least min_capacity large and swaps it in , empty entries of current are frozen
+     *   first so a late install fails and retries on the new table , a writer that loses the swap drops its copy
+     *   since the winner copied the same entries
+     **/
+    void Grow(Table* current, size_t min_capacity) {
+      const size_t old_capacity = current == nullptr ? 0 : current->capacity;
+
+      size_t new_capacity = (std::max)(size_t{ 16 }, old_capacity * 2);
+      while (new_capacity < min_capacity) {
+        new_capacity *= 2;
+      }
+
+      Table* grown = new Table(new_capacity);
+      for (size_t i = 0; i < old_capacity; ++i) {
+        Page* entry = nullptr;
+        current->pages[i].compare_exchange_strong(entry, Frozen());
+        grown->pages[i].store(entry == Frozen() ? nullptr : entry, std::memory_order_relaxed);
+      }
+
+      if (!table.compare_exchange_strong(current, grown)) {
+        delete grown;
+        return;
+      }
+
+      if (current != nullptr) {
+        PushRetired(new Retired{ .table = current, .stamp = EpochDomain::Get().Retire() });
+        retired_count.fetch_add(1, std::memory_order_relaxed);
+        Reclaim();
       }
     }
 
-    template <typename Fn>
-    void ForEach(Fn&& fn) const {
-      for (uint32_t i = 0; i < elt_count; ++i) {
-        fn((*this)[i]);
+    void PushRetired(Retired* node) {
+      node->next = retired.load(std::memory_order_relaxed);
+      while (!retired.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
       }
     }
 
-   private:
-    struct Page {
-      std::array<T, N> elements;
-    };
+    template <typename Self, typename Fn>
+    static void ParallelPages(Self& self, Fn& fn, uint32_t num_threads) {
+      const size_t count = self.Size();
+      const size_t num_pages = (count + N - 1) / N;
+      if (num_pages == 0) {
+        return;
+      }
+
+      if (num_threads == 0) {
+        num_threads = (std::max)(std::thread::hardware_concurrency(), 1u);
+      }
+      num_threads = static_cast<uint32_t>((std::min)(size_t{ num_threads }, num_pages));
+
+      using Elem = std::conditional_t<std::is_const_v<Self>, const T, T>;
+
+      /// each thread claims the next unvisited page
+      std::atomic<size_t> next = 0;
+      auto worker = [&]() {
+        EpochDomain::Guard guard;
 
-    std::shared_mutex mutex;
-    std::list<owner<Page*[]>> page_tables;
+        for (size_t p = next++; p < num_pages; p = next++) {
+          Page* page = self.PageAt(p);
+          const size_t last = (std::min)(count - p * N, N);
+          for (size_t i = 0; i < last; ++i) {
+            Elem& elem = *page->At(i);
+            fn(elem);
+          }
+        }
+      };
+
+      std::vector<std::thread> workers;
+      workers.reserve(num_threads - 1);
+      for (uint32_t i = 1; i < num_threads; ++i) {
+        workers.emplace_back(worker);
+      }
 
-    std::atomic<Page**> page_table;
-    std::atomic<uint32_t> elt_count = 0;
-    std::atomic<uint32_t> capacity = 0;
-    uint64_t page_count = 0;
+      worker();
+      for (auto& t : workers) {
+        t.join();
+      }
+    }
   };
 
 }  // namespace dotother
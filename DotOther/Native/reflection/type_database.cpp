@@ -3,18 +3,45 @@
  **/
 #include "reflection/type_database.hpp"
 
+#include <mutex>
+
+#include "core/stable_vector.hpp"
+
 namespace dotother {
 namespace echo {
+namespace {
+
+  /// appended under the mutex , read without it , a registered type never moves
+  StableVector<TypeMetadata, 64>& Registry() {
+    static StableVector<TypeMetadata, 64> registry;
+    return registry;
+  }
+
+  std::mutex registry_mutex;
+
+} // anonymous namespace
+
+namespace detail {
+
+  const TypeMetadata& Register(TypeMetadata (*describe)(uint32_t)) {
+    std::scoped_lock lock(registry_mutex);
+
+    auto& registry = Registry();
+    const uint32_t index = static_cast<uint32_t>(registry.Size());
+    return registry.EmplaceNoLock(describe(index)).second;
+  }
+
+} // namespace detail
+
+  TypeDatabase* TypeDatabase::instance = nullptr;
 
-  TypeDatabase* TypeDatabase::instance = nullptr;  
-  
   TypeDatabase& TypeDatabase::Instance() {
     if (instance == nullptr) {
       instance = new TypeDatabase;
     }
     return *instance;
   }
-      
+
   void TypeDatabase::CloseDatabase() {
     if (instance != nullptr) {
       delete instance;
@@ -22,5 +49,27 @@ namespace echo {
     }
   }
 
+  const TypeMetadata* TypeDatabase::Find(uint32_t index) const {
+    auto& registry = Registry();
+    if (index >= registry.Size()) {
+      return nullptr;
+    }
+    return &registry[index];
+  }
+
+  const TypeMetadata* TypeDatabase::Find(std::string_view name) const {
+    const TypeMetadata* found = nullptr;
+    Registry().ForEach([&](const TypeMetadata& metadata) {
+      if (found == nullptr && metadata.name == name) {
+        found = &metadata;
+      }
+    });
+    return found;
+  }
+
+  size_t TypeDatabase::Size() const {
+    return Registry().Size();
+  }
+
 } // namespace echo
 } // namespace dotother
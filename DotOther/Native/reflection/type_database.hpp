@@ -4,8 +4,10 @@
 #ifndef DOTOTHER_TYPE_DATABASE_HPP
 #define DOTOTHER_TYPE_DATABASE_HPP
 
-#include <string>
-#include <vector>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
 
 #include <refl/refl.hpp>
 
@@ -13,71 +15,106 @@ namespace dotother {
 namespace echo {
 
   struct FieldMetadata {
-    std::string name;
+    std::string_view name;
+    bool is_static = false;
   };
 
   struct MethodMetadata {
-    std::string name;
+    std::string_view name;
   };
 
+  /// everything here points at static storage generated from the type's refl descriptor , copying it is free
   struct TypeMetadata {
-    std::string name;
-    std::vector<FieldMetadata> fields{};
-    std::vector<MethodMetadata> methods{};
+    std::string_view name;
 
-    template <typename T, typename... Flds>
-    TypeMetadata(refl::type_descriptor<T> td)
-      : name(td.name) {}
+    /// dense , assigned in the order types are first looked up , stable for the life of the process
+    uint32_t index = 0;
+
+    std::span<const FieldMetadata> fields{};
+    std::span<const MethodMetadata> methods{};
   };
 
+namespace detail {
+
+  /// static storage for a member's display name so the tables can hold views into it
+  template <typename Member>
+  constexpr inline auto kDisplayName = refl::descriptor::get_display_name_const(Member{});
+
+  template <typename Member>
+  constexpr std::string_view DisplayName() {
+    return std::string_view{ kDisplayName<Member>.c_str() , kDisplayName<Member>.size };
+  }
+
+  /// field and method tables built from refl::type_descriptor<T> at compile time
+  template <typename T>
+  struct TypeTables {
+    constexpr static auto kFields = refl::util::map_to_array<FieldMetadata>(
+      refl::util::filter(refl::member_list<T>{} , [](auto member) { return refl::descriptor::is_field(member); }) ,
+      [](auto member) {
+        return FieldMetadata{
+          .name = DisplayName<decltype(member)>() ,
+          .is_static = refl::descriptor::is_static(member) ,
+        };
+      }
+    );
+
+    constexpr static auto kMethods = refl::util::map_to_array<MethodMetadata>(
+      refl::util::filter(refl::member_list<T>{} , [](auto member) { return refl::descriptor::is_function(member); }) ,
+      [](auto member) {
+        return MethodMetadata{
+          .name = DisplayName<decltype(member)>() ,
+        };
+      }
+    );
+
+    constexpr static std::string_view kName{ refl::reflect<T>().name.c_str() , refl::reflect<T>().name.size };
+
+    static TypeMetadata Describe(uint32_t index) {
+      return TypeMetadata{
+        .name = kName ,
+        .index = index ,
+        .fields = kFields ,
+        .methods = kMethods ,
+      };
+    }
+  };
+
+  /// stores the metadata under the next dense index , runs once per type
+  const TypeMetadata& Register(TypeMetadata (*describe)(uint32_t));
+
+} // namespace detail
+
+  /**
+   * every reflected type's metadata , looked up by type in O(1) without allocating
+   *
+   * the tables are generated at compile time , the first Get<T> only claims T's dense index , lookups by index or
+   *   name are for code that only has a runtime handle on the type (the scripting bridge)
+   **/
   struct TypeDatabase {
     public:
       static TypeDatabase& Instance();
       static void CloseDatabase();
 
       template <typename T>
-      const TypeMetadata& Get() {
-        refl::type_descriptor<T> td = refl::reflect<T>();
-        {
-          auto itr = std::ranges::find_if(type_data , [&](auto& tmd) -> bool {
-            if (tmd.name == std::string{ td.name.c_str() }) {
-              return true;
-            }
-          });
-          if (itr != type_data.end()) {
-            return *itr;
-          }
-        }
-
-        auto& tmd = type_data.emplace_back(td);
-        refl::util::for_each(td.members , [&](auto member) {
-          std::string name = refl::descriptor::get_display_name(member);
-
-          if constexpr (refl::descriptor::is_function(member)) {
-            auto& minfo = tmd.methods.emplace_back();
-            minfo.name = name;
-            return;
-          } 
-
-          if constexpr (refl::descriptor::is_field(member)) {
-            auto& finfo = tmd.fields.emplace_back();
-            finfo.name = name;
-            return;
-          }
-        });
-
-        return tmd;
+      const TypeMetadata& Get() const {
+        static const TypeMetadata& metadata = detail::Register(&detail::TypeTables<T>::Describe);
+        return metadata;
       }
 
+      /// null for an index no type has claimed yet
+      const TypeMetadata* Find(uint32_t index) const;
+
+      /// only finds types that were looked up through Get at least once
+      const TypeMetadata* Find(std::string_view name) const;
+
+      /// number of registered types
+      size_t Size() const;
+
     private:
       static TypeDatabase* instance;
-
-      std::vector<TypeMetadata> type_data;
   };
 
-
 } // namespace echo
 } // namespace dotother
 
-
 #endif // !DOTOTHER_TYPE_DATABASE_HPP
@@ -4,6 +4,7 @@
 #include "core/dotest.hpp"
 
 #include <core/dotother_defines.hpp>
+#include <chrono>
 #include <cstdint>
 #include <iostream>
 
@@ -138,6 +139,58 @@ TEST_F(ReflectionTests , refl_test) {
   EXPECT_EQ(fres, 420.f);
 }
 
+TEST_F(ReflectionTests, type_database_lookup) {
+  using dotother::echo::TypeDatabase;
+  using dotother::echo::TypeMetadata;
+
+  static_assert(dotother::echo::detail::TypeTables<MyStruct>::kFields.size() == 3);
+  static_assert(dotother::echo::detail::TypeTables<MyStruct>::kFields[1].name == "y");
+  static_assert(dotother::echo::detail::TypeTables<Foo>::kMethods.size() == 0);
+
+  TypeDatabase& db = TypeDatabase::Instance();
+  const TypeMetadata& my_struct = db.Get<MyStruct>();
+  const TypeMetadata& foo = db.Get<Foo>();
+
+  /// the same entry every time , and the one ReadMetadata hands out
+  EXPECT_EQ(&my_struct , &db.Get<MyStruct>());
+  MyStruct obj;
+  EXPECT_EQ(&my_struct , &static_cast<echo::reflectable&>(obj).ReadMetadata());
+
+  EXPECT_EQ(my_struct.name , "MyStruct");
+  ASSERT_EQ(my_struct.fields.size() , 3);
+  EXPECT_EQ(my_struct.fields[0].name , "x");
+  EXPECT_EQ(my_struct.fields[2].name , "z");
+  EXPECT_FALSE(my_struct.fields[0].is_static);
+
+  EXPECT_NE(my_struct.index , foo.index);
+  EXPECT_LT(my_struct.index , db.Size());
+  EXPECT_LT(foo.index , db.Size());
+  EXPECT_EQ(db.Find(foo.index) , &foo);
+  EXPECT_EQ(db.Find("MyStruct") , &my_struct);
+  EXPECT_EQ(db.Find("NotAType") , nullptr);
+  EXPECT_EQ(db.Find(static_cast<uint32_t>(db.Size())) , nullptr);
+
+  /// closing the database does not forget compile time tables
+  TypeDatabase::CloseDatabase();
+  EXPECT_EQ(&TypeDatabase::Instance().Get<MyStruct>() , &my_struct);
+}
+
+TEST_F(ReflectionTests, type_database_lookup_rate) {
+  constexpr uint32_t kLookups = 10'000'000;
+  dotother::echo::TypeDatabase& db = dotother::echo::TypeDatabase::Instance();
+
+  size_t total = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < kLookups; ++i) {
+    total += (i & 1) == 0 ?
+      db.Get<MyStruct>().fields.size() : db.Get<Foo>().methods.size();
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  EXPECT_EQ(total , kLookups / 2 * 3);
+  std::cout << fmt::format("TypeDatabase::Get : {:.1f} M lookups/s\n", kLookups / seconds / 1e6);
+}
+
 using namespace std::string_view_literals;
 TEST_F(ReflectionTests, proxy_test) {
   dotother::NObject obj(0xdeadbeef);
@@ -3,9 +3,15 @@
  **/
 #include "core/dotest.hpp"
 
+#include "core/epoch.hpp"
 #include "core/stable_vector.hpp"
 #include <gtest.h>
 
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
 using namespace dotother;
 
 struct A {
@@ -46,4 +52,206 @@ TEST_F(StableVectorTests , insert_A) {
   ASSERT_EQ(vec_a[idx].x , 1);
   ASSERT_EQ(vec_a[idx].y , 2);
   ASSERT_EQ(vec_a[idx].z , 3);
-}
\ No newline at end of file
+}
+
+TEST_F(StableVectorTests , references_survive_growth) {
+  auto [first_idx , first] = vec_a.Insert(A{ 1 , 2 , 3 });
+  A* address = &first;
+
+  for (int i = 0; i < 100'000; ++i) {
+    vec_a.Insert(A{ i , i , i });
+  }
+
+  ASSERT_EQ(vec_a.Size() , 100'001);
+  EXPECT_EQ(address , &vec_a[first_idx]);
+  EXPECT_EQ(address->z , 3);
+  EXPECT_EQ(vec_a[100'000].x , 99'999);
+}
+
+TEST_F(StableVectorTests , clear_and_reuse) {
+  for (int i = 0; i < 1000; ++i) {
+    vec.Insert(static_cast<float>(i));
+  }
+
+  StableVector<float> copy = vec;
+  vec.Clear();
+  EXPECT_EQ(vec.Size() , 0);
+  EXPECT_TRUE(vec.Empty());
+
+  auto [idx , val] = vec.Insert(5.f);
+  EXPECT_EQ(idx , 0);
+  EXPECT_EQ(val , 5.f);
+
+  ASSERT_EQ(copy.Size() , 1000);
+  EXPECT_EQ(copy[999] , 999.f);
+}
+
+TEST_F(StableVectorTests , elements_are_destroyed) {
+  auto counter = std::make_shared<int>(0);
+  {
+    StableVector<std::shared_ptr<int> , 8> owners;
+    for (int i = 0; i < 100; ++i) {
+      owners.Insert(std::shared_ptr<int>(counter));
+    }
+    EXPECT_EQ(counter.use_count() , 101);
+  }
+  EXPECT_EQ(counter.use_count() , 1);
+}
+
+TEST_F(StableVectorTests , concurrent_insert_and_read) {
+  constexpr uint32_t kWriters = 8;
+  constexpr uint32_t kPerWriter = 50'000;
+
+  /// small pages so writers keep crossing page and block boundaries
+  StableVector<std::pair<uint32_t , uint32_t> , 16> pairs;
+
+  std::atomic<bool> writing = true;
+  std::atomic<uint64_t> bad_reads = 0;
+  std::atomic<uint64_t> reads = 0;
+
+  /// every published slot has to be fully constructed , second is always the writer id times 1000
+  auto reader = [&]() {
+    while (writing.load()) {
+      const size_t size = pairs.Size();
+      for (size_t i = size > 64 ? size - 64 : 0; i < size; ++i) {
+        const auto& [writer , check] = pairs[i];
+        bad_reads += check == writer * 1000 ? 0 : 1;
+        ++reads;
+      }
+    }
+  };
+
+  std::vector<std::thread> readers;
+  for (uint32_t i = 0; i < 2; ++i) {
+    readers.emplace_back(reader);
+  }
+
+  std::vector<std::thread> writers;
+  for (uint32_t w = 0; w < kWriters; ++w) {
+    writers.emplace_back([&pairs , w]() {
+      for (uint32_t i = 0; i < kPerWriter; ++i) {
+        auto [idx , elem] = pairs.Emplace(w , w * 1000);
+        ASSERT_EQ(&elem , &pairs[idx]);
+      }
+    });
+  }
+
+  for (auto& t : writers) {
+    t.join();
+  }
+  writing = false;
+  for (auto& t : readers) {
+    t.join();
+  }
+
+  ASSERT_EQ(pairs.Size() , kWriters * kPerWriter);
+  EXPECT_EQ(bad_reads.load() , 0) << "out of " << reads.load() << " reads";
+
+  std::vector<uint32_t> per_writer(kWriters , 0);
+  pairs.ForEach([&](const std::pair<uint32_t , uint32_t>& elem) {
+    per_writer[elem.first]++;
+  });
+
+  for (uint32_t w = 0; w < kWriters; ++w) {
+    EXPECT_EQ(per_writer[w] , kPerWriter);
+  }
+}
+
+TEST_F(StableVectorTests , parallel_for_each) {
+  StableVector<uint64_t , 64> values;
+  for (uint64_t i = 0; i < 100'000; ++i) {
+    values.InsertNoLock(uint64_t{ i });
+  }
+
+  std::atomic<uint64_t> sum = 0;
+  std::atomic<uint64_t> visited = 0;
+  values.ParallelForEach([&](uint64_t& value) {
+    sum += value;
+    ++visited;
+    value *= 2;
+  } , 4);
+
+  EXPECT_EQ(visited.load() , 100'000);
+  EXPECT_EQ(sum.load() , 99'999ull * 100'000ull / 2);
+  EXPECT_EQ(values[99'999] , 99'999ull * 2);
+}
+
+TEST_F(StableVectorTests , retired_tables_are_reclaimed) {
+  StableVector<uint32_t , 16> values;
+
+  /// a reader on another thread that loaded the table before the next growth keeps it alive
+  std::atomic<bool> entered = false;
+  std::atomic<bool> release = false;
+  std::thread reader([&]() {
+    EpochDomain::Guard guard;
+    entered = true;
+    while (!release.load()) {
+      std::this_thread::yield();
+    }
+  });
+
+  while (!entered.load()) {
+    std::this_thread::yield();
+  }
+
+  /// 16 pages fill the first table , the next page doubles it
+  for (uint32_t i = 0; i < 17 * 16; ++i) {
+    values.InsertNoLock(uint32_t{ i });
+  }
+  EXPECT_EQ(values.RetiredTables() , 1);
+
+  release = true;
+  reader.join();
+
+  /// the next install frees it , after that growth with no reader around retires nothing that lingers
+  for (uint32_t i = 17 * 16; i < 100'000; ++i) {
+    values.InsertNoLock(uint32_t{ i });
+  }
+  EXPECT_EQ(values.RetiredTables() , 0);
+  EXPECT_EQ(values[99'999] , 99'999);
+}
+
+TEST_F(StableVectorTests , retired_tables_stay_bounded_under_readers) {
+  constexpr uint32_t kWriters = 4;
+  constexpr uint32_t kPerWriter = 50'000;
+
+  StableVector<uint32_t , 16> values;
+
+  std::atomic<bool> writing = true;
+  std::atomic<uint64_t> sum = 0;
+  auto reader = [&]() {
+    while (writing.load()) {
+      values.ForEach([&](const uint32_t& value) {
+        sum += value;
+      });
+    }
+  };
+
+  std::vector<std::thread> readers;
+  for (uint32_t i = 0; i < 2; ++i) {
+    readers.emplace_back(reader);
+  }
+
+  std::vector<std::thread> writers;
+  for (uint32_t w = 0; w < kWriters; ++w) {
+    writers.emplace_back([&values , w]() {
+      for (uint32_t i = 0; i < kPerWriter; ++i) {
+        values.Insert(w * kPerWriter + i);
+      }
+    });
+  }
+
+  for (auto& t : writers) {
+    t.join();
+  }
+  writing = false;
+  for (auto& t : readers) {
+    t.join();
+  }
+
+  /// 12500 pages take 10 doublings , once the readers are gone every replaced table can be freed
+  ASSERT_EQ(values.Size() , kWriters * kPerWriter);
+
+  values.Reclaim();
+  EXPECT_EQ(values.RetiredTables() , 0);
+}
@@ -0,0 +1,55 @@
+using System;
+
+namespace Other {
+
+  /// batched scene queries, the whole batch runs in parallel natively so submit everything a frame needs at once
+  public static class Physics {
+    internal static unsafe delegate*<RaycastQuery* , UInt32 , PhysicsHit* , UInt32* , UInt32 , UInt32> CastRays;
+    internal static unsafe delegate*<ShapeCastQuery* , UInt32 , PhysicsHit* , UInt32* , UInt32 , UInt32> CastShapes;
+    internal static unsafe delegate*<OverlapQuery* , UInt32 , PhysicsHit* , UInt32* , UInt32 , UInt32> Overlap;
+
+    public static UInt32 Raycast(ReadOnlySpan<RaycastQuery> queries , PhysicsHits results) {
+      Prepare(queries.Length , results);
+      unsafe {
+        fixed (RaycastQuery* q = queries)
+        fixed (PhysicsHit* h = results.hits)
+        fixed (UInt32* c = results.counts) {
+          results.TotalHits = CastRays(q , (UInt32)queries.Length , h , c , results.MaxHitsPerQuery);
+        }
+      }
+      return results.TotalHits;
+    }
+
+    public static UInt32 ShapeCast(ReadOnlySpan<ShapeCastQuery> queries , PhysicsHits results) {
+      Prepare(queries.Length , results);
+      unsafe {
+        fixed (ShapeCastQuery* q = queries)
+        fixed (PhysicsHit* h = results.hits)
+        fixed (UInt32* c = results.counts) {
+          results.TotalHits = CastShapes(q , (UInt32)queries.Length , h , c , results.MaxHitsPerQuery);
+        }
+      }
+      return results.TotalHits;
+    }
+
+    public static UInt32 Overlaps(ReadOnlySpan<OverlapQuery> queries , PhysicsHits results) {
+      Prepare(queries.Length , results);
+      unsafe {
+        fixed (OverlapQuery* q = queries)
+        fixed (PhysicsHit* h = results.hits)
+        fixed (UInt32* c = results.counts) {
+          results.TotalHits = Overlap(q , (UInt32)queries.Length , h , c , results.MaxHitsPerQuery);
+        }
+      }
+      return results.TotalHits;
+    }
+
+    /// grows results to fit the batch, a results object sized for this batch already is left alone
+    private static void Prepare(int num_queries , PhysicsHits results) {
+      if (results.NumQueries != num_queries) {
+        results.Reset(num_queries , Math.Max(results.MaxHitsPerQuery , 1u));
+      }
+    }
+  }
+
+}
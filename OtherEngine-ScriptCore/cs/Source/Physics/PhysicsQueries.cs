@@ -0,0 +1,104 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace Other {
+
+  public enum QueryShapeType : UInt32 {
+    Sphere = 0 ,
+    Box
+  }
+
+  /// layouts mirror physics/physics_queries.hpp, batches are handed to native code without copying
+  [StructLayout(LayoutKind.Sequential)]
+  public struct QueryShape {
+    public QueryShapeType type;
+
+    /// radius in x for spheres, half extents for boxes
+    public Vec3 extent;
+
+    public static QueryShape Sphere(float radius) => new QueryShape { type = QueryShapeType.Sphere , extent = new Vec3(radius) };
+    public static QueryShape Box(Vec3 half_extent) => new QueryShape { type = QueryShapeType.Box , extent = half_extent };
+  }
+
+  [StructLayout(LayoutKind.Sequential)]
+  public struct RaycastQuery {
+    public Vec3 origin;
+    public Vec3 direction;
+    public float max_distance;
+
+    public RaycastQuery(Vec3 origin , Vec3 direction , float max_distance) {
+      this.origin = origin;
+      this.direction = direction;
+      this.max_distance = max_distance;
+    }
+  }
+
+  [StructLayout(LayoutKind.Sequential)]
+  public struct ShapeCastQuery {
+    public QueryShape shape;
+    public Vec3 origin;
+    public Vec3 direction;
+    public float max_distance;
+
+    public ShapeCastQuery(QueryShape shape , Vec3 origin , Vec3 direction , float max_distance) {
+      this.shape = shape;
+      this.origin = origin;
+      this.direction = direction;
+      this.max_distance = max_distance;
+    }
+  }
+
+  [StructLayout(LayoutKind.Sequential)]
+  public struct OverlapQuery {
+    public QueryShape shape;
+    public Vec3 center;
+
+    public OverlapQuery(QueryShape shape , Vec3 center) {
+      this.shape = shape;
+      this.center = center;
+    }
+  }
+
+  [StructLayout(LayoutKind.Sequential)]
+  public struct PhysicsHit {
+    public UInt64 entity_id;
+    public Vec3 point;
+    public Vec3 normal;
+
+    /// distance along the cast as a fraction of max_distance, 0 for overlaps
+    public float fraction;
+    public UInt32 query;
+  }
+
+  /// reusable results for one batch, keep one around and Reset it each frame so submitting does not allocate
+  public class PhysicsHits {
+    internal PhysicsHit[] hits = Array.Empty<PhysicsHit>();
+    internal UInt32[] counts = Array.Empty<UInt32>();
+
+    public UInt32 MaxHitsPerQuery { get; private set; } = 0;
+    public UInt32 TotalHits { get; internal set; } = 0;
+    public int NumQueries => counts.Length;
+
+    public PhysicsHits(int num_queries = 0 , UInt32 max_hits_per_query = 1) {
+      Reset(num_queries , max_hits_per_query);
+    }
+
+    public void Reset(int num_queries , UInt32 max_hits_per_query) {
+      MaxHitsPerQuery = max_hits_per_query;
+      TotalHits = 0;
+
+      int num_hits = num_queries * (int)max_hits_per_query;
+      if (hits.Length != num_hits) {
+        hits = new PhysicsHit[num_hits];
+      }
+      if (counts.Length != num_queries) {
+        counts = new UInt32[num_queries];
+      }
+    }
+
+    /// closest first, at most one hit per entity
+    public ReadOnlySpan<PhysicsHit> this[int query] => 
+      new ReadOnlySpan<PhysicsHit>(hits , query * (int)MaxHitsPerQuery , (int)counts[query]);
+  }
+
+}
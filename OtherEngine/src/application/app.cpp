@@ -9,10 +9,14 @@
 #include "core/config_keys.hpp"
 #include "core/engine.hpp"
 #include "core/engine_state.hpp"
+#include "core/file_watcher.hpp"
+#include "core/frame_profiler.hpp"
 #include "core/logger.hpp"
+#include "core/profile.hpp"
 #include "core/time.hpp"
 
 #include "application/app_state.hpp"
+#include "asset/asset_reloader.hpp"
 #include "asset/runtime_asset_handler.hpp"
 #include "event/app_events.hpp"
 #include "event/core_events.hpp"
@@ -72,6 +76,12 @@ namespace other {
         DoEarlyUpdate(dt);
       }
 
+      /// file changes that settled since the last frame go out with everything else
+      FileWatcher::DispatchChanges();
+
+      /// assets rebuilt in the background since the last frame are swapped in here , never mid frame
+      AssetReloader::Update();
+
       /// process all events queued from io/early update/physics steps
       EventQueue::Poll(this);
 
@@ -108,7 +118,8 @@ namespace other {
 
       CHECKGL();
 
-      // FrameMark;
+      FrameProfiler::EndFrame();
+      OE_PROFILE_FRAME();
     }
 
     Detach();
@@ -387,12 +398,16 @@ namespace other {
 
   /// TODO: add early update to layers and scene
   void App::DoEarlyUpdate(float dt) {
+    OE_PROFILE_SCOPE("App::EarlyUpdate");
+
     EarlyUpdate(dt);
 
     layer_stack->InvokeControlledLoop(&Layer::EarlyUpdate, dt);
   }
 
   void App::DoUpdate(float dt) {
+    OE_PROFILE_SCOPE("App::Update");
+
     Update(dt);
 
     layer_stack->InvokeControlledLoop(&Layer::Update, dt);
@@ -411,6 +426,8 @@ namespace other {
   }
 
   void App::DoRender() {
+    OE_PROFILE_SCOPE("App::Render");
+
     Render();
 
     CHECKGL();
@@ -423,6 +440,8 @@ namespace other {
   }
 
   void App::DoRenderUI() {
+    OE_PROFILE_SCOPE("App::RenderUI");
+
     if (UI::Enabled()) {
       UI::BeginFrame();
 
@@ -45,6 +45,15 @@ namespace other {
       { "point_lights" , other::ValueType::USER_TYPE , 100 , sizeof(other::PointLight) } ,
     };
 
+    uint32_t cluster_binding_pnt = 4;
+    LightClusterGrid cluster_grid;
+    std::vector<Uniform> cluster_unis = {
+      { "cluster_grid" , other::ValueType::USER_TYPE , 1 , sizeof(glm::uvec4) } ,
+      { "cluster_depth" , other::ValueType::VEC4 } ,
+      { "clusters" , other::ValueType::USER_TYPE , cluster_grid.NumClusters() , sizeof(other::LightCluster) } ,
+      { "light_indices" , other::ValueType::UINT32 , cluster_grid.NumClusters() * kMaxLightsPerCluster } ,
+    };
+
     glm::vec2 window_size = Renderer::WindowSize();
       
     const Path shader_dir = Filesystem::GetEngineCoreDir() / "OtherEngine" / "assets" / "shaders";
@@ -57,6 +66,8 @@ namespace other {
     SceneRenderSpec spec{
       .camera_uniforms = NewRef<UniformBuffer>("Camera" , cam_unis , camera_binding_pnt) ,
       .light_uniforms = NewRef<UniformBuffer>("Lights" , light_unis , light_binding_pnt) ,
+      .cluster_uniforms = NewRef<UniformBuffer>("LightClusters" , cluster_unis , cluster_binding_pnt , SHADER_STORAGE) ,
+      .cluster_grid = cluster_grid ,
       .pipelines = {
         {
           .framebuffer_spec = {
@@ -0,0 +1,256 @@
+/**
+ * \file asset/asset_dependency_graph.cpp
+ **/
+#include "asset/asset_dependency_graph.hpp"
+
+#include <algorithm>
+#include <queue>
+#include <set>
+
+#include "core/logger.hpp"
+
+namespace other {
+namespace {
+
+  std::string NormalKey(const Path& path) {
+    return path.lexically_normal().string();
+  }
+
+  /// ready nodes come out smallest handle first so the same change always rebuilds in the same order
+  struct HandleGreater {
+    bool operator()(const AssetHandle& lhs , const AssetHandle& rhs) const {
+      return lhs.Get() > rhs.Get();
+    }
+  };
+
+} // anonymous namespace
+
+  void AssetDependencyGraph::AddAsset(AssetHandle handle , AssetType type , const Path& path) {
+    Node& node = nodes[handle];
+    if (!node.path.empty()) {
+      Unindex(handle , node.path);
+    }
+
+    node.type = type;
+    node.path = path;
+    node.file_only = false;
+
+    if (!path.empty()) {
+      files[NormalKey(path)].insert(handle);
+    }
+  }
+
+  void AssetDependencyGraph::RemoveAsset(AssetHandle handle) {
+    auto itr = nodes.find(handle);
+    if (itr == nodes.end()) {
+      return;
+    }
+
+    for (const auto& dependency : itr->second.dependencies) {
+      nodes[dependency].dependents.erase(handle);
+    }
+
+    for (const auto& dependent : itr->second.dependents) {
+      nodes[dependent].dependencies.erase(handle);
+    }
+
+    if (!itr->second.path.empty()) {
+      Unindex(handle , itr->second.path);
+    }
+    nodes.erase(itr);
+  }
+
+  void AssetDependencyGraph::AddDependency(AssetHandle dependent , AssetHandle dependency) {
+    if (dependent == dependency) {
+      OE_WARN("Asset {} can not depend on itself" , dependent);
+      return;
+    }
+
+    nodes[dependent].dependencies.insert(dependency);
+    nodes[dependency].dependents.insert(dependent);
+  }
+
+  AssetHandle AssetDependencyGraph::AddFileDependency(AssetHandle dependent , const Path& file) {
+    const AssetHandle file_handle = FileHandle(file);
+
+    auto [itr , inserted] = nodes.try_emplace(file_handle);
+    if (inserted) {
+      itr->second.type = AssetType::SOURCE_FILE;
+      itr->second.path = file;
+      itr->second.file_only = true;
+      files[NormalKey(file)].insert(file_handle);
+    }
+
+    AddDependency(dependent , file_handle);
+    return file_handle;
+  }
+
+  void AssetDependencyGraph::ClearDependencies(AssetHandle dependent) {
+    auto itr = nodes.find(dependent);
+    if (itr == nodes.end()) {
+      return;
+    }
+
+    std::vector<AssetHandle> orphaned_files;
+    for (const auto& dependency : itr->second.dependencies) {
+      Node& node = nodes[dependency];
+      node.dependents.erase(dependent);
+
+      if (node.file_only && node.dependents.empty()) {
+        orphaned_files.push_back(dependency);
+      }
+    }
+    itr->second.dependencies.clear();
+
+    /// a file nothing reads anymore has no reason to stay in the graph
+    for (const auto& file : orphaned_files) {
+      RemoveAsset(file);
+    }
+  }
+
+  std::vector<AssetHandle> AssetDependencyGraph::Invalidate(const Path& file) const {
+    return Invalidate(std::span<const Path>{ &file , 1 });
+  }
+
+  std::vector<AssetHandle> AssetDependencyGraph::Invalidate(std::span<const Path> changed) const {
+    /// everything reachable from the changed files along dependent edges
+    std::unordered_set<AssetHandle> affected;
+    std::vector<AssetHandle> stack;
+    for (const auto& file : changed) {
+      auto itr = files.find(NormalKey(file));
+      if (itr == files.end()) {
+        continue;
+      }
+
+      for (const auto& handle : itr->second) {
+        if (affected.insert(handle).second) {
+          stack.push_back(handle);
+        }
+      }
+    }
+
+    while (!stack.empty()) {
+      const AssetHandle handle = stack.back();
+      stack.pop_back();
+
+      for (const auto& dependent : nodes.at(handle).dependents) {
+        if (affected.insert(dependent).second) {
+          stack.push_back(dependent);
+        }
+      }
+    }
+
+    /// kahn's algorithm over the affected nodes only , dependencies outside the set are already up to date
+    std::unordered_map<AssetHandle , uint32_t> pending_dependencies;
+    std::priority_queue<AssetHandle , std::vector<AssetHandle> , HandleGreater> ready;
+    for (const auto& handle : affected) {
+      uint32_t count = 0;
+      for (const auto& dependency : nodes.at(handle).dependencies) {
+        count += affected.contains(dependency) ? 1 : 0;
+      }
+
+      pending_dependencies[handle] = count;
+      if (count == 0) {
+        ready.push(handle);
+      }
+    }
+
+    std::vector<AssetHandle> order;
+    order.reserve(affected.size());
+    size_t visited = 0;
+    while (!ready.empty()) {
+      const AssetHandle handle = ready.top();
+      ready.pop();
+      ++visited;
+
+      const Node& node = nodes.at(handle);
+      if (!node.file_only) {
+        order.push_back(handle);
+      }
+
+      for (const auto& dependent : node.dependents) {
+        if (--pending_dependencies[dependent] == 0) {
+          ready.push(dependent);
+        }
+      }
+    }
+
+    /// a cycle can not be ordered , its members still rebuild , after everything else
+    if (visited != affected.size()) {
+      std::set<uint64_t> cyclic;
+      for (const auto& [handle , count] : pending_dependencies) {
+        if (count > 0 && !nodes.at(handle).file_only) {
+          cyclic.insert(handle.Get());
+        }
+      }
+
+      OE_WARN("Asset dependency cycle between {} assets , rebuilding them in arbitrary order" , cyclic.size());
+      for (const auto& handle : cyclic) {
+        order.push_back(handle);
+      }
+    }
+
+    return order;
+  }
+
+  std::vector<AssetHandle> AssetDependencyGraph::Dependencies(AssetHandle handle) const {
+    auto itr = nodes.find(handle);
+    if (itr == nodes.end()) {
+      return {};
+    }
+    return { itr->second.dependencies.begin() , itr->second.dependencies.end() };
+  }
+
+  std::vector<AssetHandle> AssetDependencyGraph::Dependents(AssetHandle handle) const {
+    auto itr = nodes.find(handle);
+    if (itr == nodes.end()) {
+      return {};
+    }
+    return { itr->second.dependents.begin() , itr->second.dependents.end() };
+  }
+
+  bool AssetDependencyGraph::Contains(AssetHandle handle) const {
+    return nodes.contains(handle);
+  }
+
+  bool AssetDependencyGraph::Watches(const Path& file) const {
+    return files.contains(NormalKey(file));
+  }
+
+  Opt<AssetType> AssetDependencyGraph::TypeOf(AssetHandle handle) const {
+    auto itr = nodes.find(handle);
+    if (itr == nodes.end()) {
+      return std::nullopt;
+    }
+    return itr->second.type;
+  }
+
+  size_t AssetDependencyGraph::Size() const {
+    return nodes.size();
+  }
+
+  std::vector<Path> AssetDependencyGraph::Directories() const {
+    std::set<Path> dirs;
+    for (const auto& [file , handles] : files) {
+      dirs.insert(Path(file).parent_path());
+    }
+    return { dirs.begin() , dirs.end() };
+  }
+
+  AssetHandle AssetDependencyGraph::FileHandle(const Path& file) {
+    return AssetHandle(FNV(NormalKey(file)));
+  }
+
+  void AssetDependencyGraph::Unindex(AssetHandle handle , const Path& path) {
+    auto itr = files.find(NormalKey(path));
+    if (itr == files.end()) {
+      return;
+    }
+
+    itr->second.erase(handle);
+    if (itr->second.empty()) {
+      files.erase(itr);
+    }
+  }
+
+} // namespace other
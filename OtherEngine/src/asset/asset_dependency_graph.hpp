@@ -0,0 +1,85 @@
+/**
+ * \file asset/asset_dependency_graph.hpp
+ **/
+#ifndef OTHER_ENGINE_ASSET_DEPENDENCY_GRAPH_HPP
+#define OTHER_ENGINE_ASSET_DEPENDENCY_GRAPH_HPP
+
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "core/defines.hpp"
+
+#include "asset/asset_types.hpp"
+
+namespace other {
+
+  /**
+   * which assets are built from which files and from which other assets , shader to import , material to
+   *   shader/texture , model to texture
+   *
+   * every node is an asset handle , a node can be backed by the file it is built from , files that are only ever read
+   *   by other assets (shader imports) get a node of their own keyed by FileHandle so edges always join two nodes
+   *
+   * a file change invalidates the nodes backed by that file and everything that transitively depends on them , in an
+   *   order where every asset comes after the assets it is built from
+   **/
+  class AssetDependencyGraph {
+    public:
+      /// adds the node or updates its type and path , an empty path means the asset is not built from a file
+      void AddAsset(AssetHandle handle , AssetType type , const Path& path = "");
+
+      /// drops the node and every edge touching it
+      void RemoveAsset(AssetHandle handle);
+
+      /// dependent has to rebuild whenever dependency does
+      void AddDependency(AssetHandle dependent , AssetHandle dependency);
+
+      /// dependent reads file , returns the node standing for file
+      AssetHandle AddFileDependency(AssetHandle dependent , const Path& file);
+
+      /// removes the edges out of dependent , a rebuild clears them before recording what it actually read
+      void ClearDependencies(AssetHandle dependent);
+
+      /// assets to rebuild after the files changed , file only nodes are left out since there is nothing to rebuild
+      std::vector<AssetHandle> Invalidate(const Path& file) const;
+      std::vector<AssetHandle> Invalidate(std::span<const Path> files) const;
+
+      std::vector<AssetHandle> Dependencies(AssetHandle handle) const;
+      std::vector<AssetHandle> Dependents(AssetHandle handle) const;
+
+      bool Contains(AssetHandle handle) const;
+      bool Watches(const Path& file) const;
+      Opt<AssetType> TypeOf(AssetHandle handle) const;
+
+      /// number of nodes , file only nodes included
+      size_t Size() const;
+
+      /// directories holding at least one file the graph depends on
+      std::vector<Path> Directories() const;
+
+      /// the node a file only dependency gets
+      static AssetHandle FileHandle(const Path& file);
+
+    private:
+      struct Node {
+        AssetType type = AssetType::BLANK_ASSET;
+        Path path = "";
+        bool file_only = false;
+
+        std::unordered_set<AssetHandle> dependencies;
+        std::unordered_set<AssetHandle> dependents;
+      };
+
+      std::unordered_map<AssetHandle , Node> nodes;
+
+      /// normalized path to every node backed by it
+      std::unordered_map<std::string , std::unordered_set<AssetHandle>> files;
+
+      void Unindex(AssetHandle handle , const Path& path);
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_ASSET_DEPENDENCY_GRAPH_HPP
@@ -0,0 +1,313 @@
+/**
+ * \file asset/asset_reloader.cpp
+ **/
+#include "asset/asset_reloader.hpp"
+
+#include <chrono>
+#include <exception>
+
+#include "core/config_keys.hpp"
+#include "core/logger.hpp"
+#include "core/profile.hpp"
+#include "core/thread_pool.hpp"
+
+#include "parsing/shader_cache.hpp"
+#include "parsing/shader_compiler.hpp"
+
+namespace other {
+namespace {
+
+  int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  /// a directory is already covered when it or one of its parents is watched , watches are recursive
+  bool IsCovered(const std::unordered_map<std::string , FileWatchId>& watched , const Path& dir) {
+    for (Path parent = dir; !parent.empty(); parent = parent.parent_path()) {
+      if (watched.contains(parent.string())) {
+        return true;
+      }
+
+      if (parent == parent.parent_path()) {
+        break;
+      }
+    }
+    return false;
+  }
+
+} // anonymous namespace
+
+  Scope<AssetReloader> AssetReloader::engine_reloader = nullptr;
+
+  AssetReloader::AssetReloader(ThreadPool* pool)
+      : pool(pool) {
+  }
+
+  AssetReloader::~AssetReloader() {
+    WaitIdle();
+
+    if (FileWatcher* watcher = FileWatcher::Get(); watcher != nullptr) {
+      for (const auto& [dir , id] : watched_dirs) {
+        watcher->Unwatch(id);
+      }
+    }
+  }
+
+  AssetDependencyGraph& AssetReloader::Graph() {
+    return graph;
+  }
+
+  const AssetDependencyGraph& AssetReloader::Graph() const {
+    return graph;
+  }
+
+  void AssetReloader::Track(AssetHandle handle , AssetType type , const Path& path , AssetRebuild rebuild) {
+    graph.AddAsset(handle , type , path);
+    rebuilds[handle] = std::move(rebuild);
+
+    if (!path.empty()) {
+      WatchDirectory(path.parent_path());
+    }
+  }
+
+  void AssetReloader::Untrack(AssetHandle handle) {
+    if (rebuilds.erase(handle) == 0) {
+      return;
+    }
+
+    graph.ClearDependencies(handle);
+    graph.RemoveAsset(handle);
+  }
+
+  bool AssetReloader::IsTracked(AssetHandle handle) const {
+    return rebuilds.contains(handle);
+  }
+
+  size_t AssetReloader::QueueChanges(std::span<const Path> files) {
+    OE_PROFILE_SCOPE("AssetReloader::QueueChanges");
+
+    std::vector<AssetHandle> order = graph.Invalidate(files);
+    if (order.empty()) {
+      return 0;
+    }
+
+    StdRef<Batch> batch = NewStdRef<Batch>();
+    batch->queued_ns = NowNs();
+    batch->handles.reserve(order.size());
+    batch->rebuilds.reserve(order.size());
+    for (const auto& handle : order) {
+      auto itr = rebuilds.find(handle);
+      if (itr == rebuilds.end()) {
+        continue;
+      }
+
+      batch->handles.push_back(handle);
+      batch->rebuilds.push_back(itr->second);
+    }
+
+    if (batch->handles.empty()) {
+      return 0;
+    }
+
+    const size_t count = batch->handles.size();
+    {
+      std::lock_guard lock(batch_mutex);
+      batches.push_back(batch);
+    }
+
+    ThreadPool* target = pool != nullptr ? pool : ThreadPool::Get();
+    if (target == nullptr) {
+      Run(*batch);
+    } else {
+      target->Submit([this , batch]() {
+        Run(*batch);
+      });
+    }
+
+    OE_DEBUG("Queued {} asset rebuilds for {} changed files" , count , files.size());
+    return count;
+  }
+
+  size_t AssetReloader::QueueChanges(const std::vector<FileChange>& changes) {
+    std::vector<Path> files;
+    files.reserve(changes.size());
+    for (const auto& change : changes) {
+      files.push_back(change.path);
+      if (change.type == FileChangeType::RENAMED && !change.old_path.empty()) {
+        files.push_back(change.old_path);
+      }
+    }
+
+    if (files.empty()) {
+      return 0;
+    }
+    return QueueChanges(std::span<const Path>{ files });
+  }
+
+  size_t AssetReloader::CommitReady() {
+    OE_PROFILE_SCOPE("AssetReloader::CommitReady");
+
+    std::vector<StdRef<Batch>> ready;
+    {
+      std::lock_guard lock(batch_mutex);
+      while (!batches.empty() && batches.front()->done) {
+        ready.push_back(std::move(batches.front()));
+        batches.pop_front();
+      }
+    }
+
+    size_t committed = 0;
+    const int64_t now = NowNs();
+    for (const auto& batch : ready) {
+      for (size_t i = 0; i < batch->commits.size(); ++i) {
+        /// the asset may have been destroyed while its batch was rebuilding
+        if (!batch->commits[i] || !IsTracked(batch->handles[i])) {
+          continue;
+        }
+
+        batch->commits[i]();
+        ++committed;
+      }
+    }
+
+    if (!ready.empty()) {
+      std::lock_guard lock(batch_mutex);
+      stats.batches += ready.size();
+      stats.last_rebuild_ms = static_cast<double>(ready.back()->rebuild_ns) / 1'000'000.0;
+      stats.last_latency_ms = static_cast<double>(now - ready.back()->queued_ns) / 1'000'000.0;
+    }
+
+    return committed;
+  }
+
+  void AssetReloader::WaitIdle() {
+    std::unique_lock lock(batch_mutex);
+    batch_cv.wait(lock , [this]() -> bool {
+      for (const auto& batch : batches) {
+        if (!batch->done) {
+          return false;
+        }
+      }
+      return true;
+    });
+  }
+
+  bool AssetReloader::Idle() const {
+    std::lock_guard lock(batch_mutex);
+    return batches.empty();
+  }
+
+  AssetReloadStats AssetReloader::Stats() const {
+    std::lock_guard lock(batch_mutex);
+    return stats;
+  }
+
+  void AssetReloader::Initialize(const ConfigTable& config) {
+    OE_ASSERT(engine_reloader == nullptr , "Engine asset reloader initialized twice");
+
+    if (!config.GetVal<bool>(kAssetReloadSection , kEnabledValue , false).value_or(true)) {
+      OE_DEBUG("Asset hot reload disabled");
+      return;
+    }
+
+    engine_reloader = NewScope<AssetReloader>();
+  }
+
+  void AssetReloader::Shutdown() {
+    engine_reloader = nullptr;
+  }
+
+  AssetReloader* AssetReloader::Get() {
+    return engine_reloader.get();
+  }
+
+  void AssetReloader::Update() {
+    if (engine_reloader == nullptr) {
+      return;
+    }
+
+    if (FileWatcher* watcher = FileWatcher::Get(); watcher != nullptr && !watcher->Dispatched().empty()) {
+      engine_reloader->QueueChanges(watcher->Dispatched());
+    }
+    engine_reloader->CommitReady();
+  }
+
+  void AssetReloader::Run(Batch& batch) {
+    OE_PROFILE_SCOPE("AssetReloader::Run");
+
+    const int64_t start = NowNs();
+
+    uint64_t failed = 0;
+    batch.commits.resize(batch.rebuilds.size());
+    for (size_t i = 0; i < batch.rebuilds.size(); ++i) {
+      try {
+        batch.commits[i] = batch.rebuilds[i]();
+      } catch (const std::exception& e) {
+        OE_ERROR("Failed to rebuild asset {} : {}" , batch.handles[i] , e.what());
+      }
+
+      failed += batch.commits[i] ? 0 : 1;
+    }
+
+    {
+      std::lock_guard lock(batch_mutex);
+      batch.rebuild_ns = NowNs() - start;
+      batch.done = true;
+
+      stats.rebuilt += batch.rebuilds.size() - failed;
+      stats.failed += failed;
+
+      /// notified under the lock , a waiting destructor may free the reloader as soon as it is released
+      batch_cv.notify_all();
+    }
+  }
+
+  void AssetReloader::WatchDirectory(const Path& dir) {
+    FileWatcher* watcher = FileWatcher::Get();
+    if (watcher == nullptr) {
+      return;
+    }
+
+    const Path normal = dir.lexically_normal();
+    if (IsCovered(watched_dirs , normal)) {
+      return;
+    }
+
+    const FileWatchId id = watcher->Watch(normal);
+    if (id == kInvalidFileWatch) {
+      OE_WARN("Failed to watch {} for asset changes" , normal);
+      return;
+    }
+    watched_dirs[normal.string()] = id;
+  }
+
+  void TrackShaderSource(AssetReloader& reloader , AssetHandle handle , const Path& path ,
+                         std::function<void(const ShaderIr&)> commit) {
+    AssetReloader* owner = &reloader;
+    auto record_imports = [owner , handle](const std::vector<Path>& imports) {
+      AssetDependencyGraph& graph = owner->Graph();
+      graph.ClearDependencies(handle);
+      for (const auto& import : imports) {
+        graph.AddFileDependency(handle , import);
+        owner->WatchDirectory(import.parent_path());
+      }
+    };
+
+    reloader.Track(handle , AssetType::SHADER , path , [path , commit , record_imports]() -> AssetCommit {
+      ShaderIr ir = ShaderCompiler::Compile(path , ShaderCache::Instance());
+      std::vector<Path> imports = ShaderCompiler::Imports(path);
+
+      return [ir = std::move(ir) , imports = std::move(imports) , commit , record_imports]() {
+        record_imports(imports);
+        commit(ir);
+      };
+    });
+
+    try {
+      record_imports(ShaderCompiler::Imports(path));
+    } catch (const std::exception& e) {
+      OE_WARN("Failed to read the imports of {} , only edits to the shader itself reload it : {}" , path , e.what());
+    }
+  }
+
+} // namespace other
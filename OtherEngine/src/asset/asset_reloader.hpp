@@ -0,0 +1,137 @@
+/**
+ * \file asset/asset_reloader.hpp
+ **/
+#ifndef OTHER_ENGINE_ASSET_RELOADER_HPP
+#define OTHER_ENGINE_ASSET_RELOADER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "core/defines.hpp"
+#include "core/config.hpp"
+#include "core/file_watcher.hpp"
+
+#include "asset/asset_dependency_graph.hpp"
+#include "asset/asset_types.hpp"
+
+namespace other {
+
+  class ThreadPool;
+  struct ShaderIr;
+
+  /// runs on the main thread at a frame boundary and swaps the rebuilt data into the live asset
+  using AssetCommit = std::function<void()>;
+
+  /// runs on a worker , builds everything that does not need the main thread , an empty commit keeps the old asset
+  using AssetRebuild = std::function<AssetCommit()>;
+
+  struct AssetReloadStats {
+    uint64_t batches = 0;
+    uint64_t rebuilt = 0;
+    uint64_t failed = 0;
+
+    /// worker time spent rebuilding the last committed batch
+    double last_rebuild_ms = 0.0;
+
+    /// from the change being queued to the batch being committed
+    double last_latency_ms = 0.0;
+  };
+
+  /**
+   * rebuilds assets whose source files changed , and only those plus whatever depends on them
+   *
+   * a change set is turned into one batch through the dependency graph , the batch rebuilds on the thread pool in
+   *   dependency order and its commits all run together in CommitReady , so a frame either sees every asset of the
+   *   batch in its old state or every one in its new state , batches commit in the order they were queued
+   *
+   * the graph is only touched from the main thread , rebuild functions should not reach into it
+   **/
+  class AssetReloader {
+    public:
+      /// null pool uses the engine pool , without one rebuilds run inline when queued
+      AssetReloader(ThreadPool* pool = nullptr);
+      ~AssetReloader();
+
+      AssetReloader(const AssetReloader&) = delete;
+      AssetReloader& operator=(const AssetReloader&) = delete;
+
+      AssetDependencyGraph& Graph();
+      const AssetDependencyGraph& Graph() const;
+
+      /// adds the asset to the graph , rebuild is what runs when it or anything it depends on changes
+      void Track(AssetHandle handle , AssetType type , const Path& path , AssetRebuild rebuild);
+      void Untrack(AssetHandle handle);
+      bool IsTracked(AssetHandle handle) const;
+
+      /// queues one batch for everything the files affect , returns how many assets it rebuilds
+      size_t QueueChanges(std::span<const Path> files);
+      size_t QueueChanges(const std::vector<FileChange>& changes);
+
+      /// main thread , commits every finished batch at the front of the queue , returns how many assets were swapped
+      size_t CommitReady();
+
+      /// blocks until every queued batch finished rebuilding , nothing is committed
+      void WaitIdle();
+
+      bool Idle() const;
+      AssetReloadStats Stats() const;
+
+      /// asks the engine file watcher to watch dir for tracked files that live outside their asset's directory
+      void WatchDirectory(const Path& dir);
+
+      /// creates the engine reloader and watches every directory tracked assets come from
+      static void Initialize(const ConfigTable& config);
+      static void Shutdown();
+
+      /// null before Initialize and after Shutdown
+      static AssetReloader* Get();
+
+      /// once per frame from the main thread , queues this frame's file changes and commits finished batches
+      static void Update();
+
+    private:
+      static Scope<AssetReloader> engine_reloader;
+
+      struct Batch {
+        std::vector<AssetHandle> handles;
+        std::vector<AssetRebuild> rebuilds;
+        std::vector<AssetCommit> commits;
+
+        int64_t queued_ns = 0;
+        int64_t rebuild_ns = 0;
+        bool done = false;
+      };
+
+      ThreadPool* pool = nullptr;
+
+      std::unordered_map<AssetHandle , AssetRebuild> rebuilds;
+      AssetDependencyGraph graph;
+
+      mutable std::mutex batch_mutex;
+      std::condition_variable batch_cv;
+      std::deque<StdRef<Batch>> batches;
+
+      /// directories the engine file watcher was asked to watch on behalf of tracked assets
+      std::unordered_map<std::string , FileWatchId> watched_dirs;
+
+      AssetReloadStats stats;
+
+      void Run(Batch& batch);
+  };
+
+  /**
+   * tracks a shader source so editing it or any of its imports recompiles it off the main thread , commit receives
+   *   the fresh ir on the main thread , the import edges are refreshed from what the new source imports
+   **/
+  void TrackShaderSource(AssetReloader& reloader , AssetHandle handle , const Path& path ,
+                         std::function<void(const ShaderIr&)> commit);
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_ASSET_RELOADER_HPP
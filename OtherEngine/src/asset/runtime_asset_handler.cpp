@@ -4,6 +4,7 @@
 #include "asset/runtime_asset_handler.hpp"
 
 #include "core/logger.hpp"
+#include "core/profile.hpp"
 
 #include "asset/asset_loader.hpp"
 
@@ -146,6 +147,8 @@ namespace other {
   }
 
   void RuntimeAssetHandler::LoadAsset(AssetHandle handle) {
+    OE_PROFILE_SCOPE("RuntimeAssetHandler::LoadAsset");
+
     auto& metadata = GetMetadata(handle);
     if (metadata.IsValid()) {
       metadata.loaded = AssetLoader::Load(metadata , assets[handle]);
@@ -0,0 +1,133 @@
+/**
+ * \file core/binary_serializer.cpp
+ **/
+#include "core/binary_serializer.hpp"
+
+namespace other {
+
+  BinaryWriter::BinaryWriter(size_t capacity) {
+    bytes.reserve(capacity);
+  }
+
+  void BinaryWriter::Write(const void* src , size_t size) {
+    if (size == 0) {
+      return;
+    }
+    std::memcpy(Append(size) , src , size);
+  }
+
+  uint8_t* BinaryWriter::Append(size_t size) {
+    const size_t offset = bytes.size();
+    bytes.resize(offset + size);
+    return bytes.data() + offset;
+  }
+
+  size_t BinaryWriter::BeginLength() {
+    const size_t mark = bytes.size();
+    Write(uint32_t{ 0 });
+    return mark;
+  }
+
+  void BinaryWriter::EndLength(size_t mark) {
+    const uint32_t length = static_cast<uint32_t>(bytes.size() - mark - sizeof(uint32_t));
+    Patch(mark , &length , sizeof(length));
+  }
+
+  void BinaryWriter::Patch(size_t offset , const void* src , size_t size) {
+    std::memcpy(bytes.data() + offset , src , size);
+  }
+
+  void BinaryWriter::Clear() {
+    bytes.clear();
+  }
+
+  size_t BinaryWriter::Size() const {
+    return bytes.size();
+  }
+
+  std::span<const uint8_t> BinaryWriter::Bytes() const {
+    return bytes;
+  }
+
+  std::vector<uint8_t> BinaryWriter::Release() {
+    return std::move(bytes);
+  }
+
+  BinaryReader::BinaryReader(std::span<const uint8_t> bytes)
+      : bytes(bytes) {
+  }
+
+  bool BinaryReader::Read(void* dst , size_t size) {
+    const uint8_t* src = Consume(size);
+    if (src == nullptr) {
+      return false;
+    }
+
+    if (size > 0) {
+      std::memcpy(dst , src , size);
+    }
+    return true;
+  }
+
+  const uint8_t* BinaryReader::Consume(size_t size) {
+    if (failed || size > Remaining()) {
+      failed = true;
+      return nullptr;
+    }
+
+    const uint8_t* src = bytes.data() + offset;
+    offset += size;
+    return src;
+  }
+
+  BinaryReader BinaryReader::Take(size_t size) {
+    const uint8_t* src = Consume(size);
+    if (src == nullptr) {
+      BinaryReader empty;
+      empty.Fail();
+      return empty;
+    }
+    return BinaryReader(std::span<const uint8_t>{ src , size });
+  }
+
+  bool BinaryReader::Skip(size_t size) {
+    return Consume(size) != nullptr;
+  }
+
+  size_t BinaryReader::Offset() const {
+    return offset;
+  }
+
+  size_t BinaryReader::Remaining() const {
+    return bytes.size() - offset;
+  }
+
+  bool BinaryReader::Failed() const {
+    return failed;
+  }
+
+  void BinaryReader::Fail() {
+    failed = true;
+  }
+
+  void BinaryCodec<std::string>::Write(BinaryWriter& writer , const std::string& value) {
+    writer.Write(static_cast<uint32_t>(value.size()));
+    writer.Write(value.data() , value.size());
+  }
+
+  bool BinaryCodec<std::string>::Read(BinaryReader& reader , std::string& value) {
+    uint32_t size = 0;
+    if (!reader.Read(size)) {
+      return false;
+    }
+
+    const uint8_t* src = reader.Consume(size);
+    if (src == nullptr) {
+      return false;
+    }
+
+    value.assign(reinterpret_cast<const char*>(src) , size);
+    return true;
+  }
+
+} // namespace other
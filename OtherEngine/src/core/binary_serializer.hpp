@@ -0,0 +1,470 @@
+/**
+ * \file core/binary_serializer.hpp
+ **/
+#ifndef OTHER_ENGINE_BINARY_SERIALIZER_HPP
+#define OTHER_ENGINE_BINARY_SERIALIZER_HPP
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <refl/refl.hpp>
+
+#include "core/defines.hpp"
+
+namespace other {
+
+  static_assert(std::endian::native == std::endian::little ,
+                "binary serialization copies values as they are laid out in memory , only little endian targets are supported");
+
+  /// packed little endian bytes , nothing is aligned
+  class BinaryWriter {
+    public:
+      BinaryWriter() = default;
+
+      /// reserves room for size bytes up front , appends never reallocate until it is filled
+      explicit BinaryWriter(size_t capacity);
+
+      void Write(const void* src , size_t size);
+
+      template <typename T>
+        requires std::is_trivially_copyable_v<T>
+      void Write(const T& value) {
+        Write(&value , sizeof(T));
+      }
+
+      /// appends size bytes for the caller to fill in place
+      uint8_t* Append(size_t size);
+
+      /// writes a placeholder 32 bit length , EndLength fills it with the number of bytes written since
+      size_t BeginLength();
+      void EndLength(size_t mark);
+
+      /// overwrites bytes already written
+      void Patch(size_t offset , const void* src , size_t size);
+
+      /// drops the bytes but keeps the allocation
+      void Clear();
+
+      size_t Size() const;
+      std::span<const uint8_t> Bytes() const;
+      std::vector<uint8_t> Release();
+
+    private:
+      std::vector<uint8_t> bytes;
+  };
+
+  /// reads what a BinaryWriter wrote , a read past the end fails the reader instead of throwing
+  class BinaryReader {
+    public:
+      BinaryReader() = default;
+      explicit BinaryReader(std::span<const uint8_t> bytes);
+
+      bool Read(void* dst , size_t size);
+
+      template <typename T>
+        requires std::is_trivially_copyable_v<T>
+      bool Read(T& value) {
+        return Read(&value , sizeof(T));
+      }
+
+      /// the next size bytes without copying them , null and failed when there are not enough
+      const uint8_t* Consume(size_t size);
+
+      /// a reader over the next size bytes , this one moves past them whether or not the sub reader finishes
+      BinaryReader Take(size_t size);
+
+      bool Skip(size_t size);
+
+      size_t Offset() const;
+      size_t Remaining() const;
+      bool Failed() const;
+
+      /// marks the data invalid , used by codecs that find a value they can not accept
+      void Fail();
+
+    private:
+      std::span<const uint8_t> bytes;
+      size_t offset = 0;
+      bool failed = false;
+  };
+
+  /**
+   * refl field attribute , the field is written only while the predicate holds , used for members whose meaning
+   *   depends on another one (union members picked by a type tag)
+   *
+   * a field left out of the data keeps its value when read back , so the predicate does not need to hold on read
+   **/
+  template <typename T>
+  struct SerializeIf : refl::attr::usage::field {
+    bool (*predicate)(const T&);
+
+    constexpr SerializeIf(bool (*predicate)(const T&))
+        : predicate(predicate) {}
+  };
+
+  template <typename T>
+  struct BinaryRecord;
+
+  /// 64 bit handles (UUID , AssetHandle) are written as their id
+  template <typename T>
+  concept BinaryIdType = !std::is_trivially_copyable_v<T> && std::constructible_from<T , uint64_t> &&
+    requires (const T& value) {
+      { value.Get() } -> std::convertible_to<uint64_t>;
+    };
+
+  template <typename T>
+  concept BinaryReflectedType = !std::is_trivially_copyable_v<T> && !BinaryIdType<T> && refl::is_reflectable<T>();
+
+  /**
+   * how one value is written , specialize it for types that are neither trivially copyable nor reflected
+   *
+   * trivially copyable values are copied as they are , reflected types are written as a BinaryRecord
+   **/
+  template <typename T>
+  struct BinaryCodec {
+    static_assert(std::is_trivially_copyable_v<T> || BinaryIdType<T> || BinaryReflectedType<T> ,
+                  "type has no binary codec , reflect it with ECHO_TYPE or specialize BinaryCodec");
+
+    static void Write(BinaryWriter& writer , const T& value) {
+      if constexpr (std::is_trivially_copyable_v<T>) {
+        writer.Write(value);
+      } else if constexpr (BinaryIdType<T>) {
+        writer.Write(static_cast<uint64_t>(value.Get()));
+      } else {
+        BinaryRecord<T>::Write(writer , value);
+      }
+    }
+
+    static bool Read(BinaryReader& reader , T& value) {
+      if constexpr (std::is_trivially_copyable_v<T>) {
+        return reader.Read(value);
+      } else if constexpr (BinaryIdType<T>) {
+        uint64_t id = 0;
+        if (!reader.Read(id)) {
+          return false;
+        }
+        value = T(id);
+        return true;
+      } else {
+        return BinaryRecord<T>::Read(reader , value);
+      }
+    }
+  };
+
+  template <>
+  struct BinaryCodec<std::string> {
+    static void Write(BinaryWriter& writer , const std::string& value);
+    static bool Read(BinaryReader& reader , std::string& value);
+  };
+
+  template <typename T>
+  struct BinaryCodec<std::optional<T>> {
+    static void Write(BinaryWriter& writer , const std::optional<T>& value) {
+      writer.Write(static_cast<uint8_t>(value.has_value()));
+      if (value.has_value()) {
+        BinaryCodec<T>::Write(writer , *value);
+      }
+    }
+
+    static bool Read(BinaryReader& reader , std::optional<T>& value) {
+      uint8_t present = 0;
+      if (!reader.Read(present)) {
+        return false;
+      }
+
+      if (present == 0) {
+        value.reset();
+        return true;
+      }
+
+      T& inner = value.emplace();
+      return BinaryCodec<T>::Read(reader , inner);
+    }
+  };
+
+namespace detail {
+
+  /// every element takes at least one byte , a count larger than what is left is corrupt data , not an allocation to make
+  inline bool ReadCount(BinaryReader& reader , uint32_t& count , size_t min_element_size) {
+    if (!reader.Read(count)) {
+      return false;
+    }
+
+    if (static_cast<size_t>(count) * min_element_size > reader.Remaining()) {
+      reader.Fail();
+      return false;
+    }
+    return true;
+  }
+
+} // namespace detail
+
+  template <typename T>
+  struct BinaryCodec<std::vector<T>> {
+    static void Write(BinaryWriter& writer , const std::vector<T>& value) {
+      writer.Write(static_cast<uint32_t>(value.size()));
+      if constexpr (std::is_trivially_copyable_v<T>) {
+        writer.Write(value.data() , value.size() * sizeof(T));
+      } else {
+        for (const auto& elem : value) {
+          BinaryCodec<T>::Write(writer , elem);
+        }
+      }
+    }
+
+    static bool Read(BinaryReader& reader , std::vector<T>& value) {
+      uint32_t count = 0;
+      if (!detail::ReadCount(reader , count , std::is_trivially_copyable_v<T> ? sizeof(T) : 1)) {
+        return false;
+      }
+
+      value.clear();
+      if constexpr (std::is_trivially_copyable_v<T>) {
+        value.resize(count);
+        return reader.Read(value.data() , count * sizeof(T));
+      } else {
+        value.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+          if (!BinaryCodec<T>::Read(reader , value.emplace_back())) {
+            return false;
+          }
+        }
+        return true;
+      }
+    }
+  };
+
+  template <typename T>
+  struct BinaryCodec<std::set<T>> {
+    static void Write(BinaryWriter& writer , const std::set<T>& value) {
+      writer.Write(static_cast<uint32_t>(value.size()));
+      for (const auto& elem : value) {
+        BinaryCodec<T>::Write(writer , elem);
+      }
+    }
+
+    static bool Read(BinaryReader& reader , std::set<T>& value) {
+      uint32_t count = 0;
+      if (!detail::ReadCount(reader , count , 1)) {
+        return false;
+      }
+
+      value.clear();
+      for (uint32_t i = 0; i < count; ++i) {
+        T elem{};
+        if (!BinaryCodec<T>::Read(reader , elem)) {
+          return false;
+        }
+        value.insert(value.end() , std::move(elem));
+      }
+      return true;
+    }
+  };
+
+  template <typename K , typename V>
+  struct BinaryCodec<std::map<K , V>> {
+    static void Write(BinaryWriter& writer , const std::map<K , V>& value) {
+      writer.Write(static_cast<uint32_t>(value.size()));
+      for (const auto& [key , elem] : value) {
+        BinaryCodec<K>::Write(writer , key);
+        BinaryCodec<V>::Write(writer , elem);
+      }
+    }
+
+    static bool Read(BinaryReader& reader , std::map<K , V>& value) {
+      uint32_t count = 0;
+      if (!detail::ReadCount(reader , count , 2)) {
+        return false;
+      }
+
+      value.clear();
+      for (uint32_t i = 0; i < count; ++i) {
+        K key{};
+        V elem{};
+        if (!BinaryCodec<K>::Read(reader , key) || !BinaryCodec<V>::Read(reader , elem)) {
+          return false;
+        }
+        value.insert_or_assign(std::move(key) , std::move(elem));
+      }
+      return true;
+    }
+  };
+
+  /**
+   * the reflected members of T that are written , non static fields and readable properties with a writer
+   *
+   * on disk:
+   *   layout : u16 member count , then the u64 id (FNV of the display name) of each member
+   *   values : per member a u32 byte length then the member's bytes , a length of 0 means the member was left out
+   *
+   * members are matched by id on read so renaming or reordering the type is fine , members the reader does not know
+   *   are skipped and members the data does not have keep their current value , that is the only versioning there is ,
+   *   a member whose type changes needs a new name
+   *
+   * a pool of records shares one layout , ReadLayout maps the ids once and each record only pays for its values
+   **/
+  template <typename T>
+  struct BinaryRecord {
+    constexpr static auto kMembers = refl::util::filter(refl::member_list<T>{} , [](auto member) {
+      if constexpr (refl::descriptor::is_field(member)) {
+        return !refl::descriptor::is_static(member);
+      } else if constexpr (refl::descriptor::is_property(member) && refl::descriptor::is_readable(member)) {
+        return refl::descriptor::has_writer(member);
+      } else {
+        return false;
+      }
+    });
+
+    constexpr static size_t kNumMembers = kMembers.size;
+
+    constexpr static std::array<uint64_t , kNumMembers> kIds = refl::util::map_to_array<uint64_t>(kMembers , [](auto member) {
+      const auto name = refl::descriptor::get_display_name_const(member);
+      return FNV(std::string_view{ name.c_str() , name.size });
+    });
+
+    /// index into kMembers of each member in the data , -1 for members the reader does not know
+    using Layout = std::vector<int32_t>;
+
+    static void WriteLayout(BinaryWriter& writer) {
+      writer.Write(static_cast<uint16_t>(kNumMembers));
+      writer.Write(kIds.data() , kIds.size() * sizeof(uint64_t));
+    }
+
+    static bool ReadLayout(BinaryReader& reader , Layout& layout) {
+      uint16_t count = 0;
+      if (!reader.Read(count)) {
+        return false;
+      }
+
+      layout.assign(count , -1);
+      for (uint16_t i = 0; i < count; ++i) {
+        uint64_t id = 0;
+        if (!reader.Read(id)) {
+          return false;
+        }
+
+        for (size_t m = 0; m < kNumMembers; ++m) {
+          if (kIds[m] == id) {
+            layout[i] = static_cast<int32_t>(m);
+            break;
+          }
+        }
+      }
+      return true;
+    }
+
+    static void WriteValues(BinaryWriter& writer , const T& value) {
+      refl::util::for_each(kMembers , [&](auto member) {
+        const size_t mark = writer.BeginLength();
+        if (Included(member , value)) {
+          WriteMember(writer , member , value);
+        }
+        writer.EndLength(mark);
+      });
+    }
+
+    static bool ReadValues(BinaryReader& reader , const Layout& layout , T& value) {
+      for (const int32_t index : layout) {
+        uint32_t size = 0;
+        if (!reader.Read(size)) {
+          return false;
+        }
+
+        BinaryReader member_reader = reader.Take(size);
+        if (reader.Failed()) {
+          return false;
+        }
+
+        if (size == 0 || index < 0) {
+          continue;
+        }
+
+        bool read = true;
+        refl::util::for_each(kMembers , [&](auto member , size_t m) {
+          if (m == static_cast<size_t>(index)) {
+            read = ReadMember(member_reader , member , value);
+          }
+        });
+
+        if (!read) {
+          reader.Fail();
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /// layout and values together , for a single value outside of a pool
+    static void Write(BinaryWriter& writer , const T& value) {
+      WriteLayout(writer);
+      WriteValues(writer , value);
+    }
+
+    static bool Read(BinaryReader& reader , T& value) {
+      Layout layout;
+      return ReadLayout(reader , layout) && ReadValues(reader , layout , value);
+    }
+
+    private:
+      template <typename Member>
+      static bool Included(Member member , const T& value) {
+        if constexpr (refl::descriptor::has_attribute<SerializeIf<T>>(member)) {
+          return refl::descriptor::get_attribute<SerializeIf<T>>(member).predicate(value);
+        } else {
+          return true;
+        }
+      }
+
+      template <typename Member>
+      static void WriteMember(BinaryWriter& writer , Member member , const T& value) {
+        using Value = std::remove_cvref_t<decltype(member(value))>;
+        BinaryCodec<Value>::Write(writer , member(value));
+      }
+
+      template <typename Member>
+      static bool ReadMember(BinaryReader& reader , Member member , T& value) {
+        if constexpr (refl::descriptor::is_field(member)) {
+          using Value = typename Member::value_type;
+          return BinaryCodec<Value>::Read(reader , member(value));
+        } else {
+          /// properties are read into a copy and handed to the writer
+          using Value = std::remove_cvref_t<decltype(member(std::as_const(value)))>;
+          Value prop = member(std::as_const(value));
+          if (!BinaryCodec<Value>::Read(reader , prop)) {
+            return false;
+          }
+
+          refl::descriptor::get_writer(member)(value , prop);
+          return true;
+        }
+      }
+  };
+
+  template <typename T>
+  std::vector<uint8_t> SerializeBinary(const T& value) {
+    BinaryWriter writer;
+    BinaryCodec<T>::Write(writer , value);
+    return writer.Release();
+  }
+
+  /// false when the bytes are truncated or corrupt , value may be partially read
+  template <typename T>
+  bool DeserializeBinary(std::span<const uint8_t> bytes , T& value) {
+    BinaryReader reader(bytes);
+    return BinaryCodec<T>::Read(reader , value) && !reader.Failed();
+  }
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_BINARY_SERIALIZER_HPP
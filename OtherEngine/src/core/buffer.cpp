@@ -3,44 +3,56 @@
 */
 #include "core/buffer.hpp"
 
+#include <algorithm>
 #include <cstring>
-#include <numeric>
+#include <utility>
 
 #include "core/logger.hpp"
+#include "core/profile.hpp"
 
 namespace other {
       
   Buffer::Buffer(void* d , uint64_t sz) {
     Allocate(sz);
     Write(d , sz);
-    element_sizes.push_back(sz);
+    PushElement(sz);
   }
 
-  Buffer::Buffer(Buffer&& other) {
-    Allocate(other.capacity);
-    Write(other.data , other.capacity);
-    element_sizes = other.element_sizes;
-    other.Release();
+  Buffer::Buffer(Buffer&& other)
+      : data(std::exchange(other.data , nullptr)) , capacity(std::exchange(other.capacity , 0)) ,
+        size(std::exchange(other.size , 0)) , element_offsets(std::move(other.element_offsets)) {
+    other.element_offsets.clear();
   }
 
   Buffer::Buffer(const Buffer& other) {
-    Allocate(other.capacity);
-    Write(other.data , other.capacity);
-    element_sizes = other.element_sizes;
+    *this = other;
   }
 
   Buffer& Buffer::operator=(Buffer&& other) {
-    Allocate(other.capacity);
-    Write(other.data , other.capacity);
-    element_sizes = other.element_sizes;
-    other.Release();
+    if (this == &other) {
+      return *this;
+    }
+
+    Release();
+    data = std::exchange(other.data , nullptr);
+    capacity = std::exchange(other.capacity , 0);
+    size = std::exchange(other.size , 0);
+    element_offsets = std::move(other.element_offsets);
+    other.element_offsets.clear();
     return *this;
   }
 
   Buffer& Buffer::operator=(const Buffer& other) {
+    if (this == &other) {
+      return *this;
+    }
+
     Allocate(other.capacity);
-    Write(other.data , other.capacity);
-    element_sizes = other.element_sizes;
+    if (other.data != nullptr) {
+      Write(other.data , other.capacity);
+    }
+    size = other.size;
+    element_offsets = other.element_offsets;
     return *this;
   }
 
@@ -53,43 +65,58 @@ namespace other {
 
     capacity = sz;
     data = new uint8_t[capacity];
+    OE_PROFILE_ALLOC_NAMED(data , capacity , "Buffer");
     ZeroMem();
   }
       
-  void Buffer::Extend() {
-    size_t new_size = 2 * capacity;
+  void Buffer::Extend(uint64_t min_capacity) {
+    constexpr uint64_t kMinCapacity = 64;
+    const uint64_t new_size = std::max({ 2 * capacity , min_capacity , kMinCapacity });
     uint8_t* new_buffer = new uint8_t[new_size];
+    OE_PROFILE_ALLOC_NAMED(new_buffer , new_size , "Buffer");
     uint8_t* temp = data;
 
-    memset(new_buffer , 0 , new_size);
-    memcpy(new_buffer , data , capacity);
+    /// only the new tail needs clearing , everything before it is copied over
+    if (data != nullptr) {
+      memcpy(new_buffer , data , capacity);
+    }
+    memset(new_buffer + capacity , 0 , new_size - capacity);
 
     data = new_buffer;
+    if (temp != nullptr) {
+      OE_PROFILE_FREE_NAMED(temp , "Buffer");
+    }
     delete[] temp;
 
     capacity = new_size;
   }
 
   void Buffer::Release() {
+    if (data != nullptr) {
+      OE_PROFILE_FREE_NAMED(data , "Buffer");
+    }
     delete[] data;
     data = nullptr;
     capacity = 0;
-    element_sizes.clear();
+    size = 0;
+    element_offsets.clear();
   }
 
   void Buffer::ZeroMem() {
     if (data != nullptr) {
       memset(data , 0 , capacity);
     }
-    element_sizes.clear();
+    size = 0;
+    element_offsets.clear();
   }
       
   size_t Buffer::ElementSize(size_t index) const {
-    if (index >= element_sizes.size()) {
+    if (index >= element_offsets.size()) {
       return 0;
     }
 
-    return element_sizes[index];
+    const uint64_t end = index + 1 < element_offsets.size() ? element_offsets[index + 1] : size;
+    return end - element_offsets[index];
   }
 
   const uint8_t* Buffer::ReadBytes(uint64_t offset) const {
@@ -100,11 +127,8 @@ namespace other {
   void Buffer::Write(const void* d , uint64_t sz , uint64_t offset) {
     OE_ASSERT(offset + sz <= capacity , "Attempting to write into invalid memory! expected capacity {} + {} = {} > {} real capacity" , 
               offset , sz , offset + sz , capacity);
-    const uint8_t* d_bytes = reinterpret_cast<const uint8_t*>(d);
-    uint8_t* data_bytes = reinterpret_cast<uint8_t*>(data);
-
-    for (size_t i = offset; i < offset + sz; ++i) {
-      data_bytes[i] = d_bytes[i];
+    if (sz > 0) {
+      memcpy(data + offset , d , sz);
     }
   }
 
@@ -131,7 +155,8 @@ namespace other {
     ss << " - number elements = " << NumElements() << "\n";
 
     size_t idx = 0 , cursor = 0;
-    for (auto& elt_size : element_sizes) {
+    for (; idx < element_offsets.size(); ++idx) {
+      const uint64_t elt_size = ElementSize(idx);
 
       ss << std::dec << " -- [" << idx << " : " << elt_size << "] = ";
       ss << std::hex;
@@ -144,7 +169,6 @@ namespace other {
       }
       ss << "\n";
 
-      ++idx;
       cursor += elt_size;
     }
 
@@ -152,7 +176,7 @@ namespace other {
   }
 
   uint64_t Buffer::Size() const {
-    return std::accumulate(element_sizes.begin() , element_sizes.end() , 0);
+    return size;
   }
       
   uint64_t Buffer::Capacity() const {
@@ -160,13 +184,20 @@ namespace other {
   }
       
   uint64_t Buffer::NumElements() const {
-    return element_sizes.size();
+    return element_offsets.size();
+  }
+
+  void Buffer::PushElement(uint64_t element_size) {
+    element_offsets.push_back(size);
+    size += element_size;
   }
   
-  void Buffer::SetUniformElementSize(uint64_t num_elts , uint64_t size) {
-    element_sizes.clear();
-    element_sizes.resize(num_elts);
-    std::ranges::fill(element_sizes , size);
+  void Buffer::SetUniformElementSize(uint64_t num_elts , uint64_t element_size) {
+    element_offsets.resize(num_elts);
+    for (uint64_t i = 0; i < num_elts; ++i) {
+      element_offsets[i] = i * element_size;
+    }
+    size = num_elts * element_size;
   }
        
   SafeBuffer::~SafeBuffer() {
@@ -176,7 +207,11 @@ namespace other {
   SafeBuffer SafeBuffer::Copy(const SafeBuffer& other) {
     SafeBuffer b;
     b.Allocate(other.Size());
-    memcpy(b.data , other.data , other.Size());
+    if (other.Size() > 0) {
+      memcpy(b.data , other.data , other.Size());
+    }
+    b.size = other.size;
+    b.element_offsets = other.element_offsets;
     return b;
   }
 
@@ -5,7 +5,7 @@
 #define OTHER_ENGINE_BUFFER_HPP
 
 #include <cstdint>
-#include <numeric>
+#include <cstring>
 #include <reflection/echo_defines.hpp>
 #include <span>
 
@@ -16,6 +16,14 @@
 
 namespace other {
 
+  /**
+   * untyped byte buffer of variably sized elements
+   *
+   * the running size and each element's offset are kept as elements are appended so Size and At are constant time,
+   *   appends grow the allocation geometrically
+   *
+   * a buffer does not free itself , owners call Release (or hold a SafeBuffer)
+   **/
   class Buffer {
     public:
       Buffer() 
@@ -28,7 +36,9 @@ namespace other {
       Buffer& operator=(const Buffer& other);
 
       void Allocate(uint64_t size);
-      void Extend();
+
+      /// grows to at least min_capacity and at least double the current capacity , contents are kept
+      void Extend(uint64_t min_capacity = 0);
       void Release();
       void ZeroMem();
 
@@ -54,24 +64,23 @@ namespace other {
       void Write(const T& value) {
         if constexpr (std::same_as<T , std::string> || std::same_as<T , std::string_view>) {
           Allocate(value.length() + 1);
-          for (size_t i = 0; i < value.length(); ++i) {
-            data[i] = static_cast<uint8_t>(value[i]);
-          }
+          std::memcpy(data , value.data() , value.length());
           data[value.length()] = '\0';
           SetUniformElementSize(1, value.length());
         } else {
           size_t sz = sizeof(value);
           Allocate(sz);
           if constexpr (glm_t<T>) {
-            Write(glm::value_ptr(value) , sz , Size());
+            Write(glm::value_ptr(value) , sz);
           } else {
-            Write(&value , sz , Size());
+            Write(&value , sz);
           }
           SetUniformElementSize(1, sz);
         }
       }
 
       template <typename T>
+        requires std::is_trivially_copyable_v<T> || std::same_as<T , std::string> || std::same_as<T , std::string_view>
       void BufferData(const T& value) {
         if (Capacity() == 0) {
           if constexpr (std::same_as<T , std::string> || std::same_as<T , std::string_view>) {
@@ -83,24 +92,20 @@ namespace other {
         }
 
         if constexpr (std::same_as<T , std::string> || std::same_as<T , std::string_view>) {
-          if (Size() + value.length() > Capacity()) {
-            Extend(); 
-          }
-          for (size_t i = 0; i < value.length(); ++i) {
-            data[Size() + i] = static_cast<uint8_t>(value[i]);
+          /// the terminator is written but not counted , the next element overwrites it
+          if (size + value.length() + 1 > capacity) {
+            Extend(size + value.length() + 1); 
           }
-          data[Size() + value.length()] = '\0';
-          element_sizes.push_back(value.length());
+          std::memcpy(data + size , value.data() , value.length());
+          data[size + value.length()] = '\0';
+          PushElement(value.length());
         } else {
-          if (Size() + sizeof(value) > Capacity()) {
-            Extend(); 
+          if (size + sizeof(value) > capacity) {
+            Extend(size + sizeof(value)); 
           }
           
-          size_t sz = sizeof(value);
-          T& obj = *reinterpret_cast<T*>(data + Size());
-          obj = value;
-
-          element_sizes.push_back(sz);
+          std::memcpy(data + size , &value , sizeof(value));
+          PushElement(sizeof(value));
         }
       }
       
@@ -124,12 +129,7 @@ namespace other {
         Allocate(num_elts * sizeof(U));
         SetUniformElementSize(num_elts , sizeof(U));
 
-        size_t cursor = 0;
-        for (size_t i = start_index; i < start_index + num_elts; ++i) {
-          U current_item = container[i]; 
-          *reinterpret_cast<U*>(data + cursor) = current_item;
-          cursor += sizeof(U);
-        }
+        std::memcpy(data , container.data() + start_index , num_elts * sizeof(U));
       }
 
       operator bool() const {
@@ -151,21 +151,16 @@ namespace other {
       T& At(size_t index) {
         OE_ASSERT(sizeof(T) <= capacity , "Attempting to retrieve data with incorrectly sized type! sizeof({}) == {} > {}" , 
                   typeid(T).name() , sizeof(T) , capacity);
-        OE_ASSERT(index < element_sizes.size() , "Attempting to retrieve invalid index! expected {} > {} num elements" , index , element_sizes.size());
-        OE_ASSERT(sizeof(T) == element_sizes[index] , "Attempting to access buffer with invalidly sized type {}! expected size {} != {} stored size" ,
-                  typeid(T).name() , sizeof(T) , element_sizes[index]);
-        size_t offset = std::accumulate(element_sizes.begin() , element_sizes.begin() + index , 0);
-        if (glm_t<T>) {
-          return *reinterpret_cast<T*>((float*)(data + offset));
-        } else {
-          return *reinterpret_cast<T*>(data + offset);
-        }
+        OE_ASSERT(index < element_offsets.size() , "Attempting to retrieve invalid index! expected {} > {} num elements" , index , element_offsets.size());
+        OE_ASSERT(sizeof(T) == ElementSize(index) , "Attempting to access buffer with invalidly sized type {}! expected size {} != {} stored size" ,
+                  typeid(T).name() , sizeof(T) , ElementSize(index));
+        return *reinterpret_cast<T*>(data + element_offsets[index]);
       };
       
       template <typename T>
         requires std::is_trivially_copyable_v<T>
       const T& At(size_t index) const {
-        return At<T>(index);
+        return const_cast<Buffer*>(this)->At<T>(index);
       };
 
       std::string DumpBuffer() const;
@@ -177,8 +172,14 @@ namespace other {
     protected:
       uint8_t* data = nullptr;
       uint64_t capacity = 0;
-      std::vector<uint64_t> element_sizes;
 
+      /// bytes in use , the end of the last element
+      uint64_t size = 0;
+
+      /// where each element starts , an element ends where the next one starts or at size
+      std::vector<uint64_t> element_offsets;
+
+      void PushElement(uint64_t element_size);
       void SetUniformElementSize(uint64_t num_elts , uint64_t size);
   };
 
@@ -100,20 +100,28 @@ namespace other {
       std::transform(k.begin(), k.end(), k.begin(), toupper);
     }
 
-    auto sec_hash = FNV(sec);
-    auto key_hash = FNV(k);
+    if (const auto* values = Find(FNV(sec), FNV(k)); values != nullptr) {
+      return *values;
+    }
 
-    auto itr = table.find(sec_hash);
-    if (itr != table.end()) {
-      if (auto itr2 = itr->second.find(key_hash); itr2 != itr->second.end()) {
-        std::vector<std::string> ret = itr->second.at(key_hash);
-        return ret;
-      }
+    return {};
+  }
 
-      return {};
+  const std::vector<std::string>* ConfigTable::Find(StringId section, StringId key) const {
+    return Find(section.Hash(), key.Hash());
+  }
+
+  const std::vector<std::string>* ConfigTable::Find(uint64_t section_hash, uint64_t key_hash) const {
+    auto itr = table.find(section_hash);
+    if (itr == table.end()) {
+      return nullptr;
     }
 
-    return {};
+    if (auto itr2 = itr->second.find(key_hash); itr2 != itr->second.end()) {
+      return &itr2->second;
+    }
+
+    return nullptr;
   }
 
   template <>
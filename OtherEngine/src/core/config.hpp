@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "core/defines.hpp"
+#include "core/string_id.hpp"
 
 namespace other {
 
@@ -24,6 +25,10 @@ namespace other {
     const std::vector<std::string> Get(const std::string_view section, const std::string_view key, bool case_sensitive_key = false) const;
     const std::vector<std::string> GetKeys(const std::string_view section) const;
 
+    /// lookup by id , section and key have to be upper case already (or exactly as added for case sensitive keys) ,
+    ///   nothing is copied or hashed. nullptr when the key does not exist
+    const std::vector<std::string>* Find(StringId section, StringId key) const;
+
     template <typename T>
     const Opt<T> GetVal(const std::string_view section, const std::string_view key, bool case_sensitive_key) const;
 
@@ -34,6 +39,8 @@ namespace other {
     std::map<uint64_t, std::string> key_map;
     std::map<uint64_t, std::vector<std::string>> key_names;
     std::map<uint64_t, std::map<uint64_t, std::vector<std::string>>> table;
+
+    const std::vector<std::string>* Find(uint64_t section_hash, uint64_t key_hash) const;
   };
 
 }  // namespace other
@@ -32,6 +32,18 @@ namespace other {
   constexpr static std::string_view kLogSection = "LOG";
   constexpr static uint64_t kLogSectionHash = FNV(kLogSection);
 
+  constexpr static std::string_view kThreadPoolSection = "THREAD-POOL";
+  constexpr static uint64_t kThreadPoolSectionHash = FNV(kThreadPoolSection);
+
+  constexpr static std::string_view kProfilerSection = "PROFILER";
+  constexpr static uint64_t kProfilerSectionHash = FNV(kProfilerSection);
+
+  constexpr static std::string_view kFileWatcherSection = "FILE-WATCHER";
+  constexpr static uint64_t kFileWatcherSectionHash = FNV(kFileWatcherSection);
+
+  constexpr static std::string_view kAssetReloadSection = "ASSET-RELOAD";
+  constexpr static uint64_t kAssetReloadSectionHash = FNV(kAssetReloadSection);
+
   constexpr static std::string_view kScriptEngineSection = "SCRIPT-ENGINE";
   constexpr static uint64_t kScriptEngineSectionHash = FNV(kScriptEngineSection);
 
@@ -387,9 +399,60 @@ namespace other {
   constexpr static std::string_view kColliderValue = "COLLIDER";
   constexpr static uint64_t kColliderValueHash = FNV(kColliderValue);
 
+  constexpr static std::string_view kShapeValue = "SHAPE";
+  constexpr static uint64_t kShapeValueHash = FNV(kShapeValue);
+
+  constexpr static std::string_view kBoxValue = "BOX";
+  constexpr static uint64_t kBoxValueHash = FNV(kBoxValue);
+
+  constexpr static std::string_view kSphereValue = "SPHERE";
+  constexpr static uint64_t kSphereValueHash = FNV(kSphereValue);
+
+  constexpr static std::string_view kCapsuleValue = "CAPSULE";
+  constexpr static uint64_t kCapsuleValueHash = FNV(kCapsuleValue);
+
   constexpr static std::string_view kLightSourceValue = "LIGHT-SOURCE";
   constexpr static uint64_t kLightSourceHash = FNV(kLightSourceValue);
 
+  constexpr static std::string_view kGcBudgetValue = "GC-BUDGET-US";
+  constexpr static uint64_t kGcBudgetValueHash = FNV(kGcBudgetValue);
+
+  constexpr static std::string_view kShaderCacheValue = "SHADER-CACHE";
+  constexpr static uint64_t kShaderCacheValueHash = FNV(kShaderCacheValue);
+
+  constexpr static std::string_view kStepRateValue = "STEP-RATE";
+  constexpr static uint64_t kStepRateValueHash = FNV(kStepRateValue);
+
+  constexpr static std::string_view kMaxSubStepsValue = "MAX-SUB-STEPS";
+  constexpr static uint64_t kMaxSubStepsValueHash = FNV(kMaxSubStepsValue);
+
+  constexpr static std::string_view kWorkersValue = "WORKERS";
+  constexpr static uint64_t kWorkersValueHash = FNV(kWorkersValue);
+
+  constexpr static std::string_view kTempAllocatorValue = "TEMP-ALLOCATOR-MB";
+  constexpr static uint64_t kTempAllocatorValueHash = FNV(kTempAllocatorValue);
+
+  constexpr static std::string_view kEnabledValue = "ENABLED";
+  constexpr static uint64_t kEnabledValueHash = FNV(kEnabledValue);
+
+  constexpr static std::string_view kTraceFileValue = "TRACE-FILE";
+  constexpr static uint64_t kTraceFileValueHash = FNV(kTraceFileValue);
+
+  constexpr static std::string_view kTraceFramesValue = "TRACE-FRAMES";
+  constexpr static uint64_t kTraceFramesValueHash = FNV(kTraceFramesValue);
+
+  constexpr static std::string_view kBackendValue = "BACKEND";
+  constexpr static uint64_t kBackendValueHash = FNV(kBackendValue);
+
+  constexpr static std::string_view kDebounceValue = "DEBOUNCE-MS";
+  constexpr static uint64_t kDebounceValueHash = FNV(kDebounceValue);
+
+  constexpr static std::string_view kPollIntervalValue = "POLL-INTERVAL-MS";
+  constexpr static uint64_t kPollIntervalValueHash = FNV(kPollIntervalValue);
+
+  constexpr static std::string_view kMaxEventsPerFrameValue = "MAX-EVENTS-PER-FRAME";
+  constexpr static uint64_t kMaxEventsPerFrameValueHash = FNV(kMaxEventsPerFrameValue);
+
 }  // namespace other
 
 #endif  // !OTHER_ENGINE_CONFIG_KEYS_HPP
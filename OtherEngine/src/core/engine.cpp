@@ -9,11 +9,15 @@
 #include "core/config_keys.hpp"
 #include "core/defines.hpp"
 #include "core/engine_state.hpp"
+#include "core/file_watcher.hpp"
 #include "core/filesystem.hpp"
+#include "core/frame_profiler.hpp"
 #include "core/logger.hpp"
+#include "core/thread_pool.hpp"
 
 #include "application/app_state.hpp"
 #include "application/runtime_layer.hpp"
+#include "asset/asset_reloader.hpp"
 #include "event/event_queue.hpp"
 #include "input/io.hpp"
 #include "parsing/ini_parser.hpp"
@@ -151,7 +155,11 @@ namespace other {
 
   void Engine::Launch() {
     IO::Initialize();
+    FrameProfiler::Initialize(config);
+    ThreadPool::Initialize(config);
     EventQueue::Initialize(config);
+    FileWatcher::Initialize(config);
+    AssetReloader::Initialize(config);
 
     Renderer::Initialize(config);
     CHECKGL();
@@ -169,7 +177,11 @@ namespace other {
 
     UI::Shutdown();
     Renderer::Shutdown();
+    AssetReloader::Shutdown();
+    FileWatcher::Shutdown();
     EventQueue::Shutdown();
+    ThreadPool::Shutdown();
+    FrameProfiler::Shutdown();
     IO::Shutdown();
 
     OE_INFO("Shutdown complete");
@@ -3,26 +3,691 @@
  **/
 #include "core/file_watcher.hpp"
 
-#include "core/platform.hpp"
+#include <algorithm>
 #include <filesystem>
+#include <system_error>
+
+#include "core/platform.hpp"
+
+#ifdef OE_LINUX
+  #include <cerrno>
+  #include <cstring>
+
+  #include <poll.h>
+  #include <sys/inotify.h>
+  #include <unistd.h>
+#endif
+
+#include "core/config_keys.hpp"
+#include "core/logger.hpp"
+#include "core/profile.hpp"
+
+#include "event/event_queue.hpp"
+#include "event/file_events.hpp"
 
 namespace other {
+namespace {
+
+  /// how long the watcher thread blocks at most , bounds how long Shutdown waits
+  constexpr std::chrono::milliseconds kWaitSlice{ 50 };
+
+  int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
 
-  FileWatcher::FileWatcher(const std::string_view file_path) {
-    this->file_path = file_path;
-    last_write = std::filesystem::last_write_time(Path{ file_path });
+  /// the form every path is compared and keyed in , no trailing separator
+  Path NormalizeRoot(const Path& root) {
+    Path normal = root.lexically_normal();
+    if (!normal.has_filename() && normal.has_parent_path() && normal != normal.root_path()) {
+      normal = normal.parent_path();
+    }
+    return normal;
   }
 
-  bool FileWatcher::ChangedSinceLastCheck() {
-    bool changed = false;
+  std::vector<Path> CollectDirectories(const Path& root) {
+    std::vector<Path> dirs{ root };
+
+    std::error_code ec;
+    for (auto it = std::filesystem::recursive_directory_iterator(root , std::filesystem::directory_options::skip_permission_denied , ec);
+         !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+      if (it->is_directory(ec)) {
+        dirs.push_back(it->path());
+      }
+    }
+    return dirs;
+  }
+
+#ifdef OE_LINUX
+
+  class InotifyBackend : public FileWatchBackend {
+    public:
+      InotifyBackend(int fd)
+          : fd(fd) {}
+
+      virtual ~InotifyBackend() override {
+        close(fd);
+      }
+
+      virtual std::string_view Name() const override {
+        return "inotify";
+      }
+
+      virtual bool AddRoot(const Path& root) override {
+        if (!std::filesystem::is_directory(root)) {
+          OE_ERROR("File watcher root {} is not a directory" , root);
+          return false;
+        }
+
+        bool all_added = true;
+        for (const auto& dir : CollectDirectories(root)) {
+          all_added = AddDirectory(dir , 1) && all_added;
+        }
+        return all_added;
+      }
+
+      virtual void RemoveRoot(const Path& root) override {
+        const std::string prefix = root.string() + "/";
+
+        std::vector<int> released;
+        for (auto& [wd , dir] : directories) {
+          const std::string& path = dir.path.native();
+          if (path != root.native() && !path.starts_with(prefix)) {
+            continue;
+          }
+
+          if (--dir.refs == 0) {
+            released.push_back(wd);
+          }
+        }
+
+        for (int wd : released) {
+          inotify_rm_watch(fd , wd);
+          directories.erase(wd);
+        }
+      }
+
+      virtual void Wait(std::chrono::milliseconds timeout) override {
+        pollfd pfd{ .fd = fd , .events = POLLIN , .revents = 0 };
+        poll(&pfd , 1 , static_cast<int>(timeout.count()));
+      }
+
+      virtual void Collect(std::vector<FileChange>& changes) override {
+        while (true) {
+          const ssize_t len = read(fd , buffer , sizeof(buffer));
+          if (len <= 0) {
+            break;
+          }
+
+          for (ssize_t offset = 0; offset < len;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            Process(*event , changes);
+            offset += sizeof(inotify_event) + event->len;
+          }
+        }
+
+        /// the kernel queues both halves of a move back to back , a lone half left or entered the watched tree
+        for (auto& [cookie , path] : moved_from) {
+          changes.push_back({ .path = std::move(path) , .type = FileChangeType::REMOVED });
+        }
+        moved_from.clear();
+      }
+
+    private:
+      constexpr static uint32_t kEventMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM |
+                                             IN_MOVED_TO | IN_DELETE_SELF | IN_ONLYDIR;
+
+      struct WatchedDirectory {
+        Path path;
+        uint32_t refs = 0;
+      };
+
+      int fd = -1;
+      std::unordered_map<int , WatchedDirectory> directories;
+      std::unordered_map<uint32_t , Path> moved_from;
+
+      alignas(inotify_event) char buffer[64 * 1024];
+
+      bool AddDirectory(const Path& dir , uint32_t refs) {
+        const int wd = inotify_add_watch(fd , dir.c_str() , kEventMask);
+        if (wd < 0) {
+          if (errno == ENOSPC) {
+            OE_ERROR("Out of inotify watches adding {} , raise fs.inotify.max_user_watches" , dir);
+          } else {
+            OE_ERROR("Failed to watch {} : {}" , dir , std::strerror(errno));
+          }
+          return false;
+        }
+
+        /// the kernel hands back the same descriptor for a directory that is already watched
+        auto& watched = directories[wd];
+        watched.path = dir;
+        watched.refs += refs;
+        return true;
+      }
+
+      /// a directory that appeared inside a watched one , its files may already exist by the time we get here
+      void AddCreatedDirectory(const Path& dir , uint32_t refs , std::vector<FileChange>& changes) {
+        for (const auto& sub_dir : CollectDirectories(dir)) {
+          AddDirectory(sub_dir , refs);
+
+          std::error_code ec;
+          for (const auto& entry : std::filesystem::directory_iterator(sub_dir , ec)) {
+            if (entry.is_regular_file(ec)) {
+              changes.push_back({ .path = entry.path() , .type = FileChangeType::CREATED });
+            }
+          }
+        }
+      }
+
+      void Process(const inotify_event& event , std::vector<FileChange>& changes) {
+        if (event.mask & IN_Q_OVERFLOW) {
+          OE_WARN("inotify queue overflowed , some file changes were lost");
+          return;
+        }
+
+        auto dir = directories.find(event.wd);
+        if (dir == directories.end()) {
+          return;
+        }
+
+        if (event.mask & (IN_DELETE_SELF | IN_IGNORED)) {
+          directories.erase(dir);
+          return;
+        }
+
+        if (event.len == 0) {
+          return;
+        }
+
+        const Path path = dir->second.path / event.name;
+        if (event.mask & IN_ISDIR) {
+          if (event.mask & (IN_CREATE | IN_MOVED_TO)) {
+            AddCreatedDirectory(path , dir->second.refs , changes);
+          }
+          return;
+        }
+
+        if (event.mask & IN_CREATE) {
+          changes.push_back({ .path = path , .type = FileChangeType::CREATED });
+        } else if (event.mask & (IN_MODIFY | IN_CLOSE_WRITE)) {
+          changes.push_back({ .path = path , .type = FileChangeType::MODIFIED });
+        } else if (event.mask & IN_DELETE) {
+          changes.push_back({ .path = path , .type = FileChangeType::REMOVED });
+        } else if (event.mask & IN_MOVED_FROM) {
+          moved_from[event.cookie] = path;
+        } else if (event.mask & IN_MOVED_TO) {
+          auto from = moved_from.find(event.cookie);
+          if (from == moved_from.end()) {
+            changes.push_back({ .path = path , .type = FileChangeType::CREATED });
+            return;
+          }
+
+          changes.push_back({ .path = path , .old_path = std::move(from->second) , .type = FileChangeType::RENAMED });
+          moved_from.erase(from);
+        }
+      }
+  };
+
+#endif // OE_LINUX
+
+  /// rescans every root each interval and diffs write times , renames show up as a remove and a create
+  class PollingBackend : public FileWatchBackend {
+    public:
+      PollingBackend(std::chrono::milliseconds interval)
+          : interval(interval) {}
+
+      virtual std::string_view Name() const override {
+        return "polling";
+      }
+
+      virtual bool AddRoot(const Path& root) override {
+        if (!std::filesystem::is_directory(root)) {
+          OE_ERROR("File watcher root {} is not a directory" , root);
+          return false;
+        }
+
+        auto& watched = roots[root.string()];
+        if (watched.refs++ == 0) {
+          watched.path = root;
+          Scan(root , watched.files);
+        }
+        return true;
+      }
+
+      virtual void RemoveRoot(const Path& root) override {
+        auto itr = roots.find(root.string());
+        if (itr != roots.end() && --itr->second.refs == 0) {
+          roots.erase(itr);
+        }
+      }
+
+      virtual void Wait(std::chrono::milliseconds timeout) override {
+        std::this_thread::sleep_for(timeout);
+      }
+
+      virtual void Collect(std::vector<FileChange>& changes) override {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_scan < interval) {
+          return;
+        }
+        last_scan = now;
+
+        for (auto& [key , root] : roots) {
+          std::unordered_map<std::string , std::filesystem::file_time_type> files;
+          files.reserve(root.files.size());
+          Scan(root.path , files);
+
+          for (const auto& [path , write_time] : files) {
+            auto previous = root.files.find(path);
+            if (previous == root.files.end()) {
+              changes.push_back({ .path = path , .type = FileChangeType::CREATED });
+            } else if (previous->second != write_time) {
+              changes.push_back({ .path = path , .type = FileChangeType::MODIFIED });
+            }
+          }
+
+          for (const auto& [path , write_time] : root.files) {
+            if (!files.contains(path)) {
+              changes.push_back({ .path = path , .type = FileChangeType::REMOVED });
+            }
+          }
+
+          root.files = std::move(files);
+        }
+      }
+
+    private:
+      struct WatchedRoot {
+        Path path;
+        uint32_t refs = 0;
+        std::unordered_map<std::string , std::filesystem::file_time_type> files;
+      };
+
+      std::chrono::milliseconds interval;
+      std::chrono::steady_clock::time_point last_scan = std::chrono::steady_clock::now();
+      std::unordered_map<std::string , WatchedRoot> roots;
+
+      static void Scan(const Path& root , std::unordered_map<std::string , std::filesystem::file_time_type>& files) {
+        std::error_code ec;
+        for (auto it = std::filesystem::recursive_directory_iterator(root , std::filesystem::directory_options::skip_permission_denied , ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+          std::error_code file_ec;
+          if (!it->is_regular_file(file_ec)) {
+            continue;
+          }
+
+          const auto write_time = it->last_write_time(file_ec);
+          if (!file_ec) {
+            files[it->path().string()] = write_time;
+          }
+        }
+      }
+  };
+
+} // anonymous namespace
+
+  std::string_view FileChangeTypeName(FileChangeType type) {
+    switch (type) {
+      case FileChangeType::CREATED: return "created";
+      case FileChangeType::MODIFIED: return "modified";
+      case FileChangeType::REMOVED: return "removed";
+      case FileChangeType::RENAMED: return "renamed";
+      default: return "unknown";
+    }
+  }
+
+  Scope<FileWatchBackend> CreateInotifyBackend() {
+#ifdef OE_LINUX
+    const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+      OE_WARN("inotify unavailable : {}" , std::strerror(errno));
+      return nullptr;
+    }
+    return NewScope<InotifyBackend>(fd);
+#else
+    return nullptr;
+#endif
+  }
+
+  Scope<FileWatchBackend> CreatePollingBackend(std::chrono::milliseconds interval) {
+    return NewScope<PollingBackend>(interval);
+  }
+
+  FileWatcherSettings FileWatcherSettings::FromConfig(const ConfigTable& config) {
+    FileWatcherSettings settings;
+    settings.enabled = config.GetVal<bool>(kFileWatcherSection , kEnabledValue , false).value_or(settings.enabled);
+
+    const std::string backend = config.GetVal<std::string>(kFileWatcherSection , kBackendValue , false).value_or("INOTIFY");
+    settings.force_polling = backend == "POLLING";
+
+    settings.debounce = std::chrono::milliseconds(
+      config.GetVal<uint32_t>(kFileWatcherSection , kDebounceValue , false).value_or(settings.debounce.count()));
+    settings.poll_interval = std::chrono::milliseconds(
+      config.GetVal<uint32_t>(kFileWatcherSection , kPollIntervalValue , false).value_or(settings.poll_interval.count()));
+    settings.max_events_per_frame =
+      config.GetVal<uint32_t>(kFileWatcherSection , kMaxEventsPerFrameValue , false).value_or(settings.max_events_per_frame);
+    return settings;
+  }
+
+  Scope<FileWatcher> FileWatcher::engine_watcher = nullptr;
+
+  FileWatcher::FileWatcher(const FileWatcherSettings& settings)
+      : settings(settings) , start_ns(NowNs()) {
+    if (!settings.force_polling) {
+      backend = CreateInotifyBackend();
+    }
+
+    if (backend == nullptr) {
+      backend = CreatePollingBackend(settings.poll_interval);
+    }
 
-    auto new_write_time = std::filesystem::last_write_time(file_path);
-    if (last_write != new_write_time) {
-      changed = true;
-    } 
+    thread = std::thread([this]() { ThreadMain(); });
+  }
+
+  FileWatcher::~FileWatcher() {
+    stopping = true;
+    thread.join();
+  }
+
+  FileWatchId FileWatcher::Watch(const Path& root , std::vector<std::string> extensions) {
+    const Path normal = NormalizeRoot(root);
+
+    std::lock_guard lock(watch_mutex);
+    if (!backend->AddRoot(normal)) {
+      return kInvalidFileWatch;
+    }
+
+    const FileWatchId id = next_watch++;
+    watches[id] = WatchEntry{
+      .root = normal ,
+      .root_prefix = (normal / "").string() ,
+      .extensions = std::move(extensions) ,
+    };
+    return id;
+  }
+
+  void FileWatcher::Unwatch(FileWatchId id) {
+    std::lock_guard lock(watch_mutex);
+    auto itr = watches.find(id);
+    if (itr == watches.end()) {
+      return;
+    }
+
+    backend->RemoveRoot(itr->second.root);
+    watches.erase(itr);
+  }
+
+  uint32_t FileWatcher::Consume(FileWatchId id , uint32_t mask) {
+    std::lock_guard lock(watch_mutex);
+    auto itr = watches.find(id);
+    if (itr == watches.end()) {
+      return 0;
+    }
+
+    const uint32_t flags = itr->second.flags & mask;
+    itr->second.flags &= ~mask;
+    return flags;
+  }
+
+  std::vector<FileChange> FileWatcher::TakeChanges() {
+    OE_PROFILE_SCOPE("FileWatcher::TakeChanges");
+
+    const int64_t settled_before = NowNs() - std::chrono::duration_cast<std::chrono::nanoseconds>(settings.debounce).count();
+
+    std::vector<PendingChange> ready;
+    {
+      std::lock_guard lock(watch_mutex);
+      for (auto itr = pending.begin(); itr != pending.end();) {
+        if (itr->second.last_ns > settled_before) {
+          ++itr;
+          continue;
+        }
+
+        ready.push_back(std::move(itr->second));
+        itr = pending.erase(itr);
+      }
+    }
+
+    std::ranges::sort(ready , {} , &PendingChange::sequence);
+
+    std::vector<FileChange> changes;
+    changes.reserve(ready.size());
+    for (auto& r : ready) {
+      changes.push_back(std::move(r.change));
+    }
+
+    changes_taken += changes.size();
+    return changes;
+  }
+
+  void FileWatcher::PushEvents() {
+    dispatched.clear();
+
+    std::vector<FileChange> taken = TakeChanges();
+    backlog.insert(backlog.end() , std::make_move_iterator(taken.begin()) , std::make_move_iterator(taken.end()));
+    if (backlog.empty()) {
+      return;
+    }
+
+    const size_t count = std::min<size_t>(backlog.size() , settings.max_events_per_frame);
+    dispatched.assign(std::make_move_iterator(backlog.begin()) , std::make_move_iterator(backlog.begin() + count));
+    backlog.erase(backlog.begin() , backlog.begin() + count);
+
+    for (uint32_t i = 0; i < dispatched.size(); ++i) {
+      EventQueue::PushEvent<FileChangedEvent>(dispatched[i].type , i);
+    }
+  }
+
+  const std::vector<FileChange>& FileWatcher::Dispatched() const {
+    return dispatched;
+  }
+
+  std::string_view FileWatcher::BackendName() const {
+    return backend->Name();
+  }
+
+  FileWatcherStats FileWatcher::Stats() const {
+    FileWatcherStats stats;
+    {
+      std::lock_guard lock(watch_mutex);
+      stats.roots = static_cast<uint32_t>(watches.size());
+    }
+
+    stats.raw_changes = raw_changes.load();
+    stats.changes_taken = changes_taken.load();
+    stats.busy_ms = static_cast<double>(busy_ns.load()) / 1e6;
+    stats.wall_ms = static_cast<double>(NowNs() - start_ns) / 1e6;
+    return stats;
+  }
+
+  void FileWatcher::Initialize(const ConfigTable& config) {
+    OE_ASSERT(engine_watcher == nullptr , "Engine file watcher initialized twice");
+
+    FileWatcherSettings settings = FileWatcherSettings::FromConfig(config);
+    if (!settings.enabled) {
+      OE_DEBUG("Engine file watcher disabled");
+      return;
+    }
+
+    engine_watcher = NewScope<FileWatcher>(settings);
+    OE_DEBUG("Engine file watcher started with {} backend , {} ms debounce" , engine_watcher->BackendName() , settings.debounce.count());
+  }
+
+  void FileWatcher::Shutdown() {
+    engine_watcher = nullptr;
+  }
+
+  FileWatcher* FileWatcher::Get() {
+    return engine_watcher.get();
+  }
+
+  void FileWatcher::DispatchChanges() {
+    if (engine_watcher != nullptr) {
+      engine_watcher->PushEvents();
+    }
+  }
+
+  void FileWatcher::ThreadMain() {
+    OE_CHECK_AND_REGISTER_THREAD("File Watcher Thread");
+    OE_PROFILE_THREAD("File Watcher Thread");
+
+    std::vector<FileChange> changes;
+    while (!stopping) {
+      backend->Wait(kWaitSlice);
+
+      const int64_t begin = NowNs();
+      changes.clear();
+      {
+        std::lock_guard lock(watch_mutex);
+        backend->Collect(changes);
+        for (const auto& change : changes) {
+          Merge(change , begin);
+        }
+      }
+
+      raw_changes += changes.size();
+      busy_ns += NowNs() - begin;
+    }
+  }
+
+  void FileWatcher::Merge(const FileChange& change , int64_t now_ns) {
+    if (change.type == FileChangeType::RENAMED) {
+      const bool from_watched = AnyWatchMatches(change.old_path);
+      const bool to_watched = AnyWatchMatches(change.path);
+
+      /// a rename across the edge of what is watched is a plain remove or create from the watcher's point of view
+      if (!to_watched) {
+        if (from_watched) {
+          Merge({ .path = change.old_path , .type = FileChangeType::REMOVED } , now_ns);
+        }
+        return;
+      } else if (!from_watched) {
+        Merge({ .path = change.path , .type = FileChangeType::CREATED } , now_ns);
+        return;
+      }
+
+      FileChange merged = change;
+      auto from = pending.find(change.old_path.string());
+      if (from != pending.end()) {
+        if (from->second.change.type == FileChangeType::CREATED) {
+          merged = { .path = change.path , .type = FileChangeType::CREATED };
+        } else if (from->second.change.type == FileChangeType::RENAMED) {
+          merged.old_path = from->second.change.old_path;
+        }
+        pending.erase(from);
+      }
+
+      MarkWatches(merged);
+      auto& entry = pending[merged.path.string()];
+      entry.change = std::move(merged);
+      entry.last_ns = now_ns;
+      entry.sequence = next_sequence++;
+      return;
+    }
+
+    if (!AnyWatchMatches(change.path)) {
+      return;
+    }
+
+    const std::string key = change.path.string();
+    auto existing = pending.find(key);
+    if (existing == pending.end()) {
+      MarkWatches(change);
+      pending[key] = PendingChange{
+        .change = change ,
+        .last_ns = now_ns ,
+        .sequence = next_sequence++ ,
+      };
+      return;
+    }
+
+    FileChange& merged = existing->second.change;
+    existing->second.last_ns = now_ns;
+
+    switch (merged.type) {
+      case FileChangeType::CREATED:
+        /// never existed as far as anyone outside the window can tell
+        if (change.type == FileChangeType::REMOVED) {
+          pending.erase(existing);
+        }
+        return;
+
+      case FileChangeType::MODIFIED:
+        if (change.type == FileChangeType::REMOVED) {
+          merged.type = FileChangeType::REMOVED;
+        }
+        break;
+
+      case FileChangeType::REMOVED:
+        /// replaced in place , the way editors that save through a temporary file look
+        if (change.type != FileChangeType::REMOVED) {
+          merged.type = FileChangeType::MODIFIED;
+        }
+        break;
+
+      case FileChangeType::RENAMED:
+        if (change.type == FileChangeType::REMOVED) {
+          FileChange removed{ .path = merged.old_path , .type = FileChangeType::REMOVED };
+          pending.erase(existing);
+
+          MarkWatches(removed);
+          pending[removed.path.string()] = PendingChange{
+            .change = std::move(removed) ,
+            .last_ns = now_ns ,
+            .sequence = next_sequence++ ,
+          };
+        }
+        return;
+
+      default:
+        return;
+    }
+
+    /// the bits follow the merged change , so writing a new file flags a create and not a modify as well
+    MarkWatches(merged);
+  }
+
+  void FileWatcher::MarkWatches(const FileChange& change) {
+    for (auto& [id , watch] : watches) {
+      if (change.type != FileChangeType::RENAMED) {
+        if (Matches(watch , change.path)) {
+          watch.flags |= FileChangeBit(change.type);
+        }
+        continue;
+      }
+
+      const bool from = Matches(watch , change.old_path);
+      const bool to = Matches(watch , change.path);
+      if (from && to) {
+        watch.flags |= FileChangeBit(FileChangeType::RENAMED);
+      } else if (from) {
+        watch.flags |= FileChangeBit(FileChangeType::REMOVED);
+      } else if (to) {
+        watch.flags |= FileChangeBit(FileChangeType::CREATED);
+      }
+    }
+  }
+
+  bool FileWatcher::Matches(const WatchEntry& watch , const Path& path) const {
+    if (!path.string().starts_with(watch.root_prefix)) {
+      return false;
+    }
+
+    if (watch.extensions.empty()) {
+      return true;
+    }
+
+    const std::string extension = path.extension().string();
+    return std::ranges::find(watch.extensions , extension) != watch.extensions.end();
+  }
 
-    last_write = new_write_time;
-    return changed;
+  bool FileWatcher::AnyWatchMatches(const Path& path) const {
+    for (const auto& [id , watch] : watches) {
+      if (Matches(watch , path)) {
+        return true;
+      }
+    }
+    return false;
   }
 
 } // namespace other
@@ -4,21 +4,202 @@
 #ifndef OTHER_ENGINE_FILE_WATCHER_HPP
 #define OTHER_ENGINE_FILE_WATCHER_HPP
 
-#include <filesystem>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/defines.hpp"
+#include "core/config.hpp"
 
 namespace other {
 
+  enum class FileChangeType : uint8_t {
+    CREATED = 0 ,
+    MODIFIED ,
+    REMOVED ,
+    RENAMED ,
+
+    NUM_FILE_CHANGE_TYPES ,
+  };
+
+  constexpr uint32_t FileChangeBit(FileChangeType type) {
+    return 1u << static_cast<uint32_t>(type);
+  }
+
+  constexpr uint32_t kAllFileChanges = (1u << static_cast<uint32_t>(FileChangeType::NUM_FILE_CHANGE_TYPES)) - 1;
+
+  /// files appearing , disappearing or moving , what a directory listing would notice
+  constexpr uint32_t kFileStructureChanges = FileChangeBit(FileChangeType::CREATED) | FileChangeBit(FileChangeType::REMOVED) |
+                                             FileChangeBit(FileChangeType::RENAMED);
+
+  std::string_view FileChangeTypeName(FileChangeType type);
+
+  struct FileChange {
+    Path path;
+
+    /// where a renamed file used to be , empty for every other change
+    Path old_path;
+
+    FileChangeType type = FileChangeType::MODIFIED;
+  };
+
+  /**
+   * os side of the watcher , only ever reports raw changes for regular files under the roots it was given
+   *
+   * Wait may be called without holding the watcher lock while roots are added from another thread , everything
+   *   else is called with it held
+   **/
+  class FileWatchBackend {
+    public:
+      virtual ~FileWatchBackend() {}
+
+      virtual std::string_view Name() const = 0;
+
+      /// watches root and everything below it , roots may overlap and are counted
+      virtual bool AddRoot(const Path& root) = 0;
+      virtual void RemoveRoot(const Path& root) = 0;
+
+      /// blocks for at most timeout or until there is something to collect
+      virtual void Wait(std::chrono::milliseconds timeout) = 0;
+
+      /// appends everything seen since the last call
+      virtual void Collect(std::vector<FileChange>& changes) = 0;
+  };
+
+  /// null when inotify is not available on this platform or could not be initialized
+  Scope<FileWatchBackend> CreateInotifyBackend();
+  Scope<FileWatchBackend> CreatePollingBackend(std::chrono::milliseconds interval);
+
+  struct FileWatcherSettings {
+    bool enabled = true;
+
+    /// POLLING forces the stat based fallback even where inotify exists
+    bool force_polling = false;
+
+    /// a path has to be quiet this long before its change is handed out
+    std::chrono::milliseconds debounce{ 100 };
+
+    /// how often the polling fallback rescans every root
+    std::chrono::milliseconds poll_interval{ 500 };
+
+    /// FileChangedEvents pushed per frame , anything past that waits for the next frame so the event buffer can't overflow
+    uint32_t max_events_per_frame = 32;
+
+    /// everything under the FILE-WATCHER section
+    static FileWatcherSettings FromConfig(const ConfigTable& config);
+  };
+
+  struct FileWatcherStats {
+    uint32_t roots = 0;
+    uint64_t raw_changes = 0;
+    uint64_t changes_taken = 0;
+
+    /// time the watcher thread spent collecting and merging changes
+    double busy_ms = 0.0;
+    double wall_ms = 0.0;
+  };
+
+  using FileWatchId = uint32_t;
+  constexpr FileWatchId kInvalidFileWatch = 0;
+
+  /**
+   * one background thread watching every directory the engine cares about
+   *
+   * raw changes from the backend are merged per path until that path has been quiet for the debounce window , so
+   *   an editor writing a file in several steps or a tool touching thousands of files produces one change per file ,
+   *   a create followed by a remove inside the window produces nothing at all
+   *
+   * the main thread either takes the ready changes directly or lets DispatchChanges push them into the EventQueue as
+   *   FileChangedEvents , each watch additionally keeps a set of change bits that callers can consume without looking
+   *   at individual files
+   **/
   class FileWatcher {
     public:
-      FileWatcher(const std::string_view file_path);
+      FileWatcher(const FileWatcherSettings& settings);
+      ~FileWatcher();
+
+      FileWatcher(const FileWatcher&) = delete;
+      FileWatcher& operator=(const FileWatcher&) = delete;
+
+      /// watches root recursively , only files with one of the extensions count when any are given
+      FileWatchId Watch(const Path& root , std::vector<std::string> extensions = {});
+      void Unwatch(FileWatchId id);
+
+      /// change bits seen under the watch since the last call , only the bits in mask are returned and cleared
+      uint32_t Consume(FileWatchId id , uint32_t mask = kAllFileChanges);
+
+      /// every change that has settled , in the order the paths first changed
+      std::vector<FileChange> TakeChanges();
+
+      /// takes settled changes and pushes one FileChangedEvent per change , see Dispatched
+      void PushEvents();
+
+      /// the changes behind the FileChangedEvents pushed this frame
+      const std::vector<FileChange>& Dispatched() const;
+
+      std::string_view BackendName() const;
+      FileWatcherStats Stats() const;
+
+      /// FILE-WATCHER section , BACKEND , DEBOUNCE-MS , POLL-INTERVAL-MS and MAX-EVENTS-PER-FRAME
+      static void Initialize(const ConfigTable& config);
+      static void Shutdown();
+
+      /// the engine watcher , null before Initialize , after Shutdown or when disabled
+      static FileWatcher* Get();
+
+      /// once per frame from the main thread before the event queue is polled
+      static void DispatchChanges();
+
+    private:
+      static Scope<FileWatcher> engine_watcher;
+
+      struct WatchEntry {
+        Path root;
+        std::string root_prefix;
+        std::vector<std::string> extensions;
+        uint32_t flags = 0;
+      };
+
+      struct PendingChange {
+        FileChange change;
+        int64_t last_ns = 0;
+        uint64_t sequence = 0;
+      };
+
+      FileWatcherSettings settings;
+      Scope<FileWatchBackend> backend;
+
+      mutable std::mutex watch_mutex;
+      std::unordered_map<FileWatchId , WatchEntry> watches;
+      std::unordered_map<std::string , PendingChange> pending;
+      FileWatchId next_watch = 1;
+      uint64_t next_sequence = 0;
+
+      /// taken but not yet pushed because the frame's event budget ran out
+      std::vector<FileChange> backlog;
+      std::vector<FileChange> dispatched;
+
+      std::atomic<bool> stopping = false;
+      std::thread thread;
+
+      std::atomic<uint64_t> raw_changes = 0;
+      std::atomic<uint64_t> changes_taken = 0;
+      std::atomic<int64_t> busy_ns = 0;
+      int64_t start_ns = 0;
+
+      void ThreadMain();
 
-      bool ChangedSinceLastCheck();
+      void Merge(const FileChange& change , int64_t now_ns);
+      void MarkWatches(const FileChange& change);
 
-    protected:
-      std::string file_path;
-      std::filesystem::file_time_type last_write;
-  }; 
+      bool Matches(const WatchEntry& watch , const Path& path) const;
+      bool AnyWatchMatches(const Path& path) const;
+  };
 
 } // namespace other
 
@@ -0,0 +1,446 @@
+/**
+ * \file core/frame_profiler.cpp
+ **/
+#include "core/frame_profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+#include "core/config_keys.hpp"
+#include "core/logger.hpp"
+
+namespace other {
+namespace {
+
+  struct ScopeHistory {
+    std::array<double , FrameProfiler::kHistoryFrames> frame_ms{};
+    uint32_t count = 0;
+    uint32_t next = 0;
+
+    /// filled while a frame is drained
+    uint32_t calls = 0;
+    uint64_t ticks = 0;
+
+    uint32_t last_calls = 0;
+    double last_ms = 0.0;
+  };
+
+  struct ProfilerState {
+    /// guards the scope names and the ring list , both only grow
+    std::mutex registry_mutex;
+    std::deque<std::string> scope_names;
+    std::unordered_map<std::string_view , uint32_t> scope_ids;
+    std::vector<Scope<ProfileRing>> rings;
+    std::vector<uint32_t> free_rings;
+
+    /// main thread only
+    std::vector<ScopeHistory> history;
+    std::vector<ProfileEvent> drained;
+    std::vector<uint64_t> open_ends;
+    ProfileFrame last_frame;
+    uint64_t frame_start = 0;
+
+    bool capturing = false;
+    uint32_t capture_frames = 0;
+    uint64_t capture_start = 0;
+    std::vector<ProfileSample> captured;
+    Opt<Path> trace_file = std::nullopt;
+  };
+
+  ProfilerState& State() {
+    static ProfilerState state;
+    return state;
+  }
+
+  /// hands the ring back when its thread exits so pools that restart do not keep adding rings
+  struct ThreadRingRelease {
+    ProfileRing* ring = nullptr;
+
+    ~ThreadRingRelease() {
+      if (ring == nullptr) {
+        return;
+      }
+
+      auto& state = State();
+      std::lock_guard lock(state.registry_mutex);
+      state.free_rings.push_back(ring->ThreadIndex());
+    }
+  };
+
+  thread_local ThreadRingRelease ring_release;
+
+  ProfileRing* AcquireRing() {
+    auto& state = State();
+    std::lock_guard lock(state.registry_mutex);
+
+    /// a freed ring has no writer left, whatever it still holds is drained under the new thread's name
+    if (!state.free_rings.empty()) {
+      ProfileRing* ring = state.rings[state.free_rings.back()].get();
+      state.free_rings.pop_back();
+      ring->SetThreadName(fmtstr("Thread {}" , ring->ThreadIndex()));
+      return ring;
+    }
+
+    const uint32_t index = static_cast<uint32_t>(state.rings.size());
+    state.rings.push_back(NewScope<ProfileRing>(index , fmtstr("Thread {}" , index)));
+    return state.rings.back().get();
+  }
+
+  int64_t TicksToNs(int64_t ticks) {
+    return static_cast<int64_t>(static_cast<double>(ticks) * time::NsPerTick());
+  }
+
+  double Percentile(const std::vector<double>& sorted , double p) {
+    const size_t rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank , 1 , sorted.size()) - 1];
+  }
+
+  void AppendEscaped(std::string& out , std::string_view text) {
+    for (char c : text) {
+      if (c == '"' || c == '\\') {
+        out.push_back('\\');
+      }
+      out.push_back(c);
+    }
+  }
+
+} // anonymous namespace
+
+  std::atomic<bool> FrameProfiler::enabled = false;
+  constinit thread_local ProfileRing* FrameProfiler::thread_ring = nullptr;
+
+  ProfileRing::ProfileRing(uint32_t thread_index , std::string name)
+      : events(kCapacity) , thread_index(thread_index) , thread_name(std::move(name)) {}
+
+  bool ProfileRing::Refresh(uint64_t h) {
+    cached_tail = tail.load(std::memory_order_acquire);
+    if (h - cached_tail >= kCapacity) {
+      dropped.fetch_add(1 , std::memory_order_relaxed);
+      return false;
+    }
+    return true;
+  }
+
+  uint32_t ProfileRing::ThreadIndex() const {
+    return thread_index;
+  }
+
+  const std::string& ProfileRing::ThreadName() const {
+    return thread_name;
+  }
+
+  void ProfileRing::SetThreadName(std::string_view name) {
+    thread_name = name;
+  }
+
+  uint64_t ProfileRing::Dropped() const {
+    return dropped.load(std::memory_order_relaxed);
+  }
+
+  void FrameProfiler::Initialize(const ConfigTable& config) {
+    /// calibrate here rather than in the first scope that needs a conversion
+    time::NsPerTick();
+
+    auto& state = State();
+    state.frame_start = time::Ticks();
+    SetThreadName("Main Thread");
+
+    SetEnabled(config.GetVal<bool>(kProfilerSection , kEnabledValue , false).value_or(true));
+
+    auto trace_file = config.GetVal<std::string>(kProfilerSection , kTraceFileValue , false);
+    if (trace_file.has_value()) {
+      state.trace_file = Path(*trace_file);
+      StartCapture(config.GetVal<uint32_t>(kProfilerSection , kTraceFramesValue , false).value_or(kDefaultTraceFrames));
+      OE_DEBUG("Frame profiler tracing {} frames to {}" , state.capture_frames , *trace_file);
+    }
+  }
+
+  void FrameProfiler::Shutdown() {
+    auto& state = State();
+
+    /// runs that end before the capture fills still get their trace
+    if (state.capturing && state.trace_file.has_value()) {
+      WriteChromeTrace(*state.trace_file);
+    }
+
+    SetEnabled(false);
+    Reset();
+  }
+
+  void FrameProfiler::SetEnabled(bool enable) {
+    enabled.store(enable , std::memory_order_relaxed);
+  }
+
+  uint32_t FrameProfiler::RegisterScope(std::string_view name) {
+    auto& state = State();
+    std::lock_guard lock(state.registry_mutex);
+
+    auto itr = state.scope_ids.find(name);
+    if (itr != state.scope_ids.end()) {
+      return itr->second;
+    }
+
+    const uint32_t id = static_cast<uint32_t>(state.scope_names.size());
+    state.scope_names.emplace_back(name);
+    state.scope_ids[state.scope_names.back()] = id;
+    return id;
+  }
+
+  std::string_view FrameProfiler::ScopeName(uint32_t scope) {
+    auto& state = State();
+    std::lock_guard lock(state.registry_mutex);
+    if (scope >= state.scope_names.size()) {
+      return "<unknown>";
+    }
+    return state.scope_names[scope];
+  }
+
+  void FrameProfiler::SetThreadName(std::string_view name) {
+    ProfileRing* ring = thread_ring;
+    if (ring == nullptr) {
+      ring = AcquireThreadRing();
+    }
+
+    auto& state = State();
+    std::lock_guard lock(state.registry_mutex);
+    ring->SetThreadName(name);
+  }
+
+  std::string FrameProfiler::ThreadName(uint32_t thread) {
+    auto& state = State();
+    std::lock_guard lock(state.registry_mutex);
+    if (thread >= state.rings.size()) {
+      return "<unknown>";
+    }
+    return state.rings[thread]->ThreadName();
+  }
+
+  ProfileRing* FrameProfiler::AcquireThreadRing() {
+    thread_ring = AcquireRing();
+    ring_release.ring = thread_ring;
+    return thread_ring;
+  }
+
+  void FrameProfiler::EndFrame() {
+    auto& state = State();
+    const uint64_t frame_end = time::Ticks();
+
+    ProfileFrame& frame = state.last_frame;
+    frame.index++;
+    frame.duration_ns = TicksToNs(static_cast<int64_t>(frame_end - state.frame_start));
+    frame.samples.clear();
+
+    {
+      std::lock_guard lock(state.registry_mutex);
+      if (state.history.size() < state.scope_names.size()) {
+        state.history.resize(state.scope_names.size());
+      }
+
+      for (auto& ring : state.rings) {
+        state.drained.clear();
+        ring->Drain([&](const ProfileEvent& event) {
+          state.drained.push_back(event);
+        });
+
+        /// parents start no later and end no earlier than their children, the open scope stack gives the depth
+        std::sort(state.drained.begin() , state.drained.end() , [](const ProfileEvent& a , const ProfileEvent& b) {
+          return a.start != b.start ? a.start < b.start : a.end > b.end;
+        });
+
+        state.open_ends.clear();
+        for (const auto& event : state.drained) {
+          while (!state.open_ends.empty() && state.open_ends.back() <= event.start) {
+            state.open_ends.pop_back();
+          }
+
+          frame.samples.push_back(ProfileSample{
+            .scope = event.scope ,
+            .thread = ring->ThreadIndex() ,
+            .depth = static_cast<uint32_t>(state.open_ends.size()) ,
+            .start_ns = TicksToNs(static_cast<int64_t>(event.start - state.frame_start)) ,
+            .duration_ns = TicksToNs(static_cast<int64_t>(event.end - event.start)) ,
+          });
+          state.open_ends.push_back(event.end);
+
+          auto& history = state.history[event.scope];
+          ++history.calls;
+          history.ticks += event.end - event.start;
+        }
+      }
+    }
+
+    for (auto& history : state.history) {
+      history.last_calls = history.calls;
+      history.last_ms = 0.0;
+      if (history.calls > 0) {
+        history.last_ms = static_cast<double>(TicksToNs(static_cast<int64_t>(history.ticks))) / 1e6;
+        history.frame_ms[history.next] = history.last_ms;
+        history.next = (history.next + 1) % kHistoryFrames;
+        history.count = std::min(history.count + 1 , kHistoryFrames);
+      }
+
+      history.calls = 0;
+      history.ticks = 0;
+    }
+
+    if (state.capturing) {
+      const int64_t offset = TicksToNs(static_cast<int64_t>(state.frame_start - state.capture_start));
+      for (auto sample : frame.samples) {
+        sample.start_ns += offset;
+        state.captured.push_back(sample);
+      }
+
+      if (--state.capture_frames == 0) {
+        state.capturing = false;
+        if (state.trace_file.has_value()) {
+          WriteChromeTrace(*state.trace_file);
+          state.trace_file = std::nullopt;
+        }
+      }
+    }
+
+    state.frame_start = frame_end;
+  }
+
+  const ProfileFrame& FrameProfiler::LastFrame() {
+    return State().last_frame;
+  }
+
+  std::vector<ProfileScopeStats> FrameProfiler::Stats() {
+    auto& state = State();
+
+    std::vector<ProfileScopeStats> stats;
+    std::vector<double> sorted;
+    for (uint32_t scope = 0; scope < state.history.size(); ++scope) {
+      const auto& history = state.history[scope];
+      if (history.count == 0) {
+        continue;
+      }
+
+      sorted.assign(history.frame_ms.begin() , history.frame_ms.begin() + history.count);
+      std::sort(sorted.begin() , sorted.end());
+
+      double total = 0.0;
+      for (double ms : sorted) {
+        total += ms;
+      }
+
+      stats.push_back(ProfileScopeStats{
+        .scope = scope ,
+        .name = ScopeName(scope) ,
+        .calls = history.last_calls ,
+        .frames = history.count ,
+        .last_ms = history.last_ms ,
+        .min_ms = sorted.front() ,
+        .avg_ms = total / static_cast<double>(sorted.size()) ,
+        .p95_ms = Percentile(sorted , 0.95) ,
+        .p99_ms = Percentile(sorted , 0.99) ,
+        .max_ms = sorted.back() ,
+      });
+    }
+    return stats;
+  }
+
+  uint64_t FrameProfiler::Dropped() {
+    auto& state = State();
+    std::lock_guard lock(state.registry_mutex);
+
+    uint64_t dropped = 0;
+    for (const auto& ring : state.rings) {
+      dropped += ring->Dropped();
+    }
+    return dropped;
+  }
+
+  void FrameProfiler::StartCapture(uint32_t frames) {
+    auto& state = State();
+    state.captured.clear();
+    state.capturing = frames > 0;
+    state.capture_frames = frames;
+    state.capture_start = state.frame_start;
+  }
+
+  void FrameProfiler::StopCapture() {
+    State().capturing = false;
+  }
+
+  bool FrameProfiler::Capturing() {
+    return State().capturing;
+  }
+
+  std::string FrameProfiler::ChromeTrace() {
+    auto& state = State();
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separate = [&]() {
+      if (!first) {
+        json += ",\n";
+      }
+      first = false;
+    };
+
+    std::vector<bool> named;
+    for (const auto& sample : state.captured) {
+      if (sample.thread >= named.size()) {
+        named.resize(sample.thread + 1 , false);
+      }
+
+      if (!named[sample.thread]) {
+        named[sample.thread] = true;
+        separate();
+        json += fmtstr("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"" , sample.thread);
+        AppendEscaped(json , ThreadName(sample.thread));
+        json += "\"}}";
+      }
+
+      separate();
+      json += "{\"name\":\"";
+      AppendEscaped(json , ScopeName(sample.scope));
+      json += fmtstr("\",\"cat\":\"engine\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}" ,
+                     sample.thread , static_cast<double>(sample.start_ns) / 1e3 ,
+                     static_cast<double>(sample.duration_ns) / 1e3);
+    }
+
+    json += "]}\n";
+    return json;
+  }
+
+  bool FrameProfiler::WriteChromeTrace(const Path& path) {
+    std::ofstream file(path , std::ios::trunc);
+    if (!file.is_open()) {
+      OE_ERROR("Failed to open {} for the frame profiler trace" , path);
+      return false;
+    }
+
+    const std::string json = ChromeTrace();
+    file.write(json.data() , json.size());
+    OE_DEBUG("Frame profiler trace of {} samples written to {}" , State().captured.size() , path);
+    return true;
+  }
+
+  void FrameProfiler::Reset() {
+    auto& state = State();
+    {
+      std::lock_guard lock(state.registry_mutex);
+      for (auto& ring : state.rings) {
+        ring->Drain([](const ProfileEvent&) {});
+      }
+    }
+
+    state.history.clear();
+    state.last_frame = {};
+    state.frame_start = time::Ticks();
+
+    state.capturing = false;
+    state.capture_frames = 0;
+    state.captured.clear();
+    state.trace_file = std::nullopt;
+  }
+
+} // namespace other
@@ -0,0 +1,219 @@
+/**
+ * \file core/frame_profiler.hpp
+ **/
+#ifndef OTHER_ENGINE_FRAME_PROFILER_HPP
+#define OTHER_ENGINE_FRAME_PROFILER_HPP
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/defines.hpp"
+#include "core/config.hpp"
+#include "core/time.hpp"
+
+namespace other {
+
+  /// one finished scope as its thread recorded it, times are time::Ticks
+  struct ProfileEvent {
+    uint64_t start = 0;
+    uint64_t end = 0;
+    uint32_t scope = 0;
+  };
+
+  /**
+   * single producer single consumer ring of finished scopes
+   *
+   * the thread owning the ring is the only writer and the frame profiler is the only reader, a full ring drops new
+   *   events instead of blocking the writer
+   **/
+  class ProfileRing {
+    public:
+      constexpr static uint32_t kCapacity = 1u << 13;
+
+      ProfileRing(uint32_t thread_index , std::string name);
+
+      /// writer side , false when the reader has fallen a full ring behind
+      bool Push(const ProfileEvent& event) {
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - cached_tail >= kCapacity && !Refresh(h)) {
+          return false;
+        }
+
+        events[h & (kCapacity - 1)] = event;
+        head.store(h + 1 , std::memory_order_release);
+        return true;
+      }
+
+      /// reader side , calls fn(event) oldest first and returns how many were read
+      template <typename Fn>
+      uint32_t Drain(Fn&& fn) {
+        const uint64_t first = tail.load(std::memory_order_relaxed);
+        const uint64_t last = head.load(std::memory_order_acquire);
+        for (uint64_t i = first; i < last; ++i) {
+          fn(events[i & (kCapacity - 1)]);
+        }
+
+        tail.store(last , std::memory_order_release);
+        return static_cast<uint32_t>(last - first);
+      }
+
+      uint32_t ThreadIndex() const;
+      const std::string& ThreadName() const;
+      void SetThreadName(std::string_view name);
+
+      uint64_t Dropped() const;
+
+    private:
+      std::vector<ProfileEvent> events;
+
+      uint32_t thread_index = 0;
+      std::string thread_name;
+
+      /// writer owned , the tail it saw last so a push only reads the shared tail when the ring looks full
+      alignas(64) std::atomic<uint64_t> head = 0;
+      uint64_t cached_tail = 0;
+      std::atomic<uint64_t> dropped = 0;
+
+      alignas(64) std::atomic<uint64_t> tail = 0;
+
+      /// rereads the shared tail , false and counts a drop when the ring really is full
+      bool Refresh(uint64_t h);
+  };
+
+  /// one scope in a drained frame , offsets are from the frame start and can be negative for work started earlier
+  struct ProfileSample {
+    uint32_t scope = 0;
+    uint32_t thread = 0;
+    uint32_t depth = 0;
+    int64_t start_ns = 0;
+    int64_t duration_ns = 0;
+  };
+
+  struct ProfileFrame {
+    uint64_t index = 0;
+    int64_t duration_ns = 0;
+
+    /// grouped by thread , each thread's samples in start order with parents before their children
+    std::vector<ProfileSample> samples;
+  };
+
+  /// inclusive time a scope took per frame over the history window , calls are from the last frame only
+  struct ProfileScopeStats {
+    uint32_t scope = 0;
+    std::string_view name;
+
+    uint32_t calls = 0;
+    uint32_t frames = 0;
+
+    double last_ms = 0.0;
+    double min_ms = 0.0;
+    double avg_ms = 0.0;
+    double p95_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+  };
+
+  /**
+   * always on hierarchical scope timer , the engine side of OE_PROFILE_SCOPE
+   *
+   * scopes write finished events into a ring owned by their thread , the main thread drains every ring once per
+   *   frame in EndFrame and folds them into per scope history , nesting is rebuilt from the timestamps there so the
+   *   recording side never tracks depth
+   *
+   * everything but RegisterScope, SetThreadName and Record belongs to the main thread
+   **/
+  class FrameProfiler {
+    public:
+      /// frames of per scope history percentiles are taken over
+      constexpr static uint32_t kHistoryFrames = 240;
+      constexpr static uint32_t kDefaultTraceFrames = 300;
+
+      /**
+       * ENABLED in the PROFILER section, defaults to true
+       *
+       * with TRACE-FILE set the first TRACE-FRAMES frames are captured and written there as a chrome trace, for
+       *   headless runs that have no editor to look at
+       **/
+      static void Initialize(const ConfigTable& config);
+      static void Shutdown();
+
+      static void SetEnabled(bool enable);
+      static bool Enabled() {
+        return enabled.load(std::memory_order_relaxed);
+      }
+
+      /// same name , same id , safe from any thread
+      static uint32_t RegisterScope(std::string_view name);
+      static std::string_view ScopeName(uint32_t scope);
+
+      /// names the calling thread in views and traces , threads that never call this are numbered
+      static void SetThreadName(std::string_view name);
+      static std::string ThreadName(uint32_t thread);
+
+      /// inline with the ring lookup so a scope costs its two timestamps and a store
+      static void Record(uint32_t scope , uint64_t start , uint64_t end) {
+        ProfileRing* ring = thread_ring;
+        if (ring == nullptr) {
+          ring = AcquireThreadRing();
+        }
+
+        ring->Push(ProfileEvent{
+          .start = start ,
+          .end = end ,
+          .scope = scope ,
+        });
+      }
+
+      /// drains every thread's ring into the last frame and the scope history
+      static void EndFrame();
+
+      static const ProfileFrame& LastFrame();
+      static std::vector<ProfileScopeStats> Stats();
+
+      /// events lost to full rings since Initialize
+      static uint64_t Dropped();
+
+      /// keeps every drained sample of the next frames until StopCapture
+      static void StartCapture(uint32_t frames = kDefaultTraceFrames);
+      static void StopCapture();
+      static bool Capturing();
+
+      /// chrome://tracing and perfetto json of the captured frames
+      static std::string ChromeTrace();
+      static bool WriteChromeTrace(const Path& path);
+
+      /// drops history , captures and the last frame , registered scopes and threads stay
+      static void Reset();
+
+    private:
+      static std::atomic<bool> enabled;
+      static constinit thread_local ProfileRing* thread_ring;
+
+      static ProfileRing* AcquireThreadRing();
+  };
+
+  /// times its own lifetime , the enabled check happens once on entry so toggling mid scope is harmless
+  class ProfileScope {
+    public:
+      explicit ProfileScope(uint32_t scope)
+        : scope(scope) , start(FrameProfiler::Enabled() ? time::Ticks() : 0) {}
+
+      ~ProfileScope() {
+        if (start != 0) {
+          FrameProfiler::Record(scope , start , time::Ticks());
+        }
+      }
+
+      ProfileScope(const ProfileScope&) = delete;
+      ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+      uint32_t scope;
+      uint64_t start;
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_FRAME_PROFILER_HPP
@@ -0,0 +1,176 @@
+/**
+ * \file core/instance_buffer.hpp
+ **/
+#ifndef OTHER_ENGINE_INSTANCE_BUFFER_HPP
+#define OTHER_ENGINE_INSTANCE_BUFFER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "core/logger.hpp"
+#include "core/profile.hpp"
+
+namespace other {
+
+  /**
+   * typed append only array of trivially copyable values , per frame instance data that is filled , uploaded and
+   *   cleared every frame
+   *
+   * unlike Buffer every element has the same size so there is no per element bookkeeping , memory is only zeroed
+   *   when Grow is asked to , and Clear keeps the allocation so a steady state frame does not allocate
+   **/
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  class InstanceBuffer {
+    public:
+      constexpr static size_t kMinCapacity = 64;
+
+      InstanceBuffer() = default;
+      explicit InstanceBuffer(size_t capacity) {
+        Reserve(capacity);
+      }
+
+      ~InstanceBuffer() {
+        Release();
+      }
+
+      InstanceBuffer(InstanceBuffer&& other) noexcept
+          : data(std::exchange(other.data , nullptr)) , size(std::exchange(other.size , 0)) ,
+            capacity(std::exchange(other.capacity , 0)) {}
+
+      InstanceBuffer& operator=(InstanceBuffer&& other) noexcept {
+        if (this != &other) {
+          Release();
+          data = std::exchange(other.data , nullptr);
+          size = std::exchange(other.size , 0);
+          capacity = std::exchange(other.capacity , 0);
+        }
+        return *this;
+      }
+
+      InstanceBuffer(const InstanceBuffer&) = delete;
+      InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+      /// room for at least count elements , never shrinks
+      void Reserve(size_t count) {
+        if (count <= capacity) {
+          return;
+        }
+
+        T* new_data = static_cast<T*>(::operator new(count * sizeof(T) , std::align_val_t{ alignof(T) }));
+        OE_PROFILE_ALLOC_NAMED(new_data , count * sizeof(T) , "InstanceBuffer");
+        if (size > 0) {
+          std::memcpy(new_data , data , size * sizeof(T));
+        }
+
+        Free();
+        data = new_data;
+        capacity = count;
+      }
+
+      void Append(const T& value) {
+        if (size == capacity) {
+          Reserve(GrowthFor(size + 1));
+        }
+        data[size++] = value;
+      }
+
+      void Append(std::span<const T> values) {
+        if (values.empty()) {
+          return;
+        }
+
+        if (size + values.size() > capacity) {
+          Reserve(GrowthFor(size + values.size()));
+        }
+        std::memcpy(data + size , values.data() , values.size() * sizeof(T));
+        size += values.size();
+      }
+
+      /// appends count elements for the caller to fill in place , their contents are garbage unless zero is set
+      std::span<T> Grow(size_t count , bool zero = false) {
+        if (size + count > capacity) {
+          Reserve(GrowthFor(size + count));
+        }
+
+        std::span<T> added{ data + size , count };
+        if (zero && count > 0) {
+          std::memset(static_cast<void*>(added.data()) , 0 , count * sizeof(T));
+        }
+        size += count;
+        return added;
+      }
+
+      /// drops the elements and keeps the allocation
+      void Clear() {
+        size = 0;
+      }
+
+      void Release() {
+        Free();
+        data = nullptr;
+        size = 0;
+        capacity = 0;
+      }
+
+      T& operator[](size_t index) {
+        OE_ASSERT(index < size , "InstanceBuffer index {} out of range {}" , index , size);
+        return data[index];
+      }
+
+      const T& operator[](size_t index) const {
+        OE_ASSERT(index < size , "InstanceBuffer index {} out of range {}" , index , size);
+        return data[index];
+      }
+
+      const T* Data() const {
+        return data;
+      }
+
+      std::span<const T> View() const {
+        return { data , size };
+      }
+
+      size_t Size() const {
+        return size;
+      }
+
+      size_t Capacity() const {
+        return capacity;
+      }
+
+      size_t Bytes() const {
+        return size * sizeof(T);
+      }
+
+      bool Empty() const {
+        return size == 0;
+      }
+
+    private:
+      T* data = nullptr;
+      size_t size = 0;
+      size_t capacity = 0;
+
+      size_t GrowthFor(size_t required) const {
+        return std::max({ required , capacity * 2 , kMinCapacity });
+      }
+
+      void Free() {
+        if (data == nullptr) {
+          return;
+        }
+
+        OE_PROFILE_FREE_NAMED(data , "InstanceBuffer");
+        ::operator delete(data , std::align_val_t{ alignof(T) });
+      }
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_INSTANCE_BUFFER_HPP
@@ -3,6 +3,8 @@
  */
 #include "core/layer.hpp"
 
+#include "core/profile.hpp"
+
 #include "application/app.hpp"
 
 namespace other {
@@ -12,22 +14,32 @@ namespace other {
   }
       
   void Layer::EarlyUpdate(float dt) {
+    OE_PROFILE_SCOPE("Layer::EarlyUpdate");
+    OE_PROFILE_TAG(Name());
     OnEarlyUpdate(dt);
   }
 
   void Layer::Update(float dt) {
+    OE_PROFILE_SCOPE("Layer::Update");
+    OE_PROFILE_TAG(Name());
     OnUpdate(dt);
   }
   
   void Layer::LateUpdate(float dt) {
+    OE_PROFILE_SCOPE("Layer::LateUpdate");
+    OE_PROFILE_TAG(Name());
     OnLateUpdate(dt);
   }
 
   void Layer::Render() {
+    OE_PROFILE_SCOPE("Layer::Render");
+    OE_PROFILE_TAG(Name());
     OnRender();
   }
 
   void Layer::UIRender() {
+    OE_PROFILE_SCOPE("Layer::UIRender");
+    OE_PROFILE_TAG(Name());
     OnUIRender();
   }
 
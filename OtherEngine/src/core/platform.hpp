@@ -7,7 +7,6 @@
 #include <array>
 
 #include "core/defines.hpp"
-#include "core/directory_watcher.hpp"
 #include "plugin/plugin_loader.hpp"
 
 #ifdef _WIN32
@@ -0,0 +1,70 @@
+/**
+ * \file core/profile.cpp
+ **/
+#include "core/profile.hpp"
+
+#ifdef OE_PROFILE_BUILD
+
+#include <cstdlib>
+#include <new>
+
+/**
+ * every heap allocation goes through the profiler in profiling builds so the memory view covers the whole process,
+ *   the aligned overloads are left to the runtime and are not tracked
+ **/
+void* operator new(std::size_t size) {
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  OE_PROFILE_ALLOC(ptr , size);
+  return ptr;
+}
+
+void* operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+
+void* operator new(std::size_t size , const std::nothrow_t&) noexcept {
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr != nullptr) {
+    OE_PROFILE_ALLOC(ptr , size);
+  }
+  return ptr;
+}
+
+void* operator new[](std::size_t size , const std::nothrow_t& tag) noexcept {
+  return ::operator new(size , tag);
+}
+
+void operator delete(void* ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  OE_PROFILE_FREE(ptr);
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  ::operator delete(ptr);
+}
+
+void operator delete(void* ptr , std::size_t) noexcept {
+  ::operator delete(ptr);
+}
+
+void operator delete[](void* ptr , std::size_t) noexcept {
+  ::operator delete(ptr);
+}
+
+void operator delete(void* ptr , const std::nothrow_t&) noexcept {
+  ::operator delete(ptr);
+}
+
+void operator delete[](void* ptr , const std::nothrow_t&) noexcept {
+  ::operator delete(ptr);
+}
+
+#endif // OE_PROFILE_BUILD
@@ -0,0 +1,93 @@
+/**
+ * \file core/profile.hpp
+ **/
+#ifndef OTHER_ENGINE_PROFILE_HPP
+#define OTHER_ENGINE_PROFILE_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <string_view>
+
+#include "core/frame_profiler.hpp"
+
+#define OE_PROFILE_CONCAT_IMPL(a , b) a##b
+#define OE_PROFILE_CONCAT(a , b) OE_PROFILE_CONCAT_IMPL(a , b)
+
+/// the built in FrameProfiler half of a scope , registers the name once per call site
+#define OE_FRAME_SCOPE(name) \
+  static const uint32_t OE_PROFILE_CONCAT(oe_frame_scope_id_ , __LINE__) = ::other::FrameProfiler::RegisterScope(name); \
+  const ::other::ProfileScope OE_PROFILE_CONCAT(oe_frame_scope_ , __LINE__)(OE_PROFILE_CONCAT(oe_frame_scope_id_ , __LINE__))
+
+/**
+ * profiling hooks, scopes always feed the built in FrameProfiler and only the Profile configuration (OE_PROFILE_BUILD)
+ *   also sends them to tracy , every other tracy hook compiles away outside of it
+ *
+ * zone names must be string literals , OE_PROFILE_TAG attaches runtime text like a layer or asset name to the
+ *   enclosing zone
+ *
+ * mutexes declared with OE_PROFILE_MUTEX show lock waits and holds in the profiler, lock them through CTAD
+ *   (std::lock_guard lock(mutex)) so the guard picks up the wrapped type , and wait on them with a
+ *   ProfiledConditionVariable
+ **/
+#ifdef OE_PROFILE_BUILD
+
+#include <tracy/Tracy.hpp>
+
+#define OE_PROFILE_FRAME() FrameMark
+#define OE_PROFILE_FUNCTION() OE_FRAME_SCOPE(__func__); ZoneScoped
+#define OE_PROFILE_SCOPE(name) OE_FRAME_SCOPE(name); ZoneScopedN(name)
+#define OE_PROFILE_TAG(text) \
+  do { \
+    const std::string_view oe_profile_tag{ text }; \
+    ZoneText(oe_profile_tag.data() , oe_profile_tag.size()); \
+  } while (false)
+
+#define OE_PROFILE_THREAD(name) \
+  do { \
+    ::other::FrameProfiler::SetThreadName(name); \
+    tracy::SetThreadName(name); \
+  } while (false)
+#define OE_PROFILE_PLOT(name , value) TracyPlot(name , value)
+
+#define OE_PROFILE_ALLOC(ptr , size) TracyAlloc(ptr , size)
+#define OE_PROFILE_FREE(ptr) TracyFree(ptr)
+#define OE_PROFILE_ALLOC_NAMED(ptr , size , pool) TracyAllocN(ptr , size , pool)
+#define OE_PROFILE_FREE_NAMED(ptr , pool) TracyFreeN(ptr , pool)
+
+#define OE_PROFILE_MUTEX(type , name , desc) TracyLockableN(type , name , desc)
+#define OE_PROFILE_LOCKABLE(type) LockableBase(type)
+
+namespace other {
+
+  /// tracy's lockable wrapper is not a std::mutex, only condition_variable_any can wait on it
+  using ProfiledConditionVariable = std::condition_variable_any;
+
+} // namespace other
+
+#else
+
+#define OE_PROFILE_FRAME()
+#define OE_PROFILE_FUNCTION() OE_FRAME_SCOPE(__func__)
+#define OE_PROFILE_SCOPE(name) OE_FRAME_SCOPE(name)
+#define OE_PROFILE_TAG(text)
+
+#define OE_PROFILE_THREAD(name) ::other::FrameProfiler::SetThreadName(name)
+#define OE_PROFILE_PLOT(name , value)
+
+#define OE_PROFILE_ALLOC(ptr , size)
+#define OE_PROFILE_FREE(ptr)
+#define OE_PROFILE_ALLOC_NAMED(ptr , size , pool)
+#define OE_PROFILE_FREE_NAMED(ptr , pool)
+
+#define OE_PROFILE_MUTEX(type , name , desc) type name
+#define OE_PROFILE_LOCKABLE(type) type
+
+namespace other {
+
+  using ProfiledConditionVariable = std::condition_variable;
+
+} // namespace other
+
+#endif // OE_PROFILE_BUILD
+
+#endif // !OTHER_ENGINE_PROFILE_HPP
@@ -1,29 +1,54 @@
 /**
- * \file core/ref.hpp
+ * \file core/ref.cpp
 */
 #include "core/ref.hpp"
 
+#ifdef OE_DEBUG_BUILD
+
+#include <array>
+#include <functional>
+#include <mutex>
 #include <unordered_set>
 
 namespace other {
 namespace {
 
-  std::unordered_set<void*> refs;
+  constexpr size_t kNumShards = 16;
+
+  struct RefShard {
+    std::mutex mtx;
+    std::unordered_set<void*> refs;
+  };
+
+  std::array<RefShard , kNumShards> shards;
+
+  RefShard& ShardFor(void* instance) {
+    /// the low bits of heap addresses are mostly alignment
+    return shards[(std::hash<void*>{}(instance) >> 4) % kNumShards];
+  }
 
 } // namespace anon
 namespace detail {
 
   void RegisterReference(void* instance) {
-    refs.insert(instance);
+    RefShard& shard = ShardFor(instance);
+    std::lock_guard lock(shard.mtx);
+    shard.refs.insert(instance);
   }
 
   void RemoveReference(void* instance) {
-    refs.erase(instance);
+    RefShard& shard = ShardFor(instance);
+    std::lock_guard lock(shard.mtx);
+    shard.refs.erase(instance);
   }
 
   bool IsValidRef(void* instance) {
-    return refs.find(instance) != refs.end();
+    RefShard& shard = ShardFor(instance);
+    std::lock_guard lock(shard.mtx);
+    return shard.refs.find(instance) != shard.refs.end();
   }
 
 } // namespace detail
 } // namespace other
+
+#endif // OE_DEBUG_BUILD
@@ -5,19 +5,27 @@
 #define OTHER_ENGINE_REF_HPP
 
 #include <concepts>
+#include <cstddef>
 #include <type_traits>
 
 #include "core/errors.hpp"
 #include "core/ref_counted.hpp"
 
 namespace other {
+
+#ifdef OE_DEBUG_BUILD
 namespace detail {
 
+  /// debug builds track every live object to catch use-after-free, the registry is sharded by address to keep contention low
   void RegisterReference(void* instance);
   void RemoveReference(void* instance);
   bool IsValidRef(void* instance);
 
 } // namespace detail
+#endif // OE_DEBUG_BUILD
+
+  template <typename T>
+  class RefView;
 
   template <typename T , typename U>
   concept RefCastable = std::is_convertible_v<T, U> || std::is_base_of_v<T, U>;
@@ -45,15 +53,17 @@ namespace detail {
       }
       
       Ref& operator=(const Ref<T>& other) {
-        if (this != &other) {
-          object = other.object;
-          IncRef();
-        }
+        /// increment first so assigning a ref to itself (or to another ref of the same object) can not free it
+        other.IncRef();
+        DecRef();
+
+        object = other.object;
         return *this;
       }
 
       Ref& operator=(Ref<T>&& other) noexcept {
         if (this != &other) {
+          DecRef();
           object = other.object;
           other.object = nullptr;
         }
@@ -72,7 +82,7 @@ namespace detail {
       	other.object = nullptr;
       }
       
-      virtual ~Ref() {
+      ~Ref() {
         DecRef();
       }
 
@@ -106,7 +116,8 @@ namespace detail {
       operator bool() { return object != nullptr; }
       operator bool() const { return object != nullptr; }
 
-      Ref& operator*() { return object; }
+      T& operator*() { return *object; }
+      const T& operator*() const { return *object; }
       
       T* operator->() { return object; }
       const T* operator->() const { return object; }
@@ -115,10 +126,7 @@ namespace detail {
       const T* Raw() const { return object; }
 
       void Reset(T* object = nullptr) {
-        this->object = object;
-        if (this->object == nullptr) {
-          DecRef();
-        }
+        *this = Ref<T>(object);
       }
 
       template <typename U>
@@ -171,26 +179,78 @@ namespace detail {
       mutable T* object;
 
       void IncRef() const {
-        if (object != nullptr) {
-          object->Increment();
+        if (object == nullptr) {
+          return;
+        }
+
+        [[maybe_unused]] uint64_t count = object->Increment();
+#ifdef OE_DEBUG_BUILD
+        if (count == 1) {
           detail::RegisterReference(object); 
         }
+#endif // OE_DEBUG_BUILD
       }
 
       void DecRef() const {
-        if (object != nullptr) {
-          object->Decrement();
-
-          if (object->Count() == 0) {
-            detail::RemoveReference(object);
-            delete object;
-            object = nullptr;
-          }
+        /// only the thread that drops the last reference sees 0, checking Count() separately would race
+        if (object != nullptr && object->Decrement() == 0) {
+#ifdef OE_DEBUG_BUILD
+          detail::RemoveReference(object);
+#endif // OE_DEBUG_BUILD
+          delete object;
+          object = nullptr;
         }
       }
 
       template <typename U>
       friend class Ref;
+
+      template <typename U>
+      friend class RefView;
+  };
+
+  /**
+   * borrowed, non-owning view of a Ref for hot path parameters, copying one never touches the refcount
+   *
+   * the caller has to keep a Ref to the object alive for as long as the view is in use, Retain promotes the view
+   *   back into an owning Ref when the callee needs to hold on to the object
+   **/
+  template <typename T>
+  class RefView {
+    public:
+      RefView() = default;
+      RefView(std::nullptr_t) {}
+
+      RefView(T* object)
+        : object(object) {}
+
+      template <typename T2>
+        requires std::is_convertible_v<T2* , T*>
+      RefView(const Ref<T2>& ref)
+        : object(ref.object) {}
+
+      operator bool() const { return object != nullptr; }
+
+      T& operator*() const { return *object; }
+      T* operator->() const { return object; }
+
+      T* Raw() const { return object; }
+
+      /// the count is intrusive, so taking a new reference from a raw pointer is safe
+      Ref<T> Retain() const {
+        return Ref<T>(object);
+      }
+
+      bool operator==(const RefView<T>& other) const {
+        return object == other.object;
+      }
+
+      bool operator==(std::nullptr_t) const {
+        return object == nullptr;
+      }
+
+    private:
+      T* object = nullptr;
   };
 
   template <typename T , typename... Args>
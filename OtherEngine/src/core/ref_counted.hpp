@@ -5,19 +5,33 @@
 #define OTHER_ENGINE_REF_COUNTED_HPP
 
 #include <atomic>
+#include <cstdint>
 
 namespace other {
 
+  /**
+   * intrusive reference count for objects owned through Ref
+   *
+   * taking a reference only needs the count to be atomic (relaxed), releasing one is acq_rel so every write made
+   *   through other references happens-before the destructor runs on the thread that drops the last one
+   **/
   class RefCounted {
     public:
       RefCounted() 
         : count(0) {}
       virtual ~RefCounted() = default;
 
-      void Increment();
-      void Decrement();
+      /// returns the count after incrementing
+      uint64_t Increment() const {
+        return count.fetch_add(1 , std::memory_order_relaxed) + 1;
+      }
 
-      uint64_t Count() const { return count; }
+      /// returns the count after decrementing, the caller that sees 0 owns destruction
+      uint64_t Decrement() const {
+        return count.fetch_sub(1 , std::memory_order_acq_rel) - 1;
+      }
+
+      uint64_t Count() const { return count.load(std::memory_order_relaxed); }
     
     private:
       mutable std::atomic<uint64_t> count;
@@ -0,0 +1,73 @@
+/**
+ * \file core/string_id.cpp
+ **/
+#include "core/string_id.hpp"
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "core/logger.hpp"
+
+namespace other {
+namespace {
+
+  struct InternerState {
+    /// ids are looked up far more often than new strings show up
+    std::shared_mutex mutex;
+
+    /// node based so the text of every entry stays put while the table grows
+    std::unordered_map<uint64_t , std::string> strings;
+  };
+
+  InternerState& State() {
+    static InternerState state;
+    return state;
+  }
+
+} // anonymous namespace
+
+  StringId::StringId(std::string_view str)
+      : StringId(StringInterner::Intern(str)) {
+  }
+
+  StringId StringInterner::Intern(std::string_view str) {
+    const uint64_t hash = FNV(str);
+    InternerState& state = State();
+
+    {
+      std::shared_lock lock(state.mutex);
+      if (auto itr = state.strings.find(hash); itr != state.strings.end()) {
+#ifdef OE_DEBUG_BUILD
+        OE_ASSERT(itr->second == str , "StringId collision , '{}' and '{}' both hash to {:#x}" , itr->second , str , hash);
+#endif // OE_DEBUG_BUILD
+        return StringId(hash , itr->second.c_str());
+      }
+    }
+
+    std::unique_lock lock(state.mutex);
+
+    /// another thread may have interned it between the two locks , try_emplace keeps whichever got there first
+    auto [itr , inserted] = state.strings.try_emplace(hash , str);
+    return StringId(hash , itr->second.c_str());
+  }
+
+  std::string_view StringInterner::Lookup(uint64_t hash) {
+    InternerState& state = State();
+
+    std::shared_lock lock(state.mutex);
+    if (auto itr = state.strings.find(hash); itr != state.strings.end()) {
+      return itr->second;
+    }
+    return {};
+  }
+
+  size_t StringInterner::Size() {
+    InternerState& state = State();
+
+    std::shared_lock lock(state.mutex);
+    return state.strings.size();
+  }
+
+} // namespace other
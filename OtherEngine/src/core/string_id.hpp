@@ -0,0 +1,99 @@
+/**
+ * \file core/string_id.hpp
+ **/
+#ifndef OTHER_ENGINE_STRING_ID_HPP
+#define OTHER_ENGINE_STRING_ID_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include <spdlog/fmt/fmt.h>
+
+#include "core/defines.hpp"
+
+namespace other {
+
+  /**
+   * a name hashed once , lookups key on Hash() so nothing is hashed where the id is used
+   *
+   * literals are hashed at compile time , runtime strings are interned and stay alive until shutdown , either way the
+   *   id keeps a pointer to its text so Str() works in every build
+   *
+   * ids compare by hash only , two ids with the same text are always equal
+   **/
+  class StringId {
+    public:
+      constexpr StringId() = default;
+
+      template <size_t N>
+      consteval StringId(const char (&literal)[N])
+          : hash(FNV(std::string_view{ literal , N - 1 })) , str(literal) {}
+
+      /// interns str , takes the interner's lock so keep these out of per frame code
+      explicit StringId(std::string_view str);
+
+      constexpr uint64_t Hash() const { return hash; }
+      constexpr bool Empty() const { return str == nullptr; }
+
+      std::string_view Str() const {
+        return str == nullptr ? std::string_view{} : std::string_view{ str };
+      }
+
+      constexpr bool operator==(const StringId& other) const { return hash == other.hash; }
+      constexpr auto operator<=>(const StringId& other) const { return hash <=> other.hash; }
+
+    private:
+      friend class StringInterner;
+
+      constexpr StringId(uint64_t hash , const char* str)
+          : hash(hash) , str(str) {}
+
+      uint64_t hash = 0;
+      const char* str = nullptr;
+  };
+
+  /**
+   * global , thread safe table of every runtime string turned into a StringId
+   *
+   * interned text is never freed so ids can be copied anywhere without owning anything
+   **/
+  class StringInterner {
+    public:
+      static StringId Intern(std::string_view str);
+
+      /**
+       * reverse lookup of an interned hash , empty when nothing with that hash was interned
+       *
+       * literal ids are hashed at compile time and never pass through here , so their hashes are only found once the
+       *   same text was also interned at runtime , Intern(id.Str()) registers a literal explicitly
+       **/
+      static std::string_view Lookup(uint64_t hash);
+
+      static size_t Size();
+  };
+
+} // namespace other
+
+namespace std {
+
+  template <>
+  struct hash<other::StringId> {
+    std::size_t operator()(const other::StringId& id) const {
+      return std::hash<uint64_t>()(id.Hash());
+    }
+  };
+
+} // namespace std
+
+template <>
+struct fmt::formatter<other::StringId> : public fmt::formatter<std::string_view> {
+  auto format(const other::StringId& id , fmt::format_context& ctx) {
+    if (id.Empty()) {
+      return fmt::formatter<std::string_view>::format(fmt::format(std::string_view{ "#{:016x}" } , id.Hash()) , ctx);
+    }
+    return fmt::formatter<std::string_view>::format(id.Str() , ctx);
+  }
+};
+
+#endif // !OTHER_ENGINE_STRING_ID_HPP
@@ -0,0 +1,205 @@
+/**
+ * \file core/thread_pool.cpp
+ **/
+#include "core/thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+#include "core/config_keys.hpp"
+#include "core/logger.hpp"
+#include "core/profile.hpp"
+
+namespace other {
+namespace {
+
+  int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+} // anonymous namespace
+
+  Scope<ThreadPool> ThreadPool::engine_pool = nullptr;
+
+  ThreadPool::ThreadPool(uint32_t num_workers)
+      : stats_start_ns(NowNs()) {
+    workers.reserve(num_workers);
+    for (uint32_t i = 0; i < num_workers; ++i) {
+      workers.emplace_back([this , i]() { WorkerMain(i); });
+    }
+  }
+
+  ThreadPool::~ThreadPool() {
+    {
+      std::lock_guard lock(queue_mutex);
+      stopping = true;
+    }
+    queue_cv.notify_all();
+
+    for (auto& w : workers) {
+      w.join();
+    }
+  }
+
+  void ThreadPool::Submit(Job job) {
+    if (workers.empty()) {
+      Run(job);
+      return;
+    }
+
+    {
+      std::lock_guard lock(queue_mutex);
+      queue.push_back(std::move(job));
+    }
+    queue_cv.notify_one();
+  }
+
+  void ThreadPool::Submit(std::vector<Job>& jobs) {
+    if (workers.empty()) {
+      for (auto& job : jobs) {
+        Run(job);
+      }
+      jobs.clear();
+      return;
+    }
+
+    {
+      std::lock_guard lock(queue_mutex);
+      for (auto& job : jobs) {
+        queue.push_back(std::move(job));
+      }
+    }
+    jobs.clear();
+    queue_cv.notify_all();
+  }
+
+  void ThreadPool::ParallelFor(uint32_t count , uint32_t grain , const std::function<void(uint32_t , uint32_t)>& fn) {
+    if (count == 0) {
+      return;
+    }
+
+    grain = std::max(grain , 1u);
+    const uint32_t num_chunks = (count + grain - 1) / grain;
+    const uint32_t num_helpers = std::min(NumWorkers() , num_chunks - 1);
+    if (num_helpers == 0) {
+      fn(0 , count);
+      return;
+    }
+
+    /// helpers that have not started by the time the caller finished every chunk never touch fn, so waiting is
+    ///   only for helpers already running and a busy or blocked pool can not deadlock the caller
+    struct SharedState {
+      std::atomic<uint32_t> next_chunk = 0;
+      std::atomic<uint32_t> active = 0;
+    };
+    constexpr uint32_t kClosed = 1u << 31;
+
+    auto state = std::make_shared<SharedState>();
+    auto run_chunks = [state , &fn , count , grain , num_chunks]() {
+      for (uint32_t c = state->next_chunk++; c < num_chunks; c = state->next_chunk++) {
+        const uint32_t begin = c * grain;
+        fn(begin , std::min(begin + grain , count));
+      }
+    };
+
+    std::vector<Job> helpers;
+    helpers.reserve(num_helpers);
+    for (uint32_t i = 0; i < num_helpers; ++i) {
+      helpers.push_back([state , run_chunks]() {
+        uint32_t active = state->active.load();
+        do {
+          if (active & kClosed) {
+            return;
+          }
+        } while (!state->active.compare_exchange_weak(active , active + 1));
+
+        run_chunks();
+        if (state->active.fetch_sub(1) - 1 == kClosed) {
+          state->active.notify_one();
+        }
+      });
+    }
+    Submit(helpers);
+
+    run_chunks();
+
+    for (uint32_t active = state->active.fetch_or(kClosed) | kClosed; active != kClosed; active = state->active.load()) {
+      state->active.wait(active);
+    }
+  }
+
+  uint32_t ThreadPool::NumWorkers() const {
+    return static_cast<uint32_t>(workers.size());
+  }
+
+  ThreadPoolStats ThreadPool::Stats() const {
+    ThreadPoolStats stats;
+    stats.num_workers = NumWorkers();
+    stats.jobs_executed = jobs_executed.load(std::memory_order_relaxed);
+    stats.busy_ms = static_cast<double>(busy_ns.load(std::memory_order_relaxed)) / 1e6;
+    stats.wall_ms = static_cast<double>(NowNs() - stats_start_ns.load(std::memory_order_relaxed)) / 1e6;
+
+    /// with no workers jobs run inline, occupancy is relative to the one submitting thread
+    const double capacity = stats.wall_ms * std::max(stats.num_workers , 1u);
+    stats.occupancy = capacity > 0.0 ? static_cast<float>(std::min(stats.busy_ms / capacity , 1.0)) : 0.f;
+    return stats;
+  }
+
+  void ThreadPool::ResetStats() {
+    jobs_executed = 0;
+    busy_ns = 0;
+    stats_start_ns = NowNs();
+  }
+
+  void ThreadPool::Initialize(const ConfigTable& config) {
+    OE_ASSERT(engine_pool == nullptr , "Engine thread pool initialized twice");
+
+    /// the main thread does work too, it usually waits on whatever it submitted
+    const uint32_t default_workers = std::max(std::thread::hardware_concurrency() , 1u) - 1;
+    uint32_t num_workers = config.GetVal<uint32_t>(kThreadPoolSection , kWorkersValue , false).value_or(default_workers);
+
+    engine_pool = NewScope<ThreadPool>(num_workers);
+    OE_DEBUG("Engine thread pool started with {} workers" , num_workers);
+  }
+
+  void ThreadPool::Shutdown() {
+    engine_pool = nullptr;
+  }
+
+  ThreadPool* ThreadPool::Get() {
+    return engine_pool.get();
+  }
+
+  void ThreadPool::WorkerMain(uint32_t index) {
+    OE_CHECK_AND_REGISTER_THREAD(fmtstr("Worker Thread {}" , index));
+    OE_PROFILE_THREAD(fmtstr("Worker Thread {}" , index).c_str());
+
+    while (true) {
+      Job job;
+      {
+        std::unique_lock lock(queue_mutex);
+        queue_cv.wait(lock , [this]() { return stopping || !queue.empty(); });
+
+        /// drain what is queued before exiting so nobody waits forever on a dropped job
+        if (queue.empty()) {
+          return;
+        }
+
+        job = std::move(queue.front());
+        queue.pop_front();
+      }
+
+      Run(job);
+    }
+  }
+
+  void ThreadPool::Run(Job& job) {
+    OE_PROFILE_SCOPE("ThreadPool::Job");
+    const int64_t start = NowNs();
+    job();
+    busy_ns.fetch_add(static_cast<uint64_t>(NowNs() - start) , std::memory_order_relaxed);
+    jobs_executed.fetch_add(1 , std::memory_order_relaxed);
+  }
+
+} // namespace other
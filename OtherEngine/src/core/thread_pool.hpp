@@ -0,0 +1,95 @@
+/**
+ * \file core/thread_pool.hpp
+ **/
+#ifndef OTHER_ENGINE_THREAD_POOL_HPP
+#define OTHER_ENGINE_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/defines.hpp"
+#include "core/config.hpp"
+#include "core/profile.hpp"
+
+namespace other {
+
+  struct ThreadPoolStats {
+    uint32_t num_workers = 0;
+    uint64_t jobs_executed = 0;
+    double busy_ms = 0.0;
+    double wall_ms = 0.0;
+
+    /// fraction of worker time spent running jobs since the last reset
+    float occupancy = 0.f;
+  };
+
+  /**
+   * fixed set of worker threads draining one shared job queue
+   *
+   * there is one engine wide pool created by ThreadPool::Initialize, subsystems that need threads submit to it
+   *   instead of creating their own so the total thread count stays at the number of cores no matter how many
+   *   scenes or worlds are alive
+   *
+   * a pool with zero workers runs each job on the submitting thread
+   **/
+  class ThreadPool {
+    public:
+      using Job = std::function<void()>;
+
+      ThreadPool(uint32_t num_workers);
+      ~ThreadPool();
+
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool& operator=(const ThreadPool&) = delete;
+
+      void Submit(Job job);
+
+      /// queues every job under one lock, jobs is left empty
+      void Submit(std::vector<Job>& jobs);
+
+      /**
+       * calls fn(begin , end) over [0 , count) in chunks of at most grain and returns once every chunk ran
+       *
+       * the calling thread takes chunks as well, so this makes progress even when every worker is busy and is safe
+       *   to call from inside a job
+       **/
+      void ParallelFor(uint32_t count , uint32_t grain , const std::function<void(uint32_t , uint32_t)>& fn);
+
+      uint32_t NumWorkers() const;
+
+      ThreadPoolStats Stats() const;
+      void ResetStats();
+
+      /// WORKERS in the THREAD-POOL section, defaults to one less than the number of cores
+      static void Initialize(const ConfigTable& config);
+      static void Shutdown();
+
+      /// the engine pool, null before Initialize and after Shutdown
+      static ThreadPool* Get();
+
+    private:
+      static Scope<ThreadPool> engine_pool;
+
+      std::vector<std::thread> workers;
+
+      OE_PROFILE_MUTEX(std::mutex , queue_mutex , "ThreadPool queue");
+      ProfiledConditionVariable queue_cv;
+      std::deque<Job> queue;
+      bool stopping = false;
+
+      std::atomic<uint64_t> jobs_executed = 0;
+      std::atomic<uint64_t> busy_ns = 0;
+      std::atomic<int64_t> stats_start_ns = 0;
+
+      void WorkerMain(uint32_t index);
+      void Run(Job& job);
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_THREAD_POOL_HPP
@@ -6,6 +6,27 @@
 namespace other {
 namespace time {
 
+  double NsPerTick() {
+#ifdef OE_HAS_TSC
+    static const double ns_per_tick = []() {
+      const TimePoint clock_start = Clock::now();
+      const uint64_t tick_start = Ticks();
+
+      TimePoint clock_end = clock_start;
+      while (clock_end - clock_start < std::chrono::milliseconds(2)) {
+        clock_end = Clock::now();
+      }
+      const uint64_t tick_end = Ticks();
+
+      const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_end - clock_start).count());
+      return tick_end > tick_start ? ns / static_cast<double>(tick_end - tick_start) : 1.0;
+    }();
+    return ns_per_tick;
+#else
+    return 1.0;
+#endif
+  }
+
   void Timer::Start() {
     if (!running) {
       start = Clock::now();
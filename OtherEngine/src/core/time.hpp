@@ -5,8 +5,17 @@
 #define OTHER_ENGINE_TIME_HPP
 
 #include <chrono>
+#include <cstdint>
 #include <thread>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #include <intrin.h>
+  #define OE_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+  #define OE_HAS_TSC 1
+#endif
+
 namespace other {
 namespace time {
 
@@ -14,6 +23,23 @@ namespace time {
   using Duration = std::chrono::duration<uint64_t , std::micro>;
   using TimePoint = std::chrono::time_point<std::chrono::steady_clock>;
 
+  /**
+   * raw timestamp for hot paths that cannot afford a Clock::now() per sample, the cpu time stamp counter where there
+   *   is one and Clock nanoseconds otherwise
+   *
+   * only differences between ticks mean anything, NsPerTick converts them
+   **/
+  inline uint64_t Ticks() {
+#ifdef OE_HAS_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+#endif
+  }
+
+  /// measured against Clock once on first call , that call blocks for a couple of milliseconds
+  double NsPerTick();
+
   class Timer {
     TimePoint start;
     TimePoint end;
@@ -6,55 +6,116 @@
 namespace other {
 
   Value::Value(Value&& other) {
-    type = other.type;
-    value = other.value;
-    other.value.Release();
+    std::memcpy(static_cast<void*>(this) , &other , sizeof(Value));
+    other.flags = 0;
+    other.Clear();
   }
 
   Value::Value(const Value& other) {
-    type = other.type;
-    value = other.value;
+    CopyFrom(other);
   }
 
   Value& Value::operator=(Value&& other) {
-    type = other.type;
-    value = other.value;
-    other.value.Release();
+    if (this == &other) {
+      return *this;
+    }
+
+    Release();
+    std::memcpy(static_cast<void*>(this) , &other , sizeof(Value));
+    other.flags = 0;
+    other.Clear();
     return *this;
   }
 
   Value& Value::operator=(const Value& other) {
-    type = other.type;
-    value = other.value;
+    if (this != &other) {
+      CopyFrom(other);
+    }
     return *this;
   }
       
   Value::~Value() {
-    value.Release();
+    Release();
+  }
+
+  std::string_view Value::AsString() const {
+    OE_ASSERT(Type() == ValueType::CHAR || Type() == ValueType::EMPTY , "Cannot read a value of type {} as a string" , type);
+    return { reinterpret_cast<const char*>(Data()) , size };
   }
   
   void* Value::AsRawMemory() const {
-    return static_cast<void*>(const_cast<uint8_t*>(value.ReadBytes()));
+    return static_cast<void*>(const_cast<uint8_t*>(Data()));
   }
       
   void Value::Clear() {
-    value.Release();
+    Release();
+    size = 0;
+    element_size = 0;
+    type = ValueType::EMPTY;
+    flags = 0;
   }
 
   ValueType Value::Type() const {
-    return type;
+    return static_cast<ValueType>(type);
   }
       
   bool Value::IsArray() const {
-    return is_array;
+    return (flags & kArrayFlag) != 0;
   }
 
   size_t Value::Size() const {
-    return value.Size();
+    return size;
   }
       
   size_t Value::NumElements() const {
-    return value.NumElements();
+    return element_size == 0 ? 0 : size / element_size;
+  }
+
+  bool Value::IsOutOfLine() const {
+    return (flags & kHeapFlag) != 0;
+  }
+
+  void Value::Assign(const void* src , size_t bytes , size_t elem_size , ValueType new_type , bool is_array) {
+    uint8_t* dst = local;
+    if (IsOutOfLine() && bytes <= heap.capacity) {
+      dst = heap.data;
+    } else if (bytes > kInlineCapacity) {
+      Release();
+      heap.data = new uint8_t[bytes];
+      heap.capacity = static_cast<uint32_t>(bytes);
+      flags = kHeapFlag;
+      dst = heap.data;
+    } else {
+      Release();
+      flags = 0;
+    }
+
+    if (bytes > 0) {
+      std::memcpy(dst , src , bytes);
+    }
+
+    size = static_cast<uint32_t>(bytes);
+    element_size = static_cast<uint16_t>(elem_size);
+    type = static_cast<uint8_t>(new_type);
+    flags = is_array ? (flags | kArrayFlag) : (flags & ~kArrayFlag);
+  }
+
+  void Value::CopyFrom(const Value& other) {
+    if (!other.IsOutOfLine() && !IsOutOfLine()) {
+      std::memcpy(static_cast<void*>(this) , &other , sizeof(Value));
+      return;
+    }
+
+    Assign(other.Data() , other.size , other.element_size , other.Type() , other.IsArray());
+  }
+
+  void Value::Release() {
+    if (IsOutOfLine()) {
+      delete[] heap.data;
+      heap.data = nullptr;
+      heap.capacity = 0;
+      flags &= ~kHeapFlag;
+    }
   }
 
 } // namespace other
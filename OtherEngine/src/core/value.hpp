@@ -8,19 +8,34 @@
 #include <glm/glm.hpp>
 
 #include <reflection/echo_defines.hpp>
+#include <cstring>
 #include <span>
+#include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "core/defines.hpp"
-#include "core/buffer.hpp"
+#include "core/logger.hpp"
 
 namespace other {
 
+  /**
+   * a tagged value for script fields and editor properties , 32 bytes
+   *
+   * scalars , glm vectors , short strings and small arrays live inline , anything over kInlineCapacity bytes goes to
+   *   the heap and that allocation is reused by later values that still fit. copying an inline value is a plain
+   *   copy of the 32 bytes
+   *
+   * strings are CHAR arrays without a terminator
+   **/
   class Value {
     public:
+      static constexpr size_t kInlineCapacity = 24;
+
       Value() {}
 
       template <typename T>
+        requires (!std::same_as<std::remove_cvref_t<T> , Value>)
       Value(T val) {
         Set<T>(val);
       }
@@ -35,45 +50,58 @@ namespace other {
       template <typename T>
         requires std::is_trivially_copyable_v<T>
       T Get() const {
-        OE_ASSERT(!is_array , "Cannot use .Get<{}> on value when it is an array!" , typeid(T).name());
-        T ret = value.Read<T>();
+        OE_ASSERT(!IsArray() , "Cannot use .Get<{}> on value when it is an array!" , typeid(T).name());
+        OE_ASSERT(sizeof(T) <= size , "Cannot use .Get<{}> on a value of {} bytes" , typeid(T).name() , size);
+        T ret;
+        std::memcpy(&ret , Data() , sizeof(T));
         return ret;
       }
 
       template <typename T>
         requires std::same_as<T , std::string>
       std::string Get() const {
-        OE_ASSERT(!is_array , "Cannot use .Get<std::string> on value when it is an array!");
-        std::string res;
-        res.resize(value.Size());
-        for (uint32_t i = 0; i < value.Size(); ++i) {
-          res[i] = value.At<char>(i);
-        }
-
-        return res; 
+        return std::string{ AsString() };
       }
 
       template <typename T>
         requires std::is_trivially_copyable_v<T>
       const T& Read() const {
-        OE_ASSERT(!is_array , "Cannot use .Read<{}> on value when it is an array!" , typeid(T).name());
-        return value.Read<T>();
+        OE_ASSERT(!IsArray() , "Cannot use .Read<{}> on value when it is an array!" , typeid(T).name());
+        OE_ASSERT(sizeof(T) <= size , "Cannot use .Read<{}> on a value of {} bytes" , typeid(T).name() , size);
+        return *reinterpret_cast<const T*>(Data());
       }
 
       template <typename T>
         requires std::is_trivially_copyable_v<T>
       T& At(size_t index) {
-        OE_ASSERT(is_array , "Can not index into value with .At<{}> if it is not an array!" , typeid(T).name());
-        return value.At<T>(index);
+        OE_ASSERT(IsArray() , "Can not index into value with .At<{}> if it is not an array!" , typeid(T).name());
+        OE_ASSERT((index + 1) * sizeof(T) <= size , "Index {} out of range of value with {} bytes" , index , size);
+        return reinterpret_cast<T*>(Data())[index];
       }
-      
+
       template <typename T>
         requires std::is_trivially_copyable_v<T>
       const T& At(size_t index) const {
-        OE_ASSERT(is_array , "Can not index into value with .At<{}> if it is not an array!" , typeid(T).name());
-        return At<T>(index);
+        OE_ASSERT(IsArray() , "Can not index into value with .At<{}> if it is not an array!" , typeid(T).name());
+        OE_ASSERT((index + 1) * sizeof(T) <= size , "Index {} out of range of value with {} bytes" , index , size);
+        return reinterpret_cast<const T*>(Data())[index];
+      }
+
+      /// every element of an array , or the single element of a scalar
+      template <typename T>
+        requires std::is_trivially_copyable_v<T>
+      std::span<T> AsSpan() {
+        return { reinterpret_cast<T*>(Data()) , size / sizeof(T) };
+      }
+
+      template <typename T>
+        requires std::is_trivially_copyable_v<T>
+      std::span<const T> AsSpan() const {
+        return { reinterpret_cast<const T*>(Data()) , size / sizeof(T) };
       }
 
+      std::string_view AsString() const;
+
       void* AsRawMemory() const;
 
       void Clear();
@@ -81,23 +109,19 @@ namespace other {
       template <typename T>
         requires std::is_trivially_copyable_v<T>
       void Set(const T& val) {
-        value.Write<T>(val);
-        type = GetValueType<T>();
+        Assign(&val , sizeof(T) , sizeof(T) , GetValueType<T>() , false);
       }
 
       template <typename T>
+        requires std::is_trivially_copyable_v<T>
       void Set(const std::span<T>& values) {
-        value.WriteArr<T>(values);
-        type = GetValueType<T>();
-
-        is_array = true;
+        Assign(values.data() , values.size_bytes() , sizeof(T) , GetValueType<T>() , true);
       }
 
       template <typename T>
         requires std::same_as<T , std::string>
       void Set(const std::string& val) {
-        std::vector<char> string_chars{ val.begin() , val.end() };
-        Set<char>(std::span{ string_chars });
+        Assign(val.data() , val.size() , sizeof(char) , ValueType::CHAR , true);
       }
 
       ValueType Type() const;
@@ -105,7 +129,10 @@ namespace other {
       size_t Size() const;
       size_t NumElements() const;
 
-      template <typename T> 
+      /// true once the value has outgrown the inline storage
+      bool IsOutOfLine() const;
+
+      template <typename T>
         /// because setters are limited to this we limit the types that can be unwrapped as well
         requires std::is_trivially_copyable_v<T>
       static T Unwrap(const Value& val) {
@@ -113,12 +140,39 @@ namespace other {
       }
 
     private:
-      bool is_array = false;
+      static constexpr uint8_t kArrayFlag = 1 << 0;
+      static constexpr uint8_t kHeapFlag = 1 << 1;
+
+      struct HeapStorage {
+        uint8_t* data;
+        uint32_t capacity;
+      };
+
+      union {
+        alignas(8) uint8_t local[kInlineCapacity] = {};
+        HeapStorage heap;
+      };
+
+      uint32_t size = 0;
+      uint16_t element_size = 0;
+      uint8_t type = ValueType::EMPTY;
+      uint8_t flags = 0;
+
+      uint8_t* Data() {
+        return (flags & kHeapFlag) ? heap.data : local;
+      }
+
+      const uint8_t* Data() const {
+        return (flags & kHeapFlag) ? heap.data : local;
+      }
 
-      ValueType type = ValueType::EMPTY;
-      Buffer value;
+      void Assign(const void* src , size_t bytes , size_t elem_size , ValueType new_type , bool is_array);
+      void CopyFrom(const Value& other);
+      void Release();
   };
 
+  static_assert(sizeof(Value) == 32 , "Value should stay 32 bytes");
+
 } // namespace other
 
 ECHO_TYPE(
@@ -30,6 +30,8 @@ namespace other {
  *  - add a ctor function for the component serializer list in ecs/systems/entity_serialization.cpp
  *      (this must have the same index as specified below)
  *  - add a AddComponentButton in editor/entity_properties.hpp 
+ *  - reflect the fields that are saved with ECHO_TYPE below the component and add it to ReflectedComponents in
+ *      ecs/ecs_reflection.hpp , that is all the binary serializer needs
  *
  *  - (optional) implement any UI functionality in ecs/systems/component_gui and add the call to DrawComponent<>(name , func)
  *      in the editor/entity_properties.hpp
@@ -159,4 +159,40 @@ namespace other {
     }
   }
 
+  void BinaryCodec<Ref<CameraBase>>::Write(BinaryWriter& writer, const Ref<CameraBase>& camera) {
+    if (camera == nullptr) {
+      writer.Write(INVALID_CAMERA_PROJ);
+      return;
+    }
+
+    writer.Write(camera->GetCameraProjectionType());
+    BinaryRecord<CameraBase>::Write(writer, *camera);
+  }
+
+  bool BinaryCodec<Ref<CameraBase>>::Read(BinaryReader& reader, Ref<CameraBase>& camera) {
+    CameraProjectionType type = INVALID_CAMERA_PROJ;
+    if (!reader.Read(type)) {
+      return false;
+    }
+
+    /// the viewport is one of the properties , the size given here is overwritten
+    switch (type) {
+      case PERSPECTIVE:
+        camera = NewRef<PerspectiveCamera>(glm::ivec2{ 800, 600 });
+        break;
+      case ORTHOGRAPHIC:
+        camera = NewRef<OrthographicCamera>(glm::ivec2{ 800, 600 });
+        break;
+      case INVALID_CAMERA_PROJ:
+        camera = nullptr;
+        return true;
+      default:
+        OE_ERROR("Failed to read camera , unknown projection type {}", static_cast<uint32_t>(type));
+        reader.Fail();
+        return false;
+    }
+
+    return BinaryRecord<CameraBase>::Read(reader, *camera);
+  }
+
 }  // namespace other
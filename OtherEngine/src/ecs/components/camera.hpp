@@ -4,6 +4,7 @@
 #ifndef OTHER_ENGINE_CAMERA_HPP
 #define OTHER_ENGINE_CAMERA_HPP
 
+#include "core/binary_serializer.hpp"
 #include "core/ref.hpp"
 #include "ecs/component.hpp"
 #include "ecs/component_serializer.hpp"
@@ -27,6 +28,20 @@ namespace other {
       COMPONENT_SERIALIZERS(Camera)
   };
 
+  /// the projection type then the camera's properties , reading makes a new camera of that type
+  template <>
+  struct BinaryCodec<Ref<CameraBase>> {
+    static void Write(BinaryWriter& writer , const Ref<CameraBase>& camera);
+    static bool Read(BinaryReader& reader , Ref<CameraBase>& camera);
+  };
+
 } // namespace other
 
+ECHO_TYPE(
+  type(other::Camera) ,
+  field(camera) ,
+  field(pinned_to_entity_position) ,
+  field(is_primary)
+);
+
 #endif // !OTHER_ENGINE_CAMERA_HPP
@@ -1,4 +1,3 @@
-
 /**
  * \file ecs/components/collider.cpp
  **/
@@ -15,13 +14,63 @@ namespace other {
     auto& collider = entity->GetComponent<Collider>();
     
     SerializeComponentSection(stream , entity , "collider");
+
+    stream << "shape = ";
+    switch (collider.shape) {
+      case ColliderShape::BOX_COLLIDER:
+        stream << "\"box\"\n";
+        break;
+      case ColliderShape::SPHERE_COLLIDER:
+        stream << "\"sphere\"\n";
+        break;
+      case ColliderShape::CAPSULE_COLLIDER:
+        stream << "\"capsule\"\n";
+        break;
+      default:
+        break;
+    }
+
+    SerializeVec3(stream , "offset" , collider.offset);
+    SerializeVec3(stream , "size" , collider.size);
   }
 
   void ColliderSerializer::Deserialize(Entity* entity , const ConfigTable& scene_table , Ref<Scene>& scene) const {
-    OE_ASSERT(entity != nullptr && scene != nullptr , "Attempting to deserialize a rigid-body into null entity or scene!");
+    OE_ASSERT(entity != nullptr && scene != nullptr , "Attempting to deserialize a collider into null entity or scene!");
     std::string key_value = GetComponentSectionKey(entity->Name() , std::string{ kColliderValue });
 
     auto& collider = entity->GetComponent<Collider>();
+
+    /// colliders saved before they carried a shape are boxes the size of their transform
+    auto shape_value = scene_table.Get(key_value , kShapeValue);
+    std::string shape = shape_value.size() == 1 ? shape_value[0] : std::string{ kBoxValue };
+    std::string uc_shape;
+    std::transform(shape.begin() , shape.end() , std::back_inserter(uc_shape) , ::toupper);
+
+    switch (FNV(uc_shape)) {
+      case kBoxValueHash:
+        collider.shape = BOX_COLLIDER;
+        break;
+      case kSphereValueHash:
+        collider.shape = SPHERE_COLLIDER;
+        break;
+      case kCapsuleValueHash:
+        collider.shape = CAPSULE_COLLIDER;
+        break;
+      default:
+        OE_ERROR("Collider shape {} is not a box , sphere or capsule , cannot deserialize into entity {}" , shape , entity->Name());
+        entity->RemoveComponent<Collider>();
+        return;
+    }
+
+    auto offset_value = scene_table.Get(key_value , kOffsetValue);
+    if (offset_value.size() == 3) {
+      DeserializeVec3(offset_value , collider.offset);
+    }
+
+    auto size_value = scene_table.Get(key_value , kSizeValue);
+    if (size_value.size() == 3) {
+      DeserializeVec3(size_value , collider.size);
+    }
   }
 
 } // namespace other
@@ -1,17 +1,31 @@
-
 /**
  * \file ecs/components/collider.hpp
  **/
 #ifndef OTHER_ENGINE_COLLIDER_HPP
 #define OTHER_ENGINE_COLLIDER_HPP
 
+#include <glm/glm.hpp>
+
 #include "ecs/component.hpp"
 #include "ecs/component_serializer.hpp"
 
+#include "physics/physics_defines.hpp"
+
 namespace other {
 
+  /**
+   * the shape of the entity's 3D rigid body , offset and size are in the entity's local space and scaled by its
+   *   transform
+   *
+   * a box uses size as its full extents , a sphere's diameter is the largest axis of size , a capsule takes its
+   *   diameter from x and z and its total height from y
+   **/
   struct Collider : public Component {
-    ECS_COMPONENT(Collider , kRigidBodyIndex);
+    ColliderShape shape = BOX_COLLIDER;
+    glm::vec3 offset{ 0.f };
+    glm::vec3 size{ 1.f };
+
+    ECS_COMPONENT(Collider , kColliderIndex);
   };
 
   class ColliderSerializer : public ComponentSerializer {
@@ -21,4 +35,11 @@ namespace other {
 
 } // namespace other
 
+ECHO_TYPE(
+  type(other::Collider) ,
+  field(shape) ,
+  field(offset) ,
+  field(size)
+);
+
 #endif // !OTHER_ENGINE_COLLIDER_HPP
@@ -31,4 +31,12 @@ namespace other {
 
 } // namespace other
 
+ECHO_TYPE(
+  type(other::Collider2D) ,
+  field(offset) ,
+  field(size) ,
+  field(density) ,
+  field(friction)
+);
+
 #endif // !OTHER_ENGINE_COLLIDER_2D_HPP
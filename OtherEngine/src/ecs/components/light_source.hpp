@@ -5,6 +5,7 @@
 #ifndef OTHER_ENGINE_LIGHT__SOURCE_HPP
 #define OTHER_ENGINE_LIGHT__SOURCE_HPP
 
+#include "core/binary_serializer.hpp"
 #include "ecs/component.hpp"
 #include "ecs/component_serializer.hpp"
 
@@ -43,4 +44,17 @@ namespace other {
 
 } // namespace other
 
+/// only the union member the type selects is written
+ECHO_TYPE(
+  type(other::LightSource) ,
+  field(type) ,
+  field(direction_light , other::SerializeIf<other::LightSource>([](const other::LightSource& light) {
+    return light.type == other::DIRECTION_LIGHT_SRC;
+  })) ,
+  field(pointlight , other::SerializeIf<other::LightSource>([](const other::LightSource& light) {
+    return light.type == other::POINT_LIGHT_SRC;
+  })) ,
+  field(debug_model)
+);
+
 #endif // !OTHER_ENGINE_LIGHT_SOURCE_HPP
@@ -57,4 +57,22 @@ namespace other {
 
 }  // namespace other
 
+ECHO_TYPE(
+  type(other::Mesh) ,
+  field(handle) ,
+  field(material) ,
+  field(bone_entity_ids) ,
+  field(visible)
+);
+
+ECHO_TYPE(
+  type(other::StaticMesh) ,
+  field(handle) ,
+  field(material) ,
+  field(visible) ,
+  field(is_primitive) ,
+  field(primitive_id) ,
+  field(primitive_selection)
+);
+
 #endif  // !OTHER_ENGINE_MESH_HPP
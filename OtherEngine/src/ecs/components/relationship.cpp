@@ -61,7 +61,7 @@ namespace other {
         return c == ent.second->Name();
       }) != loaded_ents.end()) {
         /// entity already loaded, so now we add it as a child of this one
-        Entity* child = scene->GetEntity(c);
+        Entity* child = scene->GetEntity(StringId{ c });
         
         /// double check we loaded it, this should never not be true, if it is
         ///  we can attempt to load it again outside of this if case below
@@ -27,4 +27,10 @@ namespace other {
 
 } // namespace other 
 
+ECHO_TYPE(
+  type(other::Relationship) ,
+  field(parent) ,
+  field(children)
+);
+
 #endif // !OTHER_ENGINE_RELATIONSHIP_HPP
@@ -9,6 +9,9 @@
 #include <Jolt/Physics/Body/Body.h>
 #include <Jolt/Physics/Body/BodyID.h>
 
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
 #include "ecs/component.hpp"
 #include "ecs/component_serializer.hpp"
 
@@ -41,6 +44,13 @@ namespace other {
     JPH::BodyID body_id;
     // JPH::Body* body = nullptr;
 
+    /// poses at the last two fixed steps, the transform is blended between them at render time
+    glm::vec3 prev_position{ 0.f };
+    glm::vec3 curr_position{ 0.f };
+    glm::quat prev_rotation{ 1.f , 0.f , 0.f , 0.f };
+    glm::quat curr_rotation{ 1.f , 0.f , 0.f , 0.f };
+    uint64_t last_active_step = 0;
+
     ECS_COMPONENT(RigidBody , kRigidBodyIndex);
   };
 
@@ -51,4 +61,22 @@ namespace other {
 
 } // namespace other
 
+/// the jolt body and the interpolation poses are rebuilt by the physics system
+ECHO_TYPE(
+  type(other::RigidBody) ,
+  field(type) ,
+  field(layer_id) ,
+  field(enable_dynamic_type_change) ,
+  field(mass) ,
+  field(linear_drag) ,
+  field(angular_drag) ,
+  field(disable_gravity) ,
+  field(is_trigger) ,
+  field(collision_type) ,
+  field(initial_linear_velocity) ,
+  field(initial_angular_velocity) ,
+  field(max_linear_velocity) ,
+  field(max_angular_velocity)
+);
+
 #endif // !OTHER_ENGINE_RIGID_BODY_HPP
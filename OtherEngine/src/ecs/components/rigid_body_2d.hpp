@@ -4,6 +4,7 @@
 #ifndef OTHER_ENGINE_RIGID_BODY_2D_HPP
 #define OTHER_ENGINE_RIGID_BODY_2D_HPP
 
+#include <glm/glm.hpp>
 #include <box2d/b2_body.h>
 #include <box2d/b2_fixture.h>
 
@@ -28,6 +29,13 @@ namespace other {
     bool fixed_rotation = false;
     bool bullet = false;
 
+    /// poses at the last two fixed steps, the transform is blended between them at render time
+    glm::vec2 prev_position{ 0.f };
+    glm::vec2 curr_position{ 0.f };
+    float prev_angle = 0.f;
+    float curr_angle = 0.f;
+    uint64_t last_active_step = 0;
+
     ECS_COMPONENT(RigidBody2D , kRigidBody2DIndex);
   }; 
 
@@ -38,4 +46,16 @@ namespace other {
 
 } // namespace other
 
+/// the box2d body and the interpolation poses are rebuilt by the physics system
+ECHO_TYPE(
+  type(other::RigidBody2D) ,
+  field(type) ,
+  field(mass) ,
+  field(linear_drag) ,
+  field(angular_drag) ,
+  field(gravity_scale) ,
+  field(fixed_rotation) ,
+  field(bullet)
+);
+
 #endif // !OTHER_ENGINE_RIGID_BODY_2D_HPP
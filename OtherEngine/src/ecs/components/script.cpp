@@ -8,6 +8,7 @@
 
 #include "core/config_keys.hpp"
 #include "core/logger.hpp"
+#include "core/profile.hpp"
 
 #include "ecs/entity.hpp"
 
@@ -61,12 +62,16 @@ namespace other {
   }
 
   void Script::ApiCall(const std::string_view name) {
+    OE_PROFILE_SCOPE("Script::ApiCall");
+    OE_PROFILE_TAG(name);
     for (auto& [id, obj] : scripts) {
       obj->CallMethod<void>(std::string{ name });
     }
   }
 
   void Script::ApiCall(const std::string_view name, float dt) {
+    OE_PROFILE_SCOPE("Script::ApiCall");
+    OE_PROFILE_TAG(name);
     for (auto& [id, obj] : scripts) {
       obj->CallMethod<void, float>(std::string{ name }, std::forward<float>(dt));
     }
@@ -107,6 +112,90 @@ namespace other {
     scripts.clear();
   }
 
+  void Script::SetData(const std::map<UUID, ScriptObjectData>& new_data) {
+    data = new_data;
+    std::erase_if(scripts, [this](const auto& script) {
+      return !data.contains(script.first);
+    });
+  }
+
+  bool Script::LoadScripts() {
+    bool loaded = true;
+
+    /// AddScript writes the description back into data
+    const auto descriptions = data;
+    for (const auto& [id, desc] : descriptions) {
+      if (scripts.contains(id)) {
+        continue;
+      }
+      loaded &= AddScript(desc.obj_name, "", desc.module).Get() != 0;
+    }
+
+    return loaded;
+  }
+
+  void Script::SaveFieldState(BinaryWriter& writer) const {
+    writer.Write(static_cast<uint32_t>(scripts.size()));
+    for (const auto& [id, instance] : scripts) {
+      writer.Write(id.Get());
+
+      const auto& fields = instance->GetFields();
+      writer.Write(static_cast<uint32_t>(fields.size()));
+      for (const auto& [field_id, field] : fields) {
+        writer.Write(field_id.Get());
+        writer.Write(static_cast<uint32_t>(field.value.Size()));
+        writer.Write(field.value.AsRawMemory(), field.value.Size());
+      }
+    }
+  }
+
+  bool Script::RestoreFieldState(BinaryReader& reader) {
+    uint32_t num_scripts = 0;
+    if (!reader.Read(num_scripts)) {
+      return false;
+    }
+
+    for (uint32_t i = 0; i < num_scripts; ++i) {
+      uint64_t id = 0;
+      uint32_t num_fields = 0;
+      if (!reader.Read(id) || !reader.Read(num_fields)) {
+        return false;
+      }
+
+      auto itr = scripts.find(id);
+      ScriptObject* instance = itr != scripts.end() && itr->second != nullptr ? itr->second.Raw() : nullptr;
+
+      for (uint32_t j = 0; j < num_fields; ++j) {
+        uint64_t field_id = 0;
+        uint32_t size = 0;
+        if (!reader.Read(field_id) || !reader.Read(size)) {
+          return false;
+        }
+
+        const uint8_t* bytes = reader.Consume(size);
+        if (bytes == nullptr) {
+          return false;
+        }
+
+        if (instance == nullptr) {
+          continue;
+        }
+
+        /// a field whose size changed keeps the value the new instance gave it
+        auto& fields = instance->GetFields();
+        if (auto field = fields.find(field_id); field != fields.end() && field->second.value.Size() == size) {
+          std::memcpy(field->second.value.AsRawMemory(), bytes, size);
+        }
+      }
+
+      if (instance != nullptr) {
+        instance->UpdateNativeFields();
+      }
+    }
+
+    return true;
+  }
+
   void ScriptSerializer::Serialize(std::ostream& stream, Entity* entity, const Ref<Scene>& scene) const {
     const auto& script = entity->GetComponent<Script>();
 
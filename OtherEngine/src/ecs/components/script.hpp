@@ -8,6 +8,7 @@
 #include <map>
 #include <type_traits>
 
+#include "core/binary_serializer.hpp"
 #include "core/uuid.hpp"
 #include "ecs/component.hpp"
 #include "ecs/component_serializer.hpp"
@@ -39,6 +40,21 @@ namespace other {
 
     const auto& GetScripts() const { return scripts; }
 
+    /// what each script was attached from , this is what is saved , the instances are not
+    const std::map<UUID , ScriptObjectData>& GetData() const { return data; }
+
+    /// replaces the saved descriptions , drops instances that are no longer described , LoadScripts attaches the rest
+    void SetData(const std::map<UUID , ScriptObjectData>& new_data);
+
+    /// attaches an instance for every description that does not have one yet , false if any failed to load
+    bool LoadScripts();
+
+    /// the raw bytes of every field of every instance , for scene snapshots
+    void SaveFieldState(BinaryWriter& writer) const;
+
+    /// copies saved bytes back into fields with the same script , id and size , false if the data is truncated
+    bool RestoreFieldState(BinaryReader& reader);
+
     private:
       std::map<UUID , ScriptObjectData> data = {};
       std::map<UUID , ScriptRef<CsObject>> scripts = {};
@@ -59,4 +75,16 @@ namespace other {
 
 } // namespace other
 
+ECHO_TYPE(
+  type(other::ScriptObjectData) ,
+  field(module) ,
+  field(obj_name)
+);
+
+ECHO_TYPE(
+  type(other::Script) ,
+  func(GetData , property("data")) ,
+  func(SetData , property("data"))
+);
+
 #endif // !OTHER_ENGINE_SCRIPT_HPP
@@ -18,4 +18,9 @@ namespace other {
 
 } // namespace other
 
+ECHO_TYPE(
+  type(other::SerializationData) ,
+  field(entity_components)
+);
+
 #endif // !OTHER_ENGINE_ENTITY_SERIALIZATION_DATA_HPP
@@ -26,4 +26,11 @@ namespace other {
 
 } // namespace other
 
+ECHO_TYPE(
+  type(other::Tag) ,
+  field(name) ,
+  field(id) ,
+  field(handle)
+);
+
 #endif // !OTHER_ENGINE_TAG_HPP
@@ -52,4 +52,13 @@ namespace other {
 
 }  // namespace other
 
+ECHO_TYPE(
+  type(other::Transform) ,
+  field(scale) ,
+  field(position) ,
+  field(erotation) ,
+  field(qrotation) ,
+  field(model_transform)
+);
+
 #endif  // !OTHER_ENGINE_TRANSFORM_HPP
@@ -4,11 +4,186 @@
 #ifndef OTHER_ENGINE_ECS_REFLECTION_HPP
 #define OTHER_ENGINE_ECS_REFLECTION_HPP
 
+#include <algorithm>
+#include <vector>
+
 #include <entt/entt.hpp>
 #include <entt/meta/meta.hpp>
 
+#include "core/binary_serializer.hpp"
+
+#include "ecs/component.hpp"
+#include "ecs/components/camera.hpp"
+#include "ecs/components/collider.hpp"
+#include "ecs/components/collider_2d.hpp"
+#include "ecs/components/light_source.hpp"
+#include "ecs/components/mesh.hpp"
+#include "ecs/components/relationship.hpp"
+#include "ecs/components/rigid_body.hpp"
+#include "ecs/components/rigid_body_2d.hpp"
+#include "ecs/components/script.hpp"
+#include "ecs/components/tag.hpp"
+#include "ecs/components/transform.hpp"
+
 namespace other {
 
+  /// every component in kComponentTags , in index order
+  using ReflectedComponents = entt::type_list<
+    Tag , Transform , Relationship , Mesh , StaticMesh , Script , Camera , RigidBody2D , Collider2D , RigidBody , Collider ,
+    LightSource
+  >;
+
+  static_assert(ReflectedComponents::size == kNumComponents , "a component is missing from ReflectedComponents");
+
+  enum class BinaryPoolFormat : uint8_t {
+    /// one BinaryRecord layout then the values of every component
+    RECORDS = 0 ,
+    /// the components' bytes exactly as the pool stores them
+    RAW = 1 ,
+  };
+
+  /**
+   * writes every C in the registry , in the pool's packed order
+   *
+   * on disk: u32 count , u8 BinaryPoolFormat , the packed entity array , then
+   *   RAW     : u32 sizeof(C) and each page of the pool copied as is
+   *   RECORDS : the BinaryRecord layout once and the values of each component
+   *
+   * trivially copyable components take the RAW path , one memcpy per pool page , everything else is written field
+   *   by field so it can be read back by a later version of the component
+   **/
+  template <typename C>
+  uint32_t SerializePool(BinaryWriter& writer , const entt::registry& registry) {
+    using traits = entt::component_traits<C>;
+    static_assert(!traits::in_place_delete , "pools with tombstones can not be written in packed order");
+
+    const auto* storage = registry.storage<C>();
+    const uint32_t count = storage == nullptr ? 0 : static_cast<uint32_t>(storage->size());
+
+    constexpr BinaryPoolFormat format = std::is_trivially_copyable_v<C> ? BinaryPoolFormat::RAW : BinaryPoolFormat::RECORDS;
+    writer.Write(count);
+    writer.Write(format);
+    if (count == 0) {
+      return 0;
+    }
+
+    writer.Write(storage->data() , count * sizeof(entt::entity));
+
+    if constexpr (format == BinaryPoolFormat::RAW) {
+      static_assert(traits::page_size > 0 , "empty components have no storage to copy");
+
+      writer.Write(static_cast<uint32_t>(sizeof(C)));
+      const auto* pages = storage->raw();
+      for (size_t first = 0; first < count; first += traits::page_size) {
+        const size_t num = (std::min)(static_cast<size_t>(count) - first , traits::page_size);
+        writer.Write(pages[first / traits::page_size] , num * sizeof(C));
+      }
+    } else {
+      /// iterating the storage walks it back to front , the values have to follow the entity array
+      BinaryRecord<C>::WriteLayout(writer);
+      const entt::entity* packed = storage->data();
+      for (uint32_t i = 0; i < count; ++i) {
+        BinaryRecord<C>::WriteValues(writer , storage->get(packed[i]));
+      }
+    }
+
+    return count;
+  }
+
+  /**
+   * reads a pool written by SerializePool into registry , entities that are not alive are created with the same id ,
+   *   components they already have are overwritten
+   *
+   * the Component base (parent uuid , entity , handle) is not part of the data , it is left to whoever attaches the
+   *   entity to a scene
+   *
+   * raw pools are copied page by page only when the packed order after inserting the entities is the order they were
+   *   written in , an owning group on C moves entities as they are inserted and those pools are copied per entity
+   *
+   * false when the data is truncated , corrupt , or written in a format C can no longer be read from
+   **/
+  template <typename C>
+  bool DeserializePool(BinaryReader& reader , entt::registry& registry) {
+    using traits = entt::component_traits<C>;
+
+    uint32_t count = 0;
+    BinaryPoolFormat format = BinaryPoolFormat::RECORDS;
+    if (!reader.Read(count) || !reader.Read(format)) {
+      return false;
+    }
+
+    if (count == 0) {
+      return true;
+    }
+
+    std::vector<entt::entity> entities(count);
+    if (!reader.Read(entities.data() , count * sizeof(entt::entity))) {
+      return false;
+    }
+
+    for (const entt::entity entity : entities) {
+      if (!registry.valid(entity) && registry.create(entity) != entity) {
+        reader.Fail();
+        return false;
+      }
+    }
+
+    auto& storage = registry.storage<C>();
+
+    if (format == BinaryPoolFormat::RAW) {
+      if constexpr (std::is_trivially_copyable_v<C>) {
+        uint32_t size = 0;
+        if (!reader.Read(size) || size != sizeof(C)) {
+          reader.Fail();
+          return false;
+        }
+
+        const uint8_t* bytes = reader.Consume(static_cast<size_t>(count) * sizeof(C));
+        if (bytes == nullptr) {
+          return false;
+        }
+
+        /// an empty pool is filled in the same packed order it was written in , page by page , unless an owning
+        ///   group reordered it while the entities were inserted
+        if (storage.empty()) {
+          storage.insert(entities.begin() , entities.end());
+
+          if (std::equal(entities.begin() , entities.end() , storage.data())) {
+            auto* pages = storage.raw();
+            for (size_t first = 0; first < count; first += traits::page_size) {
+              const size_t num = (std::min)(static_cast<size_t>(count) - first , traits::page_size);
+              std::memcpy(pages[first / traits::page_size] , bytes + first * sizeof(C) , num * sizeof(C));
+            }
+            return true;
+          }
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+          C& component = storage.contains(entities[i]) ? storage.get(entities[i]) : storage.emplace(entities[i]);
+          std::memcpy(&component , bytes + i * sizeof(C) , sizeof(C));
+        }
+        return true;
+      }
+    } else if (format == BinaryPoolFormat::RECORDS) {
+      if constexpr (refl::is_reflectable<C>()) {
+        typename BinaryRecord<C>::Layout layout;
+        if (!BinaryRecord<C>::ReadLayout(reader , layout)) {
+          return false;
+        }
+
+        for (const entt::entity entity : entities) {
+          C& component = storage.contains(entity) ? storage.get(entity) : storage.emplace(entity);
+          if (!BinaryRecord<C>::ReadValues(reader , layout , component)) {
+            return false;
+          }
+        }
+        return true;
+      }
+    }
+
+    reader.Fail();
+    return false;
+  }
 
 } // namespace other
 
@@ -29,4 +29,9 @@ namespace other {
     tag.name = name;
   }
 
+  Entity::Entity(Scene* ctx , entt::entity handle , UUID uuid , const std::string& name) 
+      : registry(ctx->registry) , handle(handle) , uuid(uuid) , name(name) {
+    context = Ref<Scene>(ctx);
+  }
+
 } // namespace other
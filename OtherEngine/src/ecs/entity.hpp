@@ -175,6 +175,9 @@ namespace other {
       
       /// this is for the scene to call internally if wants
       Entity(Scene* ctx , UUID uuid , const std::string& name);
+
+      /// wraps an entity already in the scene's registry , for entities a snapshot restore brought back
+      Entity(Scene* ctx , entt::entity handle , UUID uuid , const std::string& name);
   };
 
 } // namespace other
@@ -20,6 +20,11 @@
 #include "physics/phyics_engine.hpp"
 #include <box2d/b2_fixture.h>
 #include <box2d/b2_polygon_shape.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
+#include <Jolt/Physics/Collision/Shape/RotatedTranslatedShape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
 
 namespace other {
 
@@ -87,7 +92,10 @@ namespace other {
     body.body_def.gravityScale = body.gravity_scale;
     body.body_def.fixedRotation = body.fixed_rotation;
     body.body_def.bullet = body.bullet;
-    body.body_def.userData.pointer = (uintptr_t)tag.id.Get();
+    body.body_def.userData.pointer = static_cast<uintptr_t>(tag.handle);
+    body.prev_position = body.curr_position = { transform.position.x , transform.position.y };
+    body.prev_angle = body.curr_angle = transform.erotation.z;
+    body.last_active_step = 0;
 
     switch (body.type) {
       case STATIC:
@@ -160,10 +168,108 @@ namespace other {
     Initialize2DCollider(physics_world , body , collider , transform);
   }
   
-  void InitializeRigidBody(Ref<PhysicsWorld>& world , RigidBody& body , const Tag& tag , const Transform& transform) {
+  JPH::Ref<JPH::Shape> CreateColliderShape(const Collider* collider , const Transform& transform) {
+    const ColliderShape type = collider == nullptr ? BOX_COLLIDER : collider->shape;
+    const glm::vec3 size = glm::abs(transform.scale * (collider == nullptr ? glm::vec3(1.f) : collider->size));
+
+    /// a convex shape can not be thinner than its convex radius
+    JPH::Ref<JPH::Shape> shape = nullptr;
+    switch (type) {
+      case BOX_COLLIDER: {
+        const glm::vec3 half_extent = glm::max(size * 0.5f , glm::vec3(JPH::cDefaultConvexRadius));
+        shape = new JPH::BoxShape(JPH::Vec3(half_extent.x , half_extent.y , half_extent.z));
+      } break;
+      case SPHERE_COLLIDER: {
+        const float radius = glm::max(glm::max(size.x , glm::max(size.y , size.z)) * 0.5f , JPH::cDefaultConvexRadius);
+        shape = new JPH::SphereShape(radius);
+      } break;
+      case CAPSULE_COLLIDER: {
+        /// a capsule no taller than it is wide has no cylinder left and is a sphere
+        const float radius = glm::max(glm::max(size.x , size.z) * 0.5f , JPH::cDefaultConvexRadius);
+        const float half_height = size.y * 0.5f - radius;
+        if (half_height > 0.f) {
+          shape = new JPH::CapsuleShape(half_height , radius);
+        } else {
+          shape = new JPH::SphereShape(radius);
+        }
+      } break;
+      default:
+        OE_ERROR("Collider shape {} is not a box , sphere or capsule" , static_cast<uint32_t>(type));
+        return nullptr;
+    }
+
+    if (collider == nullptr || collider->offset == glm::vec3(0.f)) {
+      return shape;
+    }
+
+    const glm::vec3 offset = collider->offset * transform.scale;
+    return new JPH::RotatedTranslatedShape(JPH::Vec3(offset.x , offset.y , offset.z) , JPH::Quat::sIdentity() , shape);
+  }
+
+  void InitializeRigidBody(Ref<PhysicsWorld>& world , RigidBody& body , const Tag& tag , const Transform& transform ,
+                           const Collider* collider) {
+    /// re-initializing replaces whatever body the component had
+    world->DestroyBody(body.body_id);
+    body.body_id = JPH::BodyID{};
+
+    JPH::EMotionType motion_type;
+    switch (body.type) {
+      case STATIC:
+        motion_type = JPH::EMotionType::Static;
+      break;
+      case KINEMATIC:
+        motion_type = JPH::EMotionType::Kinematic;
+      break;
+      case DYNAMIC:
+        motion_type = JPH::EMotionType::Dynamic;
+      break;
+      default:
+        OE_ERROR("Invalid Rigid Body type, can not add to physics scene!");
+        return;
+    }
+
+    JPH::Ref<JPH::Shape> shape = CreateColliderShape(collider , transform);
+    if (shape == nullptr) {
+      OE_ERROR("Failed to create rigid body for {}, its collider has no valid shape" , tag.name);
+      return;
+    }
+
+    glm::quat rotation = glm::quat(transform.erotation);
+    JPH::BodyCreationSettings settings(shape , JPH::RVec3(transform.position.x , transform.position.y , transform.position.z) , 
+                                       JPH::Quat(rotation.x , rotation.y , rotation.z , rotation.w) , motion_type , 
+                                       body.type == STATIC ? STATIC_OBJECT_LAYER : MOVING_OBJECT_LAYER);
+    settings.mAllowDynamicOrKinematic = body.enable_dynamic_type_change;
+    settings.mLinearDamping = body.linear_drag;
+    settings.mAngularDamping = body.angular_drag;
+    settings.mGravityFactor = body.disable_gravity ? 0.f : 1.f;
+    settings.mIsSensor = body.is_trigger;
+    settings.mMotionQuality = body.collision_type == CONTINUOUS_COLLISION ? 
+      JPH::EMotionQuality::LinearCast : JPH::EMotionQuality::Discrete;
+    settings.mLinearVelocity = JPH::Vec3(body.initial_linear_velocity.x , body.initial_linear_velocity.y , body.initial_linear_velocity.z);
+    settings.mAngularVelocity = JPH::Vec3(body.initial_angular_velocity.x , body.initial_angular_velocity.y , body.initial_angular_velocity.z);
+    settings.mMaxLinearVelocity = body.max_linear_velocity;
+    settings.mMaxAngularVelocity = body.max_angular_velocity;
+    settings.mOverrideMassProperties = JPH::EOverrideMassProperties::CalculateInertia;
+    settings.mMassPropertiesOverride.mMass = body.mass;
+
+    /// physics sync maps active bodies back to their entity through this
+    settings.mUserData = static_cast<uint64_t>(tag.handle);
+
+    body.body_id = world->CreateBody(settings , body.type != STATIC);
+    if (body.body_id.IsInvalid()) {
+      OE_ERROR("Failed to create rigid body for {}, the physics world is full" , tag.name);
+      return;
+    }
+
+    body.prev_position = body.curr_position = transform.position;
+    body.prev_rotation = body.curr_rotation = rotation;
+    body.last_active_step = 0;
   }
 
-  void InitializeCollider(Ref<PhysicsWorld>& world , RigidBody& body , Collider& collider , const Transform& transform) {
+  void InitializeCollider(Ref<PhysicsWorld>& world , RigidBody& body , Collider& collider , const Tag& tag ,
+                          const Transform& transform) {
+    /// jolt bodies can not swap shapes without losing their mass override , the body is rebuilt around the new shape
+    InitializeRigidBody(world , body , tag , transform , &collider);
   }
   
   CORE_SYSTEM(OnRigidBodyUpdate) {
@@ -178,8 +284,9 @@ namespace other {
 
     auto& tag = ent.GetComponent<Tag>();
     auto& transform = ent.GetComponent<Transform>();
+    const Collider* collider = ent.HasComponent<Collider>() ? &ent.GetComponent<Collider>() : nullptr;
 
-    InitializeRigidBody(physics_world , body , tag , transform);
+    InitializeRigidBody(physics_world , body , tag , transform , collider);
   }
 
   CORE_SYSTEM(OnColliderUpdate) {
@@ -196,9 +303,10 @@ namespace other {
 
     auto& body = ent.GetComponent<RigidBody>(); 
     auto& collider = ent.GetComponent<Collider>();
+    auto& tag = ent.GetComponent<Tag>();
     auto& transform = ent.GetComponent<Transform>();
 
-    InitializeCollider(physics_world , body , collider , transform);
+    InitializeCollider(physics_world , body , collider , tag , transform);
   }
 
 } // namespace other
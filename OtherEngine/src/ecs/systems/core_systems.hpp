@@ -46,8 +46,13 @@ namespace other {
   CORE_SYSTEM(OnRigidBody2DUpdate);
   CORE_SYSTEM(OnCollider2DUpdate);
   
-  void InitializeRigidBody(Ref<PhysicsWorld>& world , RigidBody& body , const Tag& tag , const Transform& transform);
-  void InitializeCollider(Ref<PhysicsWorld>& world , RigidBody& body , Collider& collider , const Transform& transform);
+  /// the jolt shape a collider describes , a body without a collider is a box the size of its transform
+  JPH::Ref<JPH::Shape> CreateColliderShape(const Collider* collider , const Transform& transform);
+
+  void InitializeRigidBody(Ref<PhysicsWorld>& world , RigidBody& body , const Tag& tag , const Transform& transform ,
+                           const Collider* collider = nullptr);
+  void InitializeCollider(Ref<PhysicsWorld>& world , RigidBody& body , Collider& collider , const Tag& tag ,
+                          const Transform& transform);
 
   CORE_SYSTEM(OnRigidBodyUpdate);
   CORE_SYSTEM(OnColliderUpdate);
@@ -6,6 +6,7 @@
 #include "asset/asset_extensions.hpp"
 #include "core/logger.hpp"
 #include "core/filesystem.hpp"
+#include "core/profile.hpp"
 #include "core/rand.hpp"
 #include "asset/asset_loader.hpp"
 
@@ -240,6 +241,8 @@ namespace other {
   }
 
   void EditorAssetHandler::LoadAsset(AssetHandle handle) {
+    OE_PROFILE_SCOPE("EditorAssetHandler::LoadAsset");
+
     auto& metadata = GetMutableMetadata(handle);
     if (metadata.IsValid()) {
       metadata.loaded = AssetLoader::Load(metadata , assets[handle]);
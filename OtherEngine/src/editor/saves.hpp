@@ -4,22 +4,16 @@
 #ifndef OTHER_ENGINE_SAVES_HPP
 #define OTHER_ENGINE_SAVES_HPP
 
-#include <entt/entt.hpp>
-#include <entt/entity/snapshot.hpp>
-
 #include "scene/scene.hpp"
-
-#include "ecs/components/transform.hpp"
+#include "scene/scene_snapshot.hpp"
 
 namespace other {
 
   struct StateCapture {
     UUID scene_id;
 
-    /// capture entities
-    /// transforms
-    std::map<UUID , Transform> transforms;
-
+    /// every entity , component , physics body and script field in the scene
+    SceneSnapshot snapshot;
   };
 
   class StateStack {
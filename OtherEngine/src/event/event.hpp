@@ -22,7 +22,7 @@ namespace other {
 
     // application events
     APP_TICK , APP_UPDATE , APP_RENDER , APP_LAYER ,
-    SCRIPT_RELOAD , PROJECT_DIR_UPDATE ,
+    SCRIPT_RELOAD , PROJECT_DIR_UPDATE , FILE_CHANGED ,
     
     // input events
     KEY_PRESSED , KEY_RELEASED , KEY_TYPED , KEY_HELD ,
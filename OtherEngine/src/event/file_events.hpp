@@ -0,0 +1,43 @@
+/**
+ * \file event/file_events.hpp
+ */
+#ifndef OTHER_ENGINE_FILE_EVENTS_HPP
+#define OTHER_ENGINE_FILE_EVENTS_HPP
+
+#include "core/file_watcher.hpp"
+#include "event/event.hpp"
+
+namespace other {
+
+  /// events are copied byte for byte into the queue , so the path stays with the watcher and the event only indexes it
+  class FileChangedEvent : public Event {
+    public:
+      FileChangedEvent(FileChangeType change , uint32_t index)
+        : Event() , change(change) , index(index) {}
+
+      FileChangeType ChangeType() const { return change; }
+
+      /// the full change , null once the watcher has moved on to the next frame's changes
+      const FileChange* Change() const {
+        FileWatcher* watcher = FileWatcher::Get();
+        if (watcher == nullptr || index >= watcher->Dispatched().size()) {
+          return nullptr;
+        }
+        return &watcher->Dispatched()[index];
+      }
+
+      virtual std::string ToString() const override {
+        return fmtstr("FileChangedEvent: {}" , FileChangeTypeName(change));
+      }
+
+      EVENT_CATEGORY(APPLICATION_EVENT | CORE_EVENT);
+      EVENT_TYPE(FILE_CHANGED);
+
+    private:
+      FileChangeType change;
+      uint32_t index;
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_FILE_EVENTS_HPP
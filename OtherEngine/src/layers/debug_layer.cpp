@@ -3,6 +3,9 @@
  **/
 #include "layers/debug_layer.hpp"
 
+#include <algorithm>
+#include <cinttypes>
+
 #include "rendering/ui/ui.hpp"
 #include "scripting/script_engine.hpp"
 
@@ -38,10 +41,178 @@ namespace other {
       ImGui::Text("  %s", module.second.name.c_str());
     }
 
+    RenderLuaMemoryStats();
+    RenderProfiler();
+
     ImGui::End();
   }
 
   void DebugLayer::OnDetach() {
   }
 
+  void DebugLayer::RenderLuaMemoryStats() {
+    Ref<LuaModule> lua_module = ScriptEngine::GetModuleAs<LuaModule>(LUA_MODULE);
+    if (lua_module == nullptr) {
+      return;
+    }
+
+    if (!ImGui::CollapsingHeader("Lua Memory")) {
+      return;
+    }
+
+    const auto& allocator = lua_module->GetAllocator();
+    const auto& total = allocator.TotalStats();
+    ImGui::Text("Live: %.2f KB (peak %.2f KB)", total.live_bytes / 1024.f, total.peak_bytes / 1024.f);
+    ImGui::Text("Pooled: %.2f KB", allocator.PooledBytes() / 1024.f);
+    ImGui::Text("Allocations: %" PRIu64 " | Frees: %" PRIu64, total.num_allocations, total.num_frees);
+
+    allocator.ForEachModule([](UUID id, const LuaMemoryStats& stats) {
+      auto script = ScriptEngine::GetScriptModule(id);
+      const char* name = script != nullptr ? script->ModuleName().c_str() : "<core>";
+      ImGui::Text("  %s : %.2f KB", name, stats.live_bytes / 1024.f);
+    });
+
+    ImGui::Separator();
+
+    const auto& gc = lua_module->GetGcStats();
+    if (lua_module->GetGcBudget() == 0) {
+      ImGui::Text("GC: automatic");
+    } else {
+      ImGui::Text("GC budget: %u us", lua_module->GetGcBudget());
+    }
+    ImGui::Text("GC heap: %zu KB", gc.heap_kb);
+    ImGui::Text("GC pause: last %.1f us | p99 %.1f us | max %.1f us", gc.last_pause_us, lua_module->GcPausePercentile(0.99f), gc.max_pause_us);
+    ImGui::Text("GC steps: %" PRIu64 " | cycles: %" PRIu64 " | full: %" PRIu64, gc.steps, gc.cycles, gc.full_collections);
+  }
+
+  void DebugLayer::RenderProfiler() {
+    if (!ImGui::CollapsingHeader("Profiler")) {
+      return;
+    }
+
+    bool enabled = FrameProfiler::Enabled();
+    if (ImGui::Checkbox("Enabled", &enabled)) {
+      FrameProfiler::SetEnabled(enabled);
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Freeze", &profiler_frozen);
+    ImGui::SameLine();
+    if (ImGui::Button("Capture Trace")) {
+      FrameProfiler::StartCapture();
+    }
+    ImGui::SameLine();
+    ImGui::BeginDisabled(FrameProfiler::Capturing());
+    if (ImGui::Button("Save Trace")) {
+      FrameProfiler::WriteChromeTrace("frame_trace.json");
+    }
+    ImGui::EndDisabled();
+
+    const auto& last_frame = FrameProfiler::LastFrame();
+    if (!profiler_frozen) {
+      flame_frame = last_frame;
+    }
+
+    ImGui::Text("Frame %" PRIu64 " : %.3f ms | dropped events: %" PRIu64, flame_frame.index, flame_frame.duration_ns / 1e6,
+                FrameProfiler::Dropped());
+    RenderFlameView();
+
+    auto stats = FrameProfiler::Stats();
+    std::sort(stats.begin(), stats.end(), [](const ProfileScopeStats& a, const ProfileScopeStats& b) {
+      return a.avg_ms > b.avg_ms;
+    });
+
+    constexpr ImGuiTableFlags kTableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (!ImGui::BeginTable("##profiler-stats", 8, kTableFlags, ImVec2(0, 250))) {
+      return;
+    }
+
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Scope");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Last");
+    ImGui::TableSetupColumn("Min");
+    ImGui::TableSetupColumn("Avg");
+    ImGui::TableSetupColumn("p95");
+    ImGui::TableSetupColumn("p99");
+    ImGui::TableSetupColumn("Max");
+    ImGui::TableHeadersRow();
+
+    for (const auto& scope : stats) {
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(scope.name.data(), scope.name.data() + scope.name.size());
+      ImGui::TableNextColumn();
+      ImGui::Text("%u", scope.calls);
+      for (double ms : { scope.last_ms, scope.min_ms, scope.avg_ms, scope.p95_ms, scope.p99_ms, scope.max_ms }) {
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", ms);
+      }
+    }
+
+    ImGui::EndTable();
+  }
+
+  void DebugLayer::RenderFlameView() {
+    constexpr float kRowHeight = 18.f;
+    constexpr float kLaneGap = 6.f;
+
+    uint32_t num_threads = 0;
+    uint32_t max_depth = 0;
+    for (const auto& sample : flame_frame.samples) {
+      num_threads = std::max(num_threads, sample.thread + 1);
+      max_depth = std::max(max_depth, sample.depth + 1);
+    }
+
+    if (num_threads == 0 || flame_frame.duration_ns <= 0) {
+      ImGui::TextDisabled("No samples this frame");
+      return;
+    }
+
+    /// every thread gets a lane as deep as the deepest stack so lanes line up
+    const float lane_height = max_depth * kRowHeight + kLaneGap;
+    const float width = std::max(ImGui::GetContentRegionAvail().x, 100.f);
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImGui::InvisibleButton("##flame-view", ImVec2(width, num_threads * lane_height));
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    const double ns_to_px = width / static_cast<double>(flame_frame.duration_ns);
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+
+    for (const auto& sample : flame_frame.samples) {
+      /// work that started last frame is clamped to the left edge
+      const double start = std::max<double>(static_cast<double>(sample.start_ns), 0.0);
+      const double end = std::min<double>(static_cast<double>(sample.start_ns + sample.duration_ns),
+                                          static_cast<double>(flame_frame.duration_ns));
+      if (end <= start) {
+        continue;
+      }
+
+      const ImVec2 min{
+        origin.x + static_cast<float>(start * ns_to_px),
+        origin.y + sample.thread * lane_height + sample.depth * kRowHeight,
+      };
+      const ImVec2 max{
+        std::max(origin.x + static_cast<float>(end * ns_to_px), min.x + 1.f),
+        min.y + kRowHeight - 1.f,
+      };
+
+      /// color per scope so the same zone reads the same across frames
+      const uint32_t hash = sample.scope * 2654435761u;
+      const ImU32 color = IM_COL32(80 + (hash & 0x7F), 80 + ((hash >> 8) & 0x7F), 80 + ((hash >> 16) & 0x7F), 255);
+      draw_list->AddRectFilled(min, max, color);
+
+      const std::string_view name = FrameProfiler::ScopeName(sample.scope);
+      if (max.x - min.x > 30.f) {
+        draw_list->PushClipRect(min, max, true);
+        draw_list->AddText(ImVec2(min.x + 2.f, min.y + 2.f), IM_COL32_WHITE, name.data(), name.data() + name.size());
+        draw_list->PopClipRect();
+      }
+
+      if (ImGui::IsItemHovered() && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) {
+        ImGui::SetTooltip("%.*s\n%.3f ms on %s", static_cast<int>(name.size()), name.data(),
+                          sample.duration_ns / 1e6, FrameProfiler::ThreadName(sample.thread).c_str());
+      }
+    }
+  }
+
 } // namespace other
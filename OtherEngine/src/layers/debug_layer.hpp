@@ -4,6 +4,7 @@
 #ifndef OTHER_ENGINE_DEBUG_LAYER_HPP
 #define OTHER_ENGINE_DEBUG_LAYER_HPP
 
+#include "core/frame_profiler.hpp"
 #include "core/layer.hpp"
 
 namespace other {
@@ -26,6 +27,14 @@ namespace other {
       constexpr static size_t kFpsSamples = 100;
       float fps_data[kFpsSamples] = {0.0f};
       size_t fps_data_index = 0;
+
+      /// frozen keeps the flame view on one frame while the stats keep updating
+      bool profiler_frozen = false;
+      ProfileFrame flame_frame;
+
+      void RenderLuaMemoryStats();
+      void RenderProfiler();
+      void RenderFlameView();
   };
 
 } // namespace other
@@ -4,8 +4,8 @@
 #ifndef OTHER_ENGINE_AST_NODE_HPP
 #define OTHER_ENGINE_AST_NODE_HPP
 
-#include "core/ref.hpp"
-#include "core/ref_counted.hpp"
+#include <ostream>
+#include <vector>
 
 #include "parsing/parsing_defines.hpp"
 #include "parsing/tree_walker.hpp"
@@ -13,7 +13,11 @@
 
 namespace other {
 
-  class AstNode : public RefCounted {
+  /**
+   * nodes are allocated from the ShaderArena of the compile that parsed them and are only ever destroyed with it,
+   *   child pointers are non-owning
+   **/
+  class AstNode {
     public:
       AstNodeType type;
 
@@ -59,7 +63,7 @@ namespace other {
 
   class UnaryExpr : public AstExpr {
     public:
-      UnaryExpr(Token op, const Ref<AstExpr>& right) 
+      UnaryExpr(Token op, AstExpr* right) 
         : AstExpr(UNARY_EXPR) , op(op), right(right) {}
       virtual ~UnaryExpr() override {}
 
@@ -68,12 +72,12 @@ namespace other {
       // std::vector<Instruction> Emit() override;
 
       Token op;
-      Ref<AstExpr> right;
+      AstExpr* right;
     };
 
   class BinaryExpr : public AstExpr {
     public:
-      BinaryExpr(const Ref<AstExpr>& left, Token op, const Ref<AstExpr>& right) 
+      BinaryExpr(AstExpr* left, Token op, AstExpr* right) 
         : AstExpr(AstNodeType::BINARY_EXPR) , left(left), op(op), right(right) {}
       virtual ~BinaryExpr() override {}
 
@@ -81,14 +85,14 @@ namespace other {
       void Accept(TreeWalker& walker) override;
       // std::vector<Instruction> Emit() override;
 
-      Ref<AstExpr> left;
+      AstExpr* left;
       Token op;
-      Ref<AstExpr> right;
+      AstExpr* right;
   };
 
   class CallExpr : public AstExpr {
     public:
-      CallExpr(const Ref<AstExpr>& callee, std::vector<Ref<AstExpr>>& as) 
+      CallExpr(AstExpr* callee, std::vector<AstExpr*>& as) 
           : AstExpr(AstNodeType::CALL_EXPR) , callee(callee) {
         args.swap(as);
       }
@@ -98,13 +102,13 @@ namespace other {
       void Accept(TreeWalker& walker) override;
       // std::vector<Instruction> Emit() override;
 
-      Ref<AstExpr> callee;
-      std::vector<Ref<AstExpr>> args;
+      AstExpr* callee;
+      std::vector<AstExpr*> args;
   };
 
   class GroupingExpr : public AstExpr {
     public:
-      GroupingExpr(const Ref<AstExpr>& expr) 
+      GroupingExpr(AstExpr* expr) 
         : AstExpr(AstNodeType::GROUPING_EXPR) , expr(expr) {}
       virtual ~GroupingExpr() override {}
 
@@ -112,7 +116,7 @@ namespace other {
       void Accept(TreeWalker& walker) override;
       // std::vector<Instruction> Emit() override;
 
-      Ref<AstExpr> expr;
+      AstExpr* expr;
   };
 
   class VarExpr : public AstExpr {
@@ -130,7 +134,7 @@ namespace other {
 
   class AssignExpr : public AstExpr {
     public:
-      AssignExpr(Token name, const Ref<AstExpr>& value) 
+      AssignExpr(Token name, AstExpr* value) 
         : AstExpr(AstNodeType::ASSIGN_EXPR) , name(name), value(value) {}
       virtual ~AssignExpr() override {}
 
@@ -139,12 +143,12 @@ namespace other {
       // std::vector<Instruction> Emit() override;
 
       Token name;
-      Ref<AstExpr> value;
+      AstExpr* value;
   };
 
   class ArrayExpr : public AstExpr {
     public:
-      ArrayExpr(std::vector<Ref<AstExpr>>& elts) 
+      ArrayExpr(std::vector<AstExpr*>& elts) 
           : AstExpr(AstNodeType::ARRAY_EXPR) {
         elements.swap(elts);
       }
@@ -154,12 +158,12 @@ namespace other {
       void Accept(TreeWalker& walker) override;
       // std::vector<Instruction> Emit() override;
 
-      std::vector<Ref<AstExpr>> elements;
+      std::vector<AstExpr*> elements;
   };
 
   class ArrayAccessExpr : public AstExpr {
     public:
-      ArrayAccessExpr(const Ref<AstExpr>& array, const Ref<AstExpr>& index) 
+      ArrayAccessExpr(AstExpr* array, AstExpr* index) 
         : AstExpr(AstNodeType::ARRAY_ACCESS_EXPR) , array(array), index(index) {}
       virtual ~ArrayAccessExpr() override {}
 
@@ -167,13 +171,13 @@ namespace other {
       void Accept(TreeWalker& walker) override;
       // std::vector<Instruction> Emit() override;
 
-      Ref<AstExpr> array;
-      Ref<AstExpr> index;
+      AstExpr* array;
+      AstExpr* index;
   };
 
   class ObjAccessExpr : public AstExpr {
     public:
-      ObjAccessExpr(const Ref<AstExpr>& obj, Token member , const Ref<AstExpr>& index = nullptr  , const Ref<AstExpr>& assignment = nullptr) 
+      ObjAccessExpr(AstExpr* obj, Token member , AstExpr* index = nullptr  , AstExpr* assignment = nullptr) 
         : AstExpr(AstNodeType::OBJ_ACCESS_EXPR) , obj(obj), member(member) , index(index) , assignment(assignment) {}
       virtual ~ObjAccessExpr() override {}
 
@@ -181,15 +185,15 @@ namespace other {
       void Accept(TreeWalker& walker) override;
       // std::vector<Instruction> Emit() override;
 
-      Ref<AstExpr> obj;
+      AstExpr* obj;
       Token member;
-      Ref<AstExpr> index;
-      Ref<AstExpr> assignment;
+      AstExpr* index;
+      AstExpr* assignment;
   };
 
   class ExprStmt : public AstStmt {
     public:
-      ExprStmt(const Ref<AstExpr>& expr) 
+      ExprStmt(AstExpr* expr) 
         : AstStmt(AstNodeType::EXPR_STMT) , expr(expr) {}
       virtual ~ExprStmt() override {}
 
@@ -197,12 +201,12 @@ namespace other {
       virtual void Accept(TreeWalker& walker) override;
       // virtual std::vector<Instruction> Emit() override;
 
-      Ref<AstExpr> expr = nullptr;
+      AstExpr* expr = nullptr;
   };
 
   class VarDecl : public AstStmt {
     public:
-      VarDecl(const Token& type , const Token& name , const Ref<AstExpr>& initializer = nullptr , bool is_const = false , bool is_global = false) 
+      VarDecl(const Token& type , const Token& name , AstExpr* initializer = nullptr , bool is_const = false , bool is_global = false) 
         : AstStmt(AstNodeType::VAR_DECL_STMT) , name(name) ,  type(type) , initializer(initializer) , is_const(is_const) , is_global(is_global) {}
       virtual ~VarDecl() override {}
 
@@ -212,14 +216,14 @@ namespace other {
 
       Token name;
       Token type;
-      Ref<AstExpr> initializer = nullptr;
+      AstExpr* initializer = nullptr;
       bool is_const = false;
       bool is_global = false;
   };
 
   class ArrayDecl : public AstStmt {
     public:
-      ArrayDecl(const Token& type , const Token& name , Token size , const Ref<AstExpr>& initializer , bool is_const = false) 
+      ArrayDecl(const Token& type , const Token& name , Token size , AstExpr* initializer , bool is_const = false) 
         : AstStmt(AstNodeType::ARRAY_DECL_STMT) , name(name) , type(type)  , 
           size(size) , initializer(initializer) , is_const(is_const) {}
       virtual ~ArrayDecl() override {}
@@ -231,13 +235,13 @@ namespace other {
       Token name;
       Token type;
       Token size;
-      Ref<AstExpr> initializer = nullptr;
+      AstExpr* initializer = nullptr;
       bool is_const;
   };
 
   class BlockStmt : public AstStmt {
     public:
-      BlockStmt(std::vector<Ref<AstStmt>>& stmts) 
+      BlockStmt(std::vector<AstStmt*>& stmts) 
           : AstStmt(AstNodeType::BLOCK_STMT) {
         statements.swap(stmts);
       }
@@ -248,12 +252,12 @@ namespace other {
       virtual void Accept(TreeWalker& walker) override;
       // virtual std::vector<Instruction> Emit() override;
 
-      std::vector<Ref<AstStmt>> statements;
+      std::vector<AstStmt*> statements;
   };
 
   class IfStmt : public AstStmt {
     public:
-      IfStmt(const Ref<AstExpr>& condition , const Ref<AstStmt>& then_branch , const Ref<AstStmt>& else_branch = nullptr) 
+      IfStmt(AstExpr* condition , AstStmt* then_branch , AstStmt* else_branch = nullptr) 
         : AstStmt(AstNodeType::IF_STMT) , condition(condition) , then_branch(then_branch) , else_branch(else_branch) {}
       virtual ~IfStmt() override {
       }
@@ -262,14 +266,14 @@ namespace other {
       virtual void Accept(TreeWalker& walker) override;
       // virtual std::vector<Instruction> Emit() override;
 
-      Ref<AstExpr> condition;
-      Ref<AstStmt> then_branch;
-      Ref<AstStmt> else_branch;
+      AstExpr* condition;
+      AstStmt* then_branch;
+      AstStmt* else_branch;
   };
 
   class WhileStmt : public AstStmt {
     public:
-      WhileStmt(const Ref<AstExpr>& condition , const Ref<AstStmt>& body) 
+      WhileStmt(AstExpr* condition , AstStmt* body) 
         : AstStmt(AstNodeType::WHILE_STMT) , condition(condition) , body(body) {}
       virtual ~WhileStmt() override {
       }
@@ -278,13 +282,13 @@ namespace other {
       virtual void Accept(TreeWalker& walker) override;
       // virtual std::vector<Instruction> Emit() override;
 
-      Ref<AstExpr> condition;
-      Ref<AstStmt> body;
+      AstExpr* condition;
+      AstStmt* body;
   };
 
   class ReturnStmt : public AstStmt {
     public:
-      ReturnStmt(const Ref<AstStmt>& expr = nullptr) 
+      ReturnStmt(AstStmt* expr = nullptr) 
         : AstStmt(AstNodeType::RETURN_STMT) , stmt(expr) {}
       virtual ~ReturnStmt() override {}
 
@@ -292,7 +296,7 @@ namespace other {
       virtual void Accept(TreeWalker& walker) override;
       // virtual std::vector<Instruction> Emit() override;
 
-      Ref<AstStmt> stmt = nullptr;
+      AstStmt* stmt = nullptr;
   };
 
   struct FunctionParam {
@@ -303,7 +307,7 @@ namespace other {
   class FunctionStmt : public AstStmt {
     public:
       FunctionStmt(const Token& name , const std::vector<FunctionParam>& params , const Token& type ,
-                   const Ref<AstStmt>& body = nullptr) 
+                   AstStmt* body = nullptr) 
         : AstStmt(AstNodeType::FUNCTION_STMT) , name(name) , params(params) , body(body) , type(type) {}
       virtual ~FunctionStmt() override {}
 
@@ -313,13 +317,13 @@ namespace other {
 
       Token name;
       std::vector<FunctionParam> params;
-      Ref<AstStmt> body;
+      AstStmt* body;
       Token type;
   };
 
   class StructStmt : public AstStmt {
     public:
-      StructStmt(const Token& name , std::vector<Ref<AstStmt>>& fs) 
+      StructStmt(const Token& name , std::vector<AstStmt*>& fs) 
           : AstStmt(AstNodeType::STRUCT_STMT) , name(name) {
         fields.swap(fs);
       }
@@ -331,7 +335,7 @@ namespace other {
       // virtual std::vector<Instruction> Emit() override;
 
       Token name;
-      std::vector<Ref<AstStmt>> fields;
+      std::vector<AstStmt*> fields;
   };
 
 } // namespace other
@@ -346,14 +346,20 @@ namespace other {
     uint32_t column = 1;
   };
 
+  /**
+   * value views either the preprocessed source or text owned by the ShaderArena of the compile that produced it,
+   *   tokens must not outlive either of them
+   **/
   struct Token {
     SourceLocation location;
-    std::string value;
+    std::string_view value;
     uint64_t hash;
     TokenType type;
 
-    Token(SourceLocation loc , TokenType type , const std::string& value)
+    Token(SourceLocation loc , TokenType type , std::string_view value)
       : location(loc) , value(value) , hash(FNV(value)) , type(type) {}
+    Token(SourceLocation loc , TokenType type , std::string_view value , uint64_t hash)
+      : location(loc) , value(value) , hash(hash) , type(type) {}
   };  
 
   static inline bool IsNumeric(char c) {
@@ -372,10 +378,16 @@ namespace other {
     return c == ' ' || c == '\t' || c == '\r' || c == '\n';
   }
 
-  static inline bool IsKeyword(const std::string& str) {
-    return std::find_if(kKeywordMap.begin() , kKeywordMap.end() , [&str](const KeyWordPair& kw) -> bool { 
-      return FNV(str) == kw.first;
-    }) != kKeywordMap.end();
+  /// INVALID_TOKEN if hash does not belong to a keyword
+  static inline TokenType KeywordFromHash(uint64_t hash) {
+    auto itr = std::find_if(kKeywordMap.begin() , kKeywordMap.end() , [hash](const KeyWordPair& kw) -> bool { 
+      return hash == kw.first;
+    });
+    return itr != kKeywordMap.end() ? itr->second : INVALID_TOKEN;
+  }
+
+  static inline bool IsKeyword(std::string_view str) {
+    return KeywordFromHash(FNV(str)) != INVALID_TOKEN;
   }
 
   static inline bool IsOperator(char c) {
@@ -0,0 +1,63 @@
+/**
+ * \file parsing/shader_arena.cpp
+ **/
+#include "parsing/shader_arena.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace other {
+
+  ShaderArena::~ShaderArena() {
+    for (DtorRecord* record = dtors; record != nullptr; record = record->next) {
+      record->destroy(record->object);
+    }
+    dtors = nullptr;
+
+    for (auto* block : blocks) {
+      std::free(block);
+    }
+    blocks.clear();
+  }
+
+  std::string_view ShaderArena::Intern(std::string_view str) {
+    if (str.empty()) {
+      return {};
+    }
+
+    char* mem = static_cast<char*>(Allocate(str.size() , alignof(char)));
+    std::memcpy(mem , str.data() , str.size());
+    return std::string_view(mem , str.size());
+  }
+
+  void* ShaderArena::Allocate(size_t size , size_t align) {
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(cursor) + align - 1) & ~(align - 1);
+    if (cursor == nullptr || aligned + size > reinterpret_cast<uintptr_t>(end)) {
+      NewBlock(size + align);
+      aligned = (reinterpret_cast<uintptr_t>(cursor) + align - 1) & ~(align - 1);
+    }
+
+    uint8_t* mem = reinterpret_cast<uint8_t*>(aligned);
+    bytes_used += (mem + size) - cursor;
+    cursor = mem + size;
+
+    return mem;
+  }
+
+  void ShaderArena::NewBlock(size_t min_size) {
+    const size_t size = std::max(block_size , min_size);
+
+    uint8_t* block = static_cast<uint8_t*>(std::malloc(size));
+    if (block == nullptr) {
+      throw std::bad_alloc();
+    }
+
+    blocks.push_back(block);
+    bytes_reserved += size;
+
+    cursor = block;
+    end = block + size;
+  }
+
+} // namespace other
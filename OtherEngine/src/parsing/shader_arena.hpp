@@ -0,0 +1,97 @@
+/**
+ * \file parsing/shader_arena.hpp
+ **/
+#ifndef OTHER_ENGINE_SHADER_ARENA_HPP
+#define OTHER_ENGINE_SHADER_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace other {
+
+  /**
+   * bump allocator owning everything produced while compiling a single shader
+   *
+   * ast nodes and any token text the lexer has to synthesize (folded scientific literals, merged qualifiers, ...)
+   *   are carved out of large blocks, nothing is freed individually, the whole arena is released when it is destroyed
+   *
+   * objects that are not trivially destructible get a small record threaded through the arena so their
+   *   destructors still run (in reverse order of construction) when the arena goes away
+   **/
+  class ShaderArena {
+    public:
+      constexpr static size_t kDefaultBlockSize = 16 * 1024;
+
+      ShaderArena(size_t block_size = kDefaultBlockSize)
+        : block_size(block_size) {}
+      ~ShaderArena();
+
+      ShaderArena(const ShaderArena&) = delete;
+      ShaderArena& operator=(const ShaderArena&) = delete;
+
+      template <typename T , typename... Args>
+      T* New(Args&&... args) {
+        ++num_objects;
+        if constexpr (std::is_trivially_destructible_v<T>) {
+          void* mem = Allocate(sizeof(T) , alignof(T));
+          return new (mem) T(std::forward<Args>(args)...);
+        } else {
+          /// record sits directly in front of the object so one bump covers both
+          constexpr size_t kObjOffset = (sizeof(DtorRecord) + alignof(T) - 1) & ~(alignof(T) - 1);
+          constexpr size_t kAlign = alignof(T) > alignof(DtorRecord) ?
+            alignof(T) : alignof(DtorRecord);
+
+          uint8_t* mem = static_cast<uint8_t*>(Allocate(kObjOffset + sizeof(T) , kAlign));
+          T* obj = new (mem + kObjOffset) T(std::forward<Args>(args)...);
+
+          DtorRecord* record = new (mem) DtorRecord{
+            .object = obj ,
+            .destroy = [](void* o) { static_cast<T*>(o)->~T(); } ,
+            .next = dtors ,
+          };
+          dtors = record;
+
+          return obj;
+        }
+      }
+
+      /// copies str into the arena, the returned view lives as long as the arena
+      std::string_view Intern(std::string_view str);
+
+      void* Allocate(size_t size , size_t align);
+
+      size_t NumObjects() const { return num_objects; }
+      size_t NumBlocks() const { return blocks.size(); }
+      size_t BytesUsed() const { return bytes_used; }
+      size_t BytesReserved() const { return bytes_reserved; }
+
+    private:
+      struct DtorRecord {
+        void* object;
+        void (*destroy)(void*);
+        DtorRecord* next;
+      };
+
+      size_t block_size;
+
+      std::vector<uint8_t*> blocks;
+      uint8_t* cursor = nullptr;
+      uint8_t* end = nullptr;
+
+      DtorRecord* dtors = nullptr;
+
+      size_t num_objects = 0;
+      size_t bytes_used = 0;
+      size_t bytes_reserved = 0;
+
+      void NewBlock(size_t min_size);
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_SHADER_ARENA_HPP
@@ -36,7 +36,7 @@ namespace other {
   void LayoutDecl::Stream(std::ostream& stream , TreeWalker& walker) const {
     ShaderGlslTranspiler* tp = static_cast<ShaderGlslTranspiler*>(&walker);
     if (tp->mesh_layout.has_value() && tp->mesh_layout->override && descriptors.size() == 1) {
-      Ref<LayoutDescriptor> desc = descriptors[0].As<LayoutDescriptor>();
+      const LayoutDescriptor* desc = static_cast<const LayoutDescriptor*>(descriptors[0]);
       
       if (desc->type.type == LOCATION_KW) {
         OE_DEBUG("LayoutDecl::Stream {} = {} ({})" , descriptors.size() , kTokenStrings[desc->type.type] , desc->type.type); 
@@ -42,19 +42,19 @@ namespace other {
 
   class LayoutDescriptor : public AstExpr {
     public:
-      LayoutDescriptor(Token type , const Ref<AstExpr>& expr)
+      LayoutDescriptor(Token type , AstExpr* expr)
         : AstExpr(LAYOUT_DESCRIPTOR) , type(type) , expr(expr) {}
 
       virtual void Stream(std::ostream& stream , TreeWalker& walker) const override;
       virtual void Accept(TreeWalker& walker) override;
 
       Token type;
-      Ref<AstExpr> expr;
+      AstExpr* expr;
   };
 
   class LayoutDecl : public AstStmt {
     public:
-      LayoutDecl(Token layout_rules , std::vector<Ref<AstExpr>>& dtors , const Ref<AstStmt>& data) 
+      LayoutDecl(Token layout_rules , std::vector<AstExpr*>& dtors , AstStmt* data) 
           : AstStmt(LAYOUT_DECL_STMT) , layout_rules(layout_rules) , data(data) {
         descriptors.swap(dtors);
       }
@@ -63,8 +63,8 @@ namespace other {
       virtual void Accept(TreeWalker& walker) override;
 
       Token layout_rules;
-      std::vector<Ref<AstExpr>> descriptors;
-      Ref<AstStmt> data;
+      std::vector<AstExpr*> descriptors;
+      AstStmt* data;
   };
 
   class LayoutVarDecl : public AstStmt {
@@ -82,7 +82,7 @@ namespace other {
 
   class ShaderStorageStmt : public AstStmt {
     public:
-      ShaderStorageStmt(const Token& type , const Token& id , const Ref<AstStmt>& body)
+      ShaderStorageStmt(const Token& type , const Token& id , AstStmt* body)
         : AstStmt(SHADER_STORAGE_STMT) , type(type) , name(id) , body(body) {}
 
       virtual void Stream(std::ostream& stream , TreeWalker& walker) const override;
@@ -90,12 +90,12 @@ namespace other {
 
       Token type;
       Token name;
-      Ref<AstStmt> body;
+      AstStmt* body;
   };
 
   class InOutBlockStmt : public AstStmt {
     public:
-      InOutBlockStmt(Token in_out , Token tag , Token identifier , const Ref<AstStmt>& body , bool is_array = false)
+      InOutBlockStmt(Token in_out , Token tag , Token identifier , AstStmt* body , bool is_array = false)
         : AstStmt(IN_OUT_BLOCK_STMT) , in_out(in_out) , tag(tag) , name(identifier) , body(body) , is_array(is_array) {}
       virtual ~InOutBlockStmt() override {}
       
@@ -105,26 +105,26 @@ namespace other {
       Token in_out;
       Token tag;
       Token name;
-      Ref<AstStmt> body;
+      AstStmt* body;
 
       bool is_array;
   };
 
   class UniformDecl : public AstStmt {
     public:
-      UniformDecl(const Ref<AstStmt>& var_decl)
+      UniformDecl(AstStmt* var_decl)
           : AstStmt(UNIFORM_DECL_STMT) , var_decl(var_decl) {}
       virtual ~UniformDecl() override {}
       
       virtual void Stream(std::ostream& stream , TreeWalker& walker) const override;
       virtual void Accept(TreeWalker& walker) override;
 
-      Ref<AstStmt> var_decl;
+      AstStmt* var_decl;
   };
   
   class ShaderDecl : public AstStmt {
     public:
-      ShaderDecl(ShaderType type , std::vector<Ref<AstExpr>>& attrs , std::vector<Ref<AstStmt>>& stmts) 
+      ShaderDecl(ShaderType type , std::vector<AstExpr*>& attrs , std::vector<AstStmt*>& stmts) 
           : AstStmt(SHADER_DECL_STMT) , type(type) {
         attributes.swap(attrs);
         statements.swap(stmts);
@@ -135,8 +135,8 @@ namespace other {
       virtual void Accept(TreeWalker& walker) override;
       
       ShaderType type;
-      std::vector<Ref<AstExpr>> attributes;
-      std::vector<Ref<AstStmt>> statements;
+      std::vector<AstExpr*> attributes;
+      std::vector<AstStmt*> statements;
   };
 
 } // namespace other
@@ -0,0 +1,360 @@
+/**
+ * \file parsing/shader_cache.cpp
+ **/
+#include "parsing/shader_cache.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "core/logger.hpp"
+#include "core/filesystem.hpp"
+
+namespace other {
+namespace {
+
+  constexpr uint32_t kCacheMagic = 0x4353454F; // 'OESC'
+  constexpr std::string_view kCacheExtension = ".oshc";
+
+  class CacheWriter {
+    public:
+      template <typename T>
+        requires std::is_trivially_copyable_v<T>
+      void Write(const T& value) {
+        bytes.append(reinterpret_cast<const char*>(&value) , sizeof(T));
+      }
+
+      void Write(const std::string& str) {
+        Write<uint32_t>(static_cast<uint32_t>(str.size()));
+        bytes.append(str);
+      }
+
+      const std::string& Bytes() const { return bytes; }
+
+    private:
+      std::string bytes;
+  };
+
+  class CacheReader {
+    public:
+      CacheReader(const std::string& bytes)
+        : bytes(bytes) {}
+
+      template <typename T>
+        requires std::is_trivially_copyable_v<T>
+      bool Read(T& value) {
+        if (cursor + sizeof(T) > bytes.size()) {
+          return false;
+        }
+        std::memcpy(&value , bytes.data() + cursor , sizeof(T));
+        cursor += sizeof(T);
+        return true;
+      }
+
+      bool Read(std::string& str) {
+        uint32_t size = 0;
+        if (!Read(size) || cursor + size > bytes.size()) {
+          return false;
+        }
+        str.assign(bytes.data() + cursor , size);
+        cursor += size;
+        return true;
+      }
+
+      bool AtEnd() const { return cursor == bytes.size(); }
+
+    private:
+      const std::string& bytes;
+      size_t cursor = 0;
+  };
+
+  void WriteUniform(CacheWriter& writer , const Uniform& uniform) {
+    writer.Write(uniform.name);
+    writer.Write<uint32_t>(uniform.type);
+    writer.Write<uint32_t>(uniform.arr_length);
+    writer.Write<uint8_t>(uniform.size.has_value());
+    writer.Write<uint64_t>(uniform.size.value_or(0));
+  }
+
+  bool ReadUniform(CacheReader& reader , Uniform& uniform) {
+    uint32_t type = 0;
+    uint8_t has_size = 0;
+    uint64_t size = 0;
+    if (!reader.Read(uniform.name) || !reader.Read(type) || !reader.Read(uniform.arr_length) ||
+        !reader.Read(has_size) || !reader.Read(size)) {
+      return false;
+    }
+
+    uniform.type = static_cast<ValueType>(type);
+    uniform.size = has_size ? Opt<size_t>(size) : std::nullopt;
+    return true;
+  }
+
+  void WriteUniforms(CacheWriter& writer , const std::map<UUID , Uniform>& uniforms) {
+    writer.Write<uint32_t>(static_cast<uint32_t>(uniforms.size()));
+    for (const auto& [id , uniform] : uniforms) {
+      writer.Write<uint64_t>(id.Get());
+      WriteUniform(writer , uniform);
+    }
+  }
+
+  bool ReadUniforms(CacheReader& reader , std::map<UUID , Uniform>& uniforms) {
+    uint32_t count = 0;
+    if (!reader.Read(count)) {
+      return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+      uint64_t id = 0;
+      Uniform uniform;
+      if (!reader.Read(id) || !ReadUniform(reader , uniform)) {
+        return false;
+      }
+      uniforms[id] = uniform;
+    }
+    return true;
+  }
+
+  std::string SerializeIr(UUID key , const ShaderIr& ir) {
+    CacheWriter writer;
+    writer.Write(kCacheMagic);
+    writer.Write(kShaderCompilerVersion);
+    writer.Write<uint64_t>(key.Get());
+
+    writer.Write<uint8_t>(ir.layout.override);
+    writer.Write(ir.layout.curr_idx);
+    writer.Write(ir.layout.layout_name);
+    writer.Write(ir.layout.stride);
+    writer.Write<uint32_t>(static_cast<uint32_t>(ir.layout.attrs.size()));
+    for (const auto& attr : ir.layout.attrs) {
+      writer.Write(attr.attr_name);
+      writer.Write(attr.idx);
+      writer.Write(attr.size);
+    }
+
+    writer.Write<uint32_t>(static_cast<uint32_t>(ir.storages.size()));
+    for (const auto& [id , storage] : ir.storages) {
+      writer.Write<uint64_t>(id.Get());
+      writer.Write<uint32_t>(storage.type);
+      writer.Write(storage.binding_point);
+      writer.Write(storage.name);
+      WriteUniforms(writer , storage.uniforms);
+    }
+
+    WriteUniforms(writer , ir.uniforms);
+
+    writer.Write(ir.name);
+    writer.Write(ir.vert_source);
+    writer.Write(ir.frag_source);
+    writer.Write<uint8_t>(ir.geom_source.has_value());
+    if (ir.geom_source.has_value()) {
+      writer.Write(ir.geom_source.value());
+    }
+
+    writer.Write<uint32_t>(static_cast<uint32_t>(ir.stripped_uniforms.size()));
+    for (const auto& name : ir.stripped_uniforms) {
+      writer.Write(name);
+    }
+
+    return writer.Bytes();
+  }
+
+  Opt<ShaderIr> DeserializeIr(UUID key , const std::string& bytes) {
+    CacheReader reader(bytes);
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t stored_key = 0;
+    if (!reader.Read(magic) || magic != kCacheMagic || !reader.Read(version) || version != kShaderCompilerVersion ||
+        !reader.Read(stored_key) || stored_key != key.Get()) {
+      return std::nullopt;
+    }
+
+    ShaderIr ir;
+
+    uint8_t override = 0;
+    uint32_t num_attrs = 0;
+    if (!reader.Read(override) || !reader.Read(ir.layout.curr_idx) || !reader.Read(ir.layout.layout_name) ||
+        !reader.Read(ir.layout.stride) || !reader.Read(num_attrs)) {
+      return std::nullopt;
+    }
+    ir.layout.override = override != 0;
+
+    ir.layout.attrs.resize(num_attrs);
+    for (auto& attr : ir.layout.attrs) {
+      if (!reader.Read(attr.attr_name) || !reader.Read(attr.idx) || !reader.Read(attr.size)) {
+        return std::nullopt;
+      }
+    }
+
+    uint32_t num_storages = 0;
+    if (!reader.Read(num_storages)) {
+      return std::nullopt;
+    }
+
+    for (uint32_t i = 0; i < num_storages; ++i) {
+      uint64_t id = 0;
+      uint32_t type = 0;
+      ShaderStorage storage;
+      if (!reader.Read(id) || !reader.Read(type) || !reader.Read(storage.binding_point) ||
+          !reader.Read(storage.name) || !ReadUniforms(reader , storage.uniforms)) {
+        return std::nullopt;
+      }
+      storage.type = static_cast<ShaderStorageType>(type);
+      ir.storages[id] = storage;
+    }
+
+    if (!ReadUniforms(reader , ir.uniforms)) {
+      return std::nullopt;
+    }
+
+    uint8_t has_geom = 0;
+    if (!reader.Read(ir.name) || !reader.Read(ir.vert_source) || !reader.Read(ir.frag_source) || !reader.Read(has_geom)) {
+      return std::nullopt;
+    }
+
+    if (has_geom) {
+      std::string geom;
+      if (!reader.Read(geom)) {
+        return std::nullopt;
+      }
+      ir.geom_source = geom;
+    }
+
+    uint32_t num_stripped = 0;
+    if (!reader.Read(num_stripped)) {
+      return std::nullopt;
+    }
+
+    ir.stripped_uniforms.resize(num_stripped);
+    for (auto& name : ir.stripped_uniforms) {
+      if (!reader.Read(name)) {
+        return std::nullopt;
+      }
+    }
+
+    if (!reader.AtEnd()) {
+      return std::nullopt;
+    }
+
+    return ir;
+  }
+
+} // anonymous namespace
+
+  Scope<ShaderCache> ShaderCache::instance = nullptr;
+
+  ShaderCache::ShaderCache(const Path& cache_dir)
+      : cache_dir(cache_dir) {
+    if (!Filesystem::PathExists(cache_dir)) {
+      std::error_code ec;
+      std::filesystem::create_directories(cache_dir , ec);
+      if (ec) {
+        OE_ERROR("Failed to create shader cache directory {} : {}" , cache_dir , ec.message());
+      }
+    }
+  }
+
+  void ShaderCache::Open(const Path& cache_dir) {
+    instance = NewScope<ShaderCache>(cache_dir);
+    OE_DEBUG("Shader cache opened at {}" , cache_dir);
+  }
+
+  void ShaderCache::Close() {
+    instance = nullptr;
+  }
+
+  ShaderCache* ShaderCache::Instance() {
+    return instance.get();
+  }
+
+  UUID ShaderCache::Key(const std::string& src , const std::vector<std::string>& import_sources) {
+    uint64_t key = FNV(src);
+    for (const auto& import : import_sources) {
+      key ^= FNV(import);
+      key *= kFnvPrime;
+    }
+
+    key ^= kShaderCompilerVersion;
+    key *= kFnvPrime;
+
+    return key;
+  }
+
+  Opt<ShaderIr> ShaderCache::Load(UUID key) {
+    Path entry = EntryPath(key);
+    std::ifstream file(entry , std::ios::binary);
+    if (!file.is_open()) {
+      ++misses;
+      return std::nullopt;
+    }
+
+    std::stringstream ss;
+    ss << file.rdbuf();
+
+    Opt<ShaderIr> ir = DeserializeIr(key , ss.str());
+    if (!ir.has_value()) {
+      OE_WARN("Discarding corrupt shader cache entry {}" , entry);
+      ++misses;
+      return std::nullopt;
+    }
+
+    ++hits;
+    return ir;
+  }
+
+  bool ShaderCache::Store(UUID key , const ShaderIr& ir) {
+    const std::string bytes = SerializeIr(key , ir);
+
+    Path entry = EntryPath(key);
+    Path tmp = entry;
+    tmp += fmtstr(".{}.tmp" , std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    {
+      std::ofstream file(tmp , std::ios::binary | std::ios::trunc);
+      if (!file.is_open()) {
+        OE_ERROR("Failed to open shader cache entry {} for writing" , tmp);
+        return false;
+      }
+      file.write(bytes.data() , bytes.size());
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp , entry , ec);
+    if (ec) {
+      std::filesystem::remove(tmp , ec);
+      OE_ERROR("Failed to write shader cache entry {}" , entry);
+      return false;
+    }
+
+    ++stores;
+    return true;
+  }
+
+  void ShaderCache::Clear() {
+    for (const auto& file : Filesystem::GetDirectoryFiles(cache_dir)) {
+      if (file.extension() == kCacheExtension) {
+        Filesystem::AttemptDelete(file);
+      }
+    }
+  }
+
+  const Path& ShaderCache::Directory() const {
+    return cache_dir;
+  }
+
+  ShaderCacheStats ShaderCache::Stats() const {
+    return {
+      .hits = hits.load() ,
+      .misses = misses.load() ,
+      .stores = stores.load() ,
+    };
+  }
+
+  Path ShaderCache::EntryPath(UUID key) const {
+    return cache_dir / fmtstr("{:016x}{}" , key.Get() , kCacheExtension);
+  }
+
+} // namespace other
@@ -0,0 +1,70 @@
+/**
+ * \file parsing/shader_cache.hpp
+ **/
+#ifndef OTHER_ENGINE_SHADER_CACHE_HPP
+#define OTHER_ENGINE_SHADER_CACHE_HPP
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "core/defines.hpp"
+#include "core/uuid.hpp"
+
+#include "rendering/shader.hpp"
+
+namespace other {
+
+  /// bump whenever the generated glsl or the layout of ShaderIr changes, invalidates every cached entry
+  constexpr static uint32_t kShaderCompilerVersion = 2;
+
+  struct ShaderCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t stores = 0;
+  };
+
+  /**
+   * content addressed on-disk store of transpiled shaders
+   *
+   * entries are keyed by the raw shader source , the contents of every resolved import and kShaderCompilerVersion,
+   *   editing any of them produces a new key so stale entries are never read, they are just left behind
+   *
+   * Load/Store are safe to call from multiple threads, each key maps to its own file and stores go through a
+   *   temporary file that is renamed into place
+   **/
+  class ShaderCache {
+    public:
+      ShaderCache(const Path& cache_dir);
+
+      static void Open(const Path& cache_dir);
+      static void Close();
+      /// null if the cache has not been opened
+      static ShaderCache* Instance();
+
+      static UUID Key(const std::string& src , const std::vector<std::string>& import_sources);
+
+      Opt<ShaderIr> Load(UUID key);
+      bool Store(UUID key , const ShaderIr& ir);
+
+      /// removes every entry in the cache directory
+      void Clear();
+
+      const Path& Directory() const;
+      ShaderCacheStats Stats() const;
+
+    private:
+      static Scope<ShaderCache> instance;
+
+      Path cache_dir;
+
+      std::atomic<uint64_t> hits = 0;
+      std::atomic<uint64_t> misses = 0;
+      std::atomic<uint64_t> stores = 0;
+
+      Path EntryPath(UUID key) const;
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_SHADER_CACHE_HPP
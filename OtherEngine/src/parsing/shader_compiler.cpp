@@ -3,13 +3,64 @@
  **/
 #include "parsing/shader_compiler.hpp"
 
+#include <algorithm>
+
+#include "core/filesystem.hpp"
+#include "core/logger.hpp"
+#include "core/profile.hpp"
+#include "core/thread_pool.hpp"
+
+#include "parsing/shader_cache.hpp"
 #include "parsing/shader_preprocessor.hpp"
 #include "parsing/shader_lexer.hpp"
 #include "parsing/shader_parser.hpp"
+#include "parsing/shader_optimizer.hpp"
 #include "parsing/shader_glsl_transpiler.hpp"
 
 namespace other {
-      
+namespace {
+
+  struct ResolvedImport {
+    Path path;
+
+    /// empty when the file could not be read
+    Opt<std::string> src = std::nullopt;
+  };
+
+  /// every file imported from 'from' , directly or through other imports , each once in first seen order
+  void CollectImports(const Path& from , const std::vector<std::string>& names , std::vector<ResolvedImport>& closure) {
+    for (const auto& name : names) {
+      const Path import_path = (from.parent_path() / name).lexically_normal();
+      auto seen = std::find_if(closure.begin() , closure.end() , [&](const ResolvedImport& import) -> bool {
+        return import.path == import_path;
+      });
+      if (seen != closure.end()) {
+        continue;
+      }
+
+      ResolvedImport& import = closure.emplace_back(ResolvedImport{ .path = import_path });
+      if (!Filesystem::FileExists(import_path)) {
+        continue;
+      }
+
+      std::string src = Filesystem::ReadFile(import_path);
+      import.src = src;
+
+      /// imports are never compiled on their own , a file that does not preprocess just has no imports of its own
+      std::vector<std::string> nested;
+      try {
+        ShaderPreprocessor preprocessor(src , OTHER_SHADER);
+        nested = preprocessor.Process().imports;
+      } catch (const ShaderException& e) {
+        OE_WARN("Failed to read imports of {} : {}" , import_path , e.what());
+      }
+
+      CollectImports(import_path , nested , closure);
+    }
+  }
+
+} // anonymous namespace
+
   ShaderIr ShaderCompiler::Compile(const std::string& src) {
     return Compile(OTHER_SHADER , src);
   }
@@ -18,14 +69,144 @@ namespace other {
     ShaderPreprocessor preprocessor(src , type);
     ShaderProcessedFile processed_shader = preprocessor.Process();
 
+    return CompileProcessed(processed_shader);
+  }
+
+  ShaderIr ShaderCompiler::Compile(const Path& path , ShaderCache* cache , bool* cache_hit) {
+    OE_PROFILE_SCOPE("ShaderCompiler::Compile");
+    OE_PROFILE_TAG(path.filename().string());
+
+    if (cache_hit != nullptr) {
+      *cache_hit = false;
+    }
+
+    std::string src = Filesystem::ReadFile(path);
+    if (src.empty()) {
+      throw ShaderException(fmtstr("Failed to read shader file {}" , path.string()) , SHADER_EMPTY , 0 , 0);
+    }
+
+    ShaderPreprocessor preprocessor(src , OTHER_SHADER);
+    ShaderProcessedFile processed_shader = preprocessor.Process();
+
+    if (cache == nullptr) {
+      ShaderIr ir = CompileProcessed(processed_shader);
+      ir.name = path.filename().string();
+      return ir;
+    }
+
+    /// the key covers imports of imports too , an import that can not be resolved still contributes its path so
+    ///   adding the file later changes the key
+    std::vector<ResolvedImport> imports;
+    CollectImports(path , processed_shader.imports , imports);
+
+    std::vector<std::string> import_sources;
+    import_sources.reserve(imports.size());
+    for (auto& import : imports) {
+      if (import.src.has_value()) {
+        import_sources.push_back(std::move(import.src.value()));
+      } else {
+        OE_WARN("Failed to resolve shader import {} from {}" , import.path , path);
+        import_sources.push_back(import.path.string());
+      }
+    }
+
+    UUID key = ShaderCache::Key(src , import_sources);
+    if (Opt<ShaderIr> cached = cache->Load(key); cached.has_value()) {
+      if (cache_hit != nullptr) {
+        *cache_hit = true;
+      }
+      return cached.value();
+    }
+
+    ShaderIr ir = CompileProcessed(processed_shader);
+    ir.name = path.filename().string();
+
+    cache->Store(key , ir);
+    return ir;
+  }
+
+  std::vector<Path> ShaderCompiler::Imports(const Path& path) {
+    std::string src = Filesystem::ReadFile(path);
+    if (src.empty()) {
+      throw ShaderException(fmtstr("Failed to read shader file {}" , path.string()) , SHADER_EMPTY , 0 , 0);
+    }
+
+    ShaderPreprocessor preprocessor(src , OTHER_SHADER);
+    ShaderProcessedFile processed_shader = preprocessor.Process();
+
+    std::vector<ResolvedImport> closure;
+    CollectImports(path , processed_shader.imports , closure);
+
+    std::vector<Path> imports;
+    imports.reserve(closure.size());
+    for (const auto& import : closure) {
+      imports.push_back(import.path);
+    }
+    return imports;
+  }
+
+  std::vector<ShaderBatchResult> ShaderCompiler::CompileBatch(const Path& dir , ShaderCache* cache , bool parallel) {
+    std::vector<ShaderBatchResult> results;
+    for (const auto& file : Filesystem::GetDirectoryFiles(dir)) {
+      if (file.extension() == ".oshader") {
+        results.push_back({ .path = file });
+      }
+    }
+
+    if (results.empty()) {
+      return results;
+    }
+
+    std::sort(results.begin() , results.end() , [](const ShaderBatchResult& a , const ShaderBatchResult& b) -> bool {
+      return a.path < b.path;
+    });
+
+    /// results are written to disjoint slots so no lock is needed
+    auto compile = [&](uint32_t first , uint32_t last) {
+      for (uint32_t i = first; i < last; ++i) {
+        ShaderBatchResult& res = results[i];
+        try {
+          res.ir = Compile(res.path , cache , &res.cache_hit);
+        } catch (const std::exception& e) {
+          res.error = e.what();
+        }
+      }
+    };
+
+    const uint32_t count = static_cast<uint32_t>(results.size());
+    ThreadPool* pool = ThreadPool::Get();
+    if (!parallel || pool == nullptr || count < 2) {
+      compile(0 , count);
+    } else {
+      pool->ParallelFor(count , 1 , compile);
+    }
+
+    for (const auto& res : results) {
+      if (!res.ir.has_value()) {
+        OE_ERROR("Failed to compile shader {} : {}" , res.path , res.error);
+      }
+    }
+
+    return results;
+  }
+
+  ShaderIr ShaderCompiler::CompileProcessed(const ShaderProcessedFile& processed_shader) {
+    OE_PROFILE_SCOPE("ShaderCompiler::CompileProcessed");
+
+    /// tokens and the ast view into processed_shader, it has to stay alive until transpilation is done
     ShaderLexer lexer(processed_shader);
     ShaderLexResult tokens = lexer.Lex();
 
     ShaderParser parser(tokens);
     ShaderAst ast = parser.Parse();
 
+    ShaderOptimizer optimizer(ast);
+    ShaderOptimizerStats stats = optimizer.Optimize();
+
     ShaderGlslTranspiler transpiler(ast);
-    return transpiler.Transpile();
+    ShaderIr ir = transpiler.Transpile();
+    ir.stripped_uniforms = std::move(stats.stripped_uniforms);
+    return ir;
   }
 
 } // namespace other
@@ -8,13 +8,39 @@
 
 namespace other {
 
+  class ShaderCache;
+  struct ShaderProcessedFile;
+
+  struct ShaderBatchResult {
+    Path path;
+    Opt<ShaderIr> ir = std::nullopt;
+    std::string error = "";
+    bool cache_hit = false;
+  };
+
   class ShaderCompiler {
     public:
       static ShaderIr Compile(const std::string& src);
       static ShaderIr Compile(ShaderType type , const std::string& src);
+
+      /**
+       * imports are resolved relative to the shader's directory, if cache is not null the transpiled ir is looked up
+       *   by content hash before compiling and stored after a miss
+       **/
+      static ShaderIr Compile(const Path& path , ShaderCache* cache = nullptr , bool* cache_hit = nullptr);
+
+      /// the files path imports directly or through other imports , resolved the same way Compile resolves them ,
+      ///   missing files included
+      static std::vector<Path> Imports(const Path& path);
+
+      /// compiles every .oshader in dir on the engine thread pool , serially without a pool or when parallel is false ,
+      ///   results are sorted by path
+      static std::vector<ShaderBatchResult> CompileBatch(const Path& dir , ShaderCache* cache = nullptr , bool parallel = true);
+
+    private:
+      static ShaderIr CompileProcessed(const ShaderProcessedFile& processed_shader);
   };
 
 } // namespace other
 
 #endif // !OTHER_ENGINE_SHADER_COMPILER_HPP
-
@@ -3,6 +3,8 @@
  **/
 #include "parsing/shader_glsl_transpiler.hpp"
 
+#include <charconv>
+
 #include "core/errors.hpp"
 #include "parsing/parsing_defines.hpp"
 #include "parsing/shader_ast_node.hpp"
@@ -13,7 +15,7 @@ namespace other {
   ShaderIr ShaderGlslTranspiler::Transpile() {
     ProcessNodes();
 
-    std::vector<Ref<AstNode>>* correct_nodes = nullptr;
+    std::vector<AstNode*>* correct_nodes = nullptr;
     std::string* output_src = nullptr;
 
     bool other_shader = false;
@@ -123,7 +125,7 @@ namespace other {
   void ShaderGlslTranspiler::Visit(VarDecl& stmt) {
     if (!flags.is_uniform.empty()) {
       Uniform uni{
-        .name = stmt.name.value , 
+        .name = std::string{ stmt.name.value } , 
         .type = ValueTypeFromString(stmt.type.value) ,
       }; 
     
@@ -198,7 +200,7 @@ namespace other {
 
       /// curr_idx and what we're reading will always be the same
       vertex_attr_stack.push({
-        .idx = std::stoul(literal.value) , 
+        .idx = UintFromToken(literal) , 
       });
 
       mesh_layout->curr_idx++;
@@ -213,7 +215,7 @@ namespace other {
       token_stack.pop();
 
       shader_storage_stack.push({
-        .binding_point = std::stoul(literal.value) , 
+        .binding_point = UintFromToken(literal) , 
       });
     }
   }
@@ -313,7 +315,7 @@ namespace other {
     } 
   }
 
-  std::string ShaderGlslTranspiler::TranspileTo(std::vector<Ref<AstNode>>& nodes) {
+  std::string ShaderGlslTranspiler::TranspileTo(const std::vector<AstNode*>& nodes) {
     std::stringstream stream;
     stream << "#version 460 core\n\n";
 
@@ -453,7 +455,7 @@ namespace other {
     } ,
   };
       
-  void ShaderGlslTranspiler::SetMeshLayout(const std::string& value) {
+  void ShaderGlslTranspiler::SetMeshLayout(std::string_view value) {
     if (context != VERTEX_SHADER) {
       throw Error(INVALID_SHADER_CTX , "Can not change mesh layout from anything but a vertex shader!");
     }
@@ -489,7 +491,7 @@ namespace other {
     mesh_layout->override = true;
   }
       
-  uint32_t ShaderGlslTranspiler::SizeFromString(const std::string& str) {
+  uint32_t ShaderGlslTranspiler::SizeFromString(std::string_view str) {
     if (str == "int") {
       return 1;
     } else if (str == "vec2") {
@@ -508,7 +510,7 @@ namespace other {
     return 0;
   }
       
-  ValueType ShaderGlslTranspiler::ValueTypeFromString(const std::string& str) {
+  ValueType ShaderGlslTranspiler::ValueTypeFromString(std::string_view str) {
     if (str == "int") {
       return INT32;
     } else if (str == "vec2") {
@@ -526,5 +528,14 @@ namespace other {
     }
     return EMPTY;
   }
+      
+  uint32_t ShaderGlslTranspiler::UintFromToken(const Token& token) {
+    uint32_t value = 0;
+    auto [_ , ec] = std::from_chars(token.value.data() , token.value.data() + token.value.size() , value);
+    if (ec != std::errc{}) {
+      throw Error(SHADER_TRANSPILATION , "Expected an unsigned integer literal! found {}" , token.value);
+    }
+    return value;
+  }
 
 } // namespace other
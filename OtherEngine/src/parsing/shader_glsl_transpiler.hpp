@@ -13,7 +13,7 @@ namespace other {
 
   class ShaderGlslTranspiler : public TreeWalker {
     public: 
-      ShaderGlslTranspiler(ShaderAst ast)
+      ShaderGlslTranspiler(ShaderAst& ast)
         : ast(ast) {}
 
       ShaderIr Transpile();
@@ -61,7 +61,7 @@ namespace other {
     private:
       ShaderIr result;
 
-      ShaderAst ast;
+      ShaderAst& ast;
       ShaderType context;
 
       struct Flags {
@@ -76,13 +76,14 @@ namespace other {
 
       std::stack<Token> token_stack;
 
-      std::string  TranspileTo(std::vector<Ref<AstNode>>& nodes);
+      std::string  TranspileTo(const std::vector<AstNode*>& nodes);
       void ProcessNodes();
 
-      void SetMeshLayout(const std::string& value);
+      void SetMeshLayout(std::string_view value);
 
-      uint32_t SizeFromString(const std::string& str);
-      ValueType ValueTypeFromString(const std::string& str);
+      uint32_t SizeFromString(std::string_view str);
+      ValueType ValueTypeFromString(std::string_view str);
+      uint32_t UintFromToken(const Token& token);
 
       template <typename... Args>
       ShaderException Error(ShaderError error , std::string_view message, Args&&... args) const {
@@ -2,6 +2,9 @@
  * \file parsing/shader_lexer.cpp
  **/
 #include "parsing/shader_lexer.hpp"
+
+#include <charconv>
+
 #include "parsing/parsing_defines.hpp"
 
 namespace other {
@@ -11,6 +14,10 @@ namespace other {
       return {};
     }
 
+    result.arena = NewScope<ShaderArena>();
+
+    /// roughly one token per handful of characters, avoids regrowing the token list through the whole file
+    result.tokens.reserve(file_data.src.size() / 4);
     result.tokens.push_back(Token(loc ,TokenType::START_SRC , ""));
 
     loc.index = 0;
@@ -45,7 +52,7 @@ namespace other {
 
     result.tokens.push_back(Token(loc , TokenType::END_SRC , ""));
 
-    return result;
+    return std::move(result);
   }
 
   void ShaderLexer::HandleWhitespace() {
@@ -100,8 +107,11 @@ namespace other {
       Consume();
     }
 
-    if (std::stod(current_token) > std::numeric_limits<float>::max()) {
-      throw Error(INVALID_VALUE , "Float value in shader is too large {}" , current_token);
+    std::string_view token = CurrentToken();
+    double value = 0.0;
+    auto [_ , ec] = std::from_chars(token.data() , token.data() + token.size() , value);
+    if (ec == std::errc::result_out_of_range || value > std::numeric_limits<float>::max()) {
+      throw Error(INVALID_VALUE , "Float value in shader is too large {}" , token);
     }
       
     AddToken(TokenType::FLOAT_LIT);
@@ -112,13 +122,15 @@ namespace other {
 
     bool small = false;
 
-    double lead_digit;
-    try {
-      lead_digit = std::stod(current_token);
-    } catch (std::out_of_range& e) {
-      throw Error(INVALID_VALUE , "Scientific notation lead digit out of range");
-    } catch (std::invalid_argument& e) {
-      throw Error(INVALID_VALUE , "Scientific notation lead digit is not a number");
+    double lead_digit = 0.0;
+    {
+      std::string_view token = CurrentToken();
+      auto [_ , ec] = std::from_chars(token.data() , token.data() + token.size() , lead_digit);
+      if (ec == std::errc::result_out_of_range) {
+        throw Error(INVALID_VALUE , "Scientific notation lead digit out of range");
+      } else if (ec != std::errc{}) {
+        throw Error(INVALID_VALUE , "Scientific notation lead digit is not a number");
+      }
     }
 
     DiscardToken();
@@ -134,21 +146,23 @@ namespace other {
       }
     }
 
-    uint32_t val;
-    try {
-      val = std::stoi(current_token);
-    } catch (std::out_of_range& e) {
-      throw Error(INVALID_VALUE , "Scientific notation exponent out of range");
-    } catch (std::invalid_argument& e) {
-      throw Error(INVALID_VALUE , "Scientific notation exponent is not a number");
-    } 
+    uint32_t val = 0;
+    {
+      std::string_view token = CurrentToken();
+      auto [_ , ec] = std::from_chars(token.data() , token.data() + token.size() , val);
+      if (ec == std::errc::result_out_of_range) {
+        throw Error(INVALID_VALUE , "Scientific notation exponent out of range");
+      } else if (ec != std::errc{}) {
+        throw Error(INVALID_VALUE , "Scientific notation exponent is not a number");
+      } 
+    }
 
     std::string small_str = "0.";
     if (small) {
       auto pos = std::to_string(lead_digit).find('.');
       std::string lead_digit_str = pos == std::string::npos ? 
         std::to_string(lead_digit) : 
-        std::to_string(lead_digit).substr(0, pos) + std::to_string(lead_digit).substr(pos + 1, current_token.size() - pos - 1);
+        std::to_string(lead_digit).substr(0, pos) + std::to_string(lead_digit).substr(pos + 1, CurrentToken().size() - pos - 1);
 
       while (lead_digit_str[lead_digit_str.size() - 1] == '0') {
         lead_digit_str.pop_back();
@@ -160,16 +174,20 @@ namespace other {
       small_str += lead_digit_str;
     }
 
-    std::string  result = small ? 
+    std::string folded = small ? 
       small_str :
       std::to_string(lead_digit * std::pow(10, val));
-    current_token = result;
 
-    if (std::stod(current_token) > std::numeric_limits<float>::max()) {
-      throw Error(ShaderError::INVALID_VALUE ,"Float value in shader is too large {}" , current_token);
+    /// the folded literal does not exist in the source, so its text has to live in the arena
+    std::string_view value = result.arena->Intern(folded);
+
+    double folded_value = 0.0;
+    auto [_ , ec] = std::from_chars(value.data() , value.data() + value.size() , folded_value);
+    if (ec == std::errc::result_out_of_range || folded_value > std::numeric_limits<float>::max()) {
+      throw Error(ShaderError::INVALID_VALUE ,"Float value in shader is too large {}" , value);
     }
       
-    AddToken(TokenType::FLOAT_LIT);
+    AddToken(TokenType::FLOAT_LIT , value , FNV(value));
   }
 
   void ShaderLexer::HandleAlpha() {
@@ -177,13 +195,17 @@ namespace other {
       Advance();
     }
 
-    if (IsKeyword(current_token)) {
-      AddToken(GetKeywordType(current_token));
+    std::string_view token = CurrentToken();
+    uint64_t hash = FNV(token);
+
+    TokenType keyword = KeywordFromHash(hash);
+    if (keyword != INVALID_TOKEN) {
+      AddToken(keyword , token , hash);
     } else {
-      if (current_token.substr(0 , 3) == "std") {
-        AddToken(STDXXX_KW);
+      if (token.starts_with("std")) {
+        AddToken(STDXXX_KW , token , hash);
       } else {
-        AddToken(IDENTIFIER);
+        AddToken(IDENTIFIER , token , hash);
       }
     }
   }
@@ -332,8 +354,13 @@ namespace other {
 
     DiscardToken();
   }
-void ShaderLexer::AddToken(TokenType type) {
-    result.tokens.push_back(Token(loc, type, current_token));
+  void ShaderLexer::AddToken(TokenType type) {
+    result.tokens.push_back(Token(loc, type, CurrentToken()));
+    DiscardToken();
+  }
+
+  void ShaderLexer::AddToken(TokenType type , std::string_view value , uint64_t hash) {
+    result.tokens.push_back(Token(loc , type , value , hash));
     DiscardToken();
   }
 
@@ -351,12 +378,15 @@ void ShaderLexer::AddToken(TokenType type) {
   }
 
   void ShaderLexer::Advance() {
-    current_token += file_data.src[loc.index];
+    if (token_length == 0) {
+      token_start = loc.index;
+    }
+    ++token_length;
     Consume();
   }
 
   void ShaderLexer::DiscardToken() {
-    current_token = "";
+    token_length = 0;
   }
 
   bool ShaderLexer::AtEnd() const {
@@ -393,19 +423,8 @@ void ShaderLexer::AddToken(TokenType type) {
     return true;
   }
       
-  TokenType ShaderLexer::GetKeywordType(const std::string& str) const {
-    try {
-      auto itr = std::find_if(kKeywordMap.begin() , kKeywordMap.end() , [&str](const KeyWordPair& kw) -> bool {
-        return FNV(str) == kw.first;
-      });
-      if (itr != kKeywordMap.end()) {
-        return itr->second;
-      }
-      return VOID_KW;
-    } catch (...) {
-      std::string msg = fmtstr("Unknown operator : '{}'" , str);
-      throw Error(ShaderError::SYNTAX_ERROR , msg);
-    }
+  std::string_view ShaderLexer::CurrentToken() const {
+    return std::string_view(file_data.src).substr(token_start , token_length);
   }
 
 } // namespace other
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "parsing/parsing_defines.hpp"
+#include "parsing/shader_arena.hpp"
 #include "parsing/shader_preprocessor.hpp"
 
 namespace other {
@@ -16,8 +17,14 @@ namespace other {
   struct ShaderLexResult {
     std::vector<Token> tokens;
     ShaderType shader_type;
+
+    /// holds any token text that does not exist verbatim in the source, handed to the parser for the ast
+    Scope<ShaderArena> arena = nullptr;
   };
 
+  /**
+   * tokens view directly into processed_file.src, which must outlive the lex result and the ast built from it
+   **/
   class ShaderLexer {
     public:
       ShaderLexer(const ShaderProcessedFile& processed_file)
@@ -28,9 +35,11 @@ namespace other {
       ShaderLexResult Lex();
 
     private:
-      ShaderProcessedFile file_data;
+      const ShaderProcessedFile& file_data;
 
-      std::string current_token;
+      /// current token is always the contiguous range [token_start , token_start + token_length) of the source
+      uint32_t token_start = 0;
+      uint32_t token_length = 0;
       SourceLocation loc;
 
       ShaderLexResult result;
@@ -52,6 +61,7 @@ namespace other {
       void HandleComment();
 
       void AddToken(TokenType type);
+      void AddToken(TokenType type , std::string_view value , uint64_t hash);
 
       void NewLine(bool advance = true);
       void Consume();
@@ -64,7 +74,8 @@ namespace other {
       bool Check(char c) const;
       bool CheckNext(char c) const;
       bool Match(char expected);
-      TokenType GetKeywordType(const std::string& str) const;      
+
+      std::string_view CurrentToken() const;
 
       template <typename... Args>
       ShaderException Error(ShaderError error , std::string_view message, Args&&... args) const {
@@ -0,0 +1,1396 @@
+/**
+ * \file parsing/shader_optimizer.cpp
+ **/
+#include "parsing/shader_optimizer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/logger.hpp"
+
+#include "parsing/shader_ast_node.hpp"
+
+namespace other {
+
+  void ShaderPass::Walk(AstNode* node) {
+    if (node != nullptr) {
+      node->Accept(*this);
+    }
+  }
+
+  void ShaderPass::Rewrite(AstExpr*& slot) {
+    if (slot == nullptr) {
+      return;
+    }
+
+    replacement = nullptr;
+    slot->Accept(*this);
+    if (replacement != nullptr) {
+      slot = replacement;
+      replacement = nullptr;
+    }
+  }
+
+  void ShaderPass::Visit(LiteralExpr& expr) {}
+
+  void ShaderPass::Visit(UnaryExpr& expr) {
+    Rewrite(expr.right);
+  }
+
+  void ShaderPass::Visit(BinaryExpr& expr) {
+    Rewrite(expr.left);
+    Rewrite(expr.right);
+  }
+
+  void ShaderPass::Visit(CallExpr& expr) {
+    Rewrite(expr.callee);
+    for (auto& arg : expr.args) {
+      Rewrite(arg);
+    }
+  }
+
+  void ShaderPass::Visit(GroupingExpr& expr) {
+    Rewrite(expr.expr);
+  }
+
+  void ShaderPass::Visit(VarExpr& expr) {}
+
+  void ShaderPass::Visit(AssignExpr& expr) {
+    Rewrite(expr.value);
+  }
+
+  void ShaderPass::Visit(ArrayExpr& expr) {
+    for (auto& elt : expr.elements) {
+      Rewrite(elt);
+    }
+  }
+
+  void ShaderPass::Visit(ArrayAccessExpr& expr) {
+    Rewrite(expr.array);
+    Rewrite(expr.index);
+  }
+
+  void ShaderPass::Visit(ObjAccessExpr& expr) {
+    Rewrite(expr.obj);
+    Rewrite(expr.index);
+    Rewrite(expr.assignment);
+  }
+
+  void ShaderPass::Visit(ExprStmt& stmt) {
+    Rewrite(stmt.expr);
+  }
+
+  void ShaderPass::Visit(VarDecl& stmt) {
+    Rewrite(stmt.initializer);
+  }
+
+  void ShaderPass::Visit(ArrayDecl& stmt) {
+    Rewrite(stmt.initializer);
+  }
+
+  void ShaderPass::Visit(BlockStmt& stmt) {
+    for (auto& s : stmt.statements) {
+      Walk(s);
+    }
+  }
+
+  void ShaderPass::Visit(IfStmt& stmt) {
+    Rewrite(stmt.condition);
+    Walk(stmt.then_branch);
+    Walk(stmt.else_branch);
+  }
+
+  void ShaderPass::Visit(WhileStmt& stmt) {
+    Rewrite(stmt.condition);
+    Walk(stmt.body);
+  }
+
+  void ShaderPass::Visit(ReturnStmt& stmt) {
+    Walk(stmt.stmt);
+  }
+
+  void ShaderPass::Visit(FunctionStmt& stmt) {
+    Walk(stmt.body);
+  }
+
+  void ShaderPass::Visit(StructStmt& stmt) {
+    for (auto& f : stmt.fields) {
+      Walk(f);
+    }
+  }
+
+  void ShaderPass::Visit(LayoutDescriptor& expr) {
+    Rewrite(expr.expr);
+  }
+
+  void ShaderPass::Visit(LayoutDecl& stmt) {
+    for (auto& d : stmt.descriptors) {
+      Rewrite(d);
+    }
+    Walk(stmt.data);
+  }
+
+  void ShaderPass::Visit(ShaderStorageStmt& stmt) {
+    Walk(stmt.body);
+  }
+
+  void ShaderPass::Visit(InOutBlockStmt& stmt) {
+    Walk(stmt.body);
+  }
+
+  void ShaderPass::Visit(UniformDecl& stmt) {
+    Walk(stmt.var_decl);
+  }
+
+  void ShaderPass::Visit(ShaderDecl& stmt) {
+    for (auto& a : stmt.attributes) {
+      Rewrite(a);
+    }
+
+    for (auto& s : stmt.statements) {
+      Walk(s);
+    }
+  }
+
+namespace {
+
+  using NameSet = std::unordered_set<std::string_view>;
+
+  template <typename T>
+  using NameMap = std::unordered_map<std::string_view , T>;
+
+  /// removing a function or a variable can make others dead, this bounds how often the stages are swept
+  constexpr uint32_t kMaxDcePasses = 8;
+
+  /**
+   * variables, arrays and struct layouts the transpiler writes into every stage before the user's code, these
+   *   have to match ShaderGlslTranspiler::TranspileTo and the engine mesh layouts
+   **/
+  const NameMap<std::string_view> kBuiltinVariables = {
+    { "gl_Position" , "vec4" } , { "gl_InstanceID" , "int" } , { "gl_FragCoord" , "vec4" } ,
+    { "projection" , "mat4" } , { "view" , "mat4" } , { "viewpoint" , "vec4" } ,
+    { "material" , "Material" } , { "instanceid" , "int" } , { "num_lights" , "vec4" } ,
+    { "goe_position" , "sampler2D" } , { "goe_normal" , "sampler2D" } , { "goe_albedo" , "sampler2D" } ,
+    { "g_position" , "vec4" } , { "g_normal" , "vec4" } , { "g_albedo" , "vec4" } ,
+    { "voe_position" , "vec3" } , { "voe_normal" , "vec3" } , { "voe_tangent" , "vec3" } ,
+    { "voe_bitangent" , "vec3" } , { "voe_uvs" , "vec2" } ,
+  };
+
+  const NameMap<std::string_view> kBuiltinArrays = {
+    { "models" , "mat4" } , { "materials" , "Material" } ,
+    { "point_lights" , "PointLight" } , { "direction_lights" , "DirectionLight" } ,
+  };
+
+  const NameMap<NameMap<std::string_view>> kBuiltinStructs = {
+    { "Material" , { { "color" , "vec4" } , { "shininess" , "float" } } } ,
+    { "PointLight" , {
+      { "position" , "vec4" } , { "color" , "vec4" } , { "radius" , "float" } ,
+      { "constant" , "float" } , { "linear" , "float" } , { "quadratic" , "float" } ,
+    } } ,
+    { "DirectionLight" , { { "direction" , "vec4" } , { "color" , "vec4" } } } ,
+  };
+
+  /// builtins whose result has the type of their first argument
+  const NameSet kGenTypeFunctions = {
+    "normalize" , "abs" , "sign" , "floor" , "ceil" , "fract" , "mod" , "min" , "max" , "clamp" , "mix" , "step" ,
+    "smoothstep" , "sin" , "cos" , "tan" , "asin" , "acos" , "atan" , "pow" , "exp" , "log" , "exp2" , "log2" ,
+    "sqrt" , "inversesqrt" , "reflect" , "refract" , "faceforward" , "radians" , "degrees" , "transpose" , "inverse" ,
+  };
+
+  const NameMap<std::string_view> kFixedTypeFunctions = {
+    { "length" , "float" } , { "distance" , "float" } , { "dot" , "float" } , { "determinant" , "float" } ,
+    { "cross" , "vec3" } , { "texture" , "vec4" } , { "texelFetch" , "vec4" } ,
+    { "float" , "float" } , { "int" , "int" } ,
+    { "vec2" , "vec2" } , { "vec3" , "vec3" } , { "vec4" , "vec4" } ,
+    { "mat2" , "mat2" } , { "mat3" , "mat3" } , { "mat4" , "mat4" } ,
+  };
+
+  constexpr std::array<std::string_view , 5> kVectorTypes = { "" , "float" , "vec2" , "vec3" , "vec4" };
+
+  template <typename T>
+  T Lookup(const NameMap<T>& map , std::string_view name) {
+    auto itr = map.find(name);
+    return itr == map.end() ? T{} : itr->second;
+  }
+
+  bool IsBuiltin(std::string_view name) {
+    return name.starts_with("gl_") || kBuiltinVariables.contains(name) || kBuiltinArrays.contains(name);
+  }
+
+  bool IsImpureBuiltin(std::string_view name) {
+    return name.starts_with("image") || name.starts_with("atomic") || name.starts_with("Emit") ||
+           name.starts_with("End") || name.ends_with("arrier");
+  }
+
+  std::string_view DeclName(AstNode* node) {
+    switch (node->GetType()) {
+      case VAR_DECL_STMT:
+        return static_cast<VarDecl*>(node)->name.value;
+      case ARRAY_DECL_STMT:
+        return static_cast<ArrayDecl*>(node)->name.value;
+      case UNIFORM_DECL_STMT:
+        return DeclName(static_cast<UniformDecl*>(node)->var_decl);
+      case FUNCTION_STMT:
+        return static_cast<FunctionStmt*>(node)->name.value;
+      case LAYOUT_VAR_DECL_STMT: {
+        auto* decl = static_cast<LayoutVarDecl*>(node);
+        return decl->name.has_value() ? decl->name->value : std::string_view{};
+      }
+      default:
+        return {};
+    }
+  }
+
+  /// the variable an lvalue ultimately writes to, `a.b[i].c` -> `a`
+  std::string_view RootName(AstExpr* expr) {
+    while (expr != nullptr) {
+      switch (expr->GetType()) {
+        case VAR_EXPR:
+          return static_cast<VarExpr*>(expr)->name.value;
+        case OBJ_ACCESS_EXPR:
+          expr = static_cast<ObjAccessExpr*>(expr)->obj;
+          break;
+        case ARRAY_ACCESS_EXPR:
+          expr = static_cast<ArrayAccessExpr*>(expr)->array;
+          break;
+        case GROUPING_EXPR:
+          expr = static_cast<GroupingExpr*>(expr)->expr;
+          break;
+        default:
+          return {};
+      }
+    }
+    return {};
+  }
+
+  std::string_view CalleeName(const CallExpr& expr) {
+    if (expr.callee == nullptr || expr.callee->GetType() != VAR_EXPR) {
+      return {};
+    }
+    return static_cast<VarExpr*>(expr.callee)->name.value;
+  }
+
+  struct Stage {
+    ShaderType type;
+    std::vector<AstNode*>& nodes;
+  };
+
+  template <typename Fn>
+  void ForEachGlobal(Stage& stage , Fn&& fn) {
+    for (auto* node : stage.nodes) {
+      if (node->GetType() == SHADER_DECL_STMT) {
+        for (auto* s : static_cast<ShaderDecl*>(node)->statements) {
+          fn(s);
+        }
+      } else {
+        fn(node);
+      }
+    }
+  }
+
+  template <typename T , typename Pred>
+  uint32_t EraseNodes(std::vector<T*>& nodes , Pred&& pred) {
+    auto itr = std::remove_if(nodes.begin() , nodes.end() , [&](T* node) -> bool {
+      return pred(static_cast<AstNode*>(node));
+    });
+
+    uint32_t erased = static_cast<uint32_t>(std::distance(itr , nodes.end()));
+    nodes.erase(itr , nodes.end());
+    return erased;
+  }
+
+  template <typename Pred>
+  uint32_t EraseGlobals(Stage& stage , Pred&& pred) {
+    uint32_t erased = 0;
+    for (auto* node : stage.nodes) {
+      if (node->GetType() == SHADER_DECL_STMT) {
+        erased += EraseNodes(static_cast<ShaderDecl*>(node)->statements , pred);
+      }
+    }
+
+    erased += EraseNodes(stage.nodes , [&](AstNode* node) -> bool {
+      return node->GetType() != SHADER_DECL_STMT && pred(node);
+    });
+    return erased;
+  }
+
+  NameSet FunctionNames(Stage& stage) {
+    NameSet names;
+    ForEachGlobal(stage , [&](AstNode* node) {
+      if (node->GetType() == FUNCTION_STMT) {
+        names.insert(DeclName(node));
+      }
+    });
+    return names;
+  }
+
+  class UsageCounter : public ShaderPass {
+    public:
+      using ShaderPass::Visit;
+
+      NameMap<uint32_t> reads;
+      NameMap<uint32_t> writes;
+
+      virtual void Visit(VarExpr& expr) override {
+        ++reads[expr.name.value];
+      }
+
+      virtual void Visit(AssignExpr& expr) override {
+        ++writes[expr.name.value];
+        ShaderPass::Visit(expr);
+      }
+
+      virtual void Visit(ObjAccessExpr& expr) override {
+        if (expr.assignment != nullptr) {
+          ++writes[RootName(expr.obj)];
+        }
+        ShaderPass::Visit(expr);
+      }
+  };
+
+  /// an expression is pure if evaluating it twice or not at all is unobservable
+  class PurityChecker : public ShaderPass {
+    public:
+      using ShaderPass::Visit;
+
+      PurityChecker(const NameSet& user_functions)
+        : user_functions(user_functions) {}
+
+      bool pure = true;
+
+      virtual void Visit(AssignExpr& expr) override {
+        pure = false;
+      }
+
+      virtual void Visit(ObjAccessExpr& expr) override {
+        if (expr.assignment != nullptr) {
+          pure = false;
+          return;
+        }
+        ShaderPass::Visit(expr);
+      }
+
+      virtual void Visit(CallExpr& expr) override {
+        std::string_view callee = CalleeName(expr);
+        if (callee.empty() || user_functions.contains(callee) || IsImpureBuiltin(callee)) {
+          pure = false;
+          return;
+        }
+        ShaderPass::Visit(expr);
+      }
+
+    private:
+      const NameSet& user_functions;
+  };
+
+  bool IsPure(AstNode* node , const NameSet& user_functions) {
+    PurityChecker checker(user_functions);
+    checker.Walk(node);
+    return checker.pure;
+  }
+
+  /// every name a statement assigns to or declares, calls to user functions may write through out parameters
+  class WriteCollector : public ShaderPass {
+    public:
+      using ShaderPass::Visit;
+
+      WriteCollector(const NameSet& user_functions)
+        : user_functions(user_functions) {}
+
+      NameSet names;
+
+      virtual void Visit(AssignExpr& expr) override {
+        names.insert(expr.name.value);
+        ShaderPass::Visit(expr);
+      }
+
+      virtual void Visit(ObjAccessExpr& expr) override {
+        if (expr.assignment != nullptr) {
+          names.insert(RootName(expr.obj));
+        }
+        ShaderPass::Visit(expr);
+      }
+
+      virtual void Visit(VarDecl& stmt) override {
+        names.insert(stmt.name.value);
+        ShaderPass::Visit(stmt);
+      }
+
+      virtual void Visit(ArrayDecl& stmt) override {
+        names.insert(stmt.name.value);
+        ShaderPass::Visit(stmt);
+      }
+
+      virtual void Visit(CallExpr& expr) override {
+        if (user_functions.contains(CalleeName(expr))) {
+          for (auto* arg : expr.args) {
+            names.insert(RootName(arg));
+          }
+        }
+        ShaderPass::Visit(expr);
+      }
+
+    private:
+      const NameSet& user_functions;
+  };
+
+  /// local declarations and every block they can live in
+  class DeclCollector : public ShaderPass {
+    public:
+      using ShaderPass::Visit;
+
+      NameMap<std::vector<VarDecl*>> vars;
+      NameSet arrays;
+      std::vector<BlockStmt*> blocks;
+
+      virtual void Visit(VarDecl& stmt) override {
+        vars[stmt.name.value].push_back(&stmt);
+        ShaderPass::Visit(stmt);
+      }
+
+      virtual void Visit(ArrayDecl& stmt) override {
+        arrays.insert(stmt.name.value);
+        ShaderPass::Visit(stmt);
+      }
+
+      virtual void Visit(BlockStmt& stmt) override {
+        blocks.push_back(&stmt);
+        ShaderPass::Visit(stmt);
+      }
+  };
+
+  bool IsAssignmentTo(AstNode* node , std::string_view name , const NameSet& user_functions) {
+    if (node->GetType() != EXPR_STMT) {
+      return false;
+    }
+
+    AstExpr* expr = static_cast<ExprStmt*>(node)->expr;
+    if (expr == nullptr || expr->GetType() != ASSIGN_EXPR) {
+      return false;
+    }
+
+    auto* assign = static_cast<AssignExpr*>(expr);
+    return assign->name.value == name && IsPure(assign->value , user_functions);
+  }
+
+  /**
+   * removes `name` and every assignment to it from blocks if nothing reads it and all of the statements that
+   *   touch it can be dropped without losing a side effect
+   **/
+  bool StripVariable(std::string_view name , const std::vector<BlockStmt*>& blocks , const std::vector<VarDecl*>& decls ,
+                     uint32_t writes , const NameSet& user_functions) {
+    for (auto* decl : decls) {
+      if (decl->initializer != nullptr && !IsPure(decl->initializer , user_functions)) {
+        return false;
+      }
+    }
+
+    uint32_t removable_writes = 0;
+    for (auto* block : blocks) {
+      for (auto* s : block->statements) {
+        removable_writes += IsAssignmentTo(s , name , user_functions) ? 1 : 0;
+      }
+    }
+
+    if (removable_writes != writes) {
+      return false;
+    }
+
+    for (auto* block : blocks) {
+      EraseNodes(block->statements , [&](AstNode* node) -> bool {
+        return (node->GetType() == VAR_DECL_STMT && DeclName(node) == name) ||
+               IsAssignmentTo(node , name , user_functions);
+      });
+    }
+    return true;
+  }
+
+  struct Numeric {
+    bool is_float = false;
+    int64_t i = 0;
+    float f = 0.f;
+  };
+
+  Opt<Numeric> ParseNumeric(const AstExpr* expr) {
+    if (expr == nullptr || expr->GetType() != LITERAL_EXPR) {
+      return std::nullopt;
+    }
+
+    const Token& tok = static_cast<const LiteralExpr*>(expr)->value;
+    std::string_view text = tok.value;
+
+    Numeric num;
+    if (tok.type == INT_LIT) {
+      auto [ptr , ec] = std::from_chars(text.data() , text.data() + text.size() , num.i);
+      if (ec != std::errc{} || ptr != text.data() + text.size()) {
+        return std::nullopt;
+      }
+      return num;
+    }
+
+    if (tok.type == FLOAT_LIT) {
+      if (text.ends_with('f') || text.ends_with('F')) {
+        text.remove_suffix(1);
+      }
+
+      double value = 0.0;
+      auto [ptr , ec] = std::from_chars(text.data() , text.data() + text.size() , value);
+      if (ec != std::errc{} || ptr != text.data() + text.size()) {
+        return std::nullopt;
+      }
+
+      num.is_float = true;
+      num.f = static_cast<float>(value);
+      return num;
+    }
+
+    return std::nullopt;
+  }
+
+  float AsFloat(const Numeric& num) {
+    return num.is_float ? num.f : static_cast<float>(num.i);
+  }
+
+  class ConstantFolder : public ShaderPass {
+    public:
+      using ShaderPass::Visit;
+
+      ConstantFolder(ShaderArena& arena , ShaderOptimizerStats& stats , const NameMap<LiteralExpr*>& constants)
+        : arena(arena) , stats(stats) , constants(constants) {}
+
+      virtual void Visit(VarExpr& expr) override {
+        auto itr = constants.find(expr.name.value);
+        if (itr != constants.end()) {
+          replacement = itr->second;
+          ++stats.folded_constants;
+        }
+      }
+
+      virtual void Visit(GroupingExpr& expr) override {
+        ShaderPass::Visit(expr);
+        if (expr.expr != nullptr && expr.expr->GetType() == LITERAL_EXPR) {
+          replacement = expr.expr;
+        }
+      }
+
+      virtual void Visit(UnaryExpr& expr) override {
+        ShaderPass::Visit(expr);
+
+        Opt<Numeric> value = ParseNumeric(expr.right);
+        if (!value.has_value()) {
+          return;
+        }
+
+        if (expr.op.type == PLUS) {
+          replacement = expr.right;
+        } else if (expr.op.type == MINUS) {
+          if (value->is_float) {
+            replacement = FloatLiteral(expr.op , -value->f);
+          } else if (value->i != std::numeric_limits<int32_t>::min()) {
+            replacement = IntLiteral(expr.op , -value->i);
+          }
+        }
+
+        if (replacement != nullptr) {
+          ++stats.folded_constants;
+        }
+      }
+
+      virtual void Visit(BinaryExpr& expr) override {
+        ShaderPass::Visit(expr);
+
+        Opt<Numeric> lhs = ParseNumeric(expr.left);
+        Opt<Numeric> rhs = ParseNumeric(expr.right);
+        if (!lhs.has_value() || !rhs.has_value()) {
+          return;
+        }
+
+        /// glsl promotes the int operand of a mixed expression to float
+        if (lhs->is_float || rhs->is_float) {
+          replacement = FoldFloat(expr.op , AsFloat(*lhs) , AsFloat(*rhs));
+        } else {
+          replacement = FoldInt(expr.op , lhs->i , rhs->i);
+        }
+
+        if (replacement != nullptr) {
+          ++stats.folded_constants;
+        }
+      }
+
+    private:
+      ShaderArena& arena;
+      ShaderOptimizerStats& stats;
+      const NameMap<LiteralExpr*>& constants;
+
+      LiteralExpr* FloatLiteral(const Token& at , float value) {
+        /// shortest text that round trips, it must still read as a float literal
+        std::string text = fmtstr("{}" , value);
+        if (text.find_first_of(".e") == std::string::npos) {
+          text += ".0";
+        }
+        return arena.New<LiteralExpr>(Token(at.location , FLOAT_LIT , arena.Intern(text)));
+      }
+
+      LiteralExpr* IntLiteral(const Token& at , int64_t value) {
+        return arena.New<LiteralExpr>(Token(at.location , INT_LIT , arena.Intern(fmtstr("{}" , value))));
+      }
+
+      AstExpr* FoldFloat(const Token& op , float lhs , float rhs) {
+        float value = 0.f;
+        switch (op.type) {
+          case PLUS: value = lhs + rhs; break;
+          case MINUS: value = lhs - rhs; break;
+          case STAR: value = lhs * rhs; break;
+          case F_SLASH:
+            if (rhs == 0.f) {
+              return nullptr;
+            }
+            value = lhs / rhs;
+            break;
+          default:
+            return nullptr;
+        }
+
+        if (!std::isfinite(value)) {
+          return nullptr;
+        }
+        return FloatLiteral(op , value);
+      }
+
+      AstExpr* FoldInt(const Token& op , int64_t lhs , int64_t rhs) {
+        int64_t value = 0;
+        switch (op.type) {
+          case PLUS: value = lhs + rhs; break;
+          case MINUS: value = lhs - rhs; break;
+          case STAR: value = lhs * rhs; break;
+          case F_SLASH:
+            /// rounding of negative integer division is implementation defined in glsl
+            if (rhs <= 0 || lhs < 0) {
+              return nullptr;
+            }
+            value = lhs / rhs;
+            break;
+          default:
+            return nullptr;
+        }
+
+        if (value < std::numeric_limits<int32_t>::min() || value > std::numeric_limits<int32_t>::max()) {
+          return nullptr;
+        }
+        return IntLiteral(op , value);
+      }
+  };
+
+  /// counts every declaration of a name in a stage, propagation is only safe for names that are never shadowed
+  class DeclCounter : public ShaderPass {
+    public:
+      using ShaderPass::Visit;
+
+      NameMap<uint32_t> counts;
+      std::vector<VarDecl*> constants;
+
+      virtual void Visit(VarDecl& stmt) override {
+        ++counts[stmt.name.value];
+        if (stmt.is_const) {
+          constants.push_back(&stmt);
+        }
+        ShaderPass::Visit(stmt);
+      }
+
+      virtual void Visit(ArrayDecl& stmt) override {
+        ++counts[stmt.name.value];
+        ShaderPass::Visit(stmt);
+      }
+
+      virtual void Visit(FunctionStmt& stmt) override {
+        ++counts[stmt.name.value];
+        for (const auto& p : stmt.params) {
+          ++counts[p.name.value];
+        }
+        ShaderPass::Visit(stmt);
+      }
+
+      virtual void Visit(LayoutVarDecl& stmt) override {
+        if (stmt.name.has_value()) {
+          ++counts[stmt.name->value];
+        }
+      }
+
+      virtual void Visit(InOutBlockStmt& stmt) override {
+        ++counts[stmt.name.value];
+        ShaderPass::Visit(stmt);
+      }
+  };
+
+  void FoldConstants(Stage& stage , ShaderArena& arena , ShaderOptimizerStats& stats) {
+    NameMap<LiteralExpr*> constants;
+
+    /// first sweep folds the initializers of constants so they can be propagated by the second
+    ConstantFolder folder(arena , stats , constants);
+    ForEachGlobal(stage , [&](AstNode* node) {
+      folder.Walk(node);
+    });
+
+    DeclCounter decls;
+    ForEachGlobal(stage , [&](AstNode* node) {
+      decls.Walk(node);
+    });
+
+    for (auto* decl : decls.constants) {
+      std::string_view name = decl->name.value;
+      if (decl->initializer == nullptr || decl->initializer->GetType() != LITERAL_EXPR ||
+          decls.counts[name] != 1 || IsBuiltin(name)) {
+        continue;
+      }
+
+      /// `const float x = 2` can not be substituted, `x / 3` would become integer division
+      auto* literal = static_cast<LiteralExpr*>(decl->initializer);
+      if ((literal->value.type == FLOAT_LIT && decl->type.value == "float") ||
+          (literal->value.type == INT_LIT && decl->type.value == "int")) {
+        constants[name] = literal;
+      }
+    }
+
+    if (!constants.empty()) {
+      ForEachGlobal(stage , [&](AstNode* node) {
+        folder.Walk(node);
+      });
+    }
+  }
+
+  struct TypeEnv {
+    NameMap<std::string_view> vars;
+    NameMap<std::string_view> arrays;
+
+    /// a name declared with two different types is ambiguous, expressions that use it are not hoisted
+    static void Declare(NameMap<std::string_view>& map , std::string_view name , std::string_view type) {
+      auto [itr , inserted] = map.try_emplace(name , type);
+      if (!inserted && itr->second != type) {
+        itr->second = {};
+      }
+    }
+  };
+
+  std::string_view InferType(AstExpr* expr , const TypeEnv& env);
+
+  uint32_t VectorSize(std::string_view type) {
+    for (uint32_t i = 1; i < kVectorTypes.size(); ++i) {
+      if (kVectorTypes[i] == type) {
+        return i;
+      }
+    }
+    return 0;
+  }
+
+  bool IsMatrix(std::string_view type) {
+    return type == "mat2" || type == "mat3" || type == "mat4";
+  }
+
+  std::string_view SwizzleType(std::string_view obj_type , std::string_view swizzle) {
+    uint32_t size = VectorSize(obj_type);
+    if (size < 2 || swizzle.empty() || swizzle.size() >= kVectorTypes.size()) {
+      return {};
+    }
+
+    for (std::string_view set : { "xyzw" , "rgba" , "stpq" }) {
+      bool valid = std::all_of(swizzle.begin() , swizzle.end() , [&](char c) -> bool {
+        size_t idx = set.find(c);
+        return idx != std::string_view::npos && idx < size;
+      });
+
+      if (valid) {
+        return kVectorTypes[swizzle.size()];
+      }
+    }
+    return {};
+  }
+
+  std::string_view ArithmeticType(const Token& op , std::string_view lhs , std::string_view rhs) {
+    if (lhs.empty() || rhs.empty()) {
+      return {};
+    }
+
+    if (lhs == rhs) {
+      return lhs;
+    }
+
+    if ((lhs == "int" && rhs == "float") || (lhs == "float" && rhs == "int")) {
+      return "float";
+    }
+
+    if (lhs == "float" && (VectorSize(rhs) > 1 || IsMatrix(rhs))) {
+      return rhs;
+    }
+
+    if (rhs == "float" && (VectorSize(lhs) > 1 || IsMatrix(lhs))) {
+      return lhs;
+    }
+
+    /// matN * vecN and vecN * matN
+    if (op.type == STAR && IsMatrix(lhs) && VectorSize(rhs) == static_cast<uint32_t>(lhs.back() - '0')) {
+      return rhs;
+    }
+
+    if (op.type == STAR && IsMatrix(rhs) && VectorSize(lhs) == static_cast<uint32_t>(rhs.back() - '0')) {
+      return lhs;
+    }
+
+    return {};
+  }
+
+  std::string_view InferType(AstExpr* expr , const TypeEnv& env) {
+    if (expr == nullptr) {
+      return {};
+    }
+
+    switch (expr->GetType()) {
+      case LITERAL_EXPR: {
+        TokenType type = static_cast<LiteralExpr*>(expr)->value.type;
+        return type == FLOAT_LIT ?
+          std::string_view{ "float" } : type == INT_LIT ?
+            std::string_view{ "int" } : std::string_view{};
+      }
+      case VAR_EXPR:
+        return Lookup(env.vars , static_cast<VarExpr*>(expr)->name.value);
+      case GROUPING_EXPR:
+        return InferType(static_cast<GroupingExpr*>(expr)->expr , env);
+      case UNARY_EXPR:
+        return InferType(static_cast<UnaryExpr*>(expr)->right , env);
+      case BINARY_EXPR: {
+        auto* binary = static_cast<BinaryExpr*>(expr);
+        if (binary->op.type != PLUS && binary->op.type != MINUS && binary->op.type != STAR && binary->op.type != F_SLASH) {
+          return {};
+        }
+        return ArithmeticType(binary->op , InferType(binary->left , env) , InferType(binary->right , env));
+      }
+      case ARRAY_ACCESS_EXPR: {
+        auto* access = static_cast<ArrayAccessExpr*>(expr);
+        if (access->array->GetType() == VAR_EXPR) {
+          std::string_view element = Lookup(env.arrays , static_cast<VarExpr*>(access->array)->name.value);
+          if (!element.empty()) {
+            return element;
+          }
+        }
+
+        std::string_view type = InferType(access->array , env);
+        if (VectorSize(type) > 1) {
+          return "float";
+        }
+        return IsMatrix(type) ? kVectorTypes[type.back() - '0'] : std::string_view{};
+      }
+      case OBJ_ACCESS_EXPR: {
+        auto* access = static_cast<ObjAccessExpr*>(expr);
+        if (access->index != nullptr || access->assignment != nullptr) {
+          return {};
+        }
+
+        std::string_view obj_type = InferType(access->obj , env);
+        auto itr = kBuiltinStructs.find(obj_type);
+        if (itr != kBuiltinStructs.end()) {
+          return Lookup(itr->second , access->member.value);
+        }
+        return SwizzleType(obj_type , access->member.value);
+      }
+      case CALL_EXPR: {
+        auto* call = static_cast<CallExpr*>(expr);
+        std::string_view callee = CalleeName(*call);
+        if (kGenTypeFunctions.contains(callee) && !call->args.empty()) {
+          return InferType(call->args.front() , env);
+        }
+        return Lookup(kFixedTypeFunctions , callee);
+      }
+      default:
+        return {};
+    }
+  }
+
+  /// collects the slot of every expression in a statement so occurrences can be swapped in place
+  class SlotCollector : public ShaderPass {
+    public:
+      using ShaderPass::Visit;
+
+      std::vector<AstExpr**> slots;
+
+    protected:
+      virtual void Rewrite(AstExpr*& slot) override {
+        if (slot != nullptr) {
+          slots.push_back(&slot);
+        }
+        ShaderPass::Rewrite(slot);
+      }
+  };
+
+  bool IsCompound(AstNode* node) {
+    switch (node->GetType()) {
+      case BLOCK_STMT:
+      case IF_STMT:
+      case WHILE_STMT:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  /**
+   * hoists pure expressions that are evaluated more than once in a block into a local declared right before the
+   *   first statement that uses them
+   *
+   * an occurrence may sit inside a nested if/loop, in that case nothing in the nested statement may write to what
+   *   the expression reads, which also makes hoisting out of a loop loop-invariant code motion
+   **/
+  class CseHoister : public ShaderPass {
+    public:
+      using ShaderPass::Visit;
+
+      CseHoister(ShaderArena& arena , ShaderOptimizerStats& stats , const NameSet& user_functions , const TypeEnv& globals ,
+                 uint32_t& next_temp)
+        : arena(arena) , stats(stats) , user_functions(user_functions) , globals(globals) , next_temp(next_temp) {}
+
+      virtual void Visit(FunctionStmt& stmt) override {
+        env = globals;
+        for (const auto& p : stmt.params) {
+          TypeEnv::Declare(env.vars , p.name.value , p.type.value);
+        }
+
+        DeclCollector decls;
+        decls.Walk(stmt.body);
+        for (const auto& [name , list] : decls.vars) {
+          for (auto* decl : list) {
+            TypeEnv::Declare(env.vars , name , decl->type.value);
+          }
+        }
+
+        ShaderPass::Visit(stmt);
+      }
+
+      virtual void Visit(BlockStmt& stmt) override {
+        /// inner blocks first so an expression is hoisted no further out than it has to be
+        ShaderPass::Visit(stmt);
+
+        NameSet rejected;
+        while (HoistOne(stmt , rejected)) {}
+      }
+
+    private:
+      ShaderArena& arena;
+      ShaderOptimizerStats& stats;
+      const NameSet& user_functions;
+      const TypeEnv& globals;
+      uint32_t& next_temp;
+
+      TypeEnv env;
+
+      struct Occurrence {
+        size_t stmt_idx;
+        AstExpr** slot;
+      };
+
+      bool IsCandidate(AstExpr* expr) {
+        if (expr->GetType() == BINARY_EXPR) {
+          TokenType op = static_cast<BinaryExpr*>(expr)->op.type;
+          if (op != PLUS && op != MINUS && op != STAR && op != F_SLASH) {
+            return false;
+          }
+        } else if (expr->GetType() != CALL_EXPR) {
+          return false;
+        }
+
+        return IsPure(expr , user_functions);
+      }
+
+      std::string Key(AstExpr* expr) {
+        std::stringstream ss;
+        expr->Stream(ss , *this);
+        return ss.str();
+      }
+
+      bool HoistOne(BlockStmt& block , NameSet& rejected) {
+        /// ordered by key so the scan below is deterministic
+        std::map<std::string , std::vector<Occurrence>> groups;
+        for (size_t i = 0; i < block.statements.size(); ++i) {
+          SlotCollector collector;
+          collector.Walk(block.statements[i]);
+
+          for (auto* slot : collector.slots) {
+            if (IsCandidate(*slot)) {
+              groups[Key(*slot)].push_back({ i , slot });
+            }
+          }
+        }
+
+        std::vector<std::pair<const std::string* , std::vector<Occurrence>*>> repeated;
+        for (auto& [key , occurrences] : groups) {
+          if (occurrences.size() > 1 && !rejected.contains(key)) {
+            repeated.push_back({ &key , &occurrences });
+          }
+        }
+
+        /// the largest repeated expression first, its own subexpressions are covered by the same temporary
+        std::stable_sort(repeated.begin() , repeated.end() , [](const auto& a , const auto& b) -> bool {
+          return a.first->size() > b.first->size();
+        });
+
+        for (auto& [key , occurrences] : repeated) {
+          if (TryHoist(block , *occurrences)) {
+            return true;
+          }
+          rejected.insert(arena.Intern(*key));
+        }
+
+        return false;
+      }
+
+      bool TryHoist(BlockStmt& block , std::vector<Occurrence>& occurrences) {
+        AstExpr* expr = *occurrences.front().slot;
+
+        UsageCounter usage;
+        usage.Walk(expr);
+        if (usage.reads.empty()) {
+          return false;
+        }
+
+        size_t first = occurrences.front().stmt_idx;
+        size_t last = occurrences.back().stmt_idx;
+
+        WriteCollector writes(user_functions);
+        for (size_t i = first; i < last; ++i) {
+          writes.Walk(block.statements[i]);
+        }
+        if (IsCompound(block.statements[last])) {
+          writes.Walk(block.statements[last]);
+        }
+
+        for (const auto& [name , _] : usage.reads) {
+          if (writes.names.contains(name)) {
+            return false;
+          }
+        }
+
+        std::string_view type = InferType(expr , env);
+        if (type.empty()) {
+          return false;
+        }
+
+        std::string_view name = arena.Intern(fmtstr("oe_cse_{}" , next_temp++));
+        TokenType type_kind = KeywordFromHash(FNV(type));
+        Token type_token({} , type_kind == INVALID_TOKEN ? IDENTIFIER : type_kind , type);
+        Token name_token({} , IDENTIFIER , name);
+
+        for (auto& occ : occurrences) {
+          *occ.slot = arena.New<VarExpr>(name_token);
+        }
+
+        VarDecl* temp = arena.New<VarDecl>(type_token , name_token , expr);
+        block.statements.insert(block.statements.begin() + first , temp);
+        TypeEnv::Declare(env.vars , name , type);
+
+        ++stats.hoisted_expressions;
+        return true;
+      }
+  };
+
+  TypeEnv StageTypes(Stage& stage) {
+    TypeEnv env;
+    env.vars = kBuiltinVariables;
+    env.arrays = kBuiltinArrays;
+
+    ForEachGlobal(stage , [&](AstNode* node) {
+      AstNode* decl = node;
+      if (decl->GetType() == UNIFORM_DECL_STMT) {
+        decl = static_cast<UniformDecl*>(decl)->var_decl;
+      } else if (decl->GetType() == LAYOUT_DECL_STMT) {
+        decl = static_cast<LayoutDecl*>(decl)->data;
+      }
+
+      switch (decl->GetType()) {
+        case VAR_DECL_STMT: {
+          auto* var = static_cast<VarDecl*>(decl);
+          TypeEnv::Declare(env.vars , var->name.value , var->type.value);
+        } break;
+        case ARRAY_DECL_STMT: {
+          auto* arr = static_cast<ArrayDecl*>(decl);
+          TypeEnv::Declare(env.arrays , arr->name.value , arr->type.value);
+        } break;
+        case LAYOUT_VAR_DECL_STMT: {
+          auto* var = static_cast<LayoutVarDecl*>(decl);
+          if (var->type.has_value() && var->name.has_value()) {
+            TypeEnv::Declare(env.vars , var->name->value , var->type->value);
+          }
+        } break;
+        default:
+          break;
+      }
+    });
+
+    return env;
+  }
+
+  void HoistCommonSubexpressions(Stage& stage , ShaderArena& arena , ShaderOptimizerStats& stats , uint32_t& next_temp) {
+    NameSet user_functions = FunctionNames(stage);
+    TypeEnv globals = StageTypes(stage);
+
+    CseHoister hoister(arena , stats , user_functions , globals , next_temp);
+    ForEachGlobal(stage , [&](AstNode* node) {
+      if (node->GetType() == FUNCTION_STMT) {
+        hoister.Walk(node);
+      }
+    });
+  }
+
+  bool StripFunctions(Stage& stage , const NameSet& user_functions , ShaderOptimizerStats& stats) {
+    if (!user_functions.contains("main")) {
+      return false;
+    }
+
+    NameMap<NameSet> callees;
+    NameSet live = { "main" };
+    std::vector<std::string_view> pending = { "main" };
+
+    ForEachGlobal(stage , [&](AstNode* node) {
+      UsageCounter usage;
+      usage.Walk(node);
+
+      for (const auto& [name , _] : usage.reads) {
+        if (!user_functions.contains(name)) {
+          continue;
+        }
+
+        /// anything outside of a function body (global initializers) is always evaluated
+        if (node->GetType() == FUNCTION_STMT) {
+          callees[DeclName(node)].insert(name);
+        } else if (live.insert(name).second) {
+          pending.push_back(name);
+        }
+      }
+    });
+
+    while (!pending.empty()) {
+      std::string_view fn = pending.back();
+      pending.pop_back();
+
+      for (auto callee : callees[fn]) {
+        if (live.insert(callee).second) {
+          pending.push_back(callee);
+        }
+      }
+    }
+
+    uint32_t erased = EraseGlobals(stage , [&](AstNode* node) -> bool {
+      return node->GetType() == FUNCTION_STMT && !live.contains(DeclName(node));
+    });
+
+    stats.stripped_functions += erased;
+    return erased > 0;
+  }
+
+  bool StripLocals(FunctionStmt& fn , const NameSet& global_names , const NameSet& user_functions , ShaderOptimizerStats& stats) {
+    UsageCounter usage;
+    usage.Walk(fn.body);
+
+    DeclCollector decls;
+    decls.Walk(fn.body);
+
+    NameSet params;
+    for (const auto& p : fn.params) {
+      params.insert(p.name.value);
+    }
+
+    bool changed = false;
+    for (const auto& [name , list] : decls.vars) {
+      if (Lookup(usage.reads , name) > 0 || params.contains(name) || global_names.contains(name) ||
+          decls.arrays.contains(name) || IsBuiltin(name)) {
+        continue;
+      }
+
+      if (StripVariable(name , decls.blocks , list , Lookup(usage.writes , name) , user_functions)) {
+        ++stats.stripped_variables;
+        changed = true;
+      }
+    }
+
+    return changed;
+  }
+
+  bool EliminateDeadCode(Stage& stage , ShaderOptimizerStats& stats , std::vector<std::string>& stripped_uniforms) {
+    NameSet user_functions = FunctionNames(stage);
+    bool changed = StripFunctions(stage , user_functions , stats);
+
+    UsageCounter usage;
+    NameSet global_names;
+    ForEachGlobal(stage , [&](AstNode* node) {
+      usage.Walk(node);
+      if (node->GetType() != FUNCTION_STMT) {
+        global_names.insert(DeclName(node));
+      }
+    });
+
+    uint32_t erased = EraseGlobals(stage , [&](AstNode* node) -> bool {
+      std::string_view name = DeclName(node);
+      if (name.empty() || Lookup(usage.reads , name) > 0) {
+        return false;
+      }
+
+      if (node->GetType() == UNIFORM_DECL_STMT) {
+        stripped_uniforms.emplace_back(name);
+        return true;
+      }
+
+      if (node->GetType() == VAR_DECL_STMT) {
+        auto* var = static_cast<VarDecl*>(node);
+        if (Lookup(usage.writes , name) == 0 && (var->initializer == nullptr || IsPure(var->initializer , user_functions))) {
+          ++stats.stripped_variables;
+          return true;
+        }
+      }
+
+      return false;
+    });
+    changed = changed || erased > 0;
+
+    ForEachGlobal(stage , [&](AstNode* node) {
+      if (node->GetType() == FUNCTION_STMT) {
+        changed = StripLocals(*static_cast<FunctionStmt*>(node) , global_names , user_functions , stats) || changed;
+      }
+    });
+
+    return changed;
+  }
+
+  bool IsVarying(AstNode* node , TokenType direction) {
+    if (node->GetType() != LAYOUT_VAR_DECL_STMT) {
+      return false;
+    }
+
+    auto* var = static_cast<LayoutVarDecl*>(node);
+    return var->in_out.type == direction && var->name.has_value();
+  }
+
+  /// fragment inputs nothing reads, then vertex outputs with no matching fragment input and the writes that feed them
+  bool StripVaryings(Stage& vertex , Stage& fragment , ShaderOptimizerStats& stats) {
+    UsageCounter frag_usage;
+    ForEachGlobal(fragment , [&](AstNode* node) {
+      frag_usage.Walk(node);
+    });
+
+    uint32_t erased = EraseGlobals(fragment , [&](AstNode* node) -> bool {
+      return IsVarying(node , IN_KW) && Lookup(frag_usage.reads , DeclName(node)) == 0;
+    });
+
+    NameSet frag_inputs;
+    ForEachGlobal(fragment , [&](AstNode* node) {
+      if (IsVarying(node , IN_KW)) {
+        frag_inputs.insert(DeclName(node));
+      }
+    });
+
+    NameSet user_functions = FunctionNames(vertex);
+    UsageCounter vert_usage;
+    DeclCollector vert_decls;
+    ForEachGlobal(vertex , [&](AstNode* node) {
+      vert_usage.Walk(node);
+      if (node->GetType() == FUNCTION_STMT) {
+        vert_decls.Walk(node);
+      }
+    });
+
+    NameSet dead_outputs;
+    ForEachGlobal(vertex , [&](AstNode* node) {
+      std::string_view name = DeclName(node);
+      if (!IsVarying(node , OUT_KW) || frag_inputs.contains(name) || Lookup(vert_usage.reads , name) > 0) {
+        return;
+      }
+
+      if (StripVariable(name , vert_decls.blocks , {} , Lookup(vert_usage.writes , name) , user_functions)) {
+        dead_outputs.insert(name);
+      }
+    });
+
+    erased += EraseGlobals(vertex , [&](AstNode* node) -> bool {
+      return IsVarying(node , OUT_KW) && dead_outputs.contains(DeclName(node));
+    });
+
+    stats.stripped_varyings += erased;
+    return erased > 0;
+  }
+
+} // anonymous namespace
+
+  ShaderOptimizerStats ShaderOptimizer::Optimize() {
+    ShaderOptimizerStats stats;
+    if (ast.arena == nullptr) {
+      return stats;
+    }
+
+    std::vector<Stage> stages;
+    Opt<size_t> vertex_idx = std::nullopt;
+    Opt<size_t> fragment_idx = std::nullopt;
+
+    if (!ast.vertex_nodes.empty()) {
+      vertex_idx = stages.size();
+      stages.push_back({ VERTEX_SHADER , ast.vertex_nodes });
+    }
+
+    if (!ast.fragment_nodes.empty()) {
+      fragment_idx = stages.size();
+      stages.push_back({ FRAGMENT_SHADER , ast.fragment_nodes });
+    }
+
+    if (!ast.geometry_nodes.empty()) {
+      stages.push_back({ GEOMETRY_SHADER , ast.geometry_nodes });
+    }
+
+    uint32_t next_temp = 0;
+    for (auto& stage : stages) {
+      FoldConstants(stage , *ast.arena , stats);
+      HoistCommonSubexpressions(stage , *ast.arena , stats , next_temp);
+    }
+
+    /// a geometry stage sits between vertex and fragment so their interfaces can not be matched directly
+    const bool match_varyings = ast.type == OTHER_SHADER && vertex_idx.has_value() &&
+                                fragment_idx.has_value() && ast.geometry_nodes.empty();
+
+    std::vector<std::string> stripped_uniforms;
+    bool changed = true;
+    for (uint32_t i = 0; changed && i < kMaxDcePasses; ++i) {
+      changed = false;
+      for (auto& stage : stages) {
+        changed = EliminateDeadCode(stage , stats , stripped_uniforms) || changed;
+      }
+
+      if (match_varyings) {
+        changed = StripVaryings(stages[*vertex_idx] , stages[*fragment_idx] , stats) || changed;
+      }
+    }
+
+    /// a uniform that is still read by another stage stays bound
+    NameSet remaining;
+    for (auto& stage : stages) {
+      ForEachGlobal(stage , [&](AstNode* node) {
+        if (node->GetType() == UNIFORM_DECL_STMT) {
+          remaining.insert(DeclName(node));
+        }
+      });
+    }
+
+    for (const auto& name : stripped_uniforms) {
+      if (!remaining.contains(name) &&
+          std::find(stats.stripped_uniforms.begin() , stats.stripped_uniforms.end() , name) == stats.stripped_uniforms.end()) {
+        stats.stripped_uniforms.push_back(name);
+      }
+    }
+
+    OE_DEBUG("Shader optimizer : {} folded , {} hoisted , {} functions , {} variables , {} varyings , {} uniforms stripped" ,
+             stats.folded_constants , stats.hoisted_expressions , stats.stripped_functions , stats.stripped_variables ,
+             stats.stripped_varyings , stats.stripped_uniforms.size());
+
+    return stats;
+  }
+
+} // namespace other
@@ -0,0 +1,99 @@
+/**
+ * \file parsing/shader_optimizer.hpp
+ **/
+#ifndef OTHER_ENGINE_SHADER_OPTIMIZER_HPP
+#define OTHER_ENGINE_SHADER_OPTIMIZER_HPP
+
+#include <string>
+#include <vector>
+
+#include "parsing/ast_node.hpp"
+#include "parsing/shader_parser.hpp"
+
+namespace other {
+
+  struct ShaderOptimizerStats {
+    uint32_t folded_constants = 0;
+    uint32_t hoisted_expressions = 0;
+    uint32_t stripped_functions = 0;
+    uint32_t stripped_variables = 0;
+    uint32_t stripped_varyings = 0;
+
+    /// uniforms that no stage reads anymore, they are also missing from ShaderIr::uniforms after transpilation
+    std::vector<std::string> stripped_uniforms;
+  };
+
+  /**
+   * base for passes that rewrite a ShaderAst in place
+   *
+   * every Visit recurses into the node's children by default, expression children go through Rewrite so a pass can
+   *   swap out the node it is visiting by setting replacement before returning
+   **/
+  class ShaderPass : public TreeWalker {
+    public:
+      virtual ~ShaderPass() override = default;
+
+      void Walk(AstNode* node);
+
+      // Expressions
+      virtual void Visit(LiteralExpr& expr) override;
+      virtual void Visit(UnaryExpr& expr) override;
+      virtual void Visit(BinaryExpr& expr) override;
+      virtual void Visit(CallExpr& expr) override;
+      virtual void Visit(GroupingExpr& expr) override;
+      virtual void Visit(VarExpr& expr) override;
+      virtual void Visit(AssignExpr& expr) override;
+      virtual void Visit(ArrayExpr& expr) override;
+      virtual void Visit(ArrayAccessExpr& expr) override;
+      virtual void Visit(ObjAccessExpr& expr) override;
+
+      // Statements
+      virtual void Visit(ExprStmt& stmt) override;
+      virtual void Visit(VarDecl& stmt) override;
+      virtual void Visit(ArrayDecl& stmt) override;
+      virtual void Visit(BlockStmt& stmt) override;
+      virtual void Visit(IfStmt& stmt) override;
+      virtual void Visit(WhileStmt& stmt) override;
+      virtual void Visit(ReturnStmt& stmt) override;
+      virtual void Visit(FunctionStmt& stmt) override;
+      virtual void Visit(StructStmt& stmt) override;
+
+      virtual void Visit(LayoutDescriptor& expr) override;
+
+      virtual void Visit(LayoutDecl& stmt) override;
+      virtual void Visit(ShaderStorageStmt& stmt) override;
+      virtual void Visit(InOutBlockStmt& stmt) override;
+      virtual void Visit(UniformDecl& stmt) override;
+
+      virtual void Visit(ShaderDecl& stmt) override;
+
+    protected:
+      AstExpr* replacement = nullptr;
+
+      virtual void Rewrite(AstExpr*& slot);
+  };
+
+  /**
+   * runs between the parser and the transpiler:
+   *
+   *  - constant folding of numeric literals and propagation of literal `const` scalars
+   *  - hoisting of pure subexpressions that are computed more than once in a block into a local
+   *  - stripping of unreachable functions, unread variables and uniforms and varyings the next stage never reads
+   *
+   * the passes never touch layout declarations, storage blocks or anything the transpiler injects, so the mesh
+   *   layout and bindings in the resulting ShaderIr are the same with or without optimization
+   **/
+  class ShaderOptimizer {
+    public:
+      ShaderOptimizer(ShaderAst& ast)
+        : ast(ast) {}
+
+      ShaderOptimizerStats Optimize();
+
+    private:
+      ShaderAst& ast;
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_SHADER_OPTIMIZER_HPP
@@ -3,6 +3,8 @@
  **/
 #include "parsing/shader_parser.hpp"
 
+#include <charconv>
+
 #include "core/errors.hpp"
 #include "core/logger.hpp"
 
@@ -25,7 +27,7 @@ namespace other {
         break;
       }
 
-      Ref<AstStmt> s = ParseDecl();
+      AstStmt* s = ParseDecl();
       if (s != nullptr) {
         AddTopLevelNode(s);
       } else {
@@ -35,7 +37,7 @@ namespace other {
 
     Consume(END_SRC , "Expected End of File");
 
-    return result; 
+    return std::move(result); 
   }
       
   ShaderType ShaderParser::GetCurrentShaderType() {
@@ -54,7 +56,7 @@ namespace other {
     throw Error(INVALID_SHADER_TYPE , "Parser State is corrupted!");
   }
 
-  Ref<AstStmt> ShaderParser::ParseDecl() {
+  AstStmt* ShaderParser::ParseDecl() {
     bool no_advance = false;
 
     /// if oshader parse special, otherwise don't do anything
@@ -79,12 +81,12 @@ namespace other {
     }
 
     if (Match({ IDENTIFIER } , false)) {
-      return NewRef<ExprStmt>(ParseExpression());
+      return NewNode<ExprStmt>(ParseExpression());
     }
 
     if (Match({ LAYOUT_KW })) {
       flags.initializer_blocker.push(true);
-      Ref<AstStmt> stmt = ParseLayoutDecl();
+      AstStmt* stmt = ParseLayoutDecl();
       flags.initializer_blocker.pop();
       return stmt;
     }
@@ -110,7 +112,7 @@ namespace other {
       Token type = ConsumeType(fmtstr("Expected type keyword after {}! found {}" , Previous().value , Peek().value));
       Token identifier = Consume(IDENTIFIER , fmtstr("Expected identifier! found {}" , Peek().value));
 
-      return NewRef<LayoutVarDecl>(in_out , type , identifier);
+      return NewNode<LayoutVarDecl>(in_out , type , identifier);
     }
 
     if (Match({ RETURN_KW })) {
@@ -128,8 +130,8 @@ namespace other {
     return ParseStatement();
   }
       
-  Ref<AstStmt> ShaderParser::ParseShaderDecl() {
-    std::vector<Ref<AstExpr>> attributes;
+  AstStmt* ShaderParser::ParseShaderDecl() {
+    std::vector<AstExpr*> attributes;
 
     if (Match({ OPEN_BRACKET })) {
       while (!Match({ CLOSE_BRACKET })) {
@@ -141,10 +143,10 @@ namespace other {
     }
 
     Consume(OPEN_BRACE , "Expected opening brace for shader declaration"); 
-    std::vector<Ref<AstStmt>> stmts;
+    std::vector<AstStmt*> stmts;
 
     while (!Check(CLOSE_BRACE) && !AtEnd()) {
-      Ref<AstStmt> stmt = ParseDecl();
+      AstStmt* stmt = ParseDecl();
       if (stmt != nullptr) {
         stmts.push_back(stmt);
       } else {
@@ -157,21 +159,21 @@ namespace other {
 
     Consume(CLOSE_BRACE , "Expected closing brace to close shader declaration");
 
-    return NewRef<ShaderDecl>(GetCurrentShaderType() , attributes , stmts);
+    return NewNode<ShaderDecl>(GetCurrentShaderType() , attributes , stmts);
   }
 
-  Ref<AstStmt> ShaderParser::ParseLayoutDecl() {
+  AstStmt* ShaderParser::ParseLayoutDecl() {
     Consume(OPEN_PAREN , fmtstr("Expected open parathesis after 'layout'! found {}" , Peek().value));
 
     /// fix this so that the order of the layout descriptors doesn't matter
 
     Token rules = Token({} , INVALID_TOKEN , "");
-    std::vector<Ref<AstExpr>> descriptors;
+    std::vector<AstExpr*> descriptors;
     if (Match({ STDXXX_KW , TRIANGLES_KW , LINE_STRIP_KW })) {
       rules = Previous();
       if (Match({ CLOSE_PAREN })) {
-        Ref<AstStmt> layout = ParseLayoutStmt();
-        return NewRef<LayoutDecl>(rules , descriptors , layout);
+        AstStmt* layout = ParseLayoutStmt();
+        return NewNode<LayoutDecl>(rules , descriptors , layout);
       }
 
       Consume(COMMA , fmtstr("Expected ',' or ')' in layout definition! found {}" , Peek().value));
@@ -186,12 +188,12 @@ namespace other {
 
     Consume(CLOSE_PAREN , "Expected close parathesis after layout descriptor set");
 
-    Ref<AstStmt> layout = ParseLayoutStmt();
+    AstStmt* layout = ParseLayoutStmt();
 
-    return NewRef<LayoutDecl>(rules , descriptors , layout);
+    return NewNode<LayoutDecl>(rules , descriptors , layout);
   }
       
-  Ref<AstStmt> ShaderParser::ParseFunctionDecl(const Token& type , const Token& name) { 
+  AstStmt* ShaderParser::ParseFunctionDecl(const Token& type , const Token& name) { 
     std::vector<FunctionParam> params;
     if (Match({ OPEN_PAREN })) {
       while (!Check(CLOSE_PAREN) && !AtEnd()) {
@@ -205,7 +207,7 @@ namespace other {
       Consume(CLOSE_PAREN , "Expected closing parenthesis for function parameters");
     }
     
-    Ref<AstStmt> body = ParseBlock();
+    AstStmt* body = ParseBlock();
     if (body == nullptr) {
       throw Error(SYNTAX_ERROR , "Expected function body");
     }
@@ -214,23 +216,23 @@ namespace other {
       // do nothing
     }
 
-    return NewRef<FunctionStmt>(name , params , type , body);
+    return NewNode<FunctionStmt>(name , params , type , body);
   }
 
-  Ref<AstStmt> ShaderParser::ParseStructDecl(const Token& name) { 
+  AstStmt* ShaderParser::ParseStructDecl(const Token& name) { 
     OE_DEBUG("Struct decl current token {}" , Peek().value);
     return nullptr; 
   }
 
-  Ref<AstStmt> ShaderParser::ParseUniformDecl() {
+  AstStmt* ShaderParser::ParseUniformDecl() {
     flags.initializer_blocker.push(true);
-    Ref<AstStmt> var = ParseVarDecl();
+    AstStmt* var = ParseVarDecl();
     flags.initializer_blocker.pop();
 
-    return NewRef<UniformDecl>(var);  
+    return NewNode<UniformDecl>(var);  
   }
 
-  Ref<AstStmt> ShaderParser::ParseVarDecl() {
+  AstStmt* ShaderParser::ParseVarDecl() {
     bool is_const = false;
     if (Match({ CONST_KW })) {
       is_const = true;
@@ -240,12 +242,12 @@ namespace other {
     Token identifier = Consume(IDENTIFIER , fmtstr("Expected identifier! found {}" , Peek().value));
 
     /// if initializers are not valid then functions and function calls are not either
-    Ref<AstStmt> initializer;
+    AstExpr* initializer = nullptr;
     if (flags.initializer_blocker.empty()) {
       if (Match({ OPEN_PAREN } , false)) {
         return ParseFunctionDecl(type , identifier);
       } else if (Match({ EQUAL_OP })) {
-        initializer = ParseStatement();
+        initializer = ParseExpression();
       }
     } else if (Match({ OPEN_BRACKET })) {
       return ParseArrayDecl(type , identifier , is_const);
@@ -258,17 +260,17 @@ namespace other {
       is_global = true;
     }
 
-    return NewRef<VarDecl>(type , identifier , initializer , is_const , is_global); 
+    return NewNode<VarDecl>(type , identifier , initializer , is_const , is_global); 
   }
 
-  Ref<AstStmt> ShaderParser::ParseArrayDecl(const Token& type , const Token& name , bool is_const) { 
+  AstStmt* ShaderParser::ParseArrayDecl(const Token& type , const Token& name , bool is_const) { 
     Token size = Token({} , INT_LIT , "");
     if (Match({ INT_LIT })) {
       size = Consume(INT_LIT , fmtstr("Expected integer literal for array size! found {}" , Peek().type));
     } 
     Consume(CLOSE_BRACKET , fmtstr("Expected close bracket after array size! found {}" , Peek().type));
 
-    Ref<AstExpr> initializer = nullptr;
+    AstExpr* initializer = nullptr;
     if (flags.initializer_blocker.empty()) {
       if (Match({ EQUAL_OP })) {
         /// do nothing
@@ -277,16 +279,19 @@ namespace other {
       initializer = ParseArrayExpr(size);
     } 
 
-    return NewRef<ArrayDecl>(type , name , size , initializer , is_const);
+    return NewNode<ArrayDecl>(type , name , size , initializer , is_const);
   }
       
-  Ref<AstStmt> ShaderParser::ParseBufferDecl() {
+  AstStmt* ShaderParser::ParseBufferDecl() {
     Token buff_type = Token({} , INVALID_TOKEN , "");
     if (Match({ READONLY_KW })) {
       Token readonly = Previous();
 
-      buff_type = Consume(BUFFER_KW , fmtstr("Can only make Shader Storage Buffers read only! found {}" , Peek().value));
-      buff_type.value = readonly.value + " " + buff_type.value;
+      Token buffer = Consume(BUFFER_KW , fmtstr("Can only make Shader Storage Buffers read only! found {}" , Peek().value));
+
+      /// qualifiers are streamed as a single token, the merged text only exists in the arena
+      std::string_view merged = result.arena->Intern(fmtstr("{} {}" , readonly.value , buffer.value));
+      buff_type = Token(buffer.location , BUFFER_KW , merged);
     } else {
       if (Match({ UNIFORM_KW , BUFFER_KW } , false)) {
         buff_type = Advance();
@@ -297,23 +302,23 @@ namespace other {
 
     Token identifier = Consume(IDENTIFIER , fmtstr("Expected identifier to name Shader Storage! found {}" , Peek().value));
 
-    Ref<AstStmt> body = ParseBlock();
+    AstStmt* body = ParseBlock();
     // Consume(SEMICOLON , fmtstr("Must close shader storage block with ';'! found {}" , Peek().value));
 
-    return NewRef<ShaderStorageStmt>(buff_type , identifier , body);
+    return NewNode<ShaderStorageStmt>(buff_type , identifier , body);
   }
 
-  Ref<AstStmt> ShaderParser::ParseLayoutStmt() {
+  AstStmt* ShaderParser::ParseLayoutStmt() {
     if (Match({ IN_KW , OUT_KW })) {
       Token in_out = Previous();
       if (Match({ SEMICOLON })) {
-        return NewRef<LayoutVarDecl>(in_out); 
+        return NewNode<LayoutVarDecl>(in_out); 
       }
 
       Token type = ConsumeType(fmtstr("Expected type keyword after {}! found {}" , Previous().value , Peek().value));
       Token identifier = Consume(IDENTIFIER , fmtstr("Expected identifier! found {}" , Peek().value));
 
-      return NewRef<LayoutVarDecl>(in_out , type , identifier);
+      return NewNode<LayoutVarDecl>(in_out , type , identifier);
     }
     
     if (Match({ READONLY_KW , BUFFER_KW , UNIFORM_KW } , false)) {
@@ -323,9 +328,9 @@ namespace other {
     throw Error(SYNTAX_ERROR , fmtstr("Failed to parse layout statement! found {}" , Peek().value));
   }
 
-  Ref<AstStmt> ShaderParser::ParseStatement() { 
+  AstStmt* ShaderParser::ParseStatement() { 
     if (Match({ OPEN_BRACE })) {
-      Ref<AstStmt> block = ParseBlock();
+      AstStmt* block = ParseBlock();
       if (block == nullptr) {
         throw current;
       }
@@ -333,15 +338,14 @@ namespace other {
       return block;
     }
 
-    Ref<ExprStmt> stmt = ParseExpression();
-    return stmt;
+    return NewNode<ExprStmt>(ParseExpression());
   }
 
-  Ref<AstStmt> ShaderParser::ParseInOutBlock(const Token& type , const Token& tag) {
+  AstStmt* ShaderParser::ParseInOutBlock(const Token& type , const Token& tag) {
     bool is_array = false;
 
     flags.initializer_blocker.push(true);
-    Ref<AstStmt> body = ParseBlock();
+    AstStmt* body = ParseBlock();
     flags.initializer_blocker.pop();
 
     Token name = Consume(IDENTIFIER , fmtstr("Expected identifier for {} block {}! found {}" , type.value , tag.value , Peek().value));
@@ -355,17 +359,17 @@ namespace other {
     
     // Consume(SEMICOLON , fmtstr("Expected semicolon after {} block {}! found {}" , type.value , tag.value , Peek().value));
 
-    return NewRef<InOutBlockStmt>(type , tag , name , body , is_array);
+    return NewNode<InOutBlockStmt>(type , tag , name , body , is_array);
   }
 
-  Ref<AstStmt> ShaderParser::ParseBlock() {
+  AstStmt* ShaderParser::ParseBlock() {
     Consume(OPEN_BRACE , "Expected opening brace for function declaration"); 
-    std::vector<Ref<AstStmt>> stmts;
+    std::vector<AstStmt*> stmts;
 
     flags.scoping.push(true);
 
     while (!Check(CLOSE_BRACE) && !AtEnd()) {
-      Ref<AstStmt> stmt = ParseDecl();
+      AstStmt* stmt = ParseDecl();
       if (stmt != nullptr) {
         stmts.push_back(stmt);
       } else {
@@ -381,121 +385,121 @@ namespace other {
     
     flags.scoping.pop();
 
-    return NewRef<BlockStmt>(stmts);
+    return NewNode<BlockStmt>(stmts);
   }
 
-  Ref<AstStmt> ShaderParser::ParseIf() { 
+  AstStmt* ShaderParser::ParseIf() { 
     Consume(OPEN_PAREN , fmtstr("Expected '(' after 'if'! found {}" , Peek().value));
 
-    Ref<AstExpr> expr = ParseExpression();
+    AstExpr* expr = ParseExpression();
     
     Consume(CLOSE_PAREN , fmtstr("Expected ')' after if condition! found {}" , Peek().value));
 
-    Ref<AstStmt> then_stmt = ParseBlock();
+    AstStmt* then_stmt = ParseBlock();
 
-    Ref<AstStmt> else_stmt = nullptr;
+    AstStmt* else_stmt = nullptr;
     if (Match({ ELSE_KW })) {
       else_stmt = ParseDecl();
     }
 
-    return NewRef<IfStmt>(expr , then_stmt , else_stmt);
+    return NewNode<IfStmt>(expr , then_stmt , else_stmt);
   }
 
-  Ref<AstStmt> ShaderParser::ParseWhile() { return nullptr; }
+  AstStmt* ShaderParser::ParseWhile() { return nullptr; }
 
-  Ref<AstStmt> ShaderParser::ParseFor() { 
+  AstStmt* ShaderParser::ParseFor() { 
     Consume(TokenType::OPEN_PAREN , "Expected opening parenthesis after 'for' keyword");
 
-    Ref<AstStmt> initializer = nullptr;
+    AstStmt* initializer = nullptr;
     if (Match({ TokenType::SEMICOLON })) {
       // do nothing
     } else if (Match({ TokenType::IDENTIFIER } , false)) {
       initializer = ParseDecl();
     } else {
-      Ref<AstExpr> expr = ParseExpression();
-      initializer = NewRef<ExprStmt>(expr);
+      AstExpr* expr = ParseExpression();
+      initializer = NewNode<ExprStmt>(expr);
       Consume(TokenType::SEMICOLON , "Expected semicolon after initializer");
     }
 
-    Ref<AstExpr> condition = nullptr;
+    AstExpr* condition = nullptr;
     if (!Check(TokenType::SEMICOLON)) {
       condition = ParseExpression();
     }
     Consume(TokenType::SEMICOLON , "Expected semicolon after loop condition");
 
-    Ref<AstExpr> increment = nullptr;
+    AstExpr* increment = nullptr;
     if (!Check(TokenType::CLOSE_PAREN)) {
       increment = ParseExpression();
     }
     Consume(TokenType::CLOSE_PAREN , "Expected closing parenthesis after for loop");
 
-    Ref<AstStmt> body = ParseBlock();
+    AstStmt* body = ParseBlock();
 
     if (increment != nullptr) {
-      std::vector<Ref<AstStmt>> stmts{ body , NewRef<ExprStmt>(increment) };
-      body = NewRef<BlockStmt>(stmts);
+      std::vector<AstStmt*> stmts{ body , NewNode<ExprStmt>(increment) };
+      body = NewNode<BlockStmt>(stmts);
     }
 
     if (condition == nullptr) {
-      condition = NewRef<LiteralExpr>(Token(Peek().location , TokenType::TRUE_KW , "true"));
+      condition = NewNode<LiteralExpr>(Token(Peek().location , TokenType::TRUE_KW , "true"));
     }
 
-    body = NewRef<WhileStmt>(condition , body);
+    body = NewNode<WhileStmt>(condition , body);
 
     if (initializer != nullptr) {
-      std::vector<Ref<AstStmt>> stmts{ initializer , body };
-      body = NewRef<BlockStmt>(stmts);
+      std::vector<AstStmt*> stmts{ initializer , body };
+      body = NewNode<BlockStmt>(stmts);
     }
 
     return body;
   }
 
-  Ref<AstStmt> ShaderParser::ParseReturn() {
+  AstStmt* ShaderParser::ParseReturn() {
     if (Match({ SEMICOLON })) {
-      return NewRef<ReturnStmt>();
+      return NewNode<ReturnStmt>();
     }
 
-    Ref<ExprStmt> expr = NewRef<ExprStmt>(ParseExpression());
+    ExprStmt* expr = NewNode<ExprStmt>(ParseExpression());
     Consume(SEMICOLON , fmtstr("Expected ';' after return statement! found {}" , Peek().value));
 
-    return NewRef<ReturnStmt>(expr);
+    return NewNode<ReturnStmt>(expr);
   }
       
-  Ref<AstExpr> ShaderParser::ParseShaderAttribute() {
+  AstExpr* ShaderParser::ParseShaderAttribute() {
     if (Match({ MESH_KW })) {
       Token type = Previous();
       Consume(COLON , fmtstr("Expected ':' to define shader attribute! found {}" , Peek().value));
       Token value = Consume(IDENTIFIER , fmtstr("Expected identifier to define shader attribute! found {}" , Peek().value));
-      return NewRef<ShaderAttribute>(type , value); 
+      return NewNode<ShaderAttribute>(type , value); 
     }
 
     throw Error(SYNTAX_ERROR , "Unknown shader attribute! found {}" , Peek().value);
   }
       
-  Ref<AstExpr> ShaderParser::ParseLayoutDescriptor() {
+  AstExpr* ShaderParser::ParseLayoutDescriptor() {
     if (Match({ BINDING_KW , LOCATION_KW , MAX_VERTICES_KW })) {
       Token type = Previous();
       Consume(EQUAL_OP , fmtstr("Expected '=' after layout decsriptor! found {}" , Peek().value));
-      Ref<AstExpr> val = ParseExpression();
-      return NewRef<LayoutDescriptor>(type , val);
+      AstExpr* val = ParseExpression();
+      return NewNode<LayoutDescriptor>(type , val);
     }
     
     throw Error(SYNTAX_ERROR , fmtstr("Expected 'binding' or 'location'! found {}" , Peek().value));
   }
 
-  Ref<AstExpr> ShaderParser::ParseExpression() {
+  AstExpr* ShaderParser::ParseExpression() {
     return ParseAssignment();
   }
 
-  Ref<AstExpr> ShaderParser::ParseAssignment() {
+  AstExpr* ShaderParser::ParseAssignment() {
     auto expr = ParseOr();
 
     if (Match({ EQUAL_OP })) {
       /// Token('=') == Previous()
-      Ref<AstExpr> right = ParseAssignment();
+      AstExpr* right = ParseAssignment();
       if (expr->GetType() == VAR_EXPR) {
-        Ref<VarExpr> var = Ref<AstExpr>::Cast<VarExpr>(expr);
-        return NewRef<AssignExpr>(var->name , right);
+        VarExpr* var = static_cast<VarExpr*>(expr);
+        return NewNode<AssignExpr>(var->name , right);
       }
 
       throw Error(SYNTAX_ERROR , fmtstr("Invalid assignment target {}" , expr->GetType()));
@@ -505,79 +509,79 @@ namespace other {
   }
 
   
-  Ref<AstExpr> ShaderParser::ParseOr() {
+  AstExpr* ShaderParser::ParseOr() {
     auto expr = ParseAnd();
 
     while (Match({ LOGICAL_OR })) {
       Token op = Previous();
-      Ref<AstExpr> right = ParseAnd();
-      expr = NewRef<BinaryExpr>(expr , op , right);
+      AstExpr* right = ParseAnd();
+      expr = NewNode<BinaryExpr>(expr , op , right);
     }
 
     return expr; 
   }
 
-  Ref<AstExpr> ShaderParser::ParseAnd() {
+  AstExpr* ShaderParser::ParseAnd() {
     auto expr = ParseEquality();
     
     while (Match({ TokenType::LOGICAL_AND })) {
       Token op = Previous();
-      Ref<AstExpr> right = ParseEquality();
-      expr = NewRef<BinaryExpr>(expr , op , right);
+      AstExpr* right = ParseEquality();
+      expr = NewNode<BinaryExpr>(expr , op , right);
     }
 
     return expr;
   }
 
-  Ref<AstExpr> ShaderParser::ParseEquality() {
+  AstExpr* ShaderParser::ParseEquality() {
     auto expr = ParseComparison();
 
     while (Match({ BANG_EQUAL , EQUAL_EQUAL })) {
       Token op = Previous();
-      Ref<AstExpr> right = ParseComparison();
-      expr = NewRef<BinaryExpr>(expr , op , right);
+      AstExpr* right = ParseComparison();
+      expr = NewNode<BinaryExpr>(expr , op , right);
     }
 
     return expr;
   }
 
-  Ref<AstExpr> ShaderParser::ParseComparison() {
+  AstExpr* ShaderParser::ParseComparison() {
     auto expr = ParseTerm();
 
     while (Match({ GREATER_OP , GREATER_EQUAL_OP , LESS_OP , LESS_EQUAL_OP })) {
       Token op = Previous();
-      Ref<AstExpr> right = ParseTerm();
-      expr = NewRef<BinaryExpr>(expr , op , right);
+      AstExpr* right = ParseTerm();
+      expr = NewNode<BinaryExpr>(expr , op , right);
     }
 
     return expr;
   }
 
-  Ref<AstExpr> ShaderParser::ParseTerm() {
+  AstExpr* ShaderParser::ParseTerm() {
     auto expr = ParseFactor();
     
     while (Match({ PLUS , MINUS })) {
       Token op = Previous();
-      Ref<AstExpr> right = ParseFactor();
-      expr = NewRef<BinaryExpr>(expr , op , right);
+      AstExpr* right = ParseFactor();
+      expr = NewNode<BinaryExpr>(expr , op , right);
     }
 
     return expr;
   }
 
-  Ref<AstExpr> ShaderParser::ParseFactor() {
+  AstExpr* ShaderParser::ParseFactor() {
     auto expr = ParseCall();
 
     while (Match({ STAR , F_SLASH })) {
       Token op = Previous();
-      Ref<AstExpr> right = ParseCall();
-      expr = NewRef<BinaryExpr>(expr , op , right);
+      AstExpr* right = ParseCall();
+      expr = NewNode<BinaryExpr>(expr , op , right);
     }
 
     return expr;
   }
 
-  Ref<AstExpr> ShaderParser::ParseCall() {
+  AstExpr* ShaderParser::ParseCall() {
     auto expr = ParseLiteral();
 
     do {
@@ -585,7 +589,7 @@ namespace other {
         expr = FinishCall(expr);
       } else if (Match({ DOT })) {
         Token name = Consume(IDENTIFIER , fmtstr("Expected property or name after '.'! found {}" , Peek().value));
-        expr = NewRef<ObjAccessExpr>(expr , name);
+        expr = NewNode<ObjAccessExpr>(expr , name);
       } else {
         break;
       }
@@ -594,8 +598,8 @@ namespace other {
     return expr;
   }
 
-  Ref<AstExpr> ShaderParser::FinishCall(Ref<AstExpr>& callee) {
-    std::vector<Ref<AstExpr>> args;
+  AstExpr* ShaderParser::FinishCall(AstExpr* callee) {
+    std::vector<AstExpr*> args;
     if (!Check(CLOSE_PAREN)) {
       do {
         if (args.size() >= 255) {
@@ -607,18 +611,18 @@ namespace other {
 
     Consume(CLOSE_PAREN , fmtstr("Expected closing parenthesis after function parameters! found {}" , Peek().value));
 
-    return NewRef<CallExpr>(callee , args);
+    return NewNode<CallExpr>(callee , args);
   }
 
-  Ref<AstExpr> ShaderParser::ParseLiteral() {
+  AstExpr* ShaderParser::ParseLiteral() {
     if (MatchLiterals()) {
-      return NewRef<LiteralExpr>(Previous());
+      return NewNode<LiteralExpr>(Previous());
     }
 
     return ResolveExpr();
   }
 
-  Ref<AstExpr> ShaderParser::ResolveExpr() {
+  AstExpr* ShaderParser::ResolveExpr() {
     if (Match({ HASH })) {
       Token version = Consume(IDENTIFIER , fmtstr("Expected 'version' after '#'! found {}" , Peek().type));
       if (version.value != "version") {
@@ -628,23 +632,23 @@ namespace other {
       Token number = Consume(INT_LIT , fmtstr("Expected a version number for glsl! found {}" , Peek().type));
       Token type = Consume(CORE_KW , fmtstr("Expected 'core' after '#version XXX'! found {}" , Peek().type));
 
-      return NewRef<VersionExpr>(number , type);
+      return NewNode<VersionExpr>(number , type);
     }
 
     if (Match({ TokenType::OPEN_PAREN })) {
-      Ref<AstExpr> expr = ParseExpression();
+      AstExpr* expr = ParseExpression();
       Consume(TokenType::CLOSE_PAREN , "Expected closing parenthesis");
-      return NewRef<GroupingExpr>(expr);
+      return NewNode<GroupingExpr>(expr);
     }
 
     if (Match({ TokenType::PLUS , TokenType::MINUS })) {
       Token op = Previous();
-      Ref<AstExpr> right = ParseLiteral();
-      return NewRef<UnaryExpr>(op , right);
+      AstExpr* right = ParseLiteral();
+      return NewNode<UnaryExpr>(op , right);
     }
     
     if (Match({ TokenType::IDENTIFIER })) {
-      Ref<AstExpr> id = NewRef<VarExpr>(Previous());
+      AstExpr* id = NewNode<VarExpr>(Previous());
 
       if (Match({ TokenType::OPEN_BRACKET } , false)) {
         return ParseArrayAccess(id);
@@ -655,15 +659,15 @@ namespace other {
         return ParseStructAccess(id);
       }
 
-      return NewRef<VarExpr>(Previous());
+      return id;
     }
 
     /// here we assume ctor call 
     if (MatchTypes()) {
-      Ref<AstExpr> var_expr = NewRef<VarExpr>(Previous());
+      AstExpr* var_expr = NewNode<VarExpr>(Previous());
       
       if (Match({ OPEN_PAREN })) {
-        Ref<AstExpr> ctor_call = FinishCall(var_expr);
+        AstExpr* ctor_call = FinishCall(var_expr);
         return ctor_call;
       }
     }
@@ -671,13 +675,17 @@ namespace other {
     throw Error(SYNTAX_ERROR , fmtstr("Unable to resolve expression! found {}" , Peek().value));
   }
 
-  Ref<AstExpr> ShaderParser::ParseArrayExpr(Token size) {
+  AstExpr* ShaderParser::ParseArrayExpr(Token size) {
     Consume(OPEN_BRACE , fmtstr("Expected open brace to define array values! found {}" , Peek().value));
 
-    std::vector<Ref<AstExpr>> elements;
+    /// unsized arrays take as many elements as the initializer has
+    size_t max_elements = std::numeric_limits<size_t>::max();
+    std::from_chars(size.value.data() , size.value.data() + size.value.size() , max_elements);
+
+    std::vector<AstExpr*> elements;
     while (!Match({ TokenType::CLOSE_BRACE })) {
       do {
-        if (elements.size() > std::stoi(size.value)) {
+        if (elements.size() > max_elements) {
           throw Error(SYNTAX_ERROR , "Array size does not match number of values in initializer!");
         }
         elements.push_back(ParseExpression());
@@ -686,23 +694,23 @@ namespace other {
 
     // Consume(SEMICOLON , fmtstr("Expected closing bracket for array literal! found {}" , Peek().type));
 
-    return NewRef<ArrayExpr>(elements);
+    return NewNode<ArrayExpr>(elements);
   }
   
-  Ref<AstExpr> ShaderParser::ParseArrayAccess(Ref<AstExpr>& expr) {
+  AstExpr* ShaderParser::ParseArrayAccess(AstExpr* expr) {
     Consume(TokenType::OPEN_BRACKET , "Expected opening bracket for array access");
 
-    Ref<AstExpr> index = ParseExpression();
+    AstExpr* index = ParseExpression();
     Consume(TokenType::CLOSE_BRACKET , "Expected closing bracket for array access");
 
-    return NewRef<ArrayAccessExpr>(expr , index);
+    return NewNode<ArrayAccessExpr>(expr , index);
   }
 
-  Ref<AstExpr> ShaderParser::ParseStructAccess(Ref<AstExpr>& expr) {
+  AstExpr* ShaderParser::ParseStructAccess(AstExpr* expr) {
     Token name = Consume(IDENTIFIER , fmtstr("Expected identifier for struct access! found {}" , Peek().value));
 
-    Ref<AstExpr> assignment = nullptr;
-    Ref<AstExpr> index = nullptr;
+    AstExpr* assignment = nullptr;
+    AstExpr* index = nullptr;
     
     if (Match({ EQUAL_OP })) {
       assignment = ParseExpression();
@@ -718,7 +726,7 @@ namespace other {
       }
     }
 
-    return NewRef<ObjAccessExpr>(expr , name , index , assignment);
+    return NewNode<ObjAccessExpr>(expr , name , index , assignment);
   }
 
   Token ShaderParser::Peek() const {
@@ -827,7 +835,7 @@ namespace other {
     }, advance);
   }
 
-  void ShaderParser::AddTopLevelNode(const Ref<AstStmt>& node) {
+  void ShaderParser::AddTopLevelNode(AstStmt* node) {
     switch (current_context) {
       case VERTEX_CTX:
         result.vertex_nodes.push_back(node);
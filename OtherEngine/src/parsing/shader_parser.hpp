@@ -12,15 +12,20 @@
 
 #include "parsing/parsing_defines.hpp"
 #include "parsing/ast_node.hpp"
+#include "parsing/shader_arena.hpp"
 #include "parsing/shader_lexer.hpp"
 
 namespace other {
 
   struct ShaderAst {
     ShaderType type;
-    std::vector<Ref<AstNode>> vertex_nodes;
-    std::vector<Ref<AstNode>> fragment_nodes;
-    std::vector<Ref<AstNode>> geometry_nodes;
+
+    /// owns every node below (and any synthesized token text), released in one shot with the ast
+    Scope<ShaderArena> arena = nullptr;
+
+    std::vector<AstNode*> vertex_nodes;
+    std::vector<AstNode*> fragment_nodes;
+    std::vector<AstNode*> geometry_nodes;
   };
 
   class ShaderParser {
@@ -28,6 +33,8 @@ namespace other {
       ShaderParser(ShaderLexResult& shader_lex_result) {
         tokens.swap(shader_lex_result.tokens);
         result.type = shader_lex_result.shader_type;
+        result.arena = shader_lex_result.arena != nullptr ? 
+          std::move(shader_lex_result.arena) : NewScope<ShaderArena>();
         OE_DEBUG("Shader Type {}" , result.type);
         switch (result.type) {
           case VERTEX_SHADER:
@@ -75,51 +82,51 @@ namespace other {
 
       ShaderType GetCurrentShaderType();
 
-      Ref<AstStmt> ParseDecl();
+      AstStmt* ParseDecl();
 
-      Ref<AstStmt> ParseShaderDecl();
+      AstStmt* ParseShaderDecl();
 
-      Ref<AstStmt> ParseLayoutDecl();
-      Ref<AstStmt> ParseFunctionDecl(const Token& type , const Token& name);
-      Ref<AstStmt> ParseStructDecl(const Token& name);
+      AstStmt* ParseLayoutDecl();
+      AstStmt* ParseFunctionDecl(const Token& type , const Token& name);
+      AstStmt* ParseStructDecl(const Token& name);
       
-      Ref<AstStmt> ParseUniformDecl();
-      Ref<AstStmt> ParseVarDecl();
-      Ref<AstStmt> ParseArrayDecl(const Token& type , const Token& name , bool is_const = false);
-
-      Ref<AstStmt> ParseBufferDecl();
-
-      Ref<AstStmt> ParseLayoutStmt();
-
-      Ref<AstStmt> ParseStatement();
-      Ref<AstStmt> ParseInOutBlock(const Token& type , const Token& tag);
-      Ref<AstStmt> ParseBlock();                                                                          
-      Ref<AstStmt> ParseIf();
-      Ref<AstStmt> ParseWhile();
-      Ref<AstStmt> ParseFor();
-      Ref<AstStmt> ParseReturn();
-
-      Ref<AstExpr> ParseShaderAttribute();
-
-      Ref<AstExpr> ParseLayoutDescriptor();
-
-      Ref<AstExpr> HandleExpr();
-      Ref<AstExpr> ParseExpression();                                                                     
-      Ref<AstExpr> ParseAssignment();
-      Ref<AstExpr> ParseOr();
-      Ref<AstExpr> ParseAnd();
-      Ref<AstExpr> ParseEquality();
-      Ref<AstExpr> ParseComparison();
-      Ref<AstExpr> ParseTerm();
-      Ref<AstExpr> ParseFactor();
-      Ref<AstExpr> ParseCall();
-      Ref<AstExpr> FinishCall(Ref<AstExpr>& callee);
-      Ref<AstExpr> ParseLiteral();
-      Ref<AstExpr> ResolveExpr();
-
-      Ref<AstExpr> ParseArrayExpr(Token size);
-      Ref<AstExpr> ParseArrayAccess(Ref<AstExpr>& expr);
-      Ref<AstExpr> ParseStructAccess(Ref<AstExpr>& expr);
+      AstStmt* ParseUniformDecl();
+      AstStmt* ParseVarDecl();
+      AstStmt* ParseArrayDecl(const Token& type , const Token& name , bool is_const = false);
+
+      AstStmt* ParseBufferDecl();
+
+      AstStmt* ParseLayoutStmt();
+
+      AstStmt* ParseStatement();
+      AstStmt* ParseInOutBlock(const Token& type , const Token& tag);
+      AstStmt* ParseBlock();                                                                          
+      AstStmt* ParseIf();
+      AstStmt* ParseWhile();
+      AstStmt* ParseFor();
+      AstStmt* ParseReturn();
+
+      AstExpr* ParseShaderAttribute();
+
+      AstExpr* ParseLayoutDescriptor();
+
+      AstExpr* HandleExpr();
+      AstExpr* ParseExpression();                                                                     
+      AstExpr* ParseAssignment();
+      AstExpr* ParseOr();
+      AstExpr* ParseAnd();
+      AstExpr* ParseEquality();
+      AstExpr* ParseComparison();
+      AstExpr* ParseTerm();
+      AstExpr* ParseFactor();
+      AstExpr* ParseCall();
+      AstExpr* FinishCall(AstExpr* callee);
+      AstExpr* ParseLiteral();
+      AstExpr* ResolveExpr();
+
+      AstExpr* ParseArrayExpr(Token size);
+      AstExpr* ParseArrayAccess(AstExpr* expr);
+      AstExpr* ParseStructAccess(AstExpr* expr);
 
       /**
        * declaration (layout, type, struct, ...)
@@ -141,7 +148,12 @@ namespace other {
       bool MatchLiterals(bool advance = true);
       bool MatchTypes(bool advance = true);
 
-      void AddTopLevelNode(const Ref<AstStmt>& node);
+      void AddTopLevelNode(AstStmt* node);
+
+      template <typename T , typename... Args>
+      T* NewNode(Args&&... args) {
+        return result.arena->New<T>(std::forward<Args>(args)...);
+      }
 
       template <typename... Args>
       ShaderException Error(ShaderError error , std::string_view message, Args&&... args) const {
@@ -3,7 +3,185 @@
  **/
 #include "physics/2D/physics_world_2d.hpp"
 
+#include <box2d/b2_body.h>
+#include <box2d/b2_circle_shape.h>
+#include <box2d/b2_collision.h>
+#include <box2d/b2_distance.h>
+#include <box2d/b2_fixture.h>
+#include <box2d/b2_polygon_shape.h>
+
+#include "core/logger.hpp"
+
 namespace other {
+namespace {
+
+  /// smallest extent a query shape is built with, Box2D asserts on degenerate polygons
+  constexpr static float kMinQueryExtent = 1e-3f;
+
+  b2Vec2 ToBox2d(const glm::vec3& v) {
+    return { v.x , v.y };
+  }
+
+  glm::vec3 ToGlm(const b2Vec2& v) {
+    return { v.x , v.y , 0.f };
+  }
+
+  class QueryShape2D {
+    public:
+      QueryShape2D(const PhysicsQueryShape& query) 
+          : is_box(query.type == BOX_QUERY_SHAPE) {
+        if (is_box) {
+          polygon.SetAsBox(std::max(query.extent.x , kMinQueryExtent) , std::max(query.extent.y , kMinQueryExtent));
+        } else {
+          circle.m_radius = std::max(query.extent.x , kMinQueryExtent);
+        }
+      }
+
+      const b2Shape* Get() const {
+        return is_box ? static_cast<const b2Shape*>(&polygon) : &circle;
+      }
+
+      b2AABB Bounds(const b2Transform& xf) const {
+        b2AABB bounds;
+        Get()->ComputeAABB(&bounds , xf , 0);
+        return bounds;
+      }
+
+    private:
+      bool is_box;
+      b2CircleShape circle;
+      b2PolygonShape polygon;
+  };
+
+  uint64_t UserData(const b2Fixture* fixture) {
+    return static_cast<uint64_t>(fixture->GetBody()->GetUserData().pointer);
+  }
+
+  /**
+   * closest point on fixture if it overlaps shape, null otherwise
+   *
+   * b2Distance bumps Box2D's global gjk debug counters, those are the only shared state queries write
+   **/
+  Opt<b2Vec2> OverlapPoint(const b2Fixture* fixture , const b2Shape* shape , const b2Transform& xf) {
+    const b2Shape* fixture_shape = fixture->GetShape();
+    for (int32 child = 0; child < fixture_shape->GetChildCount(); ++child) {
+      b2DistanceInput input;
+      input.proxyA.Set(fixture_shape , child);
+      input.proxyB.Set(shape , 0);
+      input.transformA = fixture->GetBody()->GetTransform();
+      input.transformB = xf;
+      input.useRadii = true;
+
+      b2SimplexCache cache;
+      cache.count = 0;
+
+      b2DistanceOutput output;
+      b2Distance(&output , &cache , &input);
+
+      /// same tolerance as b2TestOverlap
+      if (output.distance < 10.f * b2_epsilon) {
+        return output.pointA;
+      }
+    }
+    return std::nullopt;
+  }
+
+  class RayCallback : public b2RayCastCallback {
+    public:
+      RayCallback(const PhysicsQueryResults& results , uint32_t query)
+          : results(results) , query(query) {}
+
+      /// the returned fraction clips the ray, 1 keeps it whole while the slot still has room
+      virtual float ReportFixture(b2Fixture* fixture , const b2Vec2& point , const b2Vec2& normal , float fraction) override {
+        return results.Insert(PhysicsQueryHit {
+          .user_data = UserData(fixture) ,
+          .point = ToGlm(point) ,
+          .normal = ToGlm(normal) ,
+          .fraction = fraction ,
+          .query = query ,
+        });
+      }
+
+    private:
+      const PhysicsQueryResults& results;
+      uint32_t query;
+  };
+
+  class ShapeCastCallback : public b2QueryCallback {
+    public:
+      ShapeCastCallback(const PhysicsQueryResults& results , uint32_t query , const QueryShape2D& shape , 
+                        const b2Transform& xf , const b2Vec2& translation)
+          : results(results) , query(query) , shape(shape) , xf(xf) , translation(translation) {}
+
+      virtual bool ReportFixture(b2Fixture* fixture) override {
+        bool hit = false;
+        const b2Shape* fixture_shape = fixture->GetShape();
+        for (int32 child = 0; child < fixture_shape->GetChildCount(); ++child) {
+          b2ShapeCastInput input;
+          input.proxyA.Set(fixture_shape , child);
+          input.proxyB.Set(shape.Get() , 0);
+          input.transformA = fixture->GetBody()->GetTransform();
+          input.transformB = xf;
+          input.translationB = translation;
+
+          b2ShapeCastOutput output;
+          if (b2ShapeCast(&output , &input)) {
+            Insert(fixture , output.point , output.normal , output.lambda);
+            hit = true;
+          }
+        }
+
+        /// b2ShapeCast reports nothing for shapes that start out overlapping, Jolt reports those at fraction 0
+        if (!hit) {
+          if (Opt<b2Vec2> point = OverlapPoint(fixture , shape.Get() , xf); point.has_value()) {
+            Insert(fixture , point.value() , b2Vec2_zero , 0.f);
+          }
+        }
+        return true;
+      }
+
+    private:
+      const PhysicsQueryResults& results;
+      uint32_t query;
+      const QueryShape2D& shape;
+      b2Transform xf;
+      b2Vec2 translation;
+
+      void Insert(const b2Fixture* fixture , const b2Vec2& point , const b2Vec2& normal , float fraction) {
+        results.Insert(PhysicsQueryHit {
+          .user_data = UserData(fixture) ,
+          .point = ToGlm(point) ,
+          .normal = ToGlm(normal) ,
+          .fraction = fraction ,
+          .query = query ,
+        });
+      }
+  };
+
+  class OverlapCallback : public b2QueryCallback {
+    public:
+      OverlapCallback(const PhysicsQueryResults& results , uint32_t query , const QueryShape2D& shape , const b2Transform& xf)
+          : results(results) , query(query) , shape(shape) , xf(xf) {}
+
+      virtual bool ReportFixture(b2Fixture* fixture) override {
+        if (Opt<b2Vec2> point = OverlapPoint(fixture , shape.Get() , xf); point.has_value()) {
+          results.Insert(PhysicsQueryHit {
+            .user_data = UserData(fixture) ,
+            .point = ToGlm(point.value()) ,
+            .query = query ,
+          });
+        }
+        return !results.Full(query);
+      }
+
+    private:
+      const PhysicsQueryResults& results;
+      uint32_t query;
+      const QueryShape2D& shape;
+      b2Transform xf;
+  };
+
+} // anonymous namespace
 
   PhysicsWorld2D::PhysicsWorld2D(const glm::vec2& grav) {
     gravity = {
@@ -29,4 +207,66 @@ namespace other {
     return { gravity.x , gravity.y };
   }
 
+  void PhysicsWorld2D::CastRays(std::span<const RaycastQuery> queries , const PhysicsQueryResults& results) const {
+    OE_ASSERT(queries.size() <= results.num_queries , "Physics query results too small for {} raycasts" , queries.size());
+
+    DispatchPhysicsQueries(static_cast<uint32_t>(queries.size()) , [&](uint32_t i) {
+      results.counts[i] = 0;
+
+      const RaycastQuery& query = queries[i];
+      b2Vec2 direction = ToBox2d(query.direction);
+      if (direction.Normalize() == 0.f) {
+        return;
+      }
+
+      b2Vec2 start = ToBox2d(query.origin);
+      RayCallback callback(results , i);
+      world->RayCast(&callback , start , start + query.max_distance * direction);
+    });
+  }
+
+  void PhysicsWorld2D::CastShapes(std::span<const ShapeCastQuery> queries , const PhysicsQueryResults& results) const {
+    OE_ASSERT(queries.size() <= results.num_queries , "Physics query results too small for {} shape casts" , queries.size());
+
+    DispatchPhysicsQueries(static_cast<uint32_t>(queries.size()) , [&](uint32_t i) {
+      results.counts[i] = 0;
+
+      const ShapeCastQuery& query = queries[i];
+      b2Vec2 direction = ToBox2d(query.direction);
+      if (direction.Normalize() == 0.f) {
+        return;
+      }
+
+      QueryShape2D shape(query.shape);
+      b2Transform xf(ToBox2d(query.origin) , b2Rot(0.f));
+      b2Vec2 translation = query.max_distance * direction;
+
+      /// everything the shape can touch lies in the bounds swept from start to end
+      b2AABB swept;
+      swept.Combine(shape.Bounds(xf) , shape.Bounds(b2Transform(xf.p + translation , xf.q)));
+
+      ShapeCastCallback callback(results , i , shape , xf , translation);
+      world->QueryAABB(&callback , swept);
+    });
+  }
+
+  void PhysicsWorld2D::Overlap(std::span<const OverlapQuery> queries , const PhysicsQueryResults& results) const {
+    OE_ASSERT(queries.size() <= results.num_queries , "Physics query results too small for {} overlaps" , queries.size());
+
+    DispatchPhysicsQueries(static_cast<uint32_t>(queries.size()) , [&](uint32_t i) {
+      results.counts[i] = 0;
+
+      const OverlapQuery& query = queries[i];
+      QueryShape2D shape(query.shape);
+      b2Transform xf(ToBox2d(query.center) , b2Rot(0.f));
+
+      OverlapCallback callback(results , i , shape , xf);
+      world->QueryAABB(&callback , shape.Bounds(xf));
+    });
+  }
+
+  b2Body* PhysicsWorld2D::GetBodyList() {
+    return world->GetBodyList();
+  }
+
 } // namespace other
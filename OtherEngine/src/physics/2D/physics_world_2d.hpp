@@ -4,12 +4,16 @@
 #ifndef OTHER_ENGINE_PHYSICS_WORLD_2D_HPP
 #define OTHER_ENGINE_PHYSICS_WORLD_2D_HPP
 
+#include <span>
+
 #include <glm/glm.hpp>
 #include <box2d/b2_world.h>
 
 #include "core/defines.hpp"
 #include "core/ref_counted.hpp"
 
+#include "physics/physics_queries.hpp"
+
 namespace other {
 
   class PhysicsWorld2D : public RefCounted {
@@ -23,6 +27,19 @@ namespace other {
 
       glm::vec2 GetGravity() const;
 
+      /**
+       * batched scene queries through Box2D's broad phase tree, run in parallel on the engine thread pool the same way
+       *   as the 3D world, queries only read x and y
+       *
+       * none of these may overlap Step or body creation
+       **/
+      void CastRays(std::span<const RaycastQuery> queries , const PhysicsQueryResults& results) const;
+      void CastShapes(std::span<const ShapeCastQuery> queries , const PhysicsQueryResults& results) const;
+      void Overlap(std::span<const OverlapQuery> queries , const PhysicsQueryResults& results) const;
+
+      /// head of Box2D's intrusive body list, walk it with b2Body::GetNext
+      b2Body* GetBodyList();
+
     private:
       b2Vec2 gravity;
       Scope<b2World> world = nullptr;
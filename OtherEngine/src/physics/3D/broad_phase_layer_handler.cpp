@@ -15,7 +15,7 @@ namespace other {
   }
   
 #if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
-   const char* BroadPhaseLayerHandler::GetBroadPhaseLayerName(JPH::BroadBroadPhaseLayer layer) const {
+   const char* BroadPhaseLayerHandler::GetBroadPhaseLayerName(JPH::BroadPhaseLayer layer) const {
      return "Debug Broad Phase Layer";
    }
 #endif // !JPH_EXTERNAL_PROFILE || JPH_PROFILE_ENABLED
@@ -19,11 +19,11 @@ namespace other {
       JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer layer) const override;
   
 #if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
-      const char* GetBroadPhaseLayerName(JPH::BroadBroadPhaseLayer layer) const override;
+      const char* GetBroadPhaseLayerName(JPH::BroadPhaseLayer layer) const override;
 #endif // !JPH_EXTERNAL_PROFILE || JPH_PROFILE_ENABLED
   
     private:
-      JPH::BroadPhaseLayer broad_phase_layer;
+      JPH::BroadPhaseLayer broad_phase_layer{ 0 };
   };
 
 } // namespace other
@@ -1,13 +1,14 @@
-
 /**
  * \file physics/3D/object_layer_filter.cpp
  **/
 #include "physics/3D/object_layer_filter.hpp"
 
+#include "physics/physics_defines.hpp"
+
 namespace other {
 
   bool ObjectLayerFilter::ShouldCollide(JPH::ObjectLayer layer1 , JPH::ObjectLayer layer2) const {
-    return true;
+    return layer1 != STATIC_OBJECT_LAYER || layer2 != STATIC_OBJECT_LAYER;
   }
 
 } // namespace other
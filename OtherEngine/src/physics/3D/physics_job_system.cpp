@@ -0,0 +1,97 @@
+/**
+ * \file physics/3D/physics_job_system.cpp
+ **/
+#include "physics/3D/physics_job_system.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace other {
+namespace {
+
+  int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+} // anonymous namespace
+
+  PhysicsJobSystem::PhysicsJobSystem(ThreadPool& pool , uint32_t max_jobs , uint32_t max_barriers) 
+      : JPH::JobSystemWithBarrier(max_barriers) , pool(pool) , stats_start_ns(NowNs()) {
+    jobs.Init(max_jobs , max_jobs);
+  }
+
+  int PhysicsJobSystem::GetMaxConcurrency() const {
+    /// the thread stepping the world helps out while it waits
+    return static_cast<int>(pool.NumWorkers()) + 1;
+  }
+
+  JPH::JobSystem::JobHandle PhysicsJobSystem::CreateJob(const char* name , JPH::ColorArg color , const JobFunction& job_function , 
+                                                        JPH::uint32 num_dependencies) {
+    JPH::uint32 index = jobs.ConstructObject(name , color , this , job_function , num_dependencies);
+    while (index == JobList::cInvalidObjectIndex) {
+      /// every job slot is in flight, wait for the pool to retire some
+      std::this_thread::yield();
+      index = jobs.ConstructObject(name , color , this , job_function , num_dependencies);
+    }
+
+    Job* job = &jobs.Get(index);
+
+    /// keep a reference in the handle, the job may finish before we return
+    JobHandle handle(job);
+    if (num_dependencies == 0) {
+      QueueJob(job);
+    }
+
+    return handle;
+  }
+
+  ThreadPoolStats PhysicsJobSystem::Stats() const {
+    ThreadPoolStats stats;
+    stats.num_workers = pool.NumWorkers();
+    stats.jobs_executed = jobs_executed.load(std::memory_order_relaxed);
+    stats.busy_ms = static_cast<double>(busy_ns.load(std::memory_order_relaxed)) / 1e6;
+    stats.wall_ms = static_cast<double>(NowNs() - stats_start_ns.load(std::memory_order_relaxed)) / 1e6;
+
+    const double capacity = stats.wall_ms * std::max(stats.num_workers , 1u);
+    stats.occupancy = capacity > 0.0 ? static_cast<float>(std::min(stats.busy_ms / capacity , 1.0)) : 0.f;
+    return stats;
+  }
+
+  void PhysicsJobSystem::ResetStats() {
+    jobs_executed = 0;
+    busy_ns = 0;
+    stats_start_ns = NowNs();
+  }
+
+  void PhysicsJobSystem::QueueJob(Job* job) {
+    pool.Submit(MakeTask(job));
+  }
+
+  void PhysicsJobSystem::QueueJobs(Job** jobs , JPH::uint num_jobs) {
+    /// finishing jobs queue their dependents from whatever thread they ran on, so the batch can not be shared
+    std::vector<ThreadPool::Job> batch;
+    batch.reserve(num_jobs);
+    for (JPH::uint i = 0; i < num_jobs; ++i) {
+      batch.push_back(MakeTask(jobs[i]));
+    }
+    pool.Submit(batch);
+  }
+
+  void PhysicsJobSystem::FreeJob(Job* job) {
+    jobs.DestructObject(job);
+  }
+
+  ThreadPool::Job PhysicsJobSystem::MakeTask(Job* job) {
+    /// the queue holds a reference until the job ran, whoever gets to it first executes it, the other call is a no-op
+    job->AddRef();
+    return [this , job]() {
+      const int64_t start = NowNs();
+      job->Execute();
+      busy_ns.fetch_add(static_cast<uint64_t>(NowNs() - start) , std::memory_order_relaxed);
+      jobs_executed.fetch_add(1 , std::memory_order_relaxed);
+      job->Release();
+    };
+  }
+
+} // namespace other
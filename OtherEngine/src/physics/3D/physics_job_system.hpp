@@ -0,0 +1,56 @@
+/**
+ * \file physics/3D/physics_job_system.hpp
+ **/
+#ifndef OTHER_ENGINE_PHYSICS_JOB_SYSTEM_HPP
+#define OTHER_ENGINE_PHYSICS_JOB_SYSTEM_HPP
+
+#include <atomic>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+#include "core/thread_pool.hpp"
+
+namespace other {
+
+  /**
+   * runs Jolt's jobs on the engine thread pool
+   *
+   * Jolt only needs somewhere to run a job once its dependencies are met, barriers come from JobSystemWithBarrier
+   *   and the thread waiting on a barrier runs jobs from it as well, so the step never stalls on a busy pool
+   **/
+  class PhysicsJobSystem final : public JPH::JobSystemWithBarrier {
+    public:
+      PhysicsJobSystem(ThreadPool& pool , uint32_t max_jobs , uint32_t max_barriers);
+      virtual ~PhysicsJobSystem() override = default;
+
+      virtual int GetMaxConcurrency() const override;
+      virtual JobHandle CreateJob(const char* name , JPH::ColorArg color , const JobFunction& job_function , 
+                                  JPH::uint32 num_dependencies = 0) override;
+
+      /// occupancy of the pool's workers by physics jobs alone since the last reset
+      ThreadPoolStats Stats() const;
+      void ResetStats();
+
+    protected:
+      virtual void QueueJob(Job* job) override;
+      virtual void QueueJobs(Job** jobs , JPH::uint num_jobs) override;
+      virtual void FreeJob(Job* job) override;
+
+    private:
+      using JobList = JPH::FixedSizeFreeList<Job>;
+
+      ThreadPool& pool;
+      JobList jobs;
+
+      std::atomic<uint64_t> jobs_executed = 0;
+      std::atomic<uint64_t> busy_ns = 0;
+      std::atomic<int64_t> stats_start_ns = 0;
+
+      ThreadPool::Job MakeTask(Job* job);
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_PHYSICS_JOB_SYSTEM_HPP
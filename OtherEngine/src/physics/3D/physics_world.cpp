@@ -1,4 +1,3 @@
-
 /**
  * \file physics/3D/physics_world.cpp
  **/
@@ -7,24 +6,146 @@
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/Body/BodyInterface.h>
+#include <Jolt/Physics/Body/BodyLockInterface.h>
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/CollideShape.h>
+#include <Jolt/Physics/Collision/NarrowPhaseQuery.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/ShapeCast.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
 
+#include "core/logger.hpp"
 
 namespace other {
+namespace {
 
-  constexpr static JPH::uint kMaxBodies = 1024;
   constexpr static JPH::uint kNumMutexes = 0;
-  constexpr static JPH::uint kMaxPairs = 1024;
-  constexpr static JPH::uint kMaxContactConstraints = 1024;
 
-  PhysicsWorld::PhysicsWorld() {
-    /// TODO: somehow choose the best amount of pre-allocated memory for the scene this world
-    ///       is owned by
-    temp_alloc = NewScope<JPH::TempAllocatorImpl>(10 * 1024 * 1024);
-    thread_pool = NewScope<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs , JPH::cMaxPhysicsBarriers , 
-                                                     std::thread::hardware_concurrency() - 1);
+  /// smallest extent a query shape is built with, Jolt asserts on degenerate shapes
+  constexpr static float kMinQueryExtent = 1e-3f;
+
+  glm::vec3 ToGlm(JPH::Vec3Arg v) {
+    return { v.GetX() , v.GetY() , v.GetZ() };
+  }
+
+  JPH::Vec3 ToJolt(const glm::vec3& v) {
+    return { v.x , v.y , v.z };
+  }
+
+  /// query shapes live on the stack of the query that uses them, embedding keeps Jolt from ever freeing them
+  class QueryShape {
+    public:
+      QueryShape(const PhysicsQueryShape& query) {
+        if (query.type == BOX_QUERY_SHAPE) {
+          JPH::Vec3 half_extent = JPH::Vec3::sMax(ToJolt(query.extent) , JPH::Vec3::sReplicate(kMinQueryExtent));
+          box.emplace(half_extent , std::min(JPH::cDefaultConvexRadius , half_extent.ReduceMin()));
+          box->SetEmbedded();
+        } else {
+          sphere.emplace(std::max(query.extent.x , kMinQueryExtent));
+          sphere->SetEmbedded();
+        }
+      }
+
+      const JPH::Shape* Get() const {
+        return box.has_value() ? static_cast<const JPH::Shape*>(&box.value()) : &sphere.value();
+      }
+
+    private:
+      Opt<JPH::SphereShape> sphere;
+      Opt<JPH::BoxShape> box;
+  };
+
+  /// normal pointing from the body towards the query, Jolt reports the axis from the query into the body
+  glm::vec3 NormalFromPenetrationAxis(JPH::Vec3Arg axis) {
+    return axis.IsNearZero() ? glm::vec3{ 0.f } : ToGlm(-axis.Normalized());
+  }
+
+  /**
+   * writes hits for one query straight into its results slot instead of buffering them, the body a hit belongs
+   *   to is handed over in OnBody right before its hits
+   **/
+  template <typename CollectorType>
+  class QueryCollector : public CollectorType {
+    public:
+      QueryCollector(const PhysicsQueryResults& results , uint32_t query)
+          : results(results) , query(query) {}
+
+      virtual void OnBody(const JPH::Body& body) override {
+        current_body = &body;
+      }
+
+    protected:
+      const PhysicsQueryResults& results;
+      uint32_t query;
+      const JPH::Body* current_body = nullptr;
+
+      void Insert(const glm::vec3& point , const glm::vec3& normal , float fraction) {
+        float cutoff = results.Insert(PhysicsQueryHit {
+          .user_data = current_body->GetUserData() ,
+          .point = point ,
+          .normal = normal ,
+          .fraction = fraction ,
+          .query = query ,
+        });
+
+        /// once the slot is full only closer hits matter, let Jolt skip everything further away
+        if (cutoff < this->GetEarlyOutFraction()) {
+          this->UpdateEarlyOutFraction(cutoff);
+        }
+      }
+  };
+
+  class RayCollector : public QueryCollector<JPH::CastRayCollector> {
+    public:
+      RayCollector(const PhysicsQueryResults& results , uint32_t query , const JPH::RRayCast& ray)
+          : QueryCollector(results , query) , ray(ray) {}
+
+      virtual void AddHit(const JPH::RayCastResult& hit) override {
+        JPH::RVec3 point = ray.GetPointOnRay(hit.mFraction);
+        Insert(ToGlm(point) , ToGlm(current_body->GetWorldSpaceSurfaceNormal(hit.mSubShapeID2 , point)) , hit.mFraction);
+      }
+
+    private:
+      const JPH::RRayCast& ray;
+  };
+
+  class ShapeCastCollector : public QueryCollector<JPH::CastShapeCollector> {
+    public:
+      using QueryCollector::QueryCollector;
+
+      virtual void AddHit(const JPH::ShapeCastResult& hit) override {
+        Insert(ToGlm(hit.mContactPointOn2) , NormalFromPenetrationAxis(hit.mPenetrationAxis) , hit.mFraction);
+      }
+  };
+
+  class OverlapCollector : public QueryCollector<JPH::CollideShapeCollector> {
+    public:
+      using QueryCollector::QueryCollector;
+
+      virtual void AddHit(const JPH::CollideShapeResult& hit) override {
+        results.Insert(PhysicsQueryHit {
+          .user_data = current_body->GetUserData() ,
+          .point = ToGlm(hit.mContactPointOn2) ,
+          .normal = NormalFromPenetrationAxis(hit.mPenetrationAxis) ,
+          .query = query ,
+        });
+
+        if (results.Full(query)) {
+          ForceEarlyOut();
+        }
+      }
+  };
+
+} // anonymous namespace
+
+  PhysicsWorld::PhysicsWorld(JPH::JobSystem* job_system , TempAllocatorPool* temp_allocators , const PhysicsWorldLimits& limits)
+      : job_system(job_system) , temp_allocators(temp_allocators) {
+    OE_ASSERT(job_system != nullptr , "Physics world created without a job system");
+    OE_ASSERT(temp_allocators != nullptr , "Physics world created without temp allocators");
 
     system = NewScope<JPH::PhysicsSystem>();
-    system->Init(kMaxBodies , kNumMutexes , kMaxPairs , kMaxContactConstraints ,
+    system->Init(limits.max_bodies , kNumMutexes , limits.max_body_pairs , limits.max_contact_constraints ,
                  broad_phase_layer_handler , broad_phase_layer_filter , obj_layer_filter);
 
     activation_listener = NewScope<ActivationListener>();
@@ -36,16 +157,125 @@ namespace other {
 
   PhysicsWorld::~PhysicsWorld() {
     system = nullptr;
-    thread_pool = nullptr;
-    temp_alloc = nullptr;
   }
 
-  void PhysicsWorld::Simulate(float ts) {
-    /// FIXME: do we do this each simulation frame
+  void PhysicsWorld::Simulate(float step) {
+    /// one collision step per fixed step, sub-stepping is driven by the caller's accumulator
+    const int32_t collision_steps = 1;
+
+    ScopedTempAllocator temp_alloc(*temp_allocators);
+    JPH::EPhysicsUpdateError err = system->Update(step , collision_steps , temp_alloc.Get() , job_system);
+    if (err != JPH::EPhysicsUpdateError::None) {
+      OE_WARN("Physics step reported errors (0x{:x}), world limits are too small for the scene" , static_cast<uint32_t>(err));
+    }
+  }
+
+  void PhysicsWorld::OptimizeBroadPhase() {
     system->OptimizeBroadPhase(); 
+  }
+
+  JPH::BodyID PhysicsWorld::CreateBody(const JPH::BodyCreationSettings& settings , bool activate) {
+    return system->GetBodyInterface().CreateAndAddBody(settings , activate ? 
+                                                        JPH::EActivation::Activate : JPH::EActivation::DontActivate);
+  }
+
+  void PhysicsWorld::DestroyBody(JPH::BodyID id) {
+    if (id.IsInvalid()) {
+      return;
+    }
+
+    JPH::BodyInterface& bodies = system->GetBodyInterface();
+    bodies.RemoveBody(id);
+    bodies.DestroyBody(id);
+  }
+
+  void PhysicsWorld::GetActiveBodyStates(std::vector<PhysicsBodyState>& states) {
+    states.clear();
+
+    const uint32_t num_active = system->GetNumActiveBodies(JPH::EBodyType::RigidBody);
+    const JPH::BodyID* active = system->GetActiveBodiesUnsafe(JPH::EBodyType::RigidBody);
+    const JPH::BodyLockInterfaceNoLock& lock_interface = system->GetBodyLockInterfaceNoLock();
+
+    states.reserve(num_active);
+    for (uint32_t i = 0; i < num_active; ++i) {
+      const JPH::Body* body = lock_interface.TryGetBody(active[i]);
+      if (body == nullptr) {
+        continue;
+      }
+
+      JPH::RVec3 p = body->GetPosition();
+      JPH::Quat q = body->GetRotation();
+      states.push_back(PhysicsBodyState {
+        .user_data = body->GetUserData() ,
+        .position = { p.GetX() , p.GetY() , p.GetZ() } ,
+        .rotation = glm::quat(q.GetW() , q.GetX() , q.GetY() , q.GetZ()) ,
+      });
+    }
+  }
+      
+  void PhysicsWorld::CastRays(std::span<const RaycastQuery> queries , const PhysicsQueryResults& results) const {
+    OE_ASSERT(queries.size() <= results.num_queries , "Physics query results too small for {} raycasts" , queries.size());
+
+    const JPH::NarrowPhaseQuery& narrow_phase = system->GetNarrowPhaseQueryNoLock();
+    DispatchPhysicsQueries(static_cast<uint32_t>(queries.size()) , [&](uint32_t i) {
+      results.counts[i] = 0;
+
+      const RaycastQuery& query = queries[i];
+      if (glm::length(query.direction) == 0.f) {
+        return;
+      }
+
+      JPH::RRayCast ray(ToJolt(query.origin) , ToJolt(glm::normalize(query.direction) * query.max_distance));
+
+      RayCollector collector(results , i , ray);
+      narrow_phase.CastRay(ray , JPH::RayCastSettings{} , collector);
+    });
+  }
+
+  void PhysicsWorld::CastShapes(std::span<const ShapeCastQuery> queries , const PhysicsQueryResults& results) const {
+    OE_ASSERT(queries.size() <= results.num_queries , "Physics query results too small for {} shape casts" , queries.size());
+
+    const JPH::NarrowPhaseQuery& narrow_phase = system->GetNarrowPhaseQueryNoLock();
+    DispatchPhysicsQueries(static_cast<uint32_t>(queries.size()) , [&](uint32_t i) {
+      results.counts[i] = 0;
+
+      const ShapeCastQuery& query = queries[i];
+      if (glm::length(query.direction) == 0.f) {
+        return;
+      }
+
+      QueryShape shape(query.shape);
+      JPH::RShapeCast cast = JPH::RShapeCast::sFromWorldTransform(shape.Get() , JPH::Vec3::sReplicate(1.f) ,
+                                                                   JPH::RMat44::sTranslation(ToJolt(query.origin)) ,
+                                                                   ToJolt(glm::normalize(query.direction) * query.max_distance));
+
+      ShapeCastCollector collector(results , i);
+      narrow_phase.CastShape(cast , JPH::ShapeCastSettings{} , JPH::RVec3::sZero() , collector);
+    });
+  }
+
+  void PhysicsWorld::Overlap(std::span<const OverlapQuery> queries , const PhysicsQueryResults& results) const {
+    OE_ASSERT(queries.size() <= results.num_queries , "Physics query results too small for {} overlaps" , queries.size());
+
+    const JPH::NarrowPhaseQuery& narrow_phase = system->GetNarrowPhaseQueryNoLock();
+    DispatchPhysicsQueries(static_cast<uint32_t>(queries.size()) , [&](uint32_t i) {
+      results.counts[i] = 0;
+
+      const OverlapQuery& query = queries[i];
+      QueryShape shape(query.shape);
+
+      OverlapCollector collector(results , i);
+      narrow_phase.CollideShape(shape.Get() , JPH::Vec3::sReplicate(1.f) , JPH::RMat44::sTranslation(ToJolt(query.center)) ,
+                                JPH::CollideShapeSettings{} , JPH::RVec3::sZero() , collector);
+    });
+  }
+      
+  uint32_t PhysicsWorld::NumBodies() const {
+    return system->GetNumBodies();
+  }
 
-    const int32_t collision_steps = 16;
-    system->Update(ts , collision_steps , temp_alloc.get() , thread_pool.get());
+  uint32_t PhysicsWorld::NumActiveBodies() const {
+    return system->GetNumActiveBodies(JPH::EBodyType::RigidBody);
   }
 
   JPH::BodyInterface& PhysicsWorld::GetPhysicsBodies() {
@@ -1,38 +1,92 @@
-
 /**
  * \file physics/3D/physics_world.hpp
  **/
 #ifndef OTHER_ENGINE_PHYSICS_WORLD_HPP
 #define OTHER_ENGINE_PHYSICS_WORLD_HPP
 
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
 #include <Jolt/Jolt.h>
-#include <Jolt/Core/TempAllocator.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/JobSystem.h>
 #include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
 
 #include "core/defines.hpp"
 #include "core/ref_counted.hpp"
 
+#include "physics/physics_queries.hpp"
 #include "physics/3D/broad_phase_layer_handler.hpp"
 #include "physics/3D/broad_phase_filter.hpp"
 #include "physics/3D/object_layer_filter.hpp"
 #include "physics/3D/activation_listener.hpp"
 #include "physics/3D/contact_listener.hpp"
+#include "physics/3D/temp_allocator_pool.hpp"
 
 namespace other {
 
+  struct PhysicsWorldLimits {
+    uint32_t max_bodies = 65536;
+    uint32_t max_body_pairs = 65536;
+    uint32_t max_contact_constraints = 20480;
+  };
+
+  /// pose of an awake body after the last step, user_data is whatever the body was created with
+  struct PhysicsBodyState {
+    uint64_t user_data = 0;
+    glm::vec3 position{ 0.f };
+    glm::quat rotation{ 1.f , 0.f , 0.f , 0.f };
+  };
+
   class PhysicsWorld : public RefCounted {
     public:
-      PhysicsWorld();
+      /**
+       * the job system and scratch arenas are borrowed from the physics engine and shared by every world, each world
+       *   only owns its bodies and broad phase
+       *
+       * the temp allocator arenas must be large enough for a step at these limits, Jolt aborts if one runs out
+       **/
+      PhysicsWorld(JPH::JobSystem* job_system , TempAllocatorPool* temp_allocators , const PhysicsWorldLimits& limits = {});
       ~PhysicsWorld();
 
-      void Simulate(float ts);
+      /// advances the simulation by exactly one fixed step
+      void Simulate(float step);
+
+      /// call after adding a batch of bodies, not every step
+      void OptimizeBroadPhase();
+
+      JPH::BodyID CreateBody(const JPH::BodyCreationSettings& settings , bool activate);
+      void DestroyBody(JPH::BodyID id);
+
+      /**
+       * fills states with only the bodies Jolt reports as active, sleeping and static bodies are skipped so the cost
+       *   scales with what moved rather than with the size of the world
+       *
+       * must not be called while Simulate is running
+       **/
+      void GetActiveBodyStates(std::vector<PhysicsBodyState>& states);
+
+      /**
+       * batched scene queries, each query writes into its own slot of results so they run in parallel on the engine
+       *   thread pool against the narrow phase without locking
+       *
+       * results must hold at least queries.size() queries, none of these may overlap Simulate or body creation
+       **/
+      void CastRays(std::span<const RaycastQuery> queries , const PhysicsQueryResults& results) const;
+      void CastShapes(std::span<const ShapeCastQuery> queries , const PhysicsQueryResults& results) const;
+      void Overlap(std::span<const OverlapQuery> queries , const PhysicsQueryResults& results) const;
+
+      uint32_t NumBodies() const;
+      uint32_t NumActiveBodies() const;
 
       JPH::BodyInterface& GetPhysicsBodies();
 
     private:
-      Scope<JPH::TempAllocatorImpl> temp_alloc = nullptr;
-      Scope<JPH::JobSystemThreadPool> thread_pool = nullptr;
+      JPH::JobSystem* job_system = nullptr;
+      TempAllocatorPool* temp_allocators = nullptr;
 
       Scope<ActivationListener> activation_listener = nullptr;
       Scope<ContactListener> contact_listener = nullptr;
@@ -0,0 +1,48 @@
+/**
+ * \file physics/3D/temp_allocator_pool.cpp
+ **/
+#include "physics/3D/temp_allocator_pool.hpp"
+
+#include "core/logger.hpp"
+
+namespace other {
+
+  TempAllocatorPool::TempAllocatorPool(uint32_t arena_size) 
+      : arena_size(arena_size) {
+    /// almost every frame needs exactly one so make it up front
+    arenas.push_back(NewScope<JPH::TempAllocatorImpl>(arena_size));
+    free_arenas.push_back(arenas.back().get());
+  }
+
+  TempAllocatorPool::~TempAllocatorPool() {
+    OE_ASSERT(free_arenas.size() == arenas.size() , "Destroying physics temp allocators while a world is stepping");
+  }
+
+  JPH::TempAllocator* TempAllocatorPool::Acquire() {
+    std::lock_guard lock(mutex);
+    if (free_arenas.empty()) {
+      arenas.push_back(NewScope<JPH::TempAllocatorImpl>(arena_size));
+      OE_DEBUG("Physics worlds stepping concurrently, temp allocator pool grown to {} arenas" , arenas.size());
+      return arenas.back().get();
+    }
+
+    JPH::TempAllocatorImpl* arena = free_arenas.back();
+    free_arenas.pop_back();
+    return arena;
+  }
+
+  void TempAllocatorPool::Release(JPH::TempAllocator* arena) {
+    std::lock_guard lock(mutex);
+    free_arenas.push_back(static_cast<JPH::TempAllocatorImpl*>(arena));
+  }
+
+  uint32_t TempAllocatorPool::NumArenas() const {
+    std::lock_guard lock(mutex);
+    return static_cast<uint32_t>(arenas.size());
+  }
+
+  uint32_t TempAllocatorPool::ArenaSize() const {
+    return arena_size;
+  }
+
+} // namespace other
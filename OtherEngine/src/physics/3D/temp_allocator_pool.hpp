@@ -0,0 +1,62 @@
+/**
+ * \file physics/3D/temp_allocator_pool.hpp
+ **/
+#ifndef OTHER_ENGINE_TEMP_ALLOCATOR_POOL_HPP
+#define OTHER_ENGINE_TEMP_ALLOCATOR_POOL_HPP
+
+#include <mutex>
+#include <vector>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/TempAllocator.h>
+
+#include "core/defines.hpp"
+#include "core/profile.hpp"
+
+namespace other {
+
+  /**
+   * scratch arenas shared by every physics world
+   *
+   * a step borrows an arena for its duration and leaves it empty, so worlds stepped one after another all reuse
+   *   the same memory, a second arena is only made if two worlds step at the same time
+   **/
+  class TempAllocatorPool {
+    public:
+      TempAllocatorPool(uint32_t arena_size);
+      ~TempAllocatorPool();
+
+      JPH::TempAllocator* Acquire();
+      void Release(JPH::TempAllocator* arena);
+
+      uint32_t NumArenas() const;
+      uint32_t ArenaSize() const;
+
+    private:
+      uint32_t arena_size;
+
+      mutable OE_PROFILE_MUTEX(std::mutex , mutex , "Physics temp allocators");
+      std::vector<Scope<JPH::TempAllocatorImpl>> arenas;
+      std::vector<JPH::TempAllocatorImpl*> free_arenas;
+  };
+
+  /// borrows an arena for the lifetime of the scope
+  class ScopedTempAllocator {
+    public:
+      ScopedTempAllocator(TempAllocatorPool& pool)
+        : pool(pool) , arena(pool.Acquire()) {}
+      ~ScopedTempAllocator() { pool.Release(arena); }
+
+      ScopedTempAllocator(const ScopedTempAllocator&) = delete;
+      ScopedTempAllocator& operator=(const ScopedTempAllocator&) = delete;
+
+      JPH::TempAllocator* Get() const { return arena; }
+
+    private:
+      TempAllocatorPool& pool;
+      JPH::TempAllocator* arena;
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_TEMP_ALLOCATOR_POOL_HPP
@@ -6,11 +6,15 @@
 
 #include "core/ref.hpp"
 #include "core/config.hpp"
+#include "core/thread_pool.hpp"
 
 #include "scene/scene.hpp"
 
+#include "physics/physics_defines.hpp"
 #include "physics/2D/physics_world_2d.hpp"
 #include "physics/3D/physics_world.hpp"
+#include "physics/3D/physics_job_system.hpp"
+#include "physics/3D/temp_allocator_pool.hpp"
 
 namespace other {
 
@@ -26,8 +30,26 @@ namespace other {
       static Ref<PhysicsWorld2D> GetPhysicsWorld2D(const glm::vec2& gravity);
       static Ref<PhysicsWorld> GetPhysicsWorld();
 
+      /// every 3D world runs its jobs on the engine thread pool through this
+      static JPH::JobSystem* GetJobSystem();
+
+      /// scratch arenas every 3D world borrows from while stepping, sized by TEMP-ALLOCATOR-MB
+      static TempAllocatorPool* GetTempAllocators();
+
+      /// how busy physics jobs kept the engine workers since the last reset
+      static ThreadPoolStats GetJobStats();
+      static void ResetJobStats();
+
+      static uint32_t StepRate();
+      static uint32_t MaxSubSteps();
+
     private:
       static Ref<Scene> scene_context;
+      static Scope<PhysicsJobSystem> job_system;
+      static Scope<TempAllocatorPool> temp_allocators;
+
+      static uint32_t step_rate;
+      static uint32_t max_sub_steps;
   };
 
 } // namespace other
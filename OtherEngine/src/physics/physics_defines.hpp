@@ -27,6 +27,15 @@ namespace other {
     INVALID_PHYSICS_BODY = NUM_PHYSICS_BODIES
   };
 
+  /// Jolt object layers, static bodies never test against each other
+  enum PhysicsObjectLayer : uint16_t {
+    STATIC_OBJECT_LAYER = 0 ,
+    MOVING_OBJECT_LAYER ,
+
+    NUM_OBJECT_LAYERS ,
+    INVALID_OBJECT_LAYER = NUM_OBJECT_LAYERS ,
+  };
+
   enum MeshCookingResult {
     NUM_COOKING_RESULTS , 
     INVALID_COOKING_RESULT = NUM_COOKING_RESULTS ,
@@ -59,6 +68,15 @@ namespace other {
     INVALID_ACTOR_AXIS = NUM_ACTOR_AXES ,
   };
 
+  enum ColliderShape {
+    BOX_COLLIDER = 0 ,
+    SPHERE_COLLIDER ,
+    CAPSULE_COLLIDER ,
+
+    NUM_COLLIDER_SHAPES ,
+    INVALID_COLLIDER_SHAPE = NUM_COLLIDER_SHAPES ,
+  };
+
   enum CollisionDetectionType {
     DISCRETE_COLLISION = 0 , 
     CONTINUOUS_COLLISION ,
@@ -85,6 +103,13 @@ namespace other {
     INVALID_FALL_OFF_MODE = NUM_COOKING_RESULTS ,
   };
 
+  /// simulation rate in hz and the most fixed steps taken in one frame before the remaining time is dropped
+  constexpr static uint32_t kDefaultPhysicsStepRate = 60;
+  constexpr static uint32_t kDefaultPhysicsMaxSubSteps = 8;
+
+  /// size of each physics scratch arena, a step at the default PhysicsWorldLimits fits in this
+  constexpr static uint32_t kDefaultPhysicsTempAllocatorMb = 32;
+
   struct CollisionMaterial {
     float friction = 0.5f;
     float restitution = 0.15f;
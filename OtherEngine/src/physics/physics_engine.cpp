@@ -3,11 +3,16 @@
  **/
 #include "physics/phyics_engine.hpp"
 
+#include <algorithm>
+
 #include <Jolt/Jolt.h>
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Memory.h>
 #include <Jolt/Core/Factory.h>
+#include <Jolt/Physics/PhysicsSettings.h>
 
+#include "core/config_keys.hpp"
+#include "core/logger.hpp"
 #include "application/app_state.hpp"
 
 #include "physics/2D/physics_world_2d.hpp"
@@ -15,6 +20,11 @@
 namespace other {
   
   Ref<Scene> PhysicsEngine::scene_context = nullptr;
+  Scope<PhysicsJobSystem> PhysicsEngine::job_system = nullptr;
+  Scope<TempAllocatorPool> PhysicsEngine::temp_allocators = nullptr;
+
+  uint32_t PhysicsEngine::step_rate = kDefaultPhysicsStepRate;
+  uint32_t PhysicsEngine::max_sub_steps = kDefaultPhysicsMaxSubSteps;
 
   void PhysicsEngine::Initialize(const ConfigTable& config) {
     JPH::RegisterDefaultAllocator(); 
@@ -28,9 +38,24 @@ namespace other {
     /// Register user types from config table
 
     JPH::RegisterTypes();
+
+    step_rate = config.GetVal<uint32_t>(kPhysicsValue , kStepRateValue , false).value_or(kDefaultPhysicsStepRate);
+    max_sub_steps = config.GetVal<uint32_t>(kPhysicsValue , kMaxSubStepsValue , false).value_or(kDefaultPhysicsMaxSubSteps);
+    step_rate = std::max(step_rate , 1u);
+    max_sub_steps = std::max(max_sub_steps , 1u);
+
+    ThreadPool* pool = ThreadPool::Get();
+    OE_ASSERT(pool != nullptr , "Physics engine initialized before the engine thread pool");
+    job_system = NewScope<PhysicsJobSystem>(*pool , JPH::cMaxPhysicsJobs , JPH::cMaxPhysicsBarriers);
+
+    uint32_t temp_mb = config.GetVal<uint32_t>(kPhysicsValue , kTempAllocatorValue , false).value_or(kDefaultPhysicsTempAllocatorMb);
+    temp_allocators = NewScope<TempAllocatorPool>(std::max(temp_mb , 1u) * 1024 * 1024);
   }
 
   void PhysicsEngine::Shutdown() {
+    job_system = nullptr;
+    temp_allocators = nullptr;
+
     JPH::UnregisterTypes();
 
     delete JPH::Factory::sInstance;
@@ -50,7 +75,37 @@ namespace other {
   }
 
   Ref<PhysicsWorld> PhysicsEngine::GetPhysicsWorld() {
-    return Ref<PhysicsWorld>::Create();
+    OE_ASSERT(job_system != nullptr , "Creating a physics world before the physics engine was initialized");
+    return Ref<PhysicsWorld>::Create(job_system.get() , temp_allocators.get());
+  }
+      
+  JPH::JobSystem* PhysicsEngine::GetJobSystem() {
+    return job_system.get();
+  }
+      
+  TempAllocatorPool* PhysicsEngine::GetTempAllocators() {
+    return temp_allocators.get();
+  }
+
+  ThreadPoolStats PhysicsEngine::GetJobStats() {
+    if (job_system == nullptr) {
+      return {};
+    }
+    return job_system->Stats();
+  }
+
+  void PhysicsEngine::ResetJobStats() {
+    if (job_system != nullptr) {
+      job_system->ResetStats();
+    }
+  }
+
+  uint32_t PhysicsEngine::StepRate() {
+    return step_rate;
+  }
+
+  uint32_t PhysicsEngine::MaxSubSteps() {
+    return max_sub_steps;
   }
 
 } // namespace other
@@ -0,0 +1,110 @@
+/**
+ * \file physics/physics_queries.cpp
+ **/
+#include "physics/physics_queries.hpp"
+
+#include <numeric>
+
+#include "core/logger.hpp"
+#include "core/thread_pool.hpp"
+
+namespace other {
+
+  std::span<PhysicsQueryHit> PhysicsQueryResults::Slot(uint32_t query) const {
+    OE_ASSERT(query < num_queries , "Physics query {} out of range of results for {} queries" , query , num_queries);
+    return { hits + static_cast<size_t>(query) * max_hits_per_query , max_hits_per_query };
+  }
+
+  float PhysicsQueryResults::Insert(const PhysicsQueryHit& hit) const {
+    if (max_hits_per_query == 0) {
+      return 0.f;
+    }
+
+    std::span<PhysicsQueryHit> slot = Slot(hit.query);
+    uint32_t& count = counts[hit.query];
+
+    uint32_t pos = count;
+    for (uint32_t i = 0; i < count; ++i) {
+      if (slot[i].user_data != hit.user_data) {
+        continue;
+      }
+
+      if (slot[i].fraction <= hit.fraction) {
+        return count == max_hits_per_query ? slot[count - 1].fraction : 1.f;
+      }
+
+      pos = i;
+      break;
+    }
+
+    if (pos == count) {
+      if (count < max_hits_per_query) {
+        ++count;
+      } else if (hit.fraction < slot[count - 1].fraction) {
+        pos = count - 1;
+      } else {
+        return slot[count - 1].fraction;
+      }
+    }
+
+    /// the slot stays sorted, shift everything further than the new hit back by one
+    for (; pos > 0 && slot[pos - 1].fraction > hit.fraction; --pos) {
+      slot[pos] = slot[pos - 1];
+    }
+    slot[pos] = hit;
+
+    return count == max_hits_per_query ? slot[count - 1].fraction : 1.f;
+  }
+
+  bool PhysicsQueryResults::Full(uint32_t query) const {
+    return counts[query] >= max_hits_per_query;
+  }
+
+  void PhysicsQueryBuffer::Reset(uint32_t num_queries , uint32_t max_hits_per_query) {
+    this->max_hits_per_query = max_hits_per_query;
+    hits.resize(static_cast<size_t>(num_queries) * max_hits_per_query);
+    counts.assign(num_queries , 0);
+  }
+
+  PhysicsQueryResults PhysicsQueryBuffer::Results() {
+    return PhysicsQueryResults {
+      .hits = hits.data() ,
+      .counts = counts.data() ,
+      .num_queries = NumQueries() ,
+      .max_hits_per_query = max_hits_per_query ,
+    };
+  }
+
+  uint32_t PhysicsQueryBuffer::NumQueries() const {
+    return static_cast<uint32_t>(counts.size());
+  }
+
+  uint32_t PhysicsQueryBuffer::NumHits(uint32_t query) const {
+    return counts[query];
+  }
+
+  uint32_t PhysicsQueryBuffer::TotalHits() const {
+    return std::accumulate(counts.begin() , counts.end() , 0u);
+  }
+
+  std::span<const PhysicsQueryHit> PhysicsQueryBuffer::Hits(uint32_t query) const {
+    return { hits.data() + static_cast<size_t>(query) * max_hits_per_query , counts[query] };
+  }
+
+  void DispatchPhysicsQueries(uint32_t count , const std::function<void(uint32_t)>& query) {
+    auto run_range = [&query](uint32_t begin , uint32_t end) {
+      for (uint32_t i = begin; i < end; ++i) {
+        query(i);
+      }
+    };
+
+    ThreadPool* pool = ThreadPool::Get();
+    if (pool == nullptr) {
+      run_range(0 , count);
+      return;
+    }
+
+    pool->ParallelFor(count , kPhysicsQueryGrain , run_range);
+  }
+
+} // namespace other
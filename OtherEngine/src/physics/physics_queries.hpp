@@ -0,0 +1,118 @@
+/**
+ * \file physics/physics_queries.hpp
+ **/
+#ifndef OTHER_ENGINE_PHYSICS_QUERIES_HPP
+#define OTHER_ENGINE_PHYSICS_QUERIES_HPP
+
+#include <functional>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "core/defines.hpp"
+
+namespace other {
+
+  enum PhysicsQueryShapeType : uint32_t {
+    SPHERE_QUERY_SHAPE = 0 ,
+    BOX_QUERY_SHAPE ,
+
+    NUM_QUERY_SHAPES ,
+    INVALID_QUERY_SHAPE = NUM_QUERY_SHAPES ,
+  };
+
+  /**
+   * every query struct here is plain data with 4 byte fields so scripts can hand over arrays of them without copying
+   *
+   * 2D worlds read x and y and ignore z, spheres become circles
+   **/
+  struct PhysicsQueryShape {
+    PhysicsQueryShapeType type = SPHERE_QUERY_SHAPE;
+
+    /// radius in x for spheres, half extents for boxes
+    glm::vec3 extent{ 0.5f };
+  };
+
+  struct RaycastQuery {
+    glm::vec3 origin{ 0.f };
+    glm::vec3 direction{ 0.f , -1.f , 0.f };
+    float max_distance = 1.f;
+  };
+
+  struct ShapeCastQuery {
+    PhysicsQueryShape shape;
+    glm::vec3 origin{ 0.f };
+    glm::vec3 direction{ 0.f , -1.f , 0.f };
+    float max_distance = 1.f;
+  };
+
+  struct OverlapQuery {
+    PhysicsQueryShape shape;
+    glm::vec3 center{ 0.f };
+  };
+
+  /// user_data is whatever the body was created with, scenes use the entity handle
+  struct PhysicsQueryHit {
+    uint64_t user_data = 0;
+    glm::vec3 point{ 0.f };
+    glm::vec3 normal{ 0.f };
+
+    /// distance along the cast as a fraction of max_distance, 0 for overlaps
+    float fraction = 0.f;
+    uint32_t query = 0;
+  };
+
+  /**
+   * non-owning view of the memory a batch writes into, query i owns hits [i * max_hits_per_query , (i + 1) *
+   *   max_hits_per_query) and writes how many of them it used to counts[i]
+   *
+   * queries keep the closest hits sorted by fraction with at most one hit per body
+   **/
+  struct PhysicsQueryResults {
+    PhysicsQueryHit* hits = nullptr;
+    uint32_t* counts = nullptr;
+    uint32_t num_queries = 0;
+    uint32_t max_hits_per_query = 0;
+
+    std::span<PhysicsQueryHit> Slot(uint32_t query) const;
+
+    /**
+     * inserts hit into the slot of hit.query keeping the closest max_hits_per_query, a body already in the slot keeps
+     *   whichever of its hits is closer
+     *
+     * returns the fraction a cast can stop at, anything further can no longer make it into a full slot
+     **/
+    float Insert(const PhysicsQueryHit& hit) const;
+
+    bool Full(uint32_t query) const;
+  };
+
+  /// caller owned arena for batched queries, Reset keeps its memory so a batch per frame stops allocating
+  class PhysicsQueryBuffer {
+    public:
+      void Reset(uint32_t num_queries , uint32_t max_hits_per_query);
+
+      PhysicsQueryResults Results();
+
+      uint32_t NumQueries() const;
+      uint32_t NumHits(uint32_t query) const;
+      uint32_t TotalHits() const;
+
+      std::span<const PhysicsQueryHit> Hits(uint32_t query) const;
+
+    private:
+      std::vector<PhysicsQueryHit> hits;
+      std::vector<uint32_t> counts;
+      uint32_t max_hits_per_query = 0;
+  };
+
+  /// queries handed to one worker at a time
+  constexpr static uint32_t kPhysicsQueryGrain = 64;
+
+  /// runs query(i) for every i in [0 , count) across the engine thread pool, inline when there is no pool
+  void DispatchPhysicsQueries(uint32_t count , const std::function<void(uint32_t)>& query);
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_PHYSICS_QUERIES_HPP
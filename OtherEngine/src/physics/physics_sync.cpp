@@ -0,0 +1,265 @@
+/**
+ * \file physics/physics_sync.cpp
+ **/
+#include "physics/physics_sync.hpp"
+
+#include <algorithm>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include "core/time.hpp"
+#include "core/profile.hpp"
+
+#include "ecs/components/transform.hpp"
+#include "ecs/components/rigid_body.hpp"
+#include "ecs/components/rigid_body_2d.hpp"
+
+namespace other {
+namespace {
+
+  double ElapsedMs(time::TimePoint start) {
+    return std::chrono::duration<double , std::milli>(time::Clock::now() - start).count();
+  }
+
+  void WriteTransform(Transform& transform , const glm::vec3& position , const glm::quat& rotation) {
+    transform.position = position;
+    transform.erotation = glm::eulerAngles(rotation);
+    transform.CalcMatrix();
+  }
+
+  void WriteTransform2D(Transform& transform , const glm::vec2& position , float angle) {
+    transform.position.x = position.x;
+    transform.position.y = position.y;
+    transform.erotation.z = angle;
+    transform.CalcMatrix();
+  }
+
+} // anonymous namespace
+
+  FixedTimestep::FixedTimestep(uint32_t rate , uint32_t max_steps) 
+      : step(1.f / static_cast<float>(std::max(rate , 1u))) , max_steps(std::max(max_steps , 1u)) {}
+
+  uint32_t FixedTimestep::Advance(float dt) {
+    accumulator += std::max(dt , 0.f);
+
+    uint32_t steps = static_cast<uint32_t>(accumulator / step);
+    if (steps > max_steps) {
+      steps = max_steps;
+      accumulator = 0.f;
+    } else {
+      accumulator -= static_cast<float>(steps) * step;
+    }
+
+    return steps;
+  }
+
+  float FixedTimestep::Step() const {
+    return step;
+  }
+
+  float FixedTimestep::Alpha() const {
+    return std::clamp(accumulator / step , 0.f , 1.f);
+  }
+
+  void FixedTimestep::Reset() {
+    accumulator = 0.f;
+  }
+
+  PhysicsSyncStats PhysicsSync::Update(entt::registry& registry , PhysicsWorld* world , PhysicsWorld2D* world_2d , float dt) {
+    OE_PROFILE_SCOPE("PhysicsSync::Update");
+
+    PhysicsSyncStats stats;
+    stats.steps = timestep.Advance(dt);
+    stats.alpha = timestep.Alpha();
+
+    const uint64_t frame_first_step = step_count + 1;
+    const bool stepped = stats.steps > 0;
+
+    if (world != nullptr) {
+      for (uint32_t i = 0; i < stats.steps; ++i) {
+        time::TimePoint start = time::Clock::now();
+        world->Simulate(timestep.Step());
+        stats.step_ms += ElapsedMs(start);
+
+        start = time::Clock::now();
+        Step3D(registry , world , frame_first_step , frame_first_step + i);
+        stats.sync_ms += ElapsedMs(start);
+      }
+    }
+
+    if (world_2d != nullptr) {
+      for (uint32_t i = 0; i < stats.steps; ++i) {
+        time::TimePoint start = time::Clock::now();
+        world_2d->Step(timestep.Step() , 32 , 2);
+        stats.step_ms += ElapsedMs(start);
+
+        start = time::Clock::now();
+        Step2D(registry , world_2d , frame_first_step , frame_first_step + i);
+        stats.sync_ms += ElapsedMs(start);
+      }
+    }
+
+    step_count += stats.steps;
+
+    time::TimePoint start = time::Clock::now();
+    Interpolate3D(registry , stats.alpha , frame_first_step , stepped);
+    Interpolate2D(registry , stats.alpha , frame_first_step , stepped);
+    stats.sync_ms += ElapsedMs(start);
+
+    stats.synced_bodies = static_cast<uint32_t>(interpolating.size() + interpolating_2d.size());
+    return stats;
+  }
+
+  void PhysicsSync::Reset() {
+    timestep.Reset();
+    step_count = 0;
+    states.clear();
+    interpolating.clear();
+    interpolating_2d.clear();
+    moved.clear();
+    moved_2d.clear();
+  }
+
+  void PhysicsSync::Step3D(entt::registry& registry , PhysicsWorld* world , uint64_t frame_first_step , uint64_t step) {
+    OE_PROFILE_SCOPE("PhysicsSync::Step3D");
+
+    world->GetActiveBodyStates(states);
+
+    for (const auto& state : states) {
+      entt::entity entity = static_cast<entt::entity>(state.user_data);
+      if (!registry.valid(entity)) {
+        continue;
+      }
+
+      RigidBody* body = registry.try_get<RigidBody>(entity);
+      if (body == nullptr) {
+        continue;
+      }
+
+      /// first step this frame that moved the body, it has to be blended
+      if (body->last_active_step < frame_first_step) {
+        moved.push_back(entity);
+      }
+
+      body->prev_position = body->curr_position;
+      body->prev_rotation = body->curr_rotation;
+      body->curr_position = state.position;
+      body->curr_rotation = state.rotation;
+      body->last_active_step = step;
+    }
+  }
+
+  void PhysicsSync::Step2D(entt::registry& registry , PhysicsWorld2D* world , uint64_t frame_first_step , uint64_t step) {
+    OE_PROFILE_SCOPE("PhysicsSync::Step2D");
+
+    for (b2Body* b = world->GetBodyList(); b != nullptr; b = b->GetNext()) {
+      if (b->GetType() == b2_staticBody || !b->IsAwake()) {
+        continue;
+      }
+
+      entt::entity entity = static_cast<entt::entity>(b->GetUserData().pointer);
+      if (!registry.valid(entity)) {
+        continue;
+      }
+
+      RigidBody2D* body = registry.try_get<RigidBody2D>(entity);
+      if (body == nullptr) {
+        continue;
+      }
+
+      if (body->last_active_step < frame_first_step) {
+        moved_2d.push_back(entity);
+      }
+
+      const b2Vec2& position = b->GetPosition();
+      body->prev_position = body->curr_position;
+      body->prev_angle = body->curr_angle;
+      body->curr_position = { position.x , position.y };
+      body->curr_angle = b->GetAngle();
+      body->last_active_step = step;
+    }
+  }
+
+  void PhysicsSync::Interpolate3D(entt::registry& registry , float alpha , uint64_t frame_first_step , bool stepped) {
+    OE_PROFILE_SCOPE("PhysicsSync::Interpolate3D");
+
+    if (stepped) {
+      /// bodies that were blending last frame but did not move in any step this frame have come to rest
+      for (entt::entity entity : interpolating) {
+        if (!registry.valid(entity) || !registry.all_of<RigidBody , Transform>(entity)) {
+          continue;
+        }
+
+        auto [body , transform] = registry.get<RigidBody , Transform>(entity);
+        if (body.last_active_step < frame_first_step) {
+          body.prev_position = body.curr_position;
+          body.prev_rotation = body.curr_rotation;
+          WriteTransform(transform , body.curr_position , body.curr_rotation);
+        }
+      }
+
+      /// bodies that fell asleep before the last step of this frame must not keep blending towards a stale pose
+      for (entt::entity entity : moved) {
+        auto& body = registry.get<RigidBody>(entity);
+        if (body.last_active_step != step_count) {
+          body.prev_position = body.curr_position;
+          body.prev_rotation = body.curr_rotation;
+        }
+      }
+
+      std::swap(interpolating , moved);
+      moved.clear();
+    }
+
+    for (entt::entity entity : interpolating) {
+      if (!registry.valid(entity) || !registry.all_of<RigidBody , Transform>(entity)) {
+        continue;
+      }
+
+      auto [body , transform] = registry.get<RigidBody , Transform>(entity);
+      WriteTransform(transform , glm::mix(body.prev_position , body.curr_position , alpha) , 
+                     glm::slerp(body.prev_rotation , body.curr_rotation , alpha));
+    }
+  }
+
+  void PhysicsSync::Interpolate2D(entt::registry& registry , float alpha , uint64_t frame_first_step , bool stepped) {
+    OE_PROFILE_SCOPE("PhysicsSync::Interpolate2D");
+
+    if (stepped) {
+      for (entt::entity entity : interpolating_2d) {
+        if (!registry.valid(entity) || !registry.all_of<RigidBody2D , Transform>(entity)) {
+          continue;
+        }
+
+        auto [body , transform] = registry.get<RigidBody2D , Transform>(entity);
+        if (body.last_active_step < frame_first_step) {
+          body.prev_position = body.curr_position;
+          body.prev_angle = body.curr_angle;
+          WriteTransform2D(transform , body.curr_position , body.curr_angle);
+        }
+      }
+
+      for (entt::entity entity : moved_2d) {
+        auto& body = registry.get<RigidBody2D>(entity);
+        if (body.last_active_step != step_count) {
+          body.prev_position = body.curr_position;
+          body.prev_angle = body.curr_angle;
+        }
+      }
+
+      std::swap(interpolating_2d , moved_2d);
+      moved_2d.clear();
+    }
+
+    for (entt::entity entity : interpolating_2d) {
+      if (!registry.valid(entity) || !registry.all_of<RigidBody2D , Transform>(entity)) {
+        continue;
+      }
+
+      auto [body , transform] = registry.get<RigidBody2D , Transform>(entity);
+      WriteTransform2D(transform , glm::mix(body.prev_position , body.curr_position , alpha) ,
+                       glm::mix(body.prev_angle , body.curr_angle , alpha));
+    }
+  }
+
+} // namespace other
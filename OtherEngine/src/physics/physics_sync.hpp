@@ -0,0 +1,94 @@
+/**
+ * \file physics/physics_sync.hpp
+ **/
+#ifndef OTHER_ENGINE_PHYSICS_SYNC_HPP
+#define OTHER_ENGINE_PHYSICS_SYNC_HPP
+
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "physics/physics_defines.hpp"
+#include "physics/2D/physics_world_2d.hpp"
+#include "physics/3D/physics_world.hpp"
+
+namespace other {
+
+  /// accumulates frame time and hands it out in fixed steps
+  class FixedTimestep {
+    public:
+      FixedTimestep(uint32_t rate = kDefaultPhysicsStepRate , uint32_t max_steps = kDefaultPhysicsMaxSubSteps);
+
+      /**
+       * adds dt (seconds) to the accumulator and returns how many steps to take this frame
+       *
+       * if more than max_steps are owed the extra time is dropped instead of carried, otherwise a slow frame makes the
+       *   next one slower until the simulation never catches up
+       **/
+      uint32_t Advance(float dt);
+
+      /// step length in seconds
+      float Step() const;
+
+      /// fraction of a step left in the accumulator, 0 means the last step landed exactly on this frame
+      float Alpha() const;
+
+      void Reset();
+
+    private:
+      float step;
+      uint32_t max_steps;
+      float accumulator = 0.f;
+  };
+
+  struct PhysicsSyncStats {
+    uint32_t steps = 0;
+    float alpha = 0.f;
+    double step_ms = 0.0;
+    double sync_ms = 0.0;
+    uint32_t synced_bodies = 0;
+  };
+
+  /**
+   * drives both physics worlds at a fixed rate and writes body poses back into Transforms
+   *
+   * after every step only bodies the simulation reports as awake are read, each keeps its pose from the previous
+   *   and current step, then once per frame the transforms of bodies that moved are set to a blend of the two by
+   *   the accumulator's alpha so rendering stays smooth when the frame rate and step rate disagree
+   *
+   * bodies are found through their physics user data, which holds the owning entt::entity
+   **/
+  class PhysicsSync {
+    public:
+      PhysicsSync(uint32_t rate = kDefaultPhysicsStepRate , uint32_t max_steps = kDefaultPhysicsMaxSubSteps)
+        : timestep(rate , max_steps) {}
+
+      /// either world may be null, dt is in seconds
+      PhysicsSyncStats Update(entt::registry& registry , PhysicsWorld* world , PhysicsWorld2D* world_2d , float dt);
+
+      void Reset();
+
+    private:
+      FixedTimestep timestep;
+      uint64_t step_count = 0;
+
+      std::vector<PhysicsBodyState> states;
+
+      /// entities whose transforms are blended each frame, rebuilt on frames that step
+      std::vector<entt::entity> interpolating;
+      std::vector<entt::entity> interpolating_2d;
+
+      /// entities moved by the steps of the current frame
+      std::vector<entt::entity> moved;
+      std::vector<entt::entity> moved_2d;
+
+      void Step3D(entt::registry& registry , PhysicsWorld* world , uint64_t frame_first_step , uint64_t step);
+      void Step2D(entt::registry& registry , PhysicsWorld2D* world , uint64_t frame_first_step , uint64_t step);
+
+      void Interpolate3D(entt::registry& registry , float alpha , uint64_t frame_first_step , bool stepped);
+      void Interpolate2D(entt::registry& registry , float alpha , uint64_t frame_first_step , bool stepped);
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_PHYSICS_SYNC_HPP
@@ -3,8 +3,6 @@
  **/
 #include "project/project.hpp"
 
-#include <filesystem>
-
 #include "core/config_keys.hpp"
 #include "core/filesystem.hpp"
 #include "core/logger.hpp"
@@ -98,6 +96,10 @@ namespace other {
     }
   }
 
+  Project::~Project() {
+    ReleaseScriptWatchers();
+  }
+
   Ref<Project> Project::Create(const CmdLine& cmdline, const ConfigTable& data) {
     return NewRef<Project>(cmdline, data);
   }
@@ -121,17 +123,6 @@ namespace other {
       metadata.directories[FNV(stem.string())] = d;
     }
 
-    Path editor_path = metadata.assets_dir / kEditorDirName;
-    Path scripts_path = metadata.assets_dir / kScriptsDirName;
-
-    OE_DEBUG("Creating Directory Watchers for Reloading");
-
-    metadata.cs_editor_watcher = NewScope<DirectoryWatcher>(editor_path.string(), ".cs");
-    metadata.cs_scripts_watcher = NewScope<DirectoryWatcher>(scripts_path.string(), ".cs");
-
-    metadata.lua_editor_watcher = NewScope<DirectoryWatcher>(editor_path.string(), ".lua");
-    metadata.lua_scripts_watcher = NewScope<DirectoryWatcher>(scripts_path.string(), ".lua");
-
     OE_DEBUG("Creating Script Watchers");
     CreateScriptWatchers();
   }
@@ -155,53 +146,62 @@ namespace other {
   }
 
   void Project::CreateScriptWatchers() {
-    if (metadata.filewatchers.size() > 0) {
-      metadata.filewatchers.clear();
+    ReleaseScriptWatchers();
+
+    FileWatcher* watcher = FileWatcher::Get();
+    if (watcher == nullptr) {
+      OE_WARN("No engine file watcher , script changes will not be picked up");
+      return;
     }
 
     Path editor_path = metadata.assets_dir / kEditorDirName;
     Path scripts_path = metadata.assets_dir / kScriptsDirName;
 
-    CreateFileWatchers(editor_path);
-    CreateFileWatchers(scripts_path);
+    if (Filesystem::IsDirectory(editor_path)) {
+      metadata.editor_watch = watcher->Watch(editor_path, { ".cs", ".lua" });
+    } else {
+      OE_ERROR("Creating script watcher for non-existent directory {}", editor_path);
+    }
+
+    if (Filesystem::IsDirectory(scripts_path)) {
+      metadata.scripts_watch = watcher->Watch(scripts_path, { ".cs", ".lua" });
+    } else {
+      OE_ERROR("Creating script watcher for non-existent directory {}", scripts_path);
+    }
   }
 
   bool Project::EditorDirectoryChanged() {
-    OE_ASSERT(metadata.cs_editor_watcher != nullptr && metadata.lua_editor_watcher != nullptr, "Project editor watchdog nullptr!");
-    return metadata.cs_editor_watcher->DirectoryChanged() ||
-      metadata.lua_editor_watcher->DirectoryChanged();
+    FileWatcher* watcher = FileWatcher::Get();
+    return watcher != nullptr && watcher->Consume(metadata.editor_watch, kFileStructureChanges) != 0;
   }
 
   bool Project::ScriptDirectoryChanged() {
-    OE_ASSERT(metadata.cs_scripts_watcher != nullptr && metadata.lua_scripts_watcher != nullptr, "Project scripts watchdog nullptr!");
-    return metadata.cs_scripts_watcher->DirectoryChanged() ||
-      metadata.lua_scripts_watcher->DirectoryChanged();
+    FileWatcher* watcher = FileWatcher::Get();
+    return watcher != nullptr && watcher->Consume(metadata.scripts_watch, kFileStructureChanges) != 0;
   }
 
   bool Project::AnyScriptChanged() {
-    for (const auto& fw : metadata.filewatchers) {
-      if (fw->ChangedSinceLastCheck()) {
-        return true;
-      }
+    FileWatcher* watcher = FileWatcher::Get();
+    if (watcher == nullptr) {
+      return false;
     }
 
-    return false;
+    /// consume both so an edit in one directory is not reported again on the next check
+    const uint32_t modified = FileChangeBit(FileChangeType::MODIFIED);
+    const bool editor_changed = watcher->Consume(metadata.editor_watch, modified) != 0;
+    const bool scripts_changed = watcher->Consume(metadata.scripts_watch, modified) != 0;
+    return editor_changed || scripts_changed;
   }
 
-  void Project::CreateFileWatchers(const Path& dirpath) {
-    if (!Filesystem::PathExists(dirpath)) {
-      OE_ERROR("Creating file watchers for non-existent directory {}", dirpath);
-      return;
-    } else if (!Filesystem::IsDirectory(dirpath)) {
-      OE_ERROR("CreateFileWatchers param must be a directory. {} is a file.", dirpath);
-      return;
+  void Project::ReleaseScriptWatchers() {
+    FileWatcher* watcher = FileWatcher::Get();
+    if (watcher != nullptr) {
+      watcher->Unwatch(metadata.editor_watch);
+      watcher->Unwatch(metadata.scripts_watch);
     }
 
-    for (auto entry : std::filesystem::recursive_directory_iterator(dirpath)) {
-      if (entry.is_regular_file() && (entry.path().extension() == ".cs" || entry.path().extension() == ".lua")) {
-        metadata.filewatchers.push_back(NewScope<FileWatcher>(entry.path().string()));
-      }
-    }
+    metadata.editor_watch = kInvalidFileWatch;
+    metadata.scripts_watch = kInvalidFileWatch;
   }
 
   void Project::QueueNewProject(const std::string& path) {
@@ -12,7 +12,6 @@
 #include "core/ref.hpp"
 #include "core/config.hpp"
 #include "core/directory.hpp"
-#include "core/directory_watcher.hpp"
 #include "core/file_watcher.hpp"
 
 #include "parsing/cmd_line_parser.hpp"
@@ -75,19 +74,15 @@ namespace other {
 
     std::map<UUID , Ref<Directory>> directories{};
 
-    std::vector<Scope<FileWatcher>> filewatchers;
-
-    Scope<DirectoryWatcher> cs_editor_watcher = nullptr;
-    Scope<DirectoryWatcher> lua_editor_watcher = nullptr;
-
-    Scope<DirectoryWatcher> cs_scripts_watcher = nullptr;
-    Scope<DirectoryWatcher> lua_scripts_watcher = nullptr;
+    /// .cs and .lua files under assets/editor and assets/scripts , registered with the engine FileWatcher
+    FileWatchId editor_watch = kInvalidFileWatch;
+    FileWatchId scripts_watch = kInvalidFileWatch;
   };
   
   class Project : public RefCounted {
     public:
       Project(const CmdLine& cmdline , const ConfigTable& config);
-      virtual ~Project() override {}
+      virtual ~Project() override;
 
       static Ref<Project> Create(const CmdLine& cmdline , const ConfigTable& data);
 
@@ -112,8 +107,8 @@ namespace other {
 
     private:
       ProjectMetadata metadata;
-      
-      void CreateFileWatchers(const Path& dirpath);
+
+      void ReleaseScriptWatchers();
 
     public:
       static void QueueNewProject(const std::string& path);
@@ -7,6 +7,7 @@
 #include <string>
 
 #include <glm/glm.hpp>
+#include <reflection/echo_defines.hpp>
 
 #include "core/ref.hpp"
 #include "core/ref_counted.hpp"
@@ -146,4 +147,35 @@ namespace other {
 
 } // namespace other
 
+/// the projection type picks the concrete camera , it is not a property
+ECHO_TYPE(
+  type(other::CameraBase) ,
+  func(Position , property("position")) ,
+  func(SetPosition , property("position")) ,
+  func(Direction , property("direction")) ,
+  func(SetDirection , property("direction")) ,
+  func(Up , property("up")) ,
+  func(SetUp , property("up")) ,
+  func(Right , property("right")) ,
+  func(SetRight , property("right")) ,
+  func(WorldUp , property("world-up")) ,
+  func(SetWorldUp , property("world-up")) ,
+  func(Orientation , property("rotation")) ,
+  func(SetOrientation , property("rotation")) ,
+  func(Viewport , property("viewport")) ,
+  func(SetViewport , property("viewport")) ,
+  func(Clip , property("clip")) ,
+  func(SetClip , property("clip")) ,
+  func(Speed , property("speed")) ,
+  func(SetSpeed , property("speed")) ,
+  func(Sensitivity , property("sensitivity")) ,
+  func(SetSensitivity , property("sensitivity")) ,
+  func(FOV , property("fov")) ,
+  func(SetFov , property("fov")) ,
+  func(Zoom , property("zoom")) ,
+  func(SetZoom , property("zoom")) ,
+  func(ConstrainPitch , property("constrain-pitch")) ,
+  func(SetConstrainPitch , property("constrain-pitch"))
+);
+
 #endif // !OTHER_ENGINE_CAMERA_BASE_HPP
@@ -0,0 +1,265 @@
+/**
+ * \file rendering/draw_list.cpp
+ **/
+#include "rendering/draw_list.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+
+#include "core/logger.hpp"
+#include "core/profile.hpp"
+#include "core/thread_pool.hpp"
+
+namespace other {
+namespace {
+
+  constexpr static uint32_t kDrawKeyModelShift = 64 - kDrawKeyModelBits;
+  constexpr static uint32_t kDrawKeyDepthShift = kDrawKeyModelShift - 32;
+
+  constexpr static uint32_t kRadixBits = 8;
+  constexpr static uint32_t kRadixBuckets = 1u << kRadixBits;
+  constexpr static uint32_t kRadixPasses = 64 / kRadixBits;
+
+  int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  double MsSince(int64_t start_ns) {
+    return static_cast<double>(NowNs() - start_ns) / 1e6;
+  }
+
+} // anonymous namespace
+
+  uint64_t DrawSortKey(uint32_t model , float view_depth) {
+    /// non-negative floats order the same as their bits, anything behind the eye sorts first
+    const uint32_t depth_bits = std::bit_cast<uint32_t>(std::max(view_depth , 0.f));
+    return (static_cast<uint64_t>(model) << kDrawKeyModelShift) | (static_cast<uint64_t>(depth_bits) << kDrawKeyDepthShift);
+  }
+
+  void RadixSortDrawItems(std::vector<DrawItem>& items , std::vector<DrawItem>& scratch) {
+    if (items.size() < 2) {
+      return;
+    }
+
+    /// every histogram in one read of the keys
+    std::array<std::array<uint32_t , kRadixBuckets> , kRadixPasses> histograms{};
+    for (const auto& item : items) {
+      for (uint32_t p = 0; p < kRadixPasses; ++p) {
+        ++histograms[p][(item.sort_key >> (p * kRadixBits)) & (kRadixBuckets - 1)];
+      }
+    }
+
+    scratch.resize(items.size());
+    for (uint32_t p = 0; p < kRadixPasses; ++p) {
+      auto& histogram = histograms[p];
+      const uint32_t shift = p * kRadixBits;
+
+      const uint32_t first_digit = (items.front().sort_key >> shift) & (kRadixBuckets - 1);
+      if (histogram[first_digit] == items.size()) {
+        continue;
+      }
+
+      uint32_t offset = 0;
+      for (auto& bucket : histogram) {
+        const uint32_t count = bucket;
+        bucket = offset;
+        offset += count;
+      }
+
+      for (const auto& item : items) {
+        scratch[histogram[(item.sort_key >> shift) & (kRadixBuckets - 1)]++] = item;
+      }
+      items.swap(scratch);
+    }
+  }
+
+  std::span<const DrawItem> DrawList::Items() const {
+    return items;
+  }
+
+  const std::vector<DrawModel>& DrawList::Models() const {
+    return models;
+  }
+
+  const DrawListStats& DrawList::Stats() const {
+    return stats;
+  }
+
+  void DrawList::BeginBuild(uint32_t count , const Opt<DrawView>& view) {
+    build_start_ns = NowNs();
+
+    stats = {};
+    stats.sources = count;
+    stats.chunks = (count + kDrawChunkSize - 1) / kDrawChunkSize;
+
+    /// lists are cleared rather than dropped so steady state frames do not allocate
+    if (chunk_items.size() < stats.chunks) {
+      chunk_handles.resize(stats.chunks);
+      chunk_items.resize(stats.chunks);
+    }
+    for (uint32_t c = 0; c < stats.chunks; ++c) {
+      chunk_handles[c].clear();
+      chunk_items[c].clear();
+    }
+    chunk_culled.assign(stats.chunks , 0);
+
+    model_slots.clear();
+    models.clear();
+    items.clear();
+
+    cull = view.has_value();
+    if (!cull) {
+      depth_row = glm::vec4{ 0.f };
+      return;
+    }
+
+    /// gribb-hartmann, rows of the view projection combine into the six clip planes
+    const glm::mat4 vp = view->projection * view->view;
+    const glm::vec4 row0{ vp[0][0] , vp[1][0] , vp[2][0] , vp[3][0] };
+    const glm::vec4 row1{ vp[0][1] , vp[1][1] , vp[2][1] , vp[3][1] };
+    const glm::vec4 row2{ vp[0][2] , vp[1][2] , vp[2][2] , vp[3][2] };
+    const glm::vec4 row3{ vp[0][3] , vp[1][3] , vp[2][3] , vp[3][3] };
+    planes = {
+      row3 + row0 , row3 - row0 ,
+      row3 + row1 , row3 - row1 ,
+      row3 + row2 , row3 - row2 ,
+    };
+    for (auto& plane : planes) {
+      plane /= glm::length(glm::vec3(plane));
+    }
+
+    /// view space looks down -z, depth is the negated z row
+    depth_row = -glm::vec4{ view->view[0][2] , view->view[1][2] , view->view[2][2] , view->view[3][2] };
+  }
+
+  void DrawList::EndBuild() {
+    OE_PROFILE_SCOPE("DrawList::Sort");
+
+    const int64_t sort_start_ns = NowNs();
+
+    size_t total = 0;
+    for (uint32_t c = 0; c < stats.chunks; ++c) {
+      total += chunk_items[c].size();
+      stats.culled += chunk_culled[c];
+    }
+
+    items.reserve(total);
+    for (uint32_t c = 0; c < stats.chunks; ++c) {
+      items.insert(items.end() , chunk_items[c].begin() , chunk_items[c].end());
+    }
+    RadixSortDrawItems(items , scratch);
+
+    stats.draws = static_cast<uint32_t>(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+      if (i == 0 || items[i].model != items[i - 1].model) {
+        ++stats.runs;
+      }
+    }
+
+    stats.sort_ms = MsSince(sort_start_ns);
+    stats.build_ms = MsSince(build_start_ns);
+    stats.collect_ms = stats.build_ms - stats.resolve_ms - stats.sort_ms;
+  }
+
+  void DrawList::ForEachChunk(uint32_t count , const std::function<void(uint32_t , uint32_t , uint32_t)>& fn) {
+    const uint32_t num_chunks = (count + kDrawChunkSize - 1) / kDrawChunkSize;
+    auto run_chunks = [&](uint32_t first , uint32_t last) {
+      for (uint32_t c = first; c < last; ++c) {
+        fn(c , c * kDrawChunkSize , std::min(count , (c + 1) * kDrawChunkSize));
+      }
+    };
+
+    ThreadPool* pool = ThreadPool::Get();
+    if (pool == nullptr || num_chunks < 2) {
+      run_chunks(0 , num_chunks);
+      return;
+    }
+
+    pool->ParallelFor(num_chunks , 1 , run_chunks);
+  }
+
+  void DrawList::SortUnique(std::vector<AssetHandle>& handles) {
+    std::sort(handles.begin() , handles.end() , [](const AssetHandle& a , const AssetHandle& b) {
+      return a.Get() < b.Get();
+    });
+    handles.erase(std::unique(handles.begin() , handles.end()) , handles.end());
+  }
+
+  void DrawList::ResolveModels(const ResolveFn& resolve) {
+    OE_PROFILE_SCOPE("DrawList::ResolveModels");
+
+    const int64_t start_ns = NowNs();
+
+    for (uint32_t c = 0; c < stats.chunks; ++c) {
+      for (const AssetHandle& handle : chunk_handles[c]) {
+        auto [itr , inserted] = model_slots.try_emplace(handle , kInvalidSlot);
+        if (!inserted) {
+          continue;
+        }
+
+        if (models.size() >= kMaxDrawModels) {
+          OE_WARN("Draw list out of model slots, {} unique models this frame" , models.size());
+          ++stats.unresolved;
+          continue;
+        }
+
+        Opt<DrawModel> model = resolve(handle);
+        if (!model.has_value()) {
+          ++stats.unresolved;
+          continue;
+        }
+
+        model->handle = handle;
+        itr->second = static_cast<uint32_t>(models.size());
+        models.push_back(*model);
+      }
+    }
+
+    stats.models = static_cast<uint32_t>(models.size());
+    stats.resolve_ms = MsSince(start_ns);
+  }
+
+  uint32_t DrawList::ModelSlot(AssetHandle handle) const {
+    auto itr = model_slots.find(handle);
+    if (itr == model_slots.end()) {
+      return kInvalidSlot;
+    }
+    return itr->second;
+  }
+
+  bool DrawList::PushDraw(std::vector<DrawItem>& list , uint32_t slot , uint32_t instance , const glm::mat4& transform) const {
+    const DrawModel& model = models[slot];
+    const glm::vec3 local_center = (model.bounds_min + model.bounds_max) * 0.5f;
+    const glm::vec4 center = transform * glm::vec4(local_center , 1.f);
+
+    if (cull) {
+      const glm::vec3 local_extent = (model.bounds_max - model.bounds_min) * 0.5f;
+      if (local_extent != glm::vec3{ 0.f }) {
+        /// world aabb of the transformed box, |M| * extent
+        const glm::mat3 abs_basis{
+          glm::abs(glm::vec3(transform[0])) ,
+          glm::abs(glm::vec3(transform[1])) ,
+          glm::abs(glm::vec3(transform[2])) ,
+        };
+        const glm::vec3 extent = abs_basis * local_extent;
+
+        for (const auto& plane : planes) {
+          const glm::vec3 normal{ plane };
+          if (glm::dot(normal , glm::vec3(center)) + plane.w + glm::dot(glm::abs(normal) , extent) < 0.f) {
+            return false;
+          }
+        }
+      }
+    }
+
+    list.push_back(DrawItem{
+      .sort_key = DrawSortKey(slot , glm::dot(depth_row , center)) ,
+      .model = slot ,
+      .instance = instance ,
+    });
+    return true;
+  }
+
+} // namespace other
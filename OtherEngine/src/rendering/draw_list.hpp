@@ -0,0 +1,198 @@
+/**
+ * \file rendering/draw_list.hpp
+ **/
+#ifndef OTHER_ENGINE_DRAW_LIST_HPP
+#define OTHER_ENGINE_DRAW_LIST_HPP
+
+#include <array>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "core/defines.hpp"
+#include "core/uuid.hpp"
+
+#include "asset/asset_types.hpp"
+
+#include "ecs/component.hpp"
+#include "ecs/components/transform.hpp"
+
+namespace other {
+
+  /// entities collected per job, each chunk fills its own list so workers never share one
+  constexpr static uint32_t kDrawChunkSize = 1024;
+
+  /// unique models a frame can sort, the model slot takes the top bits of the sort key
+  constexpr static uint32_t kDrawKeyModelBits = 24;
+  constexpr static uint32_t kMaxDrawModels = 1u << kDrawKeyModelBits;
+
+  /**
+   * one entity that survived culling, model is a slot in the draw list's model table and instance is the entity's
+   *   position in the group it was collected from
+   **/
+  struct DrawItem {
+    uint64_t sort_key = 0;
+    uint32_t model = 0;
+    uint32_t instance = 0;
+  };
+
+  /// what resolving an asset handle tells the draw list, bounds are local space and a zero extent is never culled
+  struct DrawModel {
+    AssetHandle handle;
+    glm::vec3 bounds_min{ 0.f };
+    glm::vec3 bounds_max{ 0.f };
+  };
+
+  struct DrawView {
+    glm::mat4 view = glm::mat4(1.f);
+    glm::mat4 projection = glm::mat4(1.f);
+  };
+
+  struct DrawListStats {
+    uint32_t sources = 0;
+    uint32_t models = 0;
+
+    /// unique handles the resolver rejected, every entity using one is skipped
+    uint32_t unresolved = 0;
+    uint32_t culled = 0;
+    uint32_t draws = 0;
+
+    /// consecutive draws sharing a model after sorting, what a pipeline sees as separate submissions
+    uint32_t runs = 0;
+    uint32_t chunks = 0;
+
+    double collect_ms = 0.0;
+    double resolve_ms = 0.0;
+    double sort_ms = 0.0;
+    double build_ms = 0.0;
+  };
+
+  /// model slot in the top bits so equal meshes end up next to each other , front to back view depth below it
+  uint64_t DrawSortKey(uint32_t model , float view_depth);
+
+  /// stable lsd radix sort on sort_key, passes whose byte is the same for every item are skipped
+  void RadixSortDrawItems(std::vector<DrawItem>& items , std::vector<DrawItem>& scratch);
+
+  /**
+   * per frame list of mesh draws built on the engine thread pool
+   *
+   * a build walks the group in fixed size chunks three times
+   *  - in parallel every chunk gathers the unique asset handles it uses
+   *  - serially each unique handle is resolved once, asset lookups may load and are not safe off the main thread
+   *  - in parallel every chunk culls its entities against the view and writes sort keys into its own list
+   *
+   * the chunk lists are then concatenated in chunk order and radix sorted, so the result does not depend on how
+   *   many workers ran or which chunk finished first
+   **/
+  class DrawList {
+    public:
+      /// returns the model's bounds, nullopt when the handle should not be drawn
+      using ResolveFn = std::function<Opt<DrawModel>(AssetHandle)>;
+
+      /// without a view nothing is culled and draws of a model keep the group's order, RC is not deducible through the
+      ///   group alias so callers name it
+      template <RenderableComp RC>
+      const DrawListStats& Build(const SystemGroup<RC , Transform>& group , const ResolveFn& resolve ,
+                                 const Opt<DrawView>& view = std::nullopt) {
+        const uint32_t count = static_cast<uint32_t>(group.size());
+        BeginBuild(count , view);
+
+        ForEachChunk(count , [&](uint32_t chunk , uint32_t begin , uint32_t end) {
+          std::vector<AssetHandle>& handles = chunk_handles[chunk];
+          for (uint32_t i = begin; i < end; ++i) {
+            const RC& mesh = group.template get<RC>(group[i]);
+            if (handles.empty() || handles.back() != mesh.handle) {
+              handles.push_back(mesh.handle);
+            }
+          }
+          SortUnique(handles);
+        });
+
+        ResolveModels(resolve);
+
+        ForEachChunk(count , [&](uint32_t chunk , uint32_t begin , uint32_t end) {
+          std::vector<DrawItem>& list = chunk_items[chunk];
+          AssetHandle last_handle = 0;
+          uint32_t last_slot = kInvalidSlot;
+          for (uint32_t i = begin; i < end; ++i) {
+            const auto& [mesh , transform] = group.template get<RC , Transform>(group[i]);
+            if (mesh.handle != last_handle || i == begin) {
+              last_handle = mesh.handle;
+              last_slot = ModelSlot(mesh.handle);
+            }
+
+            if (last_slot == kInvalidSlot) {
+              continue;
+            }
+
+            if (!PushDraw(list , last_slot , i , transform.model_transform)) {
+              ++chunk_culled[chunk];
+            }
+          }
+        });
+
+        EndBuild();
+        return stats;
+      }
+
+      std::span<const DrawItem> Items() const;
+      const std::vector<DrawModel>& Models() const;
+      const DrawListStats& Stats() const;
+
+      /// calls fn(model slot , items) for every run of sorted items sharing a model
+      template <typename Fn>
+      void ForEachRun(Fn&& fn) const {
+        size_t begin = 0;
+        while (begin < items.size()) {
+          size_t end = begin + 1;
+          while (end < items.size() && items[end].model == items[begin].model) {
+            ++end;
+          }
+
+          fn(items[begin].model , std::span<const DrawItem>(items.data() + begin , end - begin));
+          begin = end;
+        }
+      }
+
+    private:
+      constexpr static uint32_t kInvalidSlot = 0xFFFFFFFF;
+
+      std::vector<std::vector<AssetHandle>> chunk_handles;
+      std::vector<std::vector<DrawItem>> chunk_items;
+      std::vector<uint32_t> chunk_culled;
+
+      std::unordered_map<AssetHandle , uint32_t> model_slots;
+      std::vector<DrawModel> models;
+
+      std::vector<DrawItem> items;
+      std::vector<DrawItem> scratch;
+
+      /// frustum planes as (normal , distance) and the view matrix row giving view depth
+      bool cull = false;
+      std::array<glm::vec4 , 6> planes{};
+      glm::vec4 depth_row{ 0.f };
+
+      DrawListStats stats;
+      int64_t build_start_ns = 0;
+
+      void BeginBuild(uint32_t count , const Opt<DrawView>& view);
+      void EndBuild();
+
+      /// calls fn(chunk , begin , end) for every chunk of [0 , count) on the engine pool
+      void ForEachChunk(uint32_t count , const std::function<void(uint32_t , uint32_t , uint32_t)>& fn);
+
+      static void SortUnique(std::vector<AssetHandle>& handles);
+
+      void ResolveModels(const ResolveFn& resolve);
+      uint32_t ModelSlot(AssetHandle handle) const;
+
+      /// false when the instance was culled
+      bool PushDraw(std::vector<DrawItem>& list , uint32_t slot , uint32_t instance , const glm::mat4& transform) const;
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_DRAW_LIST_HPP
@@ -0,0 +1,260 @@
+/**
+ * \file rendering/frame_ring.cpp
+ **/
+#include "rendering/frame_ring.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include "core/logger.hpp"
+#include "rendering/rendering_defines.hpp"
+
+namespace other {
+namespace {
+
+  /// how long a single glClientWaitSync blocks before checking again, in nanoseconds
+  constexpr static GLuint64 kFenceTimeout = 1000000;
+
+  size_t AlignUp(size_t size , size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+  }
+
+} // anonymous namespace
+
+  GlFrameRingBackend::~GlFrameRingBackend() {
+    Release();
+  }
+
+  uint8_t* GlFrameRingBackend::Allocate(size_t frame_size , uint32_t num_frames) {
+    Release();
+
+    const size_t size = frame_size * num_frames;
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glGenBuffers(1 , &renderer_id);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER , renderer_id);
+    glBufferStorage(GL_SHADER_STORAGE_BUFFER , size , nullptr , flags);
+    CHECKGL();
+
+    mapped = static_cast<uint8_t*>(glMapBufferRange(GL_SHADER_STORAGE_BUFFER , 0 , size , flags));
+    CHECKGL();
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER , 0);
+
+    if (mapped == nullptr) {
+      OE_ERROR("Failed to persistently map frame ring of {} bytes" , size);
+      Release();
+      return nullptr;
+    }
+
+    fences.assign(num_frames , nullptr);
+    return mapped;
+  }
+
+  void GlFrameRingBackend::Release() {
+    for (uint32_t f = 0; f < fences.size(); ++f) {
+      WaitFrame(f);
+    }
+    fences.clear();
+
+    if (renderer_id == 0) {
+      return;
+    }
+
+    if (mapped != nullptr) {
+      glBindBuffer(GL_SHADER_STORAGE_BUFFER , renderer_id);
+      glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+      glBindBuffer(GL_SHADER_STORAGE_BUFFER , 0);
+      mapped = nullptr;
+    }
+
+    glDeleteBuffers(1 , &renderer_id);
+    renderer_id = 0;
+  }
+
+  void GlFrameRingBackend::WaitFrame(uint32_t frame) {
+    GLsync fence = static_cast<GLsync>(fences[frame]);
+    if (fence == nullptr) {
+      return;
+    }
+
+    GLenum result = glClientWaitSync(fence , GL_SYNC_FLUSH_COMMANDS_BIT , kFenceTimeout);
+    while (result == GL_TIMEOUT_EXPIRED) {
+      result = glClientWaitSync(fence , 0 , kFenceTimeout);
+    }
+
+    if (result == GL_WAIT_FAILED) {
+      OE_ERROR("Waiting on frame ring fence {} failed" , frame);
+    }
+
+    glDeleteSync(fence);
+    fences[frame] = nullptr;
+  }
+
+  void GlFrameRingBackend::FenceFrame(uint32_t frame) {
+    if (fences[frame] != nullptr) {
+      glDeleteSync(static_cast<GLsync>(fences[frame]));
+    }
+    fences[frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE , 0);
+  }
+
+  void GlFrameRingBackend::BindRange(uint32_t binding_point , size_t offset , size_t size) {
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER , binding_point , renderer_id , offset , size);
+  }
+
+  size_t GlFrameRingBackend::Alignment() const {
+    if (alignment == 0) {
+      GLint offset_alignment = 0;
+      glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT , &offset_alignment);
+      alignment = std::max<size_t>(offset_alignment , 16);
+    }
+    return alignment;
+  }
+
+  uint32_t GlFrameRingBackend::RendererId() const {
+    return renderer_id;
+  }
+
+  HostFrameRingBackend::HostFrameRingBackend(size_t alignment)
+      : alignment(std::max<size_t>(alignment , 1)) {
+  }
+
+  uint8_t* HostFrameRingBackend::Allocate(size_t frame_size , uint32_t num_frames) {
+    memory.assign(frame_size * num_frames , 0);
+    fenced.assign(num_frames , false);
+    return memory.data();
+  }
+
+  void HostFrameRingBackend::Release() {
+    memory.clear();
+    fenced.clear();
+  }
+
+  void HostFrameRingBackend::WaitFrame(uint32_t frame) {
+    if (fenced[frame]) {
+      ++num_waits;
+      fenced[frame] = false;
+    }
+  }
+
+  void HostFrameRingBackend::FenceFrame(uint32_t frame) {
+    fenced[frame] = true;
+  }
+
+  void HostFrameRingBackend::BindRange(uint32_t binding_point , size_t offset , size_t size) {
+  }
+
+  size_t HostFrameRingBackend::Alignment() const {
+    return alignment;
+  }
+
+  uint64_t HostFrameRingBackend::NumWaits() const {
+    return num_waits;
+  }
+
+  FrameRing::FrameRing(Scope<FrameRingBackend> backend , size_t frame_size , uint32_t num_frames)
+      : backend(std::move(backend)) , num_frames(std::max(num_frames , 1u)) {
+    OE_ASSERT(this->backend != nullptr , "Frame ring created without a backend");
+    Reallocate(frame_size);
+  }
+
+  FrameRing::~FrameRing() {
+    backend->Release();
+  }
+
+  void FrameRing::BeginFrame(size_t bytes_needed) {
+    OE_ASSERT(!in_frame , "Frame ring frame begun twice without EndFrame");
+
+    if (bytes_needed > frame_size) {
+      Reallocate(std::max(AlignedSize(bytes_needed) , frame_size * 2));
+    }
+
+    frame = (frame + 1) % num_frames;
+    backend->WaitFrame(frame);
+
+    cursor = 0;
+    in_frame = true;
+  }
+
+  void FrameRing::EndFrame() {
+    if (!in_frame) {
+      return;
+    }
+
+    backend->FenceFrame(frame);
+    stats.bytes_uploaded = cursor;
+    ++stats.frames;
+    in_frame = false;
+  }
+
+  Opt<FrameRingSlice> FrameRing::Allocate(size_t size) {
+    OE_ASSERT(in_frame , "Allocating from frame ring outside of a frame");
+
+    const size_t aligned = AlignedSize(size);
+    if (memory == nullptr || cursor + aligned > frame_size) {
+      OE_ERROR("Frame ring out of space, {} bytes requested with {} of {} left" , size , frame_size - cursor , frame_size);
+      return std::nullopt;
+    }
+
+    const size_t offset = static_cast<size_t>(frame) * frame_size + cursor;
+    cursor += aligned;
+    return FrameRingSlice{
+      .data = memory + offset ,
+      .buffer = backend->RendererId() ,
+      .offset = offset ,
+      .size = size ,
+    };
+  }
+
+  Opt<FrameRingSlice> FrameRing::Write(const void* data , size_t size) {
+    Opt<FrameRingSlice> slice = Allocate(size);
+    if (slice.has_value() && size > 0) {
+      std::memcpy(slice->data , data , size);
+    }
+    return slice;
+  }
+
+  void FrameRing::Bind(uint32_t binding_point , const FrameRingSlice& slice) {
+    backend->BindRange(binding_point , slice.offset , slice.size);
+  }
+
+  size_t FrameRing::AlignedSize(size_t size) const {
+    return AlignUp(size , backend->Alignment());
+  }
+
+  uint32_t FrameRing::CurrentFrame() const {
+    return frame;
+  }
+
+  size_t FrameRing::FrameCapacity() const {
+    return frame_size;
+  }
+
+  size_t FrameRing::BytesUploaded() const {
+    return cursor;
+  }
+
+  const FrameRingStats& FrameRing::Stats() const {
+    return stats;
+  }
+
+  void FrameRing::Reallocate(size_t new_frame_size) {
+    /// regions are carved from one buffer, so growing replaces the buffer and everything in flight must finish first
+    if (memory != nullptr) {
+      for (uint32_t f = 0; f < num_frames; ++f) {
+        backend->WaitFrame(f);
+      }
+      ++stats.reallocations;
+    }
+
+    frame_size = AlignedSize(std::max<size_t>(new_frame_size , 1));
+    memory = backend->Allocate(frame_size , num_frames);
+    if (memory == nullptr) {
+      frame_size = 0;
+    }
+
+    stats.frame_capacity = frame_size;
+  }
+
+} // namespace other
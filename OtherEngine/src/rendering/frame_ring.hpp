@@ -0,0 +1,174 @@
+/**
+ * \file rendering/frame_ring.hpp
+ **/
+#ifndef OTHER_ENGINE_FRAME_RING_HPP
+#define OTHER_ENGINE_FRAME_RING_HPP
+
+#include <span>
+#include <vector>
+
+#include "core/defines.hpp"
+
+namespace other {
+
+  /// frames the cpu may run ahead of the gpu before BeginFrame blocks
+  constexpr static uint32_t kFramesInFlight = 3;
+
+  /**
+   * storage behind a FrameRing, one buffer split into a region per frame in flight that stays mapped for the lifetime
+   *   of the allocation
+   *
+   * fences guard each region, a region is only written again after the gpu is done reading it
+   **/
+  class FrameRingBackend {
+    public:
+      virtual ~FrameRingBackend() {}
+
+      /// (re)creates storage for num_frames regions of frame_size bytes and returns the mapped memory, nullptr on failure
+      virtual uint8_t* Allocate(size_t frame_size , uint32_t num_frames) = 0;
+      virtual void Release() = 0;
+
+      /// blocks until the gpu finished with everything fenced for frame
+      virtual void WaitFrame(uint32_t frame) = 0;
+      virtual void FenceFrame(uint32_t frame) = 0;
+
+      /// offset is from the start of the whole buffer
+      virtual void BindRange(uint32_t binding_point , size_t offset , size_t size) = 0;
+
+      /// every slice handed out starts at a multiple of this
+      virtual size_t Alignment() const = 0;
+
+      /// api handle recorded commands bind slices through, 0 when there is no gpu buffer
+      virtual uint32_t RendererId() const { return 0; }
+  };
+
+  /// persistently mapped coherent shader storage buffer with a fence per frame
+  class GlFrameRingBackend : public FrameRingBackend {
+    public:
+      virtual ~GlFrameRingBackend() override;
+
+      virtual uint8_t* Allocate(size_t frame_size , uint32_t num_frames) override;
+      virtual void Release() override;
+
+      virtual void WaitFrame(uint32_t frame) override;
+      virtual void FenceFrame(uint32_t frame) override;
+
+      virtual void BindRange(uint32_t binding_point , size_t offset , size_t size) override;
+
+      virtual size_t Alignment() const override;
+
+      virtual uint32_t RendererId() const override;
+
+    private:
+      uint32_t renderer_id = 0;
+      uint8_t* mapped = nullptr;
+      mutable size_t alignment = 0;
+      std::vector<void*> fences;
+  };
+
+  /// plain memory with no gpu behind it, for headless runs and tests
+  class HostFrameRingBackend : public FrameRingBackend {
+    public:
+      HostFrameRingBackend(size_t alignment = 16);
+      virtual ~HostFrameRingBackend() override {}
+
+      virtual uint8_t* Allocate(size_t frame_size , uint32_t num_frames) override;
+      virtual void Release() override;
+
+      virtual void WaitFrame(uint32_t frame) override;
+      virtual void FenceFrame(uint32_t frame) override;
+
+      virtual void BindRange(uint32_t binding_point , size_t offset , size_t size) override;
+
+      virtual size_t Alignment() const override;
+
+      /// frames that were fenced and waited on before being reused
+      uint64_t NumWaits() const;
+
+    private:
+      size_t alignment;
+      std::vector<uint8_t> memory;
+      std::vector<bool> fenced;
+      uint64_t num_waits = 0;
+  };
+
+  /// piece of the current frame's region, offset is from the start of the whole buffer
+  struct FrameRingSlice {
+    uint8_t* data = nullptr;
+    uint32_t buffer = 0;
+    size_t offset = 0;
+    size_t size = 0;
+  };
+
+  struct FrameRingStats {
+    uint64_t frames = 0;
+
+    /// bytes written during the last finished frame
+    size_t bytes_uploaded = 0;
+    size_t frame_capacity = 0;
+
+    /// times the ring grew after its first allocation
+    uint32_t reallocations = 0;
+  };
+
+  /**
+   * linear allocator over a ring of per-frame regions, everything written for a frame goes into one region so
+   *   per-frame data is uploaded exactly once no matter how many passes read it
+   *
+   * a frame is BeginFrame , Allocate/Write as often as needed , EndFrame after the last draw reading the frame
+   **/
+  class FrameRing {
+    public:
+      FrameRing(Scope<FrameRingBackend> backend , size_t frame_size , uint32_t num_frames = kFramesInFlight);
+      ~FrameRing();
+
+      /**
+       * moves to the next region and waits for the gpu to release it
+       *
+       * when bytes_needed does not fit the ring waits for every frame in flight and grows, allocations that do not
+       *   fit after that fail
+       **/
+      void BeginFrame(size_t bytes_needed = 0);
+      void EndFrame();
+
+      Opt<FrameRingSlice> Allocate(size_t size);
+      Opt<FrameRingSlice> Write(const void* data , size_t size);
+
+      template <typename T>
+        requires std::is_trivially_copyable_v<T>
+      Opt<FrameRingSlice> Write(std::span<const T> values) {
+        return Write(values.data() , values.size_bytes());
+      }
+
+      void Bind(uint32_t binding_point , const FrameRingSlice& slice);
+
+      /// size rounded up to the backend alignment, what a slice of size bytes really takes from the frame
+      size_t AlignedSize(size_t size) const;
+
+      uint32_t CurrentFrame() const;
+      size_t FrameCapacity() const;
+
+      /// bytes written so far this frame
+      size_t BytesUploaded() const;
+
+      const FrameRingStats& Stats() const;
+
+    private:
+      Scope<FrameRingBackend> backend;
+
+      uint8_t* memory = nullptr;
+      size_t frame_size = 0;
+      uint32_t num_frames = 0;
+
+      uint32_t frame = 0;
+      size_t cursor = 0;
+      bool in_frame = false;
+
+      FrameRingStats stats;
+
+      void Reallocate(size_t new_frame_size);
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_FRAME_RING_HPP
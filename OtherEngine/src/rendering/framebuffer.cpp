@@ -45,32 +45,48 @@ namespace other {
     CHECKGL();
   }
       
-  void Framebuffer::BindFrame() {
+  void Framebuffer::BindFrame(RenderCommandBuffer& commands) {
     if (!fb_complete) {
       return;
     }
 
-    glBindFramebuffer(GL_FRAMEBUFFER , fbo);
-    glClearColor(spec.clear_color.x , spec.clear_color.y , spec.clear_color.z , spec.clear_color.w);
-    glClear(clear_flags);
-
-    glViewport(0 , 0 , spec.size.x , spec.size.y);
+    commands.Record(BindFramebufferCmd{
+      .framebuffer = fbo ,
+      .width = static_cast<uint32_t>(spec.size.x) ,
+      .height = static_cast<uint32_t>(spec.size.y) ,
+      .clear_mask = clear_flags ,
+      .clear_color = { spec.clear_color.x , spec.clear_color.y , spec.clear_color.z , spec.clear_color.w } ,
+    });
   }
 
-  void Framebuffer::UnbindFrame() {
+  void Framebuffer::UnbindFrame(RenderCommandBuffer& commands) {
     if (!fb_complete) {
       return;
     }
     
     if (spec.depth) {
-      glDisable(GL_DEPTH_TEST);
+      commands.Record(SetDepthStateCmd{ .test = false });
     }
 
-    glBindFramebuffer(GL_READ_FRAMEBUFFER , fbo);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER , intermediate_fbo);
-    glBlitFramebuffer(0 , 0 , spec.size.x , spec.size.y , 0 , 0 , spec.size.x , spec.size.y , clear_flags , GL_NEAREST);
+    commands.Record(BlitFramebufferCmd{
+      .read_framebuffer = fbo ,
+      .draw_framebuffer = intermediate_fbo ,
+      .width = static_cast<uint32_t>(spec.size.x) ,
+      .height = static_cast<uint32_t>(spec.size.y) ,
+      .mask = clear_flags ,
+    });
+  }
+
+  void Framebuffer::BindFrame() {
+    RenderCommandBuffer commands;
+    BindFrame(commands);
+    SubmitImmediate(commands);
+  }
 
-    glBindFramebuffer(GL_FRAMEBUFFER , 0);
+  void Framebuffer::UnbindFrame() {
+    RenderCommandBuffer commands;
+    UnbindFrame(commands);
+    SubmitImmediate(commands);
   }
 
   void Framebuffer::Draw() const {
@@ -10,6 +10,7 @@
 
 #include "core/ref_counted.hpp"
 
+#include "rendering/render_commands.hpp"
 #include "rendering/rendering_defines.hpp"
 
 namespace other {
@@ -23,6 +24,10 @@ namespace other {
 
       void Resize(const glm::vec2& size);
 
+      /// binds and clears the frame , UnbindFrame resolves it into the texture
+      void BindFrame(RenderCommandBuffer& commands);
+      void UnbindFrame(RenderCommandBuffer& commands);
+
       void BindFrame();
       void UnbindFrame();
 
@@ -80,24 +80,41 @@ namespace other {
     return valid;
   }
       
-  void GBuffer::Bind() const {
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-
-    glBindFramebuffer(GL_FRAMEBUFFER , gbuffer_id);
-    glClearColor(0.f , 0.f , 0.f , 1.f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    
-    shader->Bind();
+  void GBuffer::Bind(RenderCommandBuffer& commands) const {
+    commands.Record(SetDepthStateCmd{
+      .test = true ,
+      .func = GL_LESS ,
+    });
+    commands.Record(BindFramebufferCmd{
+      .framebuffer = gbuffer_id ,
+      .clear_mask = GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT ,
+      .clear_color = { 0.f , 0.f , 0.f , 1.f } ,
+    });
+    commands.Record(UseProgramCmd{ .program = shader != nullptr ? shader->ID() : 0 });
   }
 
-  void GBuffer::Unbind() const {
-    shader->Unbind();
-    glBindFramebuffer(GL_FRAMEBUFFER , 0);
+  void GBuffer::Unbind(RenderCommandBuffer& commands) const {
+    commands.Record(UseProgramCmd{ .program = 0 });
+    commands.Record(BindFramebufferCmd{ .framebuffer = 0 });
     for (uint32_t i = 0; i < NUM_TEX_IDXS; ++i) {
-      glActiveTexture(GL_TEXTURE0 + i);
-      glBindTexture(GL_TEXTURE_2D , textures[i]);
+      commands.Record(BindTextureCmd{
+        .unit = i ,
+        .target = GL_TEXTURE_2D ,
+        .texture = textures[i] ,
+      });
     }
   }
 
+  void GBuffer::Bind() const {
+    RenderCommandBuffer commands;
+    Bind(commands);
+    SubmitImmediate(commands);
+  }
+
+  void GBuffer::Unbind() const {
+    RenderCommandBuffer commands;
+    Unbind(commands);
+    SubmitImmediate(commands);
+  }
+
 } // namespace other
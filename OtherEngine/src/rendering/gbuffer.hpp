@@ -10,6 +10,7 @@
 
 #include "core/ref.hpp"
 
+#include "rendering/render_commands.hpp"
 #include "rendering/shader.hpp"
 
 namespace other {
@@ -35,6 +36,10 @@ namespace other {
 
       bool Valid() const;
 
+      /// binds and clears the gbuffer for the geometry draws , Unbind leaves its textures bound for the passes
+      void Bind(RenderCommandBuffer& commands) const;
+      void Unbind(RenderCommandBuffer& commands) const;
+
       void Bind() const;
       void Unbind() const;
 
@@ -17,7 +17,7 @@ namespace other {
         }) {
   }
 
-  void GeometryPass::SetRenderState() {
+  void GeometryPass::SetRenderState(SetDepthStateCmd& depth , SetStencilStateCmd& stencil) {
   }
 
 } // namespace other
@@ -16,7 +16,7 @@ namespace other {
       GeometryPass(const std::vector<Uniform>& uniforms , const Ref<Shader>& shader);
       virtual ~GeometryPass() override {}
 
-      virtual void SetRenderState() override;
+      virtual void SetRenderState(SetDepthStateCmd& depth , SetStencilStateCmd& stencil) override;
   };  
 
 } // namespace other
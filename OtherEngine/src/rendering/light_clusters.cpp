@@ -0,0 +1,337 @@
+/**
+ * \file rendering/light_clusters.cpp
+ **/
+#include "rendering/light_clusters.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#include "core/logger.hpp"
+#include "core/thread_pool.hpp"
+
+namespace other {
+namespace {
+
+  /// lights re-binned per job, binning one light is a few dozen flops so jobs need a lot of them
+  constexpr static uint32_t kLightBinGrain = 256;
+
+  void ParallelRange(uint32_t count , uint32_t grain , const std::function<void(uint32_t , uint32_t)>& fn) {
+    ThreadPool* pool = ThreadPool::Get();
+    if (pool == nullptr) {
+      fn(0 , count);
+      return;
+    }
+
+    pool->ParallelFor(count , grain , fn);
+  }
+
+  bool SphereIntersectsAabb(const glm::vec3& center , float radius , const glm::vec3& min , const glm::vec3& max) {
+    glm::vec3 closest = glm::clamp(center , min , max);
+    glm::vec3 d = center - closest;
+    return glm::dot(d , d) <= radius * radius;
+  }
+
+  uint16_t TileFromNdc(float ndc , uint32_t tiles) {
+    float tile = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(tiles));
+    return static_cast<uint16_t>(std::clamp(tile , 0.f , static_cast<float>(tiles - 1)));
+  }
+
+} // anonymous namespace
+
+  uint32_t LightClusterGrid::NumClusters() const {
+    return x * y * z;
+  }
+
+  bool LightClusters::LightBounds::Visible() const {
+    return min[0] <= max[0] && min[1] <= max[1] && min[2] <= max[2];
+  }
+
+  LightClusters::LightClusters(const LightClusterGrid& grid)
+      : grid(grid) {
+    OE_ASSERT(grid.x > 0 && grid.y > 0 && grid.z > 0 , "Light cluster grid must have at least one cluster per axis");
+    OE_ASSERT(grid.x <= std::numeric_limits<uint16_t>::max() && grid.y <= std::numeric_limits<uint16_t>::max() &&
+              grid.z <= std::numeric_limits<uint16_t>::max() , "Light cluster grid too large");
+
+    cluster_bounds.resize(grid.NumClusters());
+    clusters.resize(grid.NumClusters());
+    slices.resize(grid.z);
+    for (auto& slice : slices) {
+      slice.cursors.resize(grid.x * grid.y);
+    }
+  }
+
+  LightClusterStats LightClusters::Build(const Environment& environment , const glm::mat4& view , const glm::mat4& projection ,
+                                         const glm::vec2& clip) {
+    const auto start = std::chrono::steady_clock::now();
+
+    LightClusterStats stats;
+    stats.lights = static_cast<uint32_t>(environment.point_lights.size());
+
+    if (clip.x <= 0.f || clip.y <= clip.x) {
+      OE_WARN("Invalid clip planes ({} , {}) for light clustering" , clip.x , clip.y);
+      return stats;
+    }
+
+    const bool frustum_changed = !built || projection != this->projection || clip != this->clip;
+    const bool camera_changed = frustum_changed || view != this->view;
+
+    /// versions are only comparable within one environment, switching environments re-bins everything
+    const bool rebin_all = camera_changed || &environment != this->environment;
+    this->environment = &environment;
+    if (frustum_changed) {
+      this->projection = projection;
+      this->clip = clip;
+      log_near = std::log(clip.x);
+      log_depth_range = std::log(clip.y / clip.x);
+      BuildClusterBounds();
+    }
+    this->view = view;
+
+    /// a camera move changes every light's view space position, otherwise only what the environment touched moved
+    ///   and only the slices those lights left or entered have to be binned again
+    std::span<const uint64_t> versions = environment.PointLightVersions();
+    dirty_slices.assign(grid.z , rebin_all ? 1 : 0);
+    auto mark_slices = [this](const LightBounds& bounds) {
+      if (bounds.Visible()) {
+        std::fill(dirty_slices.begin() + bounds.min[2] , dirty_slices.begin() + bounds.max[2] + 1 , 1);
+      }
+    };
+
+    for (uint32_t i = stats.lights; i < light_bounds.size(); ++i) {
+      mark_slices(light_bounds[i]);
+    }
+    light_bounds.resize(stats.lights);
+
+    if (!rebin_all) {
+      dirty_lights.clear();
+      for (uint32_t i = 0; i < stats.lights; ++i) {
+        if (versions[i] > environment_version) {
+          dirty_lights.push_back(i);
+          mark_slices(light_bounds[i]);
+        }
+      }
+      stats.rebinned_lights = static_cast<uint32_t>(dirty_lights.size());
+
+      ParallelRange(stats.rebinned_lights , kLightBinGrain , [&](uint32_t begin , uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+          BinLight(environment.point_lights[dirty_lights[i]] , light_bounds[dirty_lights[i]]);
+        }
+      });
+
+      for (uint32_t light : dirty_lights) {
+        mark_slices(light_bounds[light]);
+      }
+    } else {
+      stats.rebinned_lights = stats.lights;
+      ParallelRange(stats.lights , kLightBinGrain , [&](uint32_t begin , uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+          BinLight(environment.point_lights[i] , light_bounds[i]);
+        }
+      });
+    }
+
+    environment_version = environment.Version();
+    built = true;
+
+    /// each slice owns its clusters so counting needs no synchronization, clean slices keep last build's pairs
+    ParallelRange(grid.z , 1 , [this](uint32_t begin , uint32_t end) {
+      for (uint32_t z = begin; z < end; ++z) {
+        if (dirty_slices[z]) {
+          BinSlice(z);
+        }
+      }
+    });
+    stats.rebinned_slices = static_cast<uint32_t>(std::count(dirty_slices.begin() , dirty_slices.end() , 1));
+
+    uint32_t offset = 0;
+    for (auto& cluster : clusters) {
+      cluster.offset = offset;
+      offset += cluster.count;
+    }
+    indices.resize(offset);
+
+    /// pairs were produced light by light, so each cluster's lights land in ascending order
+    ParallelRange(grid.z , 1 , [this](uint32_t begin , uint32_t end) {
+      for (uint32_t z = begin; z < end; ++z) {
+        SliceBin& bin = slices[z];
+        const uint32_t first_cluster = ClusterIndex(0 , 0 , z);
+        std::fill(bin.cursors.begin() , bin.cursors.end() , 0u);
+
+        for (const auto& [cluster , light] : bin.pairs) {
+          indices[clusters[cluster].offset + bin.cursors[cluster - first_cluster]++] = light;
+        }
+      }
+    });
+
+    stats.indices = offset;
+    stats.visible_lights = static_cast<uint32_t>(std::count_if(light_bounds.begin() , light_bounds.end() ,
+                                                               [](const LightBounds& b) { return b.Visible(); }));
+    stats.build_ms = std::chrono::duration<double , std::milli>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+  }
+
+  const LightClusterGrid& LightClusters::Grid() const {
+    return grid;
+  }
+
+  uint32_t LightClusters::ClusterIndex(uint32_t x , uint32_t y , uint32_t z) const {
+    return x + y * grid.x + z * grid.x * grid.y;
+  }
+
+  uint32_t LightClusters::DepthSlice(float depth) const {
+    if (depth <= clip.x) {
+      return 0;
+    }
+
+    float slice = std::floor((std::log(depth) - log_near) / log_depth_range * static_cast<float>(grid.z));
+    return static_cast<uint32_t>(std::clamp(slice , 0.f , static_cast<float>(grid.z - 1)));
+  }
+
+  glm::vec2 LightClusters::DepthSliceParams() const {
+    const float scale = static_cast<float>(grid.z) / log_depth_range;
+    return { scale , -log_near * scale };
+  }
+
+  std::span<const LightCluster> LightClusters::Clusters() const {
+    return clusters;
+  }
+
+  std::span<const uint32_t> LightClusters::LightIndices() const {
+    return indices;
+  }
+
+  std::span<const uint32_t> LightClusters::ClusterLights(uint32_t cluster) const {
+    const LightCluster& c = clusters[cluster];
+    return std::span<const uint32_t>(indices).subspan(c.offset , c.count);
+  }
+
+  void LightClusters::BuildClusterBounds() {
+    const glm::mat4 inv_projection = glm::inverse(projection);
+    auto unproject = [&inv_projection](float x , float y , float z) -> glm::vec3 {
+      glm::vec4 p = inv_projection * glm::vec4(x , y , z , 1.f);
+      return glm::vec3(p) / p.w;
+    };
+
+    std::vector<float> slice_depths(grid.z + 1);
+    for (uint32_t k = 0; k <= grid.z; ++k) {
+      slice_depths[k] = clip.x * std::pow(clip.y / clip.x , static_cast<float>(k) / static_cast<float>(grid.z));
+    }
+
+    const glm::vec2 tile_size = glm::vec2(2.f) / glm::vec2(grid.x , grid.y);
+    for (uint32_t y = 0; y < grid.y; ++y) {
+      for (uint32_t x = 0; x < grid.x; ++x) {
+        const glm::vec2 ndc_min = glm::vec2(-1.f) + glm::vec2(x , y) * tile_size;
+        const glm::vec2 ndc_max = ndc_min + tile_size;
+
+        /// rays through the tile corners from the near to the far plane, each slice cuts them at its two depths
+        glm::vec3 ray_start[4];
+        glm::vec3 ray_end[4];
+        const glm::vec2 corners[4] = {
+          ndc_min , { ndc_max.x , ndc_min.y } , { ndc_min.x , ndc_max.y } , ndc_max ,
+        };
+        for (uint32_t c = 0; c < 4; ++c) {
+          ray_start[c] = unproject(corners[c].x , corners[c].y , -1.f);
+          ray_end[c] = unproject(corners[c].x , corners[c].y , 1.f);
+        }
+
+        for (uint32_t z = 0; z < grid.z; ++z) {
+          ClusterBounds& bounds = cluster_bounds[ClusterIndex(x , y , z)];
+          bounds.min = glm::vec3(std::numeric_limits<float>::max());
+          bounds.max = glm::vec3(std::numeric_limits<float>::lowest());
+
+          for (float depth : { slice_depths[z] , slice_depths[z + 1] }) {
+            for (uint32_t c = 0; c < 4; ++c) {
+              const glm::vec3 dir = ray_end[c] - ray_start[c];
+              const float t = (-depth - ray_start[c].z) / dir.z;
+              const glm::vec3 p = ray_start[c] + t * dir;
+              bounds.min = glm::min(bounds.min , p);
+              bounds.max = glm::max(bounds.max , p);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void LightClusters::BinLight(const PointLight& light , LightBounds& bounds) const {
+    bounds = LightBounds{};
+    bounds.center = glm::vec3(view * glm::vec4(glm::vec3(light.position) , 1.f));
+    bounds.radius = light.radius;
+
+    const float depth = -bounds.center.z;
+    const float near_depth = depth - bounds.radius;
+    const float far_depth = depth + bounds.radius;
+    if (bounds.radius <= 0.f || far_depth < clip.x || near_depth > clip.y) {
+      return;
+    }
+
+    uint16_t min[3] = { 0 , 0 , static_cast<uint16_t>(DepthSlice(near_depth)) };
+    uint16_t max[3] = {
+      static_cast<uint16_t>(grid.x - 1) , static_cast<uint16_t>(grid.y - 1) , static_cast<uint16_t>(DepthSlice(far_depth)) ,
+    };
+
+    /// a sphere crossing the near plane can cover any tile, otherwise its box projects to a conservative screen rect
+    if (near_depth > clip.x) {
+      glm::vec2 ndc_min(std::numeric_limits<float>::max());
+      glm::vec2 ndc_max(std::numeric_limits<float>::lowest());
+      for (uint32_t c = 0; c < 8; ++c) {
+        glm::vec3 corner = bounds.center + bounds.radius * glm::vec3(
+          (c & 1) ? 1.f : -1.f , (c & 2) ? 1.f : -1.f , (c & 4) ? 1.f : -1.f
+        );
+        glm::vec4 p = projection * glm::vec4(corner , 1.f);
+        glm::vec2 ndc = glm::vec2(p) / p.w;
+        ndc_min = glm::min(ndc_min , ndc);
+        ndc_max = glm::max(ndc_max , ndc);
+      }
+
+      if (ndc_max.x < -1.f || ndc_max.y < -1.f || ndc_min.x > 1.f || ndc_min.y > 1.f) {
+        return;
+      }
+
+      min[0] = TileFromNdc(ndc_min.x , grid.x);
+      min[1] = TileFromNdc(ndc_min.y , grid.y);
+      max[0] = TileFromNdc(ndc_max.x , grid.x);
+      max[1] = TileFromNdc(ndc_max.y , grid.y);
+    }
+
+    std::copy_n(min , 3 , bounds.min);
+    std::copy_n(max , 3 , bounds.max);
+  }
+
+  void LightClusters::BinSlice(uint32_t z) {
+    SliceBin& bin = slices[z];
+    bin.lights.clear();
+    bin.pairs.clear();
+
+    const uint32_t first_cluster = ClusterIndex(0 , 0 , z);
+    const uint32_t slice_clusters = grid.x * grid.y;
+    for (uint32_t c = 0; c < slice_clusters; ++c) {
+      clusters[first_cluster + c].count = 0;
+    }
+
+    for (uint32_t i = 0; i < light_bounds.size(); ++i) {
+      const LightBounds& b = light_bounds[i];
+      if (b.Visible() && b.min[2] <= z && z <= b.max[2]) {
+        bin.lights.push_back(i);
+      }
+    }
+
+    for (uint32_t light : bin.lights) {
+      const LightBounds& b = light_bounds[light];
+      for (uint32_t y = b.min[1]; y <= b.max[1]; ++y) {
+        for (uint32_t x = b.min[0]; x <= b.max[0]; ++x) {
+          const uint32_t cluster = ClusterIndex(x , y , z);
+          const ClusterBounds& cb = cluster_bounds[cluster];
+          if (SphereIntersectsAabb(b.center , b.radius , cb.min , cb.max)) {
+            bin.pairs.emplace_back(cluster , light);
+            ++clusters[cluster].count;
+          }
+        }
+      }
+    }
+  }
+
+} // namespace other
@@ -0,0 +1,135 @@
+/**
+ * \file rendering/light_clusters.hpp
+ **/
+#ifndef OTHER_ENGINE_LIGHT_CLUSTERS_HPP
+#define OTHER_ENGINE_LIGHT_CLUSTERS_HPP
+
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "core/defines.hpp"
+
+#include "scene/environment.hpp"
+
+namespace other {
+
+  /// tiles across the screen and depth slices between the near and far plane
+  struct LightClusterGrid {
+    uint32_t x = 16;
+    uint32_t y = 9;
+    uint32_t z = 24;
+
+    uint32_t NumClusters() const;
+  };
+
+  /// average a cluster list can hold when sizing the index buffer on the gpu, lists are only bounded in total
+  constexpr static uint32_t kMaxLightsPerCluster = 32;
+
+  /// window into the compact light index list, laid out as a uvec2 for std430
+  struct LightCluster {
+    uint32_t offset = 0;
+    uint32_t count = 0;
+  };
+
+  struct LightClusterStats {
+    uint32_t lights = 0;
+    uint32_t visible_lights = 0;
+
+    /// lights whose cluster range was recomputed, everything on a camera change and only what moved otherwise
+    uint32_t rebinned_lights = 0;
+    uint32_t rebinned_slices = 0;
+    uint32_t indices = 0;
+    double build_ms = 0.0;
+  };
+
+  /**
+   * bins point lights into view space clusters (froxels) so shading only loops over the lights touching a fragment's
+   *   cluster instead of every light in the scene
+   *
+   * output is a compact list of light indices plus an offset and count per cluster, cluster (x , y , z) is stored at
+   *   x + y * grid.x + z * grid.x * grid.y
+   *
+   * depth slices are exponential, slice = floor(log(depth) * scale + bias) with DepthSliceParams() = (scale , bias)
+   **/
+  class LightClusters {
+    public:
+      LightClusters(const LightClusterGrid& grid = {});
+
+      /**
+       * clip is (near , far), lights are binned on the engine thread pool one depth slice per job
+       *
+       * while the camera holds still only lights the environment changed since the last build are re-binned and only
+       *   the depth slices they touch are tested again, the index list is always rebuilt from the cached pairs since it
+       *   is cheap next to binning
+       **/
+      LightClusterStats Build(const Environment& environment , const glm::mat4& view , const glm::mat4& projection ,
+                              const glm::vec2& clip);
+
+      const LightClusterGrid& Grid() const;
+
+      uint32_t ClusterIndex(uint32_t x , uint32_t y , uint32_t z) const;
+
+      /// slice a positive view space depth falls in, clamped to the grid
+      uint32_t DepthSlice(float depth) const;
+      glm::vec2 DepthSliceParams() const;
+
+      std::span<const LightCluster> Clusters() const;
+      std::span<const uint32_t> LightIndices() const;
+
+      /// lights touching one cluster in ascending index order
+      std::span<const uint32_t> ClusterLights(uint32_t cluster) const;
+
+    private:
+      /// inclusive cluster range a light can touch, empty when the light is outside the frustum
+      struct LightBounds {
+        glm::vec3 center{ 0.f };
+        float radius = 0.f;
+        uint16_t min[3] = { 1 , 1 , 1 };
+        uint16_t max[3] = { 0 , 0 , 0 };
+
+        bool Visible() const;
+      };
+
+      struct ClusterBounds {
+        glm::vec3 min{ 0.f };
+        glm::vec3 max{ 0.f };
+      };
+
+      /// (cluster , light) pairs one slice produced, kept so each light is only tested against a cluster once
+      struct SliceBin {
+        std::vector<uint32_t> lights;
+        std::vector<std::pair<uint32_t , uint32_t>> pairs;
+        std::vector<uint32_t> cursors;
+      };
+
+      LightClusterGrid grid;
+
+      glm::mat4 view{ 0.f };
+      glm::mat4 projection{ 0.f };
+      glm::vec2 clip{ 0.f };
+      const Environment* environment = nullptr;
+      uint64_t environment_version = 0;
+      bool built = false;
+
+      float log_near = 0.f;
+      float log_depth_range = 1.f;
+
+      std::vector<ClusterBounds> cluster_bounds;
+      std::vector<LightBounds> light_bounds;
+      std::vector<uint32_t> dirty_lights;
+      std::vector<uint8_t> dirty_slices;
+      std::vector<SliceBin> slices;
+
+      std::vector<LightCluster> clusters;
+      std::vector<uint32_t> indices;
+
+      void BuildClusterBounds();
+      void BinLight(const PointLight& light , LightBounds& bounds) const;
+      void BinSlice(uint32_t z);
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_LIGHT_CLUSTERS_HPP
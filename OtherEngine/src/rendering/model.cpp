@@ -133,8 +133,22 @@ namespace other {
   const Layout& ModelSource::GetLayout() const {
     return layout;
   }
+
+  const BBox& ModelSource::BoundingBox() const {
+    return bounding_box;
+  }
       
   void ModelSource::BuildVertexBuffer(const std::vector<Vertex>& verts) {
+    if (!verts.empty()) {
+      glm::vec3 min = verts.front().position;
+      glm::vec3 max = verts.front().position;
+      for (auto& v : verts) {
+        min = glm::min(min , v.position);
+        max = glm::max(max , v.position);
+      }
+      bounding_box = BBox(min , max);
+    }
+
     for (auto& v : verts) {
       fvertices.push_back(v.position.x);
       fvertices.push_back(v.position.y);
@@ -99,6 +99,9 @@ namespace other {
     const std::vector<uint32_t>& RawLayout() const;
     const Layout& GetLayout() const;
 
+    /// local space bounds of every vertex, zero sized when the source has no vertices
+    const BBox& BoundingBox() const;
+
    private:
     std::vector<SubMesh> submeshes;
 
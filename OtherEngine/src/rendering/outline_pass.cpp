@@ -17,8 +17,8 @@ namespace other {
           }) {
   }
 
-  void OutlinePass::SetRenderState() {
-    glDisable(GL_DEPTH_TEST);
+  void OutlinePass::SetRenderState(SetDepthStateCmd& depth , SetStencilStateCmd& stencil) {
+    depth.test = false;
   }
       
   Buffer OutlinePass::ProcessModels(Buffer& buffer) {
@@ -15,7 +15,7 @@ namespace other {
       OutlinePass(const std::vector<Uniform>& uniforms , const Ref<Shader>& shader);
       virtual ~OutlinePass() override {}
 
-      virtual void SetRenderState() override;
+      virtual void SetRenderState(SetDepthStateCmd& depth , SetStencilStateCmd& stencil) override;
       virtual Buffer ProcessModels(Buffer& buffer) override;
   };
 
@@ -7,6 +7,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "core/profile.hpp"
+
 #include "rendering/rendering_defines.hpp"
 #include "rendering/vertex.hpp"
 
@@ -30,14 +32,29 @@ struct MeshKeyComparison {
 constexpr inline MeshKeyComparison mesh_key_compare{};
 
 namespace other {
+namespace {
+
+  size_t UniformBytes(const std::vector<Uniform>& uniforms) {
+    size_t bytes = 0;
+    for (const auto& u : uniforms) {
+      size_t type_size = GetValueSize(u.type);
+      if (type_size == 0) {
+        type_size = u.size.value_or(0);
+      }
+      bytes += type_size * u.arr_length;
+    }
+    return bytes;
+  }
 
-  auto MeshKey::operator<=>(const MeshKey& other) const {
+}  // anonymous namespace
+
+  std::weak_ordering MeshKey::operator<=>(const MeshKey& other) const {
     if (mesh_key_compare(*this, other)) {
-      return -1;
+      return std::weak_ordering::less;
     } else if (mesh_key_compare(other, *this)) {
-      return 1;
+      return std::weak_ordering::greater;
     } else {
-      return 0;
+      return std::weak_ordering::equivalent;
     }
   }
 
@@ -52,12 +69,24 @@ namespace other {
   Pipeline::Pipeline(PipelineSpec& s)
       : spec(s), gbuffer(s.framebuffer_spec.size) {
     target = Ref<Framebuffer>::Create(spec.framebuffer_spec);
-    model_storage = NewRef<UniformBuffer>("ModelData", spec.model_uniforms, spec.model_binding_point, SHADER_STORAGE);
-    material_storage = NewRef<UniformBuffer>("MaterialData", spec.material_uniforms, spec.material_binding_point, SHADER_STORAGE);
+
+    const size_t instance_bytes = UniformBytes(spec.model_uniforms) + UniformBytes(spec.material_uniforms);
+    instance_ring = NewScope<FrameRing>(NewScope<GlFrameRingBackend>(), instance_bytes);
+    render_backend = NewScope<GlRenderBackend>();
   }
 
   void Pipeline::SubmitRenderPass(const Ref<RenderPass>& render_pass) {
-    passes.push_back(render_pass);
+    Ref<RenderPass>& pass = passes.emplace_back(render_pass);
+    if (pass == nullptr) {
+      pass_inputs.push_back(GBufferInputs{});
+      return;
+    }
+
+    pass_inputs.push_back(GBufferInputs{
+        .position = pass->ResolveInput("goe_position"),
+        .normal = pass->ResolveInput("goe_normal"),
+        .albedo = pass->ResolveInput("goe_albedo"),
+    });
   }
 
   void Pipeline::SubmitModel(Ref<Model> model, const glm::mat4& transform, const Material& material) {
@@ -76,10 +105,7 @@ namespace other {
     Ref<ModelSource> source = submission.model->GetModelSource();
     MeshKey key = submission;
 
-    auto itr = std::ranges::find_if(model_submissions, [&](const auto& pair) -> bool {
-      return mesh_key_compare(pair.first, key) == 0;
-    });
-
+    auto itr = model_submissions.find(key);
     if (itr == model_submissions.end()) {
       auto& verts = submission.model->GetModelSource()->RawVertices();
       auto& idxs = submission.model->GetModelSource()->Indices();
@@ -89,12 +115,43 @@ namespace other {
     }
 
     auto& [mk, sl] = *itr;
-    sl.cpu_model_storage.BufferData(submission.transform);
-    sl.cpu_material_storage.BufferData(submission.material);
+    sl.cpu_model_storage.Append(submission.transform);
+    sl.cpu_material_storage.Append(submission.material);
     ++sl.instance_count;
   }
 
+  void Pipeline::SubmitStaticModels(Ref<StaticModel> model, std::span<const glm::mat4> transforms,
+                                    std::span<const Material> materials) {
+    OE_ASSERT(transforms.size() == materials.size(), "Mismatched instance transforms and materials");
+    if (transforms.empty()) {
+      return;
+    }
+
+    RenderSubmission submission{
+      .model = model,
+      .draw_mode = spec.topology,
+    };
+    MeshKey key = submission;
+
+    auto itr = model_submissions.find(key);
+    if (itr == model_submissions.end()) {
+      auto& verts = model->GetModelSource()->RawVertices();
+      auto& idxs = model->GetModelSource()->Indices();
+
+      itr = InsertMeshKey(key, verts, idxs);
+      OE_ASSERT(itr != model_submissions.end(), "Failed to insert mesh key");
+    }
+
+    auto& [mk, sl] = *itr;
+    sl.cpu_model_storage.Append(transforms);
+    sl.cpu_material_storage.Append(materials);
+    sl.instance_count += static_cast<uint32_t>(transforms.size());
+  }
+
   void Pipeline::Render() {
+    OE_PROFILE_SCOPE("Pipeline::Render");
+    OE_PROFILE_TAG(spec.debug_name);
+
     /** Passes to implement
      * ----------------
      * shadow mapping (expensive) :
@@ -117,30 +174,28 @@ namespace other {
      * bloom compute
      * composite pass
      **/
-    material_storage->Clear();
-    model_storage->Clear();
+    PackInstances(model_submissions, *instance_ring);
 
-    gbuffer.Bind();
-    CHECKGL();
+    draw_commands.Reset();
+    RecordInstancedDraws(model_submissions, spec.model_binding_point, spec.material_binding_point, draw_commands);
 
-    RenderAll();
-    CHECKGL();
+    frame_commands.Reset();
+    gbuffer.Bind(frame_commands);
+    frame_commands.Append(draw_commands);
+    gbuffer.Unbind(frame_commands);
 
-    gbuffer.Unbind();
-    CHECKGL();
-
-    target->BindFrame();
-    CHECKGL();
-    for (auto& pass : passes) {
-      if (pass == nullptr) {
+    target->BindFrame(frame_commands);
+    for (size_t i = 0; i < passes.size(); ++i) {
+      if (passes[i] == nullptr) {
         continue;
       }
 
-      PerformPass(pass);
-      CHECKGL();
+      PerformPass(passes[i], pass_inputs[i]);
     }
-    target->UnbindFrame();
-    CHECKGL();
+    target->UnbindFrame(frame_commands);
+
+    render_backend->Execute(frame_commands);
+    instance_ring->EndFrame();
   }
 
   Ref<Framebuffer> Pipeline::GetOutput() {
@@ -151,32 +206,22 @@ namespace other {
     return gbuffer;
   }
 
-  void Pipeline::Clear() {
-    /// dont clear the mesh key for a tiny optimization on future submissions
-    for (auto& [mk, sl] : model_submissions) {
-      sl.cpu_model_storage.ZeroMem();
-      sl.cpu_material_storage.ZeroMem();
-      sl.instance_count = 0;
-    }
-    model_submissions.clear();
+  const FrameRingStats& Pipeline::InstanceUploadStats() const {
+    return instance_ring->Stats();
   }
 
-  void Pipeline::PerformPass(Ref<RenderPass>& pass) {
-    CHECKGL();
-
-    pass->Bind();
-    pass->SetInput("goe_position", 0);
-    pass->SetInput("goe_normal", 1);
-    pass->SetInput("goe_albedo", 2);
-
-    CHECKGL();
-
-    RenderAll();
+  void Pipeline::Clear() {
+    ClearInstances(model_submissions);
+  }
 
-    CHECKGL();
+  void Pipeline::PerformPass(Ref<RenderPass>& pass, const GBufferInputs& inputs) {
+    pass->Bind(frame_commands);
+    pass->SetInput(frame_commands, inputs.position, 0);
+    pass->SetInput(frame_commands, inputs.normal, 1);
+    pass->SetInput(frame_commands, inputs.albedo, 2);
 
-    pass->Unbind();
-    CHECKGL();
+    frame_commands.Append(draw_commands);
+    pass->Unbind(frame_commands);
   }
 
   FrameMeshes::iterator Pipeline::InsertMeshKey(MeshKey& key, const std::vector<float>& vertices, const std::vector<Index>& indices) {
@@ -192,33 +237,85 @@ namespace other {
 
     MeshSubmissionList msl{
       .instance_count = 0,
-      .cpu_model_storage = Buffer(),  /// pre-allocate here?
-      .cpu_material_storage = Buffer(),
     };
 
     return model_submissions.insert({key, std::move(msl)}).first;
   }
 
-  void Pipeline::RenderAll() {
-    for (auto& [mk, sl] : model_submissions) {
-      RenderMeshes(mk, sl.instance_count, sl.cpu_model_storage, sl.cpu_material_storage);
+  bool PackInstances(FrameMeshes& meshes, FrameRing& ring) {
+    OE_PROFILE_SCOPE("PackInstances");
+
+    size_t frame_bytes = 0;
+    for (const auto& [mk, sl] : meshes) {
+      frame_bytes += ring.AlignedSize(sl.cpu_model_storage.Bytes()) + ring.AlignedSize(sl.cpu_material_storage.Bytes());
     }
-  }
+    ring.BeginFrame(frame_bytes);
 
-  void Pipeline::RenderMeshes(const MeshKey& mesh_key, uint32_t instance_count, const Buffer& model_buffer, const Buffer& material_buffer) {
-    model_storage->BindBase();
-    CHECKGL();
-    model_storage->LoadFromBuffer(model_buffer);
-    CHECKGL();
+    bool packed = true;
+    uint32_t base_instance = 0;
+    for (auto& [mk, sl] : meshes) {
+      if (sl.instance_count == 0) {
+        continue;
+      }
 
-    material_storage->BindBase();
-    material_storage->LoadFromBuffer(material_buffer);
+      Opt<FrameRingSlice> models = ring.Write(sl.cpu_model_storage.View());
+      Opt<FrameRingSlice> materials = ring.Write(sl.cpu_material_storage.View());
+      if (!models.has_value() || !materials.has_value()) {
+        sl.instance_count = 0;
+        packed = false;
+        continue;
+      }
 
-    mesh_key.vao->Bind();
+      sl.model_slice = *models;
+      sl.material_slice = *materials;
+      sl.base_instance = base_instance;
+      base_instance += sl.instance_count;
+    }
 
-    glPolygonMode(GL_FRONT_AND_BACK, mesh_key.render_state);
-    glDrawElementsInstancedBaseVertexBaseInstance(mesh_key.draw_mode, mesh_key.num_elements, GL_UNSIGNED_INT, (void*)0, instance_count, 0, 0);
-    CHECKGL();
+    return packed;
+  }
+
+  void ClearInstances(FrameMeshes& meshes) {
+    for (auto& [mk, sl] : meshes) {
+      sl.cpu_model_storage.Clear();
+      sl.cpu_material_storage.Clear();
+      sl.instance_count = 0;
+    }
+  }
+
+  void RecordInstancedDraws(const FrameMeshes& meshes, uint32_t model_binding_point, uint32_t material_binding_point,
+                            RenderCommandBuffer& commands) {
+    for (const auto& [mk, sl] : meshes) {
+      if (sl.instance_count == 0) {
+        continue;
+      }
+
+      /// instance data was written once in PackInstances, each draw only points the storage blocks at its slices
+      commands.Record(BindStorageRangeCmd{
+        .binding_point = model_binding_point,
+        .buffer = sl.model_slice.buffer,
+        .offset = sl.model_slice.offset,
+        .size = sl.model_slice.size,
+      });
+      commands.Record(BindStorageRangeCmd{
+        .binding_point = material_binding_point,
+        .buffer = sl.material_slice.buffer,
+        .offset = sl.material_slice.offset,
+        .size = sl.material_slice.size,
+      });
+      commands.Record(BindVertexArrayCmd{
+        .vertex_array = mk.vao != nullptr ? mk.vao->RendererId() : 0,
+      });
+      commands.Record(SetPolygonModeCmd{
+        .mode = static_cast<uint32_t>(mk.render_state),
+      });
+      commands.Record(DrawIndexedCmd{
+        .mode = static_cast<uint32_t>(mk.draw_mode),
+        .num_elements = static_cast<uint32_t>(mk.num_elements),
+        .instance_count = sl.instance_count,
+        .base_instance = sl.base_instance,
+      });
+    }
   }
 
 }  // namespace other
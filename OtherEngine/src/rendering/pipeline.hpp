@@ -4,17 +4,22 @@
 #ifndef OTHER_ENGINE_PIPELINE_HPP
 #define OTHER_ENGINE_PIPELINE_HPP
 
+#include <compare>
 #include <functional>
+#include <span>
 
 #include "core/buffer.hpp"
+#include "core/instance_buffer.hpp"
 #include "core/ref.hpp"
 #include "core/ref_counted.hpp"
 
+#include "rendering/frame_ring.hpp"
 #include "rendering/framebuffer.hpp"
 #include "rendering/gbuffer.hpp"
 #include "rendering/layout.hpp"
 #include "rendering/material.hpp"
 #include "rendering/model.hpp"
+#include "rendering/render_commands.hpp"
 #include "rendering/render_pass.hpp"
 #include "rendering/rendering_defines.hpp"
 #include "rendering/vertex.hpp"
@@ -31,9 +36,9 @@ namespace other {
     DrawMode draw_mode = DrawMode::TRIANGLES;
 
     size_t num_elements = 0;
-    bool selected;
+    bool selected = false;
 
-    auto operator<=>(const MeshKey& other) const;
+    std::weak_ordering operator<=>(const MeshKey& other) const;
   };
 
   struct PipelineSpec {
@@ -45,6 +50,7 @@ namespace other {
     FramebufferSpec framebuffer_spec{};
     Layout vertex_layout;
 
+    /// together with the material uniforms these size the first instance ring region, it grows when a frame needs more
     std::vector<Uniform> model_uniforms{};
     uint32_t model_binding_point = 0;
 
@@ -66,11 +72,31 @@ namespace other {
 
   struct MeshSubmissionList {
     uint32_t instance_count = 0;
-    Buffer cpu_model_storage;
-    Buffer cpu_material_storage;
+    InstanceBuffer<glm::mat4> cpu_model_storage;
+    InstanceBuffer<Material> cpu_material_storage;
+
+    /// where PackInstances put this list's instances in the current frame
+    uint32_t base_instance = 0;
+    FrameRingSlice model_slice;
+    FrameRingSlice material_slice;
   };
   using FrameMeshes = std::map<MeshKey, MeshSubmissionList>;
 
+  /**
+   * writes every list's models and materials into the ring once for the frame, lists that do not fit get an instance
+   *   count of 0 so they are skipped instead of drawn with stale data
+   *
+   * begins a ring frame, the caller ends it after the last draw reading the instances
+   **/
+  bool PackInstances(FrameMeshes& meshes, FrameRing& ring);
+
+  /// empties every list for the next frame, the entries and their storage stay so a steady state frame does not allocate
+  void ClearInstances(FrameMeshes& meshes);
+
+  /// records binding each packed list's instance slices and one instanced draw per list
+  void RecordInstancedDraws(const FrameMeshes& meshes, uint32_t model_binding_point, uint32_t material_binding_point,
+                            RenderCommandBuffer& commands);
+
   class Pipeline : public RefCounted {
    public:
     Pipeline(PipelineSpec& spec);
@@ -83,30 +109,46 @@ namespace other {
     void SubmitStaticModel(Ref<StaticModel> model, const glm::mat4& transform, const Material& color);
     void SubmitStaticModel(const RenderSubmission& submission);
 
+    /// instances of one model with a single draw list lookup, transforms and materials pair up by index
+    void SubmitStaticModels(Ref<StaticModel> model, std::span<const glm::mat4> transforms,
+                            std::span<const Material> materials);
+
     void Render();
     Ref<Framebuffer> GetOutput();
     GBuffer& GetGBuffer();
 
     void Clear();
 
+    const FrameRingStats& InstanceUploadStats() const;
+
    private:
     uint32_t vao_id = 0;
     PipelineSpec spec{};
     GBuffer gbuffer;
 
-    Ref<UniformBuffer> model_storage = nullptr;
-    Ref<UniformBuffer> material_storage = nullptr;
+    Scope<FrameRing> instance_ring = nullptr;
     FrameMeshes model_submissions;
 
+    /// the draw list is recorded once per frame and appended after the gbuffer's and every pass's setup, the whole frame
+    ///   is replayed with one Execute
+    Scope<RenderBackend> render_backend = nullptr;
+    RenderCommandBuffer draw_commands;
+    RenderCommandBuffer frame_commands;
+
+    /// the gbuffer samplers every pass reads, resolved when the pass is submitted
+    struct GBufferInputs {
+      PassInput position;
+      PassInput normal;
+      PassInput albedo;
+    };
+
     Ref<Framebuffer> target = nullptr;
     std::vector<Ref<RenderPass>> passes{};
+    std::vector<GBufferInputs> pass_inputs{};
 
-    void PerformPass(Ref<RenderPass>& pass);
+    void PerformPass(Ref<RenderPass>& pass, const GBufferInputs& inputs);
 
     FrameMeshes::iterator InsertMeshKey(MeshKey& key, const std::vector<float>& vertices, const std::vector<Index>& indices);
-
-    void RenderAll();
-    void RenderMeshes(const MeshKey& mesh_key, uint32_t instance_count, const Buffer& model_buffer, const Buffer& material_buffer);
   };
 
 }  // namespace other
@@ -0,0 +1,331 @@
+/**
+ * \file rendering/render_commands.cpp
+ **/
+#include "rendering/render_commands.hpp"
+
+#include <glad/glad.h>
+
+#include "core/logger.hpp"
+#include "rendering/rendering_defines.hpp"
+
+namespace other {
+
+  void RenderCommandBuffer::RecordUpload(uint32_t target , uint32_t buffer , uint64_t offset , std::span<const uint8_t> data) {
+    OE_ASSERT(data.size() <= std::numeric_limits<uint32_t>::max() / 2 , "Upload of {} bytes is too large for one render command" ,
+              data.size());
+
+    const BufferSubDataCmd command{
+      .target = target ,
+      .buffer = buffer ,
+      .offset = offset ,
+      .size = data.size() ,
+    };
+    uint8_t* inline_data = Emplace(command , data.size());
+    if (!data.empty()) {
+      std::memcpy(inline_data , data.data() , data.size());
+    }
+  }
+
+  void RenderCommandBuffer::Append(const RenderCommandBuffer& other) {
+    arena.insert(arena.end() , other.arena.begin() , other.arena.end());
+    num_commands += other.num_commands;
+  }
+
+  void RenderCommandBuffer::Reset() {
+    arena.clear();
+    num_commands = 0;
+  }
+
+  uint32_t RenderCommandBuffer::NumCommands() const {
+    return num_commands;
+  }
+
+  size_t RenderCommandBuffer::SizeBytes() const {
+    return arena.size();
+  }
+
+  size_t RenderCommandBuffer::Capacity() const {
+    return arena.capacity();
+  }
+
+  void RenderBackend::Execute(const RenderCommandBuffer& commands) {
+    BeginExecute();
+    commands.ForEach([this](const RenderCommandHeader& header , const void* payload) {
+      switch (header.type) {
+        case BIND_STORAGE_RANGE_CMD:
+          Submit(RenderCommandBuffer::Read<BindStorageRangeCmd>(payload));
+          break;
+        case BIND_VERTEX_ARRAY_CMD:
+          Submit(RenderCommandBuffer::Read<BindVertexArrayCmd>(payload));
+          break;
+        case SET_POLYGON_MODE_CMD:
+          Submit(RenderCommandBuffer::Read<SetPolygonModeCmd>(payload));
+          break;
+        case DRAW_INDEXED_CMD:
+          Submit(RenderCommandBuffer::Read<DrawIndexedCmd>(payload));
+          break;
+        case USE_PROGRAM_CMD:
+          Submit(RenderCommandBuffer::Read<UseProgramCmd>(payload));
+          break;
+        case BIND_FRAMEBUFFER_CMD:
+          Submit(RenderCommandBuffer::Read<BindFramebufferCmd>(payload));
+          break;
+        case BLIT_FRAMEBUFFER_CMD:
+          Submit(RenderCommandBuffer::Read<BlitFramebufferCmd>(payload));
+          break;
+        case BIND_TEXTURE_CMD:
+          Submit(RenderCommandBuffer::Read<BindTextureCmd>(payload));
+          break;
+        case SET_DEPTH_STATE_CMD:
+          Submit(RenderCommandBuffer::Read<SetDepthStateCmd>(payload));
+          break;
+        case SET_STENCIL_STATE_CMD:
+          Submit(RenderCommandBuffer::Read<SetStencilStateCmd>(payload));
+          break;
+        case BIND_BUFFER_BASE_CMD:
+          Submit(RenderCommandBuffer::Read<BindBufferBaseCmd>(payload));
+          break;
+        case BUFFER_SUB_DATA_CMD:
+          Submit(RenderCommandBuffer::Read<BufferSubDataCmd>(payload) , RenderCommandBuffer::InlineData<BufferSubDataCmd>(payload));
+          break;
+        case SET_UNIFORM_CMD:
+          Submit(RenderCommandBuffer::Read<SetUniformCmd>(payload));
+          break;
+        default:
+          SubmitInvalid(header);
+          break;
+      }
+    });
+    EndExecute();
+  }
+
+  void GlRenderBackend::EndExecute() {
+    /// one error check per replay instead of one per call, an error points at the buffer rather than the call
+    CHECKGL();
+  }
+
+  void GlRenderBackend::Submit(const BindStorageRangeCmd& cmd) {
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER , cmd.binding_point , cmd.buffer , cmd.offset , cmd.size);
+  }
+
+  void GlRenderBackend::Submit(const BindVertexArrayCmd& cmd) {
+    glBindVertexArray(cmd.vertex_array);
+  }
+
+  void GlRenderBackend::Submit(const SetPolygonModeCmd& cmd) {
+    glPolygonMode(GL_FRONT_AND_BACK , cmd.mode);
+  }
+
+  void GlRenderBackend::Submit(const DrawIndexedCmd& cmd) {
+    glDrawElementsInstancedBaseVertexBaseInstance(cmd.mode , cmd.num_elements , GL_UNSIGNED_INT , nullptr ,
+                                                  cmd.instance_count , cmd.base_vertex , cmd.base_instance);
+  }
+
+  void GlRenderBackend::Submit(const UseProgramCmd& cmd) {
+    glUseProgram(cmd.program);
+  }
+
+  void GlRenderBackend::Submit(const BindFramebufferCmd& cmd) {
+    glBindFramebuffer(GL_FRAMEBUFFER , cmd.framebuffer);
+    if (cmd.width != 0 && cmd.height != 0) {
+      glViewport(0 , 0 , cmd.width , cmd.height);
+    }
+
+    if (cmd.clear_mask != 0) {
+      glClearColor(cmd.clear_color[0] , cmd.clear_color[1] , cmd.clear_color[2] , cmd.clear_color[3]);
+      glClear(cmd.clear_mask);
+    }
+  }
+
+  void GlRenderBackend::Submit(const BlitFramebufferCmd& cmd) {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER , cmd.read_framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER , cmd.draw_framebuffer);
+    glBlitFramebuffer(0 , 0 , cmd.width , cmd.height , 0 , 0 , cmd.width , cmd.height , cmd.mask , GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER , 0);
+  }
+
+  void GlRenderBackend::Submit(const BindTextureCmd& cmd) {
+    glActiveTexture(GL_TEXTURE0 + cmd.unit);
+    glBindTexture(cmd.target , cmd.texture);
+  }
+
+  void GlRenderBackend::Submit(const SetDepthStateCmd& cmd) {
+    if (!cmd.test) {
+      glDisable(GL_DEPTH_TEST);
+      return;
+    }
+
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(cmd.func);
+  }
+
+  void GlRenderBackend::Submit(const SetStencilStateCmd& cmd) {
+    if (!cmd.test) {
+      glDisable(GL_STENCIL_TEST);
+      return;
+    }
+
+    glEnable(GL_STENCIL_TEST);
+    glStencilFunc(cmd.func , cmd.ref , cmd.read_mask);
+    glStencilMask(cmd.write_mask);
+    glStencilOp(cmd.stencil_fail , cmd.depth_fail , cmd.depth_pass);
+  }
+
+  void GlRenderBackend::Submit(const BindBufferBaseCmd& cmd) {
+    glBindBufferBase(cmd.target , cmd.binding_point , cmd.buffer);
+  }
+
+  void GlRenderBackend::Submit(const BufferSubDataCmd& cmd , const uint8_t* data) {
+    glBindBuffer(cmd.target , cmd.buffer);
+    glBufferSubData(cmd.target , cmd.offset , cmd.size , data);
+    glBindBuffer(cmd.target , 0);
+  }
+
+  void GlRenderBackend::Submit(const SetUniformCmd& cmd) {
+    /// program uniforms do not depend on whichever program the stream bound last
+    switch (cmd.type) {
+      case INT32: {
+        int32_t value = 0;
+        std::memcpy(&value , cmd.value , sizeof(value));
+        glProgramUniform1i(cmd.program , cmd.location , value);
+      } break;
+      case FLOAT:
+        glProgramUniform1fv(cmd.program , cmd.location , 1 , cmd.value);
+        break;
+      case VEC2:
+        glProgramUniform2fv(cmd.program , cmd.location , 1 , cmd.value);
+        break;
+      case VEC3:
+        glProgramUniform3fv(cmd.program , cmd.location , 1 , cmd.value);
+        break;
+      case VEC4:
+        glProgramUniform4fv(cmd.program , cmd.location , 1 , cmd.value);
+        break;
+      case MAT2:
+        glProgramUniformMatrix2fv(cmd.program , cmd.location , 1 , GL_FALSE , cmd.value);
+        break;
+      case MAT3:
+        glProgramUniformMatrix3fv(cmd.program , cmd.location , 1 , GL_FALSE , cmd.value);
+        break;
+      case MAT4:
+        glProgramUniformMatrix4fv(cmd.program , cmd.location , 1 , GL_FALSE , cmd.value);
+        break;
+      default:
+        OE_ERROR("Skipping uniform of unsupported type {}" , static_cast<uint32_t>(cmd.type));
+        break;
+    }
+  }
+
+  void GlRenderBackend::SubmitInvalid(const RenderCommandHeader& header) {
+    OE_ERROR("Skipping invalid render command {}" , static_cast<uint32_t>(header.type));
+  }
+
+  const NullRenderStats& NullRenderBackend::Stats() const {
+    return stats;
+  }
+
+  void NullRenderBackend::ResetStats() {
+    stats = NullRenderStats{};
+  }
+
+  void NullRenderBackend::BeginExecute() {
+    /// every replay starts from a fresh api state, like a new command list would
+    bound_vertex_array = 0;
+  }
+
+  void NullRenderBackend::Submit(const BindStorageRangeCmd& cmd) {
+    ++stats.commands[cmd.kType];
+    if (cmd.size == 0) {
+      ++stats.validation_errors;
+    }
+  }
+
+  void NullRenderBackend::Submit(const BindVertexArrayCmd& cmd) {
+    ++stats.commands[cmd.kType];
+    bound_vertex_array = cmd.vertex_array;
+  }
+
+  void NullRenderBackend::Submit(const SetPolygonModeCmd& cmd) {
+    ++stats.commands[cmd.kType];
+  }
+
+  void NullRenderBackend::Submit(const DrawIndexedCmd& cmd) {
+    ++stats.commands[cmd.kType];
+    if (bound_vertex_array == 0 || cmd.num_elements == 0 || cmd.instance_count == 0) {
+      ++stats.validation_errors;
+      return;
+    }
+
+    ++stats.draws;
+    stats.instances += cmd.instance_count;
+    stats.elements += static_cast<uint64_t>(cmd.num_elements) * cmd.instance_count;
+  }
+
+  void NullRenderBackend::Submit(const UseProgramCmd& cmd) {
+    ++stats.commands[cmd.kType];
+  }
+
+  void NullRenderBackend::Submit(const BindFramebufferCmd& cmd) {
+    ++stats.commands[cmd.kType];
+
+    /// a viewport with one zero dimension draws nothing
+    if ((cmd.width == 0) != (cmd.height == 0)) {
+      ++stats.validation_errors;
+    }
+  }
+
+  void NullRenderBackend::Submit(const BlitFramebufferCmd& cmd) {
+    ++stats.commands[cmd.kType];
+    if (cmd.read_framebuffer == cmd.draw_framebuffer || cmd.width == 0 || cmd.height == 0 || cmd.mask == 0) {
+      ++stats.validation_errors;
+    }
+  }
+
+  void NullRenderBackend::Submit(const BindTextureCmd& cmd) {
+    ++stats.commands[cmd.kType];
+  }
+
+  void NullRenderBackend::Submit(const SetDepthStateCmd& cmd) {
+    ++stats.commands[cmd.kType];
+  }
+
+  void NullRenderBackend::Submit(const SetStencilStateCmd& cmd) {
+    ++stats.commands[cmd.kType];
+  }
+
+  void NullRenderBackend::Submit(const BindBufferBaseCmd& cmd) {
+    ++stats.commands[cmd.kType];
+    if (cmd.buffer == 0) {
+      ++stats.validation_errors;
+    }
+  }
+
+  void NullRenderBackend::Submit(const BufferSubDataCmd& cmd , const uint8_t* data) {
+    ++stats.commands[cmd.kType];
+    if (cmd.buffer == 0 || cmd.size == 0) {
+      ++stats.validation_errors;
+      return;
+    }
+
+    stats.bytes_uploaded += cmd.size;
+  }
+
+  void NullRenderBackend::Submit(const SetUniformCmd& cmd) {
+    ++stats.commands[cmd.kType];
+
+    const bool plain = cmd.type == INT32 || cmd.type == FLOAT || (cmd.type >= VEC2 && cmd.type <= MAT4);
+    if (cmd.program == 0 || !plain) {
+      ++stats.validation_errors;
+    }
+  }
+
+  void NullRenderBackend::SubmitInvalid(const RenderCommandHeader& header) {
+    ++stats.validation_errors;
+  }
+
+  void SubmitImmediate(const RenderCommandBuffer& commands) {
+    GlRenderBackend backend;
+    backend.Execute(commands);
+  }
+
+} // namespace other
@@ -0,0 +1,371 @@
+/**
+ * \file rendering/render_commands.hpp
+ **/
+#ifndef OTHER_ENGINE_RENDER_COMMANDS_HPP
+#define OTHER_ENGINE_RENDER_COMMANDS_HPP
+
+#include <array>
+#include <concepts>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "core/defines.hpp"
+
+namespace other {
+
+  enum RenderCommandType : uint16_t {
+    BIND_STORAGE_RANGE_CMD = 0 ,
+    BIND_VERTEX_ARRAY_CMD ,
+    SET_POLYGON_MODE_CMD ,
+    DRAW_INDEXED_CMD ,
+    USE_PROGRAM_CMD ,
+    BIND_FRAMEBUFFER_CMD ,
+    BLIT_FRAMEBUFFER_CMD ,
+    BIND_TEXTURE_CMD ,
+    SET_DEPTH_STATE_CMD ,
+    SET_STENCIL_STATE_CMD ,
+    BIND_BUFFER_BASE_CMD ,
+    BUFFER_SUB_DATA_CMD ,
+    SET_UNIFORM_CMD ,
+
+    NUM_RENDER_COMMANDS ,
+    INVALID_RENDER_COMMAND = NUM_RENDER_COMMANDS ,
+  };
+
+  /**
+   * commands are plain data holding api handles and enums only, nothing in them points back at engine objects so a
+   *   recorded buffer can be replayed, counted or thrown away anywhere
+   **/
+  struct BindStorageRangeCmd {
+    constexpr static RenderCommandType kType = BIND_STORAGE_RANGE_CMD;
+
+    uint32_t binding_point = 0;
+    uint32_t buffer = 0;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+  };
+
+  struct BindVertexArrayCmd {
+    constexpr static RenderCommandType kType = BIND_VERTEX_ARRAY_CMD;
+
+    uint32_t vertex_array = 0;
+  };
+
+  struct SetPolygonModeCmd {
+    constexpr static RenderCommandType kType = SET_POLYGON_MODE_CMD;
+
+    uint32_t mode = 0;
+  };
+
+  struct DrawIndexedCmd {
+    constexpr static RenderCommandType kType = DRAW_INDEXED_CMD;
+
+    uint32_t mode = 0;
+    uint32_t num_elements = 0;
+    uint32_t instance_count = 1;
+    int32_t base_vertex = 0;
+    uint32_t base_instance = 0;
+  };
+
+  struct UseProgramCmd {
+    constexpr static RenderCommandType kType = USE_PROGRAM_CMD;
+
+    /// 0 unbinds
+    uint32_t program = 0;
+  };
+
+  /// binds a framebuffer for drawing , the viewport is only set with a size and only what clear_mask names is cleared
+  struct BindFramebufferCmd {
+    constexpr static RenderCommandType kType = BIND_FRAMEBUFFER_CMD;
+
+    uint32_t framebuffer = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t clear_mask = 0;
+    float clear_color[4] = { 0.f , 0.f , 0.f , 1.f };
+  };
+
+  /// copies read into draw with nearest filtering , leaves the default framebuffer bound
+  struct BlitFramebufferCmd {
+    constexpr static RenderCommandType kType = BLIT_FRAMEBUFFER_CMD;
+
+    uint32_t read_framebuffer = 0;
+    uint32_t draw_framebuffer = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mask = 0;
+  };
+
+  struct BindTextureCmd {
+    constexpr static RenderCommandType kType = BIND_TEXTURE_CMD;
+
+    uint32_t unit = 0;
+    uint32_t target = 0;
+    uint32_t texture = 0;
+  };
+
+  struct SetDepthStateCmd {
+    constexpr static RenderCommandType kType = SET_DEPTH_STATE_CMD;
+
+    bool test = false;
+    uint32_t func = 0;
+  };
+
+  struct SetStencilStateCmd {
+    constexpr static RenderCommandType kType = SET_STENCIL_STATE_CMD;
+
+    bool test = false;
+    uint32_t func = 0;
+    int32_t ref = 0;
+    uint32_t read_mask = 0xFF;
+    uint32_t write_mask = 0xFF;
+    uint32_t stencil_fail = 0;
+    uint32_t depth_fail = 0;
+    uint32_t depth_pass = 0;
+  };
+
+  /// binds a whole uniform or storage buffer to a binding point
+  struct BindBufferBaseCmd {
+    constexpr static RenderCommandType kType = BIND_BUFFER_BASE_CMD;
+
+    uint32_t target = 0;
+    uint32_t binding_point = 0;
+    uint32_t buffer = 0;
+  };
+
+  /// uploads the size bytes recorded right behind the command , RenderCommandBuffer::RecordUpload copies them in
+  struct BufferSubDataCmd {
+    constexpr static RenderCommandType kType = BUFFER_SUB_DATA_CMD;
+
+    uint32_t target = 0;
+    uint32_t buffer = 0;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+  };
+
+  /// sets a plain uniform of program , the value is stored in the command so nothing has to outlive the recording
+  struct SetUniformCmd {
+    constexpr static RenderCommandType kType = SET_UNIFORM_CMD;
+
+    uint32_t program = 0;
+    int32_t location = -1;
+    ValueType type = EMPTY;
+
+    /// int32 values are stored bit for bit , everything else is floats up to a mat4
+    float value[16] = {};
+  };
+
+  template <typename T>
+  concept render_command_t = std::is_trivially_copyable_v<T> && requires {
+    { T::kType } -> std::convertible_to<RenderCommandType>;
+  };
+
+  /// precedes every command in the arena, size covers the header , the padded payload and any inline data after it
+  struct RenderCommandHeader {
+    RenderCommandType type = INVALID_RENDER_COMMAND;
+    uint16_t padding = 0;
+    uint32_t size = 0;
+  };
+
+  /**
+   * linear arena of recorded commands, Reset keeps the memory so recording every frame stops allocating once the
+   *   arena saw the largest frame
+   *
+   * buffers recorded on different threads are merged with Append in whatever order they should replay in
+   **/
+  class RenderCommandBuffer {
+    public:
+      constexpr static size_t kCommandAlignment = 8;
+
+      template <render_command_t T>
+      void Record(const T& command) {
+        static_assert(T::kType != BUFFER_SUB_DATA_CMD , "Uploads carry their bytes , record them with RecordUpload");
+        Emplace(command , 0);
+      }
+
+      /// copies data into the arena behind the upload , the source can be rewritten or freed as soon as this returns
+      void RecordUpload(uint32_t target , uint32_t buffer , uint64_t offset , std::span<const uint8_t> data);
+
+      /// T is any type a plain uniform can hold , an int32 , a float or a glm vector or matrix
+      template <typename T>
+      void RecordUniform(uint32_t program , int32_t location , const T& value) {
+        constexpr ValueType type = GetValueType<T>();
+        static_assert(type == INT32 || type == FLOAT || (type >= VEC2 && type <= MAT4) , "Not a plain uniform type");
+
+        SetUniformCmd command{
+          .program = program ,
+          .location = location ,
+          .type = type ,
+        };
+        std::memcpy(command.value , &value , sizeof(T));
+        Record(command);
+      }
+
+      void Append(const RenderCommandBuffer& other);
+      void Reset();
+
+      uint32_t NumCommands() const;
+      size_t SizeBytes() const;
+      size_t Capacity() const;
+
+      /// calls fn(header , payload) for every command in recording order
+      template <typename Fn>
+      void ForEach(Fn&& fn) const {
+        size_t offset = 0;
+        while (offset < arena.size()) {
+          RenderCommandHeader header;
+          std::memcpy(&header , arena.data() + offset , sizeof(header));
+          fn(header , arena.data() + offset + sizeof(header));
+          offset += header.size;
+        }
+      }
+
+      /// copies a payload out of the arena, payloads are only aligned to kCommandAlignment
+      template <render_command_t T>
+      static T Read(const void* payload) {
+        T command;
+        std::memcpy(&command , payload , sizeof(T));
+        return command;
+      }
+
+      /// the bytes recorded behind a command's payload , like an upload's source data
+      template <render_command_t T>
+      static const uint8_t* InlineData(const void* payload) {
+        return static_cast<const uint8_t*>(payload) + Align(sizeof(T));
+      }
+
+    private:
+      std::vector<uint8_t> arena;
+      uint32_t num_commands = 0;
+
+      constexpr static size_t Align(size_t size) {
+        return (size + kCommandAlignment - 1) / kCommandAlignment * kCommandAlignment;
+      }
+
+      /// writes the header and the payload , returns where inline_size bytes of inline data go
+      template <render_command_t T>
+      uint8_t* Emplace(const T& command , size_t inline_size) {
+        static_assert(alignof(T) <= kCommandAlignment , "Render command over aligned for the command arena");
+
+        const size_t command_size = sizeof(RenderCommandHeader) + Align(sizeof(T)) + Align(inline_size);
+        const size_t offset = arena.size();
+        arena.resize(offset + command_size);
+
+        const RenderCommandHeader header{
+          .type = T::kType ,
+          .size = static_cast<uint32_t>(command_size) ,
+        };
+        std::memcpy(arena.data() + offset , &header , sizeof(header));
+        std::memcpy(arena.data() + offset + sizeof(header) , &command , sizeof(T));
+        ++num_commands;
+
+        return arena.data() + offset + sizeof(header) + Align(sizeof(T));
+      }
+  };
+
+  /// replays recorded commands against some graphics api, or none at all
+  class RenderBackend {
+    public:
+      virtual ~RenderBackend() {}
+
+      void Execute(const RenderCommandBuffer& commands);
+
+    protected:
+      virtual void BeginExecute() {}
+      virtual void EndExecute() {}
+
+      virtual void Submit(const BindStorageRangeCmd& cmd) = 0;
+      virtual void Submit(const BindVertexArrayCmd& cmd) = 0;
+      virtual void Submit(const SetPolygonModeCmd& cmd) = 0;
+      virtual void Submit(const DrawIndexedCmd& cmd) = 0;
+      virtual void Submit(const UseProgramCmd& cmd) = 0;
+      virtual void Submit(const BindFramebufferCmd& cmd) = 0;
+      virtual void Submit(const BlitFramebufferCmd& cmd) = 0;
+      virtual void Submit(const BindTextureCmd& cmd) = 0;
+      virtual void Submit(const SetDepthStateCmd& cmd) = 0;
+      virtual void Submit(const SetStencilStateCmd& cmd) = 0;
+      virtual void Submit(const BindBufferBaseCmd& cmd) = 0;
+      virtual void Submit(const BufferSubDataCmd& cmd , const uint8_t* data) = 0;
+      virtual void Submit(const SetUniformCmd& cmd) = 0;
+
+      /// unknown command types, only reachable through a corrupted arena
+      virtual void SubmitInvalid(const RenderCommandHeader& header) = 0;
+  };
+
+  class GlRenderBackend : public RenderBackend {
+    public:
+      virtual ~GlRenderBackend() override {}
+
+    protected:
+      virtual void EndExecute() override;
+
+      virtual void Submit(const BindStorageRangeCmd& cmd) override;
+      virtual void Submit(const BindVertexArrayCmd& cmd) override;
+      virtual void Submit(const SetPolygonModeCmd& cmd) override;
+      virtual void Submit(const DrawIndexedCmd& cmd) override;
+      virtual void Submit(const UseProgramCmd& cmd) override;
+      virtual void Submit(const BindFramebufferCmd& cmd) override;
+      virtual void Submit(const BlitFramebufferCmd& cmd) override;
+      virtual void Submit(const BindTextureCmd& cmd) override;
+      virtual void Submit(const SetDepthStateCmd& cmd) override;
+      virtual void Submit(const SetStencilStateCmd& cmd) override;
+      virtual void Submit(const BindBufferBaseCmd& cmd) override;
+      virtual void Submit(const BufferSubDataCmd& cmd , const uint8_t* data) override;
+      virtual void Submit(const SetUniformCmd& cmd) override;
+      virtual void SubmitInvalid(const RenderCommandHeader& header) override;
+  };
+
+  struct NullRenderStats {
+    std::array<uint64_t , NUM_RENDER_COMMANDS> commands{};
+    uint64_t draws = 0;
+    uint64_t instances = 0;
+    uint64_t elements = 0;
+    uint64_t bytes_uploaded = 0;
+
+    /// commands that would be an api error or draw garbage on a real backend
+    uint64_t validation_errors = 0;
+  };
+
+  /**
+   * replays nothing, counts what would be submitted and checks the stream the way a gpu driver would so the cpu side
+   *   of rendering can be benchmarked and tested headless
+   **/
+  class NullRenderBackend : public RenderBackend {
+    public:
+      virtual ~NullRenderBackend() override {}
+
+      const NullRenderStats& Stats() const;
+      void ResetStats();
+
+    protected:
+      virtual void BeginExecute() override;
+
+      virtual void Submit(const BindStorageRangeCmd& cmd) override;
+      virtual void Submit(const BindVertexArrayCmd& cmd) override;
+      virtual void Submit(const SetPolygonModeCmd& cmd) override;
+      virtual void Submit(const DrawIndexedCmd& cmd) override;
+      virtual void Submit(const UseProgramCmd& cmd) override;
+      virtual void Submit(const BindFramebufferCmd& cmd) override;
+      virtual void Submit(const BlitFramebufferCmd& cmd) override;
+      virtual void Submit(const BindTextureCmd& cmd) override;
+      virtual void Submit(const SetDepthStateCmd& cmd) override;
+      virtual void Submit(const SetStencilStateCmd& cmd) override;
+      virtual void Submit(const BindBufferBaseCmd& cmd) override;
+      virtual void Submit(const BufferSubDataCmd& cmd , const uint8_t* data) override;
+      virtual void Submit(const SetUniformCmd& cmd) override;
+      virtual void SubmitInvalid(const RenderCommandHeader& header) override;
+
+    private:
+      NullRenderStats stats;
+      uint32_t bound_vertex_array = 0;
+  };
+
+  /// replays commands right away on a throwaway gl backend , for binds and uploads made outside a recorded frame
+  void SubmitImmediate(const RenderCommandBuffer& commands);
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_RENDER_COMMANDS_HPP
@@ -19,6 +19,11 @@ namespace other {
     DefineInput({ "goe_normal"   , SAMPLER2D , sizeof(uint32_t) });
     DefineInput({ "goe_albedo"   , SAMPLER2D , sizeof(uint32_t) });
     for (auto& u : spec.uniforms) {
+      /// the shader never reads it, so there is no point in tracking or uploading it every frame
+      if (spec.shader != nullptr && spec.shader->IsUniformStripped(u.name)) {
+        stripped_inputs.insert(FNV(u.name));
+        continue;
+      }
       DefineInput(u);
     } 
 
@@ -43,46 +48,49 @@ namespace other {
     return spec.name;
   }
       
-  void RenderPass::Bind() {
+  void RenderPass::Bind(RenderCommandBuffer& commands) {
     if (spec.shader == nullptr) {
-      OE_ERROR("RenderPass [{}] has null shader!" , spec.shader);
+      OE_ERROR("RenderPass [{}] has null shader!" , spec.name);
       return;
     }
-    
-    CHECKGL();
-    
-    /// reset to sane default for next render pass
-    /// depth
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-    
-    CHECKGL();
-
-    /// stencil
-    glEnable(GL_STENCIL_TEST);
-    glStencilFunc(GL_ALWAYS , 1 , 0xFF);
-    glStencilMask(0xFF);
-    glStencilOp(GL_KEEP , GL_KEEP , GL_REPLACE);
 
-    CHECKGL();
-
-    SetRenderState();
+    /// reset to sane default for next render pass
+    SetDepthStateCmd depth{
+      .test = true ,
+      .func = GL_LESS ,
+    };
+    SetStencilStateCmd stencil{
+      .test = true ,
+      .func = GL_ALWAYS ,
+      .ref = 1 ,
+      .read_mask = 0xFF ,
+      .write_mask = 0xFF ,
+      .stencil_fail = GL_KEEP ,
+      .depth_fail = GL_KEEP ,
+      .depth_pass = GL_REPLACE ,
+    };
+    SetRenderState(depth , stencil);
 
-    CHECKGL();
+    commands.Record(depth);
+    commands.Record(stencil);
+    commands.Record(UseProgramCmd{ .program = spec.shader->ID() });
 
-    spec.shader->Bind();
+    /// everything staged into the pass's blocks since the last pass goes up in one upload per block
+    for (auto& [id , block] : uniform_blocks) {
+      block->Flush(commands);
+    }
   }
 
   Ref<Shader> RenderPass::GetShader() {
     return spec.shader;
   }
       
-  void RenderPass::Unbind() {
+  void RenderPass::Unbind(RenderCommandBuffer& commands) {
     if (spec.shader == nullptr) {
       return;
     }
 
-    spec.shader->Unbind();
+    commands.Record(UseProgramCmd{ .program = 0 });
   }
       
   void RenderPass::DefineInput(const Ref<UniformBuffer>& uni_buffer) {
@@ -108,4 +116,59 @@ namespace other {
     uniforms[hash] = uniform;
   }
 
+  PassInput RenderPass::ResolveInput(StringId name) {
+    for (uint32_t i = 0; i < resolved_inputs.size(); ++i) {
+      if (resolved_inputs[i].name == name) {
+        return PassInput{ i };
+      }
+    }
+
+    ResolvedInput resolved{ .name = name };
+
+    auto itr = uniforms.find(name.Hash());
+    if (itr == uniforms.end()) {
+      if (!stripped_inputs.contains(name.Hash())) {
+        OE_ERROR("Failed to resolve uniform {}, not defined in render pass {}" , name , spec.name);
+        return PassInput{};
+      }
+      resolved.stripped = true;
+    } else {
+      resolved.size = GetValueSize(itr->second.type);
+    }
+
+    if (spec.shader != nullptr && !resolved.stripped) {
+      if (spec.shader->ID() != resolved_program) {
+        RefreshInputLocations();
+      }
+      resolved.location = spec.shader->UniformLocation(name);
+    }
+
+    resolved_inputs.push_back(resolved);
+    return PassInput{ static_cast<uint32_t>(resolved_inputs.size() - 1) };
+  }
+
+  BlockInput RenderPass::ResolveInput(StringId block_name , StringId name) {
+    auto itr = uniform_blocks.find(block_name.Hash());
+    if (itr == uniform_blocks.end()) {
+      OE_ERROR("Failed to resolve uniform {}, block {} not defined in pass {}" , name , block_name , spec.name);
+      return BlockInput{};
+    }
+
+    auto& [id , block] = *itr;
+    return BlockInput{
+      .buffer = block.Raw() ,
+      .uniform = block->Resolve(name) ,
+    };
+  }
+
+  void RenderPass::RefreshInputLocations() {
+    resolved_program = spec.shader->ID();
+    for (auto& input : resolved_inputs) {
+      if (input.stripped) {
+        continue;
+      }
+      input.location = spec.shader->UniformLocation(input.name);
+    }
+  }
+
 } // namespace other
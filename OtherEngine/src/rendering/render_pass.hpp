@@ -4,6 +4,8 @@
 #ifndef OTHER_ENGINE_RENDER_PASS_HPP
 #define OTHER_ENGINE_RENDER_PASS_HPP
 
+#include <limits>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -13,7 +15,9 @@
 #include "core/ref.hpp"
 #include "core/ref_counted.hpp"
 #include "core/buffer.hpp"
+#include "core/string_id.hpp"
 
+#include "rendering/render_commands.hpp"
 #include "rendering/shader.hpp"
 #include "rendering/uniform.hpp"
 
@@ -85,6 +89,23 @@ namespace other {
     Ref<Shader> shader = nullptr;
   };
 
+  /// a shader uniform of a pass resolved once , stays valid when the pass's shader is reloaded
+  struct PassInput {
+    static constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    uint32_t index = kInvalidIndex;
+
+    bool Valid() const { return index != kInvalidIndex; }
+  };
+
+  /// a uniform inside one of a pass's blocks , values are staged and the block is uploaded when the pass binds
+  struct BlockInput {
+    UniformBuffer* buffer = nullptr;
+    UniformHandle uniform;
+
+    bool Valid() const { return buffer != nullptr && uniform.Valid(); }
+  };
+
   class RenderPass : public RefCounted {
     public:
       RenderPass(RenderPassSpec spec);
@@ -92,18 +113,21 @@ namespace other {
 
       std::string Name() const;
 
-      void Bind();
+      /// records the pass's state , program and block uploads , the draws follow in the same buffer
+      void Bind(RenderCommandBuffer& commands);
       Ref<Shader> GetShader();
-      void Unbind();
+      void Unbind(RenderCommandBuffer& commands);
 
       void DefineInput(const Ref<UniformBuffer>& uniform_block);
       void DefineInput(Uniform uniform);
       
-      template <typename T>
-      void SetInput(const std::string_view block_name , const std::string_view name , T val , uint32_t index = 0) {
-        uint64_t blck_hash = FNV(block_name);
+      /// resolve inputs once when the pipeline is built , SetInput with the handles does no lookups by name
+      PassInput ResolveInput(StringId name);
+      BlockInput ResolveInput(StringId block_name , StringId name);
 
-        auto itr = uniform_blocks.find(blck_hash);
+      template <typename T>
+      void SetInput(StringId block_name , StringId name , T val , uint32_t index = 0) {
+        auto itr = uniform_blocks.find(block_name.Hash());
         if (itr == uniform_blocks.end()) {
           OE_ERROR("Failed to set uniform {}, block {} not defined in pass {}" , name , block_name , spec.name);
           return;
@@ -115,11 +139,12 @@ namespace other {
 
       /// FIXME: do something about this mess
       template <typename T>
-      void SetInput(const std::string_view name , T val , uint32_t index = 0) {
-        uint64_t hash = FNV(name);
-
-        auto itr = uniforms.find(hash);
+      void SetInput(StringId name , T val , uint32_t index = 0) {
+        auto itr = uniforms.find(name.Hash());
         if (itr == uniforms.end()) {
+          if (stripped_inputs.contains(name.Hash())) {
+            return;
+          }
           OE_ERROR("Failed to set uniform {}, not defined in render pass {}" , name , spec.name);
           return;
         }
@@ -130,60 +155,45 @@ namespace other {
           return;
         }
 
-        if constexpr (std::same_as<T , int32_t>) {
-          auto itr = int_processors.find(id);
-          if (itr != int_processors.end()) {
-            auto& [id2 , processor] = *itr;
-            processor(val);
-          }
-        } else if constexpr (std::same_as<T , float>) {
-          auto itr = float_processors.find(id);
-          if (itr != float_processors.end()) {
-            auto& [id2 , processor] = *itr;
-            processor(val);
-          }
-        } else if constexpr (std::same_as<T , glm::vec2>) {
-          auto itr = vec2_processors.find(id);
-          if (itr != vec2_processors.end()) {
-            auto& [id2 , processor] = *itr;
-            processor(val);
-          }
-        } else if constexpr (std::same_as<T , glm::vec3>) {
-          auto itr = vec3_processors.find(id);
-          if (itr != vec3_processors.end()) {
-            auto& [id2 , processor] = *itr;
-            processor(val);
-          }
-        } else if constexpr (std::same_as<T , glm::vec4>) {
-          auto itr = vec4_processors.find(id);
-          if (itr != vec4_processors.end()) {
-            auto& [id2 , processor] = *itr;
-            processor(val);
-          }
-        } else if constexpr (std::same_as<T , glm::mat2>) {
-          auto itr = mat2_processors.find(id);
-          if (itr != mat2_processors.end()) {
-            auto& [id2 , processor] = *itr;
-            processor(val);
-          }
-        } else if constexpr (std::same_as<T , glm::mat3>) {
-          auto itr = mat3_processors.find(id);
-          if (itr != mat3_processors.end()) {
-            auto& [id2 , processor] = *itr;
-            processor(val);
-          }
-        } else if constexpr (std::same_as<T , glm::mat4>) {
-          auto itr = mat4_processors.find(id);
-          if (itr != mat4_processors.end()) {
-            auto& [id2 , processor] = *itr;
-            processor(val);
-          }
+        RunProcessor(id , val);
+        spec.shader->SetUniform(name , val , index);
+      }
+
+      /// records the value into commands after the pass's Bind , nothing reaches the graphics api until replay
+      template <typename T>
+      void SetInput(RenderCommandBuffer& commands , PassInput input , T val) {
+        if (!input.Valid() || spec.shader == nullptr) {
+          return;
+        }
+
+        if (spec.shader->ID() != resolved_program) {
+          RefreshInputLocations();
         }
 
-        spec.shader->SetUniform(uni.name , val , index);
+        const ResolvedInput& resolved = resolved_inputs[input.index];
+        if (resolved.stripped) {
+          return;
+        }
+
+        if (sizeof(T) != resolved.size) {
+          OE_ERROR("Attempting to set uniform {} to invalidly sized type {}" , resolved.name , typeid(T).name());
+          return;
+        }
+
+        RunProcessor(resolved.name.Hash() , val);
+        commands.RecordUniform(spec.shader->ID() , resolved.location , val);
+      }
+
+      template <typename T>
+      void SetInput(const BlockInput& input , const T& val , uint32_t index = 0) {
+        if (!input.Valid()) {
+          return;
+        }
+        input.buffer->Stage(input.uniform , val , index);
       }
 
-      virtual void SetRenderState() {}
+      /// starts from the defaults every pass shares , passes change whatever they need before it is recorded
+      virtual void SetRenderState(SetDepthStateCmd& depth , SetStencilStateCmd& stencil) {}
       /// just return them by default
       virtual Buffer ProcessModels(Buffer& buffer) { return buffer; }
       virtual Buffer ProcessMaterials(Buffer& buffer) { return buffer; }
@@ -192,8 +202,8 @@ namespace other {
       using UniformProcessor = std::function<void(T&)>;
 
       template <typename T>
-      void RegisterUniformProcessor(const std::string_view name , UniformProcessor<T> processor) {
-        UUID hash = FNV(name);
+      void RegisterUniformProcessor(StringId name , UniformProcessor<T> processor) {
+        UUID hash = name.Hash();
 
         if constexpr (std::same_as<T , int32_t>) {
           int_processors[hash] = processor;
@@ -215,8 +225,22 @@ namespace other {
       }
 
     private:
+      struct ResolvedInput {
+        StringId name;
+        uint32_t size = 0;
+        int32_t location = -1;
+
+        /// the shader never reads it , setting it does nothing
+        bool stripped = false;
+      };
+
       std::map<UUID , Uniform> uniforms;
       std::map<UUID , Ref<UniformBuffer>> uniform_blocks;
+      std::set<UUID> stripped_inputs;
+
+      /// PassInput indexes into this , locations are refreshed when the shader's program changes
+      std::vector<ResolvedInput> resolved_inputs;
+      uint32_t resolved_program = 0;
 
       RenderPassSpec spec;
 
@@ -231,6 +255,38 @@ namespace other {
       UniformProcessorMap<glm::mat2> mat2_processors;
       UniformProcessorMap<glm::mat3> mat3_processors;
       UniformProcessorMap<glm::mat4> mat4_processors;
+
+      void RefreshInputLocations();
+
+      template <typename T>
+      void RunProcessor(UUID id , T& val) {
+        UniformProcessorMap<T>* processors = nullptr;
+        if constexpr (std::same_as<T , int32_t>) {
+          processors = &int_processors;
+        } else if constexpr (std::same_as<T , float>) {
+          processors = &float_processors;
+        } else if constexpr (std::same_as<T , glm::vec2>) {
+          processors = &vec2_processors;
+        } else if constexpr (std::same_as<T , glm::vec3>) {
+          processors = &vec3_processors;
+        } else if constexpr (std::same_as<T , glm::vec4>) {
+          processors = &vec4_processors;
+        } else if constexpr (std::same_as<T , glm::mat2>) {
+          processors = &mat2_processors;
+        } else if constexpr (std::same_as<T , glm::mat3>) {
+          processors = &mat3_processors;
+        } else if constexpr (std::same_as<T , glm::mat4>) {
+          processors = &mat4_processors;
+        }
+
+        if (processors == nullptr) {
+          return;
+        }
+
+        if (auto itr = processors->find(id); itr != processors->end()) {
+          itr->second(val);
+        }
+      }
   }; 
 
 } // namespace other
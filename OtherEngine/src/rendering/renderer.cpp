@@ -5,7 +5,9 @@
 
 #include <glad/glad.h>
 
+#include "core/config_keys.hpp"
 #include "core/filesystem.hpp"
+#include "parsing/shader_cache.hpp"
 #include "rendering/rendering_defines.hpp"
 #include "rendering/shader.hpp"
 
@@ -27,6 +29,11 @@ namespace other {
     }
 
     window = std::move(win_res.Unwrap());
+
+    /// transpiled shaders are cached on disk so warm starts skip the shader compiler entirely
+    auto cache_dir = config.GetVal<std::string>(kRendererSection , kShaderCacheValue , false);
+    ShaderCache::Open(cache_dir.has_value() ?
+        Path{ cache_dir.value() } : Filesystem::GetWorkingDirectory() / ".cache" / "shaders");
     
     /// TODO: configure window shader and mesh using config
     const Path win_shader_path = Filesystem::GetEngineCoreDir() / "OtherEngine" / "assets" / "shaders" / "fbshader.oshader";
@@ -74,6 +81,7 @@ namespace other {
   void Renderer::Shutdown() {
     scene_ctx = nullptr;
     window = nullptr;
+    ShaderCache::Close();
   }
   
   const Scope<Window>& Renderer::GetWindow() { 
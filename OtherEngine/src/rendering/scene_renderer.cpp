@@ -7,13 +7,14 @@
 
 #include "core/defines.hpp"
 #include "core/logger.hpp"
+#include "core/profile.hpp"
 
 #include "rendering/uniform.hpp"
 
 namespace other {
 
   SceneRenderer::SceneRenderer(SceneRenderSpec spec)
-      : spec(spec) {
+      : spec(spec), light_clusters(spec.cluster_grid) {
     Initialize();
   }
 
@@ -33,9 +34,9 @@ namespace other {
     const glm::mat4& view = camera->ViewMatrix();
     glm::vec4 cam_pos = glm::vec4(camera->Position(), 1.f);
 
-    spec.camera_uniforms->SetUniform("projection", proj);
-    spec.camera_uniforms->SetUniform("view", view);
-    spec.camera_uniforms->SetUniform("viewpoint", cam_pos);
+    spec.camera_uniforms->Stage(uniform_handles.projection, proj);
+    spec.camera_uniforms->Stage(uniform_handles.view, view);
+    spec.camera_uniforms->Stage(uniform_handles.viewpoint, cam_pos);
     frame_data.viewpoint = camera;
   }
 
@@ -50,32 +51,25 @@ namespace other {
     glm::vec4 light_count{
       num_dir_lights, num_point_lights,
       0, 0};
-    spec.light_uniforms->BindBase();
-    spec.light_uniforms->SetUniform("num_lights", light_count);
-    for (size_t i = 0; i < num_point_lights; ++i) {
-      auto& l = environment->point_lights[i];
-      spec.light_uniforms->SetUniform("point_lights", l, i);
-    }
-    for (size_t i = 0; i < num_dir_lights; ++i) {
-      auto& l = environment->direction_lights[i];
-      spec.light_uniforms->SetUniform("direction_lights", l, i);
-    }
+    spec.light_uniforms->Stage(uniform_handles.num_lights, light_count);
+    spec.light_uniforms->StageArray<PointLight>(uniform_handles.point_lights, environment->point_lights);
+    spec.light_uniforms->StageArray<DirectionLight>(uniform_handles.direction_lights, environment->direction_lights);
     frame_data.environment = environment;
   }
 
-  void SceneRenderer::SubmitModel(const std::string_view pl_name, Ref<Model> model, const glm::mat4& transform, const Material& material) {
+  void SceneRenderer::SubmitModel(StringId pl_name, Ref<Model> model, const glm::mat4& transform, const Material& material) {
     if (model == nullptr) {
       return;
     }
   }
 
-  void SceneRenderer::SubmitStaticModel(const std::string_view pl_name, Ref<StaticModel> model,
+  void SceneRenderer::SubmitStaticModel(StringId pl_name, Ref<StaticModel> model,
                                         const glm::mat4& transform, const Material& material) {
     if (model == nullptr) {
       return;
     }
 
-    auto itr = pipelines.find(FNV(pl_name));
+    auto itr = pipelines.find(pl_name.Hash());
     if (itr == pipelines.end()) {
       OE_ERROR("Submitting model to unknown pipeline {}!", pl_name);
       return;
@@ -84,12 +78,12 @@ namespace other {
     itr->second->SubmitStaticModel(model, transform, material);
   }
 
-  void SceneRenderer::SubmitStaticModel(const std::string_view pl_name, const RenderSubmission& submission) {
+  void SceneRenderer::SubmitStaticModel(StringId pl_name, const RenderSubmission& submission) {
     if (submission.model == nullptr) {
       return;
     }
 
-    auto itr = pipelines.find(FNV(pl_name));
+    auto itr = pipelines.find(pl_name.Hash());
     if (itr == pipelines.end()) {
       OE_ERROR("Submitting model to unknown pipeline {}!", pl_name);
       return;
@@ -98,13 +92,32 @@ namespace other {
     itr->second->SubmitStaticModel(submission);
   }
 
+  void SceneRenderer::SubmitStaticModels(StringId pl_name, Ref<StaticModel> model,
+                                         std::span<const glm::mat4> transforms, std::span<const Material> materials) {
+    if (model == nullptr) {
+      return;
+    }
+
+    auto itr = pipelines.find(pl_name.Hash());
+    if (itr == pipelines.end()) {
+      OE_ERROR("Submitting model to unknown pipeline {}!", pl_name);
+      return;
+    }
+
+    itr->second->SubmitStaticModels(model, transforms, materials);
+  }
+
   bool SceneRenderer::EndScene() {
+    OE_PROFILE_SCOPE("SceneRenderer::EndScene");
+
     if (!FrameComplete()) {
       ResetFrame();
       return false;
     }
 
     PreRenderSettings();
+    BuildLightClusters();
+    FlushUniforms();
     FlushDrawList();
     ResetFrame();
     return true;
@@ -120,6 +133,18 @@ namespace other {
     return image_ir;
   }
 
+  Ref<CameraBase> SceneRenderer::Viewpoint() const {
+    return frame_data.viewpoint;
+  }
+
+  const LightClusters& SceneRenderer::GetLightClusters() const {
+    return light_clusters;
+  }
+
+  const LightClusterStats& SceneRenderer::GetLightClusterStats() const {
+    return cluster_stats;
+  }
+
   void SceneRenderer::Initialize() {
     /// already made render passes
     for (auto& rp : spec.passes) {
@@ -151,6 +176,24 @@ namespace other {
 
     spec.camera_uniforms->BindBase();
     spec.light_uniforms->BindBase();
+    if (spec.cluster_uniforms != nullptr) {
+      spec.cluster_uniforms->BindBase();
+    }
+
+    uniform_handles.projection = spec.camera_uniforms->Resolve("projection");
+    uniform_handles.view = spec.camera_uniforms->Resolve("view");
+    uniform_handles.viewpoint = spec.camera_uniforms->Resolve("viewpoint");
+
+    uniform_handles.num_lights = spec.light_uniforms->Resolve("num_lights");
+    uniform_handles.point_lights = spec.light_uniforms->Resolve("point_lights");
+    uniform_handles.direction_lights = spec.light_uniforms->Resolve("direction_lights");
+
+    if (spec.cluster_uniforms != nullptr) {
+      uniform_handles.cluster_grid = spec.cluster_uniforms->Resolve("cluster_grid");
+      uniform_handles.cluster_depth = spec.cluster_uniforms->Resolve("cluster_depth");
+      uniform_handles.clusters = spec.cluster_uniforms->Resolve("clusters");
+      uniform_handles.light_indices = spec.cluster_uniforms->Resolve("light_indices");
+    }
   }
 
   void SceneRenderer::Shutdown() {
@@ -162,7 +205,52 @@ namespace other {
     ///       but not below
   }
 
+  void SceneRenderer::BuildLightClusters() {
+    OE_PROFILE_SCOPE("SceneRenderer::BuildLightClusters");
+
+    const Ref<CameraBase>& camera = frame_data.viewpoint;
+    const glm::vec2& clip = camera->Clip();
+    cluster_stats = light_clusters.Build(*frame_data.environment, camera->ViewMatrix(), camera->ProjectionMatrix(), clip);
+
+    if (spec.cluster_uniforms == nullptr) {
+      return;
+    }
+
+    /// w of the grid is the number of indices in use, the depth block matches DepthSlice on the cpu
+    const LightClusterGrid& grid = light_clusters.Grid();
+    const glm::vec2 slice_params = light_clusters.DepthSliceParams();
+    glm::uvec4 cluster_grid{
+      grid.x, grid.y, grid.z,
+      cluster_stats.indices};
+    glm::vec4 cluster_depth{
+      slice_params.x, slice_params.y,
+      clip.x, clip.y};
+
+    spec.cluster_uniforms->Stage(uniform_handles.cluster_grid, cluster_grid);
+    spec.cluster_uniforms->Stage(uniform_handles.cluster_depth, cluster_depth);
+    spec.cluster_uniforms->StageArray<LightCluster>(uniform_handles.clusters, light_clusters.Clusters());
+    spec.cluster_uniforms->StageArray<uint32_t>(uniform_handles.light_indices, light_clusters.LightIndices());
+  }
+
+  void SceneRenderer::FlushUniforms() {
+    OE_PROFILE_SCOPE("SceneRenderer::FlushUniforms");
+
+    uniform_commands.Reset();
+    spec.camera_uniforms->Flush(uniform_commands);
+
+    spec.light_uniforms->BindBase(uniform_commands);
+    spec.light_uniforms->Flush(uniform_commands);
+    if (spec.cluster_uniforms != nullptr) {
+      spec.cluster_uniforms->BindBase(uniform_commands);
+      spec.cluster_uniforms->Flush(uniform_commands);
+    }
+
+    render_backend->Execute(uniform_commands);
+  }
+
   void SceneRenderer::FlushDrawList() {
+    OE_PROFILE_SCOPE("SceneRenderer::FlushDrawList");
+
     for (auto& [id, pl] : pipelines) {
       pl->Render();
       image_ir[id] = pl->GetOutput();
@@ -4,15 +4,20 @@
 #ifndef OTHER_ENGINE_SCENE_RENDERER_HPp
 #define OTHER_ENGINE_SCENE_RENDERER_HPp
 
+#include <span>
+
 #include <glm/glm.hpp>
 
 #include "core/ref_counted.hpp"
+#include "core/string_id.hpp"
 
 #include "scene/environment.hpp"
 
 #include "rendering/camera_base.hpp"
+#include "rendering/light_clusters.hpp"
 #include "rendering/model.hpp"
 #include "rendering/pipeline.hpp"
+#include "rendering/render_commands.hpp"
 #include "rendering/render_pass.hpp"
 
 namespace other {
@@ -21,6 +26,10 @@ namespace other {
     Ref<UniformBuffer> camera_uniforms;
     Ref<UniformBuffer> light_uniforms;
 
+    /// optional storage buffer the per-cluster light lists are uploaded to, lights are binned either way
+    Ref<UniformBuffer> cluster_uniforms = nullptr;
+    LightClusterGrid cluster_grid;
+
     std::vector<PipelineSpec> pipelines;
     std::vector<Ref<RenderPass>> passes;
 
@@ -33,21 +42,21 @@ namespace other {
     virtual ~SceneRenderer() override;
 
     template <typename T>
-    void SetUniform(const std::string_view pass, const std::string_view block, const std::string_view name, const T& val, uint32_t index = 0) {
-      if (auto itr = passes.find(FNV(pass)); itr != passes.end()) {
+    void SetUniform(StringId pass, StringId block, StringId name, const T& val, uint32_t index = 0) {
+      if (auto itr = passes.find(pass.Hash()); itr != passes.end()) {
         itr->second->SetInput(block, name, val, index);
       }
     }
 
     template <typename T>
-    void SetUniform(const std::string_view pass, std::string_view name, const T& val, uint32_t index = 0) {
-      if (auto itr = passes.find(FNV(pass)); itr != passes.end()) {
+    void SetUniform(StringId pass, StringId name, const T& val, uint32_t index = 0) {
+      if (auto itr = passes.find(pass.Hash()); itr != passes.end()) {
         itr->second->SetInput(name, val, index);
       }
     }
 
     template <typename T>
-    void SetLightUniform(const std::string_view name, const T& val, uint32_t index = 0) {
+    void SetLightUniform(StringId name, const T& val, uint32_t index = 0) {
       spec.light_uniforms->BindBase();
       spec.light_uniforms->SetUniform(name, val, index);
     }
@@ -60,9 +69,11 @@ namespace other {
     void SubmitDirectionLight(const DirectionLight& light);
     void SubmitPointLight(const PointLight& light);
 
-    void SubmitModel(const std::string_view pl_name, Ref<Model> model, const glm::mat4& transform, const Material& material);
-    void SubmitStaticModel(const std::string_view pl_name, Ref<StaticModel> model, const glm::mat4& transform, const Material& material);
-    void SubmitStaticModel(const std::string_view pl_name, const RenderSubmission& submission);
+    void SubmitModel(StringId pl_name, Ref<Model> model, const glm::mat4& transform, const Material& material);
+    void SubmitStaticModel(StringId pl_name, Ref<StaticModel> model, const glm::mat4& transform, const Material& material);
+    void SubmitStaticModel(StringId pl_name, const RenderSubmission& submission);
+    void SubmitStaticModels(StringId pl_name, Ref<StaticModel> model, std::span<const glm::mat4> transforms,
+                            std::span<const Material> materials);
 
     bool EndScene();
 
@@ -70,6 +81,12 @@ namespace other {
 
     const std::map<UUID, Ref<Framebuffer>>& GetRender() const;
 
+    /// camera submitted for the current frame, null until SubmitCamera
+    Ref<CameraBase> Viewpoint() const;
+
+    const LightClusters& GetLightClusters() const;
+    const LightClusterStats& GetLightClusterStats() const;
+
    private:
     glm::ivec2 viewport_size;
     SceneRenderSpec spec;
@@ -92,6 +109,29 @@ namespace other {
       Ref<Environment> environment = nullptr;
     } frame_data;
 
+    LightClusters light_clusters;
+    LightClusterStats cluster_stats;
+
+    /// resolved in Initialize, the submits stage through these and everything is uploaded once in EndScene
+    struct UniformHandles {
+      UniformHandle projection;
+      UniformHandle view;
+      UniformHandle viewpoint;
+
+      UniformHandle num_lights;
+      UniformHandle point_lights;
+      UniformHandle direction_lights;
+
+      UniformHandle cluster_grid;
+      UniformHandle cluster_depth;
+      UniformHandle clusters;
+      UniformHandle light_indices;
+    } uniform_handles;
+
+    /// binds and uploads for the frame's uniform blocks, replayed once before the pipelines render
+    Scope<RenderBackend> render_backend = NewScope<GlRenderBackend>();
+    RenderCommandBuffer uniform_commands;
+
     /// here go the passes
     ///  - bloom compute ?
     ///  - directional shadow pass
@@ -127,6 +167,8 @@ namespace other {
     void Shutdown();
 
     void PreRenderSettings();
+    void BuildLightClusters();
+    void FlushUniforms();
     void FlushDrawList();
 
     bool FrameComplete() const;
@@ -1,15 +1,19 @@
 #include "rendering/shader.hpp"
 
 #include <glad/glad.h>
+#include <algorithm>
 #include <string>
 #include <string>
 
 #include <glm/gtc/type_ptr.hpp>
 
 #include "core/logger.hpp"
+#include "core/profile.hpp"
 #include "core/rand.hpp"
 #include "core/filesystem.hpp"
 
+#include "asset/asset_reloader.hpp"
+#include "parsing/shader_cache.hpp"
 #include "parsing/shader_compiler.hpp"
 
 namespace other {
@@ -21,6 +25,10 @@ namespace other {
   const bool Shader::HasGeometry() const {
     return ir.geom_source.has_value();
   }
+
+  bool Shader::IsUniformStripped(const std::string_view name) const {
+    return std::find(ir.stripped_uniforms.begin() , ir.stripped_uniforms.end() , name) != ir.stripped_uniforms.end();
+  }
       
   Shader::Shader(const ShaderIr& src) 
       : ir(src) {
@@ -40,7 +48,41 @@ namespace other {
   }
   
   Shader::~Shader() {
-   glDeleteProgram(renderer_id);
+    if (AssetReloader* reloader = AssetReloader::Get(); reloader != nullptr) {
+      reloader->Untrack(handle);
+    }
+    glDeleteProgram(renderer_id);
+  }
+
+  bool Shader::Reload(const ShaderIr& src) {
+    OE_PROFILE_SCOPE("Shader::Reload");
+
+    const uint32_t old_id = renderer_id;
+    const bool old_valid = valid;
+    ShaderIr old_ir = std::move(ir);
+
+    ir = src;
+    renderer_id = 0;
+    valid = false;
+
+    const char* gsrc_ptr = HasGeometry() ? ir.geom_source.value().c_str() : nullptr;
+    if (!Compile(ir.vert_source.c_str() , ir.frag_source.c_str() , gsrc_ptr)) {
+      OE_ERROR("Failed to reload shader : {}, keeping the previous program" , src.name);
+      if (renderer_id != 0) {
+        glDeleteProgram(renderer_id);
+      }
+
+      renderer_id = old_id;
+      valid = old_valid;
+      ir = std::move(old_ir);
+      return false;
+    }
+
+    glDeleteProgram(old_id);
+    uniform_locations.clear();
+
+    OE_DEBUG("Reloaded shader : {}" , ir.name);
+    return true;
   }
 
   uint32_t Shader::ID() const {
@@ -58,47 +100,41 @@ namespace other {
     glUseProgram(0);
   }
     
-  void Shader::InnerSetUniform(const std::string_view name , const int32_t& value , uint32_t index) {
-    uint32_t loc = GetUniformLocation(name);
+  void Shader::InnerSetUniform(int32_t loc , const int32_t& value) {
     glUniform1i(loc , value);
   }
   
-  void Shader::InnerSetUniform(const std::string_view name , const float& value , uint32_t index) {
-    uint32_t loc = GetUniformLocation(name);
+  void Shader::InnerSetUniform(int32_t loc , const float& value) {
     glUniform1f(loc , value);
   }
   
-  void Shader::InnerSetUniform(const std::string_view name , const glm::vec2& value , uint32_t index) {
-    uint32_t loc = GetUniformLocation(name);
+  void Shader::InnerSetUniform(int32_t loc , const glm::vec2& value) {
     glUniform2f(loc , value.x , value.y);
   }
   
-  void Shader::InnerSetUniform(const std::string_view name , const glm::vec3& value , uint32_t index) {
-    uint32_t loc = GetUniformLocation(name);
+  void Shader::InnerSetUniform(int32_t loc , const glm::vec3& value) {
     glUniform3f(loc , value.x , value.y , value.z);
   }
   
-  void Shader::InnerSetUniform(const std::string_view name , const glm::vec4& value , uint32_t index) {
-    uint32_t loc = GetUniformLocation(name);
+  void Shader::InnerSetUniform(int32_t loc , const glm::vec4& value) {
     glUniform4f(loc , value.x , value.y , value.z , value.w);
   }
   
-  void Shader::InnerSetUniform(const std::string_view name , const glm::mat2& value , uint32_t index) {
-    uint32_t loc = GetUniformLocation(name);
+  void Shader::InnerSetUniform(int32_t loc , const glm::mat2& value) {
     glUniformMatrix2fv(loc , 1 , GL_FALSE , glm::value_ptr(value));
   }
   
-  void Shader::InnerSetUniform(const std::string_view name , const glm::mat3& value , uint32_t index) {
-    uint32_t loc = GetUniformLocation(name);
+  void Shader::InnerSetUniform(int32_t loc , const glm::mat3& value) {
     glUniformMatrix3fv(loc , 1 , GL_FALSE , glm::value_ptr(value));
   }
   
-  void Shader::InnerSetUniform(const std::string_view name , const glm::mat4& value , uint32_t index) {
-    uint32_t loc = GetUniformLocation(name);
+  void Shader::InnerSetUniform(int32_t loc , const glm::mat4& value) {
     glUniformMatrix4fv(loc , 1 , GL_FALSE , glm::value_ptr(value));
   }
       
   bool Shader::Compile(const char* vsrc , const char* fsrc , const char* gsrc) {
+    OE_PROFILE_SCOPE("Shader::Compile");
+
     uint32_t vertex_shader = glCreateShader(GL_VERTEX_SHADER);
     uint32_t fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
     Opt<uint32_t> geometry_shader = std::nullopt;
@@ -192,30 +228,42 @@ namespace other {
     return true;
   }
   
-  uint32_t Shader::GetUniformLocation(const std::string_view name) {
-    auto hash = FNV(name);
-    if (uniform_locations.find(hash) != uniform_locations.end()) {
-      return uniform_locations[hash];
+  int32_t Shader::UniformLocation(StringId name) {
+    if (auto itr = uniform_locations.find(name.Hash()); itr != uniform_locations.end()) {
+      return itr->second;
     }
   
-    std::string name_str = std::string{ name };
+    std::string name_str = std::string{ name.Str() };
     int32_t location = glGetUniformLocation(renderer_id , name_str.c_str());
-    uniform_locations[hash] = location;
+    uniform_locations[name.Hash()] = location;
   
     return location;
   }
   
   Ref<Shader> BuildShader(const Path& path) {
-    std::string src = Filesystem::ReadFile(path);
-    if (src.empty()) {
+    if (!Filesystem::FileExists(path)) {
       OE_ERROR("Failed to read shader file {}" , path);
       return nullptr;
     }
 
-    ShaderIr ir = ShaderCompiler::Compile(src);
-    ir.name = path.filename().string();
+    ShaderIr ir;
+    try {
+      ir = ShaderCompiler::Compile(path , ShaderCache::Instance());
+    } catch (const ShaderException& e) {
+      OE_ERROR("Failed to build shader {} : {}" , path , e.what());
+      return nullptr;
+    }
 
-    return NewRef<Shader>(ir);
+    Ref<Shader> shader = NewRef<Shader>(ir);
+
+    /// the reloader only runs the commit while the shader is alive , the destructor untracks it
+    if (AssetReloader* reloader = AssetReloader::Get(); reloader != nullptr) {
+      Shader* live = shader.Raw();
+      TrackShaderSource(*reloader , shader->handle , path , [live](const ShaderIr& rebuilt) {
+        live->Reload(rebuilt);
+      });
+    }
+    return shader;
   }
 
 } // namespace yockcraft
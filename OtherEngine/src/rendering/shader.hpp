@@ -9,6 +9,7 @@
 #include <glad/glad.h>
 
 #include "core/defines.hpp"
+#include "core/string_id.hpp"
 #include "asset/asset.hpp"
 
 #include "rendering/rendering_defines.hpp"
@@ -26,6 +27,9 @@ namespace other {
     std::string vert_source = ""; 
     std::string frag_source = "";
     Opt<std::string> geom_source = std::nullopt;
+
+    /// uniforms the optimizer removed because no stage reads them, setting them is a no-op
+    std::vector<std::string> stripped_uniforms;
   };
 
   class Shader : public Asset {    
@@ -43,15 +47,30 @@ namespace other {
       const bool IsValid() const;
 
       const bool HasGeometry() const;
+
+      bool IsUniformStripped(const std::string_view name) const;
+
+      /// swaps in a program built from src , on failure the current program stays bound to this shader
+      bool Reload(const ShaderIr& src);
     
       template <typename T> 
-      void SetUniform(const std::string_view name , T&& value , uint32_t index = 0) {
+      void SetUniform(StringId name , T&& value , uint32_t index = 0) {
         Bind();
-        InnerSetUniform(name , std::forward<T>(value) , index); 
+        InnerSetUniform(UniformLocation(name) , std::forward<T>(value)); 
       }
 
+      /// sets a uniform through a location from UniformLocation , skips the location cache entirely
+      template <typename T>
+      void SetUniformAt(int32_t location , T&& value) {
+        Bind();
+        InnerSetUniform(location , std::forward<T>(value));
+      }
+
+      /// -1 when the program has no such uniform , locations change when the shader is reloaded (ID() changes with it)
+      int32_t UniformLocation(StringId name);
+
     private:
-      uint32_t renderer_id;
+      uint32_t renderer_id = 0;
 
       ShaderIr ir;
   
@@ -64,16 +83,14 @@ namespace other {
       bool CompileShader(ShaderType type , uint32_t shader_piece , const char* src);
       bool LinkShader();
   
-      uint32_t GetUniformLocation(const std::string_view name);
-      
-      void InnerSetUniform(const std::string_view name , const int32_t& value , uint32_t index = 0);
-      void InnerSetUniform(const std::string_view name , const float& value , uint32_t index = 0);
-      void InnerSetUniform(const std::string_view name , const glm::vec2& value , uint32_t index = 0);
-      void InnerSetUniform(const std::string_view name , const glm::vec3& value , uint32_t index = 0);
-      void InnerSetUniform(const std::string_view name , const glm::vec4& value , uint32_t index = 0);
-      void InnerSetUniform(const std::string_view name , const glm::mat2& value , uint32_t index = 0);
-      void InnerSetUniform(const std::string_view name , const glm::mat3& value , uint32_t index = 0);
-      void InnerSetUniform(const std::string_view name , const glm::mat4& value , uint32_t index = 0);
+      void InnerSetUniform(int32_t location , const int32_t& value);
+      void InnerSetUniform(int32_t location , const float& value);
+      void InnerSetUniform(int32_t location , const glm::vec2& value);
+      void InnerSetUniform(int32_t location , const glm::vec3& value);
+      void InnerSetUniform(int32_t location , const glm::vec4& value);
+      void InnerSetUniform(int32_t location , const glm::mat2& value);
+      void InnerSetUniform(int32_t location , const glm::mat3& value);
+      void InnerSetUniform(int32_t location , const glm::mat4& value);
   };
 
   Ref<Shader> BuildShader(const Path& path);
@@ -3,6 +3,8 @@
  **/
 #include "rendering/uniform.hpp"
 
+#include <cstring>
+
 #include <glad/glad.h>
 
 #include "core/defines.hpp"
@@ -10,39 +12,104 @@
 
 namespace other {
 
-  UniformBuffer::UniformBuffer(const std::string& name , const std::vector<Uniform> unis , uint32_t binding_point ,
-                               BufferType type , BufferUsage usage) 
-      : name(name) , type(type) , usage(usage) , binding_point(binding_point)  { 
-    glGenBuffers(1 , &renderer_id);
-    glBindBuffer(type , renderer_id);
-    
-    uint32_t offset = 0;
-    for (const auto& u : unis) {
+  UniformLayout::UniformLayout(const std::vector<Uniform>& uniforms) {
+    for (const auto& u : uniforms) {
       size_t type_size = GetValueSize(u.type);
       if (type_size == 0) {
         if (!u.size.has_value()) {
           OE_ERROR("Can not set uniform size for user defined type, failed on uniform '{}'" , u.name);
-          glBindBuffer(type , 0);
-          glDeleteBuffers(1 , &renderer_id);
+          valid = false;
           return;
         } else {
           type_size = *u.size;
         }
       } 
 
-      size += type_size * u.arr_length;
-
-      UUID hash = FNV(u.name);
-      auto& u_data = uniforms[hash] = UniformData{
-        .hash = hash , 
-        .offset = offset ,
-        .size = type_size ,
+      handles[FNV(u.name)] = UniformHandle{
+        .offset = size ,
+        .size = static_cast<uint32_t>(type_size) ,
+        .arr_length = u.arr_length ,
       };
 
-      offset += u_data.size * u.arr_length;
-      
+      size += static_cast<uint32_t>(type_size * u.arr_length);
+    }
+  }
+
+  bool UniformLayout::Valid() const {
+    return valid;
+  }
+
+  uint32_t UniformLayout::Size() const {
+    return size;
+  }
+
+  UniformHandle UniformLayout::Find(StringId name) const {
+    if (auto itr = handles.find(name.Hash()); itr != handles.end()) {
+      return itr->second;
+    }
+    return {};
+  }
+
+  void UniformStaging::Resize(uint32_t size) {
+    bytes.assign(size , 0);
+    MarkClean();
+  }
+
+  bool UniformStaging::Dirty() const {
+    return dirty_begin < dirty_end;
+  }
+
+  uint32_t UniformStaging::DirtyOffset() const {
+    return dirty_begin;
+  }
+
+  std::span<const uint8_t> UniformStaging::DirtyBytes() const {
+    if (!Dirty()) {
+      return {};
+    }
+    return std::span<const uint8_t>{ bytes }.subspan(dirty_begin , dirty_end - dirty_begin);
+  }
+
+  void UniformStaging::MarkClean() {
+    dirty_begin = std::numeric_limits<uint32_t>::max();
+    dirty_end = 0;
+  }
+
+  void UniformStaging::RecordUpload(RenderCommandBuffer& commands , uint32_t target , uint32_t buffer) {
+    if (!Dirty()) {
+      return;
+    }
+
+    commands.RecordUpload(target , buffer , dirty_begin , DirtyBytes());
+    MarkClean();
+  }
+
+  std::span<const uint8_t> UniformStaging::Bytes() const {
+    return bytes;
+  }
+
+  void UniformStaging::WriteBytes(uint32_t offset , const void* src , size_t size) {
+    OE_ASSERT(offset + size <= bytes.size() , "Staged uniform write [{} , {}) is outside the {} byte block" , offset ,
+              offset + size , bytes.size());
+
+    std::memcpy(bytes.data() + offset , src , size);
+    dirty_begin = std::min(dirty_begin , offset);
+    dirty_end = std::max(dirty_end , static_cast<uint32_t>(offset + size));
+  }
+
+  UniformBuffer::UniformBuffer(const std::string& name , const std::vector<Uniform> unis , uint32_t binding_point ,
+                               BufferType type , BufferUsage usage) 
+      : layout(unis) , name(name) , type(type) , usage(usage) , binding_point(binding_point)  { 
+    if (!layout.Valid()) {
+      return;
     }
 
+    size = layout.Size();
+    staging.Resize(size);
+
+    glGenBuffers(1 , &renderer_id);
+    glBindBuffer(type , renderer_id);
+
     OE_DEBUG("Allocating Uniform Buffer {} = {}" , name , size);
 
     glBufferData(type , size , nullptr , usage);
@@ -63,7 +130,17 @@ namespace other {
   }
       
   void UniformBuffer::BindBase() {
-    glBindBufferBase(type , binding_point , renderer_id);
+    RenderCommandBuffer commands;
+    BindBase(commands);
+    SubmitImmediate(commands);
+  }
+
+  void UniformBuffer::BindBase(RenderCommandBuffer& commands) {
+    commands.Record(BindBufferBaseCmd{
+      .target = static_cast<uint32_t>(type) ,
+      .binding_point = binding_point ,
+      .buffer = renderer_id ,
+    });
   }
 
   void UniformBuffer::BindRange(size_t offset , size_t size) {
@@ -96,31 +173,33 @@ namespace other {
     CHECKGL();
   }
       
-  uint32_t UniformBuffer::CalculateOffset(const UniformData& uniform , uint32_t index) {
-    return uniform.offset + index * uniform.size;
+  const UniformLayout& UniformBuffer::GetLayout() const {
+    return layout;
   }
-      
-  std::tuple<UniformBuffer::UniformData , bool , uint32_t> UniformBuffer::TryFind(const std::string_view name , uint32_t index) {
-    auto [id , u_data] = GetUniform(name);
-    if (id.Get() == 0) {
-      return { {} , false  , 0 };
+
+  UniformHandle UniformBuffer::Resolve(StringId uniform) const {
+    UniformHandle handle = layout.Find(uniform);
+    if (!handle.Valid()) {
+      OE_ERROR("Attempting to resolve invalid uniform {} in {}" , uniform , name);
     }
-    
-    uint32_t offset = CalculateOffset(u_data , index); 
-    return { u_data , true , offset };
+    return handle;
   }
-      
-  std::pair<UUID , UniformBuffer::UniformData> UniformBuffer::GetUniform(const std::string_view name) {
-    static const auto null_uniform = std::pair<UUID , UniformBuffer::UniformData>{ 0 , {} };
-
-    UUID hash = FNV(name);
-    auto itr = uniforms.find(hash);
-    if (itr == uniforms.end()) {
-      OE_ERROR("Attempting to set invalid uniform {}" , name);
-      return null_uniform;
+
+  void UniformBuffer::Flush(RenderCommandBuffer& commands) {
+    if (renderer_id == 0) {
+      return;
+    }
+    staging.RecordUpload(commands , type , renderer_id);
+  }
+
+  void UniformBuffer::Flush() {
+    if (!staging.Dirty()) {
+      return;
     }
 
-    return *uniforms.find(hash);
+    RenderCommandBuffer commands;
+    Flush(commands);
+    SubmitImmediate(commands);
   }
 
 } // namespace other
@@ -5,16 +5,23 @@
 #define OTHER_ENGINE_UNIFORM_HPP
 
 #include <rendering/point_light.hpp>
+#include <algorithm>
+#include <limits>
+#include <span>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include "core/string_id.hpp"
 #include "core/uuid.hpp"
 #include "core/ref_counted.hpp"
 #include "core/buffer.hpp"
 #include "math/vecmath.hpp"
 
 #include "rendering/rendering_defines.hpp"
+#include "rendering/render_commands.hpp"
 #include "rendering/point_light.hpp"
 #include "rendering/direction_light.hpp"
 
@@ -38,6 +45,98 @@ namespace other {
     std::map<UUID , Uniform> uniforms;
   };
 
+  /// where one uniform lives in its block , resolved from the name once and reused every frame
+  struct UniformHandle {
+    uint32_t offset = 0;
+
+    /// bytes of one element
+    uint32_t size = 0;
+    uint32_t arr_length = 0;
+
+    bool Valid() const { return size != 0; }
+  };
+
+  /**
+   * offsets of every uniform in a block , packed back to back in declaration order
+   *
+   * no gl calls , a layout can be built and checked without a context
+   **/
+  class UniformLayout {
+    public:
+      UniformLayout() = default;
+      UniformLayout(const std::vector<Uniform>& uniforms);
+
+      /// false when a user type uniform was declared without a size
+      bool Valid() const;
+      uint32_t Size() const;
+
+      /// invalid handle when the block has no uniform called name
+      UniformHandle Find(StringId name) const;
+
+    private:
+      std::unordered_map<UUID , UniformHandle> handles;
+      uint32_t size = 0;
+      bool valid = true;
+  };
+
+  /**
+   * cpu copy of a block , writes land here and everything between the first and last byte written since the last
+   *   MarkClean goes up in one upload
+   **/
+  class UniformStaging {
+    public:
+      void Resize(uint32_t size);
+
+      /// false when the handle is invalid , index is out of range , or T is not the size of one element
+      template <typename T>
+      bool Write(const UniformHandle& handle , const T& value , uint32_t index = 0) {
+        if (!handle.Valid() || index >= handle.arr_length || sizeof(T) != handle.size) {
+          return false;
+        }
+
+        WriteBytes(handle.offset + index * handle.size , &value , sizeof(T));
+        return true;
+      }
+
+      /// writes values into consecutive elements starting at first , anything past the end of the array is dropped ,
+      ///   returns the number of elements written
+      template <typename T>
+      uint32_t WriteArray(const UniformHandle& handle , std::span<const T> values , uint32_t first = 0) {
+        if (!handle.Valid() || sizeof(T) != handle.size || first >= handle.arr_length) {
+          return 0;
+        }
+
+        const uint32_t count = static_cast<uint32_t>(std::min<size_t>(values.size() , handle.arr_length - first));
+        if (count > 0) {
+          WriteBytes(handle.offset + first * handle.size , values.data() , count * sizeof(T));
+        }
+        return count;
+      }
+
+      bool Dirty() const;
+
+      /// offset of the first changed byte , only meaningful while Dirty
+      uint32_t DirtyOffset() const;
+
+      /// every byte from the first to the last one written since the last MarkClean
+      std::span<const uint8_t> DirtyBytes() const;
+
+      void MarkClean();
+
+      /// copies the dirty range into commands as one upload into buffer and marks the block clean , records nothing when clean
+      void RecordUpload(RenderCommandBuffer& commands , uint32_t target , uint32_t buffer);
+
+      std::span<const uint8_t> Bytes() const;
+
+    private:
+      std::vector<uint8_t> bytes;
+
+      uint32_t dirty_begin = std::numeric_limits<uint32_t>::max();
+      uint32_t dirty_end = 0;
+
+      void WriteBytes(uint32_t offset , const void* src , size_t size);
+  };
+
   class UniformBuffer : public RefCounted {
     public:
       UniformBuffer(const std::string& name , const std::vector<Uniform> uniforms , uint32_t binding_point , 
@@ -49,29 +148,74 @@ namespace other {
       bool Bound() const;
 
       void BindBase();
+      void BindBase(RenderCommandBuffer& commands);
       void BindRange(size_t offset  = 0 , size_t size = 0);
 
       void Bind();
 
       void LoadFromBuffer(const Buffer& buffer);
-      
+
+      const UniformLayout& GetLayout() const;
+
+      /// resolve once when the buffer is set up , the handle stays valid for the lifetime of the buffer
+      UniformHandle Resolve(StringId name) const;
+
+      /// copies value into the staged block , nothing reaches the gpu until Flush
       template <typename T>
-      void SetUniform(const std::string_view name , const T& value , uint32_t index = 0) {
-        auto [u_data , success , offset] = TryFind(name , index);
-        if (!success) {
+      void Stage(const UniformHandle& handle , const T& value , uint32_t index = 0) {
+        /// failing to resolve was already reported
+        if (!handle.Valid()) {
           return;
         }
 
-        Bind();
-        if constexpr (glm_t<T>) {
-          glBufferSubData(type , offset , u_data.size , glm::value_ptr(value));
-        } else {
-          glBufferSubData(type , offset , u_data.size , &value);
+        if (!staging.Write(handle , value , index)) {
+          OE_ERROR("Failed to stage uniform element {} of {} bytes into {}" , index , sizeof(T) , name);
+        }
+      }
+
+      template <typename T>
+      void StageArray(const UniformHandle& handle , std::span<const T> values , uint32_t first = 0) {
+        if (!handle.Valid()) {
+          return;
         }
-        CHECKGL();
-        Unbind();
 
-        CHECKGL();
+        if (handle.size != sizeof(T)) {
+          OE_ERROR("Uniform array in {} has elements of {} bytes, attempted to stage {} byte elements" , name , 
+                   handle.size , sizeof(T));
+          return;
+        }
+        staging.WriteArray(handle , values , first);
+      }
+
+      /// records one upload of everything staged since the last flush , records nothing when nothing changed
+      void Flush(RenderCommandBuffer& commands);
+
+      /// Flush replayed right away , for uploads made outside a recorded frame
+      void Flush();
+
+      /// resolves and uploads immediately , prefer a handle and Stage for anything set every frame
+      template <typename T>
+      void SetUniform(StringId name , const T& value , uint32_t index = 0) {
+        UniformHandle handle = Resolve(name);
+        if (!handle.Valid()) {
+          return;
+        }
+
+        Stage(handle , value , index);
+        Flush();
+      }
+
+      /// writes values into consecutive elements of an array uniform starting at first with one upload, anything past
+      ///   the end of the array is dropped
+      template <typename T>
+      void SetUniformArray(StringId name , std::span<const T> values , uint32_t first = 0) {
+        UniformHandle handle = Resolve(name);
+        if (!handle.Valid() || values.empty()) {
+          return;
+        }
+
+        StageArray(handle , values , first);
+        Flush();
       }
 
       void Unbind();
@@ -79,14 +223,8 @@ namespace other {
       void Clear();
 
     private:
-      struct UniformData {
-        Uniform uniform;
-        UUID hash;
-        size_t offset;
-        size_t size;
-      };
-
-      std::map<UUID , UniformData> uniforms;
+      UniformLayout layout;
+      UniformStaging staging;
 
       const std::string name;
       bool bound = false;
@@ -97,10 +235,6 @@ namespace other {
       uint32_t binding_point;
       uint32_t size = 0;
       uint32_t renderer_id = 0;
-
-      uint32_t CalculateOffset(const UniformData& uniform , uint32_t index);
-      std::tuple<UniformData , bool , uint32_t> TryFind(const std::string_view name , uint32_t index);
-      std::pair<UUID , UniformData> GetUniform(const std::string_view name);
   };
 
 } // namespace other
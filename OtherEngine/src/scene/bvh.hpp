@@ -171,11 +171,11 @@ namespace other {
       GetSpace().AddEntity(entity, local_pos);
     }
 
-    void RenderEntityBounds(const std::string_view pl_name, Ref<SceneRenderer>& renderer, bool outline = true) {
+    void RenderEntityBounds(StringId pl_name, RefView<SceneRenderer> renderer, bool outline = true) {
       GetSpace().RenderEntityBounds(pl_name, renderer, outline);
     }
 
-    void RenderBounds(const std::string_view pl_name, Ref<SceneRenderer>& renderer, Opt<size_t> depth = std::nullopt) {
+    void RenderBounds(StringId pl_name, RefView<SceneRenderer> renderer, Opt<size_t> depth = std::nullopt) {
       GetSpace().RenderNodeBounds(pl_name, renderer, depth.value_or(Depth() - 1));
     }
 
@@ -315,7 +315,7 @@ namespace other {
 
       auto& entities = scene->SceneEntities();
       for (auto& [id, ent] : entities) {
-        AddEntity(ent, ent->ReadComponent<Transform>().position);
+        AddEntity(ent, ent->template ReadComponent<Transform>().position);
       }
     }
 
@@ -339,8 +339,8 @@ namespace other {
 
     void Subdivide(size_t depth);
 
-    void RenderEntityBounds(const std::string_view pl_name, Ref<SceneRenderer>& renderer, bool outline);
-    void RenderNodeBounds(const std::string_view pl_name, Ref<SceneRenderer>& renderer, size_t depth);
+    void RenderEntityBounds(StringId pl_name, RefView<SceneRenderer> renderer, bool outline);
+    void RenderNodeBounds(StringId pl_name, RefView<SceneRenderer> renderer, size_t depth);
 
     int64_t tree_index = -1;
 
@@ -530,7 +530,7 @@ namespace other {
   }
 
   template <size_t N>
-  void BvhNode<N>::RenderEntityBounds(const std::string_view pl_name, Ref<SceneRenderer>& renderer, bool outline) {
+  void BvhNode<N>::RenderEntityBounds(StringId pl_name, RefView<SceneRenderer> renderer, bool outline) {
     const static AssetHandle wireframe = ModelFactory::CreateBoxWireframe();
     Ref<StaticModel> model = AssetManager::GetAsset<StaticModel>(wireframe);
     Material mat = {
@@ -567,7 +567,7 @@ namespace other {
   }
 
   template <size_t N>
-  void BvhNode<N>::RenderNodeBounds(const std::string_view pl_name, Ref<SceneRenderer>& renderer, size_t depth) {
+  void BvhNode<N>::RenderNodeBounds(StringId pl_name, RefView<SceneRenderer> renderer, size_t depth) {
     constexpr glm::mat4 identity = glm::identity<glm::mat4>();
     const static AssetHandle wireframe = ModelFactory::CreateBoxWireframe();
 
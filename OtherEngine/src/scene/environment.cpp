@@ -5,6 +5,105 @@
 
 namespace other {
 
+  void Environment::SetLight(uint64_t id , const DirectionLight& light) {
+    ++version;
+    RemovePointLight(id);
 
+    if (auto itr = direction_light_slots.find(id); itr != direction_light_slots.end()) {
+      direction_lights[itr->second] = light;
+      return;
+    }
+
+    direction_light_slots[id] = static_cast<uint32_t>(direction_lights.size());
+    direction_lights.push_back(light);
+    direction_light_owners.push_back(id);
+  }
+
+  void Environment::SetLight(uint64_t id , const PointLight& light) {
+    ++version;
+    RemoveDirectionLight(id);
+
+    if (auto itr = point_light_slots.find(id); itr != point_light_slots.end()) {
+      point_lights[itr->second] = light;
+      point_light_versions[itr->second] = version;
+      return;
+    }
+
+    point_light_slots[id] = static_cast<uint32_t>(point_lights.size());
+    point_lights.push_back(light);
+    point_light_versions.push_back(version);
+    point_light_owners.push_back(id);
+  }
+
+  void Environment::RemoveLight(uint64_t id) {
+    ++version;
+    if (!RemovePointLight(id)) {
+      RemoveDirectionLight(id);
+    }
+  }
+
+  void Environment::Clear() {
+    ++version;
+    direction_lights.clear();
+    direction_light_owners.clear();
+    direction_light_slots.clear();
+
+    point_lights.clear();
+    point_light_versions.clear();
+    point_light_owners.clear();
+    point_light_slots.clear();
+  }
+
+  uint64_t Environment::Version() const {
+    return version;
+  }
+
+  std::span<const uint64_t> Environment::PointLightVersions() const {
+    return point_light_versions;
+  }
+
+  bool Environment::RemovePointLight(uint64_t id) {
+    auto itr = point_light_slots.find(id);
+    if (itr == point_light_slots.end()) {
+      return false;
+    }
+
+    const uint32_t slot = itr->second;
+    const uint32_t last = static_cast<uint32_t>(point_lights.size()) - 1;
+    point_light_slots.erase(itr);
+
+    if (slot != last) {
+      point_lights[slot] = point_lights[last];
+      point_light_owners[slot] = point_light_owners[last];
+      point_light_versions[slot] = version;
+      point_light_slots[point_light_owners[slot]] = slot;
+    }
+
+    point_lights.pop_back();
+    point_light_owners.pop_back();
+    point_light_versions.pop_back();
+    return true;
+  }
+
+  bool Environment::RemoveDirectionLight(uint64_t id) {
+    auto itr = direction_light_slots.find(id);
+    if (itr == direction_light_slots.end()) {
+      return false;
+    }
+
+    const uint32_t slot = itr->second;
+    const uint32_t last = static_cast<uint32_t>(direction_lights.size()) - 1;
+    direction_light_slots.erase(itr);
+
+    if (slot != last) {
+      direction_lights[slot] = direction_lights[last];
+      direction_light_owners[slot] = direction_light_owners[last];
+      direction_light_slots[direction_light_owners[slot]] = slot;
+    }
+
+    direction_lights.pop_back();
+    direction_light_owners.pop_back();
+    return true;
+  }
 
 } // namespace other
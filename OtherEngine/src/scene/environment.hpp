@@ -4,6 +4,8 @@
 #ifndef OTHER_ENGINE_ENVIRONMENT_HPP
 #define OTHER_ENGINE_ENVIRONMENT_HPP
 
+#include <span>
+#include <unordered_map>
 #include <vector>
 
 #include "core/ref_counted.hpp"
@@ -13,10 +15,44 @@
 
 namespace other {
 
+  /**
+   * every light in a scene keyed by whoever owns it (the scene uses entity handles), lights are packed so the arrays
+   *   can be uploaded as is
+   *
+   * the light arrays are read only outside this class, changes go through SetLight and RemoveLight so only the
+   *   touched lights have to be processed again
+   **/
   class Environment : public RefCounted {
     public:
       std::vector<DirectionLight> direction_lights;
       std::vector<PointLight> point_lights;
+
+      /// inserts or overwrites the light owned by id, a light that changed type moves to the other list
+      void SetLight(uint64_t id , const DirectionLight& light);
+      void SetLight(uint64_t id , const PointLight& light);
+
+      /// removal swaps the last light into the hole, that light counts as changed
+      void RemoveLight(uint64_t id);
+      void Clear();
+
+      /// bumped by every change
+      uint64_t Version() const;
+
+      /// version each point light was last written at, a light changed since version v if its entry is greater than v
+      std::span<const uint64_t> PointLightVersions() const;
+
+    private:
+      uint64_t version = 0;
+
+      std::vector<uint64_t> point_light_versions;
+      std::vector<uint64_t> point_light_owners;
+      std::vector<uint64_t> direction_light_owners;
+
+      std::unordered_map<uint64_t , uint32_t> point_light_slots;
+      std::unordered_map<uint64_t , uint32_t> direction_light_slots;
+
+      bool RemovePointLight(uint64_t id);
+      bool RemoveDirectionLight(uint64_t id);
   };
 
 } // namespace other
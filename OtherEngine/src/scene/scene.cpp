@@ -17,6 +17,7 @@
 #include "application/app_state.hpp"
 
 #include "asset/asset_manager.hpp"
+#include "core/profile.hpp"
 
 #include "ecs/components/camera.hpp"
 #include "ecs/components/collider_2d.hpp"
@@ -27,9 +28,12 @@
 #include "ecs/components/script.hpp"
 #include "ecs/components/tag.hpp"
 #include "ecs/components/transform.hpp"
+#include "ecs/ecs_reflection.hpp"
 #include "ecs/entity.hpp"
 #include "ecs/systems/core_systems.hpp"
 
+#include "physics/phyics_engine.hpp"
+
 #include "rendering/camera_base.hpp"
 #include "rendering/model.hpp"
 #include "rendering/model_factory.hpp"
@@ -37,6 +41,82 @@
 #include "scripting/script_engine.hpp"
 
 namespace other {
+namespace {
+
+  template <typename Query>
+  using WorldQuery = void (PhysicsWorld::*)(std::span<const Query>, const PhysicsQueryResults&) const;
+
+  template <typename Query>
+  using WorldQuery2D = void (PhysicsWorld2D::*)(std::span<const Query>, const PhysicsQueryResults&) const;
+
+  template <typename Query>
+  uint32_t RunPhysicsQueries(const entt::registry& registry, const PhysicsWorld* world, const PhysicsWorld2D* world_2d,
+                             std::span<const Query> queries, const PhysicsQueryResults& results,
+                             WorldQuery<Query> query_3d, WorldQuery2D<Query> query_2d) {
+    if (world != nullptr) {
+      (world->*query_3d)(queries, results);
+    } else if (world_2d != nullptr) {
+      (world_2d->*query_2d)(queries, results);
+    } else {
+      OE_WARN("Running physics queries in a scene without physics");
+      std::fill_n(results.counts, queries.size(), 0u);
+      return 0;
+    }
+
+    uint32_t total_hits = 0;
+    for (uint32_t i = 0; i < queries.size(); ++i) {
+      for (auto& hit : results.Slot(i).first(results.counts[i])) {
+        const Tag* tag = registry.try_get<Tag>(static_cast<entt::entity>(hit.user_data));
+        hit.user_data = tag != nullptr ? tag->id.Get() : 0;
+      }
+      total_hits += results.counts[i];
+    }
+    return total_hits;
+  }
+
+  /// resolves one unique handle for a draw list, models keeps the asset at the slot the list will give it
+  template <typename M>
+  Opt<DrawModel> ResolveDrawModel(AssetHandle handle, std::vector<Ref<M>>& models) {
+    if (!AppState::Assets()->IsValid(handle)) {
+      return std::nullopt;
+    }
+
+    Ref<M> model = AssetManager::GetAsset<M>(handle);
+    if (model == nullptr || model->GetModelSource() == nullptr) {
+      return std::nullopt;
+    }
+
+    const BBox& bounds = model->GetModelSource()->BoundingBox();
+    models.push_back(model);
+    return DrawModel{
+      .bounds_min = bounds.min,
+      .bounds_max = bounds.max,
+    };
+  }
+
+  /// entities are restored with the same ids so bodies are matched back up by handle
+  struct BodyVelocity {
+    entt::entity entity = entt::null;
+    glm::vec3 linear{ 0.f };
+    glm::vec3 angular{ 0.f };
+  };
+
+  struct BodyVelocity2D {
+    entt::entity entity = entt::null;
+    glm::vec2 linear{ 0.f };
+    float angular = 0.f;
+  };
+
+  template <typename... C>
+  void RegisterComponents(entt::registry& registry, Entity& entity, entt::type_list<C...>) {
+    ([&] {
+      if (C* component = registry.try_get<C>(entity.Handle()); component != nullptr) {
+        entity.RegisterComponent(*component);
+      }
+    }(), ...);
+  }
+
+} // anonymous namespace
 
   /// TODO: get rid of this in some nice ctor/dtor wrapper
   Scene::Scene()
@@ -58,8 +138,9 @@ namespace other {
     registry.on_construct<Collider>().connect<&Scene::OnAddCollider>(this);
     registry.on_update<Collider>().connect<&OnColliderUpdate>();
 
-    registry.on_update<LightSource>().connect<&Scene::RebuildEnvironment>(this);
-    registry.on_destroy<LightSource>().connect<&Scene::RebuildEnvironment>(this);
+    registry.on_construct<LightSource>().connect<&Scene::OnLightChanged>(this);
+    registry.on_update<LightSource>().connect<&Scene::OnLightChanged>(this);
+    registry.on_destroy<LightSource>().connect<&Scene::OnLightRemoved>(this);
 
     registry.on_construct<Mesh>().connect<&OnAddModel>();
     registry.on_construct<StaticMesh>().connect<&OnAddStaticModel>();
@@ -73,6 +154,17 @@ namespace other {
 
     /// TODO: move this
     environment = NewRef<Environment>();
+
+    snapshot_hooks.push_back(SnapshotHook{
+      .name = "physics",
+      .save = [this](BinaryWriter& writer) { SavePhysicsState(writer); },
+      .restore = [this](BinaryReader& reader) { return RestorePhysicsState(reader); },
+    });
+    snapshot_hooks.push_back(SnapshotHook{
+      .name = "scripts",
+      .save = [this](BinaryWriter& writer) { SaveScriptState(writer); },
+      .restore = [this](BinaryReader& reader) { return RestoreScriptState(reader); },
+    });
   }
 
   Scene::~Scene() {
@@ -86,8 +178,9 @@ namespace other {
     registry.on_construct<StaticMesh>().disconnect<&OnAddStaticModel>();
     registry.on_construct<Mesh>().disconnect<&OnAddModel>();
 
-    registry.on_destroy<LightSource>().disconnect<&Scene::RebuildEnvironment>(this);
-    registry.on_update<LightSource>().disconnect<&Scene::RebuildEnvironment>(this);
+    registry.on_destroy<LightSource>().disconnect<&Scene::OnLightRemoved>(this);
+    registry.on_update<LightSource>().disconnect<&Scene::OnLightChanged>(this);
+    registry.on_construct<LightSource>().disconnect<&Scene::OnLightChanged>(this);
 
     registry.on_update<Collider>().disconnect();
     registry.on_construct<Collider>().disconnect();
@@ -174,9 +267,10 @@ namespace other {
 
     FixRoots();
 
-    registry.view<RigidBody2D, Tag, Transform>().each([this](RigidBody2D& body, const Tag& tag, const Transform& transform) {
-      Initialize2DRigidBody(physics_world_2d, body, tag, transform);
-    });
+    CreatePhysicsBodies();
+
+    physics_sync = PhysicsSync(PhysicsEngine::StepRate(), PhysicsEngine::MaxSubSteps());
+    physics_stats = {};
 
     registry.view<Script>().each([&](Script& script) {
       script.ApiCall("NativeStart");
@@ -207,9 +301,7 @@ namespace other {
       script.ApiCall("NativeStop");
     });
 
-    registry.view<RigidBody2D>().each([&](RigidBody2D& body) {
-      physics_world_2d->DestroyBody(body.physics_body);
-    });
+    DestroyPhysicsBodies();
 
     scene_object->Stop();
 
@@ -223,6 +315,7 @@ namespace other {
   }
 
   void Scene::EarlyUpdate(float dt) {
+    OE_PROFILE_SCOPE("Scene::EarlyUpdate");
     OE_ASSERT(initialized, "Updating scene without initialization");
     if (!running) {
       return;
@@ -251,6 +344,7 @@ namespace other {
   }
 
   void Scene::Update(float dt) {
+    OE_PROFILE_SCOPE("Scene::Update");
     OE_ASSERT(initialized, "Updating scene without initialization");
     if (!running) {
       return;
@@ -276,25 +370,9 @@ namespace other {
      * use late update to react to other entity's changes
      **/
 
-    if (physics_world_2d != nullptr) {
-      physics_world_2d->Step(dt, 32, 2);
-
-      /// apply physics simulation to transforms, before using transforms for anything else
-      registry.view<RigidBody2D, Transform>().each([](RigidBody2D& body, Transform& transform) {
-        if (body.physics_body == nullptr) {
-          return;
-        }
-
-        auto& position = body.physics_body->GetPosition();
-        transform.position.x = position.x;
-        transform.position.y = position.y;
-        transform.erotation.z = body.physics_body->GetAngle();
-      });
-    }
-
-    /// TODO: add 3d physics update here
+    /// dt is in milliseconds, physics steps in seconds
+    physics_stats = physics_sync.Update(registry, physics_world.Raw(), physics_world_2d.Raw(), dt / 1000.f);
 
-    /// TODO: rigid body 3d here
 
     /// update environment
     registry.view<LightSource, Transform>().each([](LightSource& light, Transform& transform) {
@@ -331,6 +409,7 @@ namespace other {
   }
 
   void Scene::LateUpdate(float dt) {
+    OE_PROFILE_SCOPE("Scene::LateUpdate");
     OE_ASSERT(initialized, "Updating scene without initialization");
     if (!running) {
       return;
@@ -360,6 +439,11 @@ namespace other {
 
     OnLateUpdate(dt);
 
+    /// scripts are done allocating for the frame, let the collector spend its budget
+    if (Ref<LuaModule> lua_module = ScriptEngine::GetModuleAs<LuaModule>(LUA_MODULE); lua_module != nullptr) {
+      lua_module->StepGarbageCollector();
+    }
+
     /// finish scene update
     /// checks the case the scene become corrupt on client update
     if (corrupt) {
@@ -386,7 +470,8 @@ namespace other {
     return GetEntity(handle)->GetComponent<Camera>().camera;
   }
 
-  void Scene::Render(Ref<SceneRenderer>& renderer) {
+  void Scene::Render(RefView<SceneRenderer> renderer) {
+    OE_PROFILE_SCOPE("Scene::Render");
     renderer->ClearPipelines();
     if (auto primary_cam = GetPrimaryCamera(); primary_cam != nullptr) {
       renderer->SubmitCamera(primary_cam);
@@ -431,6 +516,29 @@ namespace other {
     return physics_world;
   }
 
+  const PhysicsSyncStats& Scene::GetPhysicsStats() const {
+    return physics_stats;
+  }
+
+  const DrawListStats& Scene::GetDrawStats() const {
+    return static_draws.Stats();
+  }
+
+  uint32_t Scene::CastRays(std::span<const RaycastQuery> queries, const PhysicsQueryResults& results) const {
+    return RunPhysicsQueries(registry, physics_world.Raw(), physics_world_2d.Raw(), queries, results,
+                             &PhysicsWorld::CastRays, &PhysicsWorld2D::CastRays);
+  }
+
+  uint32_t Scene::CastShapes(std::span<const ShapeCastQuery> queries, const PhysicsQueryResults& results) const {
+    return RunPhysicsQueries(registry, physics_world.Raw(), physics_world_2d.Raw(), queries, results,
+                             &PhysicsWorld::CastShapes, &PhysicsWorld2D::CastShapes);
+  }
+
+  uint32_t Scene::Overlap(std::span<const OverlapQuery> queries, const PhysicsQueryResults& results) const {
+    return RunPhysicsQueries(registry, physics_world.Raw(), physics_world_2d.Raw(), queries, results,
+                             &PhysicsWorld::Overlap, &PhysicsWorld2D::Overlap);
+  }
+
   Ref<Environment> Scene::GetEnvironment() const {
     return environment;
   }
@@ -477,9 +585,16 @@ namespace other {
     return entities.find(id) != entities.end();
   }
 
-  Entity* Scene::GetEntity(const std::string& name) {
-    auto ent = std::find_if(entities.begin(), entities.end(), [&name](const auto& ent_pair) -> bool {
-      return name == ent_pair.second->Name();
+  Entity* Scene::GetEntity(StringId name) {
+    const std::string_view name_str = name.Str();
+
+    /// CreateEntity ids an entity by the hash of its name
+    if (auto ent = entities.find(name.Hash()); ent != entities.end() && ent->second->ReadComponent<Tag>().name == name_str) {
+      return ent->second;
+    }
+
+    auto ent = std::find_if(entities.begin(), entities.end(), [name_str](const auto& ent_pair) -> bool {
+      return name_str == ent_pair.second->template ReadComponent<Tag>().name;
     });
 
     if (ent == entities.end()) {
@@ -662,40 +777,171 @@ namespace other {
   }
 
   void Scene::RebuildEnvironment() {
-    /// rebuild environment on light source change
-    environment->point_lights.clear();
-    environment->direction_lights.clear();
-    registry.view<LightSource, Transform>().each([this](LightSource& light, Transform& transform) {
-      switch (light.type) {
-        case POINT_LIGHT_SRC:
-          environment->point_lights.push_back(light.pointlight);
-          break;
-        case DIRECTION_LIGHT_SRC:
-          environment->direction_lights.push_back(light.direction_light);
-          break;
-        default:
-          break;
-      }
+    environment->Clear();
+    registry.view<LightSource>().each([this](entt::entity handle, const LightSource& light) {
+      SetEnvironmentLight(handle, light);
     });
   }
 
-  void Scene::RenderToPipeline(const std::string_view plname, Ref<SceneRenderer>& renderer, bool do_debug) {
-    dynamic_mesh_group.each([&renderer, plname](const Mesh& mesh, const Transform& transform) {
-      if (!AppState::Assets()->IsValid(mesh.handle)) {
-        return;
+  void Scene::CaptureSnapshot(SceneSnapshot& snapshot) {
+    OE_PROFILE_SCOPE("Scene::CaptureSnapshot");
+
+    BinaryWriter& writer = snapshot.Begin(scene_handle);
+    SaveRegistry(registry, writer);
+    SaveSections(snapshot_hooks, writer);
+  }
+
+  bool Scene::RestoreSnapshot(const SceneSnapshot& snapshot) {
+    OE_PROFILE_SCOPE("Scene::RestoreSnapshot");
+    if (snapshot.Empty()) {
+      OE_WARN("Restoring an empty scene snapshot");
+      return false;
+    }
+
+    if (snapshot.SceneId() != scene_handle) {
+      OE_ERROR("Scene snapshot of [{}] can not be restored into scene [{}]", snapshot.SceneId(), scene_handle);
+      return false;
+    }
+
+    /// the instances go away with their components , finish them the way Stop and Shutdown would
+    registry.view<Script>().each([this](Script& script) {
+      if (running) {
+        script.ApiCall("OnStop");
+        script.ApiCall("NativeStop");
+      }
+      if (initialized) {
+        script.ApiCall("OnShutdown");
+        script.ApiCall("NativeShutdown");
       }
+      script.Clear();
+    });
+
+    DestroyPhysicsBodies();
+
+    BinaryReader reader(snapshot.Bytes());
+
+    restoring_snapshot = true;
+    const bool loaded = LoadRegistry(registry, reader);
+    restoring_snapshot = false;
 
-      auto model = AssetManager::GetAsset<Model>(mesh.handle);
-      renderer->SubmitModel(plname, model, transform.model_transform, mesh.material);
+    RebuildEntityMap();
+
+    if (!loaded) {
+      OE_ERROR("Scene snapshot is corrupt , scene was only partially restored");
+      corrupt = true;
+      return false;
+    }
+
+    /// pools copied as raw bytes carry the handles of bodies that were destroyed above
+    registry.view<RigidBody2D>().each([](RigidBody2D& body) {
+      body.physics_body = nullptr;
+    });
+    registry.view<Collider2D>().each([](Collider2D& collider) {
+      collider.fixture = nullptr;
+    });
+    registry.view<RigidBody>().each([](RigidBody& body) {
+      body.body_id = JPH::BodyID{};
     });
 
-    static_mesh_group.each([&renderer, plname](const StaticMesh& mesh, const Transform& transform) {
-      if (!AppState::Assets()->IsValid(mesh.handle)) {
-        return;
+    CreatePhysicsBodies();
+
+    if (physics_world_2d != nullptr) {
+      registry.view<RigidBody2D, Collider2D, Transform>().each([this](RigidBody2D& body, Collider2D& collider, const Transform& transform) {
+        if (body.physics_body != nullptr) {
+          Initialize2DCollider(physics_world_2d, body, collider, transform);
+        }
+      });
+    }
+
+    registry.view<Script>().each([this](Script& script) {
+      script.LoadScripts();
+      if (initialized) {
+        script.ApiCall("NativeInitialize");
+        script.ApiCall("OnInitialize");
+      }
+      if (running) {
+        script.ApiCall("NativeStart");
+        script.ApiCall("OnStart");
+      }
+    });
+
+    /// sections go last so captured field values and velocities win over whatever start set
+    const bool restored = RestoreSections(snapshot_hooks, reader);
+
+    RefreshCameraTransforms();
+    RebuildEnvironment();
+    GeometryChanged();
+
+    return restored;
+  }
+
+  void Scene::AddSnapshotHook(SnapshotHook hook) {
+    snapshot_hooks.push_back(std::move(hook));
+  }
+
+  void Scene::OnLightChanged(entt::registry& context, entt::entity handle) {
+    SetEnvironmentLight(handle, context.get<LightSource>(handle));
+  }
+
+  void Scene::OnLightRemoved(entt::registry& context, entt::entity handle) {
+    environment->RemoveLight(static_cast<uint64_t>(handle));
+  }
+
+  void Scene::SetEnvironmentLight(entt::entity handle, const LightSource& light) {
+    /// only the light that changed is touched so the renderer re-bins just that one
+    const uint64_t id = static_cast<uint64_t>(handle);
+    switch (light.type) {
+      case POINT_LIGHT_SRC:
+        environment->SetLight(id, light.pointlight);
+        break;
+      case DIRECTION_LIGHT_SRC:
+        environment->SetLight(id, light.direction_light);
+        break;
+      default:
+        environment->RemoveLight(id);
+        break;
+    }
+  }
+
+  void Scene::RenderToPipeline(StringId plname, RefView<SceneRenderer> renderer, bool do_debug) {
+    OE_PROFILE_SCOPE("Scene::RenderToPipeline");
+    OE_PROFILE_TAG(plname.Str());
+
+    Opt<DrawView> view = std::nullopt;
+    if (Ref<CameraBase> camera = renderer->Viewpoint(); camera != nullptr) {
+      view = DrawView{
+        .view = camera->ViewMatrix(),
+        .projection = camera->ProjectionMatrix(),
+      };
+    }
+
+    dynamic_draw_models.clear();
+    dynamic_draws.Build<Mesh>(dynamic_mesh_group, [this](AssetHandle handle) {
+      return ResolveDrawModel(handle, dynamic_draw_models);
+    }, view);
+
+    dynamic_draws.ForEachRun([&](uint32_t model, std::span<const DrawItem> run) {
+      for (const auto& item : run) {
+        const auto& [mesh, transform] = dynamic_mesh_group.get<Mesh, Transform>(dynamic_mesh_group[item.instance]);
+        renderer->SubmitModel(plname, dynamic_draw_models[model], transform.model_transform, mesh.material);
       }
+    });
 
-      auto model = AssetManager::GetAsset<StaticModel>(mesh.handle);
-      renderer->SubmitStaticModel(plname, model, transform.model_transform, mesh.material);
+    static_draw_models.clear();
+    static_draws.Build<StaticMesh>(static_mesh_group, [this](AssetHandle handle) {
+      return ResolveDrawModel(handle, static_draw_models);
+    }, view);
+
+    /// sorted runs share a model so each one is a single lookup in the pipeline
+    static_draws.ForEachRun([&](uint32_t model, std::span<const DrawItem> run) {
+      draw_transforms.clear();
+      draw_materials.clear();
+      for (const auto& item : run) {
+        const auto& [mesh, transform] = static_mesh_group.get<StaticMesh, Transform>(static_mesh_group[item.instance]);
+        draw_transforms.push_back(transform.model_transform);
+        draw_materials.push_back(mesh.material);
+      }
+      renderer->SubmitStaticModels(plname, static_draw_models[model], draw_transforms, draw_materials);
     });
 
     if (AppState::mode == EngineMode::RUNTIME) {
@@ -723,6 +969,11 @@ namespace other {
   }
 
   void Scene::OnAddRigidBody2D(entt::registry& context, entt::entity entt) {
+    /// RestoreSnapshot rebuilds every body once the whole registry is loaded
+    if (restoring_snapshot) {
+      return;
+    }
+
     OE_ASSERT(physics_world_2d != nullptr, "Somehow created a rigid body 2D component without active 2D physics");
 
     Entity ent(context, entt);
@@ -735,6 +986,10 @@ namespace other {
   }
 
   void Scene::OnAddCollider2D(entt::registry& context, entt::entity entt) {
+    if (restoring_snapshot) {
+      return;
+    }
+
     OE_ASSERT(physics_world_2d != nullptr, "Somehow created a collider 2D component without active 2D physics");
 
     Entity ent(context, entt);
@@ -750,6 +1005,10 @@ namespace other {
   }
 
   void Scene::OnAddRigidBody(entt::registry& context, entt::entity entt) {
+    if (restoring_snapshot) {
+      return;
+    }
+
     OE_ASSERT(physics_world != nullptr, "Somehow created a rigid body component without active 3D physics!");
 
     Entity ent(context, entt);
@@ -757,11 +1016,16 @@ namespace other {
 
     auto& tag = ent.GetComponent<Tag>();
     auto& transform = ent.GetComponent<Transform>();
+    const Collider* collider = ent.HasComponent<Collider>() ? &ent.GetComponent<Collider>() : nullptr;
 
-    InitializeRigidBody(physics_world, body, tag, transform);
+    InitializeRigidBody(physics_world, body, tag, transform, collider);
   }
 
   void Scene::OnAddCollider(entt::registry& context, entt::entity entt) {
+    if (restoring_snapshot) {
+      return;
+    }
+
     OE_ASSERT(physics_world != nullptr, "Somehow created a collider component without active 3D physics!");
 
     Entity ent(context, entt);
@@ -771,9 +1035,10 @@ namespace other {
 
     auto& body = ent.AddComponent<RigidBody>();
     auto& collider = ent.AddComponent<Collider>();
+    auto& tag = ent.GetComponent<Tag>();
     auto& transform = ent.GetComponent<Transform>();
 
-    InitializeCollider(physics_world, body, collider, transform);
+    InitializeCollider(physics_world, body, collider, tag, transform);
   }
 
   void Scene::RefreshCameraTransforms() {
@@ -782,6 +1047,182 @@ namespace other {
     });
   }
 
+  void Scene::CreatePhysicsBodies() {
+    if (physics_world_2d != nullptr) {
+      registry.view<RigidBody2D, Tag, Transform>().each([this](RigidBody2D& body, const Tag& tag, const Transform& transform) {
+        Initialize2DRigidBody(physics_world_2d, body, tag, transform);
+      });
+    }
+
+    if (physics_world != nullptr) {
+      registry.view<RigidBody, Tag, Transform>().each([this](entt::entity entity, RigidBody& body, const Tag& tag, const Transform& transform) {
+        InitializeRigidBody(physics_world, body, tag, transform, registry.try_get<Collider>(entity));
+      });
+
+      /// bodies are all added at once here so the broad phase only needs rebuilding once
+      physics_world->OptimizeBroadPhase();
+    }
+  }
+
+  void Scene::DestroyPhysicsBodies() {
+    if (physics_world_2d != nullptr) {
+      registry.view<RigidBody2D>().each([&](RigidBody2D& body) {
+        if (body.physics_body != nullptr) {
+          physics_world_2d->DestroyBody(body.physics_body);
+          body.physics_body = nullptr;
+        }
+      });
+    }
+
+    if (physics_world != nullptr) {
+      registry.view<RigidBody>().each([&](RigidBody& body) {
+        physics_world->DestroyBody(body.body_id);
+        body.body_id = JPH::BodyID{};
+      });
+    }
+  }
+
+  void Scene::SavePhysicsState(BinaryWriter& writer) {
+    const auto bodies = registry.view<const RigidBody>();
+    writer.Write(static_cast<uint32_t>(physics_world == nullptr ? 0 : bodies.size()));
+    if (physics_world != nullptr) {
+      const auto& body_interface = physics_world->GetPhysicsBodies();
+      for (auto [entity, body] : bodies.each()) {
+        BodyVelocity velocity{ .entity = entity };
+        if (!body.body_id.IsInvalid()) {
+          const JPH::Vec3 linear = body_interface.GetLinearVelocity(body.body_id);
+          const JPH::Vec3 angular = body_interface.GetAngularVelocity(body.body_id);
+          velocity.linear = { linear.GetX(), linear.GetY(), linear.GetZ() };
+          velocity.angular = { angular.GetX(), angular.GetY(), angular.GetZ() };
+        }
+        writer.Write(velocity);
+      }
+    }
+
+    const auto bodies_2d = registry.view<const RigidBody2D>();
+    writer.Write(static_cast<uint32_t>(bodies_2d.size()));
+    for (auto [entity, body] : bodies_2d.each()) {
+      BodyVelocity2D velocity{ .entity = entity };
+      if (body.physics_body != nullptr) {
+        const b2Vec2 linear = body.physics_body->GetLinearVelocity();
+        velocity.linear = { linear.x, linear.y };
+        velocity.angular = body.physics_body->GetAngularVelocity();
+      }
+      writer.Write(velocity);
+    }
+  }
+
+  bool Scene::RestorePhysicsState(BinaryReader& reader) {
+    uint32_t count = 0;
+    if (!reader.Read(count)) {
+      return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+      BodyVelocity velocity;
+      if (!reader.Read(velocity)) {
+        return false;
+      }
+
+      const RigidBody* body = registry.try_get<RigidBody>(velocity.entity);
+      if (physics_world == nullptr || body == nullptr || body->body_id.IsInvalid()) {
+        continue;
+      }
+
+      physics_world->GetPhysicsBodies().SetLinearAndAngularVelocity(
+        body->body_id, JPH::Vec3(velocity.linear.x, velocity.linear.y, velocity.linear.z),
+        JPH::Vec3(velocity.angular.x, velocity.angular.y, velocity.angular.z));
+    }
+
+    if (!reader.Read(count)) {
+      return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+      BodyVelocity2D velocity;
+      if (!reader.Read(velocity)) {
+        return false;
+      }
+
+      const RigidBody2D* body = registry.try_get<RigidBody2D>(velocity.entity);
+      if (body == nullptr || body->physics_body == nullptr) {
+        continue;
+      }
+
+      body->physics_body->SetLinearVelocity(b2Vec2(velocity.linear.x, velocity.linear.y));
+      body->physics_body->SetAngularVelocity(velocity.angular);
+    }
+
+    return true;
+  }
+
+  void Scene::SaveScriptState(BinaryWriter& writer) {
+    const auto scripts = registry.view<const Script>();
+    writer.Write(static_cast<uint32_t>(scripts.size()));
+    for (auto [entity, script] : scripts.each()) {
+      writer.Write(entity);
+
+      const size_t mark = writer.BeginLength();
+      script.SaveFieldState(writer);
+      writer.EndLength(mark);
+    }
+  }
+
+  bool Scene::RestoreScriptState(BinaryReader& reader) {
+    uint32_t count = 0;
+    if (!reader.Read(count)) {
+      return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+      entt::entity entity = entt::null;
+      uint32_t length = 0;
+      if (!reader.Read(entity) || !reader.Read(length)) {
+        return false;
+      }
+
+      BinaryReader fields = reader.Take(length);
+      if (reader.Failed()) {
+        return false;
+      }
+
+      if (Script* script = registry.try_get<Script>(entity); script != nullptr && !script->RestoreFieldState(fields)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  void Scene::RebuildEntityMap() {
+    std::map<UUID, Entity*> restored;
+    registry.view<Tag>().each([this, &restored](entt::entity handle, const Tag& tag) {
+      Entity* entity = nullptr;
+      if (auto itr = entities.find(tag.id); itr != entities.end() && itr->second->handle == handle) {
+        entity = itr->second;
+        entities.erase(itr);
+      } else {
+        entity = new Entity(this, handle, tag.id, tag.name);
+      }
+
+      entity->name = tag.name;
+      restored[tag.id] = entity;
+    });
+
+    for (auto& [id, entity] : entities) {
+      delete entity;
+    }
+
+    entities = std::move(restored);
+    root_entities.clear();
+
+    for (auto& [id, entity] : entities) {
+      RegisterComponents(registry, *entity, entt::type_list_cat_t<ReflectedComponents, entt::type_list<SerializationData>>{});
+    }
+
+    FixRoots();
+  }
+
   void Scene::FixRoots() {
     /// add any entities that should be root entities to roots
     for (auto itr = entities.begin(); itr != entities.end();) {
@@ -5,6 +5,7 @@
 #define OTHER_ENGINE_SCENE_HPP
 
 #include <map>
+#include <span>
 
 #include <entt/entt.hpp>
 
@@ -15,6 +16,7 @@
 #include <reflection/reflected_object.hpp>
 
 #include "core/ref.hpp"
+#include "core/string_id.hpp"
 #include "core/uuid.hpp"
 
 #include "asset/asset.hpp"
@@ -26,9 +28,13 @@
 #include "ecs/components/script.hpp"
 #include "ecs/components/transform.hpp"
 #include "scene/environment.hpp"
+#include "scene/scene_snapshot.hpp"
 
 #include "physics/2D/physics_world_2d.hpp"
 #include "physics/3D/physics_world.hpp"
+#include "physics/physics_queries.hpp"
+#include "physics/physics_sync.hpp"
+#include "rendering/draw_list.hpp"
 #include "rendering/scene_renderer.hpp"
 #include "scripting/cs/cs_object.hpp"
 #include "scripting/script_object.hpp"
@@ -66,7 +72,7 @@ namespace other {
 
     Ref<CameraBase> GetPrimaryCamera() const;
 
-    void Render(Ref<SceneRenderer>& scene_renderer);
+    void Render(RefView<SceneRenderer> scene_renderer);
 
     void RenderUI();
 
@@ -82,6 +88,21 @@ namespace other {
     Ref<PhysicsWorld2D> Get2DPhysicsWorld() const;
     Ref<PhysicsWorld> GetPhysicsWorld() const;
 
+    /// steps, timings and synced body count of the last Update
+    const PhysicsSyncStats& GetPhysicsStats() const;
+
+    /// collection , culling and sort timings of the last static mesh draw list
+    const DrawListStats& GetDrawStats() const;
+
+    /**
+     * batched queries against whichever physics world the scene has, 3D first
+     *
+     * hits come back with the entity uuid in user_data instead of the entity handle, returns the total number of hits
+     **/
+    uint32_t CastRays(std::span<const RaycastQuery> queries, const PhysicsQueryResults& results) const;
+    uint32_t CastShapes(std::span<const ShapeCastQuery> queries, const PhysicsQueryResults& results) const;
+    uint32_t Overlap(std::span<const OverlapQuery> queries, const PhysicsQueryResults& results) const;
+
     Ref<Environment> GetEnvironment() const;
 
     const bool IsInitialized() const;
@@ -99,7 +120,8 @@ namespace other {
     bool HasEntity(const std::string& name) const;
     bool HasEntity(UUID id) const;
 
-    Entity* GetEntity(const std::string& name);
+    /// entities named after their id are found without a scan , renamed ones fall back to comparing every tag
+    Entity* GetEntity(StringId name);
     Entity* GetEntity(UUID id) const;
 
     Entity* CreateEntity(const std::string& name = "");
@@ -115,6 +137,20 @@ namespace other {
     void GeometryChanged();
     void RebuildEnvironment();
 
+    /// the registry , physics bodies , script fields and every snapshot hook , reuses snapshot's arena
+    void CaptureSnapshot(SceneSnapshot& snapshot);
+
+    /**
+     * puts the scene back the way CaptureSnapshot found it , a running scene keeps running
+     *
+     * script instances are recreated and get their captured field values back , bodies are recreated from their
+     *   components and get their captured velocities back
+     **/
+    bool RestoreSnapshot(const SceneSnapshot& snapshot);
+
+    /// client state to capture with the scene , restored after the scene's own physics and script state
+    void AddSnapshotHook(SnapshotHook hook);
+
    protected:
     other::AssetHandle model_handle;
     Ref<StaticModel> model = nullptr;
@@ -122,7 +158,7 @@ namespace other {
 
     Ref<Environment> environment = nullptr;
 
-    void RenderToPipeline(const std::string_view plname, Ref<SceneRenderer>& scene_renderer, bool do_debug = false);
+    void RenderToPipeline(StringId plname, RefView<SceneRenderer> scene_renderer, bool do_debug = false);
 
     void OnAddRigidBody2D(entt::registry& context, entt::entity ent);
     void OnAddCollider2D(entt::registry& context, entt::entity ent);
@@ -130,8 +166,24 @@ namespace other {
     void OnAddRigidBody(entt::registry& context, entt::entity ent);
     void OnAddCollider(entt::registry& context, entt::entity ent);
 
+    void OnLightChanged(entt::registry& context, entt::entity ent);
+    void OnLightRemoved(entt::registry& context, entt::entity ent);
+    void SetEnvironmentLight(entt::entity ent, const LightSource& light);
+
     void RefreshCameraTransforms();
 
+    void CreatePhysicsBodies();
+    void DestroyPhysicsBodies();
+
+    void SavePhysicsState(BinaryWriter& writer);
+    bool RestorePhysicsState(BinaryReader& reader);
+
+    void SaveScriptState(BinaryWriter& writer);
+    bool RestoreScriptState(BinaryReader& reader);
+
+    /// matches entities and root_entities to whatever is in the registry after a restore
+    void RebuildEntityMap();
+
     virtual void OnInit() {}
     virtual void OnStart() {}
 
@@ -153,6 +205,9 @@ namespace other {
     bool running = false;
     bool corrupt = false;
 
+    /// physics hooks are skipped while a snapshot is loaded , bodies are rebuilt once it is done
+    bool restoring_snapshot = false;
+
     /// true until first render
     bool scene_geometry_changed = true;
 
@@ -170,12 +225,27 @@ namespace other {
     RenderGroup<Mesh> dynamic_mesh_group;
     RenderGroup<StaticMesh> static_mesh_group;
 
+    /// rebuilt every RenderToPipeline, each models vector lines up with its list's model slots
+    DrawList dynamic_draws;
+    DrawList static_draws;
+    std::vector<Ref<Model>> dynamic_draw_models;
+    std::vector<Ref<StaticModel>> static_draw_models;
+
+    /// one sorted run's instances gathered for the pipeline
+    std::vector<glm::mat4> draw_transforms;
+    std::vector<Material> draw_materials;
+
     Ref<PhysicsWorld2D> physics_world_2d;
     Ref<PhysicsWorld> physics_world;
 
+    PhysicsSync physics_sync;
+    PhysicsSyncStats physics_stats;
+
     std::map<UUID, Entity*> root_entities{};
     std::map<UUID, Entity*> entities{};
 
+    std::vector<SnapshotHook> snapshot_hooks;
+
     template <ComponentType T1, ComponentType T2 = NullComponent, ComponentType T3 = NullComponent>
     auto GetGroup() -> SystemGroup<T1, T2, T3> {
       return registry.group<T1>(entt::get<T2>, entt::exclude<T3>);
@@ -199,17 +199,8 @@ namespace other {
       return;
     }
 
-    bool scene_playing = false;
-    if (active_scene->scene->IsRunning()) {
-      active_scene->scene->Stop();
-      scene_playing = true;
-    }
-
+    /// a running scene is restored in place and keeps running
     StateStack::RestoreState(ActiveScene()->scene , capture);
-
-    if (scene_playing) {
-      active_scene->scene->Start(AppState::mode);
-    }
   }
     
   void SceneManager::ClearScenes() {
@@ -256,7 +247,7 @@ namespace other {
     active_scene->scene->LateUpdate(dt);
   }
 
-  bool SceneManager::RenderScene(Ref<SceneRenderer>& scene_renderer , Ref<CameraBase> viewpoint) {
+  bool SceneManager::RenderScene(RefView<SceneRenderer> scene_renderer , Ref<CameraBase> viewpoint) {
     if (!HasActiveScene()) {
       return true;
     }
@@ -0,0 +1,232 @@
+/**
+ * \file scene/scene_snapshot.cpp
+ **/
+#include "scene/scene_snapshot.hpp"
+
+#include <entt/entity/snapshot.hpp>
+
+#include "core/defines.hpp"
+#include "core/logger.hpp"
+
+#include "ecs/components/serialization_data.hpp"
+#include "ecs/ecs_reflection.hpp"
+
+namespace other {
+namespace {
+
+  /// SerializationData is not a user facing component but every scene entity has one
+  using SnapshotComponents = entt::type_list_cat_t<ReflectedComponents , entt::type_list<SerializationData>>;
+
+  using EntityValue = std::underlying_type_t<entt::entity>;
+
+  /// output archive for entt::snapshot , only the entity storage goes through it
+  class EntityArchive {
+    public:
+      EntityArchive(BinaryWriter& writer)
+        : writer(writer) {}
+
+      void operator()(EntityValue value) {
+        writer.Write(value);
+      }
+
+      void operator()(entt::entity entity) {
+        writer.Write(entity);
+      }
+
+    private:
+      BinaryWriter& writer;
+  };
+
+  template <typename C>
+  bool LoadPool(entt::registry& registry , BinaryReader& reader) {
+    /// construction hooks may have already given the new entities a default C
+    registry.clear<C>();
+    return DeserializePool<C>(reader , registry);
+  }
+
+  template <typename... C>
+  void SavePools(const entt::registry& registry , BinaryWriter& writer , entt::type_list<C...>) {
+    (SerializePool<C>(writer , registry) , ...);
+  }
+
+  template <typename... C>
+  bool LoadPools(entt::registry& registry , BinaryReader& reader , entt::type_list<C...>) {
+    return (LoadPool<C>(registry , reader) && ...);
+  }
+
+} // anonymous namespace
+
+  void SaveRegistry(const entt::registry& registry , BinaryWriter& writer) {
+    EntityArchive archive(writer);
+    entt::snapshot{ registry }.get<entt::entity>(archive);
+
+    SavePools(registry , writer , SnapshotComponents{});
+  }
+
+  bool LoadRegistry(entt::registry& registry , BinaryReader& reader) {
+    /// size , free list length , then every entity in the storage , the first free list length are alive
+    EntityValue size = 0;
+    EntityValue alive = 0;
+    if (!reader.Read(size) || !reader.Read(alive)) {
+      return false;
+    }
+
+    const uint8_t* packed = reader.Consume(static_cast<size_t>(size) * sizeof(entt::entity));
+    if (packed == nullptr || alive > size) {
+      reader.Fail();
+      return false;
+    }
+
+    registry.clear();
+
+    for (EntityValue i = 0; i < alive; ++i) {
+      entt::entity entity = entt::null;
+      std::memcpy(&entity , packed + i * sizeof(entt::entity) , sizeof(entt::entity));
+
+      if (registry.create(entity) != entity) {
+        OE_ERROR("Snapshot entity {} could not be recreated with the same id" , static_cast<EntityValue>(entity));
+        reader.Fail();
+        return false;
+      }
+    }
+
+    return LoadPools(registry , reader , SnapshotComponents{});
+  }
+
+  void SaveSections(std::span<const SnapshotHook> hooks , BinaryWriter& writer) {
+    writer.Write(static_cast<uint32_t>(hooks.size()));
+    for (const auto& hook : hooks) {
+      writer.Write(FNV(hook.name));
+
+      const size_t mark = writer.BeginLength();
+      if (hook.save != nullptr) {
+        hook.save(writer);
+      }
+      writer.EndLength(mark);
+    }
+  }
+
+  bool RestoreSections(std::span<const SnapshotHook> hooks , BinaryReader& reader) {
+    uint32_t count = 0;
+    if (!reader.Read(count)) {
+      return false;
+    }
+
+    bool restored = true;
+    for (uint32_t i = 0; i < count; ++i) {
+      uint64_t id = 0;
+      uint32_t length = 0;
+      if (!reader.Read(id) || !reader.Read(length)) {
+        return false;
+      }
+
+      BinaryReader section = reader.Take(length);
+      if (reader.Failed()) {
+        return false;
+      }
+
+      auto hook = std::find_if(hooks.begin() , hooks.end() , [id](const SnapshotHook& hook) {
+        return FNV(hook.name) == id;
+      });
+
+      /// whoever wrote this section is gone , nothing to hand it to
+      if (hook == hooks.end() || hook->restore == nullptr) {
+        continue;
+      }
+
+      if (!hook->restore(section)) {
+        OE_WARN("Failed to restore snapshot section {}" , hook->name);
+        restored = false;
+      }
+    }
+
+    return restored;
+  }
+
+  SceneSnapshot::SceneSnapshot(size_t capacity)
+      : arena(capacity) {
+  }
+
+  void SceneSnapshot::Clear() {
+    scene_id = 0;
+    arena.Clear();
+  }
+
+  BinaryWriter& SceneSnapshot::Begin(UUID scene) {
+    Clear();
+    scene_id = scene;
+    return arena;
+  }
+
+  bool SceneSnapshot::Empty() const {
+    return arena.Size() == 0;
+  }
+
+  size_t SceneSnapshot::Size() const {
+    return arena.Size();
+  }
+
+  UUID SceneSnapshot::SceneId() const {
+    return scene_id;
+  }
+
+  std::span<const uint8_t> SceneSnapshot::Bytes() const {
+    return arena.Bytes();
+  }
+
+  SnapshotHistory::SnapshotHistory(size_t count , size_t capacity) {
+    OE_ASSERT(count > 0 , "Snapshot history must hold at least one snapshot");
+
+    snapshots.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      snapshots.emplace_back(capacity);
+    }
+  }
+
+  SceneSnapshot& SnapshotHistory::Push() {
+    SceneSnapshot& snapshot = snapshots[head];
+    head = (head + 1) % snapshots.size();
+    size = (std::min)(size + 1 , snapshots.size());
+    return snapshot;
+  }
+
+  const SceneSnapshot* SnapshotHistory::At(size_t index) const {
+    if (index >= size) {
+      return nullptr;
+    }
+
+    const size_t oldest = (head + snapshots.size() - size) % snapshots.size();
+    return &snapshots[(oldest + index) % snapshots.size()];
+  }
+
+  const SceneSnapshot* SnapshotHistory::Newest(size_t steps_back) const {
+    if (steps_back >= size) {
+      return nullptr;
+    }
+    return At(size - 1 - steps_back);
+  }
+
+  const SceneSnapshot* SnapshotHistory::Rewind(size_t steps) {
+    if (steps >= size) {
+      return nullptr;
+    }
+
+    head = (head + snapshots.size() - steps) % snapshots.size();
+    size -= steps;
+    return Newest();
+  }
+
+  void SnapshotHistory::Clear() {
+    head = 0;
+    size = 0;
+  }
+
+  size_t SnapshotHistory::Size() const {
+    return size;
+  }
+
+  size_t SnapshotHistory::Capacity() const {
+    return snapshots.size();
+  }
+
+} // namespace other
@@ -0,0 +1,108 @@
+/**
+ * \file scene/scene_snapshot.hpp
+ **/
+#ifndef OTHER_ENGINE_SCENE_SNAPSHOT_HPP
+#define OTHER_ENGINE_SCENE_SNAPSHOT_HPP
+
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "core/binary_serializer.hpp"
+#include "core/uuid.hpp"
+
+namespace other {
+
+  /**
+   * scene state that does not live in the registry , script fields , physics bodies or anything a client keeps
+   *
+   * every hook gets its own length prefixed section keyed by the hash of its name , restore is handed exactly the
+   *   bytes save wrote and sections without a hook are skipped
+   **/
+  struct SnapshotHook {
+    std::string name;
+    std::function<void(BinaryWriter&)> save;
+    std::function<bool(BinaryReader&)> restore;
+  };
+
+  /// writes the entity storage through entt::snapshot , then every ReflectedComponents pool and SerializationData
+  ///   with SerializePool
+  void SaveRegistry(const entt::registry& registry , BinaryWriter& writer);
+
+  /**
+   * replaces everything in registry with what SaveRegistry wrote , entities come back with the same ids
+   *
+   * entt::snapshot_loader only loads into a registry that has never had a pool , this loads into a live one so
+   *   signals and groups stay connected. construction hooks run and see default components , which are then
+   *   overwritten with the saved ones
+   **/
+  bool LoadRegistry(entt::registry& registry , BinaryReader& reader);
+
+  void SaveSections(std::span<const SnapshotHook> hooks , BinaryWriter& writer);
+  bool RestoreSections(std::span<const SnapshotHook> hooks , BinaryReader& reader);
+
+  /**
+   * one captured scene , the arena is kept between captures so capturing the same scene again does not allocate
+   **/
+  class SceneSnapshot {
+    public:
+      static constexpr size_t kDefaultCapacity = 1024 * 1024;
+
+      SceneSnapshot(size_t capacity = kDefaultCapacity);
+
+      void Clear();
+
+      /// clears the arena and tags it with the scene about to be written into it
+      BinaryWriter& Begin(UUID scene);
+
+      bool Empty() const;
+      size_t Size() const;
+
+      UUID SceneId() const;
+      std::span<const uint8_t> Bytes() const;
+
+    private:
+      UUID scene_id = 0;
+      BinaryWriter arena;
+  };
+
+  /**
+   * the last N snapshots of a scene for rewinding and replaying , capture into Push every step and restore from At
+   *
+   * the snapshots are reused in place once the ring is full so steady state capture does not allocate
+   **/
+  class SnapshotHistory {
+    public:
+      SnapshotHistory(size_t count , size_t capacity = SceneSnapshot::kDefaultCapacity);
+
+      /// the snapshot to capture into next , overwrites the oldest when full
+      SceneSnapshot& Push();
+
+      /// 0 is the oldest snapshot still held , nullptr when out of range
+      const SceneSnapshot* At(size_t index) const;
+
+      /// 0 is the newest snapshot , nullptr when out of range
+      const SceneSnapshot* Newest(size_t steps_back = 0) const;
+
+      /// drops the newest steps snapshots so the next Push continues from the one returned
+      const SceneSnapshot* Rewind(size_t steps);
+
+      void Clear();
+
+      size_t Size() const;
+      size_t Capacity() const;
+
+    private:
+      std::vector<SceneSnapshot> snapshots;
+
+      /// index the next Push writes to
+      size_t head = 0;
+      size_t size = 0;
+  };
+
+} // namespace other
+
+#endif // !OTHER_ENGINE_SCENE_SNAPSHOT_HPP
@@ -9,6 +9,7 @@
 #include "scripting/cs/cs_entity_bindings.hpp"
 #include "scripting/cs/cs_component_bindings.hpp"
 #include "scripting/cs/cs_logging_bindings.hpp"
+#include "scripting/cs/cs_physics_bindings.hpp"
 #include "scripting/cs/cs_scene_bindings.hpp"
 
 namespace other {
@@ -18,6 +19,7 @@ namespace cs_script_bindings {
     RegisterNativeComponents(assembly);
     RegisterEntityBindings(assembly);
     RegisterSceneFunctions(assembly);
+    RegisterPhysicsFunctions(assembly);
   
     RegisterInternalCallAs(assembly , "Logger" , "Write" , (void*)&cs_script_bindings::Write);
   }
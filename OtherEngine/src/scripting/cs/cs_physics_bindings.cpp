@@ -0,0 +1,62 @@
+/**
+ * \file scripting/cs/cs_physics_bindings.cpp
+ **/
+#include "scripting/cs/cs_physics_bindings.hpp"
+
+#include <algorithm>
+#include <span>
+
+#include "core/logger.hpp"
+#include "physics/physics_queries.hpp"
+#include "scene/scene.hpp"
+
+#include "scripting/script_engine.hpp"
+#include "scripting/cs/cs_register_internal_call.hpp"
+
+namespace other {
+namespace {
+
+  /// a whole script batch per call, hits go back with entity uuids
+  template <typename Query>
+  uint32_t RunBatch(const Query* queries , uint32_t count , PhysicsQueryHit* hits , uint32_t* counts , uint32_t max_hits ,
+                    uint32_t (Scene::*query)(std::span<const Query> , const PhysicsQueryResults&) const) {
+    PhysicsQueryResults results {
+      .hits = hits ,
+      .counts = counts ,
+      .num_queries = count ,
+      .max_hits_per_query = max_hits ,
+    };
+
+    Ref<Scene> scene = ScriptEngine::GetSceneContext();
+    if (scene == nullptr) {
+      OE_ERROR("Attempting to run physics queries from invalid scene context!");
+      std::fill_n(counts , count , 0u);
+      return 0;
+    }
+
+    return (scene.Raw()->*query)(std::span<const Query>(queries , count) , results);
+  }
+
+  uint32_t CastRays(const RaycastQuery* queries , uint32_t count , PhysicsQueryHit* hits , uint32_t* counts , uint32_t max_hits) {
+    return RunBatch(queries , count , hits , counts , max_hits , &Scene::CastRays);
+  }
+
+  uint32_t CastShapes(const ShapeCastQuery* queries , uint32_t count , PhysicsQueryHit* hits , uint32_t* counts , uint32_t max_hits) {
+    return RunBatch(queries , count , hits , counts , max_hits , &Scene::CastShapes);
+  }
+
+  uint32_t Overlap(const OverlapQuery* queries , uint32_t count , PhysicsQueryHit* hits , uint32_t* counts , uint32_t max_hits) {
+    return RunBatch(queries , count , hits , counts , max_hits , &Scene::Overlap);
+  }
+
+} // anonymous namespace
+namespace cs_script_bindings {
+
+  void RegisterPhysicsFunctions(ref<Assembly> assembly) {
+    RegisterInternalCallAs(assembly , "Physics" , "CastRays" , (void*)&CastRays);
+    RegisterInternalCallAs(assembly , "Physics" , "CastShapes" , (void*)&CastShapes);
+    RegisterInternalCallAs(assembly , "Physics" , "Overlap" , (void*)&Overlap);
+  }
+
+} // namespace cs_script_bindings 
+} // namespace other
@@ -0,0 +1,234 @@
+/**
+ * \file scripting/lua/lua_allocator.cpp
+ **/
+#include "scripting/lua/lua_allocator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include <sol/sol.hpp>
+
+namespace other {
+
+  LuaAllocator::LuaAllocator() {
+    module_slots.push_back(0);
+    module_stats.push_back({});
+  }
+
+  LuaAllocator::~LuaAllocator() {
+    for (auto& pool : pools) {
+      for (auto* page : pool.pages) {
+        std::free(page);
+      }
+      pool.pages.clear();
+      pool.free_list = nullptr;
+    }
+  }
+
+  void* LuaAllocator::Allocate(void* ud , void* ptr , size_t osize , size_t nsize) {
+    LuaAllocator* allocator = static_cast<LuaAllocator*>(ud);
+
+    if (nsize == 0) {
+      if (ptr != nullptr) {
+        allocator->ReleaseBlock(ptr);
+      }
+      return nullptr;
+    }
+
+    /// when ptr is null osize encodes the type of object being allocated, not a size
+    if (ptr == nullptr) {
+      return allocator->AllocBlock(nsize);
+    }
+
+    return allocator->ReallocBlock(ptr , osize , nsize);
+  }
+
+  LuaAllocator* LuaAllocator::FromState(lua_State* L) {
+    if (L == nullptr) {
+      return nullptr;
+    }
+
+    void* ud = nullptr;
+    if (lua_getallocf(L , &ud) != &LuaAllocator::Allocate) {
+      return nullptr;
+    }
+
+    return static_cast<LuaAllocator*>(ud);
+  }
+
+  UUID LuaAllocator::SetActiveModule(UUID module_id) {
+    UUID previous = module_slots[active_slot];
+
+    auto itr = std::ranges::find(module_slots , module_id);
+    if (itr == module_slots.end()) {
+      module_slots.push_back(module_id);
+      module_stats.push_back({});
+      active_slot = static_cast<uint32_t>(module_slots.size() - 1);
+    } else {
+      active_slot = static_cast<uint32_t>(std::distance(module_slots.begin() , itr));
+    }
+
+    return previous;
+  }
+
+  UUID LuaAllocator::ActiveModule() const {
+    return module_slots[active_slot];
+  }
+
+  const LuaMemoryStats& LuaAllocator::TotalStats() const {
+    return total_stats;
+  }
+
+  LuaMemoryStats LuaAllocator::ModuleStats(UUID module_id) const {
+    auto itr = std::ranges::find(module_slots , module_id);
+    if (itr == module_slots.end()) {
+      return {};
+    }
+
+    return module_stats[std::distance(module_slots.begin() , itr)];
+  }
+
+  size_t LuaAllocator::PooledBytes() const {
+    size_t bytes = 0;
+    for (size_t i = 0; i < kNumSizeClasses; ++i) {
+      bytes += pools[i].pages.size() * kBlocksPerPage * (sizeof(BlockHeader) + kSizeClasses[i]);
+    }
+    return bytes;
+  }
+
+  uint32_t LuaAllocator::SizeClassOf(size_t size) {
+    for (uint32_t i = 0; i < kNumSizeClasses; ++i) {
+      if (size <= kSizeClasses[i]) {
+        return i;
+      }
+    }
+    return kLargeBlock;
+  }
+
+  void* LuaAllocator::AllocBlock(size_t size) {
+    uint32_t size_class = SizeClassOf(size);
+
+    void* block = nullptr;
+    if (size_class == kLargeBlock) {
+      block = std::malloc(sizeof(BlockHeader) + size);
+    } else {
+      block = PopPooled(size_class);
+    }
+
+    if (block == nullptr) {
+      return nullptr;
+    }
+
+    BlockHeader* header = static_cast<BlockHeader*>(block);
+    header->module_slot = active_slot;
+    header->size_class = size_class;
+    header->size = size;
+
+    Charge(active_slot , size);
+    return header + 1;
+  }
+
+  void LuaAllocator::ReleaseBlock(void* ptr) {
+    BlockHeader* header = static_cast<BlockHeader*>(ptr) - 1;
+    Discharge(header->module_slot , header->size);
+
+    if (header->size_class == kLargeBlock) {
+      std::free(header);
+    } else {
+      PushPooled(header->size_class , header);
+    }
+  }
+
+  void* LuaAllocator::ReallocBlock(void* ptr , size_t osize , size_t nsize) {
+    BlockHeader* header = static_cast<BlockHeader*>(ptr) - 1;
+    uint32_t new_class = SizeClassOf(nsize);
+
+    /// still fits in the same block, only the accounting changes
+    if (new_class != kLargeBlock && new_class == header->size_class) {
+      Discharge(header->module_slot , header->size);
+      Charge(header->module_slot , nsize);
+      header->size = nsize;
+      return ptr;
+    }
+
+    if (new_class == kLargeBlock && header->size_class == kLargeBlock) {
+      void* block = std::realloc(header , sizeof(BlockHeader) + nsize);
+      if (block == nullptr) {
+        /// lua assumes shrinking never fails
+        return nsize <= osize ? ptr : nullptr;
+      }
+
+      header = static_cast<BlockHeader*>(block);
+      Discharge(header->module_slot , header->size);
+      Charge(header->module_slot , nsize);
+      header->size = nsize;
+      return header + 1;
+    }
+
+    /// moving between classes, keep charging the module that owns the original block
+    uint32_t owner = header->module_slot;
+    uint32_t current = active_slot;
+
+    active_slot = owner;
+    void* new_ptr = AllocBlock(nsize);
+    active_slot = current;
+
+    if (new_ptr == nullptr) {
+      return nsize <= osize ? ptr : nullptr;
+    }
+
+    std::memcpy(new_ptr , ptr , std::min<size_t>(header->size , nsize));
+    ReleaseBlock(ptr);
+
+    return new_ptr;
+  }
+
+  void* LuaAllocator::PopPooled(uint32_t size_class) {
+    Pool& pool = pools[size_class];
+    if (pool.free_list == nullptr) {
+      const size_t block_size = sizeof(BlockHeader) + kSizeClasses[size_class];
+      uint8_t* page = static_cast<uint8_t*>(std::malloc(block_size * kBlocksPerPage));
+      if (page == nullptr) {
+        return nullptr;
+      }
+      pool.pages.push_back(page);
+
+      for (size_t i = kBlocksPerPage; i > 0; --i) {
+        PushPooled(size_class , page + (i - 1) * block_size);
+      }
+    }
+
+    FreeBlock* block = pool.free_list;
+    pool.free_list = block->next;
+    return block;
+  }
+
+  void LuaAllocator::PushPooled(uint32_t size_class , void* block) {
+    Pool& pool = pools[size_class];
+    FreeBlock* free_block = static_cast<FreeBlock*>(block);
+    free_block->next = pool.free_list;
+    pool.free_list = free_block;
+  }
+
+  void LuaAllocator::Charge(uint32_t slot , size_t size) {
+    auto& stats = module_stats[slot];
+    stats.live_bytes += size;
+    stats.peak_bytes = std::max(stats.peak_bytes , stats.live_bytes);
+    ++stats.num_allocations;
+
+    total_stats.live_bytes += size;
+    total_stats.peak_bytes = std::max(total_stats.peak_bytes , total_stats.live_bytes);
+    ++total_stats.num_allocations;
+  }
+
+  void LuaAllocator::Discharge(uint32_t slot , size_t size) {
+    auto& stats = module_stats[slot];
+    stats.live_bytes -= size;
+    ++stats.num_frees;
+
+    total_stats.live_bytes -= size;
+    ++total_stats.num_frees;
+  }
+
+} // namespace other
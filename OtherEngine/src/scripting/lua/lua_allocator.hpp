@@ -0,0 +1,133 @@
+/**
+ * \file scripting/lua/lua_allocator.hpp
+ **/
+#ifndef LUA_ALLOCATOR_HPP
+#define LUA_ALLOCATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/uuid.hpp"
+
+struct lua_State;
+
+namespace other {
+
+  struct LuaMemoryStats {
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+    uint64_t num_allocations = 0;
+    uint64_t num_frees = 0;
+  };
+
+  /**
+   * allocator handed to lua through lua_setallocf (sol::state ctor)
+   *
+   * small blocks come out of per size class free lists carved from pages that are only returned when
+   *   the allocator is destroyed, anything above the largest class goes straight to malloc
+   *
+   * every block carries a small header recording the module that allocated it, so memory can be attributed
+   *   back to the script module even when the collector frees it while another module is running
+   **/
+  class LuaAllocator {
+    public:
+      constexpr static std::array<size_t , 6> kSizeClasses = { 16 , 32 , 64 , 128 , 256 , 512 };
+      constexpr static size_t kNumSizeClasses = kSizeClasses.size();
+      constexpr static size_t kBlocksPerPage = 256;
+      constexpr static uint32_t kLargeBlock = kNumSizeClasses;
+
+      /// slot 0 is always the language module itself (core files, bindings, etc...)
+      constexpr static uint32_t kCoreModuleSlot = 0;
+
+      LuaAllocator();
+      ~LuaAllocator();
+
+      LuaAllocator(const LuaAllocator&) = delete;
+      LuaAllocator& operator=(const LuaAllocator&) = delete;
+
+      /// matches lua_Alloc, ud must be a LuaAllocator*
+      static void* Allocate(void* ud , void* ptr , size_t osize , size_t nsize);
+
+      /// null if the state was not created with a LuaAllocator
+      static LuaAllocator* FromState(lua_State* L);
+
+      /// sets the module that new allocations are charged to, returns the previously active module
+      UUID SetActiveModule(UUID module_id);
+      UUID ActiveModule() const;
+
+      const LuaMemoryStats& TotalStats() const;
+      LuaMemoryStats ModuleStats(UUID module_id) const;
+
+      template <typename Fn>
+      void ForEachModule(Fn&& fn) const {
+        for (size_t i = 0; i < module_slots.size(); ++i) {
+          fn(module_slots[i] , module_stats[i]);
+        }
+      }
+
+      /// bytes reserved by the size class pages, whether or not they are in use
+      size_t PooledBytes() const;
+
+      class ScopedModule {
+        public:
+          ScopedModule(LuaAllocator* allocator , UUID module_id)
+              : allocator(allocator) {
+            if (allocator != nullptr) {
+              previous = allocator->SetActiveModule(module_id);
+            }
+          }
+
+          ~ScopedModule() {
+            if (allocator != nullptr) {
+              allocator->SetActiveModule(previous);
+            }
+          }
+
+        private:
+          LuaAllocator* allocator = nullptr;
+          UUID previous = 0;
+      };
+
+    private:
+      /// 16 bytes to keep the payload aligned for any lua type
+      struct alignas(16) BlockHeader {
+        uint32_t module_slot;
+        uint32_t size_class;
+        uint64_t size;
+      };
+
+      struct FreeBlock {
+        FreeBlock* next;
+      };
+
+      struct Pool {
+        FreeBlock* free_list = nullptr;
+        std::vector<void*> pages;
+      };
+
+      std::array<Pool , kNumSizeClasses> pools;
+
+      uint32_t active_slot = kCoreModuleSlot;
+      std::vector<UUID> module_slots;
+      std::vector<LuaMemoryStats> module_stats;
+
+      LuaMemoryStats total_stats;
+
+      static uint32_t SizeClassOf(size_t size);
+
+      void* AllocBlock(size_t size);
+      void ReleaseBlock(void* ptr);
+      void* ReallocBlock(void* ptr , size_t osize , size_t nsize);
+
+      void* PopPooled(uint32_t size_class);
+      void PushPooled(uint32_t size_class , void* block);
+
+      void Charge(uint32_t slot , size_t size);
+      void Discharge(uint32_t slot , size_t size);
+  };
+
+} // namespace other
+
+#endif // !LUA_ALLOCATOR_HPP
@@ -12,6 +12,7 @@
 #include "scripting/lua/lua_logging_bindings.hpp"
 #include "scripting/lua/lua_math_bindings.hpp"
 #include "scripting/lua/lua_component_bindings.hpp"
+#include "scripting/lua/lua_physics_bindings.hpp"
 #include "scripting/lua/lua_scene_bindings.hpp"
 #include "scripting/lua/lua_ui_bindings.hpp"
 
@@ -77,6 +78,7 @@ namespace lua_script_bindings {
 
     BindEcsTypes(lua_state);
     BindScene(lua_state);
+    BindPhysics(lua_state);
 
     BindUiTypes(lua_state);
   }
@@ -3,10 +3,12 @@
  **/
 #include "scripting/lua/lua_module.hpp"
 
+#include <algorithm>
 #include <cctype>
 #include <iterator>
 
 #include "core/filesystem.hpp"
+#include "core/time.hpp"
 
 #include "application/app_state.hpp"
 
@@ -133,6 +135,91 @@ namespace other {
     loaded_modules.erase(id);
   }
 
+  void LuaModule::SetGcBudget(uint32_t budget_us) {
+    gc_budget_us = budget_us;
+
+    lua_State* L = context.lua_state();
+    if (gc_budget_us == 0) {
+      lua_gc(L, LUA_GCRESTART);
+      OE_DEBUG("Lua garbage collector running automatically");
+      return;
+    }
+
+    lua_gc(L, LUA_GCINC, 0, 0, kGcStepSizeLog2);
+    lua_gc(L, LUA_GCSTOP);
+    gc_stats.cycle_heap_kb = 0;
+    OE_DEBUG("Lua garbage collector stepped manually with a budget of {}us per frame", gc_budget_us);
+  }
+
+  uint32_t LuaModule::GetGcBudget() const {
+    return gc_budget_us;
+  }
+
+  void LuaModule::StepGarbageCollector() {
+    if (gc_budget_us == 0) {
+      return;
+    }
+
+    lua_State* L = context.lua_state();
+    ++gc_stats.frames;
+
+    const auto start = time::Clock::now();
+    const auto budget = std::chrono::microseconds(gc_budget_us);
+
+    size_t heap_kb = static_cast<size_t>(lua_gc(L, LUA_GCCOUNT));
+    if (gc_stats.cycle_heap_kb != 0 && heap_kb > gc_stats.cycle_heap_kb * kGcEmergencyFactor) {
+      /// scripts are allocating faster than the budget can keep up with, pay for a full cycle now
+      lua_gc(L, LUA_GCCOLLECT);
+      ++gc_stats.full_collections;
+      ++gc_stats.cycles;
+      gc_stats.cycle_heap_kb = static_cast<size_t>(lua_gc(L, LUA_GCCOUNT));
+    } else {
+      while (time::Clock::now() - start < budget) {
+        ++gc_stats.steps;
+        /// a basic step, passing a size here would also pay off all the debt accumulated while stopped
+        if (lua_gc(L, LUA_GCSTEP, 0) != 0) {
+          ++gc_stats.cycles;
+          gc_stats.cycle_heap_kb = static_cast<size_t>(lua_gc(L, LUA_GCCOUNT));
+          break;
+        }
+      }
+    }
+
+    const auto pause = std::chrono::duration_cast<std::chrono::duration<float, std::micro>>(time::Clock::now() - start);
+    RecordGcPause(pause.count());
+    gc_stats.heap_kb = static_cast<size_t>(lua_gc(L, LUA_GCCOUNT));
+  }
+
+  const LuaGcStats& LuaModule::GetGcStats() const {
+    return gc_stats;
+  }
+
+  float LuaModule::GcPausePercentile(float percentile) const {
+    const size_t count = std::min<size_t>(gc_stats.frames, kGcPauseSamples);
+    if (count == 0) {
+      return 0.f;
+    }
+
+    std::array<float, kGcPauseSamples> sorted = gc_pause_samples;
+    auto end = sorted.begin() + count;
+    std::sort(sorted.begin(), end);
+
+    size_t idx = static_cast<size_t>(std::clamp(percentile, 0.f, 1.f) * static_cast<float>(count - 1));
+    return sorted[idx];
+  }
+
+  const LuaAllocator& LuaModule::GetAllocator() const {
+    return allocator;
+  }
+
+  void LuaModule::RecordGcPause(float pause_us) {
+    gc_stats.last_pause_us = pause_us;
+    gc_stats.max_pause_us = std::max(gc_stats.max_pause_us, pause_us);
+
+    gc_pause_samples[gc_pause_index] = pause_us;
+    gc_pause_index = (gc_pause_index + 1) % kGcPauseSamples;
+  }
+
   std::string_view LuaModule::GetModuleName() const {
     return "Lua";
   }
@@ -4,18 +4,39 @@
 #ifndef LUA_MODULE_HPP
 #define LUA_MODULE_HPP
 
+#include <array>
+
 #include <sol/sol.hpp>
 
 #include "scripting/language_module.hpp"
 #include "scripting/script_defines.hpp"
+#include "scripting/lua/lua_allocator.hpp"
 #include "scripting/lua/lua_script.hpp"
 
 namespace other {
+
+  struct LuaGcStats {
+    uint64_t frames = 0;
+    uint64_t steps = 0;
+    uint64_t cycles = 0;
+    uint64_t full_collections = 0;
+
+    float last_pause_us = 0.f;
+    float max_pause_us = 0.f;
+
+    size_t heap_kb = 0;
+    /// heap at the end of the last finished cycle , 0 until the first one finishes
+    size_t cycle_heap_kb = 0;
+  };
   
   class LuaModule : public LanguageModule {
     public:
+      /// if the heap grows this many times past the size at the end of the last cycle we stop respecting the budget
+      constexpr static size_t kGcEmergencyFactor = 4;
+
       LuaModule() 
-          : LanguageModule(LanguageModuleType::LUA_MODULE) {}
+          : LanguageModule(LanguageModuleType::LUA_MODULE) , 
+            context(sol::default_at_panic , &LuaAllocator::Allocate , &allocator) {}
       virtual ~LuaModule() override {}
 
       Ref<LuaScript> GetRawScriptHandle(const std::string_view name);
@@ -31,10 +52,39 @@ namespace other {
       virtual std::string_view GetModuleName() const override;
       virtual std::string_view GetModuleVersion() const override;
 
+      /**
+       * budget of 0 hands collection back to lua's automatic collector, anything else stops the automatic
+       *   collector and relies on StepGarbageCollector being called once a frame
+       **/
+      void SetGcBudget(uint32_t budget_us);
+      uint32_t GetGcBudget() const;
+
+      /// runs incremental gc steps until the frame budget is spent or the current cycle finishes
+      void StepGarbageCollector();
+
+      const LuaGcStats& GetGcStats() const;
+      float GcPausePercentile(float percentile) const;
+
+      const LuaAllocator& GetAllocator() const;
+
     private:
       constexpr static std::string_view kLuaCorePath = "OtherEngine-ScriptCore/lua";
 
+      /// log2 of the amount of work (in bytes) done per incremental step, small steps keep the budget honest
+      constexpr static int kGcStepSizeLog2 = 8;
+      constexpr static size_t kGcPauseSamples = 256;
+
+      /// must be declared before the state so it outlives it
+      LuaAllocator allocator;
       sol::state context;
+
+      uint32_t gc_budget_us = 0;
+
+      LuaGcStats gc_stats;
+      std::array<float , kGcPauseSamples> gc_pause_samples{};
+      size_t gc_pause_index = 0;
+
+      void RecordGcPause(float pause_us);
       std::vector<std::string> core_files;
   };
 
@@ -3,6 +3,8 @@
  **/
 #include "scripting/lua/lua_object.hpp"
 
+#include "scripting/script_module.hpp"
+
 namespace other {
 
     void LuaObject::InitializeScriptMethods() {
@@ -16,4 +18,11 @@ namespace other {
     void LuaObject::InitializeScriptFields() {
     }
 
+    UUID LuaObject::ModuleTag() const {
+      if (module_tag.Get() == 0 && module != nullptr) {
+        module_tag = FNV(module->ModuleName());
+      }
+      return module_tag;
+    }
+
 } // namespace other
@@ -8,6 +8,7 @@
 #include <string>
 
 #include "scripting/script_object.hpp"
+#include "scripting/lua/lua_allocator.hpp"
 
 namespace other {
 
@@ -30,6 +31,7 @@ namespace other {
       
       template <typename R , typename... Args>
       constexpr auto CallMethod(const std::string_view name , Args&&... args) -> R {
+        LuaAllocator::ScopedModule memory_scope(LuaAllocator::FromState(state.lua_state()) , ModuleTag());
         try {
           if (!object.valid()) {
             OE_ERROR("Lua state or object is invalid");
@@ -107,6 +109,12 @@ namespace other {
     protected:
       sol::state& state;
       sol::table object;
+
+    private:
+      mutable UUID module_tag = 0;
+
+      /// id of the owning script module, used to charge memory allocated during calls to the right module
+      UUID ModuleTag() const;
   };
 
 
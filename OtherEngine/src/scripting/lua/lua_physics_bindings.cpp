@@ -0,0 +1,153 @@
+/**
+ * \file scripting/lua/lua_physics_bindings.cpp
+ **/
+#include "scripting/lua/lua_physics_bindings.hpp"
+
+#include <vector>
+
+#include <sol/raii.hpp>
+#include <glm/glm.hpp>
+
+#include "core/logger.hpp"
+#include "physics/physics_queries.hpp"
+#include "scene/scene.hpp"
+
+#include "scripting/script_engine.hpp"
+
+namespace other {
+namespace lua_script_bindings {
+namespace {
+
+  /**
+   * scripts fill a batch over the frame and submit it once, every query in it runs in one parallel pass per kind
+   *
+   * indices handed back to lua start at 1 and stay valid until Clear
+   **/
+  class PhysicsQueryBatch {
+    public:
+      PhysicsQueryBatch(uint32_t max_hits_per_query)
+          : max_hits_per_query(std::max(max_hits_per_query , 1u)) {}
+
+      size_t AddRay(const glm::vec3& origin , const glm::vec3& direction , float max_distance) {
+        rays.push_back({ .origin = origin , .direction = direction , .max_distance = max_distance });
+        return rays.size();
+      }
+
+      size_t AddSphereCast(float radius , const glm::vec3& origin , const glm::vec3& direction , float max_distance) {
+        return AddShapeCast({ .type = SPHERE_QUERY_SHAPE , .extent = glm::vec3{ radius } } , origin , direction , max_distance);
+      }
+
+      size_t AddBoxCast(const glm::vec3& half_extent , const glm::vec3& origin , const glm::vec3& direction , float max_distance) {
+        return AddShapeCast({ .type = BOX_QUERY_SHAPE , .extent = half_extent } , origin , direction , max_distance);
+      }
+
+      size_t AddSphereOverlap(float radius , const glm::vec3& center) {
+        overlaps.push_back({ .shape = { .type = SPHERE_QUERY_SHAPE , .extent = glm::vec3{ radius } } , .center = center });
+        return overlaps.size();
+      }
+
+      size_t AddBoxOverlap(const glm::vec3& half_extent , const glm::vec3& center) {
+        overlaps.push_back({ .shape = { .type = BOX_QUERY_SHAPE , .extent = half_extent } , .center = center });
+        return overlaps.size();
+      }
+
+      /// returns the total number of hits over every query in the batch
+      uint32_t Submit() {
+        Ref<Scene> scene = ScriptEngine::GetSceneContext();
+        if (scene == nullptr) {
+          OE_ERROR("Attempting to run physics queries from invalid scene context!");
+          return 0;
+        }
+
+        ray_hits.Reset(static_cast<uint32_t>(rays.size()) , max_hits_per_query);
+        shape_cast_hits.Reset(static_cast<uint32_t>(shape_casts.size()) , max_hits_per_query);
+        overlap_hits.Reset(static_cast<uint32_t>(overlaps.size()) , max_hits_per_query);
+
+        uint32_t total_hits = 0;
+        if (!rays.empty()) {
+          total_hits += scene->CastRays(rays , ray_hits.Results());
+        }
+        if (!shape_casts.empty()) {
+          total_hits += scene->CastShapes(shape_casts , shape_cast_hits.Results());
+        }
+        if (!overlaps.empty()) {
+          total_hits += scene->Overlap(overlaps , overlap_hits.Results());
+        }
+        return total_hits;
+      }
+
+      sol::table RayHits(size_t index , sol::this_state s) const {
+        return HitsTable(ray_hits , index , s);
+      }
+
+      sol::table ShapeCastHits(size_t index , sol::this_state s) const {
+        return HitsTable(shape_cast_hits , index , s);
+      }
+
+      sol::table OverlapHits(size_t index , sol::this_state s) const {
+        return HitsTable(overlap_hits , index , s);
+      }
+
+      /// keeps every buffer's memory so the next frame's batch does not allocate
+      void Clear() {
+        rays.clear();
+        shape_casts.clear();
+        overlaps.clear();
+      }
+
+    private:
+      uint32_t max_hits_per_query;
+
+      std::vector<RaycastQuery> rays;
+      std::vector<ShapeCastQuery> shape_casts;
+      std::vector<OverlapQuery> overlaps;
+
+      PhysicsQueryBuffer ray_hits;
+      PhysicsQueryBuffer shape_cast_hits;
+      PhysicsQueryBuffer overlap_hits;
+
+      size_t AddShapeCast(const PhysicsQueryShape& shape , const glm::vec3& origin , const glm::vec3& direction , float max_distance) {
+        shape_casts.push_back({ .shape = shape , .origin = origin , .direction = direction , .max_distance = max_distance });
+        return shape_casts.size();
+      }
+
+      static sol::table HitsTable(const PhysicsQueryBuffer& buffer , size_t index , sol::this_state s) {
+        sol::state_view lua(s);
+        sol::table hits = lua.create_table();
+        if (index == 0 || index > buffer.NumQueries()) {
+          return hits;
+        }
+
+        for (const auto& hit : buffer.Hits(static_cast<uint32_t>(index - 1))) {
+          hits.add(lua.create_table_with(
+            "entity" , hit.user_data ,
+            "point" , hit.point ,
+            "normal" , hit.normal ,
+            "fraction" , hit.fraction
+          ));
+        }
+        return hits;
+      }
+  };
+
+} // anonymous namespace
+
+  void BindPhysics(sol::state& lua_state) {
+    lua_state.new_usertype<PhysicsQueryBatch>(
+      "PhysicsQueryBatch" ,
+      sol::constructors<PhysicsQueryBatch(uint32_t)>() ,
+      "AddRay" , &PhysicsQueryBatch::AddRay ,
+      "AddSphereCast" , &PhysicsQueryBatch::AddSphereCast ,
+      "AddBoxCast" , &PhysicsQueryBatch::AddBoxCast ,
+      "AddSphereOverlap" , &PhysicsQueryBatch::AddSphereOverlap ,
+      "AddBoxOverlap" , &PhysicsQueryBatch::AddBoxOverlap ,
+      "Submit" , &PhysicsQueryBatch::Submit ,
+      "RayHits" , &PhysicsQueryBatch::RayHits ,
+      "ShapeCastHits" , &PhysicsQueryBatch::ShapeCastHits ,
+      "OverlapHits" , &PhysicsQueryBatch::OverlapHits ,
+      "Clear" , &PhysicsQueryBatch::Clear
+    );
+  }
+
+} // namespace lua_script_bindings
+} // namespace other
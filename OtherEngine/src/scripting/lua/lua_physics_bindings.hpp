@@ -0,0 +1,17 @@
+/**
+ * \file scripting/lua/lua_physics_bindings.hpp
+ **/
+#ifndef OTHER_ENGINE_LUA_PHYSICS_BINDINGS_HPP
+#define OTHER_ENGINE_LUA_PHYSICS_BINDINGS_HPP
+
+#include <sol/state.hpp>
+
+namespace other {
+namespace lua_script_bindings {
+
+  void BindPhysics(sol::state& lua_state);
+
+} // namespace lua_script_bindings
+} // namespace other
+
+#endif // !OTHER_ENGINE_LUA_PHYSICS_BINDINGS_HPP
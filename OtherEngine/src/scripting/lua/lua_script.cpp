@@ -14,10 +14,13 @@
 #include "core/filesystem.hpp"
 #include "core/ref.hpp"
 
+#include "scripting/lua/lua_allocator.hpp"
+
 namespace other {
 
   void LuaScript::Initialize() {
     bool corrupt = false;
+    LuaAllocator::ScopedModule memory_scope(LuaAllocator::FromState(lua_state.lua_state()), FNV(module_name));
 
     try {
       sol::function_result res = lua_state.safe_script_file(path);
@@ -103,6 +106,7 @@ namespace other {
     }
 
     ScriptRef<LuaObject> obj = nullptr;
+    LuaAllocator::ScopedModule memory_scope(LuaAllocator::FromState(lua_state.lua_state()), FNV(module_name));
     {
       try {
         sol::table search_table = lua_state.globals();
@@ -45,6 +45,10 @@ namespace other {
 
     LoadModule(CS_MODULE);
     LoadModule(LUA_MODULE);
+
+    std::string lua_key = std::string{ kScriptEngineSection } + "." + std::string{ kLuaModuleSection };
+    uint32_t gc_budget = config.GetVal<uint32_t>(lua_key, kGcBudgetValue, false).value_or(kDefaultLuaGcBudgetUs);
+    GetModuleAs<LuaModule>(LUA_MODULE)->SetGcBudget(gc_budget);
   }
 
   void ScriptEngine::LoadProjectModules() {
@@ -159,6 +159,9 @@ namespace other {
     }
 
    private:
+    /// per frame time handed to the lua collector, see LuaModule::SetGcBudget
+    constexpr static uint32_t kDefaultLuaGcBudgetUs = 500;
+
     static ConfigTable config;
 
     static Ref<Scene> scene_context;
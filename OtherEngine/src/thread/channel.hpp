@@ -9,6 +9,7 @@
 #include <condition_variable>
 
 #include "core/defines.hpp"
+#include "core/profile.hpp"
 #include "core/ref.hpp"
 
 namespace other {
@@ -16,8 +17,8 @@ namespace other {
   template <typename T>
   struct Queue {
     std::queue<T> queue;
-    std::mutex mutex;
-    std::condition_variable condition;
+    OE_PROFILE_MUTEX(std::mutex , mutex , "Channel queue");
+    ProfiledConditionVariable condition;
   };
 
   template <typename T>
@@ -28,7 +29,7 @@ namespace other {
       ~Sender() {}
 
       void Send(const T& msg) {
-        std::lock_guard<std::mutex> lock(queue->mutex);
+        std::lock_guard lock(queue->mutex);
         queue->queue.push(msg);
         queue->condition.notify_one();
       }
@@ -52,7 +53,7 @@ namespace other {
       ~Receiver() {}
 
       T Recv() {
-        std::unique_lock<std::mutex> lock(queue->mutex);
+        std::unique_lock lock(queue->mutex);
         queue->condition.wait(lock, [&]{ return !queue->queue.empty(); });
         T item = queue->queue.front();
         queue->queue.pop();
@@ -65,7 +66,7 @@ namespace other {
       }
 
       bool Empty() {
-        std::lock_guard<std::mutex> lock(queue->mutex);
+        std::lock_guard lock(queue->mutex);
         return queue->queue.empty();
       }
 
@@ -0,0 +1,284 @@
+/**
+ * \file bench/bench.cpp
+ **/
+#include "bench.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
+#include <nlohmann/json.hpp>
+
+#include "core/logger.hpp"
+
+namespace other {
+namespace {
+
+  constexpr uint32_t kResultsVersion = 1;
+
+  std::vector<Benchmark>& Registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+  }
+
+  /// nearest rank on sorted samples
+  double Percentile(const std::vector<double>& sorted , double p) {
+    if (sorted.empty()) {
+      return 0.0;
+    }
+
+    const size_t rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(rank , sorted.size() - 1)];
+  }
+
+} // anonymous namespace
+
+  BenchmarkSettings BenchmarkSettings::FromConfig(const ConfigTable& config) {
+    BenchmarkSettings settings;
+    settings.warmup = config.GetVal<uint32_t>(kBenchSection , kWarmupValue , false).value_or(settings.warmup);
+    settings.iterations = std::max(config.GetVal<uint32_t>(kBenchSection , kIterationsValue , false).value_or(settings.iterations) , 1u);
+    settings.threshold = config.GetVal<double>(kBenchSection , kThresholdValue , false).value_or(settings.threshold);
+    settings.filter = config.GetVal<std::string>(kBenchSection , kFilterValue , false).value_or("");
+    settings.output = config.GetVal<std::string>(kBenchSection , kOutputValue , false).value_or(settings.output.string());
+
+    const Path baseline_dir = config.GetVal<std::string>(kBenchSection , kBaselineDirValue , false)
+      .value_or((Filesystem::GetEngineCoreDir() / "OtherTestEngine" / "bench" / "baselines").string());
+    settings.baseline = baseline_dir / fmtstr("{}.json" , BenchmarkBuildName());
+    return settings;
+  }
+
+  double BenchmarkResult::ItemsPerSecond() const {
+    if (median_ms <= 0.0) {
+      return 0.0;
+    }
+    return static_cast<double>(items) / (median_ms / 1000.0);
+  }
+
+  double BenchmarkResult::NanosecondsPerItem() const {
+    if (items == 0) {
+      return 0.0;
+    }
+    return median_ms * 1'000'000.0 / static_cast<double>(items);
+  }
+
+  BenchmarkRun::BenchmarkRun(std::string_view name , const BenchmarkSettings& settings)
+      : settings(settings) {
+    result.name = name;
+    samples_ms.reserve(settings.iterations);
+  }
+
+  void BenchmarkRun::SetItems(uint64_t items) {
+    result.items = items;
+  }
+
+  void BenchmarkRun::SetBudget(double ns_per_item) {
+    result.budget_ns = ns_per_item;
+  }
+
+  void BenchmarkRun::Skip(std::string_view reason) {
+    result.skipped = reason;
+  }
+
+  BenchmarkResult BenchmarkRun::Result() const {
+    BenchmarkResult res = result;
+    if (samples_ms.empty()) {
+      if (res.skipped.empty()) {
+        res.skipped = "benchmark never called Measure";
+      }
+      return res;
+    }
+
+    std::vector<double> sorted = samples_ms;
+    std::ranges::sort(sorted);
+
+    res.iterations = static_cast<uint32_t>(sorted.size());
+    res.min_ms = sorted.front();
+    res.max_ms = sorted.back();
+    res.median_ms = Percentile(sorted , 0.5);
+    res.p95_ms = Percentile(sorted , 0.95);
+    res.mean_ms = std::accumulate(sorted.begin() , sorted.end() , 0.0) / static_cast<double>(sorted.size());
+    return res;
+  }
+
+  bool BenchmarkRegistry::Register(std::string_view name , BenchmarkFn fn) {
+    Registry().push_back(Benchmark{
+      .name = name ,
+      .fn = fn ,
+    });
+    return true;
+  }
+
+  std::vector<Benchmark> BenchmarkRegistry::Benchmarks() {
+    std::vector<Benchmark> benchmarks = Registry();
+    std::ranges::sort(benchmarks , [](const Benchmark& a , const Benchmark& b) {
+      return a.name < b.name;
+    });
+    return benchmarks;
+  }
+
+  std::vector<BenchmarkResult> BenchmarkRegistry::Run(const BenchmarkSettings& settings) {
+    std::vector<BenchmarkResult> results;
+    for (const auto& benchmark : Benchmarks()) {
+      if (!settings.filter.empty() && benchmark.name.find(settings.filter) == std::string_view::npos) {
+        continue;
+      }
+
+      OE_INFO("Running benchmark {}" , benchmark.name);
+
+      BenchmarkRun run(benchmark.name , settings);
+      benchmark.fn(run);
+      results.push_back(run.Result());
+
+      const BenchmarkResult& result = results.back();
+      if (!result.skipped.empty()) {
+        println("  {:<32} skipped : {}" , result.name , result.skipped);
+      } else {
+        println("  {:<32} median {:>10.3f} ms | min {:>10.3f} ms | p95 {:>10.3f} ms | {:>14.0f} items/s" ,
+                result.name , result.median_ms , result.min_ms , result.p95_ms , result.ItemsPerSecond());
+      }
+    }
+    return results;
+  }
+
+  std::string BenchmarkResultsToJson(const std::vector<BenchmarkResult>& results , const BenchmarkSettings& settings) {
+    nlohmann::ordered_json json;
+    json["version"] = kResultsVersion;
+    json["build"] = BenchmarkBuildName();
+    json["warmup"] = settings.warmup;
+    json["iterations"] = settings.iterations;
+
+    nlohmann::ordered_json& benchmarks = json["benchmarks"] = nlohmann::ordered_json::array();
+    for (const auto& result : results) {
+      nlohmann::ordered_json entry;
+      entry["name"] = result.name;
+      if (!result.skipped.empty()) {
+        entry["skipped"] = result.skipped;
+        benchmarks.push_back(std::move(entry));
+        continue;
+      }
+
+      entry["iterations"] = result.iterations;
+      entry["items"] = result.items;
+      entry["min_ms"] = result.min_ms;
+      entry["median_ms"] = result.median_ms;
+      entry["mean_ms"] = result.mean_ms;
+      entry["p95_ms"] = result.p95_ms;
+      entry["max_ms"] = result.max_ms;
+      entry["items_per_second"] = result.ItemsPerSecond();
+      if (result.budget_ns > 0.0) {
+        entry["ns_per_item"] = result.NanosecondsPerItem();
+        entry["budget_ns"] = result.budget_ns;
+      }
+      benchmarks.push_back(std::move(entry));
+    }
+
+    return json.dump(2) + "\n";
+  }
+
+  bool WriteBenchmarkResults(const Path& path , const std::vector<BenchmarkResult>& results , const BenchmarkSettings& settings) {
+    if (path.has_parent_path()) {
+      std::error_code ec;
+      std::filesystem::create_directories(path.parent_path() , ec);
+    }
+
+    std::ofstream file(path , std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+      OE_ERROR("Failed to open benchmark results file {}" , path.string());
+      return false;
+    }
+
+    file << BenchmarkResultsToJson(results , settings);
+    return file.good();
+  }
+
+  Opt<std::vector<BenchmarkResult>> ReadBenchmarkResults(const Path& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+      return std::nullopt;
+    }
+
+    nlohmann::json json = nlohmann::json::parse(file , nullptr , false);
+    if (json.is_discarded() || !json.contains("benchmarks") || !json["benchmarks"].is_array()) {
+      OE_ERROR("Benchmark baseline {} is not a results file" , path.string());
+      return std::nullopt;
+    }
+
+    if (json.value("version" , 0u) != kResultsVersion) {
+      OE_WARN("Benchmark baseline {} has version {} , expected {}" , path.string() , json.value("version" , 0u) , kResultsVersion);
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (const auto& entry : json["benchmarks"]) {
+      BenchmarkResult& result = results.emplace_back();
+      result.name = entry.value("name" , "");
+      result.skipped = entry.value("skipped" , "");
+      result.iterations = entry.value("iterations" , 0u);
+      result.items = entry.value("items" , uint64_t{ 0 });
+      result.min_ms = entry.value("min_ms" , 0.0);
+      result.median_ms = entry.value("median_ms" , 0.0);
+      result.mean_ms = entry.value("mean_ms" , 0.0);
+      result.p95_ms = entry.value("p95_ms" , 0.0);
+      result.max_ms = entry.value("max_ms" , 0.0);
+      result.budget_ns = entry.value("budget_ns" , 0.0);
+    }
+    return results;
+  }
+
+  std::vector<BenchmarkComparison> CompareBenchmarks(const std::vector<BenchmarkResult>& baseline ,
+                                                     const std::vector<BenchmarkResult>& current , double threshold) {
+    std::vector<BenchmarkComparison> comparisons;
+    for (const auto& result : current) {
+      if (!result.skipped.empty()) {
+        continue;
+      }
+
+      BenchmarkComparison& comparison = comparisons.emplace_back();
+      comparison.name = result.name;
+      comparison.current_ms = result.median_ms;
+
+      if (result.budget_ns > 0.0) {
+        comparison.ns_per_item = result.NanosecondsPerItem();
+        comparison.budget_ns = result.budget_ns;
+        comparison.over_budget = result.items == 0 || comparison.ns_per_item > result.budget_ns;
+      }
+
+      auto base = std::ranges::find_if(baseline , [&](const BenchmarkResult& b) {
+        return b.name == result.name && b.skipped.empty() && b.median_ms > 0.0;
+      });
+      if (base == baseline.end()) {
+        comparison.missing = true;
+        continue;
+      }
+
+      comparison.baseline_ms = base->median_ms;
+      comparison.ratio = result.median_ms / base->median_ms;
+      comparison.regressed = comparison.ratio > 1.0 + threshold;
+    }
+    return comparisons;
+  }
+
+  std::vector<std::string> MissingBaselineEntries(const std::vector<BenchmarkResult>& baseline ,
+                                                  const std::vector<std::string_view>& names) {
+    std::vector<std::string> missing;
+    for (const auto& name : names) {
+      const bool recorded = std::ranges::any_of(baseline , [&](const BenchmarkResult& b) {
+        return b.name == name;
+      });
+      if (!recorded) {
+        missing.emplace_back(name);
+      }
+    }
+    return missing;
+  }
+
+  std::string_view BenchmarkBuildName() {
+#if defined(OE_PROFILE_BUILD)
+    return "profile";
+#elif defined(OE_DEBUG_BUILD)
+    return "debug";
+#else
+    return "release";
+#endif
+  }
+
+} // namespace other
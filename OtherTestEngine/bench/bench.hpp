@@ -0,0 +1,187 @@
+/**
+ * \file bench/bench.hpp
+ **/
+#ifndef OTHER_BENCH_HPP
+#define OTHER_BENCH_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/defines.hpp"
+#include "core/config.hpp"
+#include "core/filesystem.hpp"
+#include "core/time.hpp"
+
+/**
+ * registers a benchmark , the body receives a BenchmarkRun named run
+ *
+ *  OE_BENCHMARK(EntitySpawn , "scene.entity_spawn") {
+ *    ... setup ...
+ *    run.Measure([&]() { ... timed ... });
+ *  }
+ **/
+#define OE_BENCHMARK(fn_name , bench_name) \
+  static void fn_name(::other::BenchmarkRun& run); \
+  static const bool fn_name##_registered = ::other::BenchmarkRegistry::Register(bench_name , &fn_name); \
+  static void fn_name(::other::BenchmarkRun& run)
+
+namespace other {
+
+  constexpr static std::string_view kBenchSection = "BENCH";
+  constexpr static std::string_view kWarmupValue = "WARMUP";
+  constexpr static std::string_view kIterationsValue = "ITERATIONS";
+  constexpr static std::string_view kThresholdValue = "REGRESSION-THRESHOLD";
+  constexpr static std::string_view kBaselineDirValue = "BASELINE-DIR";
+  constexpr static std::string_view kOutputValue = "OUTPUT";
+  constexpr static std::string_view kFilterValue = "FILTER";
+
+  struct BenchmarkSettings {
+    uint32_t warmup = 2;
+    uint32_t iterations = 20;
+
+    /// a median this fraction over its baseline median is a regression
+    double threshold = 0.15;
+
+    std::string filter;
+    Path output = "./bench_results.json";
+    Path baseline;
+    bool update_baseline = false;
+
+    static BenchmarkSettings FromConfig(const ConfigTable& config);
+  };
+
+  /// wall time of one benchmark over its measured iterations , warmup iterations are not in here
+  struct BenchmarkResult {
+    std::string name;
+    uint32_t iterations = 0;
+
+    /// units of work one iteration does , entities spawned , rays cast , shaders compiled
+    uint64_t items = 0;
+
+    double min_ms = 0.0;
+    double median_ms = 0.0;
+    double mean_ms = 0.0;
+    double p95_ms = 0.0;
+    double max_ms = 0.0;
+
+    /// absolute ceiling on the median time per item , checked on every run with or without a baseline , 0 is none
+    double budget_ns = 0.0;
+
+    /// set when the benchmark could not run here , it is reported but never compared
+    std::string skipped;
+
+    double ItemsPerSecond() const;
+    double NanosecondsPerItem() const;
+  };
+
+  class BenchmarkRun {
+    public:
+      BenchmarkRun(std::string_view name , const BenchmarkSettings& settings);
+
+      void SetItems(uint64_t items);
+
+      /// for benchmarks that demonstrate a fixed cost , needs SetItems
+      void SetBudget(double ns_per_item);
+
+      void Skip(std::string_view reason);
+
+      /// times fn once per iteration
+      template <typename Fn>
+      void Measure(Fn&& fn) {
+        Measure([]() {} , fn);
+      }
+
+      /// reset runs before every iteration outside of the clock , for benchmarks that consume their input
+      template <typename Reset , typename Fn>
+      void Measure(Reset&& reset , Fn&& fn) {
+        for (uint32_t i = 0; i < settings.warmup + settings.iterations; ++i) {
+          reset();
+
+          const auto start = time::Clock::now();
+          fn();
+          const auto end = time::Clock::now();
+
+          if (i >= settings.warmup) {
+            samples_ms.push_back(std::chrono::duration<double , std::milli>(end - start).count());
+          }
+        }
+      }
+
+      BenchmarkResult Result() const;
+
+    private:
+      const BenchmarkSettings& settings;
+
+      BenchmarkResult result;
+      std::vector<double> samples_ms;
+  };
+
+  using BenchmarkFn = void(*)(BenchmarkRun&);
+
+  struct Benchmark {
+    std::string_view name;
+    BenchmarkFn fn = nullptr;
+  };
+
+  class BenchmarkRegistry {
+    public:
+      static bool Register(std::string_view name , BenchmarkFn fn);
+
+      /// sorted by name so runs and result files are in a stable order
+      static std::vector<Benchmark> Benchmarks();
+
+      /// every benchmark whose name contains the settings' filter
+      static std::vector<BenchmarkResult> Run(const BenchmarkSettings& settings);
+  };
+
+  struct BenchmarkComparison {
+    std::string name;
+
+    double baseline_ms = 0.0;
+    double current_ms = 0.0;
+
+    /// current over baseline median , 1.0 is unchanged
+    double ratio = 0.0;
+
+    bool regressed = false;
+
+    /// no baseline entry , a new benchmark or one skipped when the baseline was recorded
+    bool missing = false;
+
+    /// the current median per item against the benchmark's own budget , independent of the baseline
+    double ns_per_item = 0.0;
+    double budget_ns = 0.0;
+    bool over_budget = false;
+  };
+
+  /**
+   * results files and baselines share one json layout
+   *
+   *  { "version" : 1 , "build" : "release" , "benchmarks" : [ { "name" : ... , "median_ms" : ... } , ... ] }
+   *
+   * comparisons are on the median , the least noisy of the recorded statistics
+   **/
+  std::string BenchmarkResultsToJson(const std::vector<BenchmarkResult>& results , const BenchmarkSettings& settings);
+  bool WriteBenchmarkResults(const Path& path , const std::vector<BenchmarkResult>& results , const BenchmarkSettings& settings);
+
+  /// nullopt when the baseline cannot be read or is not a results file
+  Opt<std::vector<BenchmarkResult>> ReadBenchmarkResults(const Path& path);
+
+  std::vector<BenchmarkComparison> CompareBenchmarks(const std::vector<BenchmarkResult>& baseline ,
+                                                     const std::vector<BenchmarkResult>& current , double threshold);
+
+  /**
+   * names with no entry in the baseline at all , an entry recorded as skipped still counts
+   *
+   * every registered scenario needs one so a scenario can not drop out of the gate by never being recorded
+   **/
+  std::vector<std::string> MissingBaselineEntries(const std::vector<BenchmarkResult>& baseline ,
+                                                  const std::vector<std::string_view>& names);
+
+  /// debug , release or profile , baselines are only comparable within one build configuration
+  std::string_view BenchmarkBuildName();
+
+} // namespace other
+
+#endif // !OTHER_BENCH_HPP
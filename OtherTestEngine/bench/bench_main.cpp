@@ -0,0 +1,235 @@
+/**
+ * \file bench/bench_main.cpp
+ **/
+#include "bench.hpp"
+
+#include <charconv>
+#include <iostream>
+
+#include "core/errors.hpp"
+#include "core/frame_profiler.hpp"
+#include "core/logger.hpp"
+#include "core/thread_pool.hpp"
+#include "parsing/ini_parser.hpp"
+
+#include "event/event_queue.hpp"
+
+#include "scripting/script_engine.hpp"
+#include "physics/phyics_engine.hpp"
+
+namespace other {
+namespace {
+
+  constexpr std::string_view kUsage =
+    "usage : OtherBench [options]\n"
+    "  --config <path>       bench config , defaults to OtherTestEngine/bench/bench.other\n"
+    "  --filter <text>       only run benchmarks whose name contains text\n"
+    "  --out <path>          where to write the results json\n"
+    "  --baseline <path>     baseline to compare against , defaults to baselines/<build>.json\n"
+    "  --threshold <ratio>   allowed median slowdown before a benchmark counts as regressed , 0.15 is 15%\n"
+    "  --iterations <n>      measured iterations per benchmark\n"
+    "  --warmup <n>          unmeasured iterations before those\n"
+    "  --update-baseline     write the results over the baseline instead of comparing\n";
+
+  struct BenchArgs {
+    Path config_path = Filesystem::GetEngineCoreDir() / "OtherTestEngine" / "bench" / "bench.other";
+
+    Opt<std::string> filter;
+    Opt<Path> output;
+    Opt<Path> baseline;
+    Opt<double> threshold;
+    Opt<uint32_t> iterations;
+    Opt<uint32_t> warmup;
+    bool update_baseline = false;
+  };
+
+  template <typename T>
+  Opt<T> ParseNumber(std::string_view text) {
+    T value{};
+    auto [end , ec] = std::from_chars(text.data() , text.data() + text.size() , value);
+    if (ec != std::errc{} || end != text.data() + text.size()) {
+      return std::nullopt;
+    }
+    return value;
+  }
+
+  Opt<BenchArgs> ParseArgs(int argc , char* argv[]) {
+    BenchArgs args;
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view flag = argv[i];
+      if (flag == "--update-baseline") {
+        args.update_baseline = true;
+        continue;
+      }
+
+      if (i + 1 >= argc) {
+        std::cout << "missing value for " << flag << "\n" << kUsage;
+        return std::nullopt;
+      }
+      const std::string_view value = argv[++i];
+
+      if (flag == "--config") {
+        args.config_path = value;
+      } else if (flag == "--filter") {
+        args.filter = std::string{ value };
+      } else if (flag == "--out") {
+        args.output = value;
+      } else if (flag == "--baseline") {
+        args.baseline = value;
+      } else if (flag == "--threshold") {
+        args.threshold = ParseNumber<double>(value);
+      } else if (flag == "--iterations") {
+        args.iterations = ParseNumber<uint32_t>(value);
+      } else if (flag == "--warmup") {
+        args.warmup = ParseNumber<uint32_t>(value);
+      } else {
+        std::cout << "unknown option " << flag << "\n" << kUsage;
+        return std::nullopt;
+      }
+    }
+    return args;
+  }
+
+  /// everything a scene needs except a window , the renderer and ui are never brought up
+  void InitializeHeadless(const ConfigTable& config) {
+    Logger::Open(config);
+    Logger::Instance()->RegisterThread("Main Other Engine Bench Thread");
+
+    FrameProfiler::Initialize(config);
+    ThreadPool::Initialize(config);
+    EventQueue::Initialize(config);
+    ScriptEngine::Initialize(config);
+    PhysicsEngine::Initialize(config);
+  }
+
+  void ShutdownHeadless() {
+    PhysicsEngine::Shutdown();
+    ScriptEngine::Shutdown();
+    EventQueue::Shutdown();
+    ThreadPool::Shutdown();
+    FrameProfiler::Shutdown();
+    Logger::Shutdown();
+  }
+
+  /// registered benchmarks the filter selects , ran or skipped
+  std::vector<std::string_view> SelectedBenchmarks(const BenchmarkSettings& settings) {
+    std::vector<std::string_view> names;
+    for (const auto& benchmark : BenchmarkRegistry::Benchmarks()) {
+      if (settings.filter.empty() || benchmark.name.find(settings.filter) != std::string_view::npos) {
+        names.push_back(benchmark.name);
+      }
+    }
+    return names;
+  }
+
+  /**
+   * 1 when anything regressed , went over its budget or has no baseline entry at all , a result whose baseline entry
+   *   was recorded as skipped is reported and does not fail the run
+   **/
+  int Report(const std::vector<BenchmarkComparison>& comparisons , const std::vector<std::string>& unrecorded ,
+             double threshold) {
+    uint32_t regressions = 0;
+    uint32_t over_budget = 0;
+    println("\ncomparison against baseline , regression threshold {:.1f}%" , threshold * 100.0);
+    for (const auto& c : comparisons) {
+      if (c.missing) {
+        println("  {:<32} {:>10.3f} ms | no baseline" , c.name , c.current_ms);
+      } else {
+        println("  {:<32} {:>10.3f} ms | baseline {:>10.3f} ms | {:+7.1f}%{}" , c.name , c.current_ms , c.baseline_ms ,
+                (c.ratio - 1.0) * 100.0 , c.regressed ? " REGRESSED" : "");
+      }
+
+      if (c.budget_ns > 0.0) {
+        println("  {:<32} {:>10.1f} ns per item | budget {:>7.1f} ns{}" , "" , c.ns_per_item , c.budget_ns ,
+                c.over_budget ? " OVER BUDGET" : "");
+      }
+
+      regressions += c.regressed ? 1 : 0;
+      over_budget += c.over_budget ? 1 : 0;
+    }
+
+    if (regressions > 0) {
+      println("{} benchmark(s) regressed" , regressions);
+    }
+    if (over_budget > 0) {
+      println("{} benchmark(s) over budget" , over_budget);
+    }
+    for (const auto& name : unrecorded) {
+      println("  {:<32} has no baseline entry , record one with --update-baseline" , name);
+    }
+    if (!unrecorded.empty()) {
+      println("{} benchmark(s) missing from the baseline" , unrecorded.size());
+    }
+    return regressions + over_budget + unrecorded.size() > 0 ? 1 : 0;
+  }
+
+} // anonymous namespace
+} // namespace other
+
+/**
+ * headless benchmark driver , runs every registered benchmark , writes the results json and compares medians
+ *   against the baseline for this build configuration
+ *
+ * exits 1 on a regression , a benchmark over its absolute budget or a benchmark the baseline does not cover so it
+ *   can gate a ci job , baselines are refreshed with --update-baseline on the machine that owns them
+ **/
+int main(int argc , char* argv[]) {
+  using namespace other;
+
+  Opt<BenchArgs> args = ParseArgs(argc , argv);
+  if (!args.has_value()) {
+    return 2;
+  }
+
+  ConfigTable config;
+  try {
+    IniFileParser parser(args->config_path.string());
+    config = parser.Parse();
+  } catch (const IniException& e) {
+    std::cout << "Failed to parse bench config " << args->config_path.string() << " : " << e.what() << "\n";
+    return 2;
+  }
+
+  BenchmarkSettings settings = BenchmarkSettings::FromConfig(config);
+  settings.filter = args->filter.value_or(settings.filter);
+  settings.output = args->output.value_or(settings.output);
+  settings.baseline = args->baseline.value_or(settings.baseline);
+  settings.threshold = args->threshold.value_or(settings.threshold);
+  settings.iterations = std::max(args->iterations.value_or(settings.iterations) , 1u);
+  settings.warmup = args->warmup.value_or(settings.warmup);
+  settings.update_baseline = args->update_baseline;
+
+  InitializeHeadless(config);
+
+  println("running benchmarks [{} build | {} warmup + {} iterations]" , BenchmarkBuildName() , settings.warmup , settings.iterations);
+  const std::vector<BenchmarkResult> results = BenchmarkRegistry::Run(settings);
+
+  ShutdownHeadless();
+
+  if (!WriteBenchmarkResults(settings.output , results , settings)) {
+    std::cout << "Failed to write benchmark results to " << settings.output.string() << "\n";
+    return 2;
+  }
+  println("results written to {}" , settings.output.string());
+
+  if (settings.update_baseline) {
+    if (!WriteBenchmarkResults(settings.baseline , results , settings)) {
+      std::cout << "Failed to write benchmark baseline to " << settings.baseline.string() << "\n";
+      return 2;
+    }
+    println("baseline updated : {}" , settings.baseline.string());
+    return 0;
+  }
+
+  /// no baseline fails the gate , a build configuration nobody recorded is not a passing one
+  Opt<std::vector<BenchmarkResult>> baseline = ReadBenchmarkResults(settings.baseline);
+  if (!baseline.has_value()) {
+    println("no {} baseline at {} , run with --update-baseline to record one" , BenchmarkBuildName() ,
+            settings.baseline.string());
+    Report(CompareBenchmarks({} , results , settings.threshold) , {} , settings.threshold);
+    return 1;
+  }
+
+  return Report(CompareBenchmarks(baseline.value() , results , settings.threshold) ,
+                MissingBaselineEntries(baseline.value() , SelectedBenchmarks(settings)) , settings.threshold);
+}
@@ -0,0 +1,48 @@
+/**
+ * \file bench/scenarios/buffer_benchmarks.cpp
+ **/
+#include "bench.hpp"
+
+#include <glm/glm.hpp>
+
+#include "core/buffer.hpp"
+#include "core/instance_buffer.hpp"
+
+namespace other {
+namespace {
+
+  constexpr uint32_t kNumAppends = 1'000'000;
+
+} // anonymous namespace
+
+  /// one transform at a time into an untyped buffer , every append records its own element offset
+  OE_BENCHMARK(BufferAppend , "buffer.append") {
+    Buffer buffer;
+
+    run.SetItems(kNumAppends);
+    run.Measure([&]() {
+      buffer.Release();
+    } , [&]() {
+      for (uint32_t i = 0; i < kNumAppends; ++i) {
+        buffer.BufferData(glm::mat4(static_cast<float>(i)));
+      }
+    });
+
+    buffer.Release();
+  }
+
+  /// the per frame instance path , storage is kept between iterations the way it is kept between frames
+  OE_BENCHMARK(InstanceBufferAppend , "instance_buffer.append") {
+    InstanceBuffer<glm::mat4> buffer;
+
+    run.SetItems(kNumAppends);
+    run.Measure([&]() {
+      buffer.Clear();
+    } , [&]() {
+      for (uint32_t i = 0; i < kNumAppends; ++i) {
+        buffer.Append(glm::mat4(static_cast<float>(i)));
+      }
+    });
+  }
+
+} // namespace other
@@ -0,0 +1,96 @@
+/**
+ * \file bench/scenarios/bvh_benchmarks.cpp
+ **/
+#include "bench.hpp"
+
+#include <random>
+
+#include "core/logger.hpp"
+#include "core/ref.hpp"
+
+#include "ecs/entity.hpp"
+#include "ecs/components/transform.hpp"
+
+#include "scene/bvh.hpp"
+#include "scene/scene.hpp"
+
+namespace other {
+namespace {
+
+  constexpr uint32_t kNumEntities = 1000;
+  constexpr uint32_t kNumQueries = 4096;
+
+  Ref<Scene> ScatteredScene() {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> coord(-100.f , 100.f);
+    std::uniform_real_distribution<float> scale(0.5f , 4.f);
+
+    Ref<Scene> scene = NewRef<Scene>();
+    for (uint32_t i = 0; i < kNumEntities; ++i) {
+      auto& transform = scene->CreateEntity(fmtstr("bvh-{}" , i))->GetComponent<Transform>();
+      transform.position = { coord(rng) , coord(rng) , coord(rng) };
+      transform.scale = glm::vec3{ scale(rng) };
+    }
+    return scene;
+  }
+
+  /// entities in every leaf whose bounds hold the point , the bvh only descends into children that contain it
+  size_t QueryPoint(const BvhNode<2>& node , const glm::vec3& point) {
+    if (!node.Contains(point)) {
+      return 0;
+    }
+
+    if (node.IsLeaf()) {
+      return node.entities.size();
+    }
+
+    size_t found = 0;
+    for (const BvhNode<2>* child : node.Children()) {
+      if (child != nullptr) {
+        found += QueryPoint(*child , point);
+      }
+    }
+    return found;
+  }
+
+} // anonymous namespace
+
+  OE_BENCHMARK(BvhBuild , "bvh.build") {
+    Ref<Scene> scene = ScatteredScene();
+    Ref<BvhTree> bvh = nullptr;
+
+    run.SetItems(kNumEntities);
+    run.Measure([&]() {
+      bvh = NewRef<BvhTree>(glm::vec3{ 0.f });
+    } , [&]() {
+      bvh->AddScene(scene , glm::vec3{ 0.f });
+    });
+  }
+
+  /// point queries , ray intersection is not implemented by the bvh yet and would only measure a stub
+  OE_BENCHMARK(BvhQuery , "bvh.query") {
+    Ref<Scene> scene = ScatteredScene();
+    Ref<BvhTree> bvh = NewRef<BvhTree>(glm::vec3{ 0.f });
+    bvh->AddScene(scene , glm::vec3{ 0.f });
+
+    std::mt19937 rng(6);
+    std::uniform_real_distribution<float> coord(-100.f , 100.f);
+    std::vector<glm::vec3> points;
+    points.reserve(kNumQueries);
+    for (uint32_t i = 0; i < kNumQueries; ++i) {
+      points.push_back({ coord(rng) , coord(rng) , coord(rng) });
+    }
+
+    size_t found = 0;
+    run.SetItems(kNumQueries);
+    run.Measure([&]() {
+      found = 0;
+      for (const auto& point : points) {
+        found += QueryPoint(bvh->GetSpace() , point);
+      }
+    });
+
+    OE_DEBUG("bvh.query : {} entities under {} points" , found , kNumQueries);
+  }
+
+} // namespace other
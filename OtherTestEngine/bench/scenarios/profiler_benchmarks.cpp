@@ -0,0 +1,59 @@
+/**
+ * \file bench/scenarios/profiler_benchmarks.cpp
+ **/
+#include "bench.hpp"
+
+#include "core/frame_profiler.hpp"
+#include "core/profile.hpp"
+
+namespace other {
+namespace {
+
+  /// a ring's worth of scopes per iteration , the drain in between is the main thread's cost and is not timed
+  constexpr uint32_t kNumScopes = ProfileRing::kCapacity / 2;
+
+  /// the most a recorded scope may cost , both timestamps and the ring write
+  constexpr double kScopeBudgetNs = 50.0;
+
+  /// switched off scopes never reach the ring , more of them keep the sample above timer noise
+  constexpr uint32_t kDisabledRounds = 64;
+
+  void RecordScopes() {
+    for (uint32_t i = 0; i < kNumScopes; ++i) {
+      OE_PROFILE_SCOPE("bench.profiler.scope");
+    }
+  }
+
+} // anonymous namespace
+
+  /// what every OE_PROFILE_SCOPE in the engine costs the thread it runs on
+  OE_BENCHMARK(ProfilerScope , "profiler.scope") {
+    const bool was_enabled = FrameProfiler::Enabled();
+    FrameProfiler::SetEnabled(true);
+
+    run.SetItems(kNumScopes);
+    run.SetBudget(kScopeBudgetNs);
+    run.Measure([]() {
+      FrameProfiler::EndFrame();
+    } , RecordScopes);
+
+    FrameProfiler::SetEnabled(was_enabled);
+    FrameProfiler::EndFrame();
+  }
+
+  /// the cost left in shipped scopes when the profiler is switched off at runtime
+  OE_BENCHMARK(ProfilerScopeDisabled , "profiler.scope_disabled") {
+    const bool was_enabled = FrameProfiler::Enabled();
+    FrameProfiler::SetEnabled(false);
+
+    run.SetItems(kNumScopes * kDisabledRounds);
+    run.Measure([]() {
+      for (uint32_t i = 0; i < kDisabledRounds; ++i) {
+        RecordScopes();
+      }
+    });
+
+    FrameProfiler::SetEnabled(was_enabled);
+  }
+
+} // namespace other
@@ -0,0 +1,45 @@
+/**
+ * \file bench/scenarios/reflection_benchmarks.cpp
+ **/
+#include "bench.hpp"
+
+#include <refl/refl.hpp>
+
+#include "reflection/type_database.hpp"
+
+namespace other {
+namespace {
+
+  constexpr uint32_t kNumLookups = 1'000'000;
+
+  struct BenchTransform {
+    float x , y , z;
+  };
+
+  struct BenchRigidBody {
+    float mass;
+    float drag;
+  };
+
+} // anonymous namespace
+} // namespace other
+
+REFL_AUTO(type(other::BenchTransform) , field(x) , field(y) , field(z));
+REFL_AUTO(type(other::BenchRigidBody) , field(mass) , field(drag));
+
+namespace other {
+
+  /// what the scripting bridge and the serializers pay every time they ask for a type's fields
+  OE_BENCHMARK(ReflectionTypeLookup , "reflection.type_lookup") {
+    dotother::echo::TypeDatabase& db = dotother::echo::TypeDatabase::Instance();
+
+    volatile size_t fields = 0;
+    run.SetItems(kNumLookups);
+    run.Measure([&]() {
+      for (uint32_t i = 0; i < kNumLookups; ++i) {
+        fields = fields + ((i & 1) == 0 ? db.Get<BenchTransform>().fields.size() : db.Get<BenchRigidBody>().fields.size());
+      }
+    });
+  }
+
+} // namespace other
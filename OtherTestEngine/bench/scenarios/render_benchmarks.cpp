@@ -0,0 +1,86 @@
+/**
+ * \file bench/scenarios/render_benchmarks.cpp
+ **/
+#include "bench.hpp"
+
+#include <random>
+#include <span>
+
+#include <entt/entt.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "ecs/components/mesh.hpp"
+#include "ecs/components/transform.hpp"
+
+#include "rendering/draw_list.hpp"
+#include "rendering/render_commands.hpp"
+#include "rendering/rendering_defines.hpp"
+
+namespace other {
+namespace {
+
+  constexpr uint32_t kNumMeshes = 50000;
+  constexpr uint32_t kNumModels = 64;
+
+  /// every handle resolves to a unit cube , no asset handler or gpu is involved
+  Opt<DrawModel> ResolveCube(AssetHandle handle) {
+    return DrawModel{
+      .bounds_min = glm::vec3{ -0.5f } ,
+      .bounds_max = glm::vec3{ 0.5f } ,
+    };
+  }
+
+} // anonymous namespace
+
+  /// draw list build and command recording for one frame , executed against the null backend
+  OE_BENCHMARK(RenderSubmission , "render.submission") {
+    entt::registry registry;
+    auto group = registry.group<StaticMesh>(entt::get<Transform> , entt::exclude<NullComponent>);
+
+    std::mt19937 rng(4);
+    std::uniform_real_distribution<float> lateral(-300.f , 300.f);
+    std::uniform_real_distribution<float> depth(-450.f , 20.f);
+    for (uint32_t i = 0; i < kNumMeshes; ++i) {
+      entt::entity entity = registry.create();
+      registry.emplace<StaticMesh>(entity).handle = 1 + rng() % kNumModels;
+      registry.emplace<Transform>(entity , glm::vec3{ lateral(rng) , lateral(rng) * 0.5f , depth(rng) }).CalcMatrix();
+    }
+
+    const DrawView view{
+      .view = glm::lookAt(glm::vec3{ 0.f } , glm::vec3{ 0.f , 0.f , -1.f } , glm::vec3{ 0.f , 1.f , 0.f }) ,
+      .projection = glm::perspective(glm::radians(90.f) , 16.f / 9.f , 0.1f , 500.f) ,
+    };
+
+    DrawList list;
+    RenderCommandBuffer commands;
+    NullRenderBackend backend;
+
+    run.SetItems(kNumMeshes);
+    run.Measure([&]() {
+      list.Build<StaticMesh>(group , ResolveCube , view);
+
+      commands.Reset();
+      uint32_t base_instance = 0;
+      list.ForEachRun([&](uint32_t model , std::span<const DrawItem> items) {
+        const uint32_t count = static_cast<uint32_t>(items.size());
+        commands.Record(BindStorageRangeCmd{
+          .binding_point = 1 ,
+          .buffer = 1 ,
+          .offset = base_instance * sizeof(glm::mat4) ,
+          .size = count * sizeof(glm::mat4) ,
+        });
+        commands.Record(BindVertexArrayCmd{ .vertex_array = model + 1 });
+        commands.Record(DrawIndexedCmd{
+          .mode = TRIANGLES ,
+          .num_elements = 36 ,
+          .instance_count = count ,
+          .base_instance = base_instance ,
+        });
+        base_instance += count;
+      });
+
+      backend.Execute(commands);
+    });
+  }
+
+} // namespace other
@@ -0,0 +1,207 @@
+/**
+ * \file bench/scenarios/scene_benchmarks.cpp
+ **/
+#include "bench.hpp"
+
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "core/ref.hpp"
+
+#include "ecs/entity.hpp"
+#include "ecs/components/relationship.hpp"
+#include "ecs/components/transform.hpp"
+
+#include "scene/scene.hpp"
+#include "scene/scene_serializer.hpp"
+
+#include "scripting/script_engine.hpp"
+
+namespace other {
+namespace {
+
+  /// scene create entity is linear in the entity count , this keeps spawn from dwarfing everything else
+  constexpr uint32_t kNumEntities = 2000;
+
+  /// propagation hierarchy , kNumRoots trees of kFanout children per node
+  constexpr uint32_t kNumRoots = 16;
+  constexpr uint32_t kFanout = 4;
+  constexpr uint32_t kDepth = 4;
+
+  constexpr uint32_t kNumUpdateFrames = 60;
+  constexpr float kFrameMs = 16.f;
+
+  glm::vec3 RandomPosition(std::mt19937& rng) {
+    std::uniform_real_distribution<float> coord(-100.f , 100.f);
+    return { coord(rng) , coord(rng) , coord(rng) };
+  }
+
+  Ref<Scene> SpawnScene(uint32_t count) {
+    std::mt19937 rng(1);
+    Ref<Scene> scene = NewRef<Scene>();
+    for (uint32_t i = 0; i < count; ++i) {
+      Entity* ent = scene->CreateEntity(fmtstr("entity-{}" , i));
+      ent->GetComponent<Transform>().position = RandomPosition(rng);
+    }
+    return scene;
+  }
+
+  /// children of parent down to depth , returns how many entities were created
+  uint32_t SpawnSubtree(Ref<Scene>& scene , UUID parent , uint32_t depth , uint32_t& next , std::mt19937& rng) {
+    if (depth == 0) {
+      return 0;
+    }
+
+    uint32_t spawned = 0;
+    for (uint32_t i = 0; i < kFanout; ++i) {
+      Entity* child = scene->CreateEntity(fmtstr("node-{}" , next++));
+      auto& transform = child->GetComponent<Transform>();
+      transform.position = RandomPosition(rng) * 0.1f;
+      transform.erotation = glm::vec3{ 0.f , 0.1f * static_cast<float>(i) , 0.f };
+
+      const UUID id = child->ReadComponent<Tag>().id;
+      scene->ParentEntity(id , parent);
+      spawned += 1 + SpawnSubtree(scene , id , depth - 1 , next , rng);
+    }
+    return spawned;
+  }
+
+  void Propagate(Scene& scene , Entity* entity , const glm::mat4& parent_world) {
+    auto& transform = entity->GetComponent<Transform>();
+    transform.model_transform = parent_world * transform.CalcMatrix();
+
+    const glm::mat4 world = transform.model_transform;
+    for (const UUID& child : entity->ReadComponent<Relationship>().children) {
+      Propagate(scene , scene.GetEntity(child) , world);
+    }
+  }
+
+  /// the same text the serializer writes , entities with a transform and nothing else
+  std::string GenerateSceneFile(uint32_t count) {
+    std::mt19937 rng(2);
+    std::stringstream stream;
+
+    stream << "[metadata]\n";
+    stream << "name = \"Benchmark Scene\"\n";
+    stream << "entities = {\n";
+    for (uint32_t i = 0; i < count; ++i) {
+      stream << "  \"entity-" << i << "\"" << (i + 1 < count ? " ,\n" : "\n");
+    }
+    stream << "}\n\n";
+
+    stream << "[physics.2D]\n";
+    stream << "gravity = { 0 , -9.8 }\n\n";
+    stream << "[physics.3D]\n\n";
+
+    for (uint32_t i = 0; i < count; ++i) {
+      const glm::vec3 p = RandomPosition(rng);
+      stream << "[entity-" << i << "]\n";
+      stream << "UUID = " << FNV(fmtstr("entity-{}" , i)) << "\n\n";
+      stream << "[entity-" << i << ".transform]\n";
+      stream << fmtstr("position = {{ {} , {} , {} }}\n" , p.x , p.y , p.z);
+      stream << "rotation = { 0 , 0 , 0 , 0 }\n";
+      stream << "scale = { 1 , 1 , 1 }\n\n";
+    }
+
+    return stream.str();
+  }
+
+  Path WriteSceneFile(uint32_t count) {
+    const Path path = std::filesystem::temp_directory_path() / "other_bench_scene.yscn";
+    std::ofstream file(path , std::ios::out | std::ios::trunc);
+    file << GenerateSceneFile(count);
+    return path;
+  }
+
+} // anonymous namespace
+
+  OE_BENCHMARK(EntitySpawn , "scene.entity_spawn") {
+    run.SetItems(kNumEntities);
+
+    Ref<Scene> scene = nullptr;
+    run.Measure([&]() {
+      scene = nullptr;
+    } , [&]() {
+      scene = SpawnScene(kNumEntities);
+    });
+  }
+
+  OE_BENCHMARK(SceneUpdate , "scene.update") {
+    /// every scene update calls into the managed scene object
+    if (ScriptEngine::GetModule(LanguageModuleType::CS_MODULE) == nullptr) {
+      run.Skip("scene update needs the C# script host");
+      return;
+    }
+
+    Ref<Scene> scene = SpawnScene(kNumEntities);
+    scene->Initialize();
+    scene->Start(EngineMode::RUNTIME);
+
+    run.SetItems(kNumUpdateFrames);
+    run.Measure([&]() {
+      for (uint32_t f = 0; f < kNumUpdateFrames; ++f) {
+        scene->EarlyUpdate(kFrameMs);
+        scene->Update(kFrameMs);
+        scene->LateUpdate(kFrameMs);
+      }
+    });
+
+    scene->Stop();
+    scene->Shutdown();
+  }
+
+  OE_BENCHMARK(TransformPropagation , "scene.transform_propagation") {
+    std::mt19937 rng(3);
+    Ref<Scene> scene = NewRef<Scene>();
+
+    uint32_t next = 0;
+    uint32_t count = 0;
+    for (uint32_t r = 0; r < kNumRoots; ++r) {
+      Entity* root = scene->CreateEntity(fmtstr("root-{}" , r));
+      root->GetComponent<Transform>().position = RandomPosition(rng);
+      count += 1 + SpawnSubtree(scene , root->ReadComponent<Tag>().id , kDepth , next , rng);
+    }
+
+    run.SetItems(count);
+    run.Measure([&]() {
+      for (const auto& [id , root] : scene->RootEntities()) {
+        Propagate(*scene , root , glm::mat4(1.f));
+      }
+    });
+  }
+
+  OE_BENCHMARK(SceneLoad , "scene.load") {
+    const Path path = WriteSceneFile(kNumEntities);
+    SceneSerializer serializer;
+
+    run.SetItems(kNumEntities);
+    run.Measure([&]() {
+      DeserializedScene loaded = serializer.Deserialize(path.string());
+      if (loaded.scene == nullptr) {
+        run.Skip("generated scene failed to load");
+      }
+    });
+
+    std::filesystem::remove(path);
+  }
+
+  OE_BENCHMARK(SceneSave , "scene.save") {
+    const Path path = WriteSceneFile(kNumEntities);
+    SceneSerializer serializer;
+    DeserializedScene loaded = serializer.Deserialize(path.string());
+    std::filesystem::remove(path);
+
+    if (loaded.scene == nullptr) {
+      run.Skip("generated scene failed to load");
+      return;
+    }
+
+    run.SetItems(kNumEntities);
+    run.Measure([&]() {
+      std::stringstream stream;
+      serializer.Serialize(loaded.name , stream , loaded.scene);
+    });
+  }
+
+} // namespace other
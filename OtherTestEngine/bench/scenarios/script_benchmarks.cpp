@@ -0,0 +1,97 @@
+/**
+ * \file bench/scenarios/script_benchmarks.cpp
+ **/
+#include "bench.hpp"
+
+#include "core/logger.hpp"
+#include "core/ref.hpp"
+
+#include "scripting/lua/lua_module.hpp"
+#include "scripting/lua/lua_object.hpp"
+
+namespace other {
+namespace {
+
+  constexpr uint32_t kNumCalls = 10000;
+
+  /// the script engine default when SCRIPT-ENGINE.LUA GC-BUDGET-US is not set
+  constexpr uint32_t kGcBudgetUs = 500;
+
+} // anonymous namespace
+
+  /// native to lua Update calls on one object , the script body is trivial so this is the dispatch cost
+  OE_BENCHMARK(LuaDispatch , "script.lua_dispatch") {
+    Ref<LuaModule> lua = NewRef<LuaModule>();
+    if (!lua->Initialize()) {
+      run.Skip("lua module failed to initialize");
+      return;
+    }
+
+    const Path script_path = Filesystem::GetEngineCoreDir() / "OtherTestEngine" / "bench" / "scripts" / "dispatch.lua";
+    Ref<ScriptModule> script = lua->LoadScriptModule({
+      .name = "BenchDispatch" ,
+      .path = script_path.string() ,
+    });
+
+    Ref<LuaObject> obj = script == nullptr ?
+      nullptr : script->GetScriptObject<LuaObject>("BenchDispatch");
+    if (obj == nullptr) {
+      run.Skip("failed to load bench dispatch script");
+      lua->Shutdown();
+      return;
+    }
+
+    run.SetItems(kNumCalls);
+    run.Measure([&]() {
+      for (uint32_t i = 0; i < kNumCalls; ++i) {
+        obj->Update(0.016f);
+      }
+    });
+
+    obj = nullptr;
+    script = nullptr;
+    lua->Shutdown();
+  }
+
+  /// one frame's budgeted gc step under an allocating script , the script's own update runs outside the clock
+  OE_BENCHMARK(LuaGcStep , "script.lua_gc_step") {
+    Ref<LuaModule> lua = NewRef<LuaModule>();
+    if (!lua->Initialize()) {
+      run.Skip("lua module failed to initialize");
+      return;
+    }
+    lua->SetGcBudget(kGcBudgetUs);
+
+    const Path script_path = Filesystem::GetEngineCoreDir() / "OtherTestEngine" / "bench" / "scripts" / "gc_stress.lua";
+    Ref<ScriptModule> script = lua->LoadScriptModule({
+      .name = "BenchGcStress" ,
+      .path = script_path.string() ,
+    });
+
+    Ref<LuaObject> obj = script == nullptr ?
+      nullptr : script->GetScriptObject<LuaObject>("BenchGcStress");
+    if (obj == nullptr) {
+      run.Skip("failed to load bench gc stress script");
+      lua->Shutdown();
+      return;
+    }
+
+    run.SetItems(1);
+    run.Measure([&]() {
+      obj->Update(0.016f);
+    } , [&]() {
+      lua->StepGarbageCollector();
+    });
+
+    /// the pause distribution over the last frames , the tail is what shows up as a hitch
+    const LuaGcStats& stats = lua->GetGcStats();
+    println("  {:<32} p50 {:.1f}us | p99 {:.1f}us | max {:.1f}us | budget {}us | cycles {} | full {} | heap {}KB" ,
+            "script.lua_gc_step pauses" , lua->GcPausePercentile(0.5f) , lua->GcPausePercentile(0.99f) , stats.max_pause_us ,
+            kGcBudgetUs , stats.cycles , stats.full_collections , stats.heap_kb);
+
+    obj = nullptr;
+    script = nullptr;
+    lua->Shutdown();
+  }
+
+} // namespace other
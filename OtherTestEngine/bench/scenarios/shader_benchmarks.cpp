@@ -0,0 +1,47 @@
+/**
+ * \file bench/scenarios/shader_benchmarks.cpp
+ **/
+#include "bench.hpp"
+
+#include <algorithm>
+
+#include "core/logger.hpp"
+
+#include "parsing/shader_compiler.hpp"
+
+namespace other {
+
+  /// every engine shader from source to glsl on one thread without the cache , nothing touches the gpu
+  OE_BENCHMARK(ShaderCompile , "shader.compile") {
+    const Path shader_dir = Filesystem::GetEngineCoreDir() / "OtherEngine" / "assets" / "shaders";
+
+    /// shaders that fail are reported once here and left out so they do not count as fast compiles
+    std::vector<Path> shaders;
+    for (const auto& file : Filesystem::GetDirectoryFiles(shader_dir)) {
+      if (file.extension() != ".oshader") {
+        continue;
+      }
+
+      try {
+        ShaderCompiler::Compile(file);
+        shaders.push_back(file);
+      } catch (const std::exception& e) {
+        OE_WARN("Benchmark skipping shader {} : {}" , file.string() , e.what());
+      }
+    }
+
+    if (shaders.empty()) {
+      run.Skip(fmtstr("no shaders compiled from {}" , shader_dir.string()));
+      return;
+    }
+    std::ranges::sort(shaders);
+
+    run.SetItems(shaders.size());
+    run.Measure([&]() {
+      for (const auto& shader : shaders) {
+        ShaderCompiler::Compile(shader);
+      }
+    });
+  }
+
+} // namespace other
@@ -0,0 +1,72 @@
+/**
+ * \file bench/scenarios/stable_vector_benchmarks.cpp
+ **/
+#include "bench.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "core/stable_vector.hpp"
+
+namespace other {
+namespace {
+
+  constexpr uint32_t kNumAppends = 1'000'000;
+  constexpr uint32_t kNumWriters = 4;
+
+} // anonymous namespace
+
+  /// single writer path the bvh builds its nodes through
+  OE_BENCHMARK(StableVectorAppend , "stable_vector.append") {
+    dotother::StableVector<glm::mat4> vec;
+
+    run.SetItems(kNumAppends);
+    run.Measure([&]() {
+      vec.Clear();
+    } , [&]() {
+      for (uint32_t i = 0; i < kNumAppends; ++i) {
+        vec.EmplaceNoLock(static_cast<float>(i));
+      }
+    });
+  }
+
+  /// several writers appending at once , every append reserves and publishes atomically
+  OE_BENCHMARK(StableVectorConcurrentInsert , "stable_vector.concurrent_insert") {
+    dotother::StableVector<glm::mat4> vec;
+
+    run.SetItems(kNumAppends);
+    run.Measure([&]() {
+      vec.Clear();
+    } , [&]() {
+      std::vector<std::thread> writers;
+      for (uint32_t w = 0; w < kNumWriters; ++w) {
+        writers.emplace_back([&vec]() {
+          for (uint32_t i = 0; i < kNumAppends / kNumWriters; ++i) {
+            vec.Emplace(static_cast<float>(i));
+          }
+        });
+      }
+
+      for (auto& writer : writers) {
+        writer.join();
+      }
+    });
+  }
+
+  OE_BENCHMARK(StableVectorParallelForEach , "stable_vector.parallel_for_each") {
+    dotother::StableVector<glm::mat4> vec;
+    for (uint32_t i = 0; i < kNumAppends; ++i) {
+      vec.EmplaceNoLock(static_cast<float>(i));
+    }
+
+    run.SetItems(kNumAppends);
+    run.Measure([&]() {
+      vec.ParallelForEach([](glm::mat4& m) {
+        m = m * 1.0001f;
+      });
+    });
+  }
+
+} // namespace other
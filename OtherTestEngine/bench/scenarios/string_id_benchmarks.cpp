@@ -0,0 +1,79 @@
+/**
+ * \file bench/scenarios/string_id_benchmarks.cpp
+ **/
+#include "bench.hpp"
+
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "core/string_id.hpp"
+#include "core/uuid.hpp"
+
+namespace other {
+namespace {
+
+  constexpr uint32_t kNumLookups = 1'000'000;
+
+  /// keeps the lookups from being optimized out
+  volatile uint32_t sink = 0;
+
+  constexpr std::string_view kNames[] = { "Geometry" , "Debug" , "Shadow" , "Lighting" , "Composite" , "Outline" };
+  constexpr StringId kIds[] = { "Geometry" , "Debug" , "Shadow" , "Lighting" , "Composite" , "Outline" };
+  constexpr uint32_t kNumNames = std::size(kNames);
+
+  /// the shape of the renderer's pass and pipeline maps
+  std::map<UUID , uint32_t> BuildMap() {
+    std::map<UUID , uint32_t> map;
+    for (uint32_t i = 0; i < kNumNames; ++i) {
+      map[FNV(kNames[i])] = i;
+    }
+    return map;
+  }
+
+} // anonymous namespace
+
+  /// what SetUniform and SubmitStaticModel did before , hash the name on every call
+  OE_BENCHMARK(StringIdRuntimeHashLookup , "string_id.runtime_hash_lookup") {
+    const std::map<UUID , uint32_t> map = BuildMap();
+
+    run.SetItems(kNumLookups);
+    run.Measure([&]() {
+      uint32_t found = 0;
+      for (uint32_t i = 0; i < kNumLookups; ++i) {
+        found += map.find(FNV(kNames[i % kNumNames]))->second;
+      }
+      sink = found;
+    });
+  }
+
+  OE_BENCHMARK(StringIdLookup , "string_id.lookup") {
+    const std::map<UUID , uint32_t> map = BuildMap();
+
+    run.SetItems(kNumLookups);
+    run.Measure([&]() {
+      uint32_t found = 0;
+      for (uint32_t i = 0; i < kNumLookups; ++i) {
+        found += map.find(kIds[i % kNumNames].Hash())->second;
+      }
+      sink = found;
+    });
+  }
+
+  /// interning a string that is already in the table , only the shared lock is taken
+  OE_BENCHMARK(StringIdIntern , "string_id.intern") {
+    const std::string name = "string_id.bench.intern";
+    StringInterner::Intern(name);
+
+    run.SetItems(kNumLookups);
+    run.Measure([&]() {
+      uint32_t length = 0;
+      for (uint32_t i = 0; i < kNumLookups; ++i) {
+        length += static_cast<uint32_t>(StringInterner::Intern(name).Str().size());
+      }
+      sink = length;
+    });
+  }
+
+} // namespace other
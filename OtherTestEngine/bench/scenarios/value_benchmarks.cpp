@@ -0,0 +1,89 @@
+/**
+ * \file bench/scenarios/value_benchmarks.cpp
+ **/
+#include "bench.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "core/value.hpp"
+
+namespace other {
+namespace {
+
+  constexpr uint32_t kNumValues = 1'000'000;
+
+  /// keeps the reads from being optimized out
+  volatile float sink = 0.f;
+
+} // anonymous namespace
+
+  /// what the editor does to every float script field each frame
+  OE_BENCHMARK(ValueScalarSetGet , "value.scalar_set_get") {
+    std::vector<Value> values(kNumValues);
+
+    run.SetItems(kNumValues);
+    run.Measure([&]() {
+      float sum = 0.f;
+      for (uint32_t i = 0; i < kNumValues; ++i) {
+        values[i].Set(static_cast<float>(i));
+        sum += values[i].Get<float>();
+      }
+      sink = sum;
+    });
+  }
+
+  /// copying script fields between script instances , vec3 stays inline
+  OE_BENCHMARK(ValueCopy , "value.copy") {
+    std::vector<Value> values(kNumValues);
+    for (uint32_t i = 0; i < kNumValues; ++i) {
+      values[i].Set(glm::vec3(static_cast<float>(i)));
+    }
+
+    std::vector<Value> copies(kNumValues);
+
+    run.SetItems(kNumValues);
+    run.Measure([&]() {
+      for (uint32_t i = 0; i < kNumValues; ++i) {
+        copies[i] = values[i];
+      }
+      sink = copies.back().Read<glm::vec3>().x;
+    });
+  }
+
+  OE_BENCHMARK(ValueString , "value.string") {
+    std::vector<Value> values(kNumValues);
+    const std::string name = "player_name";
+
+    run.SetItems(kNumValues);
+    run.Measure([&]() {
+      for (uint32_t i = 0; i < kNumValues; ++i) {
+        values[i].Set<std::string>(name);
+      }
+      sink = static_cast<float>(values.back().Size());
+    });
+  }
+
+  /// 32 floats do not fit inline , after the first iteration every Set reuses the value's allocation
+  OE_BENCHMARK(ValueArray , "value.array") {
+    constexpr uint32_t kNumArrays = kNumValues / 10;
+
+    std::vector<Value> values(kNumArrays);
+    std::array<float , 32> floats{};
+
+    run.SetItems(kNumArrays);
+    run.Measure([&]() {
+      float sum = 0.f;
+      for (uint32_t i = 0; i < kNumArrays; ++i) {
+        floats[0] = static_cast<float>(i);
+        values[i].Set<float>(floats);
+        sum += values[i].At<float>(0);
+      }
+      sink = sum;
+    });
+  }
+
+} // namespace other
@@ -0,0 +1,12 @@
+local object = require("other.object")
+
+BenchDispatch = object:new()
+
+local elapsed = 0
+local ticks = 0
+
+--- as little work as possible so the benchmark measures the call and not the script
+function BenchDispatch.Update(dt)
+  elapsed = elapsed + dt
+  ticks = ticks + 1
+end
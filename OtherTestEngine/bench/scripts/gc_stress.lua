@@ -0,0 +1,15 @@
+local object = require("other.object")
+
+BenchGcStress = object:new()
+
+local retained = {}
+
+--- a frame's worth of short lived tables , a few frames stay alive so the collector has something to trace
+function BenchGcStress.Update(dt)
+  local garbage = {}
+  for i = 1, 2000 do
+    garbage[i] = { x = i , y = i * 2 , name = "node" .. i }
+  end
+
+  retained[#retained % 8 + 1] = garbage
+end
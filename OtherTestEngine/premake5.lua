@@ -52,5 +52,47 @@ local OtherTestEngine = {
 }
 
 
+local OtherBench = {
+  name = "OtherBench",
+  path = "./OtherTestEngine",
+  kind = "ConsoleApp",
+  language = "C++",
+  cppdialect = "C++latest",
+  
+  files = function()
+    files {
+      "./bench/**.cpp",
+      "./bench/**.hpp",
+    }
+  end,
+  
+  include_dirs = function()
+    includedirs {
+      "./bench",
+    }
+    externalincludedirs{
+      "%{wks.location}/DotOther/NetCore",
+      "%{wks.location}/externals/json/include",
+    }
+  end,
+  
+  defines = function()
+    defines {
+      "OE_MODULE" ,
+    }
+  end,
+  
+  windows_configuration = function()
+    systemversion "latest"
+    buildoptions { "/EHsc" , "/Zc:preprocessor" , "/Zc:__cplusplus" }
+  end,
+  
+  components = {
+    ["OtherEngine"] = "%{wks.location}/OtherEngine/src",
+  },
+
+}
+
 
 AddProject(OtherTestEngine)
+AddProject(OtherBench)
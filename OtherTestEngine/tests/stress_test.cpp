@@ -70,11 +70,8 @@ class StressTest : public other::EngineTest {
 };
 
 /**
- * Debug Mode (50,000 cubes)
- *  FPS = 10 :(
- *
- * Release Mode (50,000 cubes)
- *  FPS = 60 :)
+ * interactive soak test , the numbers that are tracked over time come from the OtherBench scenarios and their
+ *   baselines in OtherTestEngine/bench
  **/
 TEST_F(StressTest , lots_o_cubes) {
   auto renderer = TEST_ENGINE_ENV()->GetDefaultSceneRenderer(num_cubes);
@@ -9,25 +9,19 @@ tracy.files = function()
   files {
     "./tracy/client/**.h" ,
     "./tracy/client/**.hpp" ,
-    "./tracy/client/**.cpp" ,
-
     "./tracy/common/**.h" ,
     "./tracy/common/**.hpp" ,
-    "./tracy/common/**.cpp" ,
-
     "./tracy/tracy/**.h" ,
     "./tracy/tracy/**.hpp" ,
-    "./tracy/tracy/**.cpp" ,
 
-    "./tracy/libbacktrace/alloc.cpp" ,
-    "./tracy/libbacktrace/sort.cpp" ,
-    "./tracy/libbacktrace/state.cpp" ,
+    -- the unity source includes every client and common source file
+    "./tracy/TracyClient.cpp" ,
   }
 end
 
 tracy.include_dirs = function()
   includedirs {
-    "./tracy/public" ,
+    "./tracy" ,
   }
 end
 
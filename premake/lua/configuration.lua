@@ -16,7 +16,7 @@ local function ProcessWindowsConfigurations(config)
       defines { "NOMINMAX" }
     end
 
-  filter { "system:windows" , "configurations:Release" }
+  filter { "system:windows" , "configurations:Release or Profile" }
     if config.windows_release_configuration ~= nil then
       config.windows_release_configuration()
     else
@@ -39,7 +39,7 @@ local function ProcessLinuxConfigurations(config)
       print(" -- Default linux debug configuration")
     end
 
-  filter { "system:linux" , "configurations:Release" }
+  filter { "system:linux" , "configurations:Release or Profile" }
     if config.linux_release_configuration ~= nil then
       config.linux_release_configuration()
     else
@@ -83,6 +83,16 @@ local function ProcessConfigurations(config)
       end
   end
 
+  if ContainsValue(config.build_configurations , "Profile") then
+    filter "configurations:Profile"
+      if config.release_configuration ~= nil then
+        config.release_configuration()
+      else
+        optimize "On"
+        symbols "On"
+      end
+  end
+
   ProcessSystemConfigurations(config)
 end
 
@@ -53,9 +53,7 @@ function ProcessDependency(configuration , lib_data)
   local target = FirstToUpper(os.target())
 
   if configuration ~= nil and lib_data.configurations ~= nil then
-    if Contains(lib_data.configurations, configuration) then
-      matches_config = true
-    end
+    matches_config = ContainsValue(lib_data.configurations, configuration)
   end
 
   local is_debug = configuration == "Debug"
@@ -53,6 +53,10 @@ local function ProcessWindowsFilters()
     postbuildcommands {
       '{COPY} "%{wks.location}externals/sdl2/lib/Release/SDL2.dll" "%{cfg.targetdir}"',
     }
+  filter { "configurations:Profile" }
+    postbuildcommands {
+      '{COPY} "%{wks.location}externals/sdl2/lib/Release/SDL2.dll" "%{cfg.targetdir}"',
+    }
   filter { "configurations:Debug" }
     postbuildcommands {
       '{COPY} "%{wks.location}externals/sdl2/lib/Debug/SDL2d.dll" "%{cfg.targetdir}"',
@@ -118,6 +122,11 @@ local function ProcessConfigurations(project , external)
         project.windows_release_configuration()
       end
 
+    filter { "system:windows", "configurations:Profile" }
+      if project.windows_release_configuration ~= nil then
+        project.windows_release_configuration()
+      end
+
     filter "system:linux"
       if project.linux_configuration ~= nil then
         project.linux_configuration()
@@ -159,6 +168,24 @@ local function ProcessConfigurations(project , external)
           project.extra_dependencies("Release")
         end
       end
+
+    -- release build with tracy linked in and the OE_PROFILE_* hooks turned on
+    filter "configurations:Profile"
+      defines { "OE_RELEASE_BUILD" , "OE_PROFILE_BUILD" , "TRACY_ENABLE" , "TRACY_ON_DEMAND" }
+      if project.release_configuration ~= nil then
+        project.release_configuration()
+      else
+        runtime "Release"
+        optimize "Full"
+        symbols "On"
+      end
+
+      if not external and project.language == "C++" then
+        ProcessDependencies("Profile")
+        if project.extra_dependencies ~= nil then
+          project.extra_dependencies("Profile")
+        end
+      end
 end
 
 local function VerifyProject(project)
@@ -93,16 +93,19 @@ local unit_tests = {
   files = function()
     files {
       "./unit_tests/**.cpp" ,
+      "%{wks.location}/OtherTestEngine/bench/bench.cpp" ,
     }
   end,
   
   include_dirs = function()
     includedirs {
       "." ,
+      "%{wks.location}/OtherTestEngine/bench" ,
     }
     externalincludedirs {
       "%{wks.location}/DotOther/NetCore", 
-      "%{wks.location}/externals/gtest/googlemock/include"
+      "%{wks.location}/externals/gtest/googlemock/include",
+      "%{wks.location}/externals/json/include",
     }
   end,
 
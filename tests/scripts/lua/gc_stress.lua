@@ -0,0 +1,15 @@
+local object = require("other.object")
+
+GcStress = object:new()
+
+local retained = {}
+
+function GcStress.Update(dt)
+  local garbage = {}
+  for i = 1, 2000 do
+    garbage[i] = { x = i , y = i * 2 , name = "node" .. i }
+  end
+
+  --- keep a few frames alive so the collector has to trace something
+  retained[#retained % 8 + 1] = garbage
+end
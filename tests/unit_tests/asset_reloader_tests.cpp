@@ -0,0 +1,248 @@
+/**
+ * \file unit_tests/asset_reloader_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#include "core/config_keys.hpp"
+#include "core/defines.hpp"
+#include "core/file_watcher.hpp"
+#include "core/filesystem.hpp"
+#include "core/thread_pool.hpp"
+
+#include "asset/asset_dependency_graph.hpp"
+#include "asset/asset_reloader.hpp"
+#include "rendering/shader.hpp"
+
+using namespace std::chrono_literals;
+using namespace other;
+
+class AssetReloaderTests : public OtherTest {
+  public:
+    static void SetUpTestSuite() {
+      OtherTest::SetUpTestSuite();
+      OpenLog();
+    }
+
+    virtual void SetUp() override {
+      root = std::filesystem::temp_directory_path() / "oe-asset-reloader-tests";
+      std::filesystem::remove_all(root);
+      std::filesystem::create_directories(root);
+    }
+
+    /// tests that bring up the engine watcher return early on a failed assert , it is stopped here so it never leaks
+    virtual void TearDown() override {
+      FileWatcher::Shutdown();
+      std::filesystem::remove_all(root);
+    }
+
+    static void WriteFile(const Path& path , const std::string& contents) {
+      std::ofstream file(path , std::ios::trunc);
+      file << contents;
+    }
+
+    static std::string LibraryShader() {
+      return Filesystem::ReadFile(Path("./OtherEngine/assets/shaders/default.oshader"));
+    }
+
+    Path root;
+};
+
+TEST_F(AssetReloaderTests , graph_orders_dependents_after_dependencies) {
+  const AssetHandle shader = 1;
+  const AssetHandle texture = 2;
+  const AssetHandle material = 3;
+  const AssetHandle model = 4;
+
+  AssetDependencyGraph graph;
+  graph.AddAsset(shader , AssetType::SHADER , root / "lit.oshader");
+  graph.AddAsset(texture , AssetType::TEXTURE , root / "albedo.png");
+  graph.AddAsset(material , AssetType::BLANK_ASSET);
+  graph.AddAsset(model , AssetType::MODEL , root / "crate.obj");
+
+  graph.AddFileDependency(shader , root / "common.oshader");
+  graph.AddDependency(material , shader);
+  graph.AddDependency(material , texture);
+  graph.AddDependency(model , texture);
+
+  /// the import node is never rebuilt itself , only what reads it
+  EXPECT_EQ(graph.Invalidate(root / "common.oshader") , (std::vector<AssetHandle>{ shader , material }));
+  EXPECT_EQ(graph.Invalidate(root / "albedo.png") , (std::vector<AssetHandle>{ texture , material , model }));
+  EXPECT_EQ(graph.Invalidate(root / "crate.obj") , (std::vector<AssetHandle>{ model }));
+  EXPECT_TRUE(graph.Invalidate(root / "unrelated.txt").empty());
+
+  /// dropping the last reader of a file drops the file too
+  graph.ClearDependencies(shader);
+  EXPECT_FALSE(graph.Watches(root / "common.oshader"));
+  EXPECT_FALSE(graph.Contains(AssetDependencyGraph::FileHandle(root / "common.oshader")));
+  EXPECT_TRUE(graph.Invalidate(root / "common.oshader").empty());
+}
+
+TEST_F(AssetReloaderTests , graph_cycle_still_rebuilds) {
+  AssetDependencyGraph graph;
+  graph.AddAsset(1 , AssetType::SHADER , root / "a.oshader");
+  graph.AddAsset(2 , AssetType::SHADER , root / "b.oshader");
+  graph.AddDependency(1 , 2);
+  graph.AddDependency(2 , 1);
+
+  std::vector<AssetHandle> order = graph.Invalidate(root / "a.oshader");
+  EXPECT_EQ(order.size() , 2);
+}
+
+TEST_F(AssetReloaderTests , commits_wait_for_frame_boundary) {
+  ThreadPool pool(2);
+  AssetReloader reloader(&pool);
+
+  std::atomic<uint32_t> built = 0;
+  uint32_t committed = 0;
+  reloader.Track(1 , AssetType::TEXTURE , root / "albedo.png" , [&]() -> AssetCommit {
+    built++;
+    return [&]() { committed++; };
+  });
+
+  /// a failed rebuild leaves the live asset alone
+  reloader.Track(2 , AssetType::TEXTURE , root / "broken.png" , []() -> AssetCommit {
+    throw std::runtime_error("corrupt image");
+  });
+
+  const std::vector<Path> changed{ root / "albedo.png" , root / "broken.png" };
+  EXPECT_EQ(reloader.QueueChanges(std::span<const Path>{ changed }) , 2);
+  reloader.WaitIdle();
+
+  EXPECT_EQ(built.load() , 1);
+  EXPECT_EQ(committed , 0);
+  EXPECT_FALSE(reloader.Idle());
+
+  EXPECT_EQ(reloader.CommitReady() , 1);
+  EXPECT_EQ(committed , 1);
+  EXPECT_TRUE(reloader.Idle());
+
+  const AssetReloadStats stats = reloader.Stats();
+  EXPECT_EQ(stats.batches , 1);
+  EXPECT_EQ(stats.rebuilt , 1);
+  EXPECT_EQ(stats.failed , 1);
+
+  /// untracked while rebuilding , the commit is dropped
+  EXPECT_EQ(reloader.QueueChanges(std::span<const Path>{ changed.data() , 1 }) , 1);
+  reloader.Untrack(1);
+  reloader.WaitIdle();
+  EXPECT_EQ(reloader.CommitReady() , 0);
+  EXPECT_EQ(committed , 1);
+}
+
+TEST_F(AssetReloaderTests , shader_import_rebuilds_only_dependents) {
+  const std::string src = LibraryShader();
+  ASSERT_FALSE(src.empty());
+
+  const Path common = root / "common.oshader";
+  WriteFile(common , "// version 1\n");
+  WriteFile(root / "lit.oshader" , src + "\n#import \"common.oshader\";\n");
+  WriteFile(root / "unlit.oshader" , src + "\n#import \"common.oshader\";\n");
+  WriteFile(root / "debug.oshader" , src);
+
+  ThreadPool pool(2);
+  AssetReloader reloader(&pool);
+
+  std::map<std::string , uint32_t> reloads;
+  const std::vector<std::string> names{ "lit.oshader" , "unlit.oshader" , "debug.oshader" };
+  for (uint32_t i = 0; i < names.size(); ++i) {
+    const std::string name = names[i];
+    TrackShaderSource(reloader , AssetHandle(i + 1) , root / name , [&reloads , name](const ShaderIr& ir) {
+      EXPECT_FALSE(ir.vert_source.empty());
+      reloads[name]++;
+    });
+  }
+
+  FileWatcher watcher(FileWatcherSettings{ .debounce = 20ms , .poll_interval = 20ms });
+  ASSERT_NE(watcher.Watch(root) , kInvalidFileWatch);
+
+  /// what a frame loop does , wait for the change to settle , rebuild in the background , swap at the next frame
+  const auto edited_at = std::chrono::steady_clock::now();
+  WriteFile(common , "// version 2\n");
+
+  std::vector<FileChange> changes;
+  const auto deadline = edited_at + 5s;
+  while (changes.empty() && std::chrono::steady_clock::now() < deadline) {
+    changes = watcher.TakeChanges();
+    std::this_thread::sleep_for(1ms);
+  }
+  ASSERT_FALSE(changes.empty());
+  const auto detected_at = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(reloader.QueueChanges(changes) , 2);
+
+  size_t committed = 0;
+  while (committed == 0 && std::chrono::steady_clock::now() < deadline) {
+    committed = reloader.CommitReady();
+    std::this_thread::sleep_for(1ms);
+  }
+  const auto committed_at = std::chrono::steady_clock::now();
+  const double rebuild_ms = reloader.Stats().last_rebuild_ms;
+
+  EXPECT_EQ(committed , 2);
+  EXPECT_EQ(reloads["lit.oshader"] , 1);
+  EXPECT_EQ(reloads["unlit.oshader"] , 1);
+  EXPECT_EQ(reloads["debug.oshader"] , 0);
+
+  /// editing the shader that does not import anything rebuilds it alone
+  const std::vector<Path> debug{ root / "debug.oshader" };
+  EXPECT_EQ(reloader.QueueChanges(std::span<const Path>{ debug }) , 1);
+  reloader.WaitIdle();
+  EXPECT_EQ(reloader.CommitReady() , 1);
+  EXPECT_EQ(reloads["debug.oshader"] , 1);
+  EXPECT_EQ(reloads["lit.oshader"] , 1);
+
+  auto ms = [](auto duration) -> double {
+    return std::chrono::duration<double , std::milli>(duration).count();
+  };
+  println("AssetReloader : edit to detection {:.2f} ms | detection to commit {:.2f} ms | edit to commit {:.2f} ms | "
+          "last batch rebuild {:.2f} ms" ,
+          ms(detected_at - edited_at) , ms(committed_at - detected_at) , ms(committed_at - edited_at) , rebuild_ms);
+}
+
+TEST_F(AssetReloaderTests , shader_imports_outside_its_directory_are_watched) {
+  const std::string src = LibraryShader();
+  ASSERT_FALSE(src.empty());
+
+  std::filesystem::create_directories(root / "shaders");
+  std::filesystem::create_directories(root / "lib");
+  const Path common = root / "lib" / "common.oshader";
+  WriteFile(common , "// version 1\n");
+  WriteFile(root / "shaders" / "lit.oshader" , src + "\n#import \"../lib/common.oshader\";\n");
+
+  ConfigTable config;
+  config.Add(kFileWatcherSection , kDebounceValue , "20");
+  config.Add(kFileWatcherSection , kPollIntervalValue , "20");
+  FileWatcher::Initialize(config);
+  ASSERT_NE(FileWatcher::Get() , nullptr);
+
+  AssetReloader reloader;
+
+  uint32_t reloads = 0;
+  TrackShaderSource(reloader , 1 , root / "shaders" / "lit.oshader" , [&reloads](const ShaderIr&) {
+    reloads++;
+  });
+
+  /// only the engine watcher is running , the import is seen because its own directory is watched
+  WriteFile(common , "// version 2\n");
+
+  std::vector<FileChange> changes;
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (changes.empty() && std::chrono::steady_clock::now() < deadline) {
+    changes = FileWatcher::Get()->TakeChanges();
+    std::this_thread::sleep_for(1ms);
+  }
+  ASSERT_FALSE(changes.empty());
+  EXPECT_EQ(changes.front().path.lexically_normal() , common.lexically_normal());
+
+  EXPECT_EQ(reloader.QueueChanges(changes) , 1);
+  reloader.WaitIdle();
+  EXPECT_EQ(reloader.CommitReady() , 1);
+  EXPECT_EQ(reloads , 1);
+}
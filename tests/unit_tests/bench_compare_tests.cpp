@@ -0,0 +1,229 @@
+/**
+ * \file unit_tests/bench_compare_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+#include "bench.hpp"
+
+using other::BenchmarkComparison;
+using other::BenchmarkResult;
+using other::BenchmarkSettings;
+
+namespace {
+
+  constexpr double kThreshold = 0.15;
+
+  BenchmarkResult MakeResult(std::string_view name , double median_ms) {
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = 20;
+    result.items = 1000;
+    result.min_ms = median_ms;
+    result.median_ms = median_ms;
+    result.mean_ms = median_ms;
+    result.p95_ms = median_ms;
+    result.max_ms = median_ms;
+    return result;
+  }
+
+  BenchmarkResult MakeSkipped(std::string_view name) {
+    BenchmarkResult result;
+    result.name = name;
+    result.skipped = "not available";
+    return result;
+  }
+
+  const BenchmarkComparison* Find(const std::vector<BenchmarkComparison>& comparisons , std::string_view name) {
+    for (const auto& c : comparisons) {
+      if (c.name == name) {
+        return &c;
+      }
+    }
+    return nullptr;
+  }
+
+} // anonymous namespace
+
+/// the reader and writer log , the fixture brings up the logger
+class BenchCompareTests : public other::OtherTest {};
+
+TEST_F(BenchCompareTests , regression_above_threshold) {
+  const std::vector<BenchmarkResult> baseline = {
+    MakeResult("a.slower" , 10.0) ,
+    MakeResult("b.within" , 10.0) ,
+    MakeResult("c.faster" , 10.0) ,
+  };
+  const std::vector<BenchmarkResult> current = {
+    MakeResult("a.slower" , 10.0 * (1.0 + kThreshold) + 0.1) ,
+    MakeResult("b.within" , 10.0 * (1.0 + kThreshold) - 0.1) ,
+    MakeResult("c.faster" , 5.0) ,
+  };
+
+  const std::vector<BenchmarkComparison> comparisons = other::CompareBenchmarks(baseline , current , kThreshold);
+  ASSERT_EQ(comparisons.size() , 3);
+
+  const BenchmarkComparison* slower = Find(comparisons , "a.slower");
+  ASSERT_NE(slower , nullptr);
+  EXPECT_TRUE(slower->regressed);
+  EXPECT_FALSE(slower->missing);
+  EXPECT_DOUBLE_EQ(slower->baseline_ms , 10.0);
+  EXPECT_GT(slower->ratio , 1.0 + kThreshold);
+
+  const BenchmarkComparison* within = Find(comparisons , "b.within");
+  ASSERT_NE(within , nullptr);
+  EXPECT_FALSE(within->regressed);
+  EXPECT_GT(within->ratio , 1.0);
+
+  const BenchmarkComparison* faster = Find(comparisons , "c.faster");
+  ASSERT_NE(faster , nullptr);
+  EXPECT_FALSE(faster->regressed);
+  EXPECT_DOUBLE_EQ(faster->ratio , 0.5);
+
+  /// a tighter threshold turns the slowdown inside 15% into a regression
+  const std::vector<BenchmarkComparison> strict = other::CompareBenchmarks(baseline , current , 0.05);
+  EXPECT_TRUE(Find(strict , "b.within")->regressed);
+}
+
+TEST_F(BenchCompareTests , missing_and_skipped_entries) {
+  const std::vector<BenchmarkResult> baseline = {
+    MakeResult("a.present" , 10.0) ,
+    MakeSkipped("b.skipped_in_baseline") ,
+  };
+  const std::vector<BenchmarkResult> current = {
+    MakeResult("a.present" , 100.0) ,
+    MakeResult("b.skipped_in_baseline" , 100.0) ,
+    MakeResult("c.new" , 100.0) ,
+    MakeSkipped("d.skipped_now") ,
+  };
+
+  const std::vector<BenchmarkComparison> comparisons = other::CompareBenchmarks(baseline , current , kThreshold);
+
+  /// skipped results are never compared
+  ASSERT_EQ(comparisons.size() , 3);
+  EXPECT_EQ(Find(comparisons , "d.skipped_now") , nullptr);
+
+  EXPECT_TRUE(Find(comparisons , "a.present")->regressed);
+
+  /// no usable baseline is reported as missing and never as a regression
+  for (const auto name : { "b.skipped_in_baseline" , "c.new" }) {
+    const BenchmarkComparison* c = Find(comparisons , name);
+    ASSERT_NE(c , nullptr);
+    EXPECT_TRUE(c->missing);
+    EXPECT_FALSE(c->regressed);
+  }
+}
+
+TEST_F(BenchCompareTests , results_round_trip_through_json) {
+  const other::Path path = std::filesystem::temp_directory_path() / "oe_bench_compare_tests.json";
+
+  BenchmarkSettings settings;
+  BenchmarkResult budgeted = MakeResult("a.present" , 12.5);
+  budgeted.budget_ns = 50.0;
+
+  const std::vector<BenchmarkResult> written = {
+    budgeted ,
+    MakeSkipped("b.skipped") ,
+  };
+  ASSERT_TRUE(other::WriteBenchmarkResults(path , written , settings));
+
+  const other::Opt<std::vector<BenchmarkResult>> read = other::ReadBenchmarkResults(path);
+  std::filesystem::remove(path);
+  ASSERT_TRUE(read.has_value());
+  ASSERT_EQ(read->size() , 2);
+
+  EXPECT_EQ(read->at(0).name , "a.present");
+  EXPECT_DOUBLE_EQ(read->at(0).median_ms , 12.5);
+  EXPECT_EQ(read->at(0).items , 1000);
+  EXPECT_DOUBLE_EQ(read->at(0).budget_ns , 50.0);
+  EXPECT_FALSE(read->at(1).skipped.empty());
+
+  const std::vector<BenchmarkResult> current = { MakeResult("a.present" , 12.5 * 2.0) };
+  EXPECT_TRUE(other::CompareBenchmarks(read.value() , current , kThreshold).front().regressed);
+}
+
+/// the budget is checked on the current run alone , a baseline recorded over budget does not excuse it
+TEST_F(BenchCompareTests , budget_is_absolute) {
+  BenchmarkResult within = MakeResult("a.within" , 0.04);
+  within.budget_ns = 50.0;
+
+  BenchmarkResult over = MakeResult("b.over" , 0.06);
+  over.budget_ns = 50.0;
+
+  const std::vector<BenchmarkResult> baseline = { over };
+  const std::vector<BenchmarkResult> current = { within , over };
+
+  const std::vector<BenchmarkComparison> comparisons = other::CompareBenchmarks(baseline , current , kThreshold);
+  ASSERT_EQ(comparisons.size() , 2);
+
+  const BenchmarkComparison* a = Find(comparisons , "a.within");
+  ASSERT_NE(a , nullptr);
+  EXPECT_TRUE(a->missing);
+  EXPECT_DOUBLE_EQ(a->ns_per_item , 40.0);
+  EXPECT_FALSE(a->over_budget);
+
+  const BenchmarkComparison* b = Find(comparisons , "b.over");
+  ASSERT_NE(b , nullptr);
+  EXPECT_FALSE(b->regressed);
+  EXPECT_DOUBLE_EQ(b->ns_per_item , 60.0);
+  EXPECT_TRUE(b->over_budget);
+
+  /// no budget set , nothing to be over
+  EXPECT_FALSE(other::CompareBenchmarks({} , { MakeResult("c.unbounded" , 1000.0) } , kThreshold).front().over_budget);
+}
+
+/// an entry recorded as skipped covers its benchmark , only names the baseline never mentions are missing
+TEST_F(BenchCompareTests , missing_baseline_entries) {
+  const std::vector<BenchmarkResult> baseline = {
+    MakeResult("a.present" , 10.0) ,
+    MakeSkipped("b.skipped") ,
+  };
+
+  const std::vector<std::string> missing = other::MissingBaselineEntries(baseline , { "a.present" , "b.skipped" , "c.new" });
+  ASSERT_EQ(missing.size() , 1);
+  EXPECT_EQ(missing.front() , "c.new");
+
+  EXPECT_EQ(other::MissingBaselineEntries({} , { "a.present" }).size() , 1);
+  EXPECT_TRUE(other::MissingBaselineEntries(baseline , {}).empty());
+}
+
+/// the checked in release baseline has to parse and record every headless scenario , a missing one gates nothing
+TEST_F(BenchCompareTests , release_baseline_is_populated) {
+  const other::Path path = other::Filesystem::GetEngineCoreDir() / "OtherTestEngine" / "bench" / "baselines" / "release.json";
+  if (!std::filesystem::exists(path)) {
+    GTEST_SKIP() << "no engine checkout at " << path.string();
+  }
+
+  const other::Opt<std::vector<BenchmarkResult>> baseline = other::ReadBenchmarkResults(path);
+  ASSERT_TRUE(baseline.has_value());
+  ASSERT_FALSE(baseline->empty());
+
+  for (const auto& entry : baseline.value()) {
+    if (entry.skipped.empty()) {
+      EXPECT_GT(entry.median_ms , 0.0) << entry.name;
+    }
+  }
+
+  const std::vector<std::string_view> scenarios = {
+    "scene.entity_spawn" , "scene.update" , "scene.transform_propagation" , "scene.load" , "scene.save" ,
+    "render.submission" , "shader.compile" , "script.lua_dispatch" , "script.lua_gc_step" , "reflection.type_lookup" ,
+    "bvh.build" , "bvh.query" , "profiler.scope" ,
+  };
+  EXPECT_TRUE(other::MissingBaselineEntries(baseline.value() , scenarios).empty());
+
+  /// none of these need a window , a gpu or the C# host , each one has a measured median
+  for (const auto& name : scenarios) {
+    if (name == "scene.update") {
+      continue;
+    }
+
+    auto entry = std::ranges::find_if(baseline.value() , [&](const BenchmarkResult& b) {
+      return b.name == name;
+    });
+    ASSERT_NE(entry , baseline->end()) << name;
+    EXPECT_TRUE(entry->skipped.empty()) << name;
+  }
+}
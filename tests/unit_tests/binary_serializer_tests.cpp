@@ -0,0 +1,482 @@
+/**
+ * \file unit_tests/binary_serializer_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <chrono>
+
+#include <entt/entt.hpp>
+
+#include "core/binary_serializer.hpp"
+#include "ecs/ecs_reflection.hpp"
+
+#include "rendering/orthographic_camera.hpp"
+#include "rendering/perspective_camera.hpp"
+
+using namespace other;
+
+namespace {
+
+  struct SaveV1 {
+    int32_t health = 0;
+    std::string name;
+    float removed = 0.f;
+  };
+
+  /// the same save after health moved , removed was dropped and armor was added
+  struct SaveV2 {
+    std::string name;
+    int32_t health = 0;
+    double armor = 7.0;
+  };
+
+  struct Velocity {
+    glm::vec3 linear{ 0.f };
+    float damping = 0.f;
+  };
+
+  struct Mass {
+    float kg = 0.f;
+  };
+
+} // anonymous namespace
+
+ECHO_TYPE(
+  type(SaveV1) ,
+  field(health) ,
+  field(name) ,
+  field(removed)
+);
+
+ECHO_TYPE(
+  type(SaveV2) ,
+  field(name) ,
+  field(health) ,
+  field(armor)
+);
+
+class BinarySerializerTests : public OtherTest {
+  public:
+    static void SetUpTestSuite() {
+      OtherTest::SetUpTestSuite();
+      OpenLog();
+    }
+
+    template <typename T>
+    static void RoundTrip(const T& in , T& out) {
+      std::vector<uint8_t> bytes = SerializeBinary(in);
+      ASSERT_FALSE(bytes.empty());
+      ASSERT_TRUE(DeserializeBinary(bytes , out));
+    }
+};
+
+TEST_F(BinarySerializerTests , components_round_trip) {
+  {
+    SCOPED_TRACE("tag");
+    Tag in("player" , 42);
+    Tag out;
+    RoundTrip(in , out);
+    EXPECT_EQ(out.name , "player");
+    EXPECT_EQ(out.id , UUID(42));
+  }
+
+  {
+    SCOPED_TRACE("transform");
+    Transform in(1.f , 2.f , 3.f);
+    in.scale = glm::vec3(2.f);
+    in.erotation = glm::vec3(0.1f , 0.2f , 0.3f);
+    in.CalcMatrix();
+
+    Transform out;
+    RoundTrip(in , out);
+    EXPECT_EQ(out.position , in.position);
+    EXPECT_EQ(out.scale , in.scale);
+    EXPECT_EQ(out.erotation , in.erotation);
+    EXPECT_EQ(out.qrotation , in.qrotation);
+    EXPECT_EQ(out.model_transform , in.model_transform);
+  }
+
+  {
+    SCOPED_TRACE("relationship");
+    Relationship in;
+    in.parent = UUID(7);
+    in.children = { UUID(8) , UUID(9) , UUID(10) };
+
+    Relationship out;
+    out.children = { UUID(1) };
+    RoundTrip(in , out);
+    EXPECT_EQ(out.parent , in.parent);
+    EXPECT_EQ(out.children , in.children);
+
+    /// an empty optional is written too , not left out
+    Relationship orphan;
+    RoundTrip(orphan , out);
+    EXPECT_FALSE(out.parent.has_value());
+    EXPECT_TRUE(out.children.empty());
+  }
+
+  {
+    SCOPED_TRACE("mesh");
+    Mesh in;
+    in.handle = AssetHandle(99);
+    in.material.color = glm::vec4(0.1f , 0.2f , 0.3f , 1.f);
+    in.material.shininess = 8.f;
+    in.bone_entity_ids = { UUID(1) , UUID(2) };
+    in.visible = false;
+
+    Mesh out;
+    RoundTrip(in , out);
+    EXPECT_EQ(out.handle , in.handle);
+    EXPECT_EQ(out.material.color , in.material.color);
+    EXPECT_EQ(out.material.shininess , in.material.shininess);
+    EXPECT_EQ(out.bone_entity_ids , in.bone_entity_ids);
+    EXPECT_FALSE(out.visible);
+  }
+
+  {
+    SCOPED_TRACE("static-mesh");
+    StaticMesh in;
+    in.handle = AssetHandle(5);
+    in.material.shininess = 2.f;
+    in.is_primitive = true;
+    in.primitive_id = kCubeIdx;
+    in.primitive_selection = 3;
+
+    StaticMesh out;
+    RoundTrip(in , out);
+    EXPECT_EQ(out.handle , in.handle);
+    EXPECT_EQ(out.material.shininess , 2.f);
+    EXPECT_TRUE(out.visible);
+    EXPECT_TRUE(out.is_primitive);
+    EXPECT_EQ(out.primitive_id , kCubeIdx);
+    EXPECT_EQ(out.primitive_selection , 3);
+  }
+
+  {
+    SCOPED_TRACE("script");
+    Script in;
+    in.SetData({
+      { UUID(FNV("PLAYER")) , ScriptObjectData{ .module = "Sandbox" , .obj_name = "Player" } } ,
+      { UUID(FNV("CAMERA")) , ScriptObjectData{ .module = "Sandbox" , .obj_name = "Camera" } } ,
+    });
+
+    Script out;
+    RoundTrip(in , out);
+    ASSERT_EQ(out.GetData().size() , 2);
+    EXPECT_EQ(out.GetData().at(UUID(FNV("PLAYER"))).obj_name , "Player");
+    EXPECT_EQ(out.GetData().at(UUID(FNV("CAMERA"))).module , "Sandbox");
+
+    /// instances are attached later by LoadScripts
+    EXPECT_TRUE(out.GetScripts().empty());
+  }
+
+  {
+    SCOPED_TRACE("camera");
+    Camera in(NewRef<OrthographicCamera>(glm::ivec2{ 1280 , 720 }));
+    in.camera->SetPosition({ 1.f , 2.f , 3.f });
+    in.camera->SetDirection({ 0.f , 0.f , 1.f });
+    in.camera->SetOrientation({ 10.f , 20.f , 30.f });
+    in.camera->SetClip({ 0.5f , 500.f });
+    in.camera->SetFov(60.f);
+    in.camera->SetSpeed(3.f);
+    in.camera->SetConstrainPitch(false);
+    in.pinned_to_entity_position = false;
+    in.is_primary = true;
+
+    Camera out;
+    RoundTrip(in , out);
+    ASSERT_NE(out.camera , nullptr);
+    EXPECT_EQ(out.camera->GetCameraProjectionType() , ORTHOGRAPHIC);
+    EXPECT_EQ(out.camera->Position() , in.camera->Position());
+    EXPECT_EQ(out.camera->Direction() , in.camera->Direction());
+    EXPECT_EQ(out.camera->Orientation() , in.camera->Orientation());
+    EXPECT_EQ(out.camera->Viewport() , glm::ivec2(1280 , 720));
+    EXPECT_EQ(out.camera->Clip() , in.camera->Clip());
+    EXPECT_EQ(out.camera->FOV() , 60.f);
+    EXPECT_EQ(out.camera->Speed() , 3.f);
+    EXPECT_FALSE(out.camera->ConstrainPitch());
+    EXPECT_FALSE(out.pinned_to_entity_position);
+    EXPECT_TRUE(out.is_primary);
+
+    Camera empty;
+    RoundTrip(empty , out);
+    EXPECT_EQ(out.camera , nullptr);
+  }
+
+  {
+    SCOPED_TRACE("rigid-body-2d");
+    RigidBody2D in;
+    in.type = DYNAMIC;
+    in.mass = 4.f;
+    in.gravity_scale = 0.5f;
+    in.fixed_rotation = true;
+    in.bullet = true;
+
+    RigidBody2D out;
+    RoundTrip(in , out);
+    EXPECT_EQ(out.type , DYNAMIC);
+    EXPECT_EQ(out.mass , 4.f);
+    EXPECT_EQ(out.linear_drag , in.linear_drag);
+    EXPECT_EQ(out.gravity_scale , 0.5f);
+    EXPECT_TRUE(out.fixed_rotation);
+    EXPECT_TRUE(out.bullet);
+    EXPECT_EQ(out.physics_body , nullptr);
+  }
+
+  {
+    SCOPED_TRACE("collider-2d");
+    Collider2D in;
+    in.offset = { 1.f , -1.f };
+    in.size = { 2.f , 3.f };
+    in.density = 0.25f;
+    in.friction = 0.75f;
+
+    Collider2D out;
+    RoundTrip(in , out);
+    EXPECT_EQ(out.offset , in.offset);
+    EXPECT_EQ(out.size , in.size);
+    EXPECT_EQ(out.density , 0.25f);
+    EXPECT_EQ(out.friction , 0.75f);
+  }
+
+  {
+    SCOPED_TRACE("rigid-body");
+    RigidBody in;
+    in.type = KINEMATIC;
+    in.layer_id = 3;
+    in.enable_dynamic_type_change = true;
+    in.disable_gravity = true;
+    in.is_trigger = true;
+    in.collision_type = CONTINUOUS_COLLISION;
+    in.initial_linear_velocity = { 1.f , 2.f , 3.f };
+    in.initial_angular_velocity = { 0.f , 1.f , 0.f };
+    in.max_linear_velocity = 10.f;
+
+    RigidBody out;
+    RoundTrip(in , out);
+    EXPECT_EQ(out.type , KINEMATIC);
+    EXPECT_EQ(out.layer_id , 3);
+    EXPECT_TRUE(out.enable_dynamic_type_change);
+    EXPECT_TRUE(out.disable_gravity);
+    EXPECT_TRUE(out.is_trigger);
+    EXPECT_EQ(out.collision_type , CONTINUOUS_COLLISION);
+    EXPECT_EQ(out.initial_linear_velocity , in.initial_linear_velocity);
+    EXPECT_EQ(out.initial_angular_velocity , in.initial_angular_velocity);
+    EXPECT_EQ(out.max_linear_velocity , 10.f);
+    EXPECT_EQ(out.max_angular_velocity , in.max_angular_velocity);
+  }
+
+  {
+    SCOPED_TRACE("collider");
+    Collider in;
+    Collider out;
+    RoundTrip(in , out);
+    EXPECT_EQ(out.component_idx , in.component_idx);
+  }
+
+  {
+    SCOPED_TRACE("light-source");
+    LightSource in;
+    in.type = POINT_LIGHT_SRC;
+    in.pointlight = PointLight{ .position = { 1.f , 2.f , 3.f , 1.f } , .color = { 1.f , 0.f , 0.f , 1.f } , .radius = 20.f };
+    in.debug_model = AssetHandle(12);
+
+    LightSource out;
+    RoundTrip(in , out);
+    EXPECT_EQ(out.type , POINT_LIGHT_SRC);
+    EXPECT_EQ(out.pointlight.position , in.pointlight.position);
+    EXPECT_EQ(out.pointlight.color , in.pointlight.color);
+    EXPECT_EQ(out.pointlight.radius , 20.f);
+    EXPECT_EQ(out.pointlight.quadratic , in.pointlight.quadratic);
+    ASSERT_TRUE(out.debug_model.has_value());
+    EXPECT_EQ(*out.debug_model , AssetHandle(12));
+
+    /// only the member the type selects is in the data
+    LightSource sun;
+    sun.type = DIRECTION_LIGHT_SRC;
+    sun.direction_light.direction = { 0.f , -1.f , 0.5f , 0.f };
+
+    const size_t point_size = SerializeBinary(in).size();
+    const size_t sun_size = SerializeBinary(sun).size();
+    EXPECT_LT(sun_size , point_size);
+
+    RoundTrip(sun , out);
+    EXPECT_EQ(out.type , DIRECTION_LIGHT_SRC);
+    EXPECT_EQ(out.direction_light.direction , sun.direction_light.direction);
+    EXPECT_FALSE(out.debug_model.has_value());
+  }
+}
+
+TEST_F(BinarySerializerTests , fields_are_matched_by_name) {
+  SaveV1 old_save{ .health = 80 , .name = "knight" , .removed = 1.f };
+  std::vector<uint8_t> bytes = SerializeBinary(old_save);
+
+  SaveV2 new_save;
+  ASSERT_TRUE(DeserializeBinary(bytes , new_save));
+  EXPECT_EQ(new_save.name , "knight");
+  EXPECT_EQ(new_save.health , 80);
+  EXPECT_EQ(new_save.armor , 7.0);
+
+  /// and back , armor is unknown to the old reader and skipped
+  new_save.armor = 2.0;
+  SaveV1 round{ .removed = 5.f };
+  ASSERT_TRUE(DeserializeBinary(SerializeBinary(new_save) , round));
+  EXPECT_EQ(round.health , 80);
+  EXPECT_EQ(round.name , "knight");
+  EXPECT_EQ(round.removed , 5.f);
+}
+
+TEST_F(BinarySerializerTests , truncated_data_fails) {
+  Tag tag("truncated" , 1);
+  std::vector<uint8_t> bytes = SerializeBinary(tag);
+
+  for (size_t size = 0; size < bytes.size(); ++size) {
+    Tag out;
+    EXPECT_FALSE(DeserializeBinary(std::span<const uint8_t>{ bytes.data() , size } , out)) << "size " << size;
+  }
+
+  /// a count larger than the data is rejected before anything is allocated
+  BinaryWriter writer;
+  writer.Write(std::numeric_limits<uint32_t>::max());
+  std::vector<UUID> ids;
+  EXPECT_FALSE(DeserializeBinary(writer.Bytes() , ids));
+}
+
+TEST_F(BinarySerializerTests , pools_round_trip) {
+  constexpr uint32_t kNumEntities = 100'000;
+
+  entt::registry registry;
+  for (uint32_t i = 0; i < kNumEntities; ++i) {
+    const entt::entity entity = registry.create();
+    registry.emplace<Tag>(entity , fmtstr("entity-{}" , i) , UUID(i + 1));
+    if (i % 2 == 0) {
+      registry.emplace<Transform>(entity , static_cast<float>(i));
+    }
+    registry.emplace<Velocity>(entity , glm::vec3(static_cast<float>(i)) , 0.5f);
+  }
+
+  /// a hole in the middle of the entity range
+  registry.destroy(entt::entity{ 10 });
+
+  using clock = std::chrono::steady_clock;
+  const auto save_start = clock::now();
+
+  BinaryWriter writer(kNumEntities * 64);
+  EXPECT_EQ(SerializePool<Tag>(writer , registry) , kNumEntities - 1);
+  EXPECT_EQ(SerializePool<Transform>(writer , registry) , kNumEntities / 2 - 1);
+
+  const size_t raw_offset = writer.Size();
+  EXPECT_EQ(SerializePool<Velocity>(writer , registry) , kNumEntities - 1);
+  EXPECT_EQ(SerializePool<LightSource>(writer , registry) , 0);
+
+  const auto save_end = clock::now();
+
+  /// Velocity is trivially copyable , its pool is copied as is
+  EXPECT_EQ(static_cast<BinaryPoolFormat>(writer.Bytes()[raw_offset + sizeof(uint32_t)]) , BinaryPoolFormat::RAW);
+
+  entt::registry loaded;
+  BinaryReader reader(writer.Bytes());
+  const auto load_start = clock::now();
+  ASSERT_TRUE(DeserializePool<Tag>(reader , loaded));
+  ASSERT_TRUE(DeserializePool<Transform>(reader , loaded));
+  ASSERT_TRUE(DeserializePool<Velocity>(reader , loaded));
+  ASSERT_TRUE(DeserializePool<LightSource>(reader , loaded));
+  const auto load_end = clock::now();
+  EXPECT_EQ(reader.Remaining() , 0);
+
+  EXPECT_FALSE(loaded.valid(entt::entity{ 10 }));
+  EXPECT_EQ(loaded.storage<Tag>().size() , kNumEntities - 1);
+  EXPECT_EQ(loaded.storage<Transform>().size() , kNumEntities / 2 - 1);
+  EXPECT_EQ(loaded.storage<Velocity>().size() , kNumEntities - 1);
+  EXPECT_TRUE(loaded.storage<LightSource>().empty());
+
+  for (const auto [entity , tag] : registry.view<Tag>().each()) {
+    ASSERT_TRUE(loaded.valid(entity));
+    ASSERT_EQ(loaded.get<Tag>(entity).name , tag.name);
+    ASSERT_EQ(loaded.get<Tag>(entity).id , tag.id);
+    ASSERT_EQ(loaded.get<Velocity>(entity).linear , registry.get<Velocity>(entity).linear);
+
+    if (const auto* transform = registry.try_get<Transform>(entity); transform != nullptr) {
+      ASSERT_EQ(loaded.get<Transform>(entity).position , transform->position);
+    } else {
+      ASSERT_FALSE(loaded.all_of<Transform>(entity));
+    }
+  }
+
+  /// the packed order is kept , a reloaded pool iterates the same way the saved one did
+  const auto& saved_pool = registry.storage<Velocity>();
+  EXPECT_TRUE(std::equal(saved_pool.data() , saved_pool.data() + saved_pool.size() , loaded.storage<Velocity>().data()));
+
+  auto ms = [](auto duration) -> double {
+    return std::chrono::duration<double , std::milli>(duration).count();
+  };
+  println("BinarySerializer : {} entities , {} bytes | save {:.2f} ms | load {:.2f} ms" ,
+          kNumEntities , writer.Size() , ms(save_end - save_start) , ms(load_end - load_start));
+}
+
+TEST_F(BinarySerializerTests , pools_overwrite_existing_components) {
+  entt::registry registry;
+  const entt::entity entity = registry.create();
+  registry.emplace<Velocity>(entity , glm::vec3(1.f) , 0.1f);
+  registry.emplace<Collider2D>(entity).density = 3.f;
+
+  BinaryWriter writer;
+  SerializePool<Velocity>(writer , registry);
+  SerializePool<Collider2D>(writer , registry);
+
+  registry.get<Velocity>(entity).damping = 0.9f;
+  registry.get<Collider2D>(entity).density = 0.f;
+
+  BinaryReader reader(writer.Bytes());
+  ASSERT_TRUE(DeserializePool<Velocity>(reader , registry));
+  ASSERT_TRUE(DeserializePool<Collider2D>(reader , registry));
+  EXPECT_EQ(registry.get<Velocity>(entity).damping , 0.1f);
+  EXPECT_EQ(registry.get<Collider2D>(entity).density , 3.f);
+
+  /// a pool read as the wrong component is rejected
+  BinaryReader wrong(writer.Bytes());
+  EXPECT_FALSE(DeserializePool<Collider2D>(wrong , registry));
+}
+
+TEST_F(BinarySerializerTests , pools_restore_into_owning_groups) {
+  constexpr uint32_t kNumEntities = 1000;
+
+  entt::registry registry;
+  for (uint32_t i = 0; i < kNumEntities; ++i) {
+    const entt::entity entity = registry.create();
+    registry.emplace<Velocity>(entity , glm::vec3(static_cast<float>(i)) , static_cast<float>(i) * 0.001f);
+    if (i % 3 == 0) {
+      registry.emplace<Mass>(entity , static_cast<float>(i));
+    }
+  }
+
+  BinaryWriter writer;
+  SerializePool<Mass>(writer , registry);
+  SerializePool<Velocity>(writer , registry);
+
+  /// the group owns Velocity and moves every entity that also has a Mass to the front of the pool as it is filled
+  entt::registry loaded;
+  auto group = loaded.group<Velocity>(entt::get<Mass>);
+
+  BinaryReader reader(writer.Bytes());
+  ASSERT_TRUE(DeserializePool<Mass>(reader , loaded));
+  ASSERT_TRUE(DeserializePool<Velocity>(reader , loaded));
+  EXPECT_EQ(reader.Remaining() , 0);
+
+  const auto& saved_pool = registry.storage<Velocity>();
+  const auto& loaded_pool = loaded.storage<Velocity>();
+  ASSERT_EQ(loaded_pool.size() , saved_pool.size());
+  EXPECT_FALSE(std::equal(saved_pool.data() , saved_pool.data() + saved_pool.size() , loaded_pool.data()));
+
+  /// values follow their entity and not the slot they were saved in
+  for (const auto [entity , velocity] : registry.view<Velocity>().each()) {
+    ASSERT_TRUE(loaded.all_of<Velocity>(entity));
+    ASSERT_EQ(loaded.get<Velocity>(entity).linear , velocity.linear);
+    ASSERT_EQ(loaded.get<Velocity>(entity).damping , velocity.damping);
+  }
+
+  EXPECT_EQ(group.size() , (kNumEntities + 2) / 3);
+  for (const auto [entity , velocity , mass] : group.each()) {
+    ASSERT_EQ(velocity.linear.x , mass.kg);
+  }
+}
@@ -0,0 +1,273 @@
+/**
+ * \file unit_tests/draw_list_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include <entt/entt.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/config_keys.hpp"
+#include "core/defines.hpp"
+#include "core/thread_pool.hpp"
+
+#include "ecs/components/mesh.hpp"
+#include "ecs/components/transform.hpp"
+
+#include "rendering/draw_list.hpp"
+#include "rendering/render_commands.hpp"
+#include "rendering/rendering_defines.hpp"
+
+using namespace std::string_view_literals;
+using namespace other;
+
+class DrawListTests : public OtherTest {
+  public:
+    constexpr static uint32_t kNumBenchEntities = 200000;
+    constexpr static uint32_t kNumBenchModels = 64;
+
+    using StaticGroup = SystemGroup<StaticMesh , Transform>;
+
+    static void SetUpTestSuite() {
+      OtherTest::SetUpTestSuite();
+      OpenLog();
+    }
+
+    static void StartPool(uint32_t workers) {
+      ConfigTable pool_config = config;
+      pool_config.Add(kThreadPoolSection , kWorkersValue , fmtstr("{}" , workers));
+      ThreadPool::Initialize(pool_config);
+    }
+
+    /// camera at the origin looking down -z
+    static DrawView View() {
+      return DrawView{
+        .view = glm::lookAt(glm::vec3{ 0.f } , glm::vec3{ 0.f , 0.f , -1.f } , glm::vec3{ 0.f , 1.f , 0.f }) ,
+        .projection = glm::perspective(glm::radians(90.f) , 16.f / 9.f , 0.1f , 500.f) ,
+      };
+    }
+
+    static entt::entity AddMesh(entt::registry& registry , uint64_t handle , const glm::vec3& position) {
+      entt::entity entity = registry.create();
+      auto& mesh = registry.emplace<StaticMesh>(entity);
+      mesh.handle = handle;
+      mesh.material.shininess = static_cast<float>(handle);
+
+      auto& transform = registry.emplace<Transform>(entity , position);
+      transform.CalcMatrix();
+      return entity;
+    }
+
+    /// every handle but 0 is a unit cube
+    static Opt<DrawModel> ResolveCube(AssetHandle handle) {
+      if (handle.Get() == 0) {
+        return std::nullopt;
+      }
+      return DrawModel{
+        .bounds_min = glm::vec3{ -0.5f } ,
+        .bounds_max = glm::vec3{ 0.5f } ,
+      };
+    }
+
+    static std::vector<DrawItem> Copy(const DrawList& list) {
+      return std::vector<DrawItem>(list.Items().begin() , list.Items().end());
+    }
+};
+
+TEST_F(DrawListTests , radix_sort_matches_stable_sort) {
+  std::mt19937_64 rng(9);
+  std::vector<DrawItem> items;
+  for (uint32_t i = 0; i < 5000; ++i) {
+    /// few distinct keys so stability is actually exercised
+    items.push_back(DrawItem{ .sort_key = DrawSortKey(rng() % 17 , static_cast<float>(rng() % 5)) , .instance = i });
+  }
+
+  std::vector<DrawItem> expected = items;
+  std::stable_sort(expected.begin() , expected.end() , [](const DrawItem& a , const DrawItem& b) {
+    return a.sort_key < b.sort_key;
+  });
+
+  std::vector<DrawItem> scratch;
+  RadixSortDrawItems(items , scratch);
+  ASSERT_EQ(items.size() , expected.size());
+  for (size_t i = 0; i < items.size(); ++i) {
+    ASSERT_EQ(items[i].sort_key , expected[i].sort_key) << i;
+    ASSERT_EQ(items[i].instance , expected[i].instance) << i;
+  }
+
+  /// model dominates the key , depth only orders draws of one model
+  EXPECT_LT(DrawSortKey(1 , 1000.f) , DrawSortKey(2 , 0.f));
+  EXPECT_LT(DrawSortKey(1 , 1.f) , DrawSortKey(1 , 2.f));
+  EXPECT_EQ(DrawSortKey(1 , -5.f) , DrawSortKey(1 , 0.f));
+}
+
+TEST_F(DrawListTests , build_culls_and_groups_by_model) {
+  entt::registry registry;
+  StaticGroup group = registry.group<StaticMesh>(entt::get<Transform> , entt::exclude<NullComponent>);
+
+  AddMesh(registry , 2 , { 0.f , 0.f , -30.f });
+  AddMesh(registry , 1 , { 0.f , 0.f , -10.f });
+  AddMesh(registry , 2 , { 1.f , 0.f , -5.f });
+  AddMesh(registry , 1 , { 0.f , 0.f , -20.f });
+
+  /// behind the camera , far off to the side and past the far plane
+  AddMesh(registry , 1 , { 0.f , 0.f , 10.f });
+  AddMesh(registry , 2 , { 900.f , 0.f , -10.f });
+  AddMesh(registry , 2 , { 0.f , 0.f , -900.f });
+
+  /// straddles the near plane , partially visible boxes are kept
+  AddMesh(registry , 1 , { 0.f , 0.f , 0.2f });
+
+  /// unresolvable handles are dropped before culling
+  AddMesh(registry , 0 , { 0.f , 0.f , -10.f });
+
+  uint32_t resolves = 0;
+  DrawList list;
+  const DrawListStats& stats = list.Build<StaticMesh>(group , [&](AssetHandle handle) {
+    ++resolves;
+    return ResolveCube(handle);
+  } , View());
+
+  EXPECT_EQ(stats.sources , 9);
+  EXPECT_EQ(resolves , 3);
+  EXPECT_EQ(stats.models , 2);
+  EXPECT_EQ(stats.unresolved , 1);
+  EXPECT_EQ(stats.culled , 3);
+  EXPECT_EQ(stats.draws , 5);
+  EXPECT_EQ(stats.runs , 2);
+
+  std::vector<uint64_t> run_handles;
+  list.ForEachRun([&](uint32_t model , std::span<const DrawItem> run) {
+    run_handles.push_back(list.Models()[model].handle.Get());
+
+    /// front to back inside a run
+    float last_depth = -1.f;
+    for (const auto& item : run) {
+      const auto& transform = group.get<Transform>(group[item.instance]);
+      EXPECT_EQ(group.get<StaticMesh>(group[item.instance]).handle , list.Models()[model].handle);
+      const float depth = std::max(-transform.position.z , 0.f);
+      EXPECT_GE(depth , last_depth);
+      last_depth = depth;
+    }
+  });
+  ASSERT_EQ(run_handles.size() , 2);
+  EXPECT_NE(run_handles[0] , run_handles[1]);
+
+  /// without a view nothing is culled
+  list.Build<StaticMesh>(group , ResolveCube);
+  EXPECT_EQ(list.Stats().culled , 0);
+  EXPECT_EQ(list.Stats().draws , 8);
+}
+
+TEST_F(DrawListTests , build_does_not_depend_on_worker_count) {
+  entt::registry registry;
+  StaticGroup group = registry.group<StaticMesh>(entt::get<Transform> , entt::exclude<NullComponent>);
+
+  std::mt19937 rng(4);
+  std::uniform_real_distribution<float> lateral(-200.f , 200.f);
+  std::uniform_real_distribution<float> depth(-400.f , 50.f);
+  for (uint32_t i = 0; i < 20 * kDrawChunkSize + 17; ++i) {
+    AddMesh(registry , 1 + rng() % 40 , { lateral(rng) , lateral(rng) * 0.5f , depth(rng) });
+  }
+
+  DrawList serial;
+  serial.Build<StaticMesh>(group , ResolveCube , View());
+  const std::vector<DrawItem> expected = Copy(serial);
+  ASSERT_GT(serial.Stats().culled , 0);
+  ASSERT_GT(expected.size() , 0);
+
+  StartPool(4);
+  DrawList parallel;
+  for (uint32_t frame = 0; frame < 3; ++frame) {
+    parallel.Build<StaticMesh>(group , ResolveCube , View());
+    const std::vector<DrawItem> items = Copy(parallel);
+    ASSERT_EQ(items.size() , expected.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+      ASSERT_EQ(items[i].sort_key , expected[i].sort_key) << i;
+      ASSERT_EQ(items[i].instance , expected[i].instance) << i;
+    }
+  }
+  EXPECT_EQ(parallel.Stats().chunks , 21);
+  ThreadPool::Shutdown();
+}
+
+TEST_F(DrawListTests , submission_scaling) {
+  entt::registry registry;
+  StaticGroup group = registry.group<StaticMesh>(entt::get<Transform> , entt::exclude<NullComponent>);
+
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> lateral(-300.f , 300.f);
+  std::uniform_real_distribution<float> depth(-450.f , 20.f);
+  for (uint32_t i = 0; i < kNumBenchEntities; ++i) {
+    AddMesh(registry , 1 + rng() % kNumBenchModels , { lateral(rng) , lateral(rng) * 0.5f , depth(rng) });
+  }
+
+  const uint32_t max_workers = std::max(std::thread::hardware_concurrency() , 2u) - 1;
+  std::vector<uint32_t> worker_counts = { 0 };
+  for (uint32_t w = 1; w < max_workers; w *= 2) {
+    worker_counts.push_back(w);
+  }
+  worker_counts.push_back(max_workers);
+
+  constexpr uint32_t kNumFrames = 10;
+  RenderCommandBuffer commands;
+  NullRenderBackend backend;
+  DrawList list;
+
+  for (uint32_t workers : worker_counts) {
+    StartPool(workers);
+
+    double build_ms = 0.0;
+    double record_ms = 0.0;
+    for (uint32_t f = 0; f < kNumFrames + 1; ++f) {
+      list.Build<StaticMesh>(group , ResolveCube , View());
+
+      /// one instanced draw per sorted run , what the pipeline ends up issuing
+      auto start = std::chrono::steady_clock::now();
+      commands.Reset();
+      uint32_t base_instance = 0;
+      list.ForEachRun([&](uint32_t model , std::span<const DrawItem> run) {
+        const uint32_t count = static_cast<uint32_t>(run.size());
+        commands.Record(BindStorageRangeCmd{
+          .binding_point = 1 ,
+          .buffer = 1 ,
+          .offset = base_instance * sizeof(glm::mat4) ,
+          .size = count * sizeof(glm::mat4) ,
+        });
+        commands.Record(BindVertexArrayCmd{ .vertex_array = model + 1 });
+        commands.Record(DrawIndexedCmd{
+          .mode = TRIANGLES ,
+          .num_elements = 36 ,
+          .instance_count = count ,
+          .base_instance = base_instance ,
+        });
+        base_instance += count;
+      });
+      backend.Execute(commands);
+      auto end = std::chrono::steady_clock::now();
+
+      /// the first frame grows every list and is not timed
+      if (f > 0) {
+        build_ms += list.Stats().build_ms;
+        record_ms += std::chrono::duration<double , std::milli>(end - start).count();
+      }
+    }
+
+    const DrawListStats& stats = list.Stats();
+    EXPECT_EQ(stats.sources , kNumBenchEntities);
+    EXPECT_EQ(stats.draws + stats.culled , kNumBenchEntities);
+    EXPECT_EQ(stats.runs , kNumBenchModels);
+    EXPECT_EQ(backend.Stats().validation_errors , 0);
+
+    other::println("{} entities on {} workers : {:.3f} ms build ({:.3f} collect | {:.3f} resolve | {:.3f} sort) | "
+                   "{:.3f} ms record and replay , {} drawn in {} draws"sv ,
+                   kNumBenchEntities , workers , build_ms / kNumFrames , stats.collect_ms , stats.resolve_ms ,
+                   stats.sort_ms , record_ms / kNumFrames , stats.draws , stats.runs);
+
+    ThreadPool::Shutdown();
+  }
+}
@@ -0,0 +1,221 @@
+/**
+ * \file unit_tests/file_watcher_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "core/defines.hpp"
+#include "core/file_watcher.hpp"
+
+using namespace std::chrono_literals;
+using namespace other;
+
+class FileWatcherTests : public OtherTest {
+  public:
+    static void SetUpTestSuite() {
+      OtherTest::SetUpTestSuite();
+      OpenLog();
+    }
+
+    virtual void SetUp() override {
+      root = std::filesystem::temp_directory_path() / "oe-file-watcher-tests";
+      std::filesystem::remove_all(root);
+      std::filesystem::create_directories(root / "nested");
+    }
+
+    virtual void TearDown() override {
+      std::filesystem::remove_all(root);
+    }
+
+    static FileWatcherSettings Settings(bool polling) {
+      return FileWatcherSettings{
+        .force_polling = polling ,
+        .debounce = 20ms ,
+        .poll_interval = 20ms ,
+      };
+    }
+
+    static void Write(const Path& path , std::string_view contents) {
+      std::ofstream file(path , std::ios::app);
+      file << contents;
+    }
+
+    /// polls until something settles or the timeout runs out
+    static std::vector<FileChange> WaitForChanges(FileWatcher& watcher , std::chrono::milliseconds timeout = 2000ms) {
+      const auto deadline = std::chrono::steady_clock::now() + timeout;
+      while (std::chrono::steady_clock::now() < deadline) {
+        auto changes = watcher.TakeChanges();
+        if (!changes.empty()) {
+          return changes;
+        }
+        std::this_thread::sleep_for(1ms);
+      }
+      return {};
+    }
+
+    Path root;
+};
+
+TEST_F(FileWatcherTests , reports_each_change_type) {
+  FileWatcher watcher(Settings(false));
+  if (watcher.BackendName() != "inotify") {
+    GTEST_SKIP() << "renames are only reported by the inotify backend";
+  }
+  ASSERT_NE(watcher.Watch(root) , kInvalidFileWatch);
+
+  Write(root / "nested" / "a.lua" , "print('a')");
+  auto changes = WaitForChanges(watcher);
+  ASSERT_EQ(changes.size() , 1);
+  EXPECT_EQ(changes[0].type , FileChangeType::CREATED);
+  EXPECT_EQ(changes[0].path , root / "nested" / "a.lua");
+
+  Write(root / "nested" / "a.lua" , "print('b')");
+  changes = WaitForChanges(watcher);
+  ASSERT_EQ(changes.size() , 1);
+  EXPECT_EQ(changes[0].type , FileChangeType::MODIFIED);
+
+  std::filesystem::rename(root / "nested" / "a.lua" , root / "b.lua");
+  changes = WaitForChanges(watcher);
+  ASSERT_EQ(changes.size() , 1);
+  EXPECT_EQ(changes[0].type , FileChangeType::RENAMED);
+  EXPECT_EQ(changes[0].old_path , root / "nested" / "a.lua");
+  EXPECT_EQ(changes[0].path , root / "b.lua");
+
+  std::filesystem::remove(root / "b.lua");
+  changes = WaitForChanges(watcher);
+  ASSERT_EQ(changes.size() , 1);
+  EXPECT_EQ(changes[0].type , FileChangeType::REMOVED);
+}
+
+TEST_F(FileWatcherTests , debounce_coalesces_per_path) {
+  FileWatcherSettings settings = Settings(false);
+  settings.debounce = 200ms;
+  FileWatcher watcher(settings);
+  ASSERT_NE(watcher.Watch(root) , kInvalidFileWatch);
+
+  /// several writes while the path is still settling come out as the one create
+  for (uint32_t i = 0; i < 5; ++i) {
+    Write(root / "written.lua" , "--");
+  }
+
+  /// never seen by anyone once the window closes
+  Write(root / "temporary.lua" , "--");
+  std::filesystem::remove(root / "temporary.lua");
+
+  auto changes = WaitForChanges(watcher);
+  ASSERT_EQ(changes.size() , 1);
+  EXPECT_EQ(changes[0].type , FileChangeType::CREATED);
+  EXPECT_EQ(changes[0].path , root / "written.lua");
+
+  std::this_thread::sleep_for(300ms);
+  EXPECT_TRUE(watcher.TakeChanges().empty());
+}
+
+TEST_F(FileWatcherTests , watches_filter_and_flag) {
+  FileWatcher watcher(Settings(false));
+  const FileWatchId scripts = watcher.Watch(root , { ".cs" , ".lua" });
+  const FileWatchId nested = watcher.Watch(root / "nested");
+  ASSERT_NE(scripts , kInvalidFileWatch);
+  ASSERT_NE(nested , kInvalidFileWatch);
+
+  Write(root / "notes.txt" , "ignored");
+  Write(root / "nested" / "script.cs" , "class A {}");
+
+  auto changes = WaitForChanges(watcher);
+  ASSERT_EQ(changes.size() , 1);
+  EXPECT_EQ(changes[0].path , root / "nested" / "script.cs");
+
+  EXPECT_EQ(watcher.Consume(scripts , FileChangeBit(FileChangeType::MODIFIED)) , 0u);
+  EXPECT_NE(watcher.Consume(scripts , kFileStructureChanges) , 0u);
+  EXPECT_EQ(watcher.Consume(scripts , kFileStructureChanges) , 0u);
+  EXPECT_NE(watcher.Consume(nested) , 0u);
+
+  /// both watches cover the nested directory , dropping one leaves the other working
+  watcher.Unwatch(nested);
+  Write(root / "nested" / "script.cs" , "class B {}");
+  changes = WaitForChanges(watcher);
+  ASSERT_EQ(changes.size() , 1);
+  EXPECT_EQ(changes[0].type , FileChangeType::MODIFIED);
+  EXPECT_EQ(watcher.Consume(nested) , 0u);
+}
+
+TEST_F(FileWatcherTests , polling_fallback) {
+  FileWatcher watcher(Settings(true));
+  ASSERT_EQ(watcher.BackendName() , "polling");
+  ASSERT_NE(watcher.Watch(root) , kInvalidFileWatch);
+
+  Write(root / "nested" / "polled.lua" , "--");
+  auto changes = WaitForChanges(watcher);
+  ASSERT_EQ(changes.size() , 1);
+  EXPECT_EQ(changes[0].type , FileChangeType::CREATED);
+
+  /// write times are compared , make sure the next one is actually different
+  std::filesystem::last_write_time(root / "nested" / "polled.lua" ,
+                                   std::filesystem::last_write_time(root / "nested" / "polled.lua") + 1s);
+  changes = WaitForChanges(watcher);
+  ASSERT_EQ(changes.size() , 1);
+  EXPECT_EQ(changes[0].type , FileChangeType::MODIFIED);
+
+  std::filesystem::remove(root / "nested" / "polled.lua");
+  changes = WaitForChanges(watcher);
+  ASSERT_EQ(changes.size() , 1);
+  EXPECT_EQ(changes[0].type , FileChangeType::REMOVED);
+}
+
+TEST_F(FileWatcherTests , fifty_thousand_files) {
+  constexpr uint32_t kNumDirs = 50;
+  constexpr uint32_t kFilesPerDir = 1000;
+
+  for (uint32_t d = 0; d < kNumDirs; ++d) {
+    const Path dir = root / fmtstr("dir-{}" , d);
+    std::filesystem::create_directories(dir);
+    for (uint32_t f = 0; f < kFilesPerDir; ++f) {
+      std::ofstream(dir / fmtstr("file-{}.lua" , f));
+    }
+  }
+
+  for (bool polling : { false , true }) {
+    FileWatcherSettings settings = Settings(polling);
+    settings.poll_interval = 250ms;
+    FileWatcher watcher(settings);
+
+    const auto watch_start = std::chrono::steady_clock::now();
+    ASSERT_NE(watcher.Watch(root , { ".lua" }) , kInvalidFileWatch);
+    const double watch_ms = std::chrono::duration<double , std::milli>(std::chrono::steady_clock::now() - watch_start).count();
+
+    /// nothing changes , this is what the watcher costs while the editor just sits there
+    const FileWatcherStats idle_before = watcher.Stats();
+    const std::clock_t cpu_before = std::clock();
+    std::this_thread::sleep_for(500ms);
+    const FileWatcherStats idle_after = watcher.Stats();
+    const double idle_busy_ms = idle_after.busy_ms - idle_before.busy_ms;
+    const double idle_wall_ms = idle_after.wall_ms - idle_before.wall_ms;
+    const double idle_cpu_ms = 1000.0 * static_cast<double>(std::clock() - cpu_before) / CLOCKS_PER_SEC;
+
+    const Path target = root / "dir-27" / "file-512.lua";
+    const auto modified_at = std::chrono::steady_clock::now();
+    Write(target , "print('changed')");
+
+    auto changes = WaitForChanges(watcher , 5000ms);
+    const double latency_ms = std::chrono::duration<double , std::milli>(std::chrono::steady_clock::now() - modified_at).count();
+    ASSERT_EQ(changes.size() , 1);
+    EXPECT_EQ(changes[0].path , target);
+    EXPECT_EQ(changes[0].type , FileChangeType::MODIFIED);
+
+    println("FileWatcher [{}] {} files : watch {:.2f} ms | idle busy {:.3f} ms over {:.0f} ms , process cpu {:.2f} ms | "
+            "detection latency {:.2f} ms ({} ms debounce)" ,
+            watcher.BackendName() , kNumDirs * kFilesPerDir , watch_ms , idle_busy_ms , idle_wall_ms , idle_cpu_ms ,
+            latency_ms , settings.debounce.count());
+
+    /// inotify should cost nothing while idle and notice a change right after the debounce window
+    if (watcher.BackendName() == "inotify") {
+      EXPECT_LT(idle_busy_ms , 0.05 * idle_wall_ms);
+      EXPECT_LT(latency_ms , 500.0);
+    }
+  }
+}
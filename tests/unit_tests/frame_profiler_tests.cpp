@@ -0,0 +1,230 @@
+/**
+ * \file unit_tests/frame_profiler_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <algorithm>
+#include <latch>
+#include <map>
+#include <thread>
+
+#include "core/defines.hpp"
+#include "core/frame_profiler.hpp"
+#include "core/profile.hpp"
+#include "core/time.hpp"
+
+using namespace std::string_view_literals;
+using namespace other;
+
+class FrameProfilerTests : public OtherTest {
+  public:
+    static void SetUpTestSuite() {
+      OtherTest::SetUpTestSuite();
+      OpenLog();
+    }
+
+    virtual void SetUp() override {
+      FrameProfiler::Reset();
+      FrameProfiler::SetEnabled(true);
+    }
+
+    virtual void TearDown() override {
+      FrameProfiler::SetEnabled(false);
+      FrameProfiler::Reset();
+    }
+
+    static const ProfileSample* Find(const ProfileFrame& frame , uint32_t scope) {
+      for (const auto& sample : frame.samples) {
+        if (sample.scope == scope) {
+          return &sample;
+        }
+      }
+      return nullptr;
+    }
+
+    static double TicksToMs(uint64_t ticks) {
+      return static_cast<double>(ticks) * time::NsPerTick() / 1e6;
+    }
+};
+
+TEST_F(FrameProfilerTests , nesting_is_rebuilt_from_timestamps) {
+  const uint32_t outer = FrameProfiler::RegisterScope("nesting.outer");
+  const uint32_t inner = FrameProfiler::RegisterScope("nesting.inner");
+  const uint32_t leaf = FrameProfiler::RegisterScope("nesting.leaf");
+  const uint32_t sibling = FrameProfiler::RegisterScope("nesting.sibling");
+  EXPECT_EQ(FrameProfiler::RegisterScope("nesting.outer") , outer);
+
+  /// recorded in completion order , children first
+  const uint64_t base = time::Ticks();
+  FrameProfiler::Record(leaf , base + 20 , base + 30);
+  FrameProfiler::Record(inner , base + 10 , base + 40);
+  FrameProfiler::Record(sibling , base + 40 , base + 90);
+  FrameProfiler::Record(outer , base + 10 , base + 100);
+  FrameProfiler::EndFrame();
+
+  const ProfileFrame& frame = FrameProfiler::LastFrame();
+  ASSERT_EQ(frame.samples.size() , 4);
+  EXPECT_EQ(frame.samples[0].scope , outer);
+  EXPECT_EQ(frame.samples[1].scope , inner);
+  EXPECT_EQ(frame.samples[2].scope , leaf);
+  EXPECT_EQ(frame.samples[3].scope , sibling);
+
+  EXPECT_EQ(Find(frame , outer)->depth , 0);
+  EXPECT_EQ(Find(frame , inner)->depth , 1);
+  EXPECT_EQ(Find(frame , leaf)->depth , 2);
+
+  /// starts exactly where inner ends , so it is inner's sibling and not its child
+  EXPECT_EQ(Find(frame , sibling)->depth , 1);
+  EXPECT_EQ(FrameProfiler::ScopeName(sibling) , "nesting.sibling"sv);
+}
+
+TEST_F(FrameProfilerTests , stats_over_history) {
+  const uint32_t scope = FrameProfiler::RegisterScope("stats.scope");
+
+  /// frame i spends (i + 1) * 1000 ticks in the scope , split over two calls
+  constexpr uint32_t kFrames = 100;
+  for (uint32_t i = 0; i < kFrames; ++i) {
+    const uint64_t base = time::Ticks();
+    const uint64_t half = (i + 1) * 500;
+    FrameProfiler::Record(scope , base , base + half);
+    FrameProfiler::Record(scope , base + half , base + 2 * half);
+    FrameProfiler::EndFrame();
+  }
+
+  const auto stats = FrameProfiler::Stats();
+  ASSERT_EQ(stats.size() , 1);
+  const ProfileScopeStats& s = stats[0];
+  EXPECT_EQ(s.name , "stats.scope"sv);
+  EXPECT_EQ(s.calls , 2);
+  EXPECT_EQ(s.frames , kFrames);
+
+  constexpr double kTolerance = 1e-5;
+  EXPECT_NEAR(s.min_ms , TicksToMs(1000) , kTolerance);
+  EXPECT_NEAR(s.max_ms , TicksToMs(100000) , kTolerance);
+  EXPECT_NEAR(s.last_ms , TicksToMs(100000) , kTolerance);
+  EXPECT_NEAR(s.avg_ms , TicksToMs(50500) , kTolerance);
+  EXPECT_NEAR(s.p95_ms , TicksToMs(95000) , kTolerance);
+  EXPECT_NEAR(s.p99_ms , TicksToMs(99000) , kTolerance);
+
+  /// history is a window , old frames fall out of it
+  for (uint32_t i = 0; i < FrameProfiler::kHistoryFrames; ++i) {
+    const uint64_t base = time::Ticks();
+    FrameProfiler::Record(scope , base , base + 10);
+    FrameProfiler::EndFrame();
+  }
+  EXPECT_EQ(FrameProfiler::Stats()[0].frames , FrameProfiler::kHistoryFrames);
+  EXPECT_NEAR(FrameProfiler::Stats()[0].max_ms , TicksToMs(10) , kTolerance);
+}
+
+TEST_F(FrameProfilerTests , threads_record_into_their_own_rings) {
+  constexpr uint32_t kThreads = 4;
+  constexpr uint32_t kScopesPerThread = 1000;
+
+  /// nobody exits before everyone recorded , an exited thread's ring would be handed to the next one
+  std::latch done(kThreads);
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([t , &done]() {
+      OE_PROFILE_THREAD(fmtstr("Profiler Test {}" , t));
+      for (uint32_t i = 0; i < kScopesPerThread; ++i) {
+        OE_PROFILE_SCOPE("threads.work");
+      }
+      done.arrive_and_wait();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  FrameProfiler::EndFrame();
+
+  const uint32_t work = FrameProfiler::RegisterScope("threads.work");
+  std::map<uint32_t , uint32_t> per_thread;
+  for (const auto& sample : FrameProfiler::LastFrame().samples) {
+    EXPECT_EQ(sample.scope , work);
+    EXPECT_EQ(sample.depth , 0);
+    ++per_thread[sample.thread];
+  }
+
+  ASSERT_EQ(per_thread.size() , kThreads);
+  for (const auto& [thread , count] : per_thread) {
+    EXPECT_EQ(count , kScopesPerThread);
+    EXPECT_TRUE(FrameProfiler::ThreadName(thread).starts_with("Profiler Test"));
+  }
+}
+
+TEST_F(FrameProfilerTests , full_ring_drops_new_events) {
+  const uint32_t scope = FrameProfiler::RegisterScope("drop.scope");
+
+  /// a fresh thread gets a ring of its own , so nothing else on the test thread is in it
+  uint64_t dropped = 0;
+  std::thread writer([&]() {
+    const uint64_t before = FrameProfiler::Dropped();
+    for (uint32_t i = 0; i < ProfileRing::kCapacity + 10; ++i) {
+      FrameProfiler::Record(scope , i + 1 , i + 2);
+    }
+    dropped = FrameProfiler::Dropped() - before;
+  });
+  writer.join();
+
+  EXPECT_EQ(dropped , 10);
+  FrameProfiler::EndFrame();
+  EXPECT_EQ(FrameProfiler::LastFrame().samples.size() , ProfileRing::kCapacity);
+}
+
+TEST_F(FrameProfilerTests , chrome_trace) {
+  FrameProfiler::SetThreadName("Main \"Test\" Thread");
+  FrameProfiler::StartCapture(2);
+  for (uint32_t f = 0; f < 3; ++f) {
+    OE_PROFILE_SCOPE("trace.frame");
+    {
+      OE_PROFILE_SCOPE("trace.child");
+    }
+    FrameProfiler::EndFrame();
+  }
+  EXPECT_FALSE(FrameProfiler::Capturing());
+
+  const std::string json = FrameProfiler::ChromeTrace();
+  EXPECT_TRUE(json.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_TRUE(json.ends_with("]}\n"));
+  EXPECT_NE(json.find("Main \\\"Test\\\" Thread") , std::string::npos);
+
+  /// a frame scope closes after its EndFrame , so the two captured frames hold two children and only the first frame scope
+  size_t complete_events = 0;
+  for (size_t pos = json.find("\"ph\":\"X\""); pos != std::string::npos; pos = json.find("\"ph\":\"X\"" , pos + 1)) {
+    ++complete_events;
+  }
+  EXPECT_EQ(complete_events , 3);
+  EXPECT_NE(json.find("\"name\":\"trace.child\"") , std::string::npos);
+}
+
+TEST_F(FrameProfilerTests , disabled_scopes_record_nothing) {
+  /// roughly what one frame of engine zones records , the time this takes is the profiler.scope benchmark
+  constexpr uint32_t kBatch = 1024;
+  constexpr uint32_t kFrames = 8;
+
+  const uint32_t scope = FrameProfiler::RegisterScope("overhead.scope");
+
+  /// zones recorded per frame , every scope that ran shows up exactly once
+  auto run = [&]() {
+    std::vector<size_t> zones;
+    for (uint32_t f = 0; f < kFrames; ++f) {
+      for (uint32_t i = 0; i < kBatch; ++i) {
+        OE_PROFILE_SCOPE("overhead.scope");
+      }
+      FrameProfiler::EndFrame();
+
+      const auto& samples = FrameProfiler::LastFrame().samples;
+      zones.push_back(std::ranges::count_if(samples , [&](const ProfileSample& s) { return s.scope == scope; }));
+    }
+    return zones;
+  };
+
+  const uint64_t dropped = FrameProfiler::Dropped();
+  EXPECT_EQ(run() , std::vector<size_t>(kFrames , kBatch));
+
+  FrameProfiler::SetEnabled(false);
+  EXPECT_EQ(run() , std::vector<size_t>(kFrames , 0));
+
+  EXPECT_EQ(FrameProfiler::Dropped() , dropped);
+}
@@ -0,0 +1,172 @@
+/**
+ * \file unit_tests/frame_ring_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/defines.hpp"
+
+#include "rendering/frame_ring.hpp"
+#include "rendering/material.hpp"
+#include "rendering/pipeline.hpp"
+
+using namespace other;
+
+class FrameRingTests : public OtherTest {
+  public:
+    constexpr static size_t kAlignment = 64;
+
+    static Scope<FrameRing> MakeRing(size_t frame_size , HostFrameRingBackend** backend_out = nullptr) {
+      Scope<HostFrameRingBackend> backend = NewScope<HostFrameRingBackend>(kAlignment);
+      if (backend_out != nullptr) {
+        *backend_out = backend.get();
+      }
+      return NewScope<FrameRing>(std::move(backend) , frame_size);
+    }
+
+    static void Submit(FrameMeshes& meshes , uint64_t source , uint32_t count) {
+      MeshKey key{
+        .source_handle = source ,
+      };
+      auto& list = meshes[key];
+      for (uint32_t i = 0; i < count; ++i) {
+        glm::mat4 transform = glm::translate(glm::mat4(1.f) , glm::vec3(static_cast<float>(source) , static_cast<float>(i) , 0.f));
+        Material material{};
+        material.shininess = static_cast<float>(source * 100 + i);
+
+        list.cpu_model_storage.Append(transform);
+        list.cpu_material_storage.Append(material);
+        ++list.instance_count;
+      }
+    }
+};
+
+TEST_F(FrameRingTests , pack_instances_writes_every_instance_once) {
+  Scope<FrameRing> ring = MakeRing(4096);
+
+  FrameMeshes meshes;
+  Submit(meshes , 1 , 2);
+  Submit(meshes , 2 , 1);
+  Submit(meshes , 3 , 3);
+
+  ASSERT_TRUE(PackInstances(meshes , *ring));
+
+  size_t expected_bytes = 0;
+  uint32_t expected_base = 0;
+  for (const auto& [key , list] : meshes) {
+    EXPECT_EQ(list.base_instance , expected_base);
+    EXPECT_EQ(list.model_slice.offset % kAlignment , 0);
+    EXPECT_EQ(list.material_slice.offset % kAlignment , 0);
+    ASSERT_EQ(list.model_slice.size , list.instance_count * sizeof(glm::mat4));
+    ASSERT_EQ(list.material_slice.size , list.instance_count * sizeof(Material));
+
+    for (uint32_t i = 0; i < list.instance_count; ++i) {
+      glm::mat4 transform;
+      std::memcpy(&transform , list.model_slice.data + i * sizeof(glm::mat4) , sizeof(glm::mat4));
+      EXPECT_EQ(transform[3] , glm::vec4(static_cast<float>(key.source_handle.Get()) , static_cast<float>(i) , 0.f , 1.f));
+
+      Material material;
+      std::memcpy(&material , list.material_slice.data + i * sizeof(Material) , sizeof(Material));
+      EXPECT_EQ(material.shininess , static_cast<float>(key.source_handle.Get() * 100 + i));
+    }
+
+    expected_base += list.instance_count;
+    expected_bytes += ring->AlignedSize(list.model_slice.size) + ring->AlignedSize(list.material_slice.size);
+  }
+
+  EXPECT_EQ(ring->BytesUploaded() , expected_bytes);
+  ring->EndFrame();
+  EXPECT_EQ(ring->Stats().bytes_uploaded , expected_bytes);
+  EXPECT_EQ(ring->Stats().frames , 1);
+}
+
+TEST_F(FrameRingTests , frames_in_flight_use_separate_regions) {
+  HostFrameRingBackend* backend = nullptr;
+  Scope<FrameRing> ring = MakeRing(256 , &backend);
+
+  std::vector<size_t> offsets;
+  for (uint32_t f = 0; f < kFramesInFlight; ++f) {
+    ring->BeginFrame();
+    Opt<FrameRingSlice> slice = ring->Allocate(128);
+    ASSERT_TRUE(slice.has_value());
+    offsets.push_back(slice->offset);
+    ring->EndFrame();
+  }
+
+  /// nothing was reused yet so nobody had to wait on a fence
+  EXPECT_EQ(backend->NumWaits() , 0);
+  std::sort(offsets.begin() , offsets.end());
+  EXPECT_EQ(std::adjacent_find(offsets.begin() , offsets.end()) , offsets.end());
+
+  /// the next frame lands on the oldest region and has to wait for it
+  ring->BeginFrame();
+  Opt<FrameRingSlice> slice = ring->Allocate(128);
+  ASSERT_TRUE(slice.has_value());
+  EXPECT_EQ(backend->NumWaits() , 1);
+  EXPECT_NE(std::find(offsets.begin() , offsets.end() , slice->offset) , offsets.end());
+  ring->EndFrame();
+}
+
+TEST_F(FrameRingTests , clearing_keeps_instance_storage) {
+  Scope<FrameRing> ring = MakeRing(4096);
+
+  FrameMeshes meshes;
+  Submit(meshes , 1 , 4);
+  Submit(meshes , 2 , 2);
+  ASSERT_TRUE(PackInstances(meshes , *ring));
+  ring->EndFrame();
+
+  std::vector<const glm::mat4*> models;
+  std::vector<const Material*> materials;
+  for (const auto& [key , list] : meshes) {
+    models.push_back(list.cpu_model_storage.Data());
+    materials.push_back(list.cpu_material_storage.Data());
+  }
+
+  ClearInstances(meshes);
+  ASSERT_EQ(meshes.size() , 2);
+  for (const auto& [key , list] : meshes) {
+    EXPECT_EQ(list.instance_count , 0);
+    EXPECT_TRUE(list.cpu_model_storage.Empty());
+    EXPECT_TRUE(list.cpu_material_storage.Empty());
+  }
+
+  /// the same models next frame land in the same allocations
+  Submit(meshes , 1 , 4);
+  Submit(meshes , 2 , 2);
+  ASSERT_TRUE(PackInstances(meshes , *ring));
+  ring->EndFrame();
+
+  ASSERT_EQ(meshes.size() , 2);
+  size_t i = 0;
+  for (const auto& [key , list] : meshes) {
+    EXPECT_EQ(list.instance_count , key.source_handle.Get() == 1 ? 4 : 2);
+    EXPECT_EQ(list.cpu_model_storage.Data() , models[i]);
+    EXPECT_EQ(list.cpu_material_storage.Data() , materials[i]);
+    ++i;
+  }
+}
+
+TEST_F(FrameRingTests , ring_grows_when_a_frame_does_not_fit) {
+  Scope<FrameRing> ring = MakeRing(kAlignment);
+
+  FrameMeshes meshes;
+  for (uint64_t source = 1; source <= 8; ++source) {
+    Submit(meshes , source , 10);
+  }
+
+  ASSERT_TRUE(PackInstances(meshes , *ring));
+  EXPECT_EQ(ring->Stats().reallocations , 1);
+  EXPECT_GE(ring->FrameCapacity() , ring->BytesUploaded());
+  ring->EndFrame();
+
+  /// without a size hint allocations past the end fail instead of overwriting the next region
+  ring->BeginFrame();
+  EXPECT_FALSE(ring->Allocate(ring->FrameCapacity() + 1).has_value());
+  ring->EndFrame();
+}
@@ -0,0 +1,126 @@
+/**
+ * \file unit_tests/instance_buffer_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "core/instance_buffer.hpp"
+
+using namespace other;
+
+class InstanceBufferTests : public OtherTest {
+  public:
+    static void SetUpTestSuite() {
+      OtherTest::SetUpTestSuite();
+      OpenLog();
+    }
+};
+
+TEST_F(InstanceBufferTests , append_and_bulk_append) {
+  InstanceBuffer<glm::mat4> buffer;
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_EQ(buffer.Data() , nullptr);
+
+  buffer.Append(glm::mat4(1.f));
+  ASSERT_EQ(buffer.Size() , 1);
+  EXPECT_EQ(buffer.Capacity() , InstanceBuffer<glm::mat4>::kMinCapacity);
+
+  std::vector<glm::mat4> transforms;
+  for (uint32_t i = 0; i < 100; ++i) {
+    transforms.push_back(glm::mat4(static_cast<float>(i)));
+  }
+  buffer.Append(transforms);
+
+  ASSERT_EQ(buffer.Size() , 101);
+  EXPECT_EQ(buffer.Bytes() , 101 * sizeof(glm::mat4));
+  EXPECT_EQ(buffer[0] , glm::mat4(1.f));
+  for (uint32_t i = 0; i < 100; ++i) {
+    ASSERT_EQ(buffer[i + 1] , glm::mat4(static_cast<float>(i)));
+  }
+  EXPECT_EQ(buffer.View().size_bytes() , buffer.Bytes());
+}
+
+TEST_F(InstanceBufferTests , clear_keeps_storage) {
+  InstanceBuffer<uint32_t> buffer(1000);
+  EXPECT_EQ(buffer.Capacity() , 1000);
+  const uint32_t* storage = buffer.Data();
+
+  for (uint32_t frame = 0; frame < 3; ++frame) {
+    for (uint32_t i = 0; i < 1000; ++i) {
+      buffer.Append(i);
+    }
+    EXPECT_EQ(buffer.Size() , 1000);
+    buffer.Clear();
+  }
+
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_EQ(buffer.Data() , storage);
+  EXPECT_EQ(buffer.Capacity() , 1000);
+
+  /// reserving less than the capacity is a no-op
+  buffer.Reserve(10);
+  EXPECT_EQ(buffer.Data() , storage);
+}
+
+TEST_F(InstanceBufferTests , grow_zeroes_only_when_asked) {
+  InstanceBuffer<uint32_t> buffer;
+  std::span<uint32_t> first = buffer.Grow(8);
+  std::ranges::fill(first , 0xFFFFFFFFu);
+  buffer.Clear();
+
+  /// same storage handed back , left as it was
+  std::span<uint32_t> reused = buffer.Grow(8);
+  EXPECT_EQ(reused[3] , 0xFFFFFFFFu);
+  buffer.Clear();
+
+  std::span<uint32_t> zeroed = buffer.Grow(8 , true);
+  for (uint32_t v : zeroed) {
+    EXPECT_EQ(v , 0u);
+  }
+  EXPECT_EQ(buffer.Size() , 8);
+}
+
+TEST_F(InstanceBufferTests , move_steals_storage) {
+  InstanceBuffer<glm::vec4> buffer;
+  buffer.Append(glm::vec4(1.f));
+  buffer.Append(glm::vec4(2.f));
+  const glm::vec4* storage = buffer.Data();
+
+  InstanceBuffer<glm::vec4> moved(std::move(buffer));
+  EXPECT_EQ(moved.Data() , storage);
+  EXPECT_EQ(moved.Size() , 2);
+  EXPECT_EQ(buffer.Data() , nullptr);
+  EXPECT_EQ(buffer.Size() , 0);
+
+  InstanceBuffer<glm::vec4> assigned(4);
+  assigned = std::move(moved);
+  EXPECT_EQ(assigned.Data() , storage);
+  EXPECT_EQ(assigned[1] , glm::vec4(2.f));
+  EXPECT_EQ(moved.Capacity() , 0);
+}
+
+TEST_F(InstanceBufferTests , append_scales_linearly) {
+  auto fill = [](uint32_t count) {
+    InstanceBuffer<glm::mat4> buffer;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < count; ++i) {
+      buffer.Append(glm::mat4(static_cast<float>(i)));
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(buffer.Size() , count);
+    return std::chrono::duration<double , std::milli>(end - start).count();
+  };
+
+  fill(1000);
+  const double quarter_ms = fill(250'000);
+  const double full_ms = fill(1'000'000);
+  println("InstanceBuffer::Append : 250k appends {:.2f} ms | 1M appends {:.2f} ms" , quarter_ms , full_ms);
+
+  EXPECT_LT(full_ms , 8.0 * quarter_ms);
+}
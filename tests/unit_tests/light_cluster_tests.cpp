@@ -0,0 +1,275 @@
+/**
+ * \file unit_tests/light_cluster_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/config_keys.hpp"
+#include "core/defines.hpp"
+#include "core/ref.hpp"
+#include "core/thread_pool.hpp"
+
+#include "scene/environment.hpp"
+#include "rendering/light_clusters.hpp"
+
+using namespace std::string_view_literals;
+using namespace other;
+
+class LightClusterTests : public OtherTest {
+  public:
+    constexpr static float kNear = 0.1f;
+    constexpr static float kFar = 100.f;
+    constexpr static uint32_t kNumBenchLights = 10000;
+    constexpr static uint32_t kNumBenchMoves = 16;
+
+    static void SetUpTestSuite() {
+      OtherTest::SetUpTestSuite();
+      OpenLog();
+
+      ConfigTable cluster_config = config;
+      cluster_config.Add(kThreadPoolSection , kWorkersValue , "3");
+      ThreadPool::Initialize(cluster_config);
+    }
+
+    static void TearDownTestSuite() {
+      ThreadPool::Shutdown();
+      OtherTest::TearDownTestSuite();
+    }
+
+    /// camera at the origin looking down -z so view space and world space match
+    static glm::mat4 View() {
+      return glm::lookAt(glm::vec3{ 0.f } , glm::vec3{ 0.f , 0.f , -1.f } , glm::vec3{ 0.f , 1.f , 0.f });
+    }
+
+    static glm::mat4 Projection() {
+      return glm::perspective(glm::radians(90.f) , 16.f / 9.f , kNear , kFar);
+    }
+
+    static glm::vec2 Clip() {
+      return { kNear , kFar };
+    }
+
+    static PointLight MakeLight(const glm::vec3& position , float radius) {
+      PointLight light;
+      light.position = glm::vec4(position , 1.f);
+      light.radius = radius;
+      return light;
+    }
+
+    static PointLight RandomLight(std::mt19937& rng) {
+      std::uniform_real_distribution<float> lateral(-40.f , 40.f);
+      std::uniform_real_distribution<float> depth(-90.f , -1.f);
+      std::uniform_real_distribution<float> radius(0.5f , 4.f);
+      return MakeLight({ lateral(rng) , lateral(rng) * 0.5f , depth(rng) } , radius(rng));
+    }
+
+    static bool ClusterHasLight(const LightClusters& clusters , uint32_t cluster , uint32_t light) {
+      for (uint32_t l : clusters.ClusterLights(cluster)) {
+        if (l == light) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    static void ExpectSameClusters(const LightClusters& a , const LightClusters& b) {
+      ASSERT_EQ(a.Clusters().size() , b.Clusters().size());
+      ASSERT_EQ(a.LightIndices().size() , b.LightIndices().size());
+      for (uint32_t c = 0; c < a.Clusters().size(); ++c) {
+        auto a_lights = a.ClusterLights(c);
+        auto b_lights = b.ClusterLights(c);
+        ASSERT_TRUE(std::equal(a_lights.begin() , a_lights.end() , b_lights.begin() , b_lights.end())) << "cluster " << c;
+      }
+    }
+};
+
+TEST_F(LightClusterTests , light_lands_in_expected_clusters) {
+  Environment environment;
+  environment.SetLight(1 , MakeLight({ 0.f , 0.f , -10.f } , 0.5f));
+
+  LightClusters clusters;
+  LightClusterStats stats = clusters.Build(environment , View() , Projection() , Clip());
+  EXPECT_EQ(stats.lights , 1);
+  EXPECT_EQ(stats.visible_lights , 1);
+  EXPECT_EQ(stats.indices , clusters.LightIndices().size());
+
+  const LightClusterGrid& grid = clusters.Grid();
+  const uint32_t near_slice = clusters.DepthSlice(9.5f);
+  const uint32_t far_slice = clusters.DepthSlice(10.5f);
+
+  /// the light sits dead center so it touches the middle tiles and nothing near the screen edges
+  EXPECT_TRUE(ClusterHasLight(clusters , clusters.ClusterIndex(grid.x / 2 , grid.y / 2 , clusters.DepthSlice(10.f)) , 0));
+  EXPECT_TRUE(ClusterHasLight(clusters , clusters.ClusterIndex(grid.x / 2 - 1 , grid.y / 2 , clusters.DepthSlice(10.f)) , 0));
+
+  for (uint32_t z = 0; z < grid.z; ++z) {
+    for (uint32_t y = 0; y < grid.y; ++y) {
+      for (uint32_t x = 0; x < grid.x; ++x) {
+        if (!ClusterHasLight(clusters , clusters.ClusterIndex(x , y , z) , 0)) {
+          continue;
+        }
+
+        EXPECT_GE(z , near_slice);
+        EXPECT_LE(z , far_slice);
+        EXPECT_GE(x , grid.x / 2 - 2);
+        EXPECT_LE(x , grid.x / 2 + 1);
+        EXPECT_GE(y , grid.y / 2 - 1);
+        EXPECT_LE(y , grid.y / 2 + 1);
+      }
+    }
+  }
+}
+
+TEST_F(LightClusterTests , lights_outside_frustum_are_culled) {
+  Environment environment;
+  environment.SetLight(1 , MakeLight({ 0.f , 0.f , 5.f } , 1.f));
+  environment.SetLight(2 , MakeLight({ 0.f , 0.f , -200.f } , 1.f));
+  environment.SetLight(3 , MakeLight({ 500.f , 0.f , -10.f } , 1.f));
+  environment.SetLight(4 , MakeLight({ 0.f , 0.f , -10.f } , 0.f));
+
+  LightClusters clusters;
+  LightClusterStats stats = clusters.Build(environment , View() , Projection() , Clip());
+  EXPECT_EQ(stats.lights , 4);
+  EXPECT_EQ(stats.visible_lights , 0);
+  EXPECT_EQ(stats.indices , 0);
+  for (const auto& cluster : clusters.Clusters()) {
+    EXPECT_EQ(cluster.count , 0);
+  }
+}
+
+TEST_F(LightClusterTests , cluster_lists_are_compact_and_sorted) {
+  std::mt19937 rng(11);
+  Environment environment;
+  for (uint32_t i = 0; i < 500; ++i) {
+    environment.SetLight(i , RandomLight(rng));
+  }
+
+  LightClusters clusters;
+  LightClusterStats stats = clusters.Build(environment , View() , Projection() , Clip());
+  ASSERT_GT(stats.indices , 0);
+
+  uint32_t offset = 0;
+  for (const auto& cluster : clusters.Clusters()) {
+    EXPECT_EQ(cluster.offset , offset);
+    offset += cluster.count;
+  }
+  EXPECT_EQ(offset , clusters.LightIndices().size());
+
+  for (uint32_t c = 0; c < clusters.Clusters().size(); ++c) {
+    auto lights = clusters.ClusterLights(c);
+    EXPECT_TRUE(std::is_sorted(lights.begin() , lights.end()));
+    EXPECT_EQ(std::adjacent_find(lights.begin() , lights.end()) , lights.end());
+  }
+}
+
+TEST_F(LightClusterTests , incremental_build_matches_full_build) {
+  std::mt19937 rng(3);
+  Environment environment;
+  for (uint32_t i = 0; i < 2000; ++i) {
+    environment.SetLight(i , RandomLight(rng));
+  }
+
+  LightClusters incremental;
+  LightClusterStats stats = incremental.Build(environment , View() , Projection() , Clip());
+  EXPECT_EQ(stats.rebinned_lights , 2000);
+
+  environment.SetLight(7 , RandomLight(rng));
+  environment.SetLight(1500 , RandomLight(rng));
+  stats = incremental.Build(environment , View() , Projection() , Clip());
+  EXPECT_EQ(stats.rebinned_lights , 2);
+  EXPECT_LT(stats.rebinned_slices , incremental.Grid().z);
+
+  {
+    LightClusters full;
+    full.Build(environment , View() , Projection() , Clip());
+    ExpectSameClusters(incremental , full);
+  }
+
+  /// removal moves the last light into the hole, only that slot needs binning again
+  environment.RemoveLight(42);
+  stats = incremental.Build(environment , View() , Projection() , Clip());
+  EXPECT_EQ(stats.lights , 1999);
+  EXPECT_EQ(stats.rebinned_lights , 1);
+
+  {
+    LightClusters full;
+    full.Build(environment , View() , Projection() , Clip());
+    ExpectSameClusters(incremental , full);
+  }
+
+  glm::mat4 moved_view = glm::translate(View() , glm::vec3{ 1.f , 0.f , 0.f });
+  stats = incremental.Build(environment , moved_view , Projection() , Clip());
+  EXPECT_EQ(stats.rebinned_lights , 1999);
+  EXPECT_EQ(stats.rebinned_slices , incremental.Grid().z);
+}
+
+TEST_F(LightClusterTests , environment_swap_remove_keeps_owners) {
+  Environment environment;
+  environment.SetLight(10 , MakeLight({ 1.f , 0.f , 0.f } , 1.f));
+  environment.SetLight(20 , MakeLight({ 2.f , 0.f , 0.f } , 1.f));
+  environment.SetLight(30 , MakeLight({ 3.f , 0.f , 0.f } , 1.f));
+  environment.SetLight(40 , DirectionLight{});
+  ASSERT_EQ(environment.point_lights.size() , 3);
+  ASSERT_EQ(environment.direction_lights.size() , 1);
+
+  environment.RemoveLight(10);
+  ASSERT_EQ(environment.point_lights.size() , 2);
+  EXPECT_EQ(environment.point_lights[0].position.x , 3.f);
+
+  /// 30 now lives in the first slot, updating it must not touch 20
+  environment.SetLight(30 , MakeLight({ 5.f , 0.f , 0.f } , 1.f));
+  EXPECT_EQ(environment.point_lights[0].position.x , 5.f);
+  EXPECT_EQ(environment.point_lights[1].position.x , 2.f);
+
+  /// changing type moves the light between lists
+  environment.SetLight(20 , DirectionLight{});
+  EXPECT_EQ(environment.point_lights.size() , 1);
+  EXPECT_EQ(environment.direction_lights.size() , 2);
+
+  environment.RemoveLight(40);
+  environment.RemoveLight(20);
+  environment.RemoveLight(99);
+  EXPECT_TRUE(environment.direction_lights.empty());
+  EXPECT_EQ(environment.PointLightVersions().size() , environment.point_lights.size());
+}
+
+TEST_F(LightClusterTests , build_throughput) {
+  std::mt19937 rng(5);
+  Environment environment;
+  for (uint32_t i = 0; i < kNumBenchLights; ++i) {
+    environment.SetLight(i , RandomLight(rng));
+  }
+
+  LightClusters clusters;
+  LightClusterStats stats = clusters.Build(environment , View() , Projection() , Clip());
+  ASSERT_GT(stats.visible_lights , 0);
+
+  /// alternate between two views so every build re-bins everything
+  constexpr uint32_t kNumBuilds = 20;
+  glm::mat4 views[2] = { View() , glm::translate(View() , glm::vec3{ 0.f , 0.f , 0.5f }) };
+
+  double full_ms = 0.0;
+  for (uint32_t i = 0; i < kNumBuilds; ++i) {
+    full_ms += clusters.Build(environment , views[i % 2] , Projection() , Clip()).build_ms;
+  }
+  full_ms /= kNumBuilds;
+
+  double incremental_ms = 0.0;
+  for (uint32_t i = 0; i < kNumBuilds; ++i) {
+    for (uint32_t m = 0; m < kNumBenchMoves; ++m) {
+      environment.SetLight(rng() % kNumBenchLights , RandomLight(rng));
+    }
+    stats = clusters.Build(environment , views[1] , Projection() , Clip());
+    ASSERT_LE(stats.rebinned_lights , kNumBenchMoves);
+    incremental_ms += stats.build_ms;
+  }
+  incremental_ms /= kNumBuilds;
+
+  other::println("{} lights into {} clusters : {:.3f} ms full | {:.3f} ms with {} moved | {} indices on {} workers"sv ,
+                 kNumBenchLights , clusters.Grid().NumClusters() , full_ms , incremental_ms , kNumBenchMoves ,
+                 stats.indices , ThreadPool::Get()->NumWorkers());
+}
@@ -0,0 +1,113 @@
+/**
+ * \file unit_tests/lua_gc_tests.cpp
+ **/
+#include <gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <sol/sol.hpp>
+
+#include "core/defines.hpp"
+#include "core/ref.hpp"
+
+#include "scripting/lua/lua_allocator.hpp"
+#include "scripting/lua/lua_module.hpp"
+#include "scripting/lua/lua_object.hpp"
+
+#include "oetest.hpp"
+
+using namespace std::string_view_literals;
+using namespace other;
+
+class LuaGcTests : public OtherTest {
+  public:
+    constexpr static uint32_t kBudgetUs = 500;
+    constexpr static uint32_t kNumFrames = 600;
+
+    /// p99 pause allowed over the budget , loose enough for a loaded machine
+    constexpr static uint32_t kPauseBoundFactor = 4;
+};
+
+TEST_F(LuaGcTests , allocator_module_accounting) {
+  LuaAllocator allocator;
+  {
+    sol::state state(sol::default_at_panic , &LuaAllocator::Allocate , &allocator);
+    ASSERT_EQ(LuaAllocator::FromState(state.lua_state()) , &allocator);
+
+    const size_t core_bytes = allocator.TotalStats().live_bytes;
+    EXPECT_GT(core_bytes , 0u);
+
+    /// the global slot and its key string outlive the table , declared outside of any module so neither is charged
+    state.script("module_a = false");
+
+    {
+      LuaAllocator::ScopedModule scope(&allocator , FNV("ModuleA"sv));
+      state.script("module_a = {} for i = 1, 1000 do module_a[i] = { i } end");
+    }
+    EXPECT_EQ(allocator.ActiveModule() , UUID(0));
+    EXPECT_GT(allocator.ModuleStats(FNV("ModuleA"sv)).live_bytes , 0u);
+    EXPECT_EQ(allocator.ModuleStats(FNV("ModuleB"sv)).live_bytes , 0u);
+
+    /// freed while another module is active, still credited back to module a
+    {
+      LuaAllocator::ScopedModule scope(&allocator , FNV("ModuleB"sv));
+      state.script("module_a = nil");
+      state.collect_garbage();
+    }
+    EXPECT_EQ(allocator.ModuleStats(FNV("ModuleA"sv)).live_bytes , 0u);
+  }
+
+  EXPECT_EQ(allocator.TotalStats().live_bytes , 0u);
+  EXPECT_EQ(allocator.TotalStats().num_allocations , allocator.TotalStats().num_frees);
+}
+
+TEST_F(LuaGcTests , budgeted_steps_bound_pause_p99) {
+  Ref<LuaModule> lua = NewRef<LuaModule>();
+  ASSERT_TRUE(lua->Initialize());
+  lua->SetGcBudget(kBudgetUs);
+
+  Ref<ScriptModule> script = lua->LoadScriptModule({
+    .name = "GcStress",
+    .path = "./tests/scripts/lua/gc_stress.lua",
+  });
+  ASSERT_NE(script , nullptr);
+
+  Ref<LuaObject> obj = script->GetScriptObject<LuaObject>("GcStress");
+  ASSERT_NE(obj , nullptr);
+
+  std::vector<double> pauses_us;
+  pauses_us.reserve(kNumFrames);
+  for (uint32_t i = 0; i < kNumFrames; ++i) {
+    obj->Update(0.016f);
+
+    const auto start = std::chrono::steady_clock::now();
+    lua->StepGarbageCollector();
+    const auto end = std::chrono::steady_clock::now();
+    pauses_us.push_back(std::chrono::duration<double , std::micro>(end - start).count());
+  }
+
+  std::ranges::sort(pauses_us);
+  const double p50 = pauses_us[pauses_us.size() / 2];
+  const double p99 = pauses_us[static_cast<size_t>(0.99 * static_cast<double>(pauses_us.size() - 1))];
+
+  const auto& stats = lua->GetGcStats();
+  println("lua gc pause : p50 {:.1f}us | p99 {:.1f}us | max {:.1f}us | budget {}us | cycles {} | full {}"sv ,
+          p50 , p99 , pauses_us.back() , kBudgetUs , stats.cycles , stats.full_collections);
+
+  /// a step overshoots the budget by at most one incremental step , anything near a full collection is a regression
+  EXPECT_LE(p99 , static_cast<double>(kBudgetUs * kPauseBoundFactor));
+
+  /// the budget keeps up with the script by itself , the emergency full collection is a fallback and not what bounds
+  ///   the heap here
+  EXPECT_GT(stats.cycles , 0u);
+  EXPECT_LE(stats.full_collections , kNumFrames / 100);
+
+  EXPECT_EQ(stats.frames , kNumFrames);
+  EXPECT_GT(lua->GetAllocator().ModuleStats(FNV("GcStress"sv)).live_bytes , 0u);
+
+  obj = nullptr;
+  script = nullptr;
+  lua->Shutdown();
+}
@@ -0,0 +1,524 @@
+/**
+ * \file unit_tests/physics_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <random>
+
+#include <entt/entt.hpp>
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/Memory.h>
+#include <box2d/b2_body.h>
+#include <box2d/b2_polygon_shape.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+
+#include "core/config_keys.hpp"
+#include "core/defines.hpp"
+#include "core/platform.hpp"
+#include "core/ref.hpp"
+#include "core/thread_pool.hpp"
+
+#include "ecs/components/tag.hpp"
+#include "ecs/components/transform.hpp"
+#include "ecs/components/rigid_body.hpp"
+#include "ecs/components/collider.hpp"
+#include "ecs/systems/core_systems.hpp"
+
+#include "physics/phyics_engine.hpp"
+#include "physics/physics_sync.hpp"
+#include "physics/physics_queries.hpp"
+
+using namespace std::string_view_literals;
+using namespace other;
+
+namespace {
+
+  /// live allocations made through Jolt's allocator hooks while counting is installed
+  std::atomic<int64_t> jolt_live_allocations = 0;
+
+  JPH::AllocateFunction jolt_allocate = nullptr;
+  JPH::ReallocateFunction jolt_reallocate = nullptr;
+  JPH::FreeFunction jolt_free = nullptr;
+  JPH::AlignedAllocateFunction jolt_aligned_allocate = nullptr;
+  JPH::AlignedFreeFunction jolt_aligned_free = nullptr;
+
+  void InstallJoltAllocationCounter() {
+    jolt_allocate = JPH::Allocate;
+    jolt_reallocate = JPH::Reallocate;
+    jolt_free = JPH::Free;
+    jolt_aligned_allocate = JPH::AlignedAllocate;
+    jolt_aligned_free = JPH::AlignedFree;
+
+    JPH::Allocate = [](size_t size) -> void* {
+      ++jolt_live_allocations;
+      return jolt_allocate(size);
+    };
+    JPH::Reallocate = [](void* block , size_t old_size , size_t new_size) -> void* {
+      if (block == nullptr) {
+        ++jolt_live_allocations;
+      }
+      return jolt_reallocate(block , old_size , new_size);
+    };
+    JPH::Free = [](void* block) {
+      if (block != nullptr) {
+        --jolt_live_allocations;
+      }
+      jolt_free(block);
+    };
+    JPH::AlignedAllocate = [](size_t size , size_t alignment) -> void* {
+      ++jolt_live_allocations;
+      return jolt_aligned_allocate(size , alignment);
+    };
+    JPH::AlignedFree = [](void* block) {
+      if (block != nullptr) {
+        --jolt_live_allocations;
+      }
+      jolt_aligned_free(block);
+    };
+  }
+
+  void RemoveJoltAllocationCounter() {
+    JPH::Allocate = jolt_allocate;
+    JPH::Reallocate = jolt_reallocate;
+    JPH::Free = jolt_free;
+    JPH::AlignedAllocate = jolt_aligned_allocate;
+    JPH::AlignedFree = jolt_aligned_free;
+  }
+
+  /// -1 where the platform gives no cheap way to count
+  int64_t NumProcessThreads() {
+#ifdef OE_LINUX
+    int64_t count = 0;
+    for ([[maybe_unused]] const auto& entry : std::filesystem::directory_iterator("/proc/self/task")) {
+      ++count;
+    }
+    return count;
+#else
+    return -1;
+#endif
+  }
+
+} // anonymous namespace
+
+class PhysicsTests : public OtherTest {
+  public:
+    constexpr static float kFrame = 1.f / 60.f;
+    constexpr static uint32_t kNumBenchBodies = 10000;
+    constexpr static uint32_t kNumBenchFrames = 60;
+    constexpr static uint32_t kNumBenchQueries = 10000;
+
+    static void SetUpTestSuite() {
+      OtherTest::SetUpTestSuite();
+      OpenLog();
+
+      /// always run with real workers so the job system adapter is exercised on any machine
+      ConfigTable physics_config = config;
+      physics_config.Add(kThreadPoolSection , kWorkersValue , "3");
+
+      ThreadPool::Initialize(physics_config);
+      PhysicsEngine::Initialize(physics_config);
+    }
+
+    static void TearDownTestSuite() {
+      PhysicsEngine::Shutdown();
+      ThreadPool::Shutdown();
+      OtherTest::TearDownTestSuite();
+    }
+
+    static entt::entity CreateBody(entt::registry& registry , Ref<PhysicsWorld>& world , PhysicsBodyType type ,
+                                   const glm::vec3& position , const glm::vec3& scale ,
+                                   const Collider* collider = nullptr) {
+      entt::entity entity = registry.create();
+
+      auto& tag = registry.emplace<Tag>(entity , fmtstr("body {}" , static_cast<uint32_t>(entity)));
+      tag.handle = entity;
+
+      auto& transform = registry.emplace<Transform>(entity , position);
+      transform.scale = scale;
+      transform.CalcMatrix();
+
+      auto& body = registry.emplace<RigidBody>(entity);
+      body.type = type;
+      InitializeRigidBody(world , body , tag , transform , collider);
+      return entity;
+    }
+};
+
+TEST_F(PhysicsTests , fixed_timestep_accumulates) {
+  FixedTimestep timestep(60 , 4);
+  EXPECT_FLOAT_EQ(timestep.Step() , 1.f / 60.f);
+
+  EXPECT_EQ(timestep.Advance(1.f / 120.f) , 0u);
+  EXPECT_NEAR(timestep.Alpha() , 0.5f , 1e-4f);
+
+  EXPECT_EQ(timestep.Advance(1.f / 120.f) , 1u);
+  EXPECT_NEAR(timestep.Alpha() , 0.f , 1e-4f);
+
+  EXPECT_EQ(timestep.Advance(2.5f / 60.f) , 2u);
+  EXPECT_NEAR(timestep.Alpha() , 0.5f , 1e-4f);
+
+  /// a long hitch is clamped to max steps and the rest is dropped
+  EXPECT_EQ(timestep.Advance(1.f) , 4u);
+  EXPECT_FLOAT_EQ(timestep.Alpha() , 0.f);
+
+  EXPECT_EQ(timestep.Advance(-1.f) , 0u);
+}
+
+TEST_F(PhysicsTests , sync_interpolates_active_bodies) {
+  Ref<PhysicsWorld> world = PhysicsEngine::GetPhysicsWorld();
+  entt::registry registry;
+
+  entt::entity ground = CreateBody(registry , world , STATIC , { 0.f , -1.f , 0.f } , { 100.f , 2.f , 100.f });
+  entt::entity box = CreateBody(registry , world , DYNAMIC , { 0.f , 10.f , 0.f } , { 1.f , 1.f , 1.f });
+  world->OptimizeBroadPhase();
+
+  PhysicsSync sync(60 , 8);
+
+  /// half a step, nothing simulated and nothing written
+  PhysicsSyncStats stats = sync.Update(registry , world.Raw() , nullptr , kFrame * 0.5f);
+  EXPECT_EQ(stats.steps , 0u);
+  EXPECT_FLOAT_EQ(registry.get<Transform>(box).position.y , 10.f);
+
+  stats = sync.Update(registry , world.Raw() , nullptr , kFrame);
+  EXPECT_EQ(stats.steps , 1u);
+  EXPECT_EQ(stats.synced_bodies , 1u);
+  EXPECT_NEAR(stats.alpha , 0.5f , 1e-3f);
+
+  const auto& body = registry.get<RigidBody>(box);
+  const auto& transform = registry.get<Transform>(box);
+  EXPECT_LT(body.curr_position.y , body.prev_position.y);
+
+  /// rendered pose sits halfway between the last two steps
+  const float expected = body.prev_position.y + (body.curr_position.y - body.prev_position.y) * 0.5f;
+  EXPECT_NEAR(transform.position.y , expected , 1e-4f);
+
+  /// static bodies are never active so the sync never touches them
+  EXPECT_FLOAT_EQ(registry.get<Transform>(ground).position.y , -1.f);
+  EXPECT_EQ(registry.get<RigidBody>(ground).last_active_step , 0u);
+
+  /// fall for a few seconds, the box must come to rest on the ground and leave the active set
+  for (uint32_t i = 0; i < 600; ++i) {
+    stats = sync.Update(registry , world.Raw() , nullptr , kFrame);
+  }
+
+  EXPECT_EQ(world->NumActiveBodies() , 0u);
+  EXPECT_EQ(stats.synced_bodies , 0u);
+  EXPECT_NEAR(transform.position.y , 0.5f , 0.05f);
+  EXPECT_EQ(transform.position , body.curr_position);
+}
+
+TEST_F(PhysicsTests , bodies_take_their_shape_from_the_collider) {
+  Transform transform;
+  transform.scale = { 2.f , 4.f , 6.f };
+
+  /// no collider , a box the size of the transform
+  JPH::Ref<JPH::Shape> shape = CreateColliderShape(nullptr , transform);
+  ASSERT_NE(shape , nullptr);
+  ASSERT_EQ(shape->GetSubType() , JPH::EShapeSubType::Box);
+  EXPECT_TRUE(static_cast<const JPH::BoxShape*>(shape.GetPtr())->GetHalfExtent().IsClose(JPH::Vec3(1.f , 2.f , 3.f)));
+
+  Collider collider;
+  collider.shape = SPHERE_COLLIDER;
+  shape = CreateColliderShape(&collider , transform);
+  ASSERT_EQ(shape->GetSubType() , JPH::EShapeSubType::Sphere);
+  EXPECT_FLOAT_EQ(static_cast<const JPH::SphereShape*>(shape.GetPtr())->GetRadius() , 3.f);
+
+  transform.scale = glm::vec3(1.f);
+  collider.shape = CAPSULE_COLLIDER;
+  collider.size = { 1.f , 3.f , 1.f };
+  shape = CreateColliderShape(&collider , transform);
+  ASSERT_EQ(shape->GetSubType() , JPH::EShapeSubType::Capsule);
+  EXPECT_FLOAT_EQ(static_cast<const JPH::CapsuleShape*>(shape.GetPtr())->GetRadius() , 0.5f);
+  EXPECT_FLOAT_EQ(static_cast<const JPH::CapsuleShape*>(shape.GetPtr())->GetHalfHeightOfCylinder() , 1.f);
+
+  /// no taller than it is wide , nothing is left of the cylinder
+  collider.size = glm::vec3(1.f);
+  EXPECT_EQ(CreateColliderShape(&collider , transform)->GetSubType() , JPH::EShapeSubType::Sphere);
+
+  collider.offset = { 0.f , 1.f , 0.f };
+  EXPECT_EQ(CreateColliderShape(&collider , transform)->GetSubType() , JPH::EShapeSubType::RotatedTranslated);
+
+  collider.shape = INVALID_COLLIDER_SHAPE;
+  EXPECT_EQ(CreateColliderShape(&collider , transform) , nullptr);
+
+  /// a sphere two units across comes to rest one unit above the ground instead of half a unit like a unit box
+  Ref<PhysicsWorld> world = PhysicsEngine::GetPhysicsWorld();
+  entt::registry registry;
+
+  Collider sphere;
+  sphere.shape = SPHERE_COLLIDER;
+  sphere.size = glm::vec3(2.f);
+  CreateBody(registry , world , STATIC , { 0.f , -1.f , 0.f } , { 100.f , 2.f , 100.f });
+  entt::entity ball = CreateBody(registry , world , DYNAMIC , { 0.f , 5.f , 0.f } , { 1.f , 1.f , 1.f } , &sphere);
+  ASSERT_FALSE(registry.get<RigidBody>(ball).body_id.IsInvalid());
+  world->OptimizeBroadPhase();
+
+  PhysicsSync sync(60 , 8);
+  for (uint32_t i = 0; i < 600; ++i) {
+    sync.Update(registry , world.Raw() , nullptr , kFrame);
+  }
+  EXPECT_NEAR(registry.get<Transform>(ball).position.y , 1.f , 0.05f);
+}
+
+TEST_F(PhysicsTests , step_and_sync_10k_bodies) {
+  Ref<PhysicsWorld> world = PhysicsEngine::GetPhysicsWorld();
+  entt::registry registry;
+
+  CreateBody(registry , world , STATIC , { 0.f , -1.f , 0.f } , { 500.f , 2.f , 500.f });
+
+  /// spaced out so nothing touches until they land
+  const uint32_t side = 100;
+  for (uint32_t i = 0; i < kNumBenchBodies; ++i) {
+    glm::vec3 position{
+      static_cast<float>(i % side) * 2.f - side ,
+      5.f + static_cast<float>(i % 7) ,
+      static_cast<float>(i / side) * 2.f - side ,
+    };
+    CreateBody(registry , world , DYNAMIC , position , glm::vec3{ 1.f });
+  }
+  world->OptimizeBroadPhase();
+  ASSERT_EQ(world->NumBodies() , kNumBenchBodies + 1);
+
+  PhysicsSync sync(60 , 8);
+
+  double step_ms = 0.0;
+  double sync_ms = 0.0;
+  uint32_t steps = 0;
+  uint32_t max_synced = 0;
+  for (uint32_t i = 0; i < kNumBenchFrames; ++i) {
+    PhysicsSyncStats stats = sync.Update(registry , world.Raw() , nullptr , kFrame);
+    step_ms += stats.step_ms;
+    sync_ms += stats.sync_ms;
+    steps += stats.steps;
+    max_synced = std::max(max_synced , stats.synced_bodies);
+  }
+
+  ASSERT_GT(steps , 0u);
+  EXPECT_EQ(max_synced , kNumBenchBodies);
+
+  other::println("{} bodies : step {:.3f} ms | sync {:.3f} ms per fixed step"sv ,
+                 kNumBenchBodies , step_ms / steps , sync_ms / steps);
+}
+
+TEST_F(PhysicsTests , worlds_share_threads_and_scratch_memory) {
+  auto make_world = []() {
+    Ref<PhysicsWorld> world = PhysicsEngine::GetPhysicsWorld();
+    entt::registry registry;
+    CreateBody(registry , world , STATIC , { 0.f , -1.f , 0.f } , { 10.f , 2.f , 10.f });
+    for (uint32_t i = 0; i < 16; ++i) {
+      CreateBody(registry , world , DYNAMIC , { static_cast<float>(i) * 2.f , 2.f , 0.f } , glm::vec3{ 1.f });
+    }
+
+    PhysicsSync sync;
+    for (uint32_t i = 0; i < 4; ++i) {
+      sync.Update(registry , world.Raw() , nullptr , kFrame);
+    }
+  };
+
+  /// first world pays for anything Jolt sets up lazily
+  make_world();
+
+  PhysicsEngine::ResetJobStats();
+  InstallJoltAllocationCounter();
+
+  const int64_t threads_before = NumProcessThreads();
+  const int64_t allocations_before = jolt_live_allocations.load();
+
+  for (uint32_t i = 0; i < 100; ++i) {
+    make_world();
+  }
+
+  const int64_t allocations_after = jolt_live_allocations.load();
+  const int64_t threads_after = NumProcessThreads();
+  RemoveJoltAllocationCounter();
+
+  EXPECT_EQ(allocations_after , allocations_before);
+  EXPECT_EQ(threads_after , threads_before);
+  EXPECT_EQ(PhysicsEngine::GetTempAllocators()->NumArenas() , 1u);
+
+  ThreadPoolStats stats = PhysicsEngine::GetJobStats();
+  EXPECT_GT(stats.jobs_executed , 0u);
+  EXPECT_EQ(stats.num_workers , 3u);
+
+  other::println("100 worlds : {} physics jobs on {} workers , {:.1f}% occupancy"sv , 
+                 stats.jobs_executed , stats.num_workers , stats.occupancy * 100.f);
+}
+
+TEST_F(PhysicsTests , batched_queries_hit_expected_bodies) {
+  Ref<PhysicsWorld> world = PhysicsEngine::GetPhysicsWorld();
+  entt::registry registry;
+
+  entt::entity ground = CreateBody(registry , world , STATIC , { 0.f , -1.f , 0.f } , { 100.f , 2.f , 100.f });
+  entt::entity low = CreateBody(registry , world , STATIC , { 5.f , 0.5f , 0.f } , glm::vec3{ 1.f });
+  entt::entity high = CreateBody(registry , world , STATIC , { 5.f , 3.5f , 0.f } , glm::vec3{ 1.f });
+  world->OptimizeBroadPhase();
+
+  std::vector<RaycastQuery> rays = {
+    { .origin = { 5.f , 10.f , 0.f } , .direction = { 0.f , -1.f , 0.f } , .max_distance = 20.f } ,
+    { .origin = { -5.f , 10.f , 0.f } , .direction = { 0.f , -1.f , 0.f } , .max_distance = 20.f } ,
+    { .origin = { -5.f , 10.f , 0.f } , .direction = { 0.f , -1.f , 0.f } , .max_distance = 5.f } ,
+  };
+
+  PhysicsQueryBuffer buffer;
+  buffer.Reset(static_cast<uint32_t>(rays.size()) , 2);
+  world->CastRays(rays , buffer.Results());
+
+  /// closest first, the ground is third along the ray and does not fit
+  ASSERT_EQ(buffer.NumHits(0) , 2u);
+  EXPECT_EQ(buffer.Hits(0)[0].user_data , static_cast<uint64_t>(high));
+  EXPECT_EQ(buffer.Hits(0)[1].user_data , static_cast<uint64_t>(low));
+  EXPECT_NEAR(buffer.Hits(0)[0].point.y , 4.f , 1e-3f);
+  EXPECT_NEAR(buffer.Hits(0)[0].normal.y , 1.f , 1e-3f);
+  EXPECT_NEAR(buffer.Hits(0)[0].fraction , 6.f / 20.f , 1e-3f);
+
+  ASSERT_EQ(buffer.NumHits(1) , 1u);
+  EXPECT_EQ(buffer.Hits(1)[0].user_data , static_cast<uint64_t>(ground));
+  EXPECT_NEAR(buffer.Hits(1)[0].point.y , 0.f , 1e-3f);
+
+  EXPECT_EQ(buffer.NumHits(2) , 0u);
+
+  std::vector<ShapeCastQuery> casts = {
+    { 
+      .shape = { .type = SPHERE_QUERY_SHAPE , .extent = glm::vec3{ 0.5f } } , 
+      .origin = { 5.f , 10.f , 0.f } , .direction = { 0.f , -1.f , 0.f } , .max_distance = 20.f ,
+    } ,
+  };
+  buffer.Reset(1 , 1);
+  world->CastShapes(casts , buffer.Results());
+
+  ASSERT_EQ(buffer.NumHits(0) , 1u);
+  EXPECT_EQ(buffer.Hits(0)[0].user_data , static_cast<uint64_t>(high));
+  EXPECT_NEAR(buffer.Hits(0)[0].fraction , 5.5f / 20.f , 1e-2f);
+
+  std::vector<OverlapQuery> overlaps = {
+    { .shape = { .type = BOX_QUERY_SHAPE , .extent = { 0.25f , 1.9f , 0.25f } } , .center = { 5.f , 2.2f , 0.f } } ,
+    { .shape = { .type = SPHERE_QUERY_SHAPE , .extent = glm::vec3{ 0.25f } } , .center = { -5.f , 5.f , 0.f } } ,
+  };
+  buffer.Reset(static_cast<uint32_t>(overlaps.size()) , 4);
+  world->Overlap(overlaps , buffer.Results());
+
+  ASSERT_EQ(buffer.NumHits(0) , 2u);
+  EXPECT_NE(buffer.Hits(0)[0].user_data , buffer.Hits(0)[1].user_data);
+  for (const auto& hit : buffer.Hits(0)) {
+    EXPECT_TRUE(hit.user_data == static_cast<uint64_t>(low) || hit.user_data == static_cast<uint64_t>(high));
+  }
+  EXPECT_EQ(buffer.NumHits(1) , 0u);
+  EXPECT_EQ(buffer.TotalHits() , 2u);
+}
+
+TEST_F(PhysicsTests , batched_queries_2d) {
+  PhysicsWorld2D world({ 0.f , -9.8f });
+
+  auto make_box = [&](uint64_t user_data , const b2Vec2& position , const b2Vec2& half_extent) {
+    b2BodyDef def;
+    def.position = position;
+    def.userData.pointer = static_cast<uintptr_t>(user_data);
+
+    b2PolygonShape shape;
+    shape.SetAsBox(half_extent.x , half_extent.y);
+    world.CreateBody(&def)->CreateFixture(&shape , 1.f);
+  };
+
+  make_box(1 , { 0.f , -1.f } , { 50.f , 1.f });
+  make_box(2 , { 5.f , 0.5f } , { 0.5f , 0.5f });
+
+  std::vector<RaycastQuery> rays = {
+    { .origin = { 5.f , 10.f , 0.f } , .direction = { 0.f , -1.f , 0.f } , .max_distance = 20.f } ,
+    { .origin = { -5.f , 10.f , 0.f } , .direction = { 0.f , -1.f , 0.f } , .max_distance = 20.f } ,
+  };
+
+  PhysicsQueryBuffer buffer;
+  buffer.Reset(static_cast<uint32_t>(rays.size()) , 1);
+  world.CastRays(rays , buffer.Results());
+
+  ASSERT_EQ(buffer.NumHits(0) , 1u);
+  EXPECT_EQ(buffer.Hits(0)[0].user_data , 2u);
+  EXPECT_NEAR(buffer.Hits(0)[0].point.y , 1.f , 1e-3f);
+  EXPECT_NEAR(buffer.Hits(0)[0].normal.y , 1.f , 1e-3f);
+
+  ASSERT_EQ(buffer.NumHits(1) , 1u);
+  EXPECT_EQ(buffer.Hits(1)[0].user_data , 1u);
+
+  std::vector<ShapeCastQuery> casts = {
+    { 
+      .shape = { .type = SPHERE_QUERY_SHAPE , .extent = glm::vec3{ 0.5f } } , 
+      .origin = { 5.f , 10.f , 0.f } , .direction = { 0.f , -1.f , 0.f } , .max_distance = 20.f ,
+    } ,
+    { 
+      .shape = { .type = BOX_QUERY_SHAPE , .extent = glm::vec3{ 0.5f } } , 
+      .origin = { 5.f , 0.2f , 0.f } , .direction = { 1.f , 0.f , 0.f } , .max_distance = 1.f ,
+    } ,
+  };
+  buffer.Reset(static_cast<uint32_t>(casts.size()) , 2);
+  world.CastShapes(casts , buffer.Results());
+
+  ASSERT_GE(buffer.NumHits(0) , 1u);
+  EXPECT_EQ(buffer.Hits(0)[0].user_data , 2u);
+  EXPECT_NEAR(buffer.Hits(0)[0].fraction , 8.5f / 20.f , 1e-2f);
+
+  /// starts inside both boxes
+  ASSERT_EQ(buffer.NumHits(1) , 2u);
+  EXPECT_FLOAT_EQ(buffer.Hits(1)[0].fraction , 0.f);
+
+  std::vector<OverlapQuery> overlaps = {
+    { .shape = { .type = SPHERE_QUERY_SHAPE , .extent = glm::vec3{ 0.25f } } , .center = { 5.f , 0.5f , 0.f } } ,
+    { .shape = { .type = SPHERE_QUERY_SHAPE , .extent = glm::vec3{ 0.25f } } , .center = { -5.f , 5.f , 0.f } } ,
+  };
+  buffer.Reset(static_cast<uint32_t>(overlaps.size()) , 4);
+  world.Overlap(overlaps , buffer.Results());
+
+  ASSERT_EQ(buffer.NumHits(0) , 1u);
+  EXPECT_EQ(buffer.Hits(0)[0].user_data , 2u);
+  EXPECT_EQ(buffer.NumHits(1) , 0u);
+}
+
+TEST_F(PhysicsTests , raycast_throughput) {
+  Ref<PhysicsWorld> world = PhysicsEngine::GetPhysicsWorld();
+  entt::registry registry;
+
+  CreateBody(registry , world , STATIC , { 0.f , -1.f , 0.f } , { 500.f , 2.f , 500.f });
+
+  const uint32_t side = 100;
+  for (uint32_t i = 0; i < kNumBenchBodies; ++i) {
+    glm::vec3 position{
+      static_cast<float>(i % side) * 2.f - side ,
+      0.5f + static_cast<float>(i % 7) ,
+      static_cast<float>(i / side) * 2.f - side ,
+    };
+    CreateBody(registry , world , STATIC , position , glm::vec3{ 1.f });
+  }
+  world->OptimizeBroadPhase();
+
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> lateral(-static_cast<float>(side) , static_cast<float>(side));
+
+  std::vector<RaycastQuery> rays(kNumBenchQueries);
+  for (auto& ray : rays) {
+    ray.origin = { lateral(rng) , 20.f , lateral(rng) };
+    ray.direction = { 0.f , -1.f , 0.f };
+    ray.max_distance = 40.f;
+  }
+
+  PhysicsQueryBuffer buffer;
+  buffer.Reset(kNumBenchQueries , 1);
+
+  /// every ray starts above the floor and points at it
+  world->CastRays(rays , buffer.Results());
+  ASSERT_EQ(buffer.TotalHits() , kNumBenchQueries);
+
+  constexpr uint32_t kNumBatches = 20;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < kNumBatches; ++i) {
+    world->CastRays(rays , buffer.Results());
+  }
+  double ms = std::chrono::duration<double , std::milli>(std::chrono::steady_clock::now() - start).count() / kNumBatches;
+
+  other::println("{} raycasts against {} bodies : {:.3f} ms per batch | {:.2f} M rays/s on {} workers"sv ,
+                 kNumBenchQueries , kNumBenchBodies + 1 , ms , kNumBenchQueries / ms / 1000.0 , 
+                 ThreadPool::Get()->NumWorkers());
+}
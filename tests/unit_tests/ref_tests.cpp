@@ -3,9 +3,17 @@
  **/
 #include "oetest.hpp"
 
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "core/defines.hpp"
 #include "core/ref.hpp"
 
+using namespace std::string_view_literals;
+
 using other::Ref;
+using other::RefView;
 using other::RefCounted;
 
 class TestObj : public RefCounted {
@@ -21,8 +29,45 @@ class TestObj : public RefCounted {
     }
 };
 
+class TrackedObj : public RefCounted {
+  public:
+    TrackedObj(uint32_t* destroyed)
+      : destroyed(destroyed) {}
+
+    ~TrackedObj() {
+      ++(*destroyed);
+    }
+
+  private:
+    uint32_t* destroyed;
+};
+
 class RefTests : public other::OtherTest {
   public:  
+    constexpr static uint32_t kNumCopies = 1'000'000;
+
+    /// copies per second of a ref shared by num_threads threads, every copy is one increment and one decrement
+    static double CopyRate(const Ref<TestObj>& obj , uint32_t num_threads) {
+      auto copy_loop = [&obj]() {
+        for (uint32_t i = 0; i < kNumCopies; ++i) {
+          Ref<TestObj> copy = obj;
+          (void)copy;
+        }
+      };
+
+      auto start = std::chrono::high_resolution_clock::now();
+      std::vector<std::thread> threads;
+      for (uint32_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back(copy_loop);
+      }
+      for (auto& t : threads) {
+        t.join();
+      }
+      auto end = std::chrono::high_resolution_clock::now();
+
+      const double seconds = std::chrono::duration<double>(end - start).count();
+      return static_cast<double>(kNumCopies) * num_threads / seconds;
+    }
 };
 
 TEST_F(RefTests , basic_tests) {
@@ -45,4 +90,67 @@ TEST_F(RefTests , basic_tests) {
   test_obj = nullptr;
 
   ASSERT_EQ(test_obj , nullptr);
-}
\ No newline at end of file
+}
+
+TEST_F(RefTests , assignment_releases_previous) {
+  uint32_t destroyed = 0;
+
+  Ref<TrackedObj> a = other::NewRef<TrackedObj>(&destroyed);
+  Ref<TrackedObj> b = other::NewRef<TrackedObj>(&destroyed);
+
+  a = b;
+  EXPECT_EQ(destroyed , 1u);
+  EXPECT_EQ(b->Count() , 2u);
+
+  /// self assignment must not drop the last reference
+  a = a;
+  EXPECT_EQ(a->Count() , 2u);
+
+  b = nullptr;
+  EXPECT_EQ(a->Count() , 1u);
+
+  a = std::move(a);
+  EXPECT_EQ(destroyed , 1u);
+
+  a.Reset();
+  EXPECT_EQ(destroyed , 2u);
+  EXPECT_EQ(a , nullptr);
+}
+
+TEST_F(RefTests , ref_view_does_not_count) {
+  static_assert(sizeof(Ref<TestObj>) == sizeof(TestObj*) , "Ref should be a single pointer");
+  static_assert(sizeof(RefView<TestObj>) == sizeof(TestObj*) , "RefView should be a single pointer");
+
+  Ref<TestObj> obj = other::NewRef<TestObj>();
+
+  RefView<TestObj> view = obj;
+  RefView<TestObj> copy = view;
+  EXPECT_EQ(obj->Count() , 1u);
+  EXPECT_EQ(copy->data , obj->data);
+  EXPECT_EQ(copy.Raw() , obj.Raw());
+
+  {
+    Ref<TestObj> retained = view.Retain();
+    EXPECT_EQ(obj->Count() , 2u);
+  }
+  EXPECT_EQ(obj->Count() , 1u);
+
+  RefView<TestObj> empty;
+  EXPECT_EQ(empty , nullptr);
+  EXPECT_FALSE(empty);
+}
+
+TEST_F(RefTests , concurrent_copies) {
+  Ref<TestObj> obj = other::NewRef<TestObj>();
+
+  const uint32_t num_threads = std::max(std::thread::hardware_concurrency() , 2u);
+  const double single_rate = CopyRate(obj , 1);
+  const double multi_rate = CopyRate(obj , num_threads);
+
+  other::println("ref copies : {:.1f}M/s on 1 thread | {:.1f}M/s on {} threads"sv ,
+                 single_rate / 1e6 , multi_rate / 1e6 , num_threads);
+
+  /// every copy was released and nothing freed the object early
+  EXPECT_EQ(obj->Count() , 1u);
+  EXPECT_EQ(obj->data , "Test String");
+}
@@ -0,0 +1,272 @@
+/**
+ * \file unit_tests/render_command_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <span>
+
+#include "core/defines.hpp"
+
+#include "rendering/frame_ring.hpp"
+#include "rendering/pipeline.hpp"
+#include "rendering/render_commands.hpp"
+
+using namespace std::string_view_literals;
+using namespace other;
+
+class RenderCommandTests : public OtherTest {
+  public:
+    constexpr static uint32_t kNumBenchDraws = 100000;
+
+    static void RecordDraw(RenderCommandBuffer& commands , uint32_t vertex_array , uint32_t instances , uint32_t base_instance) {
+      commands.Record(BindStorageRangeCmd{
+        .binding_point = 1 ,
+        .buffer = 7 ,
+        .offset = base_instance * sizeof(glm::mat4) ,
+        .size = instances * sizeof(glm::mat4) ,
+      });
+      commands.Record(BindVertexArrayCmd{ .vertex_array = vertex_array });
+      commands.Record(SetPolygonModeCmd{ .mode = FILL });
+      commands.Record(DrawIndexedCmd{
+        .mode = TRIANGLES ,
+        .num_elements = 36 ,
+        .instance_count = instances ,
+        .base_instance = base_instance ,
+      });
+    }
+};
+
+TEST_F(RenderCommandTests , commands_replay_in_recording_order) {
+  RenderCommandBuffer commands;
+  RecordDraw(commands , 3 , 4 , 0);
+  RecordDraw(commands , 5 , 2 , 4);
+  ASSERT_EQ(commands.NumCommands() , 8);
+
+  std::vector<RenderCommandType> types;
+  std::vector<DrawIndexedCmd> draws;
+  commands.ForEach([&](const RenderCommandHeader& header , const void* payload) {
+    EXPECT_EQ(header.size % RenderCommandBuffer::kCommandAlignment , 0);
+    types.push_back(header.type);
+    if (header.type == DRAW_INDEXED_CMD) {
+      draws.push_back(RenderCommandBuffer::Read<DrawIndexedCmd>(payload));
+    }
+  });
+
+  const std::vector<RenderCommandType> expected = {
+    BIND_STORAGE_RANGE_CMD , BIND_VERTEX_ARRAY_CMD , SET_POLYGON_MODE_CMD , DRAW_INDEXED_CMD ,
+    BIND_STORAGE_RANGE_CMD , BIND_VERTEX_ARRAY_CMD , SET_POLYGON_MODE_CMD , DRAW_INDEXED_CMD ,
+  };
+  EXPECT_EQ(types , expected);
+
+  ASSERT_EQ(draws.size() , 2);
+  EXPECT_EQ(draws[0].instance_count , 4);
+  EXPECT_EQ(draws[1].instance_count , 2);
+  EXPECT_EQ(draws[1].base_instance , 4);
+}
+
+TEST_F(RenderCommandTests , append_merges_thread_local_buffers) {
+  RenderCommandBuffer first;
+  RenderCommandBuffer second;
+  RecordDraw(first , 1 , 1 , 0);
+  RecordDraw(second , 2 , 1 , 1);
+
+  RenderCommandBuffer merged;
+  merged.Append(first);
+  merged.Append(second);
+  EXPECT_EQ(merged.NumCommands() , first.NumCommands() + second.NumCommands());
+  EXPECT_EQ(merged.SizeBytes() , first.SizeBytes() + second.SizeBytes());
+
+  std::vector<uint32_t> vertex_arrays;
+  merged.ForEach([&](const RenderCommandHeader& header , const void* payload) {
+    if (header.type == BIND_VERTEX_ARRAY_CMD) {
+      vertex_arrays.push_back(RenderCommandBuffer::Read<BindVertexArrayCmd>(payload).vertex_array);
+    }
+  });
+  EXPECT_EQ(vertex_arrays , (std::vector<uint32_t>{ 1 , 2 }));
+
+  /// resetting keeps the arena so the next frame records without allocating
+  const size_t capacity = merged.Capacity();
+  merged.Reset();
+  EXPECT_EQ(merged.NumCommands() , 0);
+  EXPECT_EQ(merged.SizeBytes() , 0);
+  EXPECT_EQ(merged.Capacity() , capacity);
+}
+
+TEST_F(RenderCommandTests , null_backend_counts_and_validates) {
+  RenderCommandBuffer commands;
+  RecordDraw(commands , 3 , 4 , 0);
+  RecordDraw(commands , 3 , 2 , 4);
+
+  /// no vertex array and no instances are both draws a driver would reject or draw nothing for
+  commands.Record(BindVertexArrayCmd{ .vertex_array = 0 });
+  commands.Record(DrawIndexedCmd{ .mode = TRIANGLES , .num_elements = 3 });
+  commands.Record(BindVertexArrayCmd{ .vertex_array = 3 });
+  commands.Record(DrawIndexedCmd{ .mode = TRIANGLES , .num_elements = 3 , .instance_count = 0 });
+
+  NullRenderBackend backend;
+  backend.Execute(commands);
+
+  const NullRenderStats& stats = backend.Stats();
+  EXPECT_EQ(stats.commands[DRAW_INDEXED_CMD] , 4);
+  EXPECT_EQ(stats.commands[BIND_STORAGE_RANGE_CMD] , 2);
+  EXPECT_EQ(stats.draws , 2);
+  EXPECT_EQ(stats.instances , 6);
+  EXPECT_EQ(stats.elements , 36 * 6);
+  EXPECT_EQ(stats.validation_errors , 2);
+
+  /// replays start from a clean state, a draw before any bind in the next replay is caught too
+  RenderCommandBuffer unbound;
+  unbound.Record(DrawIndexedCmd{ .mode = TRIANGLES , .num_elements = 3 });
+  backend.Execute(unbound);
+  EXPECT_EQ(backend.Stats().validation_errors , 3);
+}
+
+TEST_F(RenderCommandTests , pipeline_draw_list_records_one_draw_per_mesh) {
+  FrameRing ring(NewScope<HostFrameRingBackend>() , 4096);
+
+  FrameMeshes meshes;
+  for (uint64_t source = 1; source <= 3; ++source) {
+    auto& list = meshes[MeshKey{ .source_handle = source , .num_elements = 6 }];
+    for (uint64_t i = 0; i < source; ++i) {
+      list.cpu_model_storage.Append(glm::mat4(1.f));
+      list.cpu_material_storage.Append(Material{});
+      ++list.instance_count;
+    }
+  }
+
+  ASSERT_TRUE(PackInstances(meshes , ring));
+
+  RenderCommandBuffer commands;
+  RecordInstancedDraws(meshes , 1 , 2 , commands);
+  ring.EndFrame();
+
+  NullRenderBackend backend;
+  backend.Execute(commands);
+
+  /// meshes without a vertex array are exactly what validation should flag
+  const NullRenderStats& stats = backend.Stats();
+  EXPECT_EQ(stats.commands[DRAW_INDEXED_CMD] , 3);
+  EXPECT_EQ(stats.commands[BIND_STORAGE_RANGE_CMD] , 6);
+  EXPECT_EQ(stats.validation_errors , 3);
+}
+
+TEST_F(RenderCommandTests , uniforms_are_recorded_by_value) {
+  glm::mat4 view{ 2.f };
+  int32_t unit = 3;
+
+  RenderCommandBuffer commands;
+  commands.RecordUniform(5 , 1 , view);
+  commands.RecordUniform(5 , 2 , unit);
+
+  /// the recording owns its copy , later changes to the source are not replayed
+  view = glm::mat4{ 0.f };
+  unit = 0;
+
+  std::vector<SetUniformCmd> uniforms;
+  commands.ForEach([&](const RenderCommandHeader& header , const void* payload) {
+    ASSERT_EQ(header.type , SET_UNIFORM_CMD);
+    uniforms.push_back(RenderCommandBuffer::Read<SetUniformCmd>(payload));
+  });
+  ASSERT_EQ(uniforms.size() , 2);
+
+  EXPECT_EQ(uniforms[0].program , 5);
+  EXPECT_EQ(uniforms[0].location , 1);
+  EXPECT_EQ(uniforms[0].type , MAT4);
+  glm::mat4 recorded_view;
+  std::memcpy(&recorded_view , uniforms[0].value , sizeof(recorded_view));
+  EXPECT_EQ(recorded_view , glm::mat4{ 2.f });
+
+  EXPECT_EQ(uniforms[1].type , INT32);
+  int32_t recorded_unit = 0;
+  std::memcpy(&recorded_unit , uniforms[1].value , sizeof(recorded_unit));
+  EXPECT_EQ(recorded_unit , 3);
+}
+
+TEST_F(RenderCommandTests , null_backend_checks_a_whole_frame) {
+  const std::array<uint8_t , 64> uniforms{};
+
+  /// the shape Pipeline::Render records , uploads and binds first then the gbuffer , one pass and the resolve
+  RenderCommandBuffer frame;
+  frame.Record(BindBufferBaseCmd{ .target = 1 , .binding_point = 2 , .buffer = 4 });
+  frame.RecordUpload(1 , 4 , 16 , std::span{ uniforms }.first(48));
+  frame.Record(SetDepthStateCmd{ .test = true , .func = 1 });
+  frame.Record(BindFramebufferCmd{ .framebuffer = 2 , .clear_mask = 1 });
+  frame.Record(UseProgramCmd{ .program = 5 });
+  RecordDraw(frame , 3 , 4 , 0);
+  frame.Record(UseProgramCmd{ .program = 0 });
+  for (uint32_t unit = 0; unit < 3; ++unit) {
+    frame.Record(BindTextureCmd{ .unit = unit , .target = 1 , .texture = 10 + unit });
+  }
+  frame.Record(BindFramebufferCmd{ .framebuffer = 6 , .width = 800 , .height = 600 , .clear_mask = 1 });
+  frame.Record(SetStencilStateCmd{ .test = true });
+  frame.Record(UseProgramCmd{ .program = 7 });
+  for (int32_t unit = 0; unit < 3; ++unit) {
+    frame.RecordUniform(7 , unit , unit);
+  }
+  RecordDraw(frame , 3 , 4 , 0);
+  frame.Record(UseProgramCmd{ .program = 0 });
+  frame.Record(BlitFramebufferCmd{ .read_framebuffer = 6 , .draw_framebuffer = 8 , .width = 800 , .height = 600 , .mask = 1 });
+
+  NullRenderBackend backend;
+  backend.Execute(frame);
+
+  const NullRenderStats& stats = backend.Stats();
+  EXPECT_EQ(stats.validation_errors , 0);
+  EXPECT_EQ(stats.draws , 2);
+  EXPECT_EQ(stats.bytes_uploaded , 48);
+  EXPECT_EQ(stats.commands[USE_PROGRAM_CMD] , 4);
+  EXPECT_EQ(stats.commands[BIND_FRAMEBUFFER_CMD] , 2);
+  EXPECT_EQ(stats.commands[BIND_TEXTURE_CMD] , 3);
+  EXPECT_EQ(stats.commands[SET_UNIFORM_CMD] , 3);
+
+  /// uploads and binds a driver would reject
+  RenderCommandBuffer broken;
+  broken.Record(BindBufferBaseCmd{ .target = 1 , .binding_point = 2 });
+  broken.RecordUpload(1 , 0 , 0 , uniforms);
+  broken.RecordUpload(1 , 4 , 0 , {});
+  broken.RecordUniform(0 , 1 , 1.f);
+  broken.Record(BindFramebufferCmd{ .framebuffer = 6 , .width = 800 });
+  broken.Record(BlitFramebufferCmd{ .read_framebuffer = 6 , .draw_framebuffer = 6 , .width = 800 , .height = 600 , .mask = 1 });
+
+  backend.ResetStats();
+  backend.Execute(broken);
+  EXPECT_EQ(backend.Stats().validation_errors , 6);
+  EXPECT_EQ(backend.Stats().bytes_uploaded , 0);
+}
+
+TEST_F(RenderCommandTests , record_and_replay_throughput) {
+  RenderCommandBuffer commands;
+  NullRenderBackend backend;
+
+  /// first frame grows the arena, the timed frames reuse it
+  for (uint32_t i = 0; i < kNumBenchDraws; ++i) {
+    RecordDraw(commands , 1 + i % 64 , 1 + i % 8 , i);
+  }
+
+  constexpr uint32_t kNumFrames = 10;
+  double record_ms = 0.0;
+  double replay_ms = 0.0;
+  for (uint32_t f = 0; f < kNumFrames; ++f) {
+    auto start = std::chrono::steady_clock::now();
+    commands.Reset();
+    for (uint32_t i = 0; i < kNumBenchDraws; ++i) {
+      RecordDraw(commands , 1 + i % 64 , 1 + i % 8 , i);
+    }
+    auto recorded = std::chrono::steady_clock::now();
+    backend.Execute(commands);
+    auto replayed = std::chrono::steady_clock::now();
+
+    record_ms += std::chrono::duration<double , std::milli>(recorded - start).count();
+    replay_ms += std::chrono::duration<double , std::milli>(replayed - recorded).count();
+  }
+
+  EXPECT_EQ(backend.Stats().draws , static_cast<uint64_t>(kNumBenchDraws) * kNumFrames);
+  EXPECT_EQ(backend.Stats().validation_errors , 0);
+
+  other::println("{} draws ({} commands , {} KiB) : {:.3f} ms to record | {:.3f} ms to replay on the null backend"sv ,
+                 kNumBenchDraws , commands.NumCommands() , commands.SizeBytes() / 1024 ,
+                 record_ms / kNumFrames , replay_ms / kNumFrames);
+}
@@ -0,0 +1,258 @@
+/**
+ * \file unit_tests/scene_snapshot_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <chrono>
+
+#include <entt/entt.hpp>
+
+#include "core/binary_serializer.hpp"
+#include "ecs/components/serialization_data.hpp"
+#include "ecs/ecs_reflection.hpp"
+#include "scene/scene_snapshot.hpp"
+
+using namespace other;
+
+namespace {
+
+  /// what the scene does for every new entity , restores have to survive it
+  void AddDefaults(entt::registry& registry , entt::entity entity) {
+    registry.emplace<Tag>(entity , "[ Blank Entity ]" , UUID(0));
+    registry.emplace<Transform>(entity);
+    registry.emplace<Relationship>(entity);
+    registry.emplace<SerializationData>(entity);
+  }
+
+  entt::entity CreateEntity(entt::registry& registry , uint32_t i) {
+    const entt::entity entity = registry.create();
+
+    auto& tag = registry.get<Tag>(entity);
+    tag.name = fmtstr("entity-{}" , i);
+    tag.id = i + 1;
+    tag.handle = entity;
+
+    registry.get<Transform>(entity).position = glm::vec3(static_cast<float>(i));
+
+    if (i % 4 == 0) {
+      auto& light = registry.emplace<LightSource>(entity);
+      light.type = POINT_LIGHT_SRC;
+      light.pointlight.position = glm::vec4(static_cast<float>(i));
+    }
+
+    return entity;
+  }
+
+} // anonymous namespace
+
+class SceneSnapshotTests : public OtherTest {
+  public:
+    static void SetUpTestSuite() {
+      OtherTest::SetUpTestSuite();
+      OpenLog();
+    }
+
+    void SetUp() override {
+      registry.on_construct<entt::entity>().connect<&AddDefaults>();
+    }
+
+  protected:
+    entt::registry registry;
+};
+
+TEST_F(SceneSnapshotTests , registry_restores_into_live_registry) {
+  /// owning group , the same shape as the scene's light group
+  auto lights = registry.group<LightSource>(entt::get<Transform>);
+
+  std::vector<entt::entity> saved;
+  for (uint32_t i = 0; i < 64; ++i) {
+    saved.push_back(CreateEntity(registry , i));
+  }
+  registry.destroy(saved[3]);
+
+  BinaryWriter writer;
+  SaveRegistry(registry , writer);
+
+  /// everything after the capture should be undone
+  registry.destroy(saved[5]);
+  registry.destroy(saved[8]);
+  const entt::entity extra = CreateEntity(registry , 1000);
+  registry.get<Transform>(saved[12]).position = glm::vec3(-1.f);
+  registry.remove<LightSource>(saved[16]);
+  registry.emplace<LightSource>(saved[1]).type = DIRECTION_LIGHT_SRC;
+
+  BinaryReader reader(writer.Bytes());
+  ASSERT_TRUE(LoadRegistry(registry , reader));
+  EXPECT_EQ(reader.Remaining() , 0);
+
+  EXPECT_FALSE(registry.valid(saved[3]));
+  EXPECT_TRUE(registry.valid(saved[5]));
+  EXPECT_TRUE(registry.valid(saved[8]));
+  if (extra != saved[3] && extra != saved[5] && extra != saved[8]) {
+    EXPECT_FALSE(registry.valid(extra));
+  }
+
+  for (uint32_t i = 0; i < saved.size(); ++i) {
+    if (i == 3) {
+      continue;
+    }
+
+    const entt::entity entity = saved[i];
+    ASSERT_TRUE(registry.valid(entity));
+
+    /// the construction hook's defaults were overwritten
+    const auto& tag = registry.get<Tag>(entity);
+    EXPECT_EQ(tag.name , fmtstr("entity-{}" , i));
+    EXPECT_EQ(tag.id , UUID(i + 1));
+    EXPECT_EQ(tag.handle , entity);
+    EXPECT_EQ(registry.get<Transform>(entity).position , glm::vec3(static_cast<float>(i)));
+
+    const auto* light = registry.try_get<LightSource>(entity);
+    ASSERT_EQ(light != nullptr , i % 4 == 0);
+    if (light != nullptr) {
+      EXPECT_EQ(light->type , POINT_LIGHT_SRC);
+      EXPECT_EQ(light->pointlight.position , glm::vec4(static_cast<float>(i)));
+    }
+  }
+
+  EXPECT_EQ(registry.storage<Tag>().size() , saved.size() - 1);
+  EXPECT_EQ(registry.storage<LightSource>().size() , 16u);
+
+  /// the group kept track of everything that was cleared and emplaced
+  EXPECT_EQ(lights.size() , 16u);
+  lights.each([](entt::entity entity , const LightSource& light , const Transform& transform) {
+    EXPECT_EQ(glm::vec4(transform.position , 1.f).x , light.pointlight.position.x);
+  });
+}
+
+TEST_F(SceneSnapshotTests , sections_are_matched_by_name) {
+  int32_t value = 42;
+  std::string text = "saved";
+
+  std::vector<SnapshotHook> hooks = {
+    SnapshotHook{
+      .name = "value" ,
+      .save = [&](BinaryWriter& writer) { writer.Write(value); } ,
+      .restore = [&](BinaryReader& reader) { return reader.Read(value); } ,
+    } ,
+    SnapshotHook{
+      .name = "text" ,
+      .save = [&](BinaryWriter& writer) { BinaryCodec<std::string>::Write(writer , text); } ,
+      .restore = [&](BinaryReader& reader) { return BinaryCodec<std::string>::Read(reader , text); } ,
+    } ,
+  };
+
+  BinaryWriter writer;
+  SaveSections(hooks , writer);
+
+  value = 0;
+  text.clear();
+
+  /// only the text hook is still around , the value section is skipped
+  BinaryReader reader(writer.Bytes());
+  ASSERT_TRUE(RestoreSections(std::span{ hooks }.subspan(1) , reader));
+  EXPECT_EQ(reader.Remaining() , 0);
+  EXPECT_EQ(value , 0);
+  EXPECT_EQ(text , "saved");
+
+  BinaryReader all(writer.Bytes());
+  ASSERT_TRUE(RestoreSections(hooks , all));
+  EXPECT_EQ(value , 42);
+
+  BinaryReader truncated(writer.Bytes().first(writer.Size() - 1));
+  EXPECT_FALSE(RestoreSections(hooks , truncated));
+}
+
+TEST_F(SceneSnapshotTests , truncated_registry_fails) {
+  for (uint32_t i = 0; i < 8; ++i) {
+    CreateEntity(registry , i);
+  }
+
+  BinaryWriter writer;
+  SaveRegistry(registry , writer);
+
+  for (size_t size : { size_t{ 0 } , size_t{ 6 } , writer.Size() / 2 , writer.Size() - 1 }) {
+    BinaryReader reader(writer.Bytes().first(size));
+    EXPECT_FALSE(LoadRegistry(registry , reader)) << size;
+  }
+}
+
+TEST_F(SceneSnapshotTests , history_rewinds) {
+  SnapshotHistory history(3 , 64);
+  EXPECT_EQ(history.Capacity() , 3);
+  EXPECT_EQ(history.Newest() , nullptr);
+
+  /// each snapshot holds the frame number it was taken on
+  auto capture = [&history](uint32_t frame) {
+    history.Push().Begin(0).Write(frame);
+  };
+  auto frame_of = [](const SceneSnapshot* snapshot) -> uint32_t {
+    uint32_t frame = 0;
+    BinaryReader reader(snapshot->Bytes());
+    reader.Read(frame);
+    return frame;
+  };
+
+  for (uint32_t frame = 0; frame < 5; ++frame) {
+    capture(frame);
+  }
+
+  ASSERT_EQ(history.Size() , 3);
+  EXPECT_EQ(frame_of(history.At(0)) , 2);
+  EXPECT_EQ(frame_of(history.Newest()) , 4);
+  EXPECT_EQ(frame_of(history.Newest(2)) , 2);
+  EXPECT_EQ(history.At(3) , nullptr);
+
+  /// rewinding one step drops frame 4 , the next capture goes where it was
+  const SceneSnapshot* rewound = history.Rewind(1);
+  ASSERT_NE(rewound , nullptr);
+  EXPECT_EQ(frame_of(rewound) , 3);
+  EXPECT_EQ(history.Size() , 2);
+
+  capture(10);
+  EXPECT_EQ(frame_of(history.Newest()) , 10);
+  EXPECT_EQ(frame_of(history.At(0)) , 2);
+
+  EXPECT_EQ(history.Rewind(3) , nullptr);
+  EXPECT_EQ(history.Size() , 3);
+}
+
+TEST_F(SceneSnapshotTests , snapshot_timings) {
+  constexpr uint32_t kNumEntities = 100'000;
+
+  for (uint32_t i = 0; i < kNumEntities; ++i) {
+    CreateEntity(registry , i);
+  }
+
+  using clock = std::chrono::steady_clock;
+  auto ms = [](auto duration) -> double {
+    return std::chrono::duration<double , std::milli>(duration).count();
+  };
+
+  SceneSnapshot snapshot(kNumEntities * 128);
+
+  const auto capture_start = clock::now();
+  SaveRegistry(registry , snapshot.Begin(1));
+  const auto capture_end = clock::now();
+
+  /// a second capture into the same arena does not allocate
+  const uint8_t* data = snapshot.Bytes().data();
+  const auto recapture_start = clock::now();
+  SaveRegistry(registry , snapshot.Begin(1));
+  const auto recapture_end = clock::now();
+  EXPECT_EQ(snapshot.Bytes().data() , data);
+
+  registry.get<Transform>(entt::entity{ 7 }).position = glm::vec3(-1.f);
+
+  BinaryReader reader(snapshot.Bytes());
+  const auto restore_start = clock::now();
+  ASSERT_TRUE(LoadRegistry(registry , reader));
+  const auto restore_end = clock::now();
+
+  EXPECT_EQ(registry.storage<Tag>().size() , kNumEntities);
+  EXPECT_EQ(registry.get<Transform>(entt::entity{ 7 }).position , glm::vec3(7.f));
+
+  println("SceneSnapshot : {} entities , {} bytes | capture {:.2f} ms | recapture {:.2f} ms | restore {:.2f} ms" ,
+          kNumEntities , snapshot.Size() , ms(capture_end - capture_start) , ms(recapture_end - recapture_start) ,
+          ms(restore_end - restore_start));
+}
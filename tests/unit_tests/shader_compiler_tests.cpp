@@ -0,0 +1,478 @@
+/**
+ * \file unit_tests/shader_compiler_tests.cpp
+ **/
+#include <gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#include "core/config_keys.hpp"
+#include "core/defines.hpp"
+#include "core/filesystem.hpp"
+#include "core/thread_pool.hpp"
+
+#include "parsing/shader_arena.hpp"
+#include "parsing/shader_cache.hpp"
+#include "parsing/shader_compiler.hpp"
+#include "parsing/shader_preprocessor.hpp"
+#include "parsing/shader_lexer.hpp"
+#include "parsing/shader_parser.hpp"
+#include "parsing/shader_optimizer.hpp"
+#include "parsing/shader_glsl_transpiler.hpp"
+
+#include "oetest.hpp"
+
+using namespace std::string_view_literals;
+using namespace other;
+
+class ShaderCompilerTests : public OtherTest {
+  public:
+    constexpr static uint32_t kNumIterations = 100;
+
+    static std::vector<Path> ShaderLibrary() {
+      std::vector<Path> shaders;
+      for (const auto& entry : std::filesystem::directory_iterator("./OtherEngine/assets/shaders")) {
+        if (entry.path().extension() == ".oshader") {
+          shaders.push_back(entry.path());
+        }
+      }
+      return shaders;
+    }
+
+    static Path TempDir(const std::string& name) {
+      Path dir = std::filesystem::temp_directory_path() / name;
+      std::filesystem::remove_all(dir);
+      std::filesystem::create_directories(dir);
+      return dir;
+    }
+
+    static void WriteFile(const Path& path , const std::string& contents) {
+      std::ofstream file(path , std::ios::trunc);
+      file << contents;
+    }
+
+    /// runs the front end and the optimizer only, the ast is transpiled by the caller if it needs the glsl
+    static ShaderOptimizerStats Optimize(const std::string& src , ShaderIr* ir = nullptr) {
+      ShaderPreprocessor preprocessor(src , OTHER_SHADER);
+      ShaderProcessedFile processed = preprocessor.Process();
+
+      ShaderLexer lexer(processed);
+      ShaderLexResult tokens = lexer.Lex();
+
+      ShaderParser parser(tokens);
+      ShaderAst ast = parser.Parse();
+
+      ShaderOptimizer optimizer(ast);
+      ShaderOptimizerStats stats = optimizer.Optimize();
+
+      if (ir != nullptr) {
+        ShaderGlslTranspiler transpiler(ast);
+        *ir = transpiler.Transpile();
+      }
+      return stats;
+    }
+};
+
+TEST_F(ShaderCompilerTests , arena_runs_destructors) {
+  struct Tracked {
+    uint32_t* count;
+    ~Tracked() { ++(*count); }
+  };
+
+  uint32_t destroyed = 0;
+  {
+    ShaderArena arena(64);
+    for (uint32_t i = 0; i < 100; ++i) {
+      arena.New<Tracked>(&destroyed);
+    }
+
+    std::string_view interned = arena.Intern("readonly buffer"sv);
+    EXPECT_EQ(interned , "readonly buffer"sv);
+    EXPECT_EQ(arena.NumObjects() , 100u);
+    EXPECT_GT(arena.NumBlocks() , 1u);
+    EXPECT_EQ(destroyed , 0u);
+  }
+  EXPECT_EQ(destroyed , 100u);
+}
+
+TEST_F(ShaderCompilerTests , tokens_view_source) {
+  const std::string src = "vertex { layout (location = 0) in vec3 voe_position; const float x = 1.5e2; }";
+
+  ShaderPreprocessor preprocessor(src , OTHER_SHADER);
+  ShaderProcessedFile processed = preprocessor.Process();
+
+  ShaderLexer lexer(processed);
+  ShaderLexResult result = lexer.Lex();
+  ASSERT_NE(result.arena , nullptr);
+
+  const char* begin = processed.src.data();
+  const char* end = begin + processed.src.size();
+
+  uint32_t synthesized = 0;
+  for (const auto& tok : result.tokens) {
+    EXPECT_EQ(tok.hash , FNV(tok.value));
+    if (tok.value.empty()) {
+      continue;
+    }
+
+    if (tok.value.data() < begin || tok.value.data() >= end) {
+      ++synthesized;
+      EXPECT_EQ(tok.type , FLOAT_LIT);
+    }
+  }
+
+  /// only the folded scientific literal should live outside the source
+  EXPECT_EQ(synthesized , 1u);
+}
+
+TEST_F(ShaderCompilerTests , compile_shader_library) {
+  const auto shaders = ShaderLibrary();
+  ASSERT_FALSE(shaders.empty());
+
+  for (const auto& path : shaders) {
+    std::string src = Filesystem::ReadFile(path);
+    ASSERT_FALSE(src.empty()) << path;
+
+    ShaderPreprocessor preprocessor(src , OTHER_SHADER);
+    ShaderProcessedFile processed = preprocessor.Process();
+
+    ShaderLexer lexer(processed);
+    ShaderLexResult tokens = lexer.Lex();
+    const size_t num_tokens = tokens.tokens.size();
+
+    ShaderParser parser(tokens);
+    ShaderAst ast = parser.Parse();
+    ASSERT_NE(ast.arena , nullptr);
+
+    const size_t num_nodes = ast.arena->NumObjects();
+    const size_t num_blocks = ast.arena->NumBlocks();
+
+    ShaderGlslTranspiler transpiler(ast);
+    ShaderIr ir = transpiler.Transpile();
+    EXPECT_FALSE(ir.vert_source.empty()) << path;
+    EXPECT_FALSE(ir.frag_source.empty()) << path;
+
+    /// time the whole pipeline, the arena and every node in it are released at the end of each iteration
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < kNumIterations; ++i) {
+      ShaderIr bench_ir = ShaderCompiler::Compile(src);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    const double avg_us = std::chrono::duration<double , std::micro>(end - start).count() / kNumIterations;
+
+    println("{:<28} : {:>5} tokens | {:>4} nodes in {} arena block(s) ({} bytes) | {:.1f}us / compile"sv ,
+            path.filename().string() , num_tokens , num_nodes , num_blocks , ast.arena->BytesUsed() , avg_us);
+
+    /// one heap allocation per block instead of one per node
+    EXPECT_LT(num_blocks , num_nodes);
+  }
+}
+
+TEST_F(ShaderCompilerTests , cache_round_trip) {
+  const Path cache_dir = TempDir("oe_shader_cache_round_trip");
+  ShaderCache cache(cache_dir);
+
+  for (const auto& path : ShaderLibrary()) {
+    bool hit = true;
+    ShaderIr cold = ShaderCompiler::Compile(path , &cache , &hit);
+    EXPECT_FALSE(hit) << path;
+
+    ShaderIr warm = ShaderCompiler::Compile(path , &cache , &hit);
+    EXPECT_TRUE(hit) << path;
+
+    EXPECT_EQ(cold.name , warm.name);
+    EXPECT_EQ(cold.vert_source , warm.vert_source);
+    EXPECT_EQ(cold.frag_source , warm.frag_source);
+    EXPECT_EQ(cold.geom_source , warm.geom_source);
+    EXPECT_EQ(cold.layout.stride , warm.layout.stride);
+    EXPECT_EQ(cold.layout.attrs.size() , warm.layout.attrs.size());
+    EXPECT_EQ(cold.uniforms.size() , warm.uniforms.size());
+    EXPECT_EQ(cold.storages.size() , warm.storages.size());
+    EXPECT_EQ(cold.stripped_uniforms , warm.stripped_uniforms);
+  }
+
+  EXPECT_EQ(cache.Stats().hits , cache.Stats().stores);
+  std::filesystem::remove_all(cache_dir);
+}
+
+TEST_F(ShaderCompilerTests , cache_invalidated_by_import) {
+  const Path dir = TempDir("oe_shader_cache_import");
+  const Path shader = dir / "importer.oshader";
+  const Path import = dir / "lib" / "common.oshader";
+
+  /// imported by common , resolved next to common rather than next to the importer
+  const Path nested = dir / "lib" / "deep.oshader";
+  std::filesystem::create_directories(dir / "lib");
+
+  const std::string src = Filesystem::ReadFile(ShaderLibrary().front());
+  ASSERT_FALSE(src.empty());
+
+  WriteFile(shader , src + "\n#import \"lib/common.oshader\";\n");
+  WriteFile(import , "// version 1\n#import \"deep.oshader\";\n");
+  WriteFile(nested , "// deep version 1\n");
+
+  const std::vector<Path> imports = ShaderCompiler::Imports(shader);
+  ASSERT_EQ(imports.size() , 2);
+  EXPECT_EQ(imports[0] , import.lexically_normal());
+  EXPECT_EQ(imports[1] , nested.lexically_normal());
+
+  ShaderCache cache(dir / "cache");
+
+  bool hit = true;
+  ShaderCompiler::Compile(shader , &cache , &hit);
+  EXPECT_FALSE(hit);
+
+  ShaderCompiler::Compile(shader , &cache , &hit);
+  EXPECT_TRUE(hit);
+
+  /// the importing shader is untouched but its dependency changed
+  WriteFile(import , "// version 2\n#import \"deep.oshader\";\n");
+  ShaderCompiler::Compile(shader , &cache , &hit);
+  EXPECT_FALSE(hit);
+
+  ShaderCompiler::Compile(shader , &cache , &hit);
+  EXPECT_TRUE(hit);
+
+  /// two levels down , neither the shader nor its direct import changed
+  WriteFile(nested , "// deep version 2\n");
+  ShaderCompiler::Compile(shader , &cache , &hit);
+  EXPECT_FALSE(hit);
+
+  ShaderCompiler::Compile(shader , &cache , &hit);
+  EXPECT_TRUE(hit);
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST_F(ShaderCompilerTests , batch_compile_cold_and_warm) {
+  const Path cache_dir = TempDir("oe_shader_cache_batch");
+  ShaderCache cache(cache_dir);
+
+  ConfigTable pool_config = config;
+  pool_config.Add(kThreadPoolSection , kWorkersValue , "3");
+  ThreadPool::Initialize(pool_config);
+
+  auto time_batch = [](ShaderCache* c , bool parallel , bool expect_hit) -> double {
+    auto start = std::chrono::high_resolution_clock::now();
+    auto results = ShaderCompiler::CompileBatch("./OtherEngine/assets/shaders" , c , parallel);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    for (const auto& res : results) {
+      EXPECT_TRUE(res.ir.has_value()) << res.path << " : " << res.error;
+      EXPECT_EQ(res.cache_hit , expect_hit) << res.path;
+    }
+    return std::chrono::duration<double , std::milli>(end - start).count();
+  };
+
+  const double serial_ms = time_batch(nullptr , false , false);
+  const double parallel_ms = time_batch(nullptr , true , false);
+  const double cold_ms = time_batch(&cache , true , false);
+  const double warm_ms = time_batch(&cache , true , true);
+  ThreadPool::Shutdown();
+
+  println("shader library : serial {:.2f}ms | parallel {:.2f}ms | cold cache {:.2f}ms | warm cache {:.2f}ms"sv ,
+          serial_ms , parallel_ms , cold_ms , warm_ms);
+
+  const auto stats = cache.Stats();
+  EXPECT_EQ(stats.stores , ShaderLibrary().size());
+  EXPECT_EQ(stats.hits , ShaderLibrary().size());
+
+  std::filesystem::remove_all(cache_dir);
+}
+
+TEST_F(ShaderCompilerTests , optimizer_golden_output) {
+  const Path goldens = "./tests/unit_tests/shader_goldens";
+  const bool update = std::getenv("OE_UPDATE_SHADER_GOLDENS") != nullptr;
+
+  for (const auto& path : ShaderLibrary()) {
+    ShaderIr ir = ShaderCompiler::Compile(Filesystem::ReadFile(path));
+    const std::string stem = path.stem().string();
+
+    std::vector<std::pair<std::string , std::string>> stages = {
+      { ".vert.glsl" , ir.vert_source } ,
+      { ".frag.glsl" , ir.frag_source } ,
+    };
+    if (ir.geom_source.has_value()) {
+      stages.push_back({ ".geom.glsl" , ir.geom_source.value() });
+    }
+
+    for (const auto& [ext , source] : stages) {
+      const Path golden = goldens / (stem + ext);
+      if (update) {
+        WriteFile(golden , source);
+        continue;
+      }
+
+      ASSERT_TRUE(Filesystem::FileExists(golden)) << golden << " is missing, rerun with OE_UPDATE_SHADER_GOLDENS set";
+      EXPECT_EQ(Filesystem::ReadFile(golden) , source) << golden;
+    }
+  }
+}
+
+TEST_F(ShaderCompilerTests , optimizer_folds_constants) {
+  const std::string src = R"(
+    vertex [mesh : default] {
+      void main() {
+        gl_Position = vec4(voe_position , 1.0);
+      }
+    }
+
+    fragment {
+      out vec4 FragColor;
+
+      const float scale = 2.0;
+      const int count = 3;
+
+      void main() {
+        float a = scale * 0.5 + (1.0 - 4.0 / 2.0);
+        int b = count * (7 - 2) + -1;
+        int c = -7 / 2;
+        FragColor = vec4(a , b , c , 2.0 * 0.25f);
+      }
+    }
+  )";
+
+  ShaderIr ir;
+  ShaderOptimizerStats stats = Optimize(src , &ir);
+
+  EXPECT_GT(stats.folded_constants , 0u);
+  EXPECT_NE(ir.frag_source.find("float a = 0.0;") , std::string::npos) << ir.frag_source;
+  EXPECT_NE(ir.frag_source.find("int b = 14;") , std::string::npos) << ir.frag_source;
+  EXPECT_NE(ir.frag_source.find("vec4(a , b , c , 0.5)") , std::string::npos) << ir.frag_source;
+
+  /// rounding of negative integer division is left to the driver
+  EXPECT_NE(ir.frag_source.find("int c = -7 / 2;") , std::string::npos) << ir.frag_source;
+
+  /// propagated constants are unread afterwards and are dropped with the rest of the dead globals
+  EXPECT_EQ(ir.frag_source.find("scale") , std::string::npos) << ir.frag_source;
+  EXPECT_EQ(ir.frag_source.find("count") , std::string::npos) << ir.frag_source;
+}
+
+TEST_F(ShaderCompilerTests , optimizer_strips_dead_code) {
+  const std::string src = R"(
+    vertex [mesh : default] {
+      out vec3 used_color;
+      out vec3 unused_normal;
+
+      void main() {
+        used_color = voe_normal;
+        unused_normal = normalize(voe_normal);
+        gl_Position = vec4(voe_position , 1.0);
+      }
+    }
+
+    fragment {
+      in vec3 used_color;
+      in vec2 unread_uvs;
+      out vec4 FragColor;
+
+      uniform float exposure;
+      uniform float unused_gamma;
+
+      float helper(float x) {
+        return x * exposure;
+      }
+
+      float unused_helper(float x) {
+        return x * unused_gamma;
+      }
+
+      void main() {
+        float unused_local = 2.0 * exposure;
+        FragColor = vec4(used_color * helper(1.0) , 1.0);
+      }
+    }
+  )";
+
+  ShaderIr ir;
+  ShaderOptimizerStats stats = Optimize(src , &ir);
+
+  EXPECT_EQ(stats.stripped_functions , 1u);
+  EXPECT_EQ(stats.stripped_variables , 1u);
+  EXPECT_EQ(stats.stripped_varyings , 2u);
+  ASSERT_EQ(stats.stripped_uniforms.size() , 1u);
+  EXPECT_EQ(stats.stripped_uniforms.front() , "unused_gamma");
+
+  EXPECT_EQ(ir.frag_source.find("unused_helper") , std::string::npos) << ir.frag_source;
+  EXPECT_EQ(ir.frag_source.find("unused_gamma") , std::string::npos) << ir.frag_source;
+  EXPECT_EQ(ir.frag_source.find("unused_local") , std::string::npos) << ir.frag_source;
+  EXPECT_EQ(ir.frag_source.find("unread_uvs") , std::string::npos) << ir.frag_source;
+  EXPECT_EQ(ir.vert_source.find("unused_normal") , std::string::npos) << ir.vert_source;
+
+  EXPECT_NE(ir.frag_source.find("helper") , std::string::npos) << ir.frag_source;
+  EXPECT_NE(ir.frag_source.find("uniform float exposure") , std::string::npos) << ir.frag_source;
+  EXPECT_NE(ir.vert_source.find("used_color = voe_normal") , std::string::npos) << ir.vert_source;
+}
+
+TEST_F(ShaderCompilerTests , optimizer_hoists_common_subexpressions) {
+  const std::string src = R"(
+    vertex [mesh : default] {
+      out vec3 frag_pos;
+
+      void main() {
+        frag_pos = voe_position;
+        gl_Position = vec4(voe_position , 1.0);
+      }
+    }
+
+    fragment {
+      in vec3 frag_pos;
+      out vec4 FragColor;
+
+      uniform vec3 light_pos;
+
+      void main() {
+        vec3 dir = normalize(light_pos - frag_pos);
+        float dist = length(light_pos - frag_pos);
+
+        vec3 offset = frag_pos * 2.0;
+        offset = offset + frag_pos * 2.0;
+        vec3 moved = frag_pos * 2.0;
+
+        FragColor = vec4(dir * dist + offset + moved , 1.0);
+      }
+    }
+  )";
+
+  ShaderIr ir;
+  ShaderOptimizerStats stats = Optimize(src , &ir);
+
+  EXPECT_EQ(stats.hoisted_expressions , 2u);
+  EXPECT_NE(ir.frag_source.find("vec3 oe_cse_0 = light_pos - frag_pos;") , std::string::npos) << ir.frag_source;
+  EXPECT_NE(ir.frag_source.find("normalize(oe_cse_0)") , std::string::npos) << ir.frag_source;
+  EXPECT_NE(ir.frag_source.find("length(oe_cse_0)") , std::string::npos) << ir.frag_source;
+  EXPECT_NE(ir.frag_source.find("vec3 oe_cse_1 = frag_pos * 2.0;") , std::string::npos) << ir.frag_source;
+}
+
+TEST_F(ShaderCompilerTests , optimizer_respects_writes) {
+  const std::string src = R"(
+    vertex [mesh : default] {
+      void main() {
+        gl_Position = vec4(voe_position , 1.0);
+      }
+    }
+
+    fragment {
+      out vec4 FragColor;
+
+      uniform float scale;
+
+      void main() {
+        float x = scale;
+        float a = x * 3.0;
+        x = x + 1.0;
+        float b = x * 3.0;
+        FragColor = vec4(a , b , 0.0 , 1.0);
+      }
+    }
+  )";
+
+  ShaderIr ir;
+  ShaderOptimizerStats stats = Optimize(src , &ir);
+
+  /// x changes between the two products, so they are different values
+  EXPECT_EQ(stats.hoisted_expressions , 0u);
+  EXPECT_EQ(ir.frag_source.find("oe_cse") , std::string::npos) << ir.frag_source;
+}
@@ -0,0 +1,86 @@
+#version 460 core
+
+struct Material {
+  vec4 color;
+  float shininess;
+};
+
+struct PointLight {
+  vec4 position;
+  vec4 color;
+  float radius;
+  float constant;
+  float linear;
+  float quadratic;
+};
+
+struct DirectionLight {
+  vec4 direction;
+  vec4 color;
+};
+
+layout (location = 0) out vec4 g_position;
+layout (location = 1) out vec4 g_normal;
+layout (location = 2) out vec4 g_albedo;
+#define MAX_LIGHTS 100
+layout (std430 , binding = 3) readonly buffer Lights {
+  vec4 num_lights;
+  PointLight point_lights[MAX_LIGHTS];
+  DirectionLight direction_lights[MAX_LIGHTS];
+};
+
+uniform sampler2D goe_position;
+uniform sampler2D goe_normal;
+uniform sampler2D goe_albedo;
+in Material material;
+
+  in vec3 fviewpoint;
+  in vec3 foe_position;
+  in vec3 foe_normal;
+  in vec2 foe_texcoords;
+  out vec4 FragColor;
+  vec3 CalcDirectionLight(DirectionLight light , vec3 normal , vec3 view_dir , vec3 diffuse , float specular) {
+  vec3 color = light.color.rgb;
+  vec3 light_dir = normalize(-light.direction.xyz);
+  vec3 diff = max(dot(normal , light_dir) , 0.0) * diffuse * color;
+  vec3 reflect_dir = reflect(-light_dir , normal);
+  float s = pow(max(dot(view_dir , reflect_dir) , 0.0) , specular);
+  vec3 spec = color * s;
+  return (diff + spec);
+}
+
+  vec3 CalcPointLight(PointLight light , vec3 normal , vec3 frag_pos , vec3 view_dir , vec3 diffuse , float specular) {
+  vec3 color = light.color.rgb;
+  vec3 oe_cse_0 = light.position.xyz - frag_pos;
+  vec3 light_dir = normalize(oe_cse_0);
+  vec3 diff = max(dot(normal , light_dir) , 0.0) * diffuse * color;
+  vec3 halfway = normalize(light_dir + view_dir);
+  float s = pow(max(dot(normal , halfway) , 0.0) , specular);
+  vec3 spec = color * s;
+  float dist = length(oe_cse_0);
+  float attenuation = 1.0 / (1.0 + light.linear * dist + light.quadratic * dist * dist);
+  diff = diff * attenuation;
+  spec = spec * attenuation;
+  return (diff + spec);
+}
+
+  void main() {
+  vec3 norm = normalize(foe_normal);
+  vec3 view_dir = normalize(fviewpoint - foe_position);
+  vec3 normal = foe_normal;
+  vec3 diffuse = material.color.rgb;
+  float specular = texture(goe_albedo , foe_texcoords).a;
+  vec3 result = diffuse * 0.1;
+  int i = 0;
+  while (i < num_lights.x) {
+  result = result + CalcDirectionLight(direction_lights[i] , norm , view_dir , diffuse , specular);
+  i = i + 1;
+};
+  i = 0;
+  while (i < num_lights.y) {
+  result = result + CalcPointLight(point_lights[i] , normal , foe_position , view_dir , diffuse , specular);
+  i = i + 1;
+};
+  FragColor = vec4(result , 1.);
+}
+
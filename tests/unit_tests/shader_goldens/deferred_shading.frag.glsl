@@ -0,0 +1,84 @@
+#version 460 core
+
+struct Material {
+  vec4 color;
+  float shininess;
+};
+
+struct PointLight {
+  vec4 position;
+  vec4 color;
+  float radius;
+  float constant;
+  float linear;
+  float quadratic;
+};
+
+struct DirectionLight {
+  vec4 direction;
+  vec4 color;
+};
+
+layout (location = 0) out vec4 g_position;
+layout (location = 1) out vec4 g_normal;
+layout (location = 2) out vec4 g_albedo;
+#define MAX_LIGHTS 100
+layout (std430 , binding = 3) readonly buffer Lights {
+  vec4 num_lights;
+  PointLight point_lights[MAX_LIGHTS];
+  DirectionLight direction_lights[MAX_LIGHTS];
+};
+
+uniform sampler2D goe_position;
+uniform sampler2D goe_normal;
+uniform sampler2D goe_albedo;
+in Material material;
+
+  out vec4 FragColor;
+  in vec3 view_pos;
+  in vec2 tex_coords;
+  void main() {
+  vec3 frag_pos = texture(goe_position , tex_coords).rgb;
+  vec3 normal = texture(goe_normal , tex_coords).rgb;
+  vec4 oe_cse_1 = texture(goe_albedo , tex_coords);
+  vec3 diffuse = oe_cse_1.rgb;
+  float specular = oe_cse_1.a;
+  vec3 lighting = diffuse * 0.1;
+  vec3 view_dir = normalize(view_pos.xyz - frag_pos);
+  int i = 0;
+  while (i < num_lights.x) {
+  vec3 color = direction_lights[i].color.rgb;
+  vec3 light_dir = normalize(-direction_lights[i].direction.xyz);
+  vec3 d = max(dot(normal , light_dir) , 0.0) * diffuse;
+  vec3 diff = d * color;
+  vec3 reflect_dir = reflect(-light_dir , normal);
+  float s = pow(max(dot(view_dir , reflect_dir) , 0.0) , specular);
+  vec3 spec = color * s * specular;
+  lighting = lighting + diff + spec;
+  i = i + 1;
+};
+  i = 0;
+  while (i < num_lights.y) {
+  vec3 oe_cse_0 = point_lights[i].position.xyz - frag_pos;
+  float distance = length(oe_cse_0);
+  if (distance <= point_lights[i].radius) {
+  {
+  vec3 color = point_lights[i].color.xyz;
+  vec3 light_dir = normalize(oe_cse_0);
+  vec3 d = max(dot(normal , light_dir) , 0.0) * diffuse;
+  vec3 diff = d * color;
+  vec3 halfway = normalize(light_dir + view_dir);
+  float s = pow(max(dot(normal , halfway) , 0.0) , specular);
+  vec3 spec = color * s * specular;
+  float attenuation = 1.0 / (point_lights[i].constant + point_lights[i].linear * distance + point_lights[i].quadratic * distance * distance);
+  diff = diff * attenuation;
+  spec = spec * attenuation;
+  lighting = lighting + diff + spec;
+}}
+
+;
+  i = i + 1;
+};
+  FragColor = vec4(lighting , 1.0);
+}
+
@@ -0,0 +1,48 @@
+#version 460 core
+
+struct Material {
+  vec4 color;
+  float shininess;
+};
+
+struct PointLight {
+  vec4 position;
+  vec4 color;
+  float radius;
+  float constant;
+  float linear;
+  float quadratic;
+};
+
+struct DirectionLight {
+  vec4 direction;
+  vec4 color;
+};
+
+layout (location = 0) out vec4 g_position;
+layout (location = 1) out vec4 g_normal;
+layout (location = 2) out vec4 g_albedo;
+#define MAX_LIGHTS 100
+layout (std430 , binding = 3) readonly buffer Lights {
+  vec4 num_lights;
+  PointLight point_lights[MAX_LIGHTS];
+  DirectionLight direction_lights[MAX_LIGHTS];
+};
+
+uniform sampler2D goe_position;
+uniform sampler2D goe_normal;
+uniform sampler2D goe_albedo;
+in Material material;
+
+  in vec2 foe_uvs;
+  out vec4 FragColor;
+  uniform sampler2D oe_screen_tex;
+
+  uniform float exposure;
+
+  void main() {
+  vec3 hdr_color = texture(oe_screen_tex , foe_uvs).rgb;
+  vec3 result = vec3(1.0) - exp(-1 * hdr_color * exposure);
+  FragColor = vec4(result , 1.0);
+}
+
@@ -0,0 +1,45 @@
+#version 460 core
+
+struct Material {
+  vec4 color;
+  float shininess;
+};
+
+struct PointLight {
+  vec4 position;
+  vec4 color;
+  float radius;
+  float constant;
+  float linear;
+  float quadratic;
+};
+
+struct DirectionLight {
+  vec4 direction;
+  vec4 color;
+};
+
+layout (location = 0) out vec4 g_position;
+layout (location = 1) out vec4 g_normal;
+layout (location = 2) out vec4 g_albedo;
+#define MAX_LIGHTS 100
+layout (std430 , binding = 3) readonly buffer Lights {
+  vec4 num_lights;
+  PointLight point_lights[MAX_LIGHTS];
+  DirectionLight direction_lights[MAX_LIGHTS];
+};
+
+uniform sampler2D goe_position;
+uniform sampler2D goe_normal;
+uniform sampler2D goe_albedo;
+in Material material;
+
+  in vec3 foe_position;
+  in vec3 foe_normal;
+  void main() {
+  g_position = vec4(foe_position , 1.0);
+  g_normal = vec4(normalize(foe_normal) , 1.0);
+  g_albedo.rgb = material.color.rgb;
+  g_albedo.a = material.shininess;
+}
+
@@ -0,0 +1,33 @@
+#version 460 core
+
+  layout (triangles) in;
+  layout (line_strip , max_vertices = 6) out;
+  layout (std140 , binding = 0) uniform Camera {
+  mat4 projection;
+  mat4 view;
+  vec4 viewpoint;
+};
+
+  in VOUT {
+  vec3 normal;
+} gin[];
+
+  uniform float magnitude;
+
+  void GenerateLine(int index) {
+  vec4 glpos = gl_in[index].gl_Position;
+  vec3 normal = gin[index].normal;
+  gl_Position = projection * glpos;
+  EmitVertex();
+  vec4 adjusted_pos = glpos + vec4(normal , 0.0) * magnitude;
+  gl_Position = projection * adjusted_pos;
+  EmitVertex();
+  EndPrimitive();
+}
+
+  void main() {
+  GenerateLine(0);
+  GenerateLine(1);
+  GenerateLine(2);
+}
+
@@ -0,0 +1,37 @@
+#version 460 core
+
+struct Material {
+  vec4 color;
+  float shininess;
+};
+
+layout (location = 0) in vec3 voe_position;
+layout (location = 1) in vec3 voe_normal;
+layout (location = 2) in vec3 voe_tangent;
+layout (location = 3) in vec3 voe_bitangent;
+layout (location = 4) in vec2 voe_uvs;
+
+layout (std140 , binding = 0) uniform Camera {
+  mat4 projection;
+  mat4 view;
+  vec4 viewpoint;
+};
+
+#define MAX_MODELS
+layout (std430 , binding = 1) readonly buffer ModelData {
+  mat4 models[MAX_MODELS];
+};
+
+#define MAX_MATERIALS 100
+layout (std430 , binding = 2) readonly buffer MaterialData {
+  Material materials[MAX_MATERIALS];
+};
+
+out int instanceid;
+out Material material;
+
+  void main() {
+  gl_Position = projection * view * models[gl_InstanceID] * vec4(voe_position , 1.0);
+  material = materials[gl_InstanceID];
+}
+
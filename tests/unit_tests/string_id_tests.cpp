@@ -0,0 +1,124 @@
+/**
+ * \file unit_tests/string_id_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/config.hpp"
+#include "core/string_id.hpp"
+
+using other::ConfigTable;
+using other::FNV;
+using other::StringId;
+using other::StringInterner;
+
+namespace {
+
+  constexpr StringId kGeometry = "Geometry";
+
+  /// only compiles if the literal was hashed at compile time
+  static_assert(kGeometry.Hash() == FNV("Geometry"));
+  static_assert(StringId("Debug") != kGeometry);
+
+  uint64_t HashOf(StringId id) {
+    return id.Hash();
+  }
+
+} // anonymous namespace
+
+TEST(StringIdTests , literals_match_runtime_strings) {
+  const std::string runtime = "Geometry";
+
+  const StringId interned{ runtime };
+  EXPECT_EQ(interned , kGeometry);
+  EXPECT_EQ(interned.Hash() , FNV(runtime));
+  EXPECT_EQ(HashOf("Geometry") , interned.Hash());
+
+  EXPECT_EQ(kGeometry.Str() , "Geometry");
+  EXPECT_EQ(interned.Str() , "Geometry");
+  EXPECT_EQ(fmt::format("{}" , kGeometry) , "Geometry");
+
+  EXPECT_TRUE(StringId{}.Empty());
+  EXPECT_FALSE(kGeometry.Empty());
+}
+
+TEST(StringIdTests , interned_text_is_shared_and_stable) {
+  std::string name = "string_id_tests.stable";
+
+  const StringId first{ name };
+  const size_t size = StringInterner::Size();
+
+  /// the id does not point into the string it came from
+  name.assign(64 , 'x');
+  EXPECT_EQ(first.Str() , "string_id_tests.stable");
+
+  const StringId second{ std::string_view{ "string_id_tests.stable" } };
+  EXPECT_EQ(second.Str().data() , first.Str().data());
+  EXPECT_EQ(StringInterner::Size() , size);
+
+  EXPECT_EQ(StringInterner::Lookup(first.Hash()) , "string_id_tests.stable");
+  EXPECT_TRUE(StringInterner::Lookup(FNV("string_id_tests.never_interned")).empty());
+}
+
+TEST(StringIdTests , lookup_only_covers_interned_text) {
+  /// a literal id carries its text but is never registered , Lookup does not know its hash
+  constexpr StringId literal = "string_id_tests.literal_only";
+  EXPECT_EQ(literal.Str() , "string_id_tests.literal_only");
+  EXPECT_TRUE(StringInterner::Lookup(literal.Hash()).empty());
+
+  /// interning the same text registers it , the literal and the interned id stay equal
+  const StringId interned = StringInterner::Intern(literal.Str());
+  EXPECT_EQ(interned , literal);
+  EXPECT_EQ(StringInterner::Lookup(literal.Hash()) , "string_id_tests.literal_only");
+}
+
+TEST(StringIdTests , concurrent_interning) {
+  constexpr uint32_t kNumThreads = 4;
+  constexpr uint32_t kNumStrings = 512;
+
+  std::vector<std::vector<StringId>> ids(kNumThreads);
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&ids , t]() {
+      for (uint32_t i = 0; i < kNumStrings; ++i) {
+        ids[t].emplace_back(fmt::format("string_id_tests.concurrent.{}" , i));
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  /// every thread got the same entry for the same text
+  for (uint32_t i = 0; i < kNumStrings; ++i) {
+    const std::string expected = fmt::format("string_id_tests.concurrent.{}" , i);
+    for (uint32_t t = 0; t < kNumThreads; ++t) {
+      ASSERT_EQ(ids[t][i].Str() , expected);
+      EXPECT_EQ(ids[t][i].Str().data() , ids[0][i].Str().data());
+    }
+  }
+}
+
+TEST(StringIdTests , config_lookup_by_id) {
+  ConfigTable table;
+  table.Add("renderer" , "depth-test" , "true");
+  table.Add("renderer" , "clear-color" , std::vector<std::string>{ "0.1" , "0.2" , "0.3" });
+
+  const auto* depth = table.Find("RENDERER" , "DEPTH-TEST");
+  ASSERT_NE(depth , nullptr);
+  ASSERT_EQ(depth->size() , 1);
+  EXPECT_EQ(depth->front() , "true");
+
+  const auto* color = table.Find("RENDERER" , "CLEAR-COLOR");
+  ASSERT_NE(color , nullptr);
+  EXPECT_EQ(color->size() , 3);
+
+  /// ids are not case folded , the table stores everything upper case
+  EXPECT_EQ(table.Find("renderer" , "depth-test") , nullptr);
+  EXPECT_EQ(table.Find("RENDERER" , "MISSING") , nullptr);
+  EXPECT_EQ(table.Get("renderer" , "depth-test") , *depth);
+}
@@ -0,0 +1,189 @@
+/**
+ * \file unit_tests/uniform_layout_tests.cpp
+ **/
+#include "oetest.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "rendering/direction_light.hpp"
+#include "rendering/point_light.hpp"
+#include "rendering/uniform.hpp"
+
+using other::DirectionLight;
+using other::PointLight;
+using other::Uniform;
+using other::UniformHandle;
+using other::UniformLayout;
+using other::UniformStaging;
+using other::ValueType;
+
+namespace {
+
+  /// the editor's camera and light blocks
+  const std::vector<Uniform> kCameraUniforms = {
+    { "projection" , ValueType::MAT4 } ,
+    { "view"       , ValueType::MAT4 } ,
+    { "viewpoint"  , ValueType::VEC4 } ,
+  };
+
+  const std::vector<Uniform> kLightUniforms = {
+    { "num_lights" , ValueType::VEC4 } ,
+    { "direction_lights" , ValueType::USER_TYPE , 100 , sizeof(DirectionLight) } ,
+    { "point_lights" , ValueType::USER_TYPE , 100 , sizeof(PointLight) } ,
+  };
+
+} // anonymous namespace
+
+/// a layout with an unsized user type logs , the fixture brings up the logger
+class UniformLayoutTests : public other::OtherTest {};
+
+TEST_F(UniformLayoutTests , offsets_follow_declaration_order) {
+  const UniformLayout camera(kCameraUniforms);
+  ASSERT_TRUE(camera.Valid());
+  EXPECT_EQ(camera.Size() , 2 * sizeof(glm::mat4) + sizeof(glm::vec4));
+
+  const UniformHandle projection = camera.Find("projection");
+  const UniformHandle view = camera.Find("view");
+  const UniformHandle viewpoint = camera.Find("viewpoint");
+  ASSERT_TRUE(projection.Valid());
+  ASSERT_TRUE(view.Valid());
+  ASSERT_TRUE(viewpoint.Valid());
+
+  EXPECT_EQ(projection.offset , 0);
+  EXPECT_EQ(projection.size , sizeof(glm::mat4));
+  EXPECT_EQ(view.offset , sizeof(glm::mat4));
+  EXPECT_EQ(viewpoint.offset , 2 * sizeof(glm::mat4));
+  EXPECT_EQ(viewpoint.size , sizeof(glm::vec4));
+  EXPECT_EQ(viewpoint.arr_length , 1);
+
+  const UniformLayout lights(kLightUniforms);
+  ASSERT_TRUE(lights.Valid());
+
+  const UniformHandle direction_lights = lights.Find("direction_lights");
+  const UniformHandle point_lights = lights.Find("point_lights");
+  EXPECT_EQ(direction_lights.offset , sizeof(glm::vec4));
+  EXPECT_EQ(direction_lights.size , sizeof(DirectionLight));
+  EXPECT_EQ(direction_lights.arr_length , 100);
+  EXPECT_EQ(point_lights.offset , sizeof(glm::vec4) + 100 * sizeof(DirectionLight));
+  EXPECT_EQ(lights.Size() , point_lights.offset + 100 * sizeof(PointLight));
+}
+
+TEST_F(UniformLayoutTests , missing_names_and_unsized_user_types) {
+  const UniformLayout camera(kCameraUniforms);
+  EXPECT_FALSE(camera.Find("model").Valid());
+
+  /// hashed names resolve the same as literals
+  EXPECT_EQ(camera.Find(other::StringId{ std::string{ "view" } }).offset , camera.Find("view").offset);
+
+  const UniformLayout unsized({
+    { "materials" , ValueType::USER_TYPE } ,
+  });
+  EXPECT_FALSE(unsized.Valid());
+}
+
+TEST_F(UniformLayoutTests , staging_tracks_dirty_range) {
+  const UniformLayout camera(kCameraUniforms);
+
+  UniformStaging staging;
+  staging.Resize(camera.Size());
+  EXPECT_FALSE(staging.Dirty());
+  EXPECT_EQ(staging.Bytes().size() , camera.Size());
+
+  const glm::vec4 viewpoint{ 1.f , 2.f , 3.f , 1.f };
+  ASSERT_TRUE(staging.Write(camera.Find("viewpoint") , viewpoint));
+  ASSERT_TRUE(staging.Dirty());
+  EXPECT_EQ(staging.DirtyOffset() , 2 * sizeof(glm::mat4));
+  EXPECT_EQ(staging.DirtyBytes().size() , sizeof(glm::vec4));
+
+  /// the range grows to cover both writes , one upload for everything
+  const glm::mat4 view{ 2.f };
+  ASSERT_TRUE(staging.Write(camera.Find("view") , view));
+  EXPECT_EQ(staging.DirtyOffset() , sizeof(glm::mat4));
+  EXPECT_EQ(staging.DirtyBytes().size() , sizeof(glm::mat4) + sizeof(glm::vec4));
+
+  glm::vec4 read{};
+  std::memcpy(&read , staging.Bytes().data() + 2 * sizeof(glm::mat4) , sizeof(glm::vec4));
+  EXPECT_EQ(read , viewpoint);
+
+  staging.MarkClean();
+  EXPECT_FALSE(staging.Dirty());
+  EXPECT_TRUE(staging.DirtyBytes().empty());
+}
+
+TEST_F(UniformLayoutTests , staging_rejects_mismatched_writes) {
+  const UniformLayout camera(kCameraUniforms);
+
+  UniformStaging staging;
+  staging.Resize(camera.Size());
+
+  EXPECT_FALSE(staging.Write(camera.Find("view") , glm::vec4{ 1.f }));
+  EXPECT_FALSE(staging.Write(camera.Find("viewpoint") , glm::vec4{ 1.f } , 1));
+  EXPECT_FALSE(staging.Write(UniformHandle{} , glm::vec4{ 1.f }));
+  EXPECT_FALSE(staging.Dirty());
+}
+
+TEST_F(UniformLayoutTests , staged_arrays_are_clamped) {
+  const UniformLayout layout({
+    { "num_lights" , ValueType::VEC4 } ,
+    { "indices" , ValueType::UINT32 , 4 } ,
+  });
+  ASSERT_TRUE(layout.Valid());
+
+  const UniformHandle indices = layout.Find("indices");
+  ASSERT_TRUE(indices.Valid());
+  EXPECT_EQ(indices.offset , sizeof(glm::vec4));
+
+  UniformStaging staging;
+  staging.Resize(layout.Size());
+
+  const std::array<uint32_t , 6> values = { 1 , 2 , 3 , 4 , 5 , 6 };
+  EXPECT_EQ(staging.WriteArray<uint32_t>(indices , values , 1) , 3);
+  EXPECT_EQ(staging.DirtyOffset() , indices.offset + sizeof(uint32_t));
+  EXPECT_EQ(staging.DirtyBytes().size() , 3 * sizeof(uint32_t));
+
+  std::array<uint32_t , 4> read{};
+  std::memcpy(read.data() , staging.Bytes().data() + indices.offset , sizeof(read));
+  EXPECT_EQ(read , (std::array<uint32_t , 4>{ 0 , 1 , 2 , 3 }));
+
+  EXPECT_EQ(staging.WriteArray<uint32_t>(indices , values , 4) , 0);
+  EXPECT_EQ(staging.WriteArray<glm::vec2>(indices , std::array<glm::vec2 , 1>{ glm::vec2{ 1.f } }) , 0);
+}
+
+TEST_F(UniformLayoutTests , flush_records_one_upload) {
+  const UniformLayout camera(kCameraUniforms);
+
+  UniformStaging staging;
+  staging.Resize(camera.Size());
+  ASSERT_TRUE(staging.Write(camera.Find("projection") , glm::mat4{ 1.f }));
+  ASSERT_TRUE(staging.Write(camera.Find("viewpoint") , glm::vec4{ 1.f }));
+
+  other::RenderCommandBuffer commands;
+  staging.RecordUpload(commands , 1 , 4);
+  ASSERT_EQ(commands.NumCommands() , 1);
+  EXPECT_FALSE(staging.Dirty());
+
+  /// the upload holds a copy , staging the next frame before replay does not reach the recorded bytes
+  const std::vector<uint8_t> recorded(staging.Bytes().begin() , staging.Bytes().end());
+  ASSERT_TRUE(staging.Write(camera.Find("viewpoint") , glm::vec4{ 2.f }));
+  staging.Resize(camera.Size() * 4);
+
+  commands.ForEach([&](const other::RenderCommandHeader& header , const void* payload) {
+    ASSERT_EQ(header.type , other::BUFFER_SUB_DATA_CMD);
+    const auto upload = other::RenderCommandBuffer::Read<other::BufferSubDataCmd>(payload);
+    EXPECT_EQ(upload.buffer , 4);
+    EXPECT_EQ(upload.offset , 0);
+    ASSERT_EQ(upload.size , camera.Size());
+
+    const uint8_t* data = other::RenderCommandBuffer::InlineData<other::BufferSubDataCmd>(payload);
+    EXPECT_TRUE(std::equal(recorded.begin() , recorded.end() , data));
+  });
+
+  /// nothing staged since , nothing recorded
+  staging.RecordUpload(commands , 1 , 4);
+  EXPECT_EQ(commands.NumCommands() , 1);
+}
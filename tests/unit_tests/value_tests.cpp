@@ -53,3 +53,100 @@ TEST_F(ValueTests , array_test1) {
       "Failed on .At<> test on step " << i;
   }
 }
+
+TEST_F(ValueTests , scalars_and_vectors_stay_inline) {
+  value.Set(glm::vec4(1.f , 2.f , 3.f , 4.f));
+  EXPECT_FALSE(value.IsOutOfLine());
+  EXPECT_EQ(value.Type() , ValueType::VEC4);
+  EXPECT_EQ(value.NumElements() , 1);
+  EXPECT_EQ(value.Get<glm::vec4>() , glm::vec4(1.f , 2.f , 3.f , 4.f));
+  EXPECT_EQ(value.Read<glm::vec4>().z , 3.f);
+
+  value.Set(2.5);
+  EXPECT_FALSE(value.IsOutOfLine());
+  EXPECT_EQ(value.Type() , ValueType::DOUBLE);
+  EXPECT_EQ(value.Get<double>() , 2.5);
+
+  value.Set(glm::mat4(1.f));
+  EXPECT_TRUE(value.IsOutOfLine());
+  EXPECT_EQ(value.Get<glm::mat4>() , glm::mat4(1.f));
+}
+
+TEST_F(ValueTests , strings) {
+  value.Set<std::string>("short");
+  EXPECT_FALSE(value.IsOutOfLine());
+  EXPECT_TRUE(value.IsArray());
+  EXPECT_EQ(value.Type() , ValueType::CHAR);
+  EXPECT_EQ(value.Size() , 5);
+  EXPECT_EQ(value.AsString() , "short");
+  EXPECT_EQ(value.Get<std::string>() , "short");
+
+  const std::string long_string(100 , 'x');
+  value.Set<std::string>(long_string);
+  EXPECT_TRUE(value.IsOutOfLine());
+  EXPECT_EQ(value.Get<std::string>() , long_string);
+
+  /// the allocation is kept for anything that still fits
+  const void* allocation = value.AsRawMemory();
+  value.Set<std::string>("a string that is longer than the inline storage");
+  EXPECT_EQ(value.AsRawMemory() , allocation);
+  EXPECT_EQ(value.AsString() , "a string that is longer than the inline storage");
+
+  value.Set(7);
+  EXPECT_EQ(value.AsRawMemory() , allocation);
+  EXPECT_FALSE(value.IsArray());
+  EXPECT_EQ(value.Get<int32_t>() , 7);
+}
+
+TEST_F(ValueTests , copies_and_moves) {
+  value.Set(glm::vec3(1.f , 2.f , 3.f));
+
+  Value copy = value;
+  EXPECT_EQ(copy.Type() , ValueType::VEC3);
+  EXPECT_EQ(copy.Get<glm::vec3>() , glm::vec3(1.f , 2.f , 3.f));
+
+  std::array<float , 32> floats{};
+  for (size_t i = 0; i < floats.size(); ++i) {
+    floats[i] = static_cast<float>(i);
+  }
+
+  Value array;
+  array.Set<float>(floats);
+  ASSERT_TRUE(array.IsOutOfLine());
+
+  Value array_copy = array;
+  EXPECT_TRUE(array_copy.IsArray());
+  EXPECT_NE(array_copy.AsRawMemory() , array.AsRawMemory());
+  EXPECT_EQ(array_copy.NumElements() , floats.size());
+
+  const void* allocation = array.AsRawMemory();
+  Value moved = std::move(array);
+  EXPECT_EQ(moved.AsRawMemory() , allocation);
+  EXPECT_EQ(array.Size() , 0);
+  EXPECT_EQ(array.Type() , ValueType::EMPTY);
+
+  copy = moved;
+  EXPECT_TRUE(copy.IsArray());
+  EXPECT_EQ(copy.At<float>(31) , 31.f);
+
+  copy = value;
+  EXPECT_FALSE(copy.IsArray());
+  EXPECT_EQ(copy.Get<glm::vec3>() , glm::vec3(1.f , 2.f , 3.f));
+}
+
+TEST_F(ValueTests , array_span) {
+  std::array<int32_t , 4> ints = { 4 , 3 , 2 , 1 };
+  value.Set<int32_t>(ints);
+  EXPECT_FALSE(value.IsOutOfLine());
+
+  std::span<int32_t> view = value.AsSpan<int32_t>();
+  ASSERT_EQ(view.size() , 4);
+  EXPECT_TRUE(std::equal(view.begin() , view.end() , ints.begin()));
+
+  view[0] = 10;
+  EXPECT_EQ(value.At<int32_t>(0) , 10);
+
+  const Value& const_value = value;
+  EXPECT_EQ(const_value.At<int32_t>(3) , 1);
+  EXPECT_EQ(const_value.AsSpan<int32_t>().back() , 1);
+}